@@ -885,6 +885,10 @@ namespace mitk
     noLazyRegistryCacheLoadingOption.callback(Poco::Util::OptionCallback<Impl>(d, &Impl::handleBooleanOption));
     options.addOption(noLazyRegistryCacheLoadingOption);
 
+    Poco::Util::Option pluginCacheOption(ARG_PLUGIN_CACHE.toStdString(), "", "the location of the registry cache");
+    pluginCacheOption.argument("<dir>").binding(ARG_PLUGIN_CACHE.toStdString());
+    options.addOption(pluginCacheOption);
+
     Poco::Util::Option registryMultiLanguageOption(ARG_REGISTRY_MULTI_LANGUAGE.toStdString(), "", "enable multi-language support for the registry");
     registryMultiLanguageOption.callback(Poco::Util::OptionCallback<Impl>(d, &Impl::handleBooleanOption));
     options.addOption(registryMultiLanguageOption);
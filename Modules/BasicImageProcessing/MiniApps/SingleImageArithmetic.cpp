@@ -15,7 +15,7 @@ found in the LICENSE file.
 #include "mitkCommandLineParser.h"
 #include "mitkIOUtil.h"
 
-#include <mitkArithmeticOperation.h>
+#include <mitkArithmeticExpression.h>
 
 static bool ConvertToBool(std::map<std::string, us::Any> &data, std::string name)
 {
@@ -95,70 +95,72 @@ int main(int argc, char* argv[])
   bool resultAsDouble = ConvertToBool(parsedArgs, "as-double");
   MITK_INFO << "Output image as double: " << resultAsDouble;
 
-  mitk::Image::Pointer tmpImage = image->Clone();
+  // The operations are only recorded and computed in one pass when the expression is evaluated
+  mitk::ArithmeticExpression expression(image);
 
   if (ConvertToBool(parsedArgs, "tan"))
   {
     MITK_INFO << " Start Doing Operation: TAN()";
-    tmpImage = mitk::ArithmeticOperation::Tan(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::Tan(expression);
   }
   if (ConvertToBool(parsedArgs, "atan"))
   {
     MITK_INFO << " Start Doing Operation: ATAN()";
-    tmpImage = mitk::ArithmeticOperation::Atan(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::Atan(expression);
   }
   if (ConvertToBool(parsedArgs, "cos"))
   {
     MITK_INFO << " Start Doing Operation: COS()";
-    tmpImage = mitk::ArithmeticOperation::Cos(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::Cos(expression);
   }
   if (ConvertToBool(parsedArgs, "acos"))
   {
     MITK_INFO << " Start Doing Operation: ACOS()";
-    tmpImage = mitk::ArithmeticOperation::Acos(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::Acos(expression);
   }
   if (ConvertToBool(parsedArgs, "sin"))
   {
     MITK_INFO << " Start Doing Operation: SIN()";
-    tmpImage = mitk::ArithmeticOperation::Sin(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::Sin(expression);
   }
   if (ConvertToBool(parsedArgs, "asin"))
   {
     MITK_INFO << " Start Doing Operation: ASIN()";
-    tmpImage = mitk::ArithmeticOperation::Asin(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::Asin(expression);
   }
   if (ConvertToBool(parsedArgs, "square"))
   {
     MITK_INFO << " Start Doing Operation: SQUARE()";
-    tmpImage = mitk::ArithmeticOperation::Square(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::Square(expression);
   }
   if (ConvertToBool(parsedArgs, "sqrt"))
   {
     MITK_INFO << " Start Doing Operation: SQRT()";
-    tmpImage = mitk::ArithmeticOperation::Sqrt(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::Sqrt(expression);
   }
   if (ConvertToBool(parsedArgs, "abs"))
   {
     MITK_INFO << " Start Doing Operation: ABS()";
-    tmpImage = mitk::ArithmeticOperation::Abs(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::Abs(expression);
   }
   if (ConvertToBool(parsedArgs, "exp"))
   {
     MITK_INFO << " Start Doing Operation: EXP()";
-    tmpImage = mitk::ArithmeticOperation::Exp(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::Exp(expression);
   }
   if (ConvertToBool(parsedArgs, "expneg"))
   {
     MITK_INFO << " Start Doing Operation: EXPNEG()";
-    tmpImage = mitk::ArithmeticOperation::ExpNeg(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::ExpNeg(expression);
   }
   if (ConvertToBool(parsedArgs, "log10"))
   {
     MITK_INFO << " Start Doing Operation: LOG10()";
-    tmpImage = mitk::ArithmeticOperation::Log10(tmpImage, resultAsDouble);
+    expression = mitk::ArithmeticExpression::Log10(expression);
   }
 
-  mitk::IOUtil::Save(tmpImage, outputFilename);
+  mitk::Image::Pointer resultImage = expression.Evaluate(resultAsDouble);
+  mitk::IOUtil::Save(resultImage, outputFilename);
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,131 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkArithmeticExpression_h
+#define mitkArithmeticExpression_h
+
+#include <mitkImage.h>
+#include <MitkBasicImageProcessingExports.h>
+
+#include <memory>
+
+namespace mitk
+{
+  /** \brief Arithmetic expression on images and values that is evaluated lazily in one pass
+  *
+  * Combining expressions with the arithmetic operators or the functions of this class only records the
+  * expression. Nothing is computed until Evaluate() is called. Evaluate() then computes the complete
+  * expression voxel by voxel in one multithreaded pass and only allocates the result image. Chained
+  * operations like (a - mean) / std * mask therefore need no intermediate images, in contrast to
+  * ArithmeticOperation, which generates a full image per operation.
+  *
+  * Example:
+  * \code
+  * mitk::ArithmeticExpression a(imageA);
+  * mitk::ArithmeticExpression mask(maskImage);
+  * mitk::Image::Pointer result = ((a - mean) / std * mask).Evaluate();
+  * \endcode
+  *
+  * All values are computed in double precision; the result is cast only once into the output pixel type.
+  * All images of an expression must be scalar images with the same dimensions and geometry. The result has the
+  * geometry of the first image of the expression. Division of two images follows itk::Functor::Div
+  * (division by zero yields the maximum value of the output type).
+  */
+  class MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression
+  {
+  public:
+    enum class OperationType
+    {
+      Image,
+      Value,
+      Add,
+      Subtract,
+      Multiply,
+      Divide,
+      Pow,
+      Tan,
+      Atan,
+      Cos,
+      Acos,
+      Sin,
+      Asin,
+      Square,
+      Sqrt,
+      Abs,
+      Exp,
+      ExpNeg,
+      Log10
+    };
+
+    /** Expression that is the passed image. The image is only referenced; it must not be changed until
+    the expression is evaluated.*/
+    explicit ArithmeticExpression(const Image* image);
+    /** Expression that is the passed constant value.*/
+    explicit ArithmeticExpression(double value);
+
+    static ArithmeticExpression Add(const ArithmeticExpression& left, const ArithmeticExpression& right);
+    static ArithmeticExpression Subtract(const ArithmeticExpression& left, const ArithmeticExpression& right);
+    static ArithmeticExpression Multiply(const ArithmeticExpression& left, const ArithmeticExpression& right);
+    static ArithmeticExpression Divide(const ArithmeticExpression& left, const ArithmeticExpression& right);
+
+    static ArithmeticExpression Pow(const ArithmeticExpression& base, double exponent);
+    static ArithmeticExpression Pow(double base, const ArithmeticExpression& exponent);
+    static ArithmeticExpression Tan(const ArithmeticExpression& expression);
+    static ArithmeticExpression Atan(const ArithmeticExpression& expression);
+    static ArithmeticExpression Cos(const ArithmeticExpression& expression);
+    static ArithmeticExpression Acos(const ArithmeticExpression& expression);
+    static ArithmeticExpression Sin(const ArithmeticExpression& expression);
+    static ArithmeticExpression Asin(const ArithmeticExpression& expression);
+    static ArithmeticExpression Square(const ArithmeticExpression& expression);
+    static ArithmeticExpression Sqrt(const ArithmeticExpression& expression);
+    static ArithmeticExpression Abs(const ArithmeticExpression& expression);
+    static ArithmeticExpression Exp(const ArithmeticExpression& expression);
+    static ArithmeticExpression ExpNeg(const ArithmeticExpression& expression);
+    static ArithmeticExpression Log10(const ArithmeticExpression& expression);
+
+    /** Computes the expression and returns the result image.
+    * @param outputAsDouble If true, the result is a double image. Otherwise it has the pixel type of the
+    * first image of the expression.
+    * @exception mitk::Exception if the expression contains no image, an image is not scalar or the
+    * dimensions or geometries of the images differ.*/
+    Image::Pointer Evaluate(bool outputAsDouble = true) const;
+
+    struct Node;
+
+  private:
+    explicit ArithmeticExpression(std::shared_ptr<const Node> node);
+
+    static ArithmeticExpression MakeOperation(OperationType operation, const ArithmeticExpression& left);
+    static ArithmeticExpression MakeOperation(OperationType operation, const ArithmeticExpression& left, const ArithmeticExpression& right);
+
+    std::shared_ptr<const Node> m_Node;
+  };
+
+  inline ArithmeticExpression operator-(const ArithmeticExpression& expression) { return ArithmeticExpression::Multiply(ArithmeticExpression(-1.), expression); }
+
+  inline ArithmeticExpression operator+(const ArithmeticExpression& left, const ArithmeticExpression& right) { return ArithmeticExpression::Add(left, right); }
+  inline ArithmeticExpression operator-(const ArithmeticExpression& left, const ArithmeticExpression& right) { return ArithmeticExpression::Subtract(left, right); }
+  inline ArithmeticExpression operator*(const ArithmeticExpression& left, const ArithmeticExpression& right) { return ArithmeticExpression::Multiply(left, right); }
+  inline ArithmeticExpression operator/(const ArithmeticExpression& left, const ArithmeticExpression& right) { return ArithmeticExpression::Divide(left, right); }
+
+  inline ArithmeticExpression operator+(const ArithmeticExpression& left, double right) { return left + ArithmeticExpression(right); }
+  inline ArithmeticExpression operator-(const ArithmeticExpression& left, double right) { return left - ArithmeticExpression(right); }
+  inline ArithmeticExpression operator*(const ArithmeticExpression& left, double right) { return left * ArithmeticExpression(right); }
+  inline ArithmeticExpression operator/(const ArithmeticExpression& left, double right) { return left / ArithmeticExpression(right); }
+
+  inline ArithmeticExpression operator+(double left, const ArithmeticExpression& right) { return ArithmeticExpression(left) + right; }
+  inline ArithmeticExpression operator-(double left, const ArithmeticExpression& right) { return ArithmeticExpression(left) - right; }
+  inline ArithmeticExpression operator*(double left, const ArithmeticExpression& right) { return ArithmeticExpression(left) * right; }
+  inline ArithmeticExpression operator/(double left, const ArithmeticExpression& right) { return ArithmeticExpression(left) / right; }
+}
+
+#endif
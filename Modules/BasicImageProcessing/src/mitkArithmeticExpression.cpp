@@ -0,0 +1,642 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkArithmeticExpression.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkNodePredicateGeometry.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+struct mitk::ArithmeticExpression::Node
+{
+  OperationType Operation = OperationType::Value;
+  double Value = 0.0;
+  Image::ConstPointer InputImage;
+  std::shared_ptr<const Node> Left;
+  std::shared_ptr<const Node> Right;
+};
+
+namespace
+{
+  using OperationType = mitk::ArithmeticExpression::OperationType;
+  using Node = mitk::ArithmeticExpression::Node;
+
+  /** Number of voxels that are processed at once. The buffers of a chunk stay in the first level cache
+  and the loops over a chunk are simple enough to be vectorized by the compiler.*/
+  const std::size_t ChunkSize = 2048;
+
+  enum class InstructionType
+  {
+    LoadImage,
+    LoadValue,
+    AddValue,
+    SubtractValue,
+    ValueSubtract,
+    MultiplyValue,
+    DivideValue,
+    ValueDivide,
+    PowValue,
+    ValuePow,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Pow,
+    Unary
+  };
+
+  /** Instruction of the stack machine the expression is compiled to. Every stack entry is a buffer of ChunkSize values.
+  Instructions with a constant operand work in place on the top buffer, binary instructions combine the two top buffers.*/
+  struct Instruction
+  {
+    InstructionType Type;
+    OperationType UnaryOperation;
+    double Value;
+    unsigned int Input;
+  };
+
+  typedef void (*LoadFunctionType)(const void* buffer, std::size_t begin, std::size_t count, double* values);
+  typedef void (*StoreFunctionType)(const double* values, std::size_t begin, std::size_t count, void* buffer);
+
+  template <typename TPixel>
+  void LoadPixels(const void* buffer, std::size_t begin, std::size_t count, double* values)
+  {
+    const TPixel* pixels = static_cast<const TPixel*>(buffer) + begin;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      values[i] = static_cast<double>(pixels[i]);
+    }
+  }
+
+  template <typename TPixel>
+  void StorePixels(const double* values, std::size_t begin, std::size_t count, void* buffer)
+  {
+    TPixel* pixels = static_cast<TPixel*>(buffer) + begin;
+    if constexpr (std::is_floating_point<TPixel>::value)
+    {
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        pixels[i] = static_cast<TPixel>(values[i]);
+      }
+    }
+    else
+    {
+      // Saturate instead of overflowing (e.g. for the results of divisions by zero)
+      const double lowest = static_cast<double>(std::numeric_limits<TPixel>::lowest());
+      const double highest = static_cast<double>(std::numeric_limits<TPixel>::max());
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const double value = values[i];
+        pixels[i] = std::isnan(value) ? TPixel(0) : value <= lowest ? std::numeric_limits<TPixel>::lowest()
+          : value >= highest ? std::numeric_limits<TPixel>::max() : static_cast<TPixel>(value);
+      }
+    }
+  }
+
+  template <typename TPixel>
+  void GetPixelFunctions(LoadFunctionType& load, StoreFunctionType& store)
+  {
+    load = &LoadPixels<TPixel>;
+    store = &StorePixels<TPixel>;
+  }
+
+  void GetPixelFunctions(const mitk::PixelType& pixelType, LoadFunctionType& load, StoreFunctionType& store)
+  {
+    if (pixelType.GetNumberOfComponents() != 1)
+    {
+      mitkThrow() << "Cannot evaluate arithmetic expression. Only scalar images are supported. Pixel type: " << pixelType.GetTypeAsString();
+    }
+
+    switch (pixelType.GetComponentType())
+    {
+      case itk::IOComponentEnum::UCHAR: GetPixelFunctions<unsigned char>(load, store); break;
+      case itk::IOComponentEnum::CHAR: GetPixelFunctions<char>(load, store); break;
+      case itk::IOComponentEnum::USHORT: GetPixelFunctions<unsigned short>(load, store); break;
+      case itk::IOComponentEnum::SHORT: GetPixelFunctions<short>(load, store); break;
+      case itk::IOComponentEnum::UINT: GetPixelFunctions<unsigned int>(load, store); break;
+      case itk::IOComponentEnum::INT: GetPixelFunctions<int>(load, store); break;
+      case itk::IOComponentEnum::ULONG: GetPixelFunctions<unsigned long>(load, store); break;
+      case itk::IOComponentEnum::LONG: GetPixelFunctions<long>(load, store); break;
+      case itk::IOComponentEnum::ULONGLONG: GetPixelFunctions<unsigned long long>(load, store); break;
+      case itk::IOComponentEnum::LONGLONG: GetPixelFunctions<long long>(load, store); break;
+      case itk::IOComponentEnum::FLOAT: GetPixelFunctions<float>(load, store); break;
+      case itk::IOComponentEnum::DOUBLE: GetPixelFunctions<double>(load, store); break;
+      default:
+        mitkThrow() << "Cannot evaluate arithmetic expression. Pixel type is not supported: " << pixelType.GetTypeAsString();
+    }
+  }
+
+  double ApplyUnary(OperationType operation, double value)
+  {
+    switch (operation)
+    {
+      case OperationType::Tan: return std::tan(value);
+      case OperationType::Atan: return std::atan(value);
+      case OperationType::Cos: return std::cos(value);
+      case OperationType::Acos: return std::acos(value);
+      case OperationType::Sin: return std::sin(value);
+      case OperationType::Asin: return std::asin(value);
+      case OperationType::Square: return value * value;
+      case OperationType::Sqrt: return std::sqrt(value);
+      case OperationType::Abs: return std::abs(value);
+      case OperationType::Exp: return std::exp(value);
+      case OperationType::ExpNeg: return std::exp(-value);
+      case OperationType::Log10: return std::log10(value);
+      default:
+        mitkThrow() << "Invalid arithmetic expression. Operation is not unary.";
+    }
+  }
+
+  /** Division like itk::Functor::Div. The maximum is saturated to the output type when the result is stored.*/
+  inline double Divide(double left, double right)
+  {
+    return right != 0.0 ? left / right : std::numeric_limits<double>::max();
+  }
+
+  double ApplyBinary(OperationType operation, double left, double right)
+  {
+    switch (operation)
+    {
+      case OperationType::Add: return left + right;
+      case OperationType::Subtract: return left - right;
+      case OperationType::Multiply: return left * right;
+      case OperationType::Divide: return Divide(left, right);
+      case OperationType::Pow: return std::pow(left, right);
+      default:
+        mitkThrow() << "Invalid arithmetic expression. Operation is not binary.";
+    }
+  }
+
+  bool IsBinary(OperationType operation)
+  {
+    return operation == OperationType::Add || operation == OperationType::Subtract || operation == OperationType::Multiply
+      || operation == OperationType::Divide || operation == OperationType::Pow;
+  }
+
+  /** Compiles an expression graph into instructions for a stack machine.*/
+  class ExpressionCompiler
+  {
+  public:
+    std::vector<Instruction> Instructions;
+    std::vector<mitk::Image::ConstPointer> Inputs;
+    unsigned int MaxStackDepth = 0;
+
+    void Compile(const Node* node)
+    {
+      this->CompileNode(node);
+    }
+
+  private:
+    unsigned int m_StackDepth = 0;
+
+    /** Returns true if the value of the node does not depend on any image; value is then set to it.*/
+    static bool IsConstant(const Node* node, double& value)
+    {
+      if (node->Operation == OperationType::Image)
+      {
+        return false;
+      }
+      if (node->Operation == OperationType::Value)
+      {
+        value = node->Value;
+        return true;
+      }
+
+      double left = 0.;
+      if (!IsConstant(node->Left.get(), left))
+      {
+        return false;
+      }
+
+      if (IsBinary(node->Operation))
+      {
+        double right = 0.;
+        if (!IsConstant(node->Right.get(), right))
+        {
+          return false;
+        }
+        value = ApplyBinary(node->Operation, left, right);
+      }
+      else
+      {
+        value = ApplyUnary(node->Operation, left);
+      }
+      return true;
+    }
+
+    void Push(const Instruction& instruction)
+    {
+      this->Instructions.push_back(instruction);
+      ++m_StackDepth;
+      this->MaxStackDepth = std::max(this->MaxStackDepth, m_StackDepth);
+    }
+
+    void Emit(InstructionType type, double value = 0.)
+    {
+      this->Instructions.push_back({ type, OperationType::Value, value, 0 });
+    }
+
+    unsigned int GetInputIndex(const mitk::Image* image)
+    {
+      auto finding = std::find_if(this->Inputs.begin(), this->Inputs.end(),
+        [image](const mitk::Image::ConstPointer& input) { return input.GetPointer() == image; });
+      if (finding != this->Inputs.end())
+      {
+        return static_cast<unsigned int>(finding - this->Inputs.begin());
+      }
+      this->Inputs.push_back(image);
+      return static_cast<unsigned int>(this->Inputs.size() - 1);
+    }
+
+    void CompileNode(const Node* node)
+    {
+      double constant = 0.;
+      if (IsConstant(node, constant))
+      {
+        this->Push({ InstructionType::LoadValue, OperationType::Value, constant, 0 });
+        return;
+      }
+
+      if (node->Operation == OperationType::Image)
+      {
+        this->Push({ InstructionType::LoadImage, OperationType::Image, 0., this->GetInputIndex(node->InputImage) });
+        return;
+      }
+
+      if (!IsBinary(node->Operation))
+      {
+        this->CompileNode(node->Left.get());
+        this->Instructions.push_back({ InstructionType::Unary, node->Operation, 0., 0 });
+        return;
+      }
+
+      double leftConstant = 0.;
+      double rightConstant = 0.;
+      const bool leftIsConstant = IsConstant(node->Left.get(), leftConstant);
+      const bool rightIsConstant = IsConstant(node->Right.get(), rightConstant);
+
+      if (rightIsConstant)
+      {
+        this->CompileNode(node->Left.get());
+        switch (node->Operation)
+        {
+          case OperationType::Add: this->Emit(InstructionType::AddValue, rightConstant); break;
+          case OperationType::Subtract: this->Emit(InstructionType::SubtractValue, rightConstant); break;
+          case OperationType::Multiply: this->Emit(InstructionType::MultiplyValue, rightConstant); break;
+          case OperationType::Divide: this->Emit(InstructionType::DivideValue, rightConstant); break;
+          default: this->Emit(InstructionType::PowValue, rightConstant); break;
+        }
+      }
+      else if (leftIsConstant)
+      {
+        this->CompileNode(node->Right.get());
+        switch (node->Operation)
+        {
+          case OperationType::Add: this->Emit(InstructionType::AddValue, leftConstant); break;
+          case OperationType::Subtract: this->Emit(InstructionType::ValueSubtract, leftConstant); break;
+          case OperationType::Multiply: this->Emit(InstructionType::MultiplyValue, leftConstant); break;
+          case OperationType::Divide: this->Emit(InstructionType::ValueDivide, leftConstant); break;
+          default: this->Emit(InstructionType::ValuePow, leftConstant); break;
+        }
+      }
+      else
+      {
+        this->CompileNode(node->Left.get());
+        this->CompileNode(node->Right.get());
+        switch (node->Operation)
+        {
+          case OperationType::Add: this->Emit(InstructionType::Add); break;
+          case OperationType::Subtract: this->Emit(InstructionType::Subtract); break;
+          case OperationType::Multiply: this->Emit(InstructionType::Multiply); break;
+          case OperationType::Divide: this->Emit(InstructionType::Divide); break;
+          default: this->Emit(InstructionType::Pow); break;
+        }
+        --m_StackDepth;
+      }
+    }
+  };
+
+  template <typename TFunction>
+  inline void TransformInPlace(double* values, std::size_t count, TFunction function)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      values[i] = function(values[i]);
+    }
+  }
+
+  template <typename TFunction>
+  inline void Combine(double* left, const double* right, std::size_t count, TFunction function)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      left[i] = function(left[i], right[i]);
+    }
+  }
+
+  void ApplyUnaryToChunk(OperationType operation, double* values, std::size_t count)
+  {
+    switch (operation)
+    {
+      case OperationType::Square: TransformInPlace(values, count, [](double v) { return v * v; }); break;
+      case OperationType::Sqrt: TransformInPlace(values, count, [](double v) { return std::sqrt(v); }); break;
+      case OperationType::Abs: TransformInPlace(values, count, [](double v) { return std::abs(v); }); break;
+      default: TransformInPlace(values, count, [operation](double v) { return ApplyUnary(operation, v); }); break;
+    }
+  }
+
+  /** Evaluates the instructions for the voxels [begin, begin+count).*/
+  void EvaluateChunk(const std::vector<Instruction>& instructions,
+                     const std::vector<const void*>& inputBuffers,
+                     const std::vector<LoadFunctionType>& loadFunctions,
+                     std::vector<std::vector<double>>& stack,
+                     std::size_t begin,
+                     std::size_t count)
+  {
+    std::size_t top = 0;
+
+    for (const auto& instruction : instructions)
+    {
+      double* values = top > 0 ? stack[top - 1].data() : nullptr;
+      const double value = instruction.Value;
+
+      switch (instruction.Type)
+      {
+        case InstructionType::LoadImage:
+          loadFunctions[instruction.Input](inputBuffers[instruction.Input], begin, count, stack[top].data());
+          ++top;
+          break;
+        case InstructionType::LoadValue:
+          std::fill_n(stack[top].data(), count, value);
+          ++top;
+          break;
+        case InstructionType::AddValue: TransformInPlace(values, count, [value](double v) { return v + value; }); break;
+        case InstructionType::SubtractValue: TransformInPlace(values, count, [value](double v) { return v - value; }); break;
+        case InstructionType::ValueSubtract: TransformInPlace(values, count, [value](double v) { return value - v; }); break;
+        case InstructionType::MultiplyValue: TransformInPlace(values, count, [value](double v) { return v * value; }); break;
+        case InstructionType::DivideValue: TransformInPlace(values, count, [value](double v) { return Divide(v, value); }); break;
+        case InstructionType::ValueDivide: TransformInPlace(values, count, [value](double v) { return Divide(value, v); }); break;
+        case InstructionType::PowValue: TransformInPlace(values, count, [value](double v) { return std::pow(v, value); }); break;
+        case InstructionType::ValuePow: TransformInPlace(values, count, [value](double v) { return std::pow(value, v); }); break;
+        case InstructionType::Unary: ApplyUnaryToChunk(instruction.UnaryOperation, values, count); break;
+        default:
+        {
+          // binary instruction: combine the two top buffers into the lower one
+          double* left = stack[top - 2].data();
+          const double* right = values;
+          switch (instruction.Type)
+          {
+            case InstructionType::Add: Combine(left, right, count, [](double l, double r) { return l + r; }); break;
+            case InstructionType::Subtract: Combine(left, right, count, [](double l, double r) { return l - r; }); break;
+            case InstructionType::Multiply: Combine(left, right, count, [](double l, double r) { return l * r; }); break;
+            case InstructionType::Divide: Combine(left, right, count, [](double l, double r) { return Divide(l, r); }); break;
+            default: Combine(left, right, count, [](double l, double r) { return std::pow(l, r); }); break;
+          }
+          --top;
+        }
+      }
+    }
+  }
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(const Image* image)
+{
+  if (nullptr == image)
+  {
+    mitkThrow() << "Cannot create arithmetic expression. Image is nullptr.";
+  }
+
+  auto node = std::make_shared<Node>();
+  node->Operation = OperationType::Image;
+  node->InputImage = image;
+  m_Node = node;
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(double value)
+{
+  auto node = std::make_shared<Node>();
+  node->Operation = OperationType::Value;
+  node->Value = value;
+  m_Node = node;
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(std::shared_ptr<const Node> node) : m_Node(node)
+{
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::MakeOperation(OperationType operation, const ArithmeticExpression& left)
+{
+  auto node = std::make_shared<Node>();
+  node->Operation = operation;
+  node->Left = left.m_Node;
+  return ArithmeticExpression(std::shared_ptr<const Node>(node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::MakeOperation(OperationType operation, const ArithmeticExpression& left, const ArithmeticExpression& right)
+{
+  auto node = std::make_shared<Node>();
+  node->Operation = operation;
+  node->Left = left.m_Node;
+  node->Right = right.m_Node;
+  return ArithmeticExpression(std::shared_ptr<const Node>(node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Add(const ArithmeticExpression& left, const ArithmeticExpression& right)
+{
+  return MakeOperation(OperationType::Add, left, right);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Subtract(const ArithmeticExpression& left, const ArithmeticExpression& right)
+{
+  return MakeOperation(OperationType::Subtract, left, right);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Multiply(const ArithmeticExpression& left, const ArithmeticExpression& right)
+{
+  return MakeOperation(OperationType::Multiply, left, right);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Divide(const ArithmeticExpression& left, const ArithmeticExpression& right)
+{
+  return MakeOperation(OperationType::Divide, left, right);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Pow(const ArithmeticExpression& base, double exponent)
+{
+  return MakeOperation(OperationType::Pow, base, ArithmeticExpression(exponent));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Pow(double base, const ArithmeticExpression& exponent)
+{
+  return MakeOperation(OperationType::Pow, ArithmeticExpression(base), exponent);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Tan(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::Tan, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Atan(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::Atan, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Cos(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::Cos, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Acos(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::Acos, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Sin(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::Sin, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Asin(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::Asin, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Square(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::Square, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Sqrt(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::Sqrt, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Abs(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::Abs, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Exp(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::Exp, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::ExpNeg(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::ExpNeg, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Log10(const ArithmeticExpression& expression)
+{
+  return MakeOperation(OperationType::Log10, expression);
+}
+
+mitk::Image::Pointer mitk::ArithmeticExpression::Evaluate(bool outputAsDouble) const
+{
+  ExpressionCompiler compiler;
+  compiler.Compile(m_Node.get());
+
+  if (compiler.Inputs.empty())
+  {
+    mitkThrow() << "Cannot evaluate arithmetic expression. The expression contains no image.";
+  }
+
+  const Image* referenceImage = compiler.Inputs.front();
+  const unsigned int dimension = referenceImage->GetDimension();
+
+  std::size_t numberOfVoxels = 1;
+  for (unsigned int i = 0; i < dimension; ++i)
+  {
+    numberOfVoxels *= referenceImage->GetDimension(i);
+  }
+
+  // ImageReadAccessor is not copyable, so the accessors are held by pointer
+  std::vector<std::unique_ptr<ImageReadAccessor>> accessors;
+  std::vector<const void*> inputBuffers;
+  std::vector<LoadFunctionType> loadFunctions;
+
+  for (const auto& input : compiler.Inputs)
+  {
+    if (input->GetDimension() != dimension)
+    {
+      mitkThrow() << "Cannot evaluate arithmetic expression. Images have different dimensions.";
+    }
+    for (unsigned int i = 0; i < dimension; ++i)
+    {
+      if (input->GetDimension(i) != referenceImage->GetDimension(i))
+      {
+        mitkThrow() << "Cannot evaluate arithmetic expression. Images have different sizes in dimension " << i << ".";
+      }
+    }
+    // images that are considered equal by NodePredicateGeometry can be combined
+    if (!mitk::Equal(*(input->GetGeometry()), *(referenceImage->GetGeometry()),
+          NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION, NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION))
+    {
+      mitkThrow() << "Cannot evaluate arithmetic expression. Images have different geometries.";
+    }
+
+    LoadFunctionType load = nullptr;
+    StoreFunctionType store = nullptr;
+    GetPixelFunctions(input->GetPixelType(), load, store);
+    loadFunctions.push_back(load);
+
+    accessors.emplace_back(new ImageReadAccessor(input));
+    inputBuffers.push_back(accessors.back()->GetData());
+  }
+
+  const PixelType outputPixelType = outputAsDouble ? MakeScalarPixelType<double>() : referenceImage->GetPixelType();
+  LoadFunctionType outputLoad = nullptr;
+  StoreFunctionType outputStore = nullptr;
+  GetPixelFunctions(outputPixelType, outputLoad, outputStore);
+
+  Image::Pointer result = Image::New();
+  result->Initialize(outputPixelType, dimension, referenceImage->GetDimensions());
+  result->SetTimeGeometry(referenceImage->GetTimeGeometry()->Clone());
+
+  ImageWriteAccessor resultAccessor(result);
+  void* outputBuffer = resultAccessor.GetData();
+
+  const std::size_t numberOfChunks = (numberOfVoxels + ChunkSize - 1) / ChunkSize;
+  const auto& instructions = compiler.Instructions;
+  const unsigned int stackDepth = compiler.MaxStackDepth;
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+  const std::size_t numberOfWorkUnits = std::max<std::size_t>(1, std::min<std::size_t>(multiThreader->GetNumberOfWorkUnits(), numberOfChunks));
+
+  multiThreader->ParallelizeArray(0, numberOfWorkUnits, [&](itk::SizeValueType workUnit)
+  {
+    std::vector<std::vector<double>> stack(stackDepth, std::vector<double>(ChunkSize));
+
+    const std::size_t firstChunk = numberOfChunks * workUnit / numberOfWorkUnits;
+    const std::size_t endChunk = numberOfChunks * (workUnit + 1) / numberOfWorkUnits;
+
+    for (std::size_t chunk = firstChunk; chunk < endChunk; ++chunk)
+    {
+      const std::size_t begin = chunk * ChunkSize;
+      const std::size_t count = std::min(ChunkSize, numberOfVoxels - begin);
+      EvaluateChunk(instructions, inputBuffers, loadFunctions, stack, begin, count);
+      outputStore(stack[0].data(), begin, count, outputBuffer);
+    }
+  }, nullptr);
+
+  return result;
+}
@@ -0,0 +1,228 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <mitkArithmeticExpression.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itkVector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <vector>
+
+class mitkArithmeticExpressionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkArithmeticExpressionTestSuite);
+
+  MITK_TEST(Precedence);
+  MITK_TEST(UnaryMinus);
+  MITK_TEST(Functions);
+  MITK_TEST(DivisionByZero);
+  MITK_TEST(DivisionByZeroSaturatesOutputType);
+  MITK_TEST(InvalidOperands);
+  MITK_TEST(MismatchedImages);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  // more voxels than one chunk of the evaluation, so several chunks and work units are involved
+  static const unsigned int SizeX = 50;
+  static const unsigned int SizeY = 45;
+  static const unsigned int SizeZ = 3;
+
+  mitk::Image::Pointer m_ImageA;
+  mitk::Image::Pointer m_ImageB;
+
+  template <typename TPixel>
+  static mitk::Image::Pointer CreateImage(std::function<double(std::size_t)> valueFunction,
+                                          unsigned int sizeX = SizeX,
+                                          unsigned int sizeY = SizeY,
+                                          unsigned int sizeZ = SizeZ)
+  {
+    unsigned int dimensions[3] = { sizeX, sizeY, sizeZ };
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<TPixel>(), 3, dimensions);
+
+    mitk::ImageWriteAccessor accessor(image);
+    auto *buffer = static_cast<TPixel *>(accessor.GetData());
+    for (std::size_t i = 0; i < std::size_t(sizeX) * sizeY * sizeZ; ++i)
+    {
+      buffer[i] = static_cast<TPixel>(valueFunction(i));
+    }
+    return image;
+  }
+
+  static double ValueA(std::size_t i) { return static_cast<double>(i % 17) - 8.; }
+  static double ValueB(std::size_t i) { return static_cast<double>(i % 5) + 1.; }
+
+  /** Checks each voxel of the double result image against the reference function of the voxel index.*/
+  static void CheckResult(const std::string &message, const mitk::Image *result, std::function<double(double, double)> reference)
+  {
+    CPPUNIT_ASSERT_MESSAGE(message + ": result has wrong pixel type",
+      result->GetPixelType().GetComponentType() == itk::IOComponentEnum::DOUBLE);
+
+    mitk::ImageReadAccessor accessor(result);
+    const auto *buffer = static_cast<const double *>(accessor.GetData());
+    for (std::size_t i = 0; i < std::size_t(SizeX) * SizeY * SizeZ; ++i)
+    {
+      const double expected = reference(ValueA(i), ValueB(i));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(message, expected, buffer[i], 1e-10 * std::max(1., std::abs(expected)));
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_ImageA = CreateImage<double>(ValueA);
+    m_ImageB = CreateImage<short>(ValueB);
+  }
+
+  void tearDown() override
+  {
+    m_ImageA = nullptr;
+    m_ImageB = nullptr;
+  }
+
+  void Precedence()
+  {
+    mitk::ArithmeticExpression a(m_ImageA);
+    mitk::ArithmeticExpression b(m_ImageB);
+
+    CheckResult("a + b * 2", (a + b * 2.).Evaluate(), [](double va, double vb) { return va + vb * 2.; });
+    CheckResult("(a + b) * 2", ((a + b) * 2.).Evaluate(), [](double va, double vb) { return (va + vb) * 2.; });
+    CheckResult("a - b - 3", (a - b - 3.).Evaluate(), [](double va, double vb) { return va - vb - 3.; });
+    CheckResult("a - (b - 3)", (a - (b - 3.)).Evaluate(), [](double va, double vb) { return va - (vb - 3.); });
+    CheckResult("a / b / 2", (a / b / 2.).Evaluate(), [](double va, double vb) { return va / vb / 2.; });
+    CheckResult("a / (b / 2)", (a / (b / 2.)).Evaluate(), [](double va, double vb) { return va / (vb / 2.); });
+    CheckResult("10 - a / b", (10. - a / b).Evaluate(), [](double va, double vb) { return 10. - va / vb; });
+    CheckResult("12 / b - a", (12. / b - a).Evaluate(), [](double va, double vb) { return 12. / vb - va; });
+    // constant subexpressions are folded, the order of the operations must not change
+    CheckResult("a - 2 * 3", (a - mitk::ArithmeticExpression(2.) * 3.).Evaluate(), [](double va, double) { return va - 6.; });
+    CheckResult("(a - 2) * 3", ((a - 2.) * 3.).Evaluate(), [](double va, double) { return (va - 2.) * 3.; });
+    CheckResult("a * a - b * b", (a * a - b * b).Evaluate(), [](double va, double vb) { return va * va - vb * vb; });
+  }
+
+  void UnaryMinus()
+  {
+    mitk::ArithmeticExpression a(m_ImageA);
+    mitk::ArithmeticExpression b(m_ImageB);
+
+    CheckResult("-a", (-a).Evaluate(), [](double va, double) { return -va; });
+    CheckResult("-(a - b)", (-(a - b)).Evaluate(), [](double va, double vb) { return -(va - vb); });
+    CheckResult("b - -a", (b - -a).Evaluate(), [](double va, double vb) { return vb + va; });
+    CheckResult("-a * b", (-a * b).Evaluate(), [](double va, double vb) { return -va * vb; });
+    CheckResult("-2 * a", (-mitk::ArithmeticExpression(2.) * a).Evaluate(), [](double va, double) { return -2. * va; });
+    CheckResult("square(-b)", mitk::ArithmeticExpression::Square(-b).Evaluate(), [](double, double vb) { return vb * vb; });
+  }
+
+  void Functions()
+  {
+    mitk::ArithmeticExpression a(m_ImageA);
+    mitk::ArithmeticExpression b(m_ImageB);
+
+    CheckResult("abs(a)", mitk::ArithmeticExpression::Abs(a).Evaluate(), [](double va, double) { return std::abs(va); });
+    CheckResult("sqrt(b)", mitk::ArithmeticExpression::Sqrt(b).Evaluate(), [](double, double vb) { return std::sqrt(vb); });
+    CheckResult("pow(b, 3)", mitk::ArithmeticExpression::Pow(b, 3.).Evaluate(), [](double, double vb) { return std::pow(vb, 3.); });
+    CheckResult("pow(2, b)", mitk::ArithmeticExpression::Pow(2., b).Evaluate(), [](double, double vb) { return std::pow(2., vb); });
+    CheckResult("log10(b) + exp(-b)", (mitk::ArithmeticExpression::Log10(b) + mitk::ArithmeticExpression::ExpNeg(b)).Evaluate(),
+      [](double, double vb) { return std::log10(vb) + std::exp(-vb); });
+  }
+
+  void DivisionByZero()
+  {
+    mitk::ArithmeticExpression a(m_ImageA);
+    mitk::ArithmeticExpression b(m_ImageB);
+    const double maximum = std::numeric_limits<double>::max();
+
+    // like itk::Functor::Div, division by zero yields the maximum value
+    CheckResult("b / a", (b / a).Evaluate(), [maximum](double va, double vb) { return va != 0. ? vb / va : maximum; });
+    CheckResult("b / 0", (b / 0.).Evaluate(), [maximum](double, double) { return maximum; });
+    CheckResult("1 / a", (1. / a).Evaluate(), [maximum](double va, double) { return va != 0. ? 1. / va : maximum; });
+    CheckResult("a / (b - b)", (a / (b - b)).Evaluate(), [maximum](double, double) { return maximum; });
+  }
+
+  void DivisionByZeroSaturatesOutputType()
+  {
+    mitk::ArithmeticExpression b(m_ImageB);
+
+    auto result = (-b / mitk::ArithmeticExpression(m_ImageA)).Evaluate(false);
+    CPPUNIT_ASSERT_MESSAGE("Result should have the pixel type of the first image",
+      result->GetPixelType().GetComponentType() == itk::IOComponentEnum::SHORT);
+
+    mitk::ImageReadAccessor accessor(result);
+    const auto *buffer = static_cast<const short *>(accessor.GetData());
+    for (std::size_t i = 0; i < std::size_t(SizeX) * SizeY * SizeZ; ++i)
+    {
+      const double a = ValueA(i);
+      const short expected = a != 0. ? static_cast<short>(-ValueB(i) / a) : std::numeric_limits<short>::max();
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Division by zero should saturate to the output type", expected, buffer[i]);
+    }
+  }
+
+  void InvalidOperands()
+  {
+    CPPUNIT_ASSERT_THROW_MESSAGE("Expression without image should not be evaluated",
+      (mitk::ArithmeticExpression(1.) + 2.).Evaluate(), mitk::Exception);
+
+    const mitk::Image *nullImage = nullptr;
+    CPPUNIT_ASSERT_THROW_MESSAGE("Expression of nullptr image should not be created",
+      mitk::ArithmeticExpression{ nullImage }, mitk::Exception);
+
+    unsigned int dimensions[3] = { SizeX, SizeY, SizeZ };
+    auto vectorImage = mitk::Image::New();
+    vectorImage->Initialize(mitk::MakePixelType<float, itk::Vector<float, 3>, 3>(), 3, dimensions);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Expression of non scalar image should not be evaluated",
+      (mitk::ArithmeticExpression(m_ImageA) + mitk::ArithmeticExpression(vectorImage)).Evaluate(), mitk::Exception);
+  }
+
+  void MismatchedImages()
+  {
+    mitk::ArithmeticExpression a(m_ImageA);
+
+    auto smallerImage = CreateImage<double>(ValueB, SizeX, SizeY - 1, SizeZ);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Images of different size should not be combined",
+      (a + mitk::ArithmeticExpression(smallerImage)).Evaluate(), mitk::Exception);
+
+    unsigned int dimensions[2] = { SizeX, SizeY };
+    auto image2D = mitk::Image::New();
+    image2D->Initialize(mitk::MakeScalarPixelType<double>(), 2, dimensions);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Images of different dimension should not be combined",
+      (a + mitk::ArithmeticExpression(image2D)).Evaluate(), mitk::Exception);
+
+    auto spacingImage = CreateImage<double>(ValueB);
+    mitk::Vector3D spacing;
+    spacing.Fill(2.);
+    spacingImage->GetGeometry()->SetSpacing(spacing);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Images of different spacing should not be combined",
+      (a + mitk::ArithmeticExpression(spacingImage)).Evaluate(), mitk::Exception);
+
+    auto originImage = CreateImage<double>(ValueB);
+    mitk::Point3D origin;
+    origin.Fill(5.);
+    originImage->GetGeometry()->SetOrigin(origin);
+    CPPUNIT_ASSERT_THROW_MESSAGE("Images of different origin should not be combined",
+      (a + mitk::ArithmeticExpression(originImage)).Evaluate(), mitk::Exception);
+
+    // the result has the geometry of the first image
+    auto result = (mitk::ArithmeticExpression(originImage) * 2.).Evaluate();
+    CPPUNIT_ASSERT_MESSAGE("Result should have the geometry of the first image",
+      mitk::Equal(*(originImage->GetGeometry()), *(result->GetGeometry()), mitk::eps, true));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkArithmeticExpression)
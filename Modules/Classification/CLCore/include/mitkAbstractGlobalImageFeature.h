@@ -22,8 +22,10 @@ found in the LICENSE file.
 #include <mitkCommandLineParser.h>
 
 #include <mitkIntensityQuantifier.h>
+#include <mitkGlobalImageFeaturePreprocessing.h>
 
 // STD Includes
+#include <functional>
 
 // Eigen
 #include <itkeigen/Eigen/Dense>
@@ -225,6 +227,12 @@ public:
   itkSetMacro(MorphMask, mitk::Image::Pointer);
   itkGetConstMacro(MorphMask, mitk::Image::Pointer);
 
+  /** Preprocessing results that are shared with other feature classes. If set and its image (or a registered
+  * copy of it) is the image passed to the calculation, cached results (e.g. the intensity range used to
+  * initialize the quantifier) are used instead of scanning the image again. Optional.*/
+  itkSetMacro(Preprocessing, GlobalImageFeaturePreprocessing::Pointer);
+  itkGetConstMacro(Preprocessing, GlobalImageFeaturePreprocessing::Pointer);
+
   itkSetMacro(Bins, int);
   itkSetMacro(UseBins, bool);
   itkGetConstMacro(UseBins, bool);
@@ -270,6 +278,18 @@ protected:
   /**Initializes the quantifier gigen the quantifier relevant variables and the passed arguments.*/
   void InitializeQuantifier(const Image* image, const Image* mask, unsigned int defaultBins = 256);
 
+  /** Returns the preprocessing instance if it is set and refers to the passed image (or a registered copy
+  * of it, see GlobalImageFeaturePreprocessing::AddImageCopy), otherwise nullptr.
+  * Feature classes use this to decide if they can work on the shared preprocessing results.*/
+  GlobalImageFeaturePreprocessing* GetPreprocessingForImage(const Image* image) const;
+
+  /** Provides the minimum and maximum intensity of the image or of the masked image region.*/
+  using IntensityRangeFunctionType = std::function<void(double& minimum, double& maximum)>;
+
+  /** Initializes the quantifier given the quantifier relevant variables. The passed functions are only called
+  * if the intensity range of the image or the masked region is needed by the settings.*/
+  void InitializeQuantifierByIntensityRanges(const IntensityRangeFunctionType& imageRange, const IntensityRangeFunctionType& regionRange, unsigned int defaultBins);
+
   /** Helper that encodes the quantifier parameters in a string (e.g. used for the legacy feature name)*/
   std::string QuantifierParameterString() const;
 
@@ -316,6 +336,7 @@ private:
   ParametersType m_Parameters; // Parameter setting
 
   mitk::Image::Pointer m_MorphMask = nullptr;
+  GlobalImageFeaturePreprocessing::Pointer m_Preprocessing;
 
 
   IntensityQuantifier::Pointer m_Quantifier;
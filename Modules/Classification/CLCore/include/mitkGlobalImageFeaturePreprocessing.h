@@ -0,0 +1,159 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+
+#ifndef mitkGlobalImageFeaturePreprocessing_h
+#define mitkGlobalImageFeaturePreprocessing_h
+
+#include <MitkCLCoreExports.h>
+
+#include <mitkImage.h>
+#include <mitkIntensityQuantifier.h>
+
+#include <itkObject.h>
+#include <itkOffset.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace mitk
+{
+  /**
+  * \brief Holds the preprocessing results that are shared by all feature classes analyzing the same image.
+  *
+  * Most feature classes derived from AbstractGlobalImageFeature start by scanning the image (and mask)
+  * for the intensity range, collecting the masked voxels, quantizing their intensities and building the
+  * neighborhood offsets. If an instance of this class is passed to the feature classes
+  * (see AbstractGlobalImageFeature::SetPreprocessing), these intermediate results are computed only once
+  * per image/mask pair and reused by every feature class.
+  *
+  * All results are computed lazily on first request. The getters are thread safe, so independent
+  * feature classes can be evaluated in parallel on one instance. Threads that work on their own copies of
+  * the image and masks register them (see AddImageCopy and AddMaskCopy) to share the results. Returned references stay valid as long
+  * as the instance exists and the image is not changed.
+  *
+  * Voxels are addressed by their offset in the (3D) image buffer. 2D images are treated as images with
+  * a single slice.
+  */
+  class MITKCLCORE_EXPORT GlobalImageFeaturePreprocessing : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(GlobalImageFeaturePreprocessing, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    using OffsetType = itk::Offset<3>;
+    using BufferOffsetType = itk::OffsetValueType;
+
+    /** All voxels of the image that are inside of a mask (mask value > 0).*/
+    struct MaskedVoxels
+    {
+      /** Buffer offsets of the masked voxels in ascending order.*/
+      std::vector<BufferOffsetType> offsets;
+      /** Intensity of each masked voxel (same order as offsets).*/
+      std::vector<double> values;
+      /** Minimum intensity inside the mask.*/
+      double minimum = 0;
+      /** Maximum intensity inside the mask.*/
+      double maximum = 0;
+    };
+
+    /** Bin index of each masked voxel (same order as MaskedVoxels::offsets).*/
+    using QuantizedVoxels = std::vector<unsigned int>;
+
+    /** Neighbor offset in index space and in buffer space.*/
+    struct NeighborOffset
+    {
+      OffsetType offset;
+      BufferOffsetType bufferOffset;
+    };
+    /** Table with one entry per neighborhood direction.*/
+    using NeighborOffsetTableType = std::vector<NeighborOffset>;
+
+    /** Sets the image all results refer to. Resets all cached results.*/
+    void SetImage(const Image* image);
+    const Image* GetImage() const;
+
+    /** Registers a copy of the image (e.g. the copy used by one calculation thread), so that the results are
+    * shared with the copy. The copy must not be changed as long as it is registered.*/
+    void AddImageCopy(const Image* copy);
+
+    /** Registers a copy of a mask, so that the results computed for the mask are shared with the copy.*/
+    void AddMaskCopy(const Image* copy, const Image* mask);
+
+    /** Checks if the results refer to the passed image, i.e. if it is the image or a registered copy of it.*/
+    bool RefersTo(const Image* image) const;
+
+    /** Size of the image in each of the three dimensions.*/
+    itk::Size<3> GetImageSize() const;
+
+    /** Minimum and maximum intensity of the whole image.*/
+    void GetImageMinMax(double& minimum, double& maximum);
+
+    /** Returns the voxels of the image that are inside the passed mask.
+    * The mask has to cover the same index space as the image.*/
+    const MaskedVoxels& GetMaskedVoxels(const Image* mask);
+
+    /** Returns the bin index of all masked voxels (see GetMaskedVoxels) for the passed quantifier.
+    * Results are cached per mask and quantifier setting (minimum, binsize, bins).*/
+    const QuantizedVoxels& GetQuantizedVoxels(const Image* mask, IntensityQuantifier* quantifier);
+
+    /** Returns the neighbor offsets of the 3^D neighborhood scaled by range. Only one of each pair of opposite
+    * directions is included (13 directions in 3D, 4 in 2D).*/
+    const NeighborOffsetTableType& GetNeighborOffsets(int range);
+
+    /** Converts a buffer offset into an index.*/
+    OffsetType BufferOffsetToIndex(BufferOffsetType bufferOffset) const;
+
+    /** Checks if index + offset is inside of the image.*/
+    bool IsInside(const OffsetType& index, const OffsetType& offset) const;
+
+  protected:
+    GlobalImageFeaturePreprocessing();
+    ~GlobalImageFeaturePreprocessing() override;
+
+  private:
+    using QuantizerKeyType = std::tuple<const Image*, double, double, unsigned int>;
+
+    struct MaskEntry
+    {
+      Image::ConstPointer mask;
+      MaskedVoxels voxels;
+    };
+
+    void EnsureImageMinMax();
+    const MaskedVoxels& GetMaskedVoxelsUnlocked(const Image* mask);
+    const Image* GetOriginalMaskUnlocked(const Image* mask) const;
+
+    Image::ConstPointer m_Image;
+    itk::Size<3> m_Size;
+    BufferOffsetType m_Strides[3];
+
+    bool m_ImageMinMaxValid = false;
+    double m_ImageMinimum = 0;
+    double m_ImageMaximum = 0;
+
+    std::set<const Image*> m_ImageCopies;
+    std::map<const Image*, const Image*> m_MaskCopies;
+
+    std::map<const Image*, std::unique_ptr<MaskEntry>> m_MaskedVoxels;
+    std::map<QuantizerKeyType, std::unique_ptr<QuantizedVoxels>> m_QuantizedVoxels;
+    std::map<int, std::unique_ptr<NeighborOffsetTableType>> m_NeighborOffsets;
+
+    mutable std::mutex m_Mutex;
+  };
+}
+
+#endif
@@ -46,6 +46,11 @@ public:
   void InitializeByImageRegionAndBinsizeAndMinimum(const Image* image, const Image* mask, double minimum, double binsize);
   void InitializeByImageRegionAndBinsizeAndMaximum(const Image* image, const Image* mask, double maximum, double binsize);
 
+  /** Minimum and maximum intensity of the whole image, as used by the image based initializations.*/
+  static void GetImageMinMax(const Image* image, double& minimum, double& maximum);
+  /** Minimum and maximum intensity inside the mask (mask value > 0), as used by the region based initializations.*/
+  static void GetImageRegionMinMax(const Image* image, const Image* mask, double& minimum, double& maximum);
+
   unsigned int IntensityToIndex(double intensity);
   double IndexToMinimumIntensity(unsigned int index);
   double IndexToMeanIntensity(unsigned int index);
@@ -255,6 +255,34 @@ void mitk::AbstractGlobalImageFeature::ConfigureSettingsByParameters(const Param
 
 void  mitk::AbstractGlobalImageFeature::InitializeQuantifier(const Image* image, const Image* mask, unsigned int defaultBins)
 {
+  auto preprocessing = this->GetPreprocessingForImage(image);
+  if (nullptr != preprocessing)
+  {
+    // Use the cached intensity ranges instead of scanning the image again.
+    this->InitializeQuantifierByIntensityRanges(
+      [preprocessing](double& minimum, double& maximum) { preprocessing->GetImageMinMax(minimum, maximum); },
+      [preprocessing, mask](double& minimum, double& maximum)
+      {
+        const auto& voxels = preprocessing->GetMaskedVoxels(mask);
+        minimum = voxels.minimum;
+        maximum = voxels.maximum;
+      },
+      defaultBins);
+  }
+  else
+  {
+    this->InitializeQuantifierByIntensityRanges(
+      [image](double& minimum, double& maximum) { IntensityQuantifier::GetImageMinMax(image, minimum, maximum); },
+      [image, mask](double& minimum, double& maximum) { IntensityQuantifier::GetImageRegionMinMax(image, mask, minimum, maximum); },
+      defaultBins);
+  }
+}
+
+void mitk::AbstractGlobalImageFeature::InitializeQuantifierByIntensityRanges(const IntensityRangeFunctionType& imageRange, const IntensityRangeFunctionType& regionRange, unsigned int defaultBins)
+{
+  double minimum = 0;
+  double maximum = 0;
+
   m_Quantifier = IntensityQuantifier::New();
   if (GetUseMinimumIntensity() && GetUseMaximumIntensity() && GetUseBinsize())
     m_Quantifier->InitializeByBinsizeAndMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBinsize());
@@ -262,39 +290,51 @@ void  mitk::AbstractGlobalImageFeature::InitializeQuantifier(const Image* image,
     m_Quantifier->InitializeByBinsizeAndBins(GetMinimumIntensity(), GetBins(), GetBinsize());
   else if (GetUseMinimumIntensity() && GetUseMaximumIntensity() && GetUseBins())
     m_Quantifier->InitializeByMinimumMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBins());
-  // Initialize from Image and Binsize
-  else if (GetUseBinsize() && GetIgnoreMask() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageAndBinsizeAndMinimum(image, GetMinimumIntensity(), GetBinsize());
-  else if (GetUseBinsize() && GetIgnoreMask() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageAndBinsizeAndMaximum(image, GetMaximumIntensity(), GetBinsize());
-  else if (GetUseBinsize() && GetIgnoreMask())
-    m_Quantifier->InitializeByImageAndBinsize(image, GetBinsize());
-  // Initialize form Image, Mask and Binsize
-  else if (GetUseBinsize() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageRegionAndBinsizeAndMinimum(image, mask, GetMinimumIntensity(), GetBinsize());
-  else if (GetUseBinsize() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageRegionAndBinsizeAndMaximum(image, mask, GetMaximumIntensity(), GetBinsize());
+  // Initialize from Image (or Image and Mask) and Binsize. A given minimum takes precedence over a given maximum.
   else if (GetUseBinsize())
-    m_Quantifier->InitializeByImageRegionAndBinsize(image, mask, GetBinsize());
-  // Initialize from Image and Bins
-  else if (GetUseBins() && GetIgnoreMask() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageAndMinimum(image, GetMinimumIntensity(), GetBins());
-  else if (GetUseBins() && GetIgnoreMask() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageAndMaximum(image, GetMaximumIntensity(), GetBins());
-  else if (GetUseBins())
-    m_Quantifier->InitializeByImage(image, GetBins());
-  // Initialize from Image, Mask and Bins
-  else if (GetUseBins() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageRegionAndMinimum(image, mask, GetMinimumIntensity(), GetBins());
-  else if (GetUseBins() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageRegionAndMaximum(image, mask, GetMaximumIntensity(), GetBins());
+  {
+    if (GetIgnoreMask())
+      imageRange(minimum, maximum);
+    else
+      regionRange(minimum, maximum);
+
+    if (GetUseMinimumIntensity())
+      minimum = GetMinimumIntensity();
+    else if (GetUseMaximumIntensity())
+      maximum = GetMaximumIntensity();
+    m_Quantifier->InitializeByBinsizeAndMaximum(minimum, maximum, GetBinsize());
+  }
+  // Initialize from Image and Bins. The mask is not used for the range in this case.
   else if (GetUseBins())
-    m_Quantifier->InitializeByImageRegion(image, mask, GetBins());
+  {
+    imageRange(minimum, maximum);
+
+    if (GetIgnoreMask() && GetUseMinimumIntensity())
+      minimum = GetMinimumIntensity();
+    else if (GetIgnoreMask() && GetUseMaximumIntensity())
+      maximum = GetMaximumIntensity();
+    m_Quantifier->InitializeByMinimumMaximum(minimum, maximum, GetBins());
+  }
   // Default
   else if (GetIgnoreMask())
-    m_Quantifier->InitializeByImage(image, GetBins());
+  {
+    imageRange(minimum, maximum);
+    m_Quantifier->InitializeByMinimumMaximum(minimum, maximum, GetBins());
+  }
   else
-    m_Quantifier->InitializeByImageRegion(image, mask, defaultBins);
+  {
+    regionRange(minimum, maximum);
+    m_Quantifier->InitializeByMinimumMaximum(minimum, maximum, defaultBins);
+  }
+}
+
+mitk::GlobalImageFeaturePreprocessing* mitk::AbstractGlobalImageFeature::GetPreprocessingForImage(const Image* image) const
+{
+  if (m_Preprocessing.IsNotNull() && nullptr != image && m_Preprocessing->RefersTo(image))
+  {
+    return m_Preprocessing;
+  }
+  return nullptr;
 }
 
 std::string mitk::AbstractGlobalImageFeature::GenerateLegacyFeatureName(const FeatureID& id) const
@@ -0,0 +1,271 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkGlobalImageFeaturePreprocessing.h>
+
+// STD
+#include <limits>
+
+// ITK
+#include <itkImageRegionConstIterator.h>
+
+// MITK
+#include <mitkImageCast.h>
+#include <mitkImageAccessByItk.h>
+
+template<typename TPixel, unsigned int VImageDimension>
+static void
+CalculateImageMinMax(const itk::Image<TPixel, VImageDimension>* itkImage, double &minimum, double &maximum)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+
+  minimum = std::numeric_limits<TPixel>::max();
+  maximum = std::numeric_limits<TPixel>::lowest();
+
+  itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
+
+  while (!iter.IsAtEnd())
+  {
+    minimum = std::min<TPixel>(minimum, iter.Get());
+    maximum = std::max<TPixel>(maximum, iter.Get());
+    ++iter;
+  }
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+static void
+ExtractMaskedVoxels(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, mitk::GlobalImageFeaturePreprocessing::MaskedVoxels &voxels)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+  typedef itk::Image<int, VImageDimension> MaskType;
+
+  typename MaskType::Pointer itkMask = MaskType::New();
+  mitk::CastToItkImage(mask, itkMask);
+
+  // Same semantic as the region based initialization of mitk::IntensityQuantifier,
+  // so that quantifiers initialized from the cached range are identical.
+  voxels.minimum = std::numeric_limits<TPixel>::max();
+  voxels.maximum = std::numeric_limits<TPixel>::lowest();
+
+  itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<MaskType> maskIter(itkMask, itkMask->GetLargestPossibleRegion());
+
+  itk::OffsetValueType offset = 0;
+  while (!iter.IsAtEnd())
+  {
+    if (maskIter.Get() > 0)
+    {
+      voxels.offsets.push_back(offset);
+      voxels.values.push_back(iter.Get());
+      voxels.minimum = std::min<TPixel>(voxels.minimum, iter.Get());
+      voxels.maximum = std::max<TPixel>(voxels.maximum, iter.Get());
+    }
+    ++iter;
+    ++maskIter;
+    ++offset;
+  }
+}
+
+mitk::GlobalImageFeaturePreprocessing::GlobalImageFeaturePreprocessing()
+{
+  m_Size.Fill(1);
+  m_Strides[0] = 1;
+  m_Strides[1] = 1;
+  m_Strides[2] = 1;
+}
+
+mitk::GlobalImageFeaturePreprocessing::~GlobalImageFeaturePreprocessing() = default;
+
+void mitk::GlobalImageFeaturePreprocessing::SetImage(const Image* image)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Image = image;
+  m_ImageCopies.clear();
+  m_MaskCopies.clear();
+  m_ImageMinMaxValid = false;
+  m_MaskedVoxels.clear();
+  m_QuantizedVoxels.clear();
+  m_NeighborOffsets.clear();
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    m_Size[i] = nullptr != image ? image->GetDimension(i) : 1;
+  }
+  m_Strides[0] = 1;
+  m_Strides[1] = m_Size[0];
+  m_Strides[2] = m_Size[0] * m_Size[1];
+
+  this->Modified();
+}
+
+const mitk::Image* mitk::GlobalImageFeaturePreprocessing::GetImage() const
+{
+  return m_Image;
+}
+
+void mitk::GlobalImageFeaturePreprocessing::AddImageCopy(const Image* copy)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_ImageCopies.insert(copy);
+}
+
+void mitk::GlobalImageFeaturePreprocessing::AddMaskCopy(const Image* copy, const Image* mask)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (copy != mask)
+  {
+    m_MaskCopies[copy] = this->GetOriginalMaskUnlocked(mask);
+  }
+}
+
+bool mitk::GlobalImageFeaturePreprocessing::RefersTo(const Image* image) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return nullptr != image && (m_Image.GetPointer() == image || m_ImageCopies.count(image) > 0);
+}
+
+const mitk::Image* mitk::GlobalImageFeaturePreprocessing::GetOriginalMaskUnlocked(const Image* mask) const
+{
+  auto finding = m_MaskCopies.find(mask);
+  return finding != m_MaskCopies.end() ? finding->second : mask;
+}
+
+itk::Size<3> mitk::GlobalImageFeaturePreprocessing::GetImageSize() const
+{
+  return m_Size;
+}
+
+void mitk::GlobalImageFeaturePreprocessing::EnsureImageMinMax()
+{
+  if (!m_ImageMinMaxValid)
+  {
+    AccessByItk_2(m_Image, CalculateImageMinMax, m_ImageMinimum, m_ImageMaximum);
+    m_ImageMinMaxValid = true;
+  }
+}
+
+void mitk::GlobalImageFeaturePreprocessing::GetImageMinMax(double& minimum, double& maximum)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  this->EnsureImageMinMax();
+  minimum = m_ImageMinimum;
+  maximum = m_ImageMaximum;
+}
+
+const mitk::GlobalImageFeaturePreprocessing::MaskedVoxels& mitk::GlobalImageFeaturePreprocessing::GetMaskedVoxels(const Image* mask)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return this->GetMaskedVoxelsUnlocked(mask);
+}
+
+const mitk::GlobalImageFeaturePreprocessing::MaskedVoxels& mitk::GlobalImageFeaturePreprocessing::GetMaskedVoxelsUnlocked(const Image* mask)
+{
+  mask = this->GetOriginalMaskUnlocked(mask);
+
+  auto finding = m_MaskedVoxels.find(mask);
+  if (finding != m_MaskedVoxels.end())
+  {
+    return finding->second->voxels;
+  }
+
+  auto entry = std::make_unique<MaskEntry>();
+  entry->mask = mask;
+  AccessByItk_2(m_Image, ExtractMaskedVoxels, mask, entry->voxels);
+
+  auto& voxels = entry->voxels;
+  m_MaskedVoxels.emplace(mask, std::move(entry));
+  return voxels;
+}
+
+const mitk::GlobalImageFeaturePreprocessing::QuantizedVoxels& mitk::GlobalImageFeaturePreprocessing::GetQuantizedVoxels(const Image* mask, IntensityQuantifier* quantifier)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  QuantizerKeyType key(this->GetOriginalMaskUnlocked(mask), quantifier->GetMinimum(), quantifier->GetBinsize(), quantifier->GetBins());
+  auto finding = m_QuantizedVoxels.find(key);
+  if (finding != m_QuantizedVoxels.end())
+  {
+    return *(finding->second);
+  }
+
+  const auto& voxels = this->GetMaskedVoxelsUnlocked(mask);
+  auto quantized = std::make_unique<QuantizedVoxels>(voxels.values.size());
+  for (std::size_t i = 0; i < voxels.values.size(); ++i)
+  {
+    (*quantized)[i] = quantifier->IntensityToIndex(voxels.values[i]);
+  }
+
+  auto& result = *quantized;
+  m_QuantizedVoxels.emplace(key, std::move(quantized));
+  return result;
+}
+
+const mitk::GlobalImageFeaturePreprocessing::NeighborOffsetTableType& mitk::GlobalImageFeaturePreprocessing::GetNeighborOffsets(int range)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto finding = m_NeighborOffsets.find(range);
+  if (finding != m_NeighborOffsets.end())
+  {
+    return *(finding->second);
+  }
+
+  // Same order as the first half of an itk::Neighborhood with radius 1 (first index runs fastest),
+  // i.e. all offsets in front of the center.
+  bool is2D = m_Image.IsNotNull() && m_Image->GetDimension() == 2;
+  auto table = std::make_unique<NeighborOffsetTableType>();
+  for (int d = 0; d < 13; ++d)
+  {
+    int x = d % 3 - 1;
+    int y = (d / 3) % 3 - 1;
+    int z = d / 9 - 1;
+    if (is2D && z != 0)
+    {
+      continue;
+    }
+    NeighborOffset neighbor;
+    neighbor.offset[0] = x * range;
+    neighbor.offset[1] = y * range;
+    neighbor.offset[2] = z * range;
+    neighbor.bufferOffset = neighbor.offset[0] * m_Strides[0] + neighbor.offset[1] * m_Strides[1] + neighbor.offset[2] * m_Strides[2];
+    table->push_back(neighbor);
+  }
+
+  auto& result = *table;
+  m_NeighborOffsets.emplace(range, std::move(table));
+  return result;
+}
+
+mitk::GlobalImageFeaturePreprocessing::OffsetType mitk::GlobalImageFeaturePreprocessing::BufferOffsetToIndex(BufferOffsetType bufferOffset) const
+{
+  OffsetType index;
+  index[2] = bufferOffset / m_Strides[2];
+  bufferOffset -= index[2] * m_Strides[2];
+  index[1] = bufferOffset / m_Strides[1];
+  index[0] = bufferOffset - index[1] * m_Strides[1];
+  return index;
+}
+
+bool mitk::GlobalImageFeaturePreprocessing::IsInside(const OffsetType& index, const OffsetType& offset) const
+{
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    auto position = index[i] + offset[i];
+    if (position < 0 || position >= static_cast<itk::OffsetValueType>(m_Size[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
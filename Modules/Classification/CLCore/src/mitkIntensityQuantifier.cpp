@@ -173,6 +173,14 @@ void mitk::IntensityQuantifier::InitializeByImageRegionAndBinsizeAndMaximum(cons
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
+void mitk::IntensityQuantifier::GetImageMinMax(const Image* image, double& minimum, double& maximum) {
+  AccessByItk_2(image, CalculateImageMinMax, minimum, maximum);
+}
+
+void mitk::IntensityQuantifier::GetImageRegionMinMax(const Image* image, const Image* mask, double& minimum, double& maximum) {
+  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, maximum);
+}
+
 unsigned int mitk::IntensityQuantifier::IntensityToIndex(double intensity)
 {
   double index = std::floor((intensity - m_Minimum) / m_Binsize);
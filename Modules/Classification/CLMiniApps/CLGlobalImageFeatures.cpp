@@ -21,6 +21,7 @@ found in the LICENSE file.
 
 #include <mitkSplitParameterToVector.h>
 #include <mitkGlobalImageFeaturesParameter.h>
+#include <mitkGlobalImageFeaturePreprocessing.h>
 
 #include <mitkGIFCooccurenceMatrix.h>
 #include <mitkGIFCooccurenceMatrix2.h>
@@ -670,11 +671,60 @@ int main(int argc, char* argv[])
 
     mitk::AbstractGlobalImageFeature::FeatureListType stats;
 
+    // The feature classes are independent of each other and are therefore calculated in parallel.
+    // They run ITK/MITK filters on their inputs, so every thread works on its own copies of the
+    // images and masks. Quantization ranges, masked voxels and neighborhood offsets are computed
+    // once per image/mask pair and shared by all threads, which register their copies.
+    std::vector<mitk::AbstractGlobalImageFeature::FeatureListType> featureClassStats(features.size());
     for (auto cFeature : features)
     {
       log << " Calculating " << cFeature->GetFeatureClassName() << " -";
-      cFeature->SetMorphMask(cMorphMask);
-      cFeature->CalculateAndAppendFeatures(cImage, cMask, cMaskNoNaN, stats, !param.calculateAllFeatures);
+    }
+
+    const int numberOfFeatureClasses = static_cast<int>(features.size());
+    const bool copyInputs = param.numberOfFeatureThreads > 1 && numberOfFeatureClasses > 1;
+
+    auto preprocessing = mitk::GlobalImageFeaturePreprocessing::New();
+    preprocessing->SetImage(cImage);
+    double imageMinimum = 0;
+    double imageMaximum = 0;
+    preprocessing->GetImageMinMax(imageMinimum, imageMaximum);
+    preprocessing->GetMaskedVoxels(cMask);
+    preprocessing->GetMaskedVoxels(cMaskNoNaN);
+
+#pragma omp parallel num_threads(param.numberOfFeatureThreads)
+    {
+      mitk::Image::Pointer threadImage = cImage;
+      mitk::Image::Pointer threadMask = cMask;
+      mitk::Image::Pointer threadMaskNoNaN = cMaskNoNaN;
+      mitk::Image::Pointer threadMorphMask = cMorphMask;
+
+      if (copyInputs)
+      {
+#pragma omp critical
+        {
+          threadImage = cImage->Clone();
+          threadMask = cMask->Clone();
+          threadMaskNoNaN = cMaskNoNaN->Clone();
+          threadMorphMask = cMorphMask.IsNotNull() ? cMorphMask->Clone() : mitk::Image::Pointer();
+        }
+        preprocessing->AddImageCopy(threadImage);
+        preprocessing->AddMaskCopy(threadMask, cMask);
+        preprocessing->AddMaskCopy(threadMaskNoNaN, cMaskNoNaN);
+      }
+
+#pragma omp for schedule(dynamic)
+      for (int i = 0; i < numberOfFeatureClasses; ++i)
+      {
+        features[i]->SetMorphMask(threadMorphMask);
+        features[i]->SetPreprocessing(preprocessing);
+        features[i]->CalculateAndAppendFeatures(threadImage, threadMask, threadMaskNoNaN, featureClassStats[i], !param.calculateAllFeatures);
+      }
+    }
+
+    for (const auto& featureClassStat : featureClassStats)
+    {
+      stats.insert(stats.end(), featureClassStat.begin(), featureClassStat.end());
     }
 
     for (std::size_t i = 0; i < stats.size(); ++i)
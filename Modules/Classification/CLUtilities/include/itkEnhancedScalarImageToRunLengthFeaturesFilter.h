@@ -217,6 +217,10 @@ namespace itk
 
       void FullCompute();
 
+      /** Creates a new run length matrix generator with the same settings and
+      inputs as the internal one.*/
+      typename RunLengthMatrixFilterType::Pointer CreateRunLengthMatrixGenerator() const;
+
       /** This method causes the filter to generate its output. */
       void GenerateData() ITK_OVERRIDE;
 
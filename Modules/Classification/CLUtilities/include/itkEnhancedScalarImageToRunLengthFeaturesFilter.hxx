@@ -34,6 +34,7 @@ found in the LICENSE file.
 #include "itkNeighborhood.h"
 #include <itkImageRegionConstIterator.h>
 #include "vnl/vnl_math.h"
+#include <vector>
 
 namespace itk
 {
@@ -159,42 +160,44 @@ namespace itk
         InternalRunLengthFeatureName;
 
       OffsetVectorPointer offsets = OffsetVector::New();
-      if (m_CombinedFeatureCalculation)
+      std::vector<OffsetType> offsetList;
+      for( offsetIt = this->m_Offsets->Begin(); offsetIt != this->m_Offsets->End(); offsetIt++ )
       {
-        for (int i = 0; i < this->m_Offsets->Size(); ++i)
-        {
-          offsets->push_back(m_Offsets->ElementAt(i));
-        }
+        offsets->push_back(offsetIt.Value());
+        offsetList.push_back(offsetIt.Value());
       }
 
-
-      for( offsetIt = this->m_Offsets->Begin(), offsetNum = 0;
-        offsetIt != this->m_Offsets->End(); offsetIt++, offsetNum++ )
+      // The run length matrices of the individual offsets are independent of each other,
+      // so each offset is processed by its own matrix generator in parallel.
+#pragma omp parallel for schedule(dynamic)
+      for( int offsetIndex = 0; offsetIndex < numOffsets; offsetIndex++ )
       {
-        this->m_RunLengthMatrixGenerator->SetOffset(offsetIt.Value());
+        typename RunLengthMatrixFilterType::Pointer runLengthMatrixGenerator = this->CreateRunLengthMatrixGenerator();
+
         if (m_CombinedFeatureCalculation)
         {
-          this->m_RunLengthMatrixGenerator->SetOffsets(offsets);
+          runLengthMatrixGenerator->SetOffsets(offsets);
         }
-        this->m_RunLengthMatrixGenerator->Update();
+        else
+        {
+          runLengthMatrixGenerator->SetOffset(offsetList[offsetIndex]);
+        }
+        runLengthMatrixGenerator->Update();
         typename RunLengthFeaturesFilterType::Pointer runLengthMatrixCalculator =
           RunLengthFeaturesFilterType::New();
         runLengthMatrixCalculator->SetInput(
-          this->m_RunLengthMatrixGenerator->GetOutput() );
+          runLengthMatrixGenerator->GetOutput() );
         runLengthMatrixCalculator->SetNumberOfVoxels(numberOfVoxels);
         runLengthMatrixCalculator->Update();
 
         typename FeatureNameVector::ConstIterator fnameIt;
-        for( fnameIt = this->m_RequestedFeatures->Begin(), featureNum = 0;
-          fnameIt != this->m_RequestedFeatures->End(); fnameIt++, featureNum++ )
+        int featureIndex = 0;
+        for( fnameIt = this->m_RequestedFeatures->Begin();
+          fnameIt != this->m_RequestedFeatures->End(); fnameIt++, featureIndex++ )
         {
-          features[offsetNum][featureNum] = runLengthMatrixCalculator->GetFeature(
+          features[offsetIndex][featureIndex] = runLengthMatrixCalculator->GetFeature(
             ( InternalRunLengthFeatureName )fnameIt.Value() );
         }
-        if (m_CombinedFeatureCalculation)
-        {
-          break;
-        }
       }
 
       // Now get the mean and deviaton of each feature across the offsets.
@@ -262,6 +265,34 @@ namespace itk
       delete[] features;
     }
 
+    template<typename TImage, typename THistogramFrequencyContainer>
+    typename
+      EnhancedScalarImageToRunLengthFeaturesFilter<TImage, THistogramFrequencyContainer>
+      ::RunLengthMatrixFilterType::Pointer
+      EnhancedScalarImageToRunLengthFeaturesFilter<TImage, THistogramFrequencyContainer>
+      ::CreateRunLengthMatrixGenerator() const
+    {
+      typename RunLengthMatrixFilterType::Pointer generator = RunLengthMatrixFilterType::New();
+
+      // Each generator works on its own view of the images (sharing the pixel buffers),
+      // so that the pipeline updates of concurrent generators do not interfere.
+      ImagePointer input = ImageType::New();
+      input->Graft(this->m_RunLengthMatrixGenerator->GetInput());
+      generator->SetInput(input);
+      if (this->m_RunLengthMatrixGenerator->GetMaskImage() != nullptr)
+      {
+        ImagePointer mask = ImageType::New();
+        mask->Graft(this->m_RunLengthMatrixGenerator->GetMaskImage());
+        generator->SetMaskImage(mask);
+      }
+
+      generator->SetNumberOfBinsPerAxis(this->m_RunLengthMatrixGenerator->GetNumberOfBinsPerAxis());
+      generator->SetPixelValueMinMax(this->m_RunLengthMatrixGenerator->GetMin(), this->m_RunLengthMatrixGenerator->GetMax());
+      generator->SetDistanceValueMinMax(this->m_RunLengthMatrixGenerator->GetMinDistance(), this->m_RunLengthMatrixGenerator->GetMaxDistance());
+      generator->SetInsidePixelValue(this->m_RunLengthMatrixGenerator->GetInsidePixelValue());
+      return generator;
+    }
+
     template<typename TImage, typename THistogramFrequencyContainer>
     void
       EnhancedScalarImageToRunLengthFeaturesFilter<TImage, THistogramFrequencyContainer>
@@ -70,6 +70,7 @@ namespace mitk
       bool encodeParameter;
       std::string pipelineUID;
       bool calculateAllFeatures;
+      int numberOfFeatureThreads;
 
     private:
       void ParseFileLocations(std::map<std::string, us::Any> &parsedArgs);
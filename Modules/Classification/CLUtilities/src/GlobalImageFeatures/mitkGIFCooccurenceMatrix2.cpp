@@ -23,8 +23,12 @@ found in the LICENSE file.
 #include <itkImageRegionConstIterator.h>
 
 // STL
+#include <algorithm>
 #include <sstream>
 #include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 namespace mitk
 {
@@ -39,9 +43,14 @@ namespace mitk
     FeatureID id;
   };
 
+  /** Sparse co-occurrence matrix. Entries are accumulated with Add() and
+  * converted into a row-major sorted list of nonzero entries by Finalize(),
+  * which is what the feature calculation iterates over.*/
   struct CoocurenceMatrixHolder
   {
   public:
+    using EntryType = std::pair<std::int64_t, double>;
+
     CoocurenceMatrixHolder(double min, double max, int number);
 
     int IntensityToIndex(double intensity);
@@ -49,12 +58,19 @@ namespace mitk
     double IndexToMeanIntensity(int index);
     double IndexToMaxIntensity(int index);
 
+    void Add(int i, int j, double value);
+    void Add(const CoocurenceMatrixHolder& other);
+    void Finalize();
+
+    int Row(const EntryType& entry) const { return static_cast<int>(entry.first / m_NumberOfBins); }
+    int Column(const EntryType& entry) const { return static_cast<int>(entry.first % m_NumberOfBins); }
+
     double m_MinimumRange;
     double m_MaximumRange;
     double m_Stepsize;
     int m_NumberOfBins;
-    Eigen::MatrixXd m_Matrix;
-
+    std::unordered_map<std::int64_t, double> m_Accumulator;
+    std::vector<EntryType> m_Entries;
   };
 
   struct CoocurenceMatrixFeatures
@@ -185,11 +201,28 @@ m_MinimumRange(min),
 m_MaximumRange(max),
 m_NumberOfBins(number)
 {
-  m_Matrix.resize(number, number);
-  m_Matrix.fill(0);
   m_Stepsize = (max - min) / (number);
 }
 
+void mitk::CoocurenceMatrixHolder::Add(int i, int j, double value)
+{
+  m_Accumulator[static_cast<std::int64_t>(i) * m_NumberOfBins + j] += value;
+}
+
+void mitk::CoocurenceMatrixHolder::Add(const CoocurenceMatrixHolder& other)
+{
+  for (const auto& entry : other.m_Accumulator)
+  {
+    m_Accumulator[entry.first] += entry.second;
+  }
+}
+
+void mitk::CoocurenceMatrixHolder::Finalize()
+{
+  m_Entries.assign(m_Accumulator.begin(), m_Accumulator.end());
+  std::sort(m_Entries.begin(), m_Entries.end());
+}
+
 int mitk::CoocurenceMatrixHolder::IntensityToIndex(double intensity)
 {
   int index = std::floor((intensity - m_MinimumRange) / m_Stepsize);
@@ -209,53 +242,37 @@ double mitk::CoocurenceMatrixHolder::IndexToMaxIntensity(int index)
   return m_MinimumRange + (index + 1) * m_Stepsize;
 }
 
-template<typename TPixel, unsigned int VImageDimension>
-void
-CalculateCoOcMatrix(const itk::Image<TPixel, VImageDimension>* itkImage,
-                    const itk::Image<unsigned short, VImageDimension>* mask,
-                    itk::Offset<VImageDimension> offset,
-                    int range,
+/** Adds the co-occurrences of all voxels in the range [begin, end) of the masked
+* voxel list with their neighbor at the passed offset to the holder.
+* binImage contains the bin index of each voxel of the image buffer or -1 if the
+* voxel is not part of the analyzed area.*/
+static void
+CalculateCoOcMatrix(mitk::GlobalImageFeaturePreprocessing* preprocessing,
+                    const mitk::GlobalImageFeaturePreprocessing::MaskedVoxels& voxels,
+                    const std::vector<int>& binImage,
+                    std::size_t begin, std::size_t end,
+                    const mitk::GlobalImageFeaturePreprocessing::NeighborOffset& neighbor,
                     mitk::CoocurenceMatrixHolder &holder)
 {
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typedef itk::Image<unsigned short, VImageDimension> MaskImageType;
-  typedef itk::ShapedNeighborhoodIterator<ImageType> ShapeIterType;
-  typedef itk::ShapedNeighborhoodIterator<MaskImageType> ShapeMaskIterType;
-  typedef itk::ImageRegionConstIterator<ImageType> ConstIterType;
-  typedef itk::ImageRegionConstIterator<MaskImageType> ConstMaskIterType;
-
-
-  itk::Size<VImageDimension> radius;
-  radius.Fill(range+1);
-  ShapeIterType imageOffsetIter(radius, itkImage, itkImage->GetLargestPossibleRegion());
-  ShapeMaskIterType maskOffsetIter(radius, mask, mask->GetLargestPossibleRegion());
-  imageOffsetIter.ActivateOffset(offset);
-  maskOffsetIter.ActivateOffset(offset);
-  ConstIterType imageIter(itkImage, itkImage->GetLargestPossibleRegion());
-  ConstMaskIterType maskIter(mask, mask->GetLargestPossibleRegion());
-  //  iterator.GetIndex() + ci.GetNeighborhoodOffset()
-  auto region = mask->GetLargestPossibleRegion();
-
-
-  while (!maskIter.IsAtEnd())
+  for (std::size_t k = begin; k < end; ++k)
   {
-    auto ciMask = maskOffsetIter.Begin();
-    auto ciValue = imageOffsetIter.Begin();
-    if (maskIter.Value() > 0 &&
-      ciMask.Get() > 0 &&
-      imageIter.Get() == imageIter.Get() &&
-      ciValue.Get() == ciValue.Get() &&
-      region.IsInside(maskOffsetIter.GetIndex() + ciMask.GetNeighborhoodOffset()))
+    auto voxelOffset = voxels.offsets[k];
+    int i = binImage[voxelOffset];
+    if (i < 0)
     {
-      int i = holder.IntensityToIndex(imageIter.Get());
-      int j = holder.IntensityToIndex(ciValue.Get());
-      holder.m_Matrix(i, j) += 1;
-      holder.m_Matrix(j, i) += 1;
+      continue;
     }
-    ++imageOffsetIter;
-    ++maskOffsetIter;
-    ++imageIter;
-    ++maskIter;
+    if (!preprocessing->IsInside(preprocessing->BufferOffsetToIndex(voxelOffset), neighbor.offset))
+    {
+      continue;
+    }
+    int j = binImage[voxelOffset + neighbor.bufferOffset];
+    if (j < 0)
+    {
+      continue;
+    }
+    holder.Add(i, j, 1);
+    holder.Add(j, i, 1);
   }
 }
 
@@ -264,28 +281,35 @@ void CalculateFeatures(
   mitk::CoocurenceMatrixFeatures & results
   )
 {
-  auto pijMatrix = holder.m_Matrix;
-  auto piMatrix = holder.m_Matrix;
-  auto pjMatrix = holder.m_Matrix;
+  // All sums only iterate over the nonzero entries of the matrix (in row-major order).
+  // Zero entries do not contribute to any of the features.
   double Ng = holder.m_NumberOfBins;
   int NgSize = holder.m_NumberOfBins;
-  pijMatrix /= pijMatrix.sum();
-  piMatrix.rowwise().normalize();
-  pjMatrix.colwise().normalize();
 
-  for (int i = 0; i < holder.m_NumberOfBins; ++i)
-    for (int j = 0; j < holder.m_NumberOfBins; ++j)
-    {
-      if (pijMatrix(i, j) != pijMatrix(i, j))
-        pijMatrix(i, j) = 0;
-      if (piMatrix(i, j) != piMatrix(i, j))
-        piMatrix(i, j) = 0;
-      if (pjMatrix(i, j) != pjMatrix(i, j))
-        pjMatrix(i, j) = 0;
-    }
+  double matrixSum = 0;
+  for (const auto& entry : holder.m_Entries)
+  {
+    matrixSum += entry.second;
+  }
+
+  Eigen::VectorXd piVector(NgSize);
+  piVector.fill(0);
+  Eigen::VectorXd pjVector(NgSize);
+  pjVector.fill(0);
+  std::vector<double> pijValues(holder.m_Entries.size(), 0.0);
+  // Probabilities are non-negative, so the zero entries never exceed the maximum of the nonzero ones.
+  double pijMaximum = 0;
+  for (std::size_t k = 0; k < holder.m_Entries.size(); ++k)
+  {
+    double pij = holder.m_Entries[k].second / matrixSum;
+    if (pij != pij)
+      pij = 0;
+    pijValues[k] = pij;
+    piVector(holder.Column(holder.m_Entries[k])) += pij;
+    pjVector(holder.Row(holder.m_Entries[k])) += pij;
+    pijMaximum = std::max(pijMaximum, pij);
+  }
 
-  Eigen::VectorXd piVector = pijMatrix.colwise().sum();
-  Eigen::VectorXd pjVector = pijMatrix.rowwise().sum();
   double sigmai = 0;;
   for (int i = 0; i < holder.m_NumberOfBins; ++i)
   {
@@ -309,51 +333,65 @@ void CalculateFeatures(
   Eigen::VectorXd pipj(2*NgSize);
   pipj.fill(0);
 
+  results.JointMaximum += pijMaximum;
 
-  results.JointMaximum += pijMatrix.maxCoeff();
+  for (std::size_t k = 0; k < holder.m_Entries.size(); ++k)
+  {
+    int i = holder.Row(holder.m_Entries[k]);
+    int j = holder.Column(holder.m_Entries[k]);
+    //double iInt = holder.IndexToMeanIntensity(i);
+    //double jInt = holder.IndexToMeanIntensity(j);
+    double iInt = i + 1;// holder.IndexToMeanIntensity(i);
+    double jInt = j + 1;// holder.IndexToMeanIntensity(j);
+    double pij = pijValues[k];
 
-  for (int i = 0; i < holder.m_NumberOfBins; ++i)
+    int deltaK = (i - j)>0?(i-j) : (j-i);
+    pimj(deltaK) += pij;
+    pipj(i + j) += pij;
+
+    results.JointAverage += iInt * pij;
+    if (pij > 0)
+    {
+      results.JointEntropy -= pij * std::log(pij) / std::log(2);
+      results.FirstRowColumnEntropy -= pij * std::log(piVector(i)*pjVector(j)) / std::log(2);
+    }
+    results.AngularSecondMoment += pij*pij;
+    results.Contrast += (iInt - jInt)* (iInt - jInt) * pij;
+    results.Dissimilarity += std::abs<double>(iInt - jInt) * pij;
+    results.InverseDifference += pij / (1 + (std::abs<double>(iInt - jInt)));
+    results.InverseDifferenceNormalised += pij / (1 + (std::abs<double>(iInt - jInt) / Ng));
+    results.InverseDifferenceMoment += pij / (1 + (iInt - jInt)*(iInt - jInt));
+    results.InverseDifferenceMomentNormalised += pij / (1 + (iInt - jInt)*(iInt - jInt)/Ng/Ng);
+    results.Autocorrelation += iInt*jInt * pij;
+    double cluster = (iInt + jInt - 2 * results.RowAverage);
+    results.ClusterTendency += cluster*cluster * pij;
+    results.ClusterShade += cluster*cluster*cluster * pij;
+    results.ClusterProminence += cluster*cluster*cluster*cluster * pij;
+    if (iInt != jInt)
+    {
+      results.InverseVariance += pij / (iInt - jInt) / (iInt - jInt);
+    }
+  }
+
+  // The second row-column entropy depends on the marginal probabilities only,
+  // so it is sufficient to iterate over their nonzero entries.
+  std::vector<int> nonzeroI;
+  std::vector<int> nonzeroJ;
+  for (int i = 0; i < NgSize; ++i)
   {
-    for (int j = 0; j < holder.m_NumberOfBins; ++j)
+    if (piVector(i) > 0)
+      nonzeroI.push_back(i);
+    if (pjVector(i) > 0)
+      nonzeroJ.push_back(i);
+  }
+  for (auto i : nonzeroI)
+  {
+    for (auto j : nonzeroJ)
     {
-      //double iInt = holder.IndexToMeanIntensity(i);
-      //double jInt = holder.IndexToMeanIntensity(j);
-      double iInt = i + 1;// holder.IndexToMeanIntensity(i);
-      double jInt = j + 1;// holder.IndexToMeanIntensity(j);
-      double pij = pijMatrix(i, j);
-
-      int deltaK = (i - j)>0?(i-j) : (j-i);
-      pimj(deltaK) += pij;
-      pipj(i + j) += pij;
-
-      results.JointAverage += iInt * pij;
-      if (pij > 0)
-      {
-        results.JointEntropy -= pij * std::log(pij) / std::log(2);
-        results.FirstRowColumnEntropy -= pij * std::log(piVector(i)*pjVector(j)) / std::log(2);
-      }
-      if (piVector(i) > 0 && pjVector(j) > 0 )
-      {
-        results.SecondRowColumnEntropy -= piVector(i)*pjVector(j) * std::log(piVector(i)*pjVector(j)) / std::log(2);
-      }
-      results.AngularSecondMoment += pij*pij;
-      results.Contrast += (iInt - jInt)* (iInt - jInt) * pij;
-      results.Dissimilarity += std::abs<double>(iInt - jInt) * pij;
-      results.InverseDifference += pij / (1 + (std::abs<double>(iInt - jInt)));
-      results.InverseDifferenceNormalised += pij / (1 + (std::abs<double>(iInt - jInt) / Ng));
-      results.InverseDifferenceMoment += pij / (1 + (iInt - jInt)*(iInt - jInt));
-      results.InverseDifferenceMomentNormalised += pij / (1 + (iInt - jInt)*(iInt - jInt)/Ng/Ng);
-      results.Autocorrelation += iInt*jInt * pij;
-      double cluster = (iInt + jInt - 2 * results.RowAverage);
-      results.ClusterTendency += cluster*cluster * pij;
-      results.ClusterShade += cluster*cluster*cluster * pij;
-      results.ClusterProminence += cluster*cluster*cluster*cluster * pij;
-      if (iInt != jInt)
-      {
-        results.InverseVariance += pij / (iInt - jInt) / (iInt - jInt);
-      }
+      results.SecondRowColumnEntropy -= piVector(i)*pjVector(j) * std::log(piVector(i)*pjVector(j)) / std::log(2);
     }
   }
+
   results.Correlation = 1 / sigmai / sigmai * (-results.RowAverage*results.RowAverage+ results.Autocorrelation);
   results.FirstMeasureOfInformationCorrelation = (results.JointEntropy - results.FirstRowColumnEntropy) / results.RowEntropy;
   if (results.JointEntropy < results.SecondRowColumnEntropy)
@@ -365,17 +403,13 @@ void CalculateFeatures(
     results.SecondMeasureOfInformationCorrelation = 0;
   }
 
-  for (int i = 0; i < holder.m_NumberOfBins; ++i)
+  for (std::size_t k = 0; k < holder.m_Entries.size(); ++k)
   {
-    for (int j = 0; j < holder.m_NumberOfBins; ++j)
-    {
-      //double iInt = holder.IndexToMeanIntensity(i);
-      //double jInt = holder.IndexToMeanIntensity(j);
-      double iInt = i + 1;
-      double pij = pijMatrix(i, j);
+    //double iInt = holder.IndexToMeanIntensity(i);
+    double iInt = holder.Row(holder.m_Entries[k]) + 1;
+    double pij = pijValues[k];
 
-      results.JointVariance += (iInt - results.JointAverage)* (iInt - results.JointAverage)*pij;
-    }
+    results.JointVariance += (iInt - results.JointAverage)* (iInt - results.JointAverage)*pij;
   }
 
   for (int k = 0; k < NgSize; ++k)
@@ -404,90 +438,100 @@ void CalculateFeatures(
   {
     results.SumVariance += (2+k - results.SumAverage)* (2+k - results.SumAverage)*pipj(k);
   }
+}
 
-  //MITK_INFO << std::endl << holder.m_Matrix;
-  //MITK_INFO << std::endl << pijMatrix;
-  //MITK_INFO << std::endl << piMatrix;
-  //MITK_INFO << std::endl << pjMatrix;
-
-  //for (int i = 0; i < holder.m_NumberOfBins; ++i)
-  //{
-  //  MITK_INFO << "Bin " << i << " Min: " << holder.IndexToMinIntensity(i) << " Max: " << holder.IndexToMaxIntensity(i);
-  //}
-  //MITK_INFO << pimj;
-  //MITK_INFO << pipj;
-
+/** Bin index of each voxel of the image buffer; -1 marks voxels outside of the mask or NaN voxels.
+* The bins only depend on the quantifier, so the image is shared by all ranges.*/
+static std::vector<int>
+CalculateBinImage(mitk::GlobalImageFeaturePreprocessing* preprocessing, const mitk::Image* mask, double rangeMin, double rangeMax, int numberOfBins)
+{
+  const auto& voxels = preprocessing->GetMaskedVoxels(mask);
+  auto size = preprocessing->GetImageSize();
+  mitk::CoocurenceMatrixHolder binningHolder(rangeMin, rangeMax, numberOfBins);
+  std::vector<int> binImage(size[0] * size[1] * size[2], -1);
+  for (std::size_t k = 0; k < voxels.offsets.size(); ++k)
+  {
+    if (voxels.values[k] == voxels.values[k])
+    {
+      binImage[voxels.offsets[k]] = binningHolder.IntensityToIndex(voxels.values[k]);
+    }
+  }
+  return binImage;
 }
 
-template<typename TPixel, unsigned int VImageDimension>
-void
-CalculateCoocurenceFeatures(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, mitk::GIFCooccurenceMatrix2::FeatureListType & featureList, mitk::GIFCooccurenceMatrix2Configuration config)
+static void
+CalculateCoocurenceFeatures(mitk::GlobalImageFeaturePreprocessing* preprocessing, const mitk::Image* mask, const std::vector<int>& binImage, mitk::GIFCooccurenceMatrix2::FeatureListType & featureList, mitk::GIFCooccurenceMatrix2Configuration config)
 {
-  typedef itk::Image<unsigned short, VImageDimension> MaskType;
-  typedef itk::Neighborhood<TPixel, VImageDimension > NeighborhoodType;
-  typedef itk::Offset<VImageDimension> OffsetType;
+  typedef mitk::GlobalImageFeaturePreprocessing::NeighborOffset NeighborOffsetType;
 
   ///////////////////////////////////////////////////////////////////////////////////////////////
   double rangeMin = config.MinimumIntensity;
   double rangeMax = config.MaximumIntensity;
   int numberOfBins = config.Bins;
 
-  typename MaskType::Pointer maskImage = MaskType::New();
-  mitk::CastToItkImage(mask, maskImage);
-
   //Find possible directions
-  std::vector < itk::Offset<VImageDimension> > offsetVector;
-  NeighborhoodType hood;
-  hood.SetRadius(1);
-  unsigned int        centerIndex = hood.GetCenterNeighborhoodIndex();
-  OffsetType          offset;
-  for (unsigned int d = 0; d < centerIndex; d++)
+  std::vector<NeighborOffsetType> offsetVector;
+  for (const auto& neighbor : preprocessing->GetNeighborOffsets(config.range))
   {
-    offset = hood.GetOffset(d);
     bool useOffset = true;
-    for (unsigned int i = 0; i < VImageDimension; ++i)
+    for (unsigned int i = 0; i < 3; ++i)
     {
-      offset[i] *= config.range;
-      if (config.direction == i + 2 && offset[i] != 0)
+      if (config.direction == i + 2 && neighbor.offset[i] != 0)
       {
         useOffset = false;
       }
     }
     if (useOffset)
     {
-      offsetVector.push_back(offset);
+      offsetVector.push_back(neighbor);
     }
   }
   if (config.direction == 1)
   {
     offsetVector.clear();
-    offset[0] = 0;
-    offset[1] = 0;
-    offset[2] = 1;
   }
 
-  std::vector<mitk::CoocurenceMatrixFeatures> resultVector;
-  mitk::CoocurenceMatrixHolder holderOverall(rangeMin, rangeMax, numberOfBins);
-  mitk::CoocurenceMatrixFeatures overallFeature;
-  for (std::size_t i = 0; i < offsetVector.size(); ++i)
+  const auto& voxels = preprocessing->GetMaskedVoxels(mask);
+  mitk::CoocurenceMatrixHolder binningHolder(rangeMin, rangeMax, numberOfBins);
+
+  // The matrices are built in parallel for each direction and each slab of the masked
+  // voxel list (contiguous in buffer order). The thread-local partial matrices are merged
+  // per direction afterwards.
+  const int numberOfDirections = static_cast<int>(offsetVector.size());
+  const int numberOfSlabs = static_cast<int>(std::max<std::size_t>(1, std::min<std::size_t>(16, voxels.offsets.size() / 16384)));
+  const std::size_t slabSize = (voxels.offsets.size() + numberOfSlabs - 1) / numberOfSlabs;
+
+  std::vector<mitk::CoocurenceMatrixHolder> partialHolders(numberOfDirections * numberOfSlabs, binningHolder);
+#pragma omp parallel for schedule(dynamic)
+  for (int task = 0; task < numberOfDirections * numberOfSlabs; ++task)
   {
-    if (config.direction > 1)
+    int direction = task / numberOfSlabs;
+    std::size_t begin = (task % numberOfSlabs) * slabSize;
+    std::size_t end = std::min(voxels.offsets.size(), begin + slabSize);
+    CalculateCoOcMatrix(preprocessing, voxels, binImage, begin, end, offsetVector[direction], partialHolders[task]);
+  }
+
+  std::vector<mitk::CoocurenceMatrixHolder> holders(numberOfDirections, binningHolder);
+  std::vector<mitk::CoocurenceMatrixFeatures> resultVector(numberOfDirections);
+#pragma omp parallel for schedule(dynamic)
+  for (int direction = 0; direction < numberOfDirections; ++direction)
+  {
+    for (int slab = 0; slab < numberOfSlabs; ++slab)
     {
-      if (offsetVector[i][config.direction - 2] != 0)
-      {
-        continue;
-      }
+      holders[direction].Add(partialHolders[direction * numberOfSlabs + slab]);
     }
+    holders[direction].Finalize();
+    CalculateFeatures(holders[direction], resultVector[direction]);
+  }
+  partialHolders.clear();
 
-
-    offset = offsetVector[i];
-    mitk::CoocurenceMatrixHolder holder(rangeMin, rangeMax, numberOfBins);
-    mitk::CoocurenceMatrixFeatures coocResults;
-    CalculateCoOcMatrix<TPixel, VImageDimension>(itkImage, maskImage, offset, config.range, holder);
-    holderOverall.m_Matrix += holder.m_Matrix;
-    CalculateFeatures(holder, coocResults);
-    resultVector.push_back(coocResults);
+  mitk::CoocurenceMatrixHolder holderOverall(rangeMin, rangeMax, numberOfBins);
+  mitk::CoocurenceMatrixFeatures overallFeature;
+  for (const auto& holder : holders)
+  {
+    holderOverall.Add(holder);
   }
+  holderOverall.Finalize();
   CalculateFeatures(holderOverall, overallFeature);
   //NormalizeMatrixFeature(overallFeature, offsetVector.size());
 
@@ -652,6 +696,15 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFCooccurenceMatrix2::D
 
   InitializeQuantifier(image, mask);
 
+  GlobalImageFeaturePreprocessing::Pointer preprocessing = this->GetPreprocessingForImage(image);
+  if (preprocessing.IsNull())
+  {
+    preprocessing = GlobalImageFeaturePreprocessing::New();
+    preprocessing->SetImage(image);
+  }
+
+  const auto binImage = CalculateBinImage(preprocessing, mask, GetQuantifier()->GetMinimum(), GetQuantifier()->GetMaximum(), GetQuantifier()->GetBins());
+
   for (const auto& range: m_Ranges)
   {
     MITK_INFO << "Start calculating coocurence with range " << range << "....";
@@ -664,7 +717,7 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFCooccurenceMatrix2::D
     config.Bins = GetQuantifier()->GetBins();
     config.id = this->CreateTemplateFeatureID(std::to_string(range), { {GetOptionPrefix() + "::range", range} });
 
-    AccessByItk_3(image, CalculateCoocurenceFeatures, mask, featureList, config);
+    CalculateCoocurenceFeatures(preprocessing, mask, binImage, featureList, config);
 
     MITK_INFO << "Finished calculating coocurence with range " << range << "....";
   }
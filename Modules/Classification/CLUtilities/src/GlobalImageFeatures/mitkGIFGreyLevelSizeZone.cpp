@@ -21,6 +21,9 @@ found in the LICENSE file.
 #include <itkImageRegionIteratorWithIndex.h>
 
 // STL
+#include <algorithm>
+#include <map>
+#include <vector>
 
 namespace mitk
 {
@@ -34,10 +37,14 @@ namespace mitk
     FeatureID id;
   };
 
+  /** Sparse size zone matrix. Only the nonzero entries are stored, indexed by
+  * (grey level index, zone size - 1) in row-major order.*/
   struct GreyLevelSizeZoneMatrixHolder
   {
   public:
-    GreyLevelSizeZoneMatrixHolder(double min, double max, int number, int maxSize);
+    using EntryKeyType = std::pair<int, int>;
+
+    GreyLevelSizeZoneMatrixHolder(double min, double max, int number);
 
     int IntensityToIndex(double intensity);
     double IndexToMinIntensity(int index);
@@ -48,8 +55,7 @@ namespace mitk
     double m_MaximumRange;
     double m_Stepsize;
     int m_NumberOfBins;
-    int m_MaximumSize;
-    Eigen::MatrixXd m_Matrix;
+    std::map<EntryKeyType, double> m_Matrix;
 
   };
 
@@ -124,20 +130,18 @@ void MatrixFeaturesTo(const mitk::GreyLevelSizeZoneFeatures& features,
   featureList.push_back(std::make_pair(mitk::CreateFeatureID(config.id, "Zone Size Entropy"), features.ZoneSizeEntropy));
 }
 
-mitk::GreyLevelSizeZoneMatrixHolder::GreyLevelSizeZoneMatrixHolder(double min, double max, int number, int maxSize) :
+mitk::GreyLevelSizeZoneMatrixHolder::GreyLevelSizeZoneMatrixHolder(double min, double max, int number) :
                     m_MinimumRange(min),
                     m_MaximumRange(max),
-                    m_NumberOfBins(number),
-                    m_MaximumSize(maxSize)
+                    m_NumberOfBins(number)
 {
-  m_Matrix.resize(number, maxSize);
-  m_Matrix.fill(0);
   m_Stepsize = (max - min) / (number);
 }
 
 int mitk::GreyLevelSizeZoneMatrixHolder::IntensityToIndex(double intensity)
 {
-  return std::floor((intensity - m_MinimumRange) / m_Stepsize);
+  int index = std::floor((intensity - m_MinimumRange) / m_Stepsize);
+  return std::max(0, std::min(index, m_NumberOfBins - 1));
 }
 
 double mitk::GreyLevelSizeZoneMatrixHolder::IndexToMinIntensity(int index)
@@ -153,89 +157,93 @@ double mitk::GreyLevelSizeZoneMatrixHolder::IndexToMaxIntensity(int index)
   return m_MinimumRange + (index + 1) * m_Stepsize;
 }
 
-template<typename TPixel, unsigned int VImageDimension>
-static int
-CalculateGlSZMatrix(const itk::Image<TPixel, VImageDimension>* itkImage,
-                    const itk::Image<unsigned short, VImageDimension>* mask,
-                    std::vector<itk::Offset<VImageDimension> > offsets,
-                    bool estimateLargestRegion,
+/** Collects the size zones of all masked voxels. binImage contains the grey level index
+* of each voxel of the image buffer or -1 if the voxel is not part of the analyzed area.
+* Zones never cross grey levels, so the zones of the individual grey levels are
+* collected in parallel.*/
+static void
+CalculateGlSZMatrix(mitk::GlobalImageFeaturePreprocessing* preprocessing,
+                    const mitk::GlobalImageFeaturePreprocessing::MaskedVoxels& voxels,
+                    const std::vector<int>& binImage,
+                    const std::vector<mitk::GlobalImageFeaturePreprocessing::NeighborOffset>& offsets,
                     mitk::GreyLevelSizeZoneMatrixHolder &holder)
 {
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typedef itk::Image<unsigned short, VImageDimension> MaskImageType;
-  typedef typename ImageType::IndexType IndexType;
-
-  typedef itk::ImageRegionConstIteratorWithIndex<ImageType> ConstIterType;
-  typedef itk::ImageRegionConstIteratorWithIndex<MaskImageType> ConstMaskIterType;
-
-  auto region = mask->GetLargestPossibleRegion();
-  typename MaskImageType::RegionType newRegion;
-  newRegion.SetSize(region.GetSize());
-  newRegion.SetIndex(region.GetIndex());
+  typedef mitk::GlobalImageFeaturePreprocessing::NeighborOffset NeighborOffsetType;
+  typedef mitk::GlobalImageFeaturePreprocessing::BufferOffsetType BufferOffsetType;
 
-  ConstIterType imageIter(itkImage, itkImage->GetLargestPossibleRegion());
-  ConstMaskIterType maskIter(mask, mask->GetLargestPossibleRegion());
+  // Zones are connected in positive and negative offset direction
+  std::vector<NeighborOffsetType> neighbors;
+  for (const auto& offset : offsets)
+  {
+    neighbors.push_back(offset);
+    NeighborOffsetType negativeOffset;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      negativeOffset.offset[i] = -offset.offset[i];
+    }
+    negativeOffset.bufferOffset = -offset.bufferOffset;
+    neighbors.push_back(negativeOffset);
+  }
 
-  typename MaskImageType::Pointer visitedImage = MaskImageType::New();
-  visitedImage->SetRegions(newRegion);
-  visitedImage->Allocate();
-  visitedImage->FillBuffer(0);
+  std::vector<std::vector<BufferOffsetType> > voxelsPerLevel(holder.m_NumberOfBins);
+  for (auto voxelOffset : voxels.offsets)
+  {
+    if (binImage[voxelOffset] >= 0)
+    {
+      voxelsPerLevel[binImage[voxelOffset]].push_back(voxelOffset);
+    }
+  }
 
-  int largestRegion = 0;
+  // Each thread only accesses voxels of its own grey level, so the flags can be shared.
+  std::vector<unsigned char> visited(binImage.size(), 0);
+  std::vector<std::map<int, double> > zonesPerLevel(holder.m_NumberOfBins);
 
-  while (!maskIter.IsAtEnd())
+#pragma omp parallel for schedule(dynamic)
+  for (int level = 0; level < holder.m_NumberOfBins; ++level)
   {
-    if (maskIter.Value() > 0 )
+    std::vector<BufferOffsetType> indices;
+    for (auto startOffset : voxelsPerLevel[level])
     {
-      auto startIntensityIndex = holder.IntensityToIndex(imageIter.Value());
-      std::vector<IndexType> indices;
-      indices.push_back(maskIter.GetIndex());
-      unsigned int steps = 0;
+      if (visited[startOffset] > 0)
+      {
+        continue;
+      }
+      visited[startOffset] = 1;
+      indices.push_back(startOffset);
+      int steps = 0;
 
       while (indices.size() > 0)
       {
-        auto currentIndex = indices.back();
+        auto currentOffset = indices.back();
         indices.pop_back();
+        ++steps;
 
-        if (!region.IsInside(currentIndex))
-        {
-          continue;
-        }
-
-        auto wasVisited = visitedImage->GetPixel(currentIndex);
-        auto newIntensityIndex = holder.IntensityToIndex(itkImage->GetPixel(currentIndex));
-        auto isInMask = mask->GetPixel(currentIndex);
-
-        if ((isInMask > 0) &&
-            (newIntensityIndex == startIntensityIndex) &&
-            (wasVisited < 1))
+        auto currentIndex = preprocessing->BufferOffsetToIndex(currentOffset);
+        for (const auto& neighbor : neighbors)
         {
-          ++steps;
-          visitedImage->SetPixel(currentIndex, 1);
-          for (auto offset : offsets)
+          if (!preprocessing->IsInside(currentIndex, neighbor.offset))
           {
-            auto newIndex = currentIndex + offset;
-            indices.push_back(newIndex);
-            newIndex = currentIndex - offset;
-            indices.push_back(newIndex);
+            continue;
+          }
+          auto newOffset = currentOffset + neighbor.bufferOffset;
+          if (binImage[newOffset] == level && visited[newOffset] < 1)
+          {
+            visited[newOffset] = 1;
+            indices.push_back(newOffset);
           }
-
-        }
-      }
-      if (steps > 0)
-      {
-        largestRegion = std::max<int>(steps, largestRegion);
-        steps = std::min<unsigned int>(steps, holder.m_MaximumSize);
-        if (!estimateLargestRegion)
-        {
-          holder.m_Matrix(startIntensityIndex, steps - 1) += 1;
         }
       }
+      zonesPerLevel[level][steps - 1] += 1;
+    }
+  }
+
+  for (int level = 0; level < holder.m_NumberOfBins; ++level)
+  {
+    for (const auto& zone : zonesPerLevel[level])
+    {
+      holder.m_Matrix[std::make_pair(level, zone.first)] += zone.second;
     }
-    ++imageIter;
-    ++maskIter;
   }
-  return largestRegion;
 }
 
 static void CalculateFeatures(
@@ -243,36 +251,26 @@ static void CalculateFeatures(
   mitk::GreyLevelSizeZoneFeatures & results
   )
 {
-  auto SgzMatrix = holder.m_Matrix;
-  auto pgzMatrix = holder.m_Matrix;
-  auto pgMatrix = holder.m_Matrix;
-  auto pzMatrix = holder.m_Matrix;
-
-  double Ns = pgzMatrix.sum();
-  pgzMatrix /= Ns;
-  pgMatrix.rowwise().normalize();
-  pzMatrix.colwise().normalize();
-
-  for (int i = 0; i < pgzMatrix.rows(); ++i)
-    for (int j = 0; j < pgzMatrix.cols(); ++j)
-    {
-      if (pgzMatrix(i, j) != pgzMatrix(i, j))
-        pgzMatrix(i, j) = 0;
-      if (pgMatrix(i, j) != pgMatrix(i, j))
-        pgMatrix(i, j) = 0;
-      if (pzMatrix(i, j) != pzMatrix(i, j))
-        pzMatrix(i, j) = 0;
-    }
-
-  Eigen::VectorXd SgVector = SgzMatrix.rowwise().sum();
-  Eigen::VectorXd SzVector = SgzMatrix.colwise().sum();
+  // All sums only iterate over the nonzero entries of the matrix,
+  // zero entries do not contribute to any of the features.
+  double Ns = 0;
+  Eigen::VectorXd SgVector(holder.m_NumberOfBins);
+  SgVector.fill(0);
+  std::map<int, double> SzVector;
+  for (const auto& entry : holder.m_Matrix)
+  {
+    Ns += entry.second;
+    SgVector(entry.first.first) += entry.second;
+    SzVector[entry.first.second] += entry.second;
+  }
 
-  for (int j = 0; j < SzVector.size(); ++j)
+  for (const auto& entry : SzVector)
   {
-    results.SmallZoneEmphasis += SzVector(j) / (j + 1) / (j + 1);
-    results.LargeZoneEmphasis += SzVector(j) * (j + 1.0) * (j + 1.0);
-    results.ZoneSizeNonUniformity += SzVector(j) * SzVector(j);
-    results.ZoneSizeNoneUniformityNormalized += SzVector(j) * SzVector(j);
+    int j = entry.first;
+    results.SmallZoneEmphasis += entry.second / (j + 1) / (j + 1);
+    results.LargeZoneEmphasis += entry.second * (j + 1.0) * (j + 1.0);
+    results.ZoneSizeNonUniformity += entry.second * entry.second;
+    results.ZoneSizeNoneUniformityNormalized += entry.second * entry.second;
   }
   for (int i = 0; i < SgVector.size(); ++i)
   {
@@ -282,30 +280,33 @@ static void CalculateFeatures(
     results.GreyLevelNonUniformityNormalized += SgVector(i)*SgVector(i);
   }
 
-  for (int i = 0; i < SgzMatrix.rows(); ++i)
+  for (const auto& entry : holder.m_Matrix)
   {
-    for (int j = 0; j < SgzMatrix.cols(); ++j)
-    {
-      results.SmallZoneLowGreyLevelEmphasis += SgzMatrix(i, j) / (i + 1) / (i + 1) / (j + 1) / (j + 1);
-      results.SmallZoneHighGreyLevelEmphasis += SgzMatrix(i, j) * (i + 1) * (i + 1) / (j + 1) / (j + 1);
-      results.LargeZoneLowGreyLevelEmphasis += SgzMatrix(i, j) / (i + 1) / (i + 1) * (j + 1.0) * (j + 1.0);
-      results.LargeZoneHighGreyLevelEmphasis += SgzMatrix(i, j) * (i + 1) * (i + 1) * (j + 1.0) * (j + 1.0);
-      results.ZonePercentage += SgzMatrix(i, j)*(j + 1);
-
-      results.GreyLevelMean += (i + 1)*pgzMatrix(i, j);
-      results.ZoneSizeMean += (j + 1)*pgzMatrix(i, j);
-      if (pgzMatrix(i, j) > 0)
-        results.ZoneSizeEntropy -= pgzMatrix(i, j) * std::log(pgzMatrix(i, j)) / std::log(2);
-    }
+    int i = entry.first.first;
+    int j = entry.first.second;
+    double sgz = entry.second;
+    double pgz = sgz / Ns;
+
+    results.SmallZoneLowGreyLevelEmphasis += sgz / (i + 1) / (i + 1) / (j + 1) / (j + 1);
+    results.SmallZoneHighGreyLevelEmphasis += sgz * (i + 1) * (i + 1) / (j + 1) / (j + 1);
+    results.LargeZoneLowGreyLevelEmphasis += sgz / (i + 1) / (i + 1) * (j + 1.0) * (j + 1.0);
+    results.LargeZoneHighGreyLevelEmphasis += sgz * (i + 1) * (i + 1) * (j + 1.0) * (j + 1.0);
+    results.ZonePercentage += sgz*(j + 1);
+
+    results.GreyLevelMean += (i + 1)*pgz;
+    results.ZoneSizeMean += (j + 1)*pgz;
+    if (pgz > 0)
+      results.ZoneSizeEntropy -= pgz * std::log(pgz) / std::log(2);
   }
 
-  for (int i = 0; i < SgzMatrix.rows(); ++i)
+  for (const auto& entry : holder.m_Matrix)
   {
-    for (int j = 0; j < SgzMatrix.cols(); ++j)
-    {
-      results.GreyLevelVariance += (i + 1 - results.GreyLevelMean)*(i + 1 - results.GreyLevelMean)*pgzMatrix(i, j);
-      results.ZoneSizeVariance += (j + 1 - results.ZoneSizeMean)*(j + 1 - results.ZoneSizeMean)*pgzMatrix(i, j);
-    }
+    int i = entry.first.first;
+    int j = entry.first.second;
+    double pgz = entry.second / Ns;
+
+    results.GreyLevelVariance += (i + 1 - results.GreyLevelMean)*(i + 1 - results.GreyLevelMean)*pgz;
+    results.ZoneSizeVariance += (j + 1 - results.ZoneSizeMean)*(j + 1 - results.ZoneSizeMean)*pgz;
   }
 
   results.SmallZoneEmphasis /= Ns;
@@ -325,60 +326,59 @@ static void CalculateFeatures(
   results.ZonePercentage = Ns / results.ZonePercentage;
 }
 
-template<typename TPixel, unsigned int VImageDimension>
 static void
-CalculateGreyLevelSizeZoneFeatures(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, mitk::GIFGreyLevelSizeZone::FeatureListType & featureList, mitk::GIFGreyLevelSizeZoneConfiguration config)
+CalculateGreyLevelSizeZoneFeatures(mitk::GlobalImageFeaturePreprocessing* preprocessing, const mitk::Image* mask, mitk::GIFGreyLevelSizeZone::FeatureListType & featureList, mitk::GIFGreyLevelSizeZoneConfiguration config)
 {
-  typedef itk::Image<unsigned short, VImageDimension> MaskType;
-  typedef itk::Neighborhood<TPixel, VImageDimension > NeighborhoodType;
-  typedef itk::Offset<VImageDimension> OffsetType;
+  typedef mitk::GlobalImageFeaturePreprocessing::NeighborOffset NeighborOffsetType;
 
   ///////////////////////////////////////////////////////////////////////////////////////////////
   double rangeMin = config.MinimumIntensity;
   double rangeMax = config.MaximumIntensity;
   int numberOfBins = config.Bins;
-
-  typename MaskType::Pointer maskImage = MaskType::New();
-  mitk::CastToItkImage(mask, maskImage);
+  auto size = preprocessing->GetImageSize();
 
   //Find possible directions
-  std::vector < itk::Offset<VImageDimension> > offsetVector;
-  NeighborhoodType hood;
-  hood.SetRadius(1);
-  unsigned int        centerIndex = hood.GetCenterNeighborhoodIndex();
-  OffsetType          offset;
-  for (unsigned int d = 0; d < centerIndex; d++)
+  std::vector<NeighborOffsetType> offsetVector;
+  for (const auto& neighbor : preprocessing->GetNeighborOffsets(1))
   {
-    offset = hood.GetOffset(d);
     bool useOffset = true;
-    for (unsigned int i = 0; i < VImageDimension; ++i)
+    for (unsigned int i = 0; i < 3; ++i)
     {
-      if ((config.direction == i + 2) && offset[i] != 0)
+      if ((config.direction == i + 2) && neighbor.offset[i] != 0)
       {
         useOffset = false;
       }
     }
     if (useOffset)
     {
-      offsetVector.push_back(offset);
-      MITK_INFO << offset;
+      offsetVector.push_back(neighbor);
     }
   }
   if (config.direction == 1)
   {
     offsetVector.clear();
-    offset[0] = 0;
-    offset[1] = 0;
-    offset[2] = 1;
+    NeighborOffsetType offset;
+    offset.offset[0] = 0;
+    offset.offset[1] = 0;
+    offset.offset[2] = 1;
+    offset.bufferOffset = size[0] * size[1];
     offsetVector.push_back(offset);
   }
 
-  std::vector<mitk::GreyLevelSizeZoneFeatures> resultVector;
-  mitk::GreyLevelSizeZoneMatrixHolder tmpHolder(rangeMin, rangeMax, numberOfBins, 3);
-  int largestRegion = CalculateGlSZMatrix<TPixel, VImageDimension>(itkImage, maskImage, offsetVector, true, tmpHolder);
-  mitk::GreyLevelSizeZoneMatrixHolder holderOverall(rangeMin, rangeMax, numberOfBins,largestRegion);
+  // Grey level index of each voxel of the image buffer; -1 marks voxels outside of the mask or NaN voxels.
+  const auto& voxels = preprocessing->GetMaskedVoxels(mask);
+  mitk::GreyLevelSizeZoneMatrixHolder holderOverall(rangeMin, rangeMax, numberOfBins);
+  std::vector<int> binImage(size[0] * size[1] * size[2], -1);
+  for (std::size_t k = 0; k < voxels.offsets.size(); ++k)
+  {
+    if (voxels.values[k] == voxels.values[k])
+    {
+      binImage[voxels.offsets[k]] = holderOverall.IntensityToIndex(voxels.values[k]);
+    }
+  }
+
   mitk::GreyLevelSizeZoneFeatures overallFeature;
-  CalculateGlSZMatrix<TPixel, VImageDimension>(itkImage, maskImage, offsetVector, false, holderOverall);
+  CalculateGlSZMatrix(preprocessing, voxels, binImage, offsetVector, holderOverall);
   CalculateFeatures(holderOverall, overallFeature);
 
   MatrixFeaturesTo(overallFeature, config, featureList);
@@ -416,7 +416,14 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFGreyLevelSizeZone::Do
   config.Bins = GetQuantifier()->GetBins();
   config.id = this->CreateTemplateFeatureID();
 
-  AccessByItk_3(image, CalculateGreyLevelSizeZoneFeatures, mask, featureList, config);
+  GlobalImageFeaturePreprocessing::Pointer preprocessing = this->GetPreprocessingForImage(image);
+  if (preprocessing.IsNull())
+  {
+    preprocessing = GlobalImageFeaturePreprocessing::New();
+    preprocessing->SetImage(image);
+  }
+
+  CalculateGreyLevelSizeZoneFeatures(preprocessing, mask, featureList, config);
 
   MITK_INFO << "Finished calculating Grey level size zone ...";
 
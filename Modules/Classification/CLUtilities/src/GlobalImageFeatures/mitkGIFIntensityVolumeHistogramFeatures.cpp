@@ -32,42 +32,10 @@ namespace
     mitk::FeatureID id;
   };
 
-  template<typename TPixel, unsigned int VImageDimension>
-  void CalculateIntensityPeak(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, GIFIntensityVolumeHistogramFeaturesParameters params, mitk::GIFIntensityVolumeHistogramFeatures::FeatureListType& featureList)
+  void CalculateIntensityVolumeHistogramFeatures(std::vector<double> hist, int count, GIFIntensityVolumeHistogramFeaturesParameters params, mitk::GIFIntensityVolumeHistogramFeatures::FeatureListType& featureList)
   {
-    typedef itk::Image<TPixel, VImageDimension> ImageType;
-    typedef itk::Image<unsigned short, VImageDimension> MaskType;
-
-    typename MaskType::Pointer itkMask = MaskType::New();
-    mitk::CastToItkImage(mask, itkMask);
-
     mitk::IntensityQuantifier::Pointer quantifier = params.quantifier;
 
-    itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
-    itk::ImageRegionConstIterator<MaskType> iterMask(itkMask, itkMask->GetLargestPossibleRegion());
-
-    MITK_INFO << "Quantification: " << quantifier->GetMinimum() << " to " << quantifier->GetMaximum() << " with " << quantifier->GetBins() << " bins";
-
-    iter.GoToBegin();
-    iterMask.GoToBegin();
-    std::vector<double> hist;
-    hist.resize(quantifier->GetBins(), 0);
-
-    int count = 0;
-    while (!iter.IsAtEnd())
-    {
-      if (iterMask.Get() > 0)
-      {
-        double value = iter.Get();
-        //std::size_t index = std::floor((value - minimum) / (maximum - minimum) * (bins-1));
-        std::size_t index = quantifier->IntensityToIndex(value);
-        ++count;
-        hist[index] += 1.0;// / count;
-      }
-      ++iterMask;
-      ++iter;
-    }
-
     bool notFoundIntenstiy010 = true;
     bool notFoundIntenstiy090 = true;
 
@@ -111,6 +79,61 @@ namespace
     featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Area under IVH curve"), auc));
     //featureList.push_back(std::make_pair("Local Intensity Global Intensity Peak", globalPeakValue));
   }
+
+  template<typename TPixel, unsigned int VImageDimension>
+  void CalculateIntensityPeak(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, GIFIntensityVolumeHistogramFeaturesParameters params, mitk::GIFIntensityVolumeHistogramFeatures::FeatureListType& featureList)
+  {
+    typedef itk::Image<TPixel, VImageDimension> ImageType;
+    typedef itk::Image<unsigned short, VImageDimension> MaskType;
+
+    typename MaskType::Pointer itkMask = MaskType::New();
+    mitk::CastToItkImage(mask, itkMask);
+
+    mitk::IntensityQuantifier::Pointer quantifier = params.quantifier;
+
+    itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<MaskType> iterMask(itkMask, itkMask->GetLargestPossibleRegion());
+
+    MITK_INFO << "Quantification: " << quantifier->GetMinimum() << " to " << quantifier->GetMaximum() << " with " << quantifier->GetBins() << " bins";
+
+    iter.GoToBegin();
+    iterMask.GoToBegin();
+    std::vector<double> hist;
+    hist.resize(quantifier->GetBins(), 0);
+
+    int count = 0;
+    while (!iter.IsAtEnd())
+    {
+      if (iterMask.Get() > 0)
+      {
+        double value = iter.Get();
+        //std::size_t index = std::floor((value - minimum) / (maximum - minimum) * (bins-1));
+        std::size_t index = quantifier->IntensityToIndex(value);
+        ++count;
+        hist[index] += 1.0;// / count;
+      }
+      ++iterMask;
+      ++iter;
+    }
+
+    CalculateIntensityVolumeHistogramFeatures(hist, count, params, featureList);
+  }
+
+  void CalculateIntensityPeakFromPreprocessing(mitk::GlobalImageFeaturePreprocessing* preprocessing, const mitk::Image* mask, GIFIntensityVolumeHistogramFeaturesParameters params, mitk::GIFIntensityVolumeHistogramFeatures::FeatureListType& featureList)
+  {
+    mitk::IntensityQuantifier::Pointer quantifier = params.quantifier;
+    MITK_INFO << "Quantification: " << quantifier->GetMinimum() << " to " << quantifier->GetMaximum() << " with " << quantifier->GetBins() << " bins";
+
+    const auto& quantized = preprocessing->GetQuantizedVoxels(mask, quantifier);
+    std::vector<double> hist;
+    hist.resize(quantifier->GetBins(), 0);
+    for (auto index : quantized)
+    {
+      hist[index] += 1.0;
+    }
+
+    CalculateIntensityVolumeHistogramFeatures(hist, static_cast<int>(quantized.size()), params, featureList);
+  }
 }
 
 mitk::GIFIntensityVolumeHistogramFeatures::GIFIntensityVolumeHistogramFeatures()
@@ -138,7 +161,15 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFIntensityVolumeHistog
   GIFIntensityVolumeHistogramFeaturesParameters params;
   params.quantifier = GetQuantifier();
   params.id = this->CreateTemplateFeatureID();
-  AccessByItk_3(image, CalculateIntensityPeak, mask, params, featureList);
+  auto preprocessing = this->GetPreprocessingForImage(image);
+  if (nullptr != preprocessing)
+  {
+    CalculateIntensityPeakFromPreprocessing(preprocessing, mask, params, featureList);
+  }
+  else
+  {
+    AccessByItk_3(image, CalculateIntensityPeak, mask, params, featureList);
+  }
   MITK_INFO << "Finished calculating local intensity features....";
 
   return featureList;
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include <mitkGlobalImageFeaturesParameter.h>
 
 
+#include <algorithm>
 #include <fstream>
 #include <itkFileTools.h>
 #include <itksys/SystemTools.hxx>
@@ -58,6 +59,7 @@ void mitk::cl::GlobalImageFeaturesParameter::AddParameter(mitkCommandLineParser
   parser.addArgument("encode-parameter-in-name", "encode-parameter", mitkCommandLineParser::Bool, "Bool", "If true, the parameters used for each feature is encoded in its name.", us::Any());
   parser.addArgument("pipeline-uid", "p", mitkCommandLineParser::String, "Pipeline UID", "UID that is stored in the XML output and identifies the processing pipeline the app is used in.", us::Any());
   parser.addArgument("all-features", "a", mitkCommandLineParser::Bool, "Calculate all features", "If true, all features will be calculated and the feature specific activation will be ignored.", us::Any());
+  parser.addArgument("feature-threads", "ft", mitkCommandLineParser::Int, "Int", "Number of feature classes that are calculated in parallel on the shared preprocessing results. (Default: 1)", us::Any());
 }
 
 void mitk::cl::GlobalImageFeaturesParameter::ParseParameter(std::map<std::string, us::Any> parsedArgs)
@@ -153,6 +155,12 @@ void mitk::cl::GlobalImageFeaturesParameter::ParseAdditionalOutputs(std::map<std
   }
 
   calculateAllFeatures = parsedArgs.count("all-features");
+
+  numberOfFeatureThreads = 1;
+  if (parsedArgs.count("feature-threads"))
+  {
+    numberOfFeatureThreads = std::max(1, us::any_cast<int>(parsedArgs["feature-threads"]));
+  }
 }
 
 void mitk::cl::GlobalImageFeaturesParameter::ParseHeaderInformation(std::map<std::string, us::Any> &parsedArgs)
@@ -11,6 +11,7 @@ set(MODULE_TESTS
   mitkGIFLocalIntensityTest.cpp
   mitkGIFNeighbourhoodGreyToneDifferenceFeaturesTest.cpp
   mitkGIFNeighbouringGreyLevelDependenceFeatureTest.cpp
+  mitkGIFTextureMatrixRegressionTest.cpp
   mitkGIFVolumetricDensityStatisticsTest.cpp
   mitkGIFVolumetricStatisticsTest.cpp
 )
@@ -24,6 +24,7 @@ class mitkGIFIntensityVolumeHistogramTestSuite : public mitk::TestFixture
   MITK_TEST(ImageDescription_PhantomTest_Large);
   MITK_TEST(ImageDescription_PhantomTest_Small);
   MITK_TEST(ImageDescription_PhantomTest_2D);
+  MITK_TEST(ImageDescription_PhantomTest_SharedPreprocessing);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -150,6 +151,23 @@ public:
     CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("SliceWise Var. Intensity Volume Histogram::Area under IVH curve  with Large IBSI Phantom Image", 0.0110923, results["SliceWise Var. Intensity Volume Histogram::Area under IVH curve"], 0.001);
   }
 
+  void ImageDescription_PhantomTest_SharedPreprocessing()
+  {
+    mitk::GIFIntensityVolumeHistogramFeatures::Pointer featureCalculator = mitk::GIFIntensityVolumeHistogramFeatures::New();
+    auto referenceList = featureCalculator->CalculateFeatures(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large);
+
+    auto preprocessing = mitk::GlobalImageFeaturePreprocessing::New();
+    preprocessing->SetImage(m_IBSI_Phantom_Image_Large);
+    featureCalculator->SetPreprocessing(preprocessing);
+    auto featureList = featureCalculator->CalculateFeatures(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Shared preprocessing should not change the number of features.", referenceList.size(), featureList.size());
+    for (std::size_t i = 0; i < featureList.size(); ++i)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(featureList[i].first.name + " with shared preprocessing", referenceList[i].second, featureList[i].second, 0.000001);
+    }
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkGIFIntensityVolumeHistogram)
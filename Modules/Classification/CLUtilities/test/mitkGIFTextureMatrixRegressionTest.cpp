@@ -0,0 +1,351 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+#include <mitkITKImageImport.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include <itkImage.h>
+
+#include <mitkGIFCooccurenceMatrix2.h>
+#include <mitkGIFGreyLevelRunLength.h>
+#include <mitkGIFGreyLevelSizeZone.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/** Checks the sparse and parallel texture matrices (co-occurrence, size zone and run length)
+* against dense reference matrices calculated in this test and against serial calculations.
+* The test image is large enough to split the co-occurrence matrices into several voxel slabs.*/
+class mitkGIFTextureMatrixRegressionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkGIFTextureMatrixRegressionTestSuite);
+
+  MITK_TEST(CooccurenceMatrix_DenseReference);
+  MITK_TEST(SizeZone_DenseReference);
+  MITK_TEST(CooccurenceMatrix_SerialEqualsParallel);
+  MITK_TEST(SizeZone_SerialEqualsParallel);
+  MITK_TEST(RunLength_SerialEqualsParallel);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<double, 3> ImageType;
+  typedef itk::Image<unsigned short, 3> MaskType;
+  typedef std::map<std::string, double> ResultMapType;
+
+  static const int SizeX = 48;
+  static const int SizeY = 40;
+  static const int SizeZ = 24;
+  static const int NumberOfBins = 6;
+
+  mitk::Image::Pointer m_Image;
+  mitk::Image::Pointer m_Mask;
+
+  // Grey level index (0..NumberOfBins-1) of each voxel, -1 outside of the mask
+  std::vector<int> m_Levels;
+
+  int m_NumberOfThreads;
+
+  static int Index(int x, int y, int z)
+  {
+    return x + SizeX * (y + SizeY * z);
+  }
+
+  int Level(int x, int y, int z) const
+  {
+    if (x < 0 || y < 0 || z < 0 || x >= SizeX || y >= SizeY || z >= SizeZ)
+      return -1;
+    return m_Levels[Index(x, y, z)];
+  }
+
+  template <class TFeature>
+  typename TFeature::Pointer CreateFeature()
+  {
+    auto feature = TFeature::New();
+    feature->SetUseBinsize(true);
+    feature->SetBinsize(1.0);
+    feature->SetUseMinimumIntensity(true);
+    feature->SetUseMaximumIntensity(true);
+    feature->SetMinimumIntensity(0.5);
+    feature->SetMaximumIntensity(NumberOfBins + 0.5);
+    return feature;
+  }
+
+  template <class TFeature>
+  ResultMapType Calculate(int numberOfThreads)
+  {
+#ifdef _OPENMP
+    omp_set_num_threads(numberOfThreads);
+#else
+    (void)numberOfThreads;
+#endif
+    auto featureList = CreateFeature<TFeature>()->CalculateFeatures(m_Image, m_Mask);
+#ifdef _OPENMP
+    omp_set_num_threads(m_NumberOfThreads);
+#endif
+
+    ResultMapType results;
+    for (const auto &valuePair : featureList)
+    {
+      results[valuePair.first.featureClass + "::" + valuePair.first.name] = valuePair.second;
+    }
+    return results;
+  }
+
+  void AssertEqualResults(const ResultMapType &serial, const ResultMapType &parallel)
+  {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Serial and parallel calculation should return the same features.", serial.size(), parallel.size());
+    for (const auto &feature : serial)
+    {
+      auto finding = parallel.find(feature.first);
+      CPPUNIT_ASSERT_MESSAGE(feature.first + " missing in parallel calculation", finding != parallel.end());
+      if (std::isnan(feature.second))
+      {
+        CPPUNIT_ASSERT_MESSAGE(feature.first + " differs between serial and parallel calculation", std::isnan(finding->second));
+        continue;
+      }
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(feature.first + " differs between serial and parallel calculation",
+        feature.second, finding->second, 1e-9 * std::max(1.0, std::abs(feature.second)));
+    }
+  }
+
+  /** Dense co-occurrence matrix of the given offsets, each pair is counted in both directions.*/
+  std::vector<double> DenseCooccurenceMatrix(const std::vector<std::vector<int> > &offsets) const
+  {
+    std::vector<double> matrix(NumberOfBins * NumberOfBins, 0.0);
+    for (int z = 0; z < SizeZ; ++z)
+      for (int y = 0; y < SizeY; ++y)
+        for (int x = 0; x < SizeX; ++x)
+        {
+          int i = Level(x, y, z);
+          if (i < 0)
+            continue;
+          for (const auto &offset : offsets)
+          {
+            int j = Level(x + offset[0], y + offset[1], z + offset[2]);
+            if (j < 0)
+              continue;
+            matrix[i * NumberOfBins + j] += 1;
+            matrix[j * NumberOfBins + i] += 1;
+          }
+        }
+    return matrix;
+  }
+
+  static ResultMapType DenseCooccurenceFeatures(std::vector<double> matrix)
+  {
+    double sum = 0;
+    for (auto value : matrix)
+      sum += value;
+
+    ResultMapType results;
+    for (int i = 0; i < NumberOfBins; ++i)
+    {
+      for (int j = 0; j < NumberOfBins; ++j)
+      {
+        double pij = matrix[i * NumberOfBins + j] / sum;
+        results["Joint Maximum"] = std::max(results["Joint Maximum"], pij);
+        results["Joint Average"] += (i + 1) * pij;
+        results["Contrast"] += (i - j) * (i - j) * pij;
+        results["Angular Second Moment"] += pij * pij;
+        if (pij > 0)
+          results["Joint Entropy"] -= pij * std::log(pij) / std::log(2);
+      }
+    }
+    return results;
+  }
+
+  static std::vector<std::vector<int> > HalfNeighborhoodOffsets()
+  {
+    std::vector<std::vector<int> > offsets;
+    for (int d = 0; d < 13; ++d)
+    {
+      offsets.push_back({ d % 3 - 1, (d / 3) % 3 - 1, d / 9 - 1 });
+    }
+    return offsets;
+  }
+
+public:
+
+  void setUp(void) override
+  {
+    m_Levels.assign(SizeX * SizeY * SizeZ, -1);
+
+    auto image = ImageType::New();
+    auto mask = MaskType::New();
+    ImageType::RegionType region;
+    region.SetSize({ { SizeX, SizeY, SizeZ } });
+    image->SetRegions(region);
+    image->Allocate();
+    mask->SetRegions(region);
+    mask->Allocate();
+
+    for (int z = 0; z < SizeZ; ++z)
+    {
+      for (int y = 0; y < SizeY; ++y)
+      {
+        for (int x = 0; x < SizeX; ++x)
+        {
+          // Piecewise constant regions with some scattered voxels, so that zones of different sizes exist
+          int level = (x / 3 + y / 4 + z / 2 + ((x * 7 + y * 13 + z * 17) % 5 == 0 ? 1 : 0)) % NumberOfBins;
+          // The mask excludes two border planes and a cube inside of the image
+          bool inside = x >= 2 && !(x >= 10 && x < 16 && y >= 10 && y < 16 && z >= 10 && z < 16);
+
+          ImageType::IndexType index = { { x, y, z } };
+          image->SetPixel(index, level + 1);
+          mask->SetPixel(index, inside ? 1 : 0);
+          if (inside)
+            m_Levels[Index(x, y, z)] = level;
+        }
+      }
+    }
+
+    m_Image = mitk::GrabItkImageMemory(image);
+    m_Mask = mitk::GrabItkImageMemory(mask);
+
+#ifdef _OPENMP
+    m_NumberOfThreads = omp_get_max_threads();
+#else
+    m_NumberOfThreads = 1;
+#endif
+  }
+
+  void tearDown(void) override
+  {
+    m_Image = nullptr;
+    m_Mask = nullptr;
+  }
+
+  void CooccurenceMatrix_DenseReference()
+  {
+    auto results = Calculate<mitk::GIFCooccurenceMatrix2>(4);
+    auto offsets = HalfNeighborhoodOffsets();
+
+    auto overall = DenseCooccurenceFeatures(DenseCooccurenceMatrix(offsets));
+    for (const auto &feature : overall)
+    {
+      std::string name = "Co-occurenced Based Features::Overall " + feature.first;
+      CPPUNIT_ASSERT_MESSAGE(name + " not calculated", results.count(name) == 1);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(name + " differs from dense reference", feature.second, results[name], 1e-9);
+    }
+
+    ResultMapType mean;
+    for (const auto &offset : offsets)
+    {
+      for (const auto &feature : DenseCooccurenceFeatures(DenseCooccurenceMatrix({ offset })))
+      {
+        mean[feature.first] += feature.second / offsets.size();
+      }
+    }
+    for (const auto &feature : mean)
+    {
+      std::string name = "Co-occurenced Based Features::Mean " + feature.first;
+      CPPUNIT_ASSERT_MESSAGE(name + " not calculated", results.count(name) == 1);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(name + " differs from dense reference", feature.second, results[name], 1e-9);
+    }
+  }
+
+  void SizeZone_DenseReference()
+  {
+    auto results = Calculate<mitk::GIFGreyLevelSizeZone>(4);
+
+    // Dense size zone matrix: 26-connected zones of equal grey level
+    std::vector<std::vector<double> > matrix(NumberOfBins, std::vector<double>(SizeX * SizeY * SizeZ, 0.0));
+    std::vector<bool> visited(SizeX * SizeY * SizeZ, false);
+    for (int z = 0; z < SizeZ; ++z)
+      for (int y = 0; y < SizeY; ++y)
+        for (int x = 0; x < SizeX; ++x)
+        {
+          int level = Level(x, y, z);
+          if (level < 0 || visited[Index(x, y, z)])
+            continue;
+
+          int zoneSize = 0;
+          std::vector<std::vector<int> > stack = { { x, y, z } };
+          visited[Index(x, y, z)] = true;
+          while (!stack.empty())
+          {
+            auto current = stack.back();
+            stack.pop_back();
+            ++zoneSize;
+            for (int dz = -1; dz <= 1; ++dz)
+              for (int dy = -1; dy <= 1; ++dy)
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                  int nx = current[0] + dx;
+                  int ny = current[1] + dy;
+                  int nz = current[2] + dz;
+                  if (Level(nx, ny, nz) == level && !visited[Index(nx, ny, nz)])
+                  {
+                    visited[Index(nx, ny, nz)] = true;
+                    stack.push_back({ nx, ny, nz });
+                  }
+                }
+          }
+          matrix[level][zoneSize - 1] += 1;
+        }
+
+    double numberOfZones = 0;
+    double numberOfVoxels = 0;
+    double smallZoneEmphasis = 0;
+    double largeZoneEmphasis = 0;
+    double greyLevelNonUniformity = 0;
+    double zoneSizeNonUniformity = 0;
+    std::vector<double> zonesPerSize(SizeX * SizeY * SizeZ, 0.0);
+    for (int i = 0; i < NumberOfBins; ++i)
+    {
+      double zonesPerLevel = 0;
+      for (std::size_t j = 0; j < matrix[i].size(); ++j)
+      {
+        double count = matrix[i][j];
+        numberOfZones += count;
+        numberOfVoxels += count * (j + 1);
+        smallZoneEmphasis += count / (j + 1) / (j + 1);
+        largeZoneEmphasis += count * (j + 1) * (j + 1);
+        zonesPerLevel += count;
+        zonesPerSize[j] += count;
+      }
+      greyLevelNonUniformity += zonesPerLevel * zonesPerLevel;
+    }
+    for (auto count : zonesPerSize)
+      zoneSizeNonUniformity += count * count;
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Small Zone Emphasis differs from dense reference", smallZoneEmphasis / numberOfZones, results["Grey Level Size Zone::Small Zone Emphasis"], 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Large Zone Emphasis differs from dense reference", largeZoneEmphasis / numberOfZones, results["Grey Level Size Zone::Large Zone Emphasis"], 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Grey Level Non-Uniformity differs from dense reference", greyLevelNonUniformity / numberOfZones, results["Grey Level Size Zone::Grey Level Non-Uniformity"], 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Zone Size Non-Uniformity differs from dense reference", zoneSizeNonUniformity / numberOfZones, results["Grey Level Size Zone::Zone Size Non-Uniformity"], 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Zone Percentage differs from dense reference", numberOfZones / numberOfVoxels, results["Grey Level Size Zone::Zone Percentage"], 1e-9);
+  }
+
+  void CooccurenceMatrix_SerialEqualsParallel()
+  {
+    AssertEqualResults(Calculate<mitk::GIFCooccurenceMatrix2>(1), Calculate<mitk::GIFCooccurenceMatrix2>(4));
+  }
+
+  void SizeZone_SerialEqualsParallel()
+  {
+    AssertEqualResults(Calculate<mitk::GIFGreyLevelSizeZone>(1), Calculate<mitk::GIFGreyLevelSizeZone>(4));
+  }
+
+  void RunLength_SerialEqualsParallel()
+  {
+    AssertEqualResults(Calculate<mitk::GIFGreyLevelRunLength>(1), Calculate<mitk::GIFGreyLevelRunLength>(4));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkGIFTextureMatrixRegression)
@@ -10,9 +10,155 @@ found in the LICENSE file.
 
 ============================================================================*/
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <mitkContourElement.h>
 #include <vtkMath.h>
 
+namespace
+{
+  // Minimal number of vertices of a contour for which point queries use the spatial grid.
+  constexpr mitk::ContourElement::VertexSizeType SpatialGridMinimalSize = 256;
+
+  // Minimal number of vertex instances allocated at once.
+  constexpr mitk::ContourElement::VertexSizeType MinimalVertexBlockSize = 64;
+}
+
+/** Uniform grid over the vertex coordinates. The vertex indices are sorted by cell,
+the indices of cell c are VertexIndices[CellStarts[c]] to VertexIndices[CellStarts[c+1]-1].*/
+struct mitk::ContourElement::SpatialGrid
+{
+  explicit SpatialGrid(const VertexListType& vertices)
+  {
+    const auto numberOfVertices = vertices.size();
+
+    Point3D maxPoint = vertices.front()->Coordinates;
+    Origin = maxPoint;
+
+    for (const auto vertex : vertices)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        Origin[i] = std::min(Origin[i], vertex->Coordinates[i]);
+        maxPoint[i] = std::max(maxPoint[i], vertex->Coordinates[i]);
+      }
+    }
+
+    // Contours are usually planar curves, so about sqrt(n) cells per in-plane axis give few vertices per cell.
+    // The cell size is increased until the grid has at most 4n cells.
+    const auto maxExtent = std::max({ maxPoint[0] - Origin[0], maxPoint[1] - Origin[1], maxPoint[2] - Origin[2] });
+    CellSize = maxExtent / std::ceil(std::sqrt(static_cast<double>(numberOfVertices)));
+
+    if (!(CellSize > 0.0))
+      CellSize = 1.0;
+
+    while (true)
+    {
+      double numberOfCells = 1.0;
+
+      for (int i = 0; i < 3; ++i)
+        numberOfCells *= std::floor((maxPoint[i] - Origin[i]) / CellSize) + 1.0;
+
+      if (numberOfCells <= 4.0 * numberOfVertices)
+        break;
+
+      CellSize *= 2.0;
+    }
+
+    for (int i = 0; i < 3; ++i)
+      Dimensions[i] = static_cast<VertexSizeType>((maxPoint[i] - Origin[i]) / CellSize) + 1;
+
+    std::vector<VertexSizeType> cellIndices(numberOfVertices);
+    CellStarts.assign(Dimensions[0] * Dimensions[1] * Dimensions[2] + 1, 0);
+
+    for (VertexSizeType index = 0; index < numberOfVertices; ++index)
+    {
+      const auto& coordinates = vertices[index]->Coordinates;
+      std::array<VertexSizeType, 3> cell;
+
+      for (int i = 0; i < 3; ++i)
+        cell[i] = std::min(Dimensions[i] - 1, static_cast<VertexSizeType>((coordinates[i] - Origin[i]) / CellSize));
+
+      cellIndices[index] = this->GetCellIndex(cell);
+      ++CellStarts[cellIndices[index] + 1];
+    }
+
+    for (VertexSizeType cellIndex = 1; cellIndex < CellStarts.size(); ++cellIndex)
+      CellStarts[cellIndex] += CellStarts[cellIndex - 1];
+
+    auto nextPositions = CellStarts;
+    VertexIndices.resize(numberOfVertices);
+
+    for (VertexSizeType index = 0; index < numberOfVertices; ++index)
+      VertexIndices[nextPositions[cellIndices[index]]++] = index;
+  }
+
+  VertexSizeType GetCellIndex(const std::array<VertexSizeType, 3>& cell) const
+  {
+    return (cell[2] * Dimensions[1] + cell[1]) * Dimensions[0] + cell[0];
+  }
+
+  /** Returns the index of the nearest (control) vertex with a distance smaller than eps or NPOS.
+  Like the brute force search, the first vertex of the list wins if several vertices are equally near.*/
+  VertexSizeType FindNearest(const VertexListType& vertices, const Point3D& point, double eps, bool isControlPoint) const
+  {
+    std::array<VertexSizeType, 3> firstCell;
+    std::array<VertexSizeType, 3> lastCell;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      const auto first = std::floor((point[i] - eps - Origin[i]) / CellSize);
+      const auto last = std::floor((point[i] + eps - Origin[i]) / CellSize);
+
+      if (!(last >= 0.0 && first < static_cast<double>(Dimensions[i])))
+        return NPOS;
+
+      firstCell[i] = first > 0.0 ? static_cast<VertexSizeType>(first) : 0;
+      lastCell[i] = std::min(Dimensions[i] - 1, static_cast<VertexSizeType>(last));
+    }
+
+    VertexSizeType nearestIndex = NPOS;
+    double nearestDistance = std::numeric_limits<double>::max();
+    std::array<VertexSizeType, 3> cell;
+
+    for (cell[2] = firstCell[2]; cell[2] <= lastCell[2]; ++cell[2])
+    {
+      for (cell[1] = firstCell[1]; cell[1] <= lastCell[1]; ++cell[1])
+      {
+        for (cell[0] = firstCell[0]; cell[0] <= lastCell[0]; ++cell[0])
+        {
+          const auto cellIndex = this->GetCellIndex(cell);
+
+          for (auto position = CellStarts[cellIndex]; position < CellStarts[cellIndex + 1]; ++position)
+          {
+            const auto index = VertexIndices[position];
+            const auto vertex = vertices[index];
+
+            if (isControlPoint && !vertex->IsControlPoint)
+              continue;
+
+            const auto distance = vertex->Coordinates.EuclideanDistanceTo(point);
+
+            if (distance < eps && (distance < nearestDistance || (distance == nearestDistance && index < nearestIndex)))
+            {
+              nearestIndex = index;
+              nearestDistance = distance;
+            }
+          }
+        }
+      }
+    }
+
+    return nearestIndex;
+  }
+
+  Point3D Origin;
+  double CellSize;
+  std::array<VertexSizeType, 3> Dimensions;
+  std::vector<VertexSizeType> CellStarts;
+  std::vector<VertexSizeType> VertexIndices;
+};
+
 bool mitk::ContourElement::ContourModelVertex::operator==(const ContourModelVertex &other) const
 {
   return this->Coordinates == other.Coordinates && this->IsControlPoint == other.IsControlPoint;
@@ -58,12 +204,16 @@ mitk::ContourElement::VertexIterator mitk::ContourElement::end()
   return this->m_Vertices.end();
 }
 
+mitk::ContourElement::ContourElement() = default;
+
 mitk::ContourElement::ContourElement(const mitk::ContourElement &other)
   : itk::LightObject(), m_IsClosed(other.m_IsClosed)
 {
+  this->ReserveVertexStorage(other.m_Vertices.size());
+
   for (const auto &v : other.m_Vertices)
   {
-    m_Vertices.push_back(new ContourModelVertex(*v));
+    m_Vertices.push_back(this->CreateVertex(v->Coordinates, v->IsControlPoint));
   }
 }
 
@@ -72,9 +222,11 @@ mitk::ContourElement &mitk::ContourElement::operator=(const ContourElement &othe
   if (this != &other)
   {
     this->Clear();
+    this->ReserveVertexStorage(other.m_Vertices.size());
+
     for (const auto &v : other.m_Vertices)
     {
-      m_Vertices.push_back(new ContourModelVertex(*v));
+      m_Vertices.push_back(this->CreateVertex(v->Coordinates, v->IsControlPoint));
     }
   }
 
@@ -92,14 +244,80 @@ mitk::ContourElement::VertexSizeType mitk::ContourElement::GetSize() const
   return this->m_Vertices.size();
 }
 
+mitk::ContourElement::VertexType *mitk::ContourElement::CreateVertex(const mitk::Point3D &point, bool isControlPoint)
+{
+  this->InvalidateSpatialGrid();
+
+  if (!m_FreeVertices.empty())
+  {
+    auto vertex = m_FreeVertices.back();
+    m_FreeVertices.pop_back();
+
+    vertex->Coordinates = point;
+    vertex->IsControlPoint = isControlPoint;
+    return vertex;
+  }
+
+  if (m_VertexBlocks.empty() || m_VertexBlocks.back().size() == m_VertexBlocks.back().capacity())
+  {
+    // Grow geometrically to keep the number of allocations logarithmic in the number of vertices.
+    this->ReserveVertexStorage(std::max(MinimalVertexBlockSize, m_Vertices.size()));
+  }
+
+  // The capacity of a block is never exceeded, so the vertex instances of a block are never moved.
+  auto &block = m_VertexBlocks.back();
+  block.emplace_back(point, isControlPoint);
+  return &block.back();
+}
+
+void mitk::ContourElement::ReleaseVertex(VertexType *vertex)
+{
+  this->InvalidateSpatialGrid();
+  m_FreeVertices.push_back(vertex);
+}
+
+void mitk::ContourElement::ReserveVertexStorage(VertexSizeType count)
+{
+  if (count <= m_FreeVertices.size())
+    return;
+
+  count -= m_FreeVertices.size();
+
+  if (!m_VertexBlocks.empty() && m_VertexBlocks.back().capacity() - m_VertexBlocks.back().size() >= count)
+    return;
+
+  m_VertexBlocks.emplace_back();
+  m_VertexBlocks.back().reserve(std::max(MinimalVertexBlockSize, count));
+}
+
 void mitk::ContourElement::AddVertex(const mitk::Point3D &vertex, bool isControlPoint)
 {
-  this->m_Vertices.push_back(new VertexType(vertex, isControlPoint));
+  this->m_Vertices.push_back(this->CreateVertex(vertex, isControlPoint));
+}
+
+void mitk::ContourElement::AddVertices(const std::vector<mitk::Point3D> &points, bool isControlPoint)
+{
+  this->ReserveVertexStorage(points.size());
+
+  for (const auto &point : points)
+  {
+    this->m_Vertices.push_back(this->CreateVertex(point, isControlPoint));
+  }
+}
+
+void mitk::ContourElement::AddVertices(const std::vector<VertexType> &vertices)
+{
+  this->ReserveVertexStorage(vertices.size());
+
+  for (const auto &vertex : vertices)
+  {
+    this->m_Vertices.push_back(this->CreateVertex(vertex.Coordinates, vertex.IsControlPoint));
+  }
 }
 
 void mitk::ContourElement::AddVertexAtFront(const mitk::Point3D &vertex, bool isControlPoint)
 {
-  this->m_Vertices.push_front(new VertexType(vertex, isControlPoint));
+  this->m_Vertices.push_front(this->CreateVertex(vertex, isControlPoint));
 }
 
 void mitk::ContourElement::InsertVertexAtIndex(const mitk::Point3D &vertex, bool isControlPoint, VertexSizeType index)
@@ -108,7 +326,7 @@ void mitk::ContourElement::InsertVertexAtIndex(const mitk::Point3D &vertex, bool
   {
     auto _where = this->m_Vertices.begin();
     _where += index;
-    this->m_Vertices.insert(_where, new VertexType(vertex, isControlPoint));
+    this->m_Vertices.insert(_where, this->CreateVertex(vertex, isControlPoint));
   }
 }
 
@@ -117,6 +335,7 @@ void mitk::ContourElement::SetVertexAt(VertexSizeType pointId, const Point3D &po
   if (this->GetSize() > pointId)
   {
     this->m_Vertices[pointId]->Coordinates = point;
+    this->InvalidateSpatialGrid();
   }
 }
 
@@ -131,6 +350,7 @@ void mitk::ContourElement::SetVertexAt(VertexSizeType pointId, const VertexType
   {
     this->m_Vertices[pointId]->Coordinates = vertex->Coordinates;
     this->m_Vertices[pointId]->IsControlPoint = vertex->IsControlPoint;
+    this->InvalidateSpatialGrid();
   }
 }
 
@@ -151,24 +371,18 @@ bool mitk::ContourElement::IsEmpty() const
 
 mitk::ContourElement::VertexType *mitk::ContourElement::GetControlVertexAt(const mitk::Point3D &point, float eps)
 {
-  /* current version iterates over the whole deque - should some kind of an octree with spatial query*/
-
   if (eps > 0)
   {
-    // currently no method with better performance is available
-    return BruteForceGetVertexAt(point, eps, true);
+    return this->FindNearestVertex(point, eps, true);
   } // if eps < 0
   return nullptr;
 }
 
 mitk::ContourElement::VertexType *mitk::ContourElement::GetVertexAt(const mitk::Point3D &point, float eps)
 {
-  /* current version iterates over the whole deque - should some kind of an octree with spatial query*/
-
   if (eps > 0)
   {
-    // currently no method with better performance is available
-    return BruteForceGetVertexAt(point, eps);
+    return this->FindNearestVertex(point, eps, false);
   } // if eps < 0
   return nullptr;
 }
@@ -197,22 +411,53 @@ mitk::ContourElement::VertexType *mitk::ContourElement::GetPreviousControlVertex
   return nullptr;
 }
 
+mitk::ContourElement::VertexType *mitk::ContourElement::FindNearestVertex(const mitk::Point3D &point,
+                                                                          double eps,
+                                                                          bool isControlPoint)
+{
+  if (this->m_Vertices.size() < SpatialGridMinimalSize)
+  {
+    return this->BruteForceGetVertexAt(point, eps, isControlPoint);
+  }
+
+  if (eps < 0)
+  {
+    mitkThrow() << "Distance cannot be negative";
+  }
+
+  if (nullptr == m_SpatialGrid)
+  {
+    m_SpatialGrid = std::make_unique<SpatialGrid>(this->m_Vertices);
+  }
+
+  const auto index = m_SpatialGrid->FindNearest(this->m_Vertices, point, eps, isControlPoint);
+
+  return NPOS != index
+    ? this->m_Vertices[index]
+    : nullptr;
+}
+
+void mitk::ContourElement::InvalidateSpatialGrid()
+{
+  m_SpatialGrid.reset();
+}
+
 mitk::ContourElement::VertexType *mitk::ContourElement::BruteForceGetVertexAt(const mitk::Point3D &point,
                                                                               double eps,
                                                                               bool isControlPoint,
                                                                               int offset)
 {
-  VertexListType verticesList;
+  VertexListType controlVertices;
 
   if (isControlPoint)
   {
-    verticesList = this->GetControlVertices();
-  }
-  else
-  {
-    verticesList = *this->GetVertexList();
+    controlVertices = this->GetControlVertices();
   }
 
+  const auto &verticesList = isControlPoint
+    ? controlVertices
+    : this->m_Vertices;
+
   int vertexIndex = BruteForceGetVertexIndexAt(point, eps, verticesList);
 
   if (vertexIndex!=-1)
@@ -238,7 +483,7 @@ mitk::ContourElement::VertexType *mitk::ContourElement::BruteForceGetVertexAt(co
 
 int mitk::ContourElement::BruteForceGetVertexIndexAt(const mitk::Point3D &point,
                                                      double eps,
-                                                     VertexListType verticesList)
+                                                     const VertexListType &verticesList)
 {
   if (eps < 0)
   {
@@ -414,6 +659,11 @@ void mitk::ContourElement::Concatenate(const mitk::ContourElement *other, bool c
 {
   if (other->GetSize() > 0)
   {
+    if (!check)
+    {
+      this->ReserveVertexStorage(other->GetSize());
+    }
+
     for (const auto &sourceVertex : other->m_Vertices)
     {
       if (check)
@@ -425,12 +675,12 @@ void mitk::ContourElement::Concatenate(const mitk::ContourElement *other, bool c
 
         if (finding == this->m_Vertices.end())
         {
-          this->m_Vertices.push_back(new ContourModelVertex(*sourceVertex));
+          this->m_Vertices.push_back(this->CreateVertex(sourceVertex->Coordinates, sourceVertex->IsControlPoint));
         }
       }
       else
       {
-        this->m_Vertices.push_back(new ContourModelVertex(*sourceVertex));
+        this->m_Vertices.push_back(this->CreateVertex(sourceVertex->Coordinates, sourceVertex->IsControlPoint));
       }
     }
   }
@@ -485,7 +735,7 @@ bool mitk::ContourElement::RemoveVertexByIterator(VertexListType::iterator &iter
 {
   if (iter != this->m_Vertices.end())
   {
-    delete *iter;
+    this->ReleaseVertex(*iter);
     this->m_Vertices.erase(iter);
     return true;
   }
@@ -495,11 +745,10 @@ bool mitk::ContourElement::RemoveVertexByIterator(VertexListType::iterator &iter
 
 void mitk::ContourElement::Clear()
 {
-  for (auto vertex : m_Vertices)
-  {
-    delete vertex;
-  }
   this->m_Vertices.clear();
+  this->m_FreeVertices.clear();
+  this->m_VertexBlocks.clear();
+  this->InvalidateSpatialGrid();
 }
 
 //----------------------------------------------------------------------
@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include <mitkNumericTypes.h>
 
 #include <deque>
+#include <memory>
+#include <vector>
 
 namespace mitk
 {
@@ -26,6 +28,12 @@ namespace mitk
   end of the contour and to iterate in both directions.
   To mark a vertex as a special one it can be set as a control point.
 
+  The vertex instances are allocated block wise, so vertices added in one go (see AddVertices()) are stored
+  contiguously. The pointers to the vertices stay valid until the respective vertex is removed.
+  Point queries of large contours use a uniform grid over the vertex coordinates that is built on demand
+  and discarded whenever vertices are changed via the ContourElement. If coordinates of vertices are changed
+  directly via vertex pointers, InvalidateSpatialGrid() has to be called.
+
   \note This class assumes that it manages its vertices. So if a vertex instance is added to this
   class the ownership of the vertex is transferred to the ContourElement instance.
   The ContourElement instance takes care of deleting vertex instances if needed.
@@ -111,6 +119,17 @@ namespace mitk
     */
     void AddVertex(const mitk::Point3D &point, bool isControlPoint);
 
+    /** \brief Add vertices at the end of the contour
+    \param points - coordinates in 3D space.
+    \param isControlPoint - are the vertices special control points.
+    */
+    void AddVertices(const std::vector<mitk::Point3D> &points, bool isControlPoint);
+
+    /** \brief Add copies of the passed vertices at the end of the contour
+    \param vertices - the vertices to be added.
+    */
+    void AddVertices(const std::vector<VertexType> &vertices);
+
     /** \brief Add a vertex at the front of the contour
     \param point - coordinates in 3D space.
     \param isControlPoint - is the vertex a control point.
@@ -268,7 +287,7 @@ namespace mitk
     */
     int BruteForceGetVertexIndexAt(const mitk::Point3D &point,
                                                       double eps,
-                                                      VertexListType verticesList);
+                                                      const VertexListType &verticesList);
 
     /** Returns a list pointing to all vertices that are indicated to be control
      points.
@@ -285,10 +304,15 @@ namespace mitk
     */
     void RedistributeControlVertices(const VertexType *vertex, int period);
 
+    /** \brief Discards the spatial grid used for point queries.
+    Only needed if coordinates of vertices were changed directly via vertex pointers.
+    */
+    void InvalidateSpatialGrid();
+
   protected:
     mitkCloneMacro(Self);
 
-    ContourElement() = default;
+    ContourElement();
     ContourElement(const mitk::ContourElement &other);
     ~ContourElement();
 
@@ -300,8 +324,25 @@ namespace mitk
     \result Indicates if the element indicated by the iterator was removed. If iterator points to end it returns false.*/
     bool RemoveVertexByIterator(VertexListType::iterator& iter);
 
+    /** Internal helper function that returns a vertex instance from the vertex storage.*/
+    VertexType* CreateVertex(const mitk::Point3D &point, bool isControlPoint);
+    /** Internal helper function that returns a vertex instance to the vertex storage for reuse.*/
+    void ReleaseVertex(VertexType *vertex);
+    /** Internal helper function that ensures that the next count vertices are stored contiguously.*/
+    void ReserveVertexStorage(VertexSizeType count);
+
+    /** Returns the nearest (control) vertex within eps. Uses the spatial grid for large contours.*/
+    VertexType* FindNearestVertex(const mitk::Point3D &point, double eps, bool isControlPoint);
+
     VertexListType m_Vertices; // double ended queue with vertices
     bool m_IsClosed = false;
+
+  private:
+    struct SpatialGrid;
+
+    std::vector<std::vector<VertexType>> m_VertexBlocks; // storage of the vertex instances; blocks never reallocate
+    std::vector<VertexType*> m_FreeVertices; // released vertex instances that can be reused
+    std::unique_ptr<SpatialGrid> m_SpatialGrid;
   };
 } // namespace mitk
 
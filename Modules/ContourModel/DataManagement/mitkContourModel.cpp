@@ -65,6 +65,28 @@ void mitk::ContourModel::AddVertex(const VertexType &vertex, TimeStepType timest
   this->AddVertex(vertex.Coordinates, vertex.IsControlPoint, timestep);
 }
 
+void mitk::ContourModel::AddVertices(const std::vector<Point3D> &vertices, bool isControlPoint, TimeStepType timestep)
+{
+  if (!this->IsEmptyTimeStep(timestep))
+  {
+    this->m_ContourSeries[timestep]->AddVertices(vertices, isControlPoint);
+    this->InvokeEvent(ContourModelSizeChangeEvent());
+    this->Modified();
+    this->m_UpdateBoundingBox = true;
+  }
+}
+
+void mitk::ContourModel::AddVertices(const std::vector<VertexType> &vertices, TimeStepType timestep)
+{
+  if (!this->IsEmptyTimeStep(timestep))
+  {
+    this->m_ContourSeries[timestep]->AddVertices(vertices);
+    this->InvokeEvent(ContourModelSizeChangeEvent());
+    this->Modified();
+    this->m_UpdateBoundingBox = true;
+  }
+}
+
 void mitk::ContourModel::AddVertexAtFront(const Point3D &vertex, TimeStepType timestep)
 {
   if (!this->IsEmptyTimeStep(timestep))
@@ -480,6 +502,13 @@ void mitk::ContourModel::ShiftSelectedVertex(Vector3D &translate)
   if (this->m_SelectedVertex)
   {
     this->ShiftVertex(this->m_SelectedVertex, translate);
+
+    // the selected vertex is changed directly, so the spatial grid of its contour element is outdated
+    for (auto &element : this->m_ContourSeries)
+    {
+      element->InvalidateSpatialGrid();
+    }
+
     this->Modified();
     this->m_UpdateBoundingBox = true;
   }
@@ -495,6 +524,8 @@ void mitk::ContourModel::ShiftContour(Vector3D &translate, TimeStepType timestep
       this->ShiftVertex(vertex, translate);
     }
 
+    this->m_ContourSeries[timestep]->InvalidateSpatialGrid();
+
     this->Modified();
     this->m_UpdateBoundingBox = true;
     this->InvokeEvent(ContourModelShiftEvent());
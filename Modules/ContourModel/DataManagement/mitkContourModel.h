@@ -130,6 +130,25 @@ namespace mitk
     */
     void AddVertex(const Point3D& vertex, bool isControlPoint, TimeStepType timestep = 0);
 
+    /** \brief Add vertices at the end of the contour at given timestep.
+    Use this instead of adding the vertices one by one, if many vertices are added (e.g. by readers).
+    \param vertices - coordinates of the vertices
+    \param isControlPoint - specifies the vertices to be handled in a special way (e.g. control points
+    will be rendered).
+    \param timestep - the timestep at which the vertices will be add ( default 0)
+    @note Adding vertices to a timestep which exceeds the timebounds of the contour
+    will not be added, the TimeGeometry will not be expanded.
+    */
+    void AddVertices(const std::vector<Point3D>& vertices, bool isControlPoint = false, TimeStepType timestep = 0);
+
+    /** \brief Add copies of the passed vertices at the end of the contour at given timestep.
+    \param vertices - the vertices to be added
+    \param timestep - the timestep at which the vertices will be add ( default 0)
+    @note Adding vertices to a timestep which exceeds the timebounds of the contour
+    will not be added, the TimeGeometry will not be expanded.
+    */
+    void AddVertices(const std::vector<VertexType>& vertices, TimeStepType timestep = 0);
+
     /** Clears the contour of destinationTimeStep and copies
         the contour of the passed source model at the sourceTimeStep.
      @pre sourceModel must point to a valid instance
@@ -145,6 +145,8 @@ void mitk::ContourModelReader::ReadPoints(mitk::ContourModel::Pointer newContour
   // read all points within controlPoints tag
   if (currentTimeSeries->FirstChildElement("controlPoints")->FirstChildElement("point") != nullptr)
   {
+    std::vector<mitk::ContourModel::VertexType> vertices;
+
     for (auto *currentPoint =
            currentTimeSeries->FirstChildElement("controlPoints")->FirstChildElement("point")->ToElement();
          currentPoint != nullptr;
@@ -163,8 +165,10 @@ void mitk::ContourModelReader::ReadPoints(mitk::ContourModel::Pointer newContour
 
       mitk::Point3D point;
       mitk::FillVector3D(point, x, y, z);
-      newContourModel->AddVertex(point, isActivePoint, currentTimeStep);
+      vertices.emplace_back(point, isActivePoint != 0);
     }
+
+    newContourModel->AddVertices(vertices, currentTimeStep);
   }
   else
   {
@@ -48,6 +48,9 @@ namespace mitk
 
     /*+++ methods of MITK-VTK rendering pipeline +++*/
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
+
+    /** The contour only depends on the node, its contour model and the world geometry of the renderer */
+    bool DependsOnOtherNodes() const override { return false; }
     /*+++ END methods of MITK-VTK rendering pipeline +++*/
 
     class MITKCONTOURMODEL_EXPORT LocalStorage : public mitk::Mapper::BaseLocalStorage
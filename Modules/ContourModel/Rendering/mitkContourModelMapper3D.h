@@ -50,6 +50,9 @@ namespace mitk
     /*+++ methods of MITK-VTK rendering pipeline +++*/
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
 
+    /** The tube only depends on the node and its contour model */
+    bool DependsOnOtherNodes() const override { return false; }
+
     /*+++ END methods of MITK-VTK rendering pipeline +++*/
 
     class MITKCONTOURMODEL_EXPORT LocalStorage : public mitk::Mapper::BaseLocalStorage
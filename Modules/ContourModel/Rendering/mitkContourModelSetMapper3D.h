@@ -52,6 +52,9 @@ namespace mitk
     /*+++ methods of MITK-VTK rendering pipeline +++*/
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
 
+    /** The tubes only depend on the node and its contour model set */
+    bool DependsOnOtherNodes() const override { return false; }
+
     /*+++ END methods of MITK-VTK rendering pipeline +++*/
 
     class MITKCONTOURMODEL_EXPORT LocalStorage : public mitk::Mapper::BaseLocalStorage
@@ -14,6 +14,7 @@ found in the LICENSE file.
 
 #include "mitkTestFixture.h"
 #include "mitkTestingMacros.h"
+#include <cmath>
 #include <limits>
 
 class mitkContourElementTestSuite : public mitk::TestFixture
@@ -22,9 +23,11 @@ class mitkContourElementTestSuite : public mitk::TestFixture
   // Test the append method
   MITK_TEST(Iterator);
   MITK_TEST(AddVertex);
+  MITK_TEST(AddVertices);
   MITK_TEST(AddVertexAtFront);
   MITK_TEST(InsertVertexAtIndex);
   MITK_TEST(GetSetVertexAt);
+  MITK_TEST(GetVertexAtLargeContour);
   MITK_TEST(OpenAndClose);
   MITK_TEST(OtherGetters);
   MITK_TEST(Concatenate);
@@ -108,6 +111,32 @@ public:
     CPPUNIT_ASSERT(m_Contour_empty->GetSize() == 2);
   }
 
+  void AddVertices()
+  {
+    m_Contour1to4->AddVertices({ m_p5, m_p6 }, true);
+    CPPUNIT_ASSERT(m_Contour1to4->GetSize() == 6);
+    CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(3)->Coordinates == m_p4);
+    CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(4)->Coordinates == m_p5);
+    CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(4)->IsControlPoint == true);
+    CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(5)->Coordinates == m_p6);
+    CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(5)->IsControlPoint == true);
+
+    auto v0 = m_Contour1to4->GetVertexAt(0);
+    m_Contour_empty->AddVertices({ *v0, mitk::ContourElement::VertexType(m_p7, false) });
+    CPPUNIT_ASSERT(m_Contour_empty->GetSize() == 2);
+    CPPUNIT_ASSERT(*(m_Contour_empty->GetVertexAt(0)) == *v0);
+    CPPUNIT_ASSERT(m_Contour_empty->GetVertexAt(0) != v0);
+    CPPUNIT_ASSERT(m_Contour_empty->GetVertexAt(1)->Coordinates == m_p7);
+    CPPUNIT_ASSERT(m_Contour_empty->GetVertexAt(1)->IsControlPoint == false);
+
+    // vertex instances must not move when further vertices are added
+    std::vector<mitk::Point3D> points(1000, m_p1);
+    m_Contour1to4->AddVertices(points, false);
+    CPPUNIT_ASSERT(m_Contour1to4->GetSize() == 1006);
+    CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(0) == v0);
+    CPPUNIT_ASSERT(v0->Coordinates == m_p1);
+  }
+
   void AddVertexAtFront()
   {
     m_Contour_empty->AddVertexAtFront(m_p1, false);
@@ -176,6 +205,42 @@ public:
     CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(1) == finding);
   }
 
+  void GetVertexAtLargeContour()
+  {
+    // circle with enough vertices to use the spatial grid for point queries
+    const int numberOfVertices = 1000;
+    for (int i = 0; i < numberOfVertices; ++i)
+    {
+      const double angle = 2.0 * itk::Math::pi * i / numberOfVertices;
+      mitk::Point3D point;
+      mitk::FillVector3D(point, 100.0 * std::cos(angle), 100.0 * std::sin(angle), 5.0);
+      m_Contour_empty->AddVertex(point, i % 10 == 0);
+    }
+
+    mitk::Point3D search;
+    mitk::FillVector3D(search, 100.0, 0.1, 5.0);
+    CPPUNIT_ASSERT(m_Contour_empty->GetVertexAt(search, 0.5) == m_Contour_empty->GetVertexAt(0));
+    CPPUNIT_ASSERT(m_Contour_empty->GetVertexAt(search, 0.5) == m_Contour_empty->BruteForceGetVertexAt(search, 0.5));
+    CPPUNIT_ASSERT(m_Contour_empty->GetControlVertexAt(search, 0.5) == m_Contour_empty->GetVertexAt(0));
+
+    mitk::FillVector3D(search, -100.0, 0.0, 5.0);
+    CPPUNIT_ASSERT(m_Contour_empty->GetVertexAt(search, 0.5) == m_Contour_empty->GetVertexAt(500));
+
+    mitk::FillVector3D(search, 0.0, 0.0, 5.0);
+    CPPUNIT_ASSERT(nullptr == m_Contour_empty->GetVertexAt(search, 50.0));
+    mitk::FillVector3D(search, 200.0, 0.0, 5.0);
+    CPPUNIT_ASSERT(nullptr == m_Contour_empty->GetVertexAt(search, 1.0));
+
+    // changes of the vertices must be considered by subsequent queries
+    m_Contour_empty->SetVertexAt(3, search);
+    CPPUNIT_ASSERT(m_Contour_empty->GetVertexAt(search, 1.0) == m_Contour_empty->GetVertexAt(3));
+    CPPUNIT_ASSERT(nullptr == m_Contour_empty->GetControlVertexAt(search, 1.0));
+
+    m_Contour_empty->RemoveVertexAt(0);
+    mitk::FillVector3D(search, 100.0, 0.1, 5.0);
+    CPPUNIT_ASSERT(m_Contour_empty->GetVertexAt(search, 0.5) == nullptr);
+  }
+
   void OpenAndClose()
   {
     CPPUNIT_ASSERT(!m_Contour1to4->IsClosed());
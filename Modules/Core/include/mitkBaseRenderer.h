@@ -328,6 +328,17 @@ namespace mitk
       return m_Name.c_str();
     }
 
+    /**
+     * \brief Return the interned name of the base renderer.
+     *
+     * Used to resolve the renderer-specific property lists of data nodes
+     * without string comparisons (see DataNode::GetProperty(const PropertyKey&, ...)).
+     */
+    const PropertyKey& GetNameKey() const
+    {
+      return m_NameKey;
+    }
+
     /**
      * \brief Return the size in x-direction of the base renderer.
      */
@@ -489,6 +500,8 @@ namespace mitk
 
     std::string m_Name;
 
+    PropertyKey m_NameKey;
+
     double m_Bounds[6];
 
     bool m_EmptyWorldGeometry;
@@ -31,6 +31,7 @@ found in the LICENSE file.
 #include "mitkLevelWindow.h"
 #include <map>
 #include <set>
+#include <unordered_map>
 
 class vtkLinearTransform;
 
@@ -231,6 +232,17 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const char *propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
 
+    /**
+     * \brief Get the property with the interned key \a propertyKey.
+     *
+     * Same semantics as GetProperty(const char*, const mitk::BaseRenderer*, bool), but the property lists
+     * (including the BaseRenderer-specific ones) are resolved by hashed lookups of the key ids instead of
+     * string comparisons. Meant for frequent lookups, e.g. by mappers during rendering.
+     * \sa PropertyKey
+     * \sa PropertyKeys
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
+
     /**
      * \brief Get the property of type T with key \a propertyKey from the PropertyList
      * of the \a renderer, if available there, otherwise use the BaseRenderer-independent PropertyList.
@@ -286,6 +298,22 @@ namespace mitk
       return false;
     }
 
+    /**
+     * \brief Convenience access method for GenericProperty<T> properties by interned key
+     * \return \a true property was found
+     */
+    template <typename T>
+    bool GetPropertyValue(const PropertyKey &propertyKey, T &value, const mitk::BaseRenderer *renderer = nullptr) const
+    {
+      GenericProperty<T> *gp = dynamic_cast<GenericProperty<T> *>(GetProperty(propertyKey, renderer));
+      if (gp != nullptr)
+      {
+        value = gp->GetValue();
+        return true;
+      }
+      return false;
+    }
+
     /// \brief Get a set of all group tags from this node's property list
     GroupTagList GetGroupTags() const;
 
@@ -296,6 +324,12 @@ namespace mitk
      */
     bool GetBoolProperty(const char *propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for bool properties by interned key
+     * \return \a true property was found
+     */
+    bool GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for int properties (instances of
      * IntProperty)
@@ -303,6 +337,12 @@ namespace mitk
      */
     bool GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for int properties by interned key
+     * \return \a true property was found
+     */
+    bool GetIntProperty(const PropertyKey &propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for float properties (instances of
      * FloatProperty)
@@ -341,6 +381,12 @@ namespace mitk
      */
     bool GetColor(float rgb[3], const mitk::BaseRenderer *renderer = nullptr, const char *propertyKey = "color") const;
 
+    /**
+     * \brief Convenience access method for color properties by interned key
+     * \return \a true property was found
+     */
+    bool GetColor(float rgb[3], const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const;
+
     /**
      * \brief Convenience access method for level-window properties (instances of
      * LevelWindowProperty)
@@ -451,6 +497,21 @@ namespace mitk
      */
     bool GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const char *propertyKey = "opacity") const;
 
+    /**
+     * \brief Convenience access method for opacity properties by interned key
+     * \return \a true property was found
+     */
+    bool GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const;
+
+    /**
+     * \brief Convenience access method for visibility properties by interned key
+     * \return \a true property was found
+     */
+    bool GetVisibility(bool &visible, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+    {
+      return GetBoolProperty(propertyKey, visible, renderer);
+    }
+
     /**
      * \brief Convenience access method for boolean properties (instances
      * of BoolProperty). Return value is the value of the property. If the property is
@@ -569,6 +630,17 @@ namespace mitk
      */
     itk::ModifiedTimeType GetMTime() const override;
 
+    /**
+     * \brief Get the timestamp of the last change of the contents of this node, the
+     * referenced BaseData, the properties of both or the BaseRenderer-specific
+     * properties of \a renderer.
+     *
+     * Changes of properties do not necessarily modify the node itself (e.g. if a
+     * property value is changed in place), so renderers that cache property values
+     * or mapper states have to use this method.
+     */
+    itk::ModifiedTimeType GetMTime(const mitk::BaseRenderer *renderer) const;
+
     /**
      * \brief Get the timestamp of the last change of the reference to the
      * BaseData.
@@ -603,6 +675,9 @@ namespace mitk
     /// \brief Map associating each BaseRenderer with its own PropertyList
     mutable MapOfPropertyLists m_MapOfPropertyLists;
 
+    /// \brief Index of m_MapOfPropertyLists by the interned renderer name (see BaseRenderer::GetNameKey)
+    mutable std::unordered_map<PropertyKey::IdType, PropertyList *> m_PropertyListsByRendererKey;
+
     DataInteractor::Pointer m_DataInteractor;
 
     /// \brief Timestamp of the last change of m_Data
@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include "usServiceTracker.h"
 #include <MitkCoreExports.h>
 #include <list>
+#include <vector>
 #include <mitkWeakPointer.h>
 
 namespace mitk
@@ -38,6 +39,10 @@ namespace mitk
   * DataNode.
   * Higher layers are preferred.
   *
+  * Mouse move events that arrive while an event is still being processed (e.g. from a nested event loop or a
+  * high-rate input device) are coalesced, only the latest move of each sender is processed afterwards. Pending
+  * moves are processed before any other event, so the order of moves and e.g. mouse presses is kept.
+  *
   * \ingroup Interaction
   */
 
@@ -53,7 +58,8 @@ namespace mitk
     /**
      * To post new Events which are to be handled by the Dispatcher.
      *
-     * @return Returns true if the event has been handled by an DataInteractor, and false else.
+     * @return Returns true if the event has been handled by an DataInteractor, and false else. Coalesced mouse
+     * moves are considered as handled.
      */
     bool ProcessEvent(InteractionEvent *event);
 
@@ -71,6 +77,7 @@ namespace mitk
      * until the next regular event
      * comes in.
      * \note 2) Make sure you're not causing infinite loops!
+     * \note 3) A queued mouse move event replaces a directly preceding queued mouse move event of the same sender.
      */
     void QueueEvent(InteractionEvent *event);
 
@@ -95,6 +102,32 @@ namespace mitk
     ListInteractorType m_Interactors;
     ListEventsType m_QueuedEvents;
 
+    /**
+     * Mouse move events that arrived during the processing of another event, at most one per sender.
+     */
+    ListEventsType m_PendingMouseMoves;
+
+    /**
+     * Number of nested ProcessEvent() calls.
+     */
+    unsigned int m_ProcessingDepth;
+
+    /**
+     * Passes the event to the interactors and observers and processes the queued events afterwards.
+     */
+    bool DispatchEvent(InteractionEvent *event);
+
+    /**
+     * Dispatches the pending mouse moves in the order of their arrival.
+     */
+    void FlushPendingMouseMoves();
+
+    /**
+     * Returns the interactors in descending order of their layers. Each layer is queried once and
+     * m_Interactors is only reordered if the layers changed since the last call.
+     */
+    std::vector<WeakPointer<DataInteractor>> GetInteractorsSortedByLayer();
+
     /**
      * Removes all Interactors without a DataNode pointing to them, this is necessary especially when a DataNode is
      * assigned to a new Interactor
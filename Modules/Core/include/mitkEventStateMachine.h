@@ -19,6 +19,7 @@ found in the LICENSE file.
 #include "mitkMessage.h"
 
 #include <MitkCoreExports.h>
+#include <memory>
 #include <string>
 
 /**
@@ -107,6 +108,11 @@ namespace mitk
    * is triggered by an event and it is associated with actions that are to be executed when the state change is
    * performed.
    *
+   * Before the first event is handled, the loaded pattern is compiled into integer-indexed transition tables, so that
+   * the transitions of a state for an event are only matched once against the event class hierarchy. Conditions and
+   * actions are still dispatched through CheckCondition() and ExecuteAction(). The tables are rebuilt whenever a state
+   * machine is loaded.
+   *
    */
   class MITKCORE_EXPORT EventStateMachine : public mitk::InteractionEventHandler
   {
@@ -182,6 +188,10 @@ namespace mitk
 
     virtual void ConnectActionsAndFunctions();
 
+    /**
+     * Looks up function that is associated with condition and executes it.
+     * To implement your own evaluation scheme overwrite this in your DataInteractor.
+     */
     virtual bool CheckCondition(const StateMachineCondition &condition, const InteractionEvent *interactionEvent);
 
     /**
@@ -249,6 +259,29 @@ namespace mitk
     typedef std::map<std::string, ActionFunctionDelegate *> ActionDelegatesMapType;
     typedef std::map<std::string, ConditionFunctionDelegate *> ConditionDelegatesMapType;
 
+    /**
+     * \brief Transitions, conditions and actions of the loaded state machine in integer-indexed form.
+     *
+     * Defined in the implementation file. Cells of the table are compiled on first use of an event signature in a
+     * state, so that the event class hierarchy only has to be evaluated once per signature and state.
+     */
+    struct TransitionTable;
+
+    /**
+     * Returns the compiled transitions of the current state, builds the table first if necessary.
+     */
+    std::shared_ptr<TransitionTable> GetTransitionTable();
+
+    /**
+     * Returns the index of the first transition of the table whose conditions are fulfilled, or -1.
+     */
+    int FindExecutableTransition(TransitionTable &table, InteractionEvent *event);
+
+    /**
+     * Discards the compiled tables, they refer to the states of the loaded state machine.
+     */
+    void InvalidateTransitionTable();
+
     StateMachineContainer
       *m_StateMachineContainer; // storage of all states, action, transitions on which the statemachine operates.
     std::map<std::string, TActionFunctor *> m_ActionFunctionsMap; // stores association between action string
@@ -257,6 +290,9 @@ namespace mitk
     StateMachineStateType m_CurrentState;
 
     bool m_MouseCursorSet;
+
+    std::shared_ptr<TransitionTable> m_TransitionTable; // compiled on demand, see GetTransitionTable()
+    int m_CurrentStateIndex;                             // index of m_CurrentState in m_TransitionTable, -1 if unknown
   };
 
 } /* namespace mitk */
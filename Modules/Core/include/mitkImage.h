@@ -28,6 +28,10 @@ found in the LICENSE file.
 #include <itkHistogram.h>
 #endif
 
+#include <itkImageRegion.h>
+
+#include <deque>
+
 class vtkImageData;
 
 namespace itk
@@ -517,6 +521,44 @@ namespace mitk
       */
     StatisticsHolderPointer GetStatistics() const { return m_ImageStatistics; }
 
+    /** Region in index coordinates of the volume of a time step.*/
+    using ModifiedRegionType = itk::ImageRegion<3>;
+    using ModifiedRegionVectorType = std::vector<ModifiedRegionType>;
+
+    /**
+      * @brief Enables or disables the tracking of modified regions (see GetModifiedRegions()).
+      *
+      * Tracking is disabled by default. Changing the state discards all regions recorded so far.
+      */
+    void SetModifiedRegionTracking(bool enabled);
+
+    bool GetModifiedRegionTracking() const;
+
+    /**
+      * @brief Reports that the pixels of a region of a time step were changed.
+      *
+      * Writers report the region before they call Modified(); all regions reported until then are
+      * assigned to this modification. ImageWriteAccessor reports the accessed image part automatically.
+      * Reporting an empty region states that the next call of Modified() does not change pixels.
+      * Does nothing if tracking is disabled.
+      */
+    void AddModifiedRegion(TimeStepType timeStep, const ModifiedRegionType &region);
+
+    /**
+      * @brief Returns the regions of a time step that were modified after a point in time.
+      *
+      * Consumers keep the modification time of the image when they were updated the last time
+      * and pass it as @a since to only process the regions that changed afterwards.
+      * @return false if the changes are not completely known, e.g. tracking is disabled, Modified() was
+      * called without reporting regions, the geometry was changed or the changes are too old to be still
+      * recorded. In this case the consumer has to assume that the whole image has changed.
+      */
+    bool GetModifiedRegions(itk::ModifiedTimeType since, TimeStepType timeStep, ModifiedRegionVectorType &regions) const;
+
+    /** @brief Marks the image as modified and assigns the reported regions (see AddModifiedRegion()) to the modification.
+      * The modification is recorded before the ModifiedEvent is invoked, so observers can query its regions.*/
+    void Modified() const override;
+
   protected:
     mitkCloneMacro(Self);
 
@@ -612,6 +654,30 @@ namespace mitk
     mutable std::mutex m_ReadWriteLock;
     /** A mutex, which needs to be locked to manage m_VtkReaders */
     mutable std::mutex m_VtkReadersLock;
+
+    /** Reports the image parts in the memory [begin, end) as modified (see AddModifiedRegion()). If region is
+     * not null, it is reported instead of the whole image part for every time step in the memory.
+     * Used by ImageWriteAccessor.*/
+    void AddModifiedMemory(const void *begin, const void *end, const ModifiedRegionType *region);
+
+    using TimeStepRegionVectorType = std::vector<std::pair<TimeStepType, ModifiedRegionType>>;
+
+    struct ModificationRecord
+    {
+      itk::ModifiedTimeType MTime;
+      /** False if Modified() was called without reporting regions.*/
+      bool RegionsKnown;
+      TimeStepRegionVectorType Regions;
+    };
+
+    bool m_ModifiedRegionTracking;
+    /** Regions reported since the last call of Modified().*/
+    mutable TimeStepRegionVectorType m_PendingModifiedRegions;
+    mutable std::deque<ModificationRecord> m_ModificationRecords;
+    /** Modifications up to this time are not recorded (anymore).*/
+    mutable itk::ModifiedTimeType m_ModificationRecordsStart;
+    /** A mutex, which needs to be locked to manage the modified regions */
+    mutable std::mutex m_ModifiedRegionsLock;
   };
 
   /**
@@ -78,12 +78,20 @@ namespace mitk
     itkSetMacro(Options, int);
     itkGetMacro(Options, int);
 
+    /** Restricts the region that is reported to the input as modified when the output releases its write access
+     *  (see ImageWriteAccessor::SetModifiedRegion()). By default the whole input is reported. Has no effect for
+     *  const inputs. Has to be set before the output is generated.*/
+    void SetModifiedRegion(const mitk::Image::ModifiedRegionType &region);
+
   protected:
     using itk::ProcessObject::SetInput;
     mitk::Image *GetInput(void);
     const mitk::Image *GetInput() const;
 
-    ImageToItk() : m_CopyMemFlag(false), m_Channel(0), m_Options(mitk::ImageAccessorBase::DefaultBehavior) {}
+    ImageToItk()
+      : m_CopyMemFlag(false), m_Channel(0), m_Options(mitk::ImageAccessorBase::DefaultBehavior), m_ModifiedRegionSet(false)
+    {
+    }
     ~ImageToItk() override {}
     void PrintSelf(std::ostream &os, itk::Indent indent) const override;
 
@@ -98,6 +106,9 @@ namespace mitk
 
     bool m_ConstInput;
 
+    bool m_ModifiedRegionSet;
+    mitk::Image::ModifiedRegionType m_ModifiedRegion;
+
     // ImageToItk(const Self&); //purposely not implemented
     void operator=(const Self &); // purposely not implemented
 
@@ -68,6 +68,14 @@ void mitk::ImageToItk<TOutputImage>::SetInput(const mitk::Image *input)
   m_ConstInput = true;
 }
 
+template <class TOutputImage>
+void mitk::ImageToItk<TOutputImage>::SetModifiedRegion(const mitk::Image::ModifiedRegionType &region)
+{
+  m_ModifiedRegion = region;
+  m_ModifiedRegionSet = true;
+  this->Modified();
+}
+
 template <class TOutputImage>
 mitk::Image *mitk::ImageToItk<TOutputImage>::GetInput(void)
 {
@@ -117,7 +125,12 @@ void mitk::ImageToItk<TOutputImage>::GenerateData()
   }
   else
   {
-    imageAccess.reset(new mitk::ImageWriteAccessor(input, nullptr, m_Options));
+    auto *writeAccess = new mitk::ImageWriteAccessor(input, nullptr, m_Options);
+    if (m_ModifiedRegionSet)
+    {
+      writeAccess->SetModifiedRegion(m_ModifiedRegion);
+    }
+    imageAccess.reset(writeAccess);
   }
 
   // hier wird momentan wohl nur der erste Channel verwendet??!!
@@ -132,6 +132,9 @@ namespace mitk
 
     //### methods of MITK-VTK rendering pipeline
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
+
+    /** The resliced image only depends on the node, its image and the world geometry of the renderer */
+    bool DependsOnOtherNodes() const override { return false; }
     //### end of methods of MITK-VTK rendering pipeline
 
     /** \brief Internal class holding the mapper, actor, etc. for each of the 3 2D render windows */
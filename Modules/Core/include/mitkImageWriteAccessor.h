@@ -45,6 +45,13 @@ namespace mitk
 
     /** \brief Gives full data access. */
     inline void *GetData() { return m_AddressBegin; }
+
+    /** \brief Restricts the region that is reported to the image as modified (see Image::AddModifiedRegion()).
+     *  By default the whole accessed image part is reported when the accessor is released. The region is given
+     *  in index coordinates of a volume and is reported for every time step of the accessed image part.
+     */
+    void SetModifiedRegion(const Image::ModifiedRegionType &region);
+
     /** \brief informs Image to unlock the represented image part */
     ~ImageWriteAccessor() override;
 
@@ -59,6 +66,9 @@ namespace mitk
     ImageWriteAccessor(const ImageWriteAccessor &);
 
     ImagePointer m_Image;
+
+    bool m_ModifiedRegionSet;
+    Image::ModifiedRegionType m_ModifiedRegion;
   };
 }
 #endif
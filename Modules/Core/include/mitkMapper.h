@@ -146,6 +146,14 @@ namespace mitk
      * This reflects whether this Mapper currently invokes StartEvent, EndEvent, and
      * ProgressEvent on BaseRenderer. */
     virtual bool IsLODEnabled(BaseRenderer * /*renderer*/) const { return false; }
+
+    /** Returns true if the output of this Mapper may depend on other data nodes than
+     * the one it is associated with. Renderers that only update the mappers of modified
+     * nodes (see VtkPropRenderer) update such mappers on every render call.
+     * Defaults to true, so that mappers are never skipped unless they state that their
+     * output only depends on their own node, its data and the renderer. */
+    virtual bool DependsOnOtherNodes() const { return true; }
+
   protected:
     /** \brief explicit constructor which disallows implicit conversions */
     explicit Mapper();
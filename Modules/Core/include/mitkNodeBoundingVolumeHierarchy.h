@@ -0,0 +1,88 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNodeBoundingVolumeHierarchy_h
+#define mitkNodeBoundingVolumeHierarchy_h
+
+#include <MitkCoreExports.h>
+#include <mitkPoint.h>
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace mitk
+{
+  class DataNode;
+
+  /**
+   * \brief Bounding volume hierarchy over the world bounding boxes of data nodes.
+   *
+   * Used to narrow down picking to the few nodes whose bounding box is hit by the
+   * pick ray before any exact (and expensive) test is run.
+   *
+   * Changing the bounds of a node that is already part of the hierarchy only refits
+   * the boxes on the path to the root. Adding or removing nodes marks the hierarchy
+   * for a rebuild on the next query.
+   */
+  class MITKCORE_EXPORT NodeBoundingVolumeHierarchy
+  {
+  public:
+    /** \brief Axis-aligned bounds in VTK order (xmin, xmax, ymin, ymax, zmin, zmax). */
+    typedef std::array<double, 6> BoundsType;
+    typedef std::vector<const DataNode *> NodeListType;
+
+    /** \brief Adds the node or updates its bounds. Invalid bounds (min > max) remove the node. */
+    void SetBounds(const DataNode *node, const BoundsType &bounds);
+
+    void Remove(const DataNode *node);
+    bool Contains(const DataNode *node) const;
+    void Clear();
+    std::size_t GetNumberOfNodes() const;
+
+    /**
+     * \brief Returns all nodes whose bounding box, enlarged by \a tolerance,
+     * intersects the line segment from \a p0 to \a p1.
+     */
+    NodeListType IntersectSegment(const Point3D &p0, const Point3D &p1, double tolerance = 0.0);
+
+  private:
+    struct Item
+    {
+      const DataNode *Node;
+      BoundsType Bounds;
+      int TreeNode;
+    };
+
+    struct TreeNode
+    {
+      BoundsType Bounds;
+      int Parent;
+      int Left;
+      int Right;
+      /** Index into m_Items for leaves, -1 for inner nodes. */
+      int Item;
+    };
+
+    void Build();
+    int BuildRange(std::vector<int> &itemIds, std::size_t begin, std::size_t end, int parent);
+    void Refit(int treeNode);
+
+    std::vector<Item> m_Items;
+    std::unordered_map<const DataNode *, std::size_t> m_ItemIndex;
+    std::vector<TreeNode> m_Tree;
+    bool m_RebuildRequired = false;
+  };
+}
+
+#endif
@@ -59,6 +59,9 @@ namespace mitk
     /** Applies properties specific to this mapper */
     virtual void ApplyAllProperties(BaseRenderer *renderer);
 
+    /** The gaps in the rendered plane depend on all other PlaneGeometryData nodes */
+    bool DependsOnOtherNodes() const override { return true; }
+
     /** \brief set the default properties for this mapper */
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
 
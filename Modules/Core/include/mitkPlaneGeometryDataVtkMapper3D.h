@@ -116,6 +116,9 @@ namespace mitk
     */
     virtual void SetDataStorageForTexture(mitk::DataStorage *storage);
 
+    /** The texture of the plane depends on the images of the data storage */
+    bool DependsOnOtherNodes() const override { return true; }
+
   protected:
     typedef std::multimap<int, vtkActor *> LayerSortedActorList;
 
@@ -14,10 +14,13 @@ found in the LICENSE file.
 #define mitkPointSet_h
 
 #include "mitkBaseData.h"
+#include "mitkPointSetSpatialIndex.h"
 
 #include <itkDefaultDynamicMeshTraits.h>
 #include <itkMesh.h>
 
+#include <mutex>
+
 namespace mitk
 {
   /**
@@ -45,6 +48,13 @@ namespace mitk
    *
    * The class internally uses an itk::Mesh for each time step.
    *
+   * SearchPoint() and SearchPointsInSlab() use a mitk::PointSetSpatialIndex per time step,
+   * which is built on the first query. Insertion, removal and movement of single points,
+   * e.g. during interaction, are applied to the index without rebuilding it; other changes
+   * of the points of a time step make the next query rebuild it. To add or remove many
+   * points at once, use InsertPoints() and RemovePoints(), which modify the point set only once.
+   * The indices are guarded by a mutex, so searches may run concurrently.
+   *
    * \section mitkPointSetDisplayOptions
    *
    * The default mappers for this data structure are mitk::PointSetGLMapper2D and
@@ -133,6 +143,7 @@ namespace mitk
     typedef DataType::PointDataContainer PointDataContainer;
     typedef DataType::PointDataContainerIterator PointDataIterator;
     typedef DataType::PointDataContainerIterator PointDataConstIterator;
+    typedef std::vector<PointIdentifier> PointIdentifierListType;
 
     void Expand(unsigned int timeSteps) override;
 
@@ -200,11 +211,26 @@ namespace mitk
     */
     PointIdentifier InsertPoint(PointType point, int t = 0);
 
+    /**
+    * \brief Insert the given points in world coordinate system with incremented max ids at time step t.
+    *
+    * Equivalent to calling InsertPoint(PointType, int) for each point, but the point set is
+    * modified only once.
+    */
+    void InsertPoints(const std::vector<PointType> &points, int t = 0);
+
     /**
     * \brief Remove point with given id at timestep t, if existent
     */
     bool RemovePointIfExists(PointIdentifier id, int t = 0);
 
+    /**
+    * \brief Remove the points with the given ids at timestep t, if existent, and return the number of removed points
+    *
+    * The point set is modified only once.
+    */
+    unsigned int RemovePoints(const PointIdentifierListType &ids, int t = 0);
+
     /**
     * \brief Remove max id point at timestep t and return iterator to precedent point
     */
@@ -250,6 +276,20 @@ namespace mitk
      */
     int SearchPoint(Point3D point, ScalarType distance, int t = 0) const;
 
+    /**
+     * \brief searches all points within a slab around a plane
+     *
+     * \param planeOrigin is a point of the plane in world coordinates.
+     * \param planeNormal is the normal of the plane in world coordinates.
+     * \param halfThickness is the maximal distance of a point to the plane in mm.
+     * \param t
+     * returns the ids of the points in ascending order
+     */
+    PointIdentifierListType SearchPointsInSlab(const Point3D &planeOrigin,
+                                               const Vector3D &planeNormal,
+                                               ScalarType halfThickness,
+                                               int t = 0) const;
+
     bool IsEmptyTimeStep(unsigned int t) const override;
 
     // virtual methods, that need to be implemented
@@ -278,6 +318,24 @@ namespace mitk
     /** \brief swaps point coordinates and point data of the points with identifiers id1 and id2 */
     bool SwapPointContents(PointIdentifier id1, PointIdentifier id2, int t = 0);
 
+    /**
+     * \brief returns the spatial index of time step t, updated to the current points of t
+     *
+     * The caller has to hold m_SpatialIndicesMutex while it uses the index.
+     */
+    const PointSetSpatialIndex &GetSpatialIndex(unsigned int t) const;
+
+    /** \brief returns the modification time of the points container of time step t, 0 if t does not exist */
+    itk::ModifiedTimeType GetPointsMTime(unsigned int t) const;
+
+    /**
+     * \brief passes edits of single points of time step t to its spatial index
+     *
+     * pointsTimeBeforeEdit is the result of GetPointsMTime(t) before the edits, see
+     * PointSetSpatialIndex::UpdatePoints().
+     */
+    void UpdateSpatialIndex(unsigned int t, itk::ModifiedTimeType pointsTimeBeforeEdit, const PointIdentifierListType &ids);
+
     typedef std::vector<DataType::Pointer> PointSetSeries;
 
     PointSetSeries m_PointSetSeries;
@@ -288,6 +346,10 @@ namespace mitk
     * @brief flag to indicate the right time to call SetBounds
     **/
     bool m_CalculateBoundingBox;
+
+    /** Spatial indices of the time steps, built on demand by GetSpatialIndex() */
+    mutable std::vector<PointSetSpatialIndex> m_SpatialIndices;
+    mutable std::mutex m_SpatialIndicesMutex;
   };
 
   /**
@@ -0,0 +1,142 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPointSetSpatialIndex_h
+#define mitkPointSetSpatialIndex_h
+
+#include <MitkCoreExports.h>
+#include <mitkNumericTypes.h>
+
+#include <itkMapContainer.h>
+
+#include <map>
+#include <unordered_set>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Spatial index over the points of one time step of a mitk::PointSet.
+   *
+   * The index keeps a flat copy of the point coordinates (one array per coordinate plus
+   * one array of point identifiers) that is ordered as an implicit, balanced k-d tree:
+   * the element in the middle of a range splits the range along the axis of largest
+   * extent. It supports nearest point queries and queries for all points within a slab
+   * around a plane in O(log n + k) instead of visiting every point.
+   *
+   * The index does not observe the point container. Update() compares the container
+   * and its modification time with the ones of the last update and rebuilds the index
+   * if they differ, so edits of the point set are picked up by the next query.
+   * Edits of single points can be passed to UpdatePoints() instead, which keeps the
+   * edited points in a short list next to the tree rather than rebuilding it; the list
+   * is merged into the tree by the next Update() once it grows too long. Coordinates are
+   * the index coordinates stored in the point container.
+   *
+   * The index is not thread-safe; concurrent queries and updates have to be serialized
+   * by the owner.
+   */
+  class MITKCORE_EXPORT PointSetSpatialIndex
+  {
+  public:
+    typedef itk::IdentifierType PointIdentifier;
+    typedef itk::MapContainer<PointIdentifier, itk::Point<ScalarType, 3>> PointsContainer;
+    typedef std::vector<PointIdentifier> PointIdentifierListType;
+
+    PointSetSpatialIndex();
+
+    /** \brief Rebuilds the index if points is another container or has been modified since the last build. */
+    void Update(const PointsContainer *points);
+
+    /**
+     * \brief Applies edits of the points ids of points without rebuilding the index.
+     *
+     * The new positions are read from points; ids which no longer exist in points are
+     * removed. The edits are only applied if the index reflected points before they were
+     * made, i.e. if points had the modification time pointsTimeBeforeEdit when the index was
+     * updated last. Otherwise the index is left as it is and rebuilt by the next Update().
+     */
+    void UpdatePoints(const PointsContainer *points,
+                      itk::ModifiedTimeType pointsTimeBeforeEdit,
+                      const PointIdentifierListType &ids);
+
+    /** \brief Returns true if the index reflects the current state of points. */
+    bool IsUpToDate(const PointsContainer *points) const;
+
+    void Clear();
+
+    std::size_t GetNumberOfPoints() const;
+
+    /**
+     * \brief Searches the point closest to the given point.
+     *
+     * Only points with a squared distance less than maxSquaredDistance are considered.
+     * Of several points with the same distance, the one with the smallest identifier is
+     * returned. Returns false if there is no such point.
+     */
+    bool FindClosestPoint(const Point3D &point, ScalarType maxSquaredDistance, PointIdentifier &id) const;
+
+    /**
+     * \brief Collects the identifiers of all points p with |normal * p - offset| <= halfThickness.
+     *
+     * normal does not have to be normalized; the slab is then measured in units of its length.
+     * The identifiers are returned in ascending order.
+     */
+    void FindPointsInSlab(const Vector3D &normal,
+                          ScalarType offset,
+                          ScalarType halfThickness,
+                          PointIdentifierListType &ids) const;
+
+  private:
+    void Build(const PointsContainer *points);
+
+    void BuildRange(std::vector<std::size_t> &order, std::size_t begin, std::size_t end);
+
+    void FindClosestPointInRange(std::size_t begin,
+                                 std::size_t end,
+                                 const ScalarType point[3],
+                                 ScalarType &bestSquaredDistance,
+                                 std::size_t &best) const;
+
+    void FindPointsInSlabInRange(std::size_t begin,
+                                 std::size_t end,
+                                 ScalarType bounds[6],
+                                 const Vector3D &normal,
+                                 ScalarType minimum,
+                                 ScalarType maximum,
+                                 PointIdentifierListType &ids) const;
+
+    ScalarType GetCoordinate(std::size_t i, unsigned int axis) const;
+
+    bool IsStale(std::size_t i) const;
+
+    PointsContainer::ConstPointer m_Points;
+    itk::ModifiedTimeType m_PointsTime;
+    std::size_t m_NumberOfPoints;
+
+    // Coordinates and identifiers in k-d tree order
+    std::vector<ScalarType> m_X;
+    std::vector<ScalarType> m_Y;
+    std::vector<ScalarType> m_Z;
+    std::vector<PointIdentifier> m_Ids;
+    /** Split axis of the range whose middle element is i, unused for leaf ranges */
+    std::vector<unsigned char> m_SplitAxis;
+
+    ScalarType m_Bounds[6];
+
+    /** Points inserted or moved since the last build, searched linearly */
+    std::map<PointIdentifier, PointsContainer::Element> m_EditedPoints;
+    /** Identifiers of moved or removed points whose entries in the tree are outdated */
+    std::unordered_set<PointIdentifier> m_StaleIds;
+  };
+}
+
+#endif
@@ -128,6 +128,9 @@ namespace mitk
     /** \brief returns the a prop assembly */
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
 
+    /** The glyphs only depend on the node, its point set and the world geometry of the renderer */
+    bool DependsOnOtherNodes() const override { return false; }
+
     /** \brief set the default properties for this mapper */
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
 
@@ -101,6 +101,10 @@ namespace mitk
     // overwritten from VtkMapper3D to be able to return a
     // m_PointsAssembly which is much faster than a vtkAssembly
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
+
+    /** The glyphs only depend on the node and its point set */
+    bool DependsOnOtherNodes() const override { return false; }
+
     void UpdateVtkTransform(mitk::BaseRenderer *renderer) override;
 
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
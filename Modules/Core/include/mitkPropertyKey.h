@@ -0,0 +1,70 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPropertyKey_h
+#define mitkPropertyKey_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * @brief Interned property key.
+   *
+   * The key string is registered once in a global registry and afterwards identified by a
+   * unique id. PropertyList and DataNode offer lookups by PropertyKey that resolve the id
+   * with a hashed lookup instead of string comparisons. Creating a PropertyKey locks the
+   * registry, so keys used for frequent lookups (e.g. by mappers in every render pass)
+   * should be created once and reused, e.g. as function local statics or via PropertyKeys.
+   *
+   * @ingroup DataManagement
+   */
+  class MITKCORE_EXPORT PropertyKey
+  {
+  public:
+    using IdType = std::size_t;
+
+    /** @brief Key of the empty string. */
+    PropertyKey();
+    explicit PropertyKey(const std::string &name);
+    explicit PropertyKey(const char *name);
+
+    IdType GetId() const { return m_Id; }
+    const std::string &GetName() const { return *m_Name; }
+
+    bool operator==(const PropertyKey &other) const { return m_Id == other.m_Id; }
+    bool operator!=(const PropertyKey &other) const { return m_Id != other.m_Id; }
+
+  private:
+    IdType m_Id;
+    const std::string *m_Name;
+  };
+
+  /**
+   * @brief Interned keys of properties frequently queried during rendering.
+   */
+  namespace PropertyKeys
+  {
+    MITKCORE_EXPORT const PropertyKey &Visible();
+    MITKCORE_EXPORT const PropertyKey &Layer();
+    MITKCORE_EXPORT const PropertyKey &Opacity();
+    MITKCORE_EXPORT const PropertyKey &Color();
+    MITKCORE_EXPORT const PropertyKey &Name();
+    MITKCORE_EXPORT const PropertyKey &LevelWindow();
+    MITKCORE_EXPORT const PropertyKey &Pickable();
+  }
+}
+
+#endif
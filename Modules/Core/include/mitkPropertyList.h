@@ -15,6 +15,9 @@ found in the LICENSE file.
 
 #include <mitkIPropertyOwner.h>
 #include <mitkGenericProperty.h>
+#include <mitkPropertyKey.h>
+
+#include <unordered_map>
 
 #include <nlohmann/json_fwd.hpp>
 
@@ -86,6 +89,14 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const std::string &propertyKey) const;
 
+    /**
+     * @brief Get a property by its interned key.
+     *
+     * Same as GetProperty(const std::string&), but resolved by a hashed lookup of the
+     * key id without any string comparison.
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey) const;
+
     /**
      * @brief Set a property object in the list/map by reference.
      *
@@ -117,6 +128,18 @@ namespace mitk
       return false;
     }
 
+    template <typename T>
+    bool GetPropertyValue(const PropertyKey &propertyKey, T &value) const
+    {
+      GenericProperty<T> *gp = dynamic_cast<GenericProperty<T> *>(GetProperty(propertyKey));
+      if (gp != nullptr)
+      {
+        value = gp->GetValue();
+        return true;
+      }
+      return false;
+    }
+
     /**
     * @brief Convenience method to access the value of a BoolProperty
     */
@@ -261,6 +284,16 @@ namespace mitk
 
   private:
     itk::LightObject::Pointer InternalClone() const override;
+
+    void InsertProperty(const std::string &propertyKey, BaseProperty *property);
+    void ErasePropertyFromIndex(const std::string &propertyKey);
+    void RebuildPropertyIndex();
+
+    /**
+     * @brief Index of m_Properties by interned key id (see GetProperty(const PropertyKey&)).
+     * Kept in sync with m_Properties by all methods changing the map.
+     */
+    std::unordered_map<PropertyKey::IdType, BaseProperty *> m_PropertyIndex;
   };
 
 } // namespace mitk
@@ -21,8 +21,9 @@ found in the LICENSE file.
 // VTK
 #include <vtkSmartPointer.h>
 class vtkAssembly;
-class vtkCutter;
+class vtkMitkSlabPlaneCutter;
 class vtkPlane;
+class vtkTransformPolyDataFilter;
 class vtkLookupTable;
 class vtkGlyph3D;
 class vtkArrowSource;
@@ -35,7 +36,7 @@ namespace mitk
   /**
     * @brief Vtk-based mapper for cutting 2D slices out of Surfaces.
     *
-    * The mapper uses a vtkCutter filter to cut out slices (contours) of the 3D
+    * The mapper uses a vtkMitkSlabPlaneCutter filter to cut out slices (contours) of the 3D
     * volume and render these slices as vtkPolyData. The data is transformed
     * according to its geometry before cutting, to support the geometry concept
     * of MITK.
@@ -67,6 +68,9 @@ namespace mitk
     /** \brief returns the prop assembly */
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
 
+    /** The contour only depends on the node, its surface and the world geometry of the renderer */
+    bool DependsOnOtherNodes() const override { return false; }
+
     /** \brief set the default properties for this mapper */
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
 
@@ -102,9 +106,15 @@ namespace mitk
          */
       vtkSmartPointer<vtkPolyDataMapper> m_Mapper;
       /**
-         * @brief m_Cutter Filter to cut out the 2D slice.
+         * @brief m_Transform Filter to transform the data according to its geometry.
+         */
+      vtkSmartPointer<vtkTransformPolyDataFilter> m_Transform;
+
+      /**
+         * @brief m_Cutter Filter to cut out the 2D slice. It only processes the cells
+         * that straddle the plane, see vtkMitkSlabPlaneCutter.
          */
-      vtkSmartPointer<vtkCutter> m_Cutter;
+      vtkSmartPointer<vtkMitkSlabPlaneCutter> m_Cutter;
       /**
          * @brief m_CuttingPlane The plane where to cut off the 2D slice.
          */
@@ -88,6 +88,9 @@ namespace mitk
 
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
 
+    /** The surface depends on the image of the "Surface.Texture" property, if one is set */
+    bool DependsOnOtherNodes() const override;
+
     virtual void ApplyAllProperties(mitk::BaseRenderer *renderer, vtkActor *actor);
 
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
@@ -17,10 +17,12 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include <itkCommand.h>
 #include <mitkDataStorage.h>
+#include <mitkNodeBoundingVolumeHierarchy.h>
 #include <mitkRenderingManager.h>
 
 #include <map>
 #include <utility>
+#include <vector>
 
 class vtkRenderWindow;
 class vtkLight;
@@ -28,6 +30,7 @@ class vtkLightKit;
 class vtkWorldPointPicker;
 class vtkPointPicker;
 class vtkCellPicker;
+class vtkPicker;
 class vtkTextActor;
 class vtkTextProperty;
 class vtkAssemblyPath;
@@ -202,6 +205,59 @@ namespace mitk
     // prepare all mitk::mappers for rendering
     void PrepareMapperQueue();
 
+    /** \brief Rebuild the render list from all nodes of the DataStorage. */
+    void RebuildRenderList();
+
+    /** \brief Keep the render list in sync with the DataStorage (AddNodeEvent / RemoveNodeEvent). */
+    void OnNodeAdded(const DataNode *node);
+    void OnNodeRemoved(const DataNode *node);
+    /** \brief Mark the picking bounds of a modified node as outdated (ChangedNodeEvent). */
+    void OnNodeChanged(const DataNode *node);
+
+    void AddDataStorageListeners();
+    void RemoveDataStorageListeners();
+
+    /** \brief Update the bounds of the nodes in m_PickingHierarchy that were marked as outdated. */
+    void UpdatePickingHierarchy() const;
+
+    /** \brief Fill the pick list of \a picker with the vtkProps of all nodes whose bounds are hit by
+      the pick ray through \a displayPosition. Returns the respective nodes. */
+    std::vector<const DataNode *> InitializePickList(vtkPicker *picker,
+                                                     const Point2D &displayPosition,
+                                                     bool pickableOnly) const;
+
+    /** \brief Add the vtkProps of the vtkRenderer that do not belong to nodes (e.g. annotations) to the
+      pick list of \a picker. */
+    void AddViewPropsToPickList(vtkPicker *picker) const;
+
+    /** \brief Cached per-node rendering state of this renderer.
+
+      Visibility, layer and mapper are only re-read when the node (including its properties
+      for this renderer) was modified, and mappers are only updated when their node changed
+      or when the renderer (geometry, time step, mapper slot) changed.
+    */
+    struct RenderListEntry
+    {
+      DataNode *Node = nullptr;
+      Mapper *NodeMapper = nullptr;
+      int Layer = 1;
+      bool Visible = true;
+      bool LODEnabled = false;
+      /** Time the cached visibility, layer and mapper were read. */
+      itk::TimeStamp PropertiesTime;
+      /** Time the mapper of the node was updated for this renderer. */
+      itk::TimeStamp UpdateTime;
+      bool PropertiesValid = false;
+      bool UpdateValid = false;
+      /** Whether the bounds of the node in m_PickingHierarchy are up to date. */
+      mutable bool PickingValid = false;
+    };
+    typedef std::vector<RenderListEntry> RenderListType;
+
+    /** \brief Mark the bounds of the node of \a entry in m_PickingHierarchy as outdated. Called whenever
+      the node was modified or its mapper was updated, which are the only occasions its vtkProp changes. */
+    void InvalidatePickingBounds(RenderListEntry &entry);
+
     /** \brief Propagate vtkInformation object to all VTK-based mappers */
     void PropagateRenderInfoToMappers();
 
@@ -227,6 +283,18 @@ namespace mitk
     // sorted list of mappers
     MappersMapType m_MappersMap;
 
+    // retained list of all nodes of the DataStorage (in the order of DataStorage::GetAll()
+    // whenever the sorted list of mappers was rebuilt)
+    RenderListType m_RenderList;
+    bool m_MappersMapOutdated = true;
+    MapperSlotId m_RenderListMapperID = 0;
+
+    // world bounds of the visible vtkProps of the render list, used to narrow down picking
+    mutable NodeBoundingVolumeHierarchy m_PickingHierarchy;
+    mutable bool m_PickingHierarchyOutdated = true;
+    int m_LastUpdateViewportSize[2] = {0, 0};
+    ScalarType m_LastUpdateScaleFactor = 0.0;
+
     // rendering of text
     vtkRenderer *m_TextRenderer;
     typedef std::map<unsigned int, vtkTextActor *> TextMapType;
@@ -0,0 +1,90 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef vtkMitkSlabPlaneCutter_h
+#define vtkMitkSlabPlaneCutter_h
+
+#include <MitkCoreExports.h>
+
+#include <vtkPolyDataAlgorithm.h>
+#include <vtkSmartPointer.h>
+
+#include <vector>
+
+class vtkCutter;
+class vtkPlane;
+
+/**
+ * \brief Cuts polydata with a plane, like vtkCutter, but only processes the cells that
+ * straddle the plane.
+ *
+ * On the first cut (and whenever the input or the direction of the plane normal
+ * changes) the filter computes the extent of each cell along the plane normal and sorts
+ * the cells into slabs perpendicular to the normal. Moving the plane along its normal,
+ * e.g. when scrolling through the slices of a standard view, then only visits the cells
+ * of the slab that contains the plane. Only these cells are passed on to vtkCutter.
+ *
+ * Point and cell data of the input are passed to the output like vtkCutter does.
+ * Vertex cells are ignored, since they cannot be cut.
+ */
+class MITKCORE_EXPORT vtkMitkSlabPlaneCutter : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkMitkSlabPlaneCutter *New();
+  vtkTypeMacro(vtkMitkSlabPlaneCutter, vtkPolyDataAlgorithm);
+  void PrintSelf(ostream &os, vtkIndent indent) override;
+
+  /** \brief The plane to cut with. Changes of the plane modify the filter. */
+  void SetPlane(vtkPlane *plane);
+  vtkPlane *GetPlane() const;
+
+  /** \brief Number of cells passed to vtkCutter by the last execution. */
+  vtkIdType GetNumberOfCutCells() const;
+
+  vtkMTimeType GetMTime() override;
+
+protected:
+  vtkMitkSlabPlaneCutter();
+  ~vtkMitkSlabPlaneCutter() override;
+
+  int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *) override;
+
+private:
+  vtkMitkSlabPlaneCutter(const vtkMitkSlabPlaneCutter &) = delete;
+  void operator=(const vtkMitkSlabPlaneCutter &) = delete;
+
+  bool IsIndexValid(vtkPolyData *input, const double normal[3]) const;
+  void BuildIndex(vtkPolyData *input, const double normal[3]);
+  void CollectCells(vtkPolyData *input, double distance, std::vector<vtkIdType> &cells) const;
+  void ExtractCells(vtkPolyData *input, const std::vector<vtkIdType> &cells, vtkPolyData *output);
+
+  vtkSmartPointer<vtkPlane> m_Plane;
+  vtkSmartPointer<vtkCutter> m_Cutter;
+
+  // Index of the cells along m_IndexNormal
+  vtkPolyData *m_IndexInput;
+  vtkTimeStamp m_IndexTime;
+  double m_IndexNormal[3];
+  double m_IndexMinimum;
+  double m_SlabWidth;
+  std::vector<double> m_CellMinimum;
+  std::vector<double> m_CellMaximum;
+  /** Cells of slab i are m_SlabCells[m_SlabOffsets[i]] ... m_SlabCells[m_SlabOffsets[i + 1] - 1] */
+  std::vector<vtkIdType> m_SlabOffsets;
+  std::vector<vtkIdType> m_SlabCells;
+
+  // Map of input point ids to output point ids, -1 for unused points
+  std::vector<vtkIdType> m_PointMap;
+  vtkIdType m_NumberOfCutCells;
+};
+
+#endif
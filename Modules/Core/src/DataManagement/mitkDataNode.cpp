@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkDataNode.h"
 #include "mitkCoreObjectFactory.h"
 #include <vtkTransform.h>
+#include <algorithm>
 
 #include "mitkGroupTagProperty.h"
 #include "mitkProperties.h"
@@ -209,7 +210,10 @@ mitk::PropertyList *mitk::DataNode::GetPropertyList(const std::string &rendererN
   mitk::PropertyList::Pointer &propertyList = m_MapOfPropertyLists[rendererName];
 
   if (propertyList.IsNull())
+  {
     propertyList = mitk::PropertyList::New();
+    m_PropertyListsByRendererKey[PropertyKey(rendererName).GetId()] = propertyList;
+  }
 
   assert(m_MapOfPropertyLists[rendererName].IsNotNull());
 
@@ -247,6 +251,29 @@ mitk::BaseProperty *mitk::DataNode::GetProperty(const char *propertyKey, const m
   return property;
 }
 
+mitk::BaseProperty *mitk::DataNode::GetProperty(const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer, bool fallBackOnDataProperties) const
+{
+  if (nullptr != renderer)
+  {
+    auto it = m_PropertyListsByRendererKey.find(renderer->GetNameKey().GetId());
+
+    if (m_PropertyListsByRendererKey.end() != it)
+    {
+      auto property = it->second->GetProperty(propertyKey);
+
+      if (nullptr != property)
+        return property;
+    }
+  }
+
+  auto property = m_PropertyList->GetProperty(propertyKey);
+
+  if (nullptr == property && fallBackOnDataProperties && m_Data.IsNotNull())
+    property = m_Data->GetPropertyList()->GetProperty(propertyKey);
+
+  return property;
+}
+
 mitk::DataNode::GroupTagList mitk::DataNode::GetGroupTags() const
 {
   GroupTagList groups;
@@ -277,6 +304,16 @@ bool mitk::DataNode::GetBoolProperty(const char *propertyKey, bool &boolValue, c
   return true;
 }
 
+bool mitk::DataNode::GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer) const
+{
+  auto boolprop = dynamic_cast<mitk::BoolProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == boolprop)
+    return false;
+
+  boolValue = boolprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
 {
   mitk::IntProperty::Pointer intprop = dynamic_cast<mitk::IntProperty *>(GetProperty(propertyKey, renderer));
@@ -287,6 +324,16 @@ bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, cons
   return true;
 }
 
+bool mitk::DataNode::GetIntProperty(const PropertyKey &propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
+{
+  auto intprop = dynamic_cast<mitk::IntProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == intprop)
+    return false;
+
+  intValue = intprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetFloatProperty(const char *propertyKey,
                                       float &floatValue,
                                       const mitk::BaseRenderer *renderer) const
@@ -357,6 +404,26 @@ bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *render
   return true;
 }
 
+bool mitk::DataNode::GetColor(float rgb[3], const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+{
+  auto colorprop = dynamic_cast<mitk::ColorProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == colorprop)
+    return false;
+
+  memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
+  return true;
+}
+
+bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+{
+  auto opacityprop = dynamic_cast<mitk::FloatProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == opacityprop)
+    return false;
+
+  opacity = opacityprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetLevelWindow(mitk::LevelWindow &levelWindow,
                                     const mitk::BaseRenderer *renderer,
                                     const char *propertyKey) const
@@ -508,6 +575,28 @@ itk::ModifiedTimeType mitk::DataNode::GetMTime() const
   return time;
 }
 
+itk::ModifiedTimeType mitk::DataNode::GetMTime(const mitk::BaseRenderer *renderer) const
+{
+  auto time = this->GetMTime();
+
+  // Properties can be modified in place (e.g. GetProperty(...)->SetValue(...)) without
+  // modifying the node, so the property lists have to be checked as well.
+  time = std::max(time, m_PropertyList->GetMTime());
+
+  if (m_Data.IsNotNull())
+    time = std::max(time, m_Data->GetPropertyList()->GetMTime());
+
+  if (nullptr != renderer)
+  {
+    auto it = m_PropertyListsByRendererKey.find(renderer->GetNameKey().GetId());
+
+    if (m_PropertyListsByRendererKey.end() != it)
+      time = std::max(time, it->second->GetMTime());
+  }
+
+  return time;
+}
+
 void mitk::DataNode::SetSelected(bool selected, const mitk::BaseRenderer *renderer)
 {
   mitk::BoolProperty::Pointer selectedProperty = dynamic_cast<mitk::BoolProperty *>(GetProperty("selected"));
@@ -22,6 +22,7 @@ found in the LICENSE file.
 #include <vtkImageData.h>
 
 // Other
+#include <algorithm>
 #include <cmath>
 
 #define FILL_C_ARRAY(_arr, _size, _value)                                                                              \
@@ -37,7 +38,9 @@ mitk::Image::Image()
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_ModifiedRegionTracking(false),
+    m_ModificationRecordsStart(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -52,7 +55,9 @@ mitk::Image::Image(const Image &other)
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_ModifiedRegionTracking(false),
+    m_ModificationRecordsStart(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -1197,6 +1202,228 @@ void mitk::Image::Clear()
   m_Dimensions = nullptr;
 }
 
+namespace
+{
+  /** Maximum number of modifications that are recorded by an image with tracking of modified regions.*/
+  constexpr std::size_t MaximumNumberOfModificationRecords = 256;
+
+  /** Maximum number of regions that are reported for one modification; further regions are merged.*/
+  constexpr std::size_t MaximumNumberOfPendingRegions = 1024;
+
+  mitk::Image::ModifiedRegionType MergeRegions(const mitk::Image::ModifiedRegionType &a,
+                                               const mitk::Image::ModifiedRegionType &b)
+  {
+    if (0 == a.GetNumberOfPixels())
+      return b;
+    if (0 == b.GetNumberOfPixels())
+      return a;
+
+    mitk::Image::ModifiedRegionType result;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      const auto lower = std::min(a.GetIndex(d), b.GetIndex(d));
+      const auto upper = std::max(a.GetUpperIndex()[d], b.GetUpperIndex()[d]);
+      result.SetIndex(d, lower);
+      result.SetSize(d, static_cast<itk::SizeValueType>(upper - lower + 1));
+    }
+    return result;
+  }
+}
+
+void mitk::Image::SetModifiedRegionTracking(bool enabled)
+{
+  MutexHolder lock(m_ModifiedRegionsLock);
+
+  if (enabled == m_ModifiedRegionTracking)
+    return;
+
+  m_ModifiedRegionTracking = enabled;
+  m_PendingModifiedRegions.clear();
+  m_ModificationRecords.clear();
+  m_ModificationRecordsStart = this->GetMTime();
+}
+
+bool mitk::Image::GetModifiedRegionTracking() const
+{
+  MutexHolder lock(m_ModifiedRegionsLock);
+  return m_ModifiedRegionTracking;
+}
+
+void mitk::Image::AddModifiedRegion(TimeStepType timeStep, const ModifiedRegionType &region)
+{
+  MutexHolder lock(m_ModifiedRegionsLock);
+
+  if (!m_ModifiedRegionTracking)
+    return;
+
+  if (m_PendingModifiedRegions.size() >= MaximumNumberOfPendingRegions)
+  {
+    // keep the number of regions bounded by merging regions of the same time step
+    for (auto &pending : m_PendingModifiedRegions)
+    {
+      if (pending.first == timeStep)
+      {
+        pending.second = MergeRegions(pending.second, region);
+        return;
+      }
+    }
+  }
+
+  m_PendingModifiedRegions.emplace_back(timeStep, region);
+}
+
+void mitk::Image::AddModifiedMemory(const void *begin, const void *end, const ModifiedRegionType *region)
+{
+  if (!this->GetModifiedRegionTracking())
+    return;
+
+  const auto first = static_cast<const unsigned char *>(begin);
+  const auto last = static_cast<const unsigned char *>(end);
+
+  if (last <= first)
+    return;
+
+  const std::size_t sliceSize = static_cast<std::size_t>(this->GetDimension(0)) * this->GetDimension(1);
+  const std::size_t slicesPerVolume = this->GetDimension(2);
+  const std::size_t timeSteps = this->GetDimension(3);
+
+  // slices are counted over all time steps of a channel
+  auto addSlices = [&](std::size_t firstSlice, std::size_t lastSlice) {
+    for (auto t = firstSlice / slicesPerVolume; t <= lastSlice / slicesPerVolume && t < timeSteps; ++t)
+    {
+      if (nullptr != region)
+      {
+        this->AddModifiedRegion(t, *region);
+        continue;
+      }
+
+      const auto firstZ = t == firstSlice / slicesPerVolume ? firstSlice % slicesPerVolume : 0;
+      const auto lastZ = t == lastSlice / slicesPerVolume ? lastSlice % slicesPerVolume : slicesPerVolume - 1;
+
+      ModifiedRegionType slab;
+      slab.SetIndex({{0, 0, static_cast<itk::IndexValueType>(firstZ)}});
+      slab.SetSize({{this->GetDimension(0), this->GetDimension(1), static_cast<itk::SizeValueType>(lastZ - firstZ + 1)}});
+      this->AddModifiedRegion(t, slab);
+    }
+  };
+
+  // returns true if the memory belongs to the item, starting at the passed slice
+  auto addItem = [&](const ImageDataItem *item, std::size_t itemFirstSlice, std::size_t pixelSize) {
+    if (nullptr == item || nullptr == item->GetData())
+      return false;
+
+    const auto data = static_cast<const unsigned char *>(item->GetData());
+    if (first < data || last > data + item->GetSize())
+      return false;
+
+    const std::size_t firstPixel = (first - data) / pixelSize;
+    const std::size_t lastPixel = (last - data - 1) / pixelSize;
+    addSlices(itemFirstSlice + firstPixel / sliceSize, itemFirstSlice + lastPixel / sliceSize);
+    return true;
+  };
+
+  std::lock_guard<std::mutex> lock(m_ImageDataArraysLock);
+
+  for (std::size_t n = 0; n < m_Channels.size(); ++n)
+  {
+    if (addItem(m_Channels[n], 0, this->GetPixelType(static_cast<int>(n)).GetSize()))
+      return;
+  }
+
+  for (std::size_t i = 0; i < m_Volumes.size(); ++i)
+  {
+    const auto t = i % timeSteps;
+    const auto n = i / timeSteps;
+    if (addItem(m_Volumes[i], t * slicesPerVolume, this->GetPixelType(static_cast<int>(n)).GetSize()))
+      return;
+  }
+
+  for (std::size_t i = 0; i < m_Slices.size(); ++i)
+  {
+    const auto n = i / (timeSteps * slicesPerVolume);
+    if (addItem(m_Slices[i], i % (timeSteps * slicesPerVolume), this->GetPixelType(static_cast<int>(n)).GetSize()))
+      return;
+  }
+
+  // unknown image part: report all time steps
+  addSlices(0, timeSteps * slicesPerVolume - 1);
+}
+
+bool mitk::Image::GetModifiedRegions(itk::ModifiedTimeType since,
+                                     TimeStepType timeStep,
+                                     ModifiedRegionVectorType &regions) const
+{
+  regions.clear();
+
+  const auto mTime = this->GetMTime();
+
+  MutexHolder lock(m_ModifiedRegionsLock);
+
+  if (!m_ModifiedRegionTracking || since < m_ModificationRecordsStart)
+    return false;
+
+  auto lastRecordedMTime = m_ModificationRecordsStart;
+
+  for (const auto &record : m_ModificationRecords)
+  {
+    lastRecordedMTime = record.MTime;
+
+    if (record.MTime <= since)
+      continue;
+
+    if (!record.RegionsKnown)
+    {
+      regions.clear();
+      return false;
+    }
+
+    for (const auto &[recordTimeStep, region] : record.Regions)
+    {
+      if (recordTimeStep == timeStep && region.GetNumberOfPixels() > 0)
+        regions.push_back(region);
+    }
+  }
+
+  // modifications that were not recorded (e.g. of the geometry)
+  if (mTime > std::max(since, lastRecordedMTime))
+  {
+    regions.clear();
+    return false;
+  }
+
+  return true;
+}
+
+void mitk::Image::Modified() const
+{
+  // Same as itk::Object::Modified(), but the modification is recorded before the observers
+  // are notified, so that they can already query its regions (see GetModifiedRegions()).
+  {
+    MutexHolder lock(m_ModifiedRegionsLock);
+
+    itk::TimeStamp timeStamp;
+    timeStamp.Modified();
+    const_cast<Image *>(this)->SetTimeStamp(timeStamp);
+
+    if (m_ModifiedRegionTracking)
+    {
+      ModificationRecord record;
+      record.MTime = this->GetMTime();
+      record.RegionsKnown = !m_PendingModifiedRegions.empty();
+      record.Regions.swap(m_PendingModifiedRegions);
+      m_ModificationRecords.push_back(std::move(record));
+
+      if (m_ModificationRecords.size() > MaximumNumberOfModificationRecords)
+      {
+        m_ModificationRecordsStart = m_ModificationRecords.front().MTime;
+        m_ModificationRecords.pop_front();
+      }
+    }
+  }
+
+  this->InvokeEvent(itk::ModifiedEvent());
+}
+
 void mitk::Image::SetGeometry(BaseGeometry *aGeometry3D)
 {
   // Please be aware of the 0.5 offset/pixel-center issue! See Geometry documentation for further information
@@ -13,17 +13,26 @@ found in the LICENSE file.
 #include "mitkImageWriteAccessor.h"
 
 mitk::ImageWriteAccessor::ImageWriteAccessor(ImagePointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
-  : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image)
+  : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image), m_ModifiedRegionSet(false)
 
 {
   OrganizeWriteAccess();
 }
 
+void mitk::ImageWriteAccessor::SetModifiedRegion(const Image::ModifiedRegionType &region)
+{
+  m_ModifiedRegion = region;
+  m_ModifiedRegionSet = true;
+}
+
 mitk::ImageWriteAccessor::~ImageWriteAccessor()
 {
   // In case of non-coherent memory, copied area needs to be written back
   // TODO
 
+  // the written image part is assigned to the next modification of the image
+  m_Image->AddModifiedMemory(m_AddressBegin, m_AddressEnd, m_ModifiedRegionSet ? &m_ModifiedRegion : nullptr);
+
   m_Image->m_ReadWriteLock.lock();
 
   // delete self from list of ImageReadAccessors in Image
@@ -16,6 +16,10 @@ found in the LICENSE file.
 
 #include <iomanip>
 #include <mitkNumericTypes.h>
+#include <type_traits>
+
+static_assert(std::is_same<mitk::PointSet::PointsContainer, mitk::PointSetSpatialIndex::PointsContainer>::value,
+              "PointSetSpatialIndex must index the points container of PointSet");
 
 namespace mitk
 {
@@ -61,6 +65,10 @@ mitk::PointSet::~PointSet()
 void mitk::PointSet::ClearData()
 {
   m_PointSetSeries.clear();
+  {
+    std::lock_guard<std::mutex> lock(m_SpatialIndicesMutex);
+    m_SpatialIndices.clear();
+  }
   Superclass::ClearData();
 }
 
@@ -197,19 +205,9 @@ int mitk::PointSet::SearchPoint(Point3D point, ScalarType distance, int t) const
     return -1;
   }
 
-  // Out is the point which is checked to be the searched point
-  PointType out;
-  out.Fill(0);
   PointType indexPoint;
-
   this->GetGeometry(t)->WorldToIndex(point, indexPoint);
 
-  // Searching the first point in the Set, that is +- distance far away from
-  // the given point
-  unsigned int i;
-  PointsContainer::Iterator it, end;
-  end = m_PointSetSeries[t]->GetPoints()->End();
-  int bestIndex = -1;
   distance = distance * distance;
 
   // To correct errors from converting index to world and world to index
@@ -218,37 +216,53 @@ int mitk::PointSet::SearchPoint(Point3D point, ScalarType distance, int t) const
     distance = 0.000001;
   }
 
-  ScalarType bestDist = distance;
-  ScalarType dist, tmp;
+  // The closest point within the distance; an exactly matching point has distance 0.
+  // Of points with equal distance, the one with the smallest id is the first in the list.
+  PointIdentifier id;
+  std::lock_guard<std::mutex> lock(m_SpatialIndicesMutex);
+  if (!this->GetSpatialIndex(t).FindClosestPoint(indexPoint, distance, id))
+  {
+    return -1;
+  }
+  return id;
+}
 
-  for (it = m_PointSetSeries[t]->GetPoints()->Begin(), i = 0; it != end; ++it, ++i)
+mitk::PointSet::PointIdentifierListType mitk::PointSet::SearchPointsInSlab(const Point3D &planeOrigin,
+                                                                           const Vector3D &planeNormal,
+                                                                           ScalarType halfThickness,
+                                                                           int t) const
+{
+  PointIdentifierListType ids;
+
+  if (t < 0 || t >= (int)m_PointSetSeries.size() || planeNormal.GetNorm() == 0.0)
   {
-    bool ok = m_PointSetSeries[t]->GetPoints()->GetElementIfIndexExists(it->Index(), &out);
+    return ids;
+  }
 
-    if (!ok)
-    {
-      return -1;
-    }
-    else if (indexPoint == out) // if totally equal
-    {
-      return it->Index();
-    }
+  // The distance of the world point x = M * i + o to the plane is n * (x - origin). In index
+  // coordinates this is (M^T * n) * i - n * (origin - o), which the spatial index evaluates.
+  Vector3D normal = planeNormal;
+  normal.Normalize();
 
-    // distance calculation
-    tmp = out[0] - indexPoint[0];
-    dist = tmp * tmp;
-    tmp = out[1] - indexPoint[1];
-    dist += tmp * tmp;
-    tmp = out[2] - indexPoint[2];
-    dist += tmp * tmp;
+  const AffineTransform3D *transform = this->GetGeometry(t)->GetIndexToWorldTransform();
+  const AffineTransform3D::MatrixType &matrix = transform->GetMatrix();
+  const AffineTransform3D::OffsetType &offset = transform->GetOffset();
 
-    if (dist < bestDist)
+  Vector3D indexNormal;
+  ScalarType indexOffset = 0.0;
+  for (unsigned int j = 0; j < 3; ++j)
+  {
+    indexNormal[j] = 0.0;
+    for (unsigned int i = 0; i < 3; ++i)
     {
-      bestIndex = it->Index();
-      bestDist = dist;
+      indexNormal[j] += matrix[i][j] * normal[i];
     }
+    indexOffset += normal[j] * (planeOrigin[j] - offset[j]);
   }
-  return bestIndex;
+
+  std::lock_guard<std::mutex> lock(m_SpatialIndicesMutex);
+  this->GetSpatialIndex(t).FindPointsInSlab(indexNormal, indexOffset, halfThickness, ids);
+  return ids;
 }
 
 mitk::PointSet::PointType mitk::PointSet::GetPoint(PointIdentifier id, int t) const
@@ -296,9 +310,11 @@ void mitk::PointSet::SetPoint(PointIdentifier id, PointType point, int t)
   // Adapt the size of the data vector if necessary
   this->Expand(t + 1);
 
+  const auto pointsTime = this->GetPointsMTime(t);
   mitk::Point3D indexPoint;
   this->GetGeometry(t)->WorldToIndex(point, indexPoint);
   m_PointSetSeries[t]->SetPoint(id, indexPoint);
+  this->UpdateSpatialIndex(t, pointsTime, {id});
   PointDataType defaultPointData;
   defaultPointData.id = id;
   defaultPointData.selected = false;
@@ -315,9 +331,11 @@ void mitk::PointSet::SetPoint(PointIdentifier id, PointType point, PointSpecific
   // Adapt the size of the data vector if necessary
   this->Expand(t + 1);
 
+  const auto pointsTime = this->GetPointsMTime(t);
   mitk::Point3D indexPoint;
   this->GetGeometry(t)->WorldToIndex(point, indexPoint);
   m_PointSetSeries[t]->SetPoint(id, indexPoint);
+  this->UpdateSpatialIndex(t, pointsTime, {id});
   PointDataType defaultPointData;
   defaultPointData.id = id;
   defaultPointData.selected = false;
@@ -345,7 +363,9 @@ void mitk::PointSet::InsertPoint(PointIdentifier id, PointType point, PointSpeci
       return;
     }
     tempGeometry->WorldToIndex(point, indexPoint);
+    const auto pointsTime = this->GetPointsMTime(t);
     m_PointSetSeries[t]->GetPoints()->InsertElement(id, indexPoint);
+    this->UpdateSpatialIndex(t, pointsTime, {id});
     PointDataType defaultPointData;
     defaultPointData.id = id;
     defaultPointData.selected = false;
@@ -371,9 +391,11 @@ mitk::PointSet::PointIdentifier mitk::PointSet::InsertPoint(PointType point, int
     ++id;
   }
 
+  const auto pointsTime = this->GetPointsMTime(t);
   mitk::Point3D indexPoint;
   this->GetGeometry(t)->WorldToIndex(point, indexPoint);
   m_PointSetSeries[t]->SetPoint(id, indexPoint);
+  this->UpdateSpatialIndex(t, pointsTime, {id});
   PointDataType defaultPointData;
   defaultPointData.id = id;
   defaultPointData.selected = false;
@@ -387,6 +409,47 @@ mitk::PointSet::PointIdentifier mitk::PointSet::InsertPoint(PointType point, int
   return id;
 }
 
+void mitk::PointSet::InsertPoints(const std::vector<PointType> &points, int t)
+{
+  if (points.empty())
+  {
+    return;
+  }
+
+  // Adapt the size of the data vector if necessary
+  this->Expand(t + 1);
+
+  PointIdentifier id = 0;
+  if (m_PointSetSeries[t]->GetNumberOfPoints() > 0)
+  {
+    PointsIterator it = --End(t);
+    id = it.Index();
+    ++id;
+  }
+
+  mitk::BaseGeometry *geometry = this->GetGeometry(t);
+  PointsContainer *pointsContainer = m_PointSetSeries[t]->GetPoints();
+  PointDataContainer *pointDataContainer = m_PointSetSeries[t]->GetPointData();
+
+  mitk::Point3D indexPoint;
+  PointDataType defaultPointData;
+  defaultPointData.selected = false;
+  defaultPointData.pointSpec = mitk::PTUNDEFINED;
+
+  for (const auto &point : points)
+  {
+    geometry->WorldToIndex(point, indexPoint);
+    pointsContainer->InsertElement(id, indexPoint);
+    defaultPointData.id = id;
+    pointDataContainer->InsertElement(id, defaultPointData);
+    ++id;
+  }
+
+  // boundingbox has to be computed anyway
+  m_CalculateBoundingBox = true;
+  this->Modified();
+}
+
 bool mitk::PointSet::RemovePointIfExists(PointIdentifier id, int t)
 {
   if ((unsigned int)t < m_PointSetSeries.size())
@@ -399,14 +462,48 @@ bool mitk::PointSet::RemovePointIfExists(PointIdentifier id, int t)
     bool exists = points->IndexExists(id);
     if (exists)
     {
+      const auto pointsTime = points->GetMTime();
       points->DeleteIndex(id);
       pdata->DeleteIndex(id);
+      this->UpdateSpatialIndex(t, pointsTime, {id});
       return true;
     }
   }
   return false;
 }
 
+unsigned int mitk::PointSet::RemovePoints(const PointIdentifierListType &ids, int t)
+{
+  if ((unsigned int)t >= m_PointSetSeries.size())
+  {
+    return 0;
+  }
+
+  DataType *pointSet = m_PointSetSeries[t];
+
+  PointsContainer *points = pointSet->GetPoints();
+  PointDataContainer *pdata = pointSet->GetPointData();
+
+  unsigned int numberOfRemovedPoints = 0;
+  for (const auto id : ids)
+  {
+    if (points->IndexExists(id))
+    {
+      points->DeleteIndex(id);
+      pdata->DeleteIndex(id);
+      ++numberOfRemovedPoints;
+    }
+  }
+
+  if (numberOfRemovedPoints > 0)
+  {
+    // boundingbox has to be computed anyway
+    m_CalculateBoundingBox = true;
+    this->Modified();
+  }
+  return numberOfRemovedPoints;
+}
+
 mitk::PointSet::PointsIterator mitk::PointSet::RemovePointAtEnd(int t)
 {
   if ((unsigned int)t < m_PointSetSeries.size())
@@ -608,7 +705,9 @@ void mitk::PointSet::ExecuteOperation(Operation *operation)
       }
       geometry->WorldToIndex(pt, pt);
 
+      const auto pointsTime = this->GetPointsMTime(timeStep);
       m_PointSetSeries[timeStep]->GetPoints()->InsertElement(position, pt);
+      this->UpdateSpatialIndex(timeStep, pointsTime, {static_cast<PointIdentifier>(position)});
 
       PointDataType pointData = {
         static_cast<unsigned int>(pointOp->GetIndex()), pointOp->GetSelected(), pointOp->GetPointType()};
@@ -634,7 +733,9 @@ void mitk::PointSet::ExecuteOperation(Operation *operation)
       this->GetGeometry(timeStep)->WorldToIndex(pt, pt);
 
       // Copy new point into container
+      const auto pointsTime = this->GetPointsMTime(timeStep);
       m_PointSetSeries[timeStep]->SetPoint(pointOp->GetIndex(), pt);
+      this->UpdateSpatialIndex(timeStep, pointsTime, {static_cast<PointIdentifier>(pointOp->GetIndex())});
 
       // Insert a default point data object to keep the containers in sync
       // (if no point data object exists yet)
@@ -657,8 +758,10 @@ void mitk::PointSet::ExecuteOperation(Operation *operation)
 
     case OpREMOVE: // removes the point at given by position
     {
+      const auto pointsTime = this->GetPointsMTime(timeStep);
       m_PointSetSeries[timeStep]->GetPoints()->DeleteIndex((unsigned)pointOp->GetIndex());
       m_PointSetSeries[timeStep]->GetPointData()->DeleteIndex((unsigned)pointOp->GetIndex());
+      this->UpdateSpatialIndex(timeStep, pointsTime, {static_cast<PointIdentifier>(pointOp->GetIndex())});
 
       this->OnPointSetChange();
 
@@ -877,13 +980,45 @@ bool mitk::PointSet::SwapPointContents(PointIdentifier id1, PointIdentifier id2,
   if (m_PointSetSeries[timeStep]->GetPointData(id2, &data2) == false)
     return false;
   /* now swap contents */
+  const auto pointsTime = this->GetPointsMTime(timeStep);
   m_PointSetSeries[timeStep]->SetPoint(id1, p2);
   m_PointSetSeries[timeStep]->SetPointData(id1, data2);
   m_PointSetSeries[timeStep]->SetPoint(id2, p1);
   m_PointSetSeries[timeStep]->SetPointData(id2, data1);
+  this->UpdateSpatialIndex(timeStep, pointsTime, {id1, id2});
   return true;
 }
 
+const mitk::PointSetSpatialIndex &mitk::PointSet::GetSpatialIndex(unsigned int t) const
+{
+  if (m_SpatialIndices.size() < m_PointSetSeries.size())
+  {
+    m_SpatialIndices.resize(m_PointSetSeries.size());
+  }
+
+  m_SpatialIndices[t].Update(m_PointSetSeries[t]->GetPoints());
+  return m_SpatialIndices[t];
+}
+
+itk::ModifiedTimeType mitk::PointSet::GetPointsMTime(unsigned int t) const
+{
+  if (t >= m_PointSetSeries.size())
+    return 0;
+
+  return m_PointSetSeries[t]->GetPoints()->GetMTime();
+}
+
+void mitk::PointSet::UpdateSpatialIndex(unsigned int t,
+                                        itk::ModifiedTimeType pointsTimeBeforeEdit,
+                                        const PointIdentifierListType &ids)
+{
+  std::lock_guard<std::mutex> lock(m_SpatialIndicesMutex);
+  if (t < m_SpatialIndices.size())
+  {
+    m_SpatialIndices[t].UpdatePoints(m_PointSetSeries[t]->GetPoints(), pointsTimeBeforeEdit, ids);
+  }
+}
+
 bool mitk::PointSet::PointDataType::operator==(const mitk::PointSet::PointDataType &other) const
 {
   return id == other.id && selected == other.selected && pointSpec == other.pointSpec;
@@ -0,0 +1,408 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPointSetSpatialIndex.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+  /** Ranges of up to this many points are not split any further but scanned linearly */
+  const std::size_t LeafSize = 8;
+
+  const std::size_t NoPoint = std::numeric_limits<std::size_t>::max();
+
+  /** The tree is rebuilt once more edited points are pending than the larger of these limits */
+  const std::size_t MinimumPendingEdits = 64;
+  const std::size_t PendingEditsFraction = 16;
+}
+
+mitk::PointSetSpatialIndex::PointSetSpatialIndex() : m_PointsTime(0), m_NumberOfPoints(0)
+{
+  this->Clear();
+}
+
+void mitk::PointSetSpatialIndex::Update(const PointsContainer *points)
+{
+  // Edited points are searched linearly, so merge them into the tree once there are many
+  const std::size_t maximumPendingEdits = std::max(MinimumPendingEdits, m_Ids.size() / PendingEditsFraction);
+  if (this->IsUpToDate(points) && m_StaleIds.size() <= maximumPendingEdits)
+    return;
+
+  this->Build(points);
+}
+
+void mitk::PointSetSpatialIndex::UpdatePoints(const PointsContainer *points,
+                                              itk::ModifiedTimeType pointsTimeBeforeEdit,
+                                              const PointIdentifierListType &ids)
+{
+  if (points == nullptr || m_Points.GetPointer() != points || m_PointsTime != pointsTimeBeforeEdit)
+    return;
+
+  for (const auto id : ids)
+  {
+    // The entry of the point in the tree, if any, is outdated now
+    m_StaleIds.insert(id);
+
+    PointsContainer::Element point;
+    if (points->GetElementIfIndexExists(id, &point))
+    {
+      m_EditedPoints[id] = point;
+    }
+    else
+    {
+      m_EditedPoints.erase(id);
+    }
+  }
+
+  m_PointsTime = points->GetMTime();
+  m_NumberOfPoints = points->Size();
+}
+
+void mitk::PointSetSpatialIndex::Build(const PointsContainer *points)
+{
+  this->Clear();
+
+  if (points == nullptr)
+    return;
+
+  m_Points = points;
+  m_PointsTime = points->GetMTime();
+
+  const std::size_t size = points->Size();
+  m_NumberOfPoints = size;
+  m_X.reserve(size);
+  m_Y.reserve(size);
+  m_Z.reserve(size);
+  m_Ids.reserve(size);
+
+  for (auto it = points->Begin(); it != points->End(); ++it)
+  {
+    const auto &point = it->Value();
+    m_X.push_back(point[0]);
+    m_Y.push_back(point[1]);
+    m_Z.push_back(point[2]);
+    m_Ids.push_back(it->Index());
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      m_Bounds[2 * axis] = std::min(m_Bounds[2 * axis], point[axis]);
+      m_Bounds[2 * axis + 1] = std::max(m_Bounds[2 * axis + 1], point[axis]);
+    }
+  }
+
+  if (size <= LeafSize)
+    return;
+
+  // Sort a permutation of the points into k-d tree order, then gather the coordinates
+  std::vector<std::size_t> order(size);
+  for (std::size_t i = 0; i < size; ++i)
+    order[i] = i;
+
+  m_SplitAxis.assign(size, 0);
+  this->BuildRange(order, 0, size);
+
+  std::vector<ScalarType> x(size), y(size), z(size);
+  PointIdentifierListType ids(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    x[i] = m_X[order[i]];
+    y[i] = m_Y[order[i]];
+    z[i] = m_Z[order[i]];
+    ids[i] = m_Ids[order[i]];
+  }
+
+  m_X.swap(x);
+  m_Y.swap(y);
+  m_Z.swap(z);
+  m_Ids.swap(ids);
+}
+
+bool mitk::PointSetSpatialIndex::IsUpToDate(const PointsContainer *points) const
+{
+  if (m_Points.GetPointer() != points)
+    return false;
+
+  return points == nullptr || points->GetMTime() == m_PointsTime;
+}
+
+void mitk::PointSetSpatialIndex::Clear()
+{
+  m_Points = nullptr;
+  m_PointsTime = 0;
+  m_NumberOfPoints = 0;
+
+  m_X.clear();
+  m_Y.clear();
+  m_Z.clear();
+  m_Ids.clear();
+  m_SplitAxis.clear();
+  m_EditedPoints.clear();
+  m_StaleIds.clear();
+
+  const ScalarType max = std::numeric_limits<ScalarType>::max();
+  for (unsigned int axis = 0; axis < 3; ++axis)
+  {
+    m_Bounds[2 * axis] = max;
+    m_Bounds[2 * axis + 1] = -max;
+  }
+}
+
+std::size_t mitk::PointSetSpatialIndex::GetNumberOfPoints() const
+{
+  return m_NumberOfPoints;
+}
+
+bool mitk::PointSetSpatialIndex::FindClosestPoint(const Point3D &point,
+                                                  ScalarType maxSquaredDistance,
+                                                  PointIdentifier &id) const
+{
+  const ScalarType coordinates[3] = {point[0], point[1], point[2]};
+  ScalarType bestSquaredDistance = maxSquaredDistance;
+  std::size_t best = NoPoint;
+
+  this->FindClosestPointInRange(0, m_Ids.size(), coordinates, bestSquaredDistance, best);
+
+  bool found = best != NoPoint;
+  if (found)
+    id = m_Ids[best];
+
+  for (const auto &edited : m_EditedPoints)
+  {
+    const ScalarType squaredDistance = point.SquaredEuclideanDistanceTo(edited.second);
+    if (squaredDistance < bestSquaredDistance || (squaredDistance == bestSquaredDistance && found && edited.first < id))
+    {
+      bestSquaredDistance = squaredDistance;
+      id = edited.first;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+void mitk::PointSetSpatialIndex::FindPointsInSlab(const Vector3D &normal,
+                                                  ScalarType offset,
+                                                  ScalarType halfThickness,
+                                                  PointIdentifierListType &ids) const
+{
+  ids.clear();
+
+  const ScalarType minimum = offset - halfThickness;
+  const ScalarType maximum = offset + halfThickness;
+
+  if (!m_Ids.empty())
+  {
+    ScalarType bounds[6];
+    std::copy(m_Bounds, m_Bounds + 6, bounds);
+
+    this->FindPointsInSlabInRange(0, m_Ids.size(), bounds, normal, minimum, maximum, ids);
+  }
+
+  for (const auto &edited : m_EditedPoints)
+  {
+    const auto &point = edited.second;
+    const ScalarType value = normal[0] * point[0] + normal[1] * point[1] + normal[2] * point[2];
+    if (value >= minimum && value <= maximum)
+      ids.push_back(edited.first);
+  }
+
+  std::sort(ids.begin(), ids.end());
+}
+
+void mitk::PointSetSpatialIndex::BuildRange(std::vector<std::size_t> &order, std::size_t begin, std::size_t end)
+{
+  if (end - begin <= LeafSize)
+    return;
+
+  // Split along the axis of largest extent of the points in the range
+  ScalarType lower[3], upper[3];
+  for (unsigned int axis = 0; axis < 3; ++axis)
+  {
+    lower[axis] = upper[axis] = this->GetCoordinate(order[begin], axis);
+  }
+
+  for (std::size_t i = begin + 1; i < end; ++i)
+  {
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      const ScalarType coordinate = this->GetCoordinate(order[i], axis);
+      lower[axis] = std::min(lower[axis], coordinate);
+      upper[axis] = std::max(upper[axis], coordinate);
+    }
+  }
+
+  unsigned int splitAxis = 0;
+  for (unsigned int axis = 1; axis < 3; ++axis)
+  {
+    if (upper[axis] - lower[axis] > upper[splitAxis] - lower[splitAxis])
+      splitAxis = axis;
+  }
+
+  const std::size_t middle = begin + (end - begin) / 2;
+  std::nth_element(order.begin() + begin,
+                   order.begin() + middle,
+                   order.begin() + end,
+                   [this, splitAxis](std::size_t a, std::size_t b) {
+                     return this->GetCoordinate(a, splitAxis) < this->GetCoordinate(b, splitAxis);
+                   });
+
+  m_SplitAxis[middle] = static_cast<unsigned char>(splitAxis);
+
+  this->BuildRange(order, begin, middle);
+  this->BuildRange(order, middle + 1, end);
+}
+
+void mitk::PointSetSpatialIndex::FindClosestPointInRange(std::size_t begin,
+                                                         std::size_t end,
+                                                         const ScalarType point[3],
+                                                         ScalarType &bestSquaredDistance,
+                                                         std::size_t &best) const
+{
+  auto visit = [&](std::size_t i) {
+    if (this->IsStale(i))
+      return;
+
+    const ScalarType dx = m_X[i] - point[0];
+    const ScalarType dy = m_Y[i] - point[1];
+    const ScalarType dz = m_Z[i] - point[2];
+    const ScalarType squaredDistance = dx * dx + dy * dy + dz * dz;
+
+    if (squaredDistance < bestSquaredDistance ||
+        (squaredDistance == bestSquaredDistance && best != NoPoint && m_Ids[i] < m_Ids[best]))
+    {
+      bestSquaredDistance = squaredDistance;
+      best = i;
+    }
+  };
+
+  if (end - begin <= LeafSize)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+      visit(i);
+    return;
+  }
+
+  const std::size_t middle = begin + (end - begin) / 2;
+  const unsigned int axis = m_SplitAxis[middle];
+  visit(middle);
+
+  // Descend into the half containing the point first, the other half can only contain
+  // better points if the splitting plane is closer than the best point found so far
+  const ScalarType difference = point[axis] - this->GetCoordinate(middle, axis);
+  if (difference <= 0.0)
+  {
+    this->FindClosestPointInRange(begin, middle, point, bestSquaredDistance, best);
+    if (difference * difference <= bestSquaredDistance)
+      this->FindClosestPointInRange(middle + 1, end, point, bestSquaredDistance, best);
+  }
+  else
+  {
+    this->FindClosestPointInRange(middle + 1, end, point, bestSquaredDistance, best);
+    if (difference * difference <= bestSquaredDistance)
+      this->FindClosestPointInRange(begin, middle, point, bestSquaredDistance, best);
+  }
+}
+
+void mitk::PointSetSpatialIndex::FindPointsInSlabInRange(std::size_t begin,
+                                                         std::size_t end,
+                                                         ScalarType bounds[6],
+                                                         const Vector3D &normal,
+                                                         ScalarType minimum,
+                                                         ScalarType maximum,
+                                                         PointIdentifierListType &ids) const
+{
+  if (begin >= end)
+    return;
+
+  // Range of normal * p over the box of the range
+  ScalarType boxMinimum = 0.0;
+  ScalarType boxMaximum = 0.0;
+  for (unsigned int axis = 0; axis < 3; ++axis)
+  {
+    const ScalarType a = normal[axis] * bounds[2 * axis];
+    const ScalarType b = normal[axis] * bounds[2 * axis + 1];
+    boxMinimum += std::min(a, b);
+    boxMaximum += std::max(a, b);
+  }
+
+  if (boxMaximum < minimum || boxMinimum > maximum)
+    return;
+
+  if (boxMinimum >= minimum && boxMaximum <= maximum)
+  {
+    if (m_StaleIds.empty())
+    {
+      ids.insert(ids.end(), m_Ids.begin() + begin, m_Ids.begin() + end);
+    }
+    else
+    {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        if (!this->IsStale(i))
+          ids.push_back(m_Ids[i]);
+      }
+    }
+    return;
+  }
+
+  auto visit = [&](std::size_t i) {
+    if (this->IsStale(i))
+      return;
+
+    const ScalarType value = normal[0] * m_X[i] + normal[1] * m_Y[i] + normal[2] * m_Z[i];
+    if (value >= minimum && value <= maximum)
+      ids.push_back(m_Ids[i]);
+  };
+
+  if (end - begin <= LeafSize)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+      visit(i);
+    return;
+  }
+
+  const std::size_t middle = begin + (end - begin) / 2;
+  const unsigned int axis = m_SplitAxis[middle];
+  const ScalarType split = this->GetCoordinate(middle, axis);
+  visit(middle);
+
+  const ScalarType lower = bounds[2 * axis];
+  const ScalarType upper = bounds[2 * axis + 1];
+
+  bounds[2 * axis + 1] = split;
+  this->FindPointsInSlabInRange(begin, middle, bounds, normal, minimum, maximum, ids);
+  bounds[2 * axis + 1] = upper;
+
+  bounds[2 * axis] = split;
+  this->FindPointsInSlabInRange(middle + 1, end, bounds, normal, minimum, maximum, ids);
+  bounds[2 * axis] = lower;
+}
+
+mitk::ScalarType mitk::PointSetSpatialIndex::GetCoordinate(std::size_t i, unsigned int axis) const
+{
+  switch (axis)
+  {
+    case 0:
+      return m_X[i];
+    case 1:
+      return m_Y[i];
+    default:
+      return m_Z[i];
+  }
+}
+
+bool mitk::PointSetSpatialIndex::IsStale(std::size_t i) const
+{
+  return !m_StaleIds.empty() && m_StaleIds.count(m_Ids[i]) != 0;
+}
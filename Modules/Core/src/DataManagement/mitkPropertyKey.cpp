@@ -0,0 +1,111 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkPropertyKey.h>
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+  /** Global registry of all interned keys. Names are stored in a deque, so references to
+   *  them stay valid when new keys are added.*/
+  class PropertyKeyRegistry
+  {
+  public:
+    static PropertyKeyRegistry &GetInstance()
+    {
+      static PropertyKeyRegistry instance;
+      return instance;
+    }
+
+    mitk::PropertyKey::IdType Intern(const std::string &name, const std::string *&internedName)
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+
+      auto finding = m_Ids.find(name);
+      if (finding == m_Ids.end())
+      {
+        m_Names.push_back(name);
+        finding = m_Ids.emplace(name, m_Names.size() - 1).first;
+      }
+
+      internedName = &m_Names[finding->second];
+      return finding->second;
+    }
+
+  private:
+    std::mutex m_Mutex;
+    std::unordered_map<std::string, mitk::PropertyKey::IdType> m_Ids;
+    std::deque<std::string> m_Names;
+  };
+}
+
+mitk::PropertyKey::PropertyKey()
+  : PropertyKey(std::string())
+{
+}
+
+mitk::PropertyKey::PropertyKey(const std::string &name)
+  : m_Id(0),
+    m_Name(nullptr)
+{
+  m_Id = PropertyKeyRegistry::GetInstance().Intern(name, m_Name);
+}
+
+mitk::PropertyKey::PropertyKey(const char *name)
+  : PropertyKey(std::string(nullptr != name ? name : ""))
+{
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::Visible()
+{
+  static const PropertyKey key("visible");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::Layer()
+{
+  static const PropertyKey key("layer");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::Opacity()
+{
+  static const PropertyKey key("opacity");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::Color()
+{
+  static const PropertyKey key("color");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::Name()
+{
+  static const PropertyKey key("name");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::LevelWindow()
+{
+  static const PropertyKey key("levelwindow");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::Pickable()
+{
+  static const PropertyKey key("pickable");
+  return key;
+}
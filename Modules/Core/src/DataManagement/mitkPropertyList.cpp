@@ -56,6 +56,35 @@ mitk::BaseProperty *mitk::PropertyList::GetProperty(const std::string &propertyK
     return nullptr;
 }
 
+mitk::BaseProperty *mitk::PropertyList::GetProperty(const PropertyKey &propertyKey) const
+{
+  auto it = m_PropertyIndex.find(propertyKey.GetId());
+  if (it != m_PropertyIndex.cend())
+    return it->second;
+  else
+    return nullptr;
+}
+
+void mitk::PropertyList::InsertProperty(const std::string &propertyKey, BaseProperty *property)
+{
+  m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  m_PropertyIndex[PropertyKey(propertyKey).GetId()] = property;
+}
+
+void mitk::PropertyList::ErasePropertyFromIndex(const std::string &propertyKey)
+{
+  m_PropertyIndex.erase(PropertyKey(propertyKey).GetId());
+}
+
+void mitk::PropertyList::RebuildPropertyIndex()
+{
+  m_PropertyIndex.clear();
+  for (const auto &property : m_Properties)
+  {
+    m_PropertyIndex[PropertyKey(property.first).GetId()] = property.second;
+  }
+}
+
 mitk::BaseProperty * mitk::PropertyList::GetNonConstProperty(const std::string &propertyKey, const std::string &/*contextName*/, bool /*fallBackOnDefaultContext*/)
 {
   return this->GetProperty(propertyKey);
@@ -103,7 +132,7 @@ void mitk::PropertyList::SetProperty(const std::string &propertyKey, BasePropert
   }
 
   // no? add it.
-  m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->InsertProperty(propertyKey, property);
   this->Modified();
 }
 
@@ -122,7 +151,7 @@ void mitk::PropertyList::ReplaceProperty(const std::string &propertyKey, BasePro
   }
 
   // no? add/replace it.
-  m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->InsertProperty(propertyKey, property);
   Modified();
 }
 
@@ -135,6 +164,7 @@ void mitk::PropertyList::RemoveProperty(const std::string &propertyKey, const st
   {
     it->second = nullptr;
     m_Properties.erase(it);
+    this->ErasePropertyFromIndex(propertyKey);
     Modified();
   }
 }
@@ -149,6 +179,7 @@ mitk::PropertyList::PropertyList(const mitk::PropertyList &other) : itk::Object(
   {
     m_Properties.insert(std::make_pair(i->first, i->second->Clone()));
   }
+  this->RebuildPropertyIndex();
 }
 
 mitk::PropertyList::~PropertyList()
@@ -186,6 +217,7 @@ bool mitk::PropertyList::DeleteProperty(const std::string &propertyKey)
   {
     it->second = nullptr;
     m_Properties.erase(it);
+    this->ErasePropertyFromIndex(propertyKey);
     Modified();
     return true;
   }
@@ -201,6 +233,7 @@ void mitk::PropertyList::Clear()
     ++it;
   }
   m_Properties.clear();
+  m_PropertyIndex.clear();
 }
 
 itk::LightObject::Pointer mitk::PropertyList::InternalClone() const
@@ -419,4 +452,5 @@ void mitk::PropertyList::FromJSON(const nlohmann::json& j)
   }
 
   m_Properties = properties;
+  this->RebuildPropertyIndex();
 }
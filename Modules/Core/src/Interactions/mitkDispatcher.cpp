@@ -14,20 +14,21 @@ found in the LICENSE file.
 #include "mitkInteractionEvent.h"
 #include "mitkInteractionEventObserver.h"
 #include "mitkInternalEvent.h"
+#include "mitkMouseMoveEvent.h"
 #include "usGetModuleContext.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace
 {
-  struct cmp
+  bool IsMouseMoveEvent(const mitk::InteractionEvent *event)
   {
-    bool operator()(mitk::WeakPointer<mitk::DataInteractor> d1, mitk::WeakPointer<mitk::DataInteractor> d2)
-    {
-      return (d1.Lock()->GetLayer() > d2.Lock()->GetLayer());
-    }
-  };
+    return dynamic_cast<const mitk::MouseMoveEvent *>(event) != nullptr;
+  }
 }
 
-mitk::Dispatcher::Dispatcher(const std::string &rendererName) : m_ProcessingMode(REGULAR)
+mitk::Dispatcher::Dispatcher(const std::string &rendererName) : m_ProcessingMode(REGULAR), m_ProcessingDepth(0)
 {
   // LDAP filter string to find all listeners specific for the renderer
   // corresponding to this dispatcher
@@ -99,6 +100,76 @@ mitk::Dispatcher::~Dispatcher()
 }
 
 bool mitk::Dispatcher::ProcessEvent(InteractionEvent *event)
+{
+  // A mouse move that arrives while another event is still being handled (e.g. from a nested event loop) only
+  // replaces the pending move of its sender. High-rate input devices would otherwise pile up nested handlers.
+  if (m_ProcessingDepth > 0 && IsMouseMoveEvent(event))
+  {
+    auto pendingMove =
+      std::find_if(m_PendingMouseMoves.begin(), m_PendingMouseMoves.end(), [event](const InteractionEvent::Pointer &e) {
+        return e->GetSender() == event->GetSender();
+      });
+
+    if (pendingMove != m_PendingMouseMoves.end())
+    {
+      *pendingMove = event;
+    }
+    else
+    {
+      m_PendingMouseMoves.push_back(event);
+    }
+
+    // the move is processed later on, it must not be handled by the sender in the meantime
+    return true;
+  }
+
+  // pending moves arrived before this event, so they are dispatched first
+  this->FlushPendingMouseMoves();
+
+  bool eventIsHandled = false;
+  ++m_ProcessingDepth;
+  try
+  {
+    eventIsHandled = this->DispatchEvent(event);
+  }
+  catch (...)
+  {
+    --m_ProcessingDepth;
+    throw;
+  }
+  --m_ProcessingDepth;
+
+  if (m_ProcessingDepth == 0)
+  {
+    this->FlushPendingMouseMoves();
+  }
+
+  return eventIsHandled;
+}
+
+void mitk::Dispatcher::FlushPendingMouseMoves()
+{
+  while (!m_PendingMouseMoves.empty())
+  {
+    InteractionEvent::Pointer e = m_PendingMouseMoves.front();
+    m_PendingMouseMoves.pop_front();
+
+    // moves that arrive while the pending one is dispatched are coalesced again
+    ++m_ProcessingDepth;
+    try
+    {
+      this->DispatchEvent(e);
+    }
+    catch (...)
+    {
+      --m_ProcessingDepth;
+      throw;
+    }
+    --m_ProcessingDepth;
+  }
+}
+
+bool mitk::Dispatcher::DispatchEvent(InteractionEvent *event)
 {
   InteractionEvent::Pointer p = event;
   bool eventIsHandled = false;
@@ -165,13 +236,11 @@ bool mitk::Dispatcher::ProcessEvent(InteractionEvent *event)
   {
     if (std::strcmp(p->GetNameOfClass(), "MousePressEvent") == 0)
       RenderingManager::GetInstance()->SetRenderWindowFocus(event->GetSender()->GetRenderWindow());
-    m_Interactors.sort(cmp()); // sorts interactors by layer (descending);
 
-    // copy the list to prevent iterator invalidation as executing actions
+    // the snapshot prevents iterator invalidation as executing actions
     // in HandleEvent() can cause the m_Interactors list to be updated
-    const ListInteractorType tmpInteractorList(m_Interactors);
-    ListInteractorType::const_iterator it;
-    for (it = tmpInteractorList.cbegin(); it != tmpInteractorList.cend(); ++it)
+    const std::vector<WeakPointer<DataInteractor>> interactors = this->GetInteractorsSortedByLayer();
+    for (auto it = interactors.cbegin(); it != interactors.cend(); ++it)
     {
       auto interactor = it->Lock();
       if (interactor.IsNotNull() && interactor->HandleEvent(event, interactor->GetDataNode()))
@@ -217,11 +286,50 @@ bool mitk::Dispatcher::ProcessEvent(InteractionEvent *event)
   {
     InteractionEvent::Pointer e = m_QueuedEvents.front();
     m_QueuedEvents.pop_front();
-    ProcessEvent(e);
+    DispatchEvent(e);
   }
   return eventIsHandled;
 }
 
+std::vector<mitk::WeakPointer<mitk::DataInteractor>> mitk::Dispatcher::GetInteractorsSortedByLayer()
+{
+  // Query each layer once per event and only reorder the list if a layer changed since the last event
+  std::vector<std::pair<int, WeakPointer<DataInteractor>>> layeredInteractors;
+  layeredInteractors.reserve(m_Interactors.size());
+
+  bool isSorted = true;
+  for (const auto &weakInteractor : m_Interactors)
+  {
+    auto interactor = weakInteractor.Lock();
+    const int layer = interactor.IsNotNull() ? interactor->GetLayer() : std::numeric_limits<int>::min();
+
+    if (!layeredInteractors.empty() && layer > layeredInteractors.back().first)
+      isSorted = false;
+
+    layeredInteractors.emplace_back(layer, weakInteractor);
+  }
+
+  if (!isSorted)
+  {
+    // sorts interactors by layer (descending), interactors of equal layers keep their order
+    std::stable_sort(layeredInteractors.begin(),
+                     layeredInteractors.end(),
+                     [](const std::pair<int, WeakPointer<DataInteractor>> &a,
+                        const std::pair<int, WeakPointer<DataInteractor>> &b) { return a.first > b.first; });
+
+    m_Interactors.clear();
+    for (const auto &layeredInteractor : layeredInteractors)
+      m_Interactors.push_back(layeredInteractor.second);
+  }
+
+  std::vector<WeakPointer<DataInteractor>> interactors;
+  interactors.reserve(layeredInteractors.size());
+  for (const auto &layeredInteractor : layeredInteractors)
+    interactors.push_back(layeredInteractor.second);
+
+  return interactors;
+}
+
 /*
  * Checks if DataNodes associated with DataInteractors point back to them.
  * If not remove the DataInteractors. (This can happen when s.o. tries to set DataNodes to multiple DataInteractors)
@@ -262,7 +370,16 @@ void mitk::Dispatcher::RemoveOrphanedInteractors()
 
 void mitk::Dispatcher::QueueEvent(InteractionEvent *event)
 {
-  m_QueuedEvents.push_back(event);
+  // a queued mouse move that has not been processed yet is superseded by a newer one of the same sender
+  if (IsMouseMoveEvent(event) && !m_QueuedEvents.empty() && IsMouseMoveEvent(m_QueuedEvents.back()) &&
+      m_QueuedEvents.back()->GetSender() == event->GetSender())
+  {
+    m_QueuedEvents.back() = event;
+  }
+  else
+  {
+    m_QueuedEvents.push_back(event);
+  }
 }
 
 void mitk::Dispatcher::SetEventProcessingMode(DataInteractor *dataInteractor)
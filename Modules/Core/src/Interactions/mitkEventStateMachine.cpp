@@ -20,12 +20,123 @@ found in the LICENSE file.
 #include "mitkStateMachineTransition.h"
 #include "mitkUndoController.h"
 
+#include <deque>
+
+struct mitk::EventStateMachine::TransitionTable
+{
+  struct Condition
+  {
+    const StateMachineCondition *Definition;
+    std::size_t Slot; // index in ConditionResults, shared by conditions of the same name
+  };
+
+  struct Transition
+  {
+    StateMachineTransition::Pointer Definition;
+    StateMachineState *NextState;
+    int NextStateIndex;
+    std::vector<Condition> Conditions;
+  };
+
+  /** \brief Transitions of a state for one event signature, in the order of the pattern */
+  struct Cell
+  {
+    bool IsCompiled = false;
+    std::vector<int> Transitions;
+  };
+
+  std::vector<StateMachineState::Pointer> States;
+
+  // a deque keeps references valid while actions handle nested events that compile further transitions
+  std::deque<Transition> Transitions;
+  std::map<StateMachineTransition *, int> TransitionIndices;
+  std::map<std::string, std::size_t> ConditionSlots;
+
+  // event class -> event variant -> signature index
+  std::map<std::string, std::map<std::string, std::size_t>, std::less<>> EventSignatures;
+  std::size_t NumberOfEventSignatures = 0;
+
+  // Cells[state index][signature index]
+  std::vector<std::vector<Cell>> Cells;
+
+  // results of the conditions evaluated for the current event: -1 not evaluated, 0 false, 1 true
+  std::vector<signed char> ConditionResults;
+
+  int GetStateIndex(StateMachineState *state)
+  {
+    for (std::size_t i = 0; i < States.size(); ++i)
+    {
+      if (States[i].GetPointer() == state)
+        return static_cast<int>(i);
+    }
+
+    States.push_back(state);
+    Cells.emplace_back();
+    return static_cast<int>(States.size() - 1);
+  }
+
+  int GetTransitionIndex(StateMachineTransition *transition)
+  {
+    auto iter = TransitionIndices.find(transition);
+    if (iter != TransitionIndices.end())
+      return iter->second;
+
+    Transition compiled;
+    compiled.Definition = transition;
+    compiled.NextState = transition->GetNextState().GetPointer();
+    compiled.NextStateIndex = compiled.NextState != nullptr ? this->GetStateIndex(compiled.NextState) : -1;
+
+    for (const auto &condition : transition->GetConditions())
+    {
+      auto slotIter = ConditionSlots.emplace(condition.GetConditionName(), ConditionSlots.size()).first;
+      compiled.Conditions.push_back({&condition, slotIter->second});
+    }
+
+    Transitions.push_back(std::move(compiled));
+    const int index = static_cast<int>(Transitions.size() - 1);
+    TransitionIndices[transition] = index;
+    return index;
+  }
+
+  const Cell &GetCell(int stateIndex, const char *eventClass, const std::string &eventVariant)
+  {
+    auto classIter = EventSignatures.find(eventClass);
+    if (classIter == EventSignatures.end())
+      classIter = EventSignatures.emplace(eventClass, std::map<std::string, std::size_t>()).first;
+
+    auto variantIter = classIter->second.find(eventVariant);
+    if (variantIter == classIter->second.end())
+      variantIter = classIter->second.emplace(eventVariant, NumberOfEventSignatures++).first;
+
+    const std::size_t signature = variantIter->second;
+
+    if (Cells[stateIndex].size() <= signature)
+      Cells[stateIndex].resize(signature + 1);
+
+    if (!Cells[stateIndex][signature].IsCompiled)
+    {
+      // Matching the event class hierarchy is expensive, so it is only done once per state and signature.
+      // Compiling transitions may add states, so the cell is looked up again afterwards.
+      std::vector<int> transitions;
+      for (const auto &transition : States[stateIndex]->GetTransitionList(eventClass, eventVariant))
+        transitions.push_back(this->GetTransitionIndex(transition));
+
+      Cell &cell = Cells[stateIndex][signature];
+      cell.Transitions.swap(transitions);
+      cell.IsCompiled = true;
+    }
+
+    return Cells[stateIndex][signature];
+  }
+};
+
 mitk::EventStateMachine::EventStateMachine()
   : m_IsActive(true),
     m_UndoController(nullptr),
     m_StateMachineContainer(nullptr),
     m_CurrentState(nullptr),
-    m_MouseCursorSet(false)
+    m_MouseCursorSet(false),
+    m_CurrentStateIndex(-1)
 {
   if (!m_UndoController)
   {
@@ -45,6 +156,7 @@ bool mitk::EventStateMachine::LoadStateMachine(const std::string &filename, cons
     m_StateMachineContainer->Delete();
   }
   m_StateMachineContainer = StateMachineContainer::New();
+  this->InvalidateTransitionTable();
 
   if (m_StateMachineContainer->LoadBehavior(filename, module))
   {
@@ -120,6 +232,7 @@ void mitk::EventStateMachine::AddActionFunction(const std::string &action, const
 void mitk::EventStateMachine::AddConditionFunction(const std::string &condition,
                                                    const ConditionFunctionDelegate &delegate)
 {
+  delete m_ConditionDelegatesMap[condition];
   m_ConditionDelegatesMap[condition] = delegate.Clone();
 }
 
@@ -133,22 +246,29 @@ bool mitk::EventStateMachine::HandleEvent(InteractionEvent *event, DataNode *dat
     return false;
   }
 
+  // The table is held for the whole transition, actions may load another state machine
+  const std::shared_ptr<TransitionTable> table = this->GetTransitionTable();
+  if (table == nullptr)
+    return false;
+
   // Get the transition that can be executed
-  mitk::StateMachineTransition::Pointer transition = GetExecutableTransition(event);
+  const int transitionIndex = this->FindExecutableTransition(*table, event);
 
   // check if the current state holds a transition that works with the given event.
-  if (transition.IsNotNull())
+  if (transitionIndex >= 0)
   {
+    const TransitionTable::Transition &transition = table->Transitions[transitionIndex];
+
     // all conditions are fulfilled so we can continue with the actions
-    m_CurrentState = transition->GetNextState();
+    m_CurrentState = transition.NextState;
+    m_CurrentStateIndex = transition.NextStateIndex;
 
     // iterate over all actions in this transition and execute them
-    const ActionVectorType actions = transition->GetActions();
-    for (auto it = actions.cbegin(); it != actions.cend(); ++it)
+    for (const auto &action : transition.Definition->GetActions())
     {
       try
       {
-        ExecuteAction(*it, event);
+        ExecuteAction(action, event);
       }
       catch (const std::exception &e)
       {
@@ -240,44 +360,62 @@ bool mitk::EventStateMachine::FilterEvents(InteractionEvent *interactionEvent, D
 
 mitk::StateMachineTransition *mitk::EventStateMachine::GetExecutableTransition(mitk::InteractionEvent *event)
 {
-  // Map that will contain all conditions that are possibly used by the
-  // transitions
-  std::map<std::string, bool> conditionsMap;
+  const std::shared_ptr<TransitionTable> table = this->GetTransitionTable();
+  if (table == nullptr)
+    return nullptr;
 
+  const int transitionIndex = this->FindExecutableTransition(*table, event);
+  return transitionIndex >= 0 ? table->Transitions[transitionIndex].Definition.GetPointer() : nullptr;
+}
+
+std::shared_ptr<mitk::EventStateMachine::TransitionTable> mitk::EventStateMachine::GetTransitionTable()
+{
+  if (m_CurrentState.IsNull())
+    return nullptr;
+
+  if (m_TransitionTable == nullptr)
+  {
+    m_TransitionTable = std::make_shared<TransitionTable>();
+    m_CurrentStateIndex = -1;
+  }
+
+  if (m_CurrentStateIndex < 0)
+    m_CurrentStateIndex = m_TransitionTable->GetStateIndex(m_CurrentState);
+
+  return m_TransitionTable;
+}
+
+int mitk::EventStateMachine::FindExecutableTransition(TransitionTable &table, InteractionEvent *event)
+{
   // Get a list of all transitions that match the given event
-  const mitk::StateMachineState::TransitionVector transitionList =
-    m_CurrentState->GetTransitionList(event->GetNameOfClass(), MapToEventVariant(event));
+  const TransitionTable::Cell &cell =
+    table.GetCell(m_CurrentStateIndex, event->GetNameOfClass(), MapToEventVariant(event));
 
-  // if there are not transitions, we can return nullptr here.
-  if (transitionList.empty())
+  // if there are not transitions, we can return here.
+  if (cell.Transitions.empty())
   {
-    return nullptr;
+    return -1;
   }
 
-  StateMachineState::TransitionVector::const_iterator transitionIter;
-  ConditionVectorType::const_iterator conditionIter;
-  for (transitionIter = transitionList.cbegin(); transitionIter != transitionList.cend(); ++transitionIter)
+  // Conditions are evaluated at most once per event, as other transitions may need the same condition again
+  table.ConditionResults.assign(table.ConditionSlots.size(), -1);
+
+  for (const int transitionIndex : cell.Transitions)
   {
     bool allConditionsFulfilled(true);
 
-    // Get all conditions for the current transition
-    const ConditionVectorType conditions = (*transitionIter)->GetConditions();
-    for (conditionIter = conditions.cbegin(); conditionIter != conditions.cend(); ++conditionIter)
+    for (const auto &condition : table.Transitions[transitionIndex].Conditions)
     {
       bool currentConditionFulfilled(false);
 
-      // sequentially check all conditions that we have evaluated above
-      const std::string conditionName = (*conditionIter).GetConditionName();
-
       // Check if the condition has already been evaluated
-      if (conditionsMap.find(conditionName) == conditionsMap.cend())
+      if (table.ConditionResults[condition.Slot] < 0)
       {
-        // if the condition has not been evaluated yet, do it now and store
-        // the result in the map
+        // if the condition has not been evaluated yet, do it now and store the result
         try
         {
-          currentConditionFulfilled = CheckCondition((*conditionIter), event);
-          conditionsMap.insert(std::pair<std::string, bool>(conditionName, currentConditionFulfilled));
+          currentConditionFulfilled = CheckCondition(*condition.Definition, event);
+          table.ConditionResults[condition.Slot] = currentConditionFulfilled ? 1 : 0;
         }
         catch (const std::exception &e)
         {
@@ -295,12 +433,12 @@ mitk::StateMachineTransition *mitk::EventStateMachine::GetExecutableTransition(m
       else
       {
         // if the condition has been evaluated before, use that result
-        currentConditionFulfilled = conditionsMap[conditionName];
+        currentConditionFulfilled = table.ConditionResults[condition.Slot] != 0;
       }
 
       // set 'allConditionsFulfilled' under consideration of a possible
       // inversion of the condition
-      if (currentConditionFulfilled == (*conditionIter).IsInverted())
+      if (currentConditionFulfilled == condition.Definition->IsInverted())
       {
         allConditionsFulfilled = false;
         break;
@@ -310,17 +448,24 @@ mitk::StateMachineTransition *mitk::EventStateMachine::GetExecutableTransition(m
     // If all conditions are fulfilled, we execute this transition
     if (allConditionsFulfilled)
     {
-      return (*transitionIter);
+      return transitionIndex;
     }
   }
 
-  // We have found no transition that can be executed, return nullptr
-  return nullptr;
+  // We have found no transition that can be executed
+  return -1;
+}
+
+void mitk::EventStateMachine::InvalidateTransitionTable()
+{
+  m_TransitionTable = nullptr;
+  m_CurrentStateIndex = -1;
 }
 
 void mitk::EventStateMachine::ResetToStartState()
 {
   m_CurrentState = m_StateMachineContainer->GetStartState();
+  m_CurrentStateIndex = -1;
 }
 
 void mitk::EventStateMachine::SetMouseCursor(const char *xpm[], int hotspotX, int hotspotY)
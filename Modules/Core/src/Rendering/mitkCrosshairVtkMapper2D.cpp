@@ -67,7 +67,7 @@ void mitk::CrosshairVtkMapper2D::Update(mitk::BaseRenderer* renderer)
   }
 
   bool visible = true;
-  node->GetVisibility(visible, renderer, "visible");
+  node->GetVisibility(visible, renderer, PropertyKeys::Visible());
   if (!visible)
   {
     // Do not render crosshair for base renderer, if the
@@ -232,9 +232,9 @@ void mitk::CrosshairVtkMapper2D::ApplyColorAndOpacityProperties2D(BaseRenderer*
   DataNode* node = GetDataNode();
 
   // check for color prop and use it for rendering if it exists
-  node->GetColor(rgba, renderer, "color");
+  node->GetColor(rgba, renderer, PropertyKeys::Color());
   // check for opacity prop and use it for rendering if it exists
-  node->GetOpacity(rgba[3], renderer, "opacity");
+  node->GetOpacity(rgba[3], renderer, PropertyKeys::Opacity());
 
   double drgba[4] = { rgba[0], rgba[1], rgba[2], rgba[3] };
   actor->GetProperty()->SetColor(drgba);
@@ -134,7 +134,7 @@ float mitk::ImageVtkMapper2D::CalculateLayerDepth(mitk::BaseRenderer *renderer)
   // Due to a VTK bug, we cannot use the whole clipping range. /100 is empirically determined
   float depth = -maxRange * 0.01; // divide by 100
   int layer = 0;
-  GetDataNode()->GetIntProperty("layer", layer, renderer);
+  GetDataNode()->GetIntProperty(PropertyKeys::Layer(), layer, renderer);
   // add the layer property for each image to render images with a higher layer on top of the others
   depth += layer * 10; //*10: keep some room for each image (e.g. for ODFs in between)
   if (depth > 0.0f)
@@ -520,7 +520,7 @@ void mitk::ImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer)
     }
     else
     {
-      GetDataNode()->GetColor(rgb, renderer, "color");
+      GetDataNode()->GetColor(rgb, renderer, PropertyKeys::Color());
     }
   }
   if (binary && selected)
@@ -533,12 +533,12 @@ void mitk::ImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer)
     }
     else
     {
-      GetDataNode()->GetColor(rgb, renderer, "color");
+      GetDataNode()->GetColor(rgb, renderer, PropertyKeys::Color());
     }
   }
   if (!binary || (!hover && !selected))
   {
-    GetDataNode()->GetColor(rgb, renderer, "color");
+    GetDataNode()->GetColor(rgb, renderer, PropertyKeys::Color());
   }
 
   double rgbConv[3] = {(double)rgb[0], (double)rgb[1], (double)rgb[2]}; // conversion to double for VTK
@@ -674,7 +674,7 @@ void mitk::ImageVtkMapper2D::SetToInvalidState(mitk::ImageVtkMapper2D::LocalStor
 void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, PropertyKeys::Visible());
 
   if (!visible)
   {
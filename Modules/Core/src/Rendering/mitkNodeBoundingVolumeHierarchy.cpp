@@ -0,0 +1,256 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNodeBoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  typedef mitk::NodeBoundingVolumeHierarchy::BoundsType BoundsType;
+
+  BoundsType EmptyBounds()
+  {
+    const double max = std::numeric_limits<double>::max();
+    return { { max, -max, max, -max, max, -max } };
+  }
+
+  void Merge(BoundsType &bounds, const BoundsType &other)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      bounds[2 * i] = std::min(bounds[2 * i], other[2 * i]);
+      bounds[2 * i + 1] = std::max(bounds[2 * i + 1], other[2 * i + 1]);
+    }
+  }
+
+  bool IsValid(const BoundsType &bounds)
+  {
+    return bounds[0] <= bounds[1] && bounds[2] <= bounds[3] && bounds[4] <= bounds[5];
+  }
+
+  /** Slab test of the segment p0 + t * (p1 - p0), t in [0, 1], against the enlarged box. */
+  bool IntersectsSegment(const BoundsType &bounds, const mitk::Point3D &p0, const mitk::Point3D &p1, double tolerance)
+  {
+    double tMin = 0.0;
+    double tMax = 1.0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      const double lower = bounds[2 * i] - tolerance;
+      const double upper = bounds[2 * i + 1] + tolerance;
+      const double direction = p1[i] - p0[i];
+
+      // The segment is parallel to the slab if its extent along the axis is negligible compared
+      // to the extent of the box, which works for boxes of micrometer and of kilometer size
+      if (std::abs(direction) <= std::numeric_limits<double>::epsilon() * (upper - lower))
+      {
+        if (p0[i] < lower || p0[i] > upper)
+          return false;
+        continue;
+      }
+
+      double t0 = (lower - p0[i]) / direction;
+      double t1 = (upper - p0[i]) / direction;
+      if (t0 > t1)
+        std::swap(t0, t1);
+
+      tMin = std::max(tMin, t0);
+      tMax = std::min(tMax, t1);
+      if (tMin > tMax)
+        return false;
+    }
+    return true;
+  }
+}
+
+void mitk::NodeBoundingVolumeHierarchy::SetBounds(const DataNode *node, const BoundsType &bounds)
+{
+  if (!IsValid(bounds))
+  {
+    this->Remove(node);
+    return;
+  }
+
+  auto finding = m_ItemIndex.find(node);
+  if (finding == m_ItemIndex.end())
+  {
+    m_ItemIndex.emplace(node, m_Items.size());
+    m_Items.push_back({ node, bounds, -1 });
+    m_RebuildRequired = true;
+    return;
+  }
+
+  Item &item = m_Items[finding->second];
+  if (item.Bounds == bounds)
+    return;
+
+  item.Bounds = bounds;
+  if (!m_RebuildRequired && item.TreeNode >= 0)
+  {
+    m_Tree[item.TreeNode].Bounds = bounds;
+    this->Refit(m_Tree[item.TreeNode].Parent);
+  }
+}
+
+void mitk::NodeBoundingVolumeHierarchy::Remove(const DataNode *node)
+{
+  auto finding = m_ItemIndex.find(node);
+  if (finding == m_ItemIndex.end())
+    return;
+
+  const std::size_t index = finding->second;
+  m_ItemIndex.erase(finding);
+
+  if (index != m_Items.size() - 1)
+  {
+    m_Items[index] = m_Items.back();
+    m_ItemIndex[m_Items[index].Node] = index;
+  }
+  m_Items.pop_back();
+  m_RebuildRequired = true;
+}
+
+bool mitk::NodeBoundingVolumeHierarchy::Contains(const DataNode *node) const
+{
+  return m_ItemIndex.find(node) != m_ItemIndex.end();
+}
+
+void mitk::NodeBoundingVolumeHierarchy::Clear()
+{
+  m_Items.clear();
+  m_ItemIndex.clear();
+  m_Tree.clear();
+  m_RebuildRequired = false;
+}
+
+std::size_t mitk::NodeBoundingVolumeHierarchy::GetNumberOfNodes() const
+{
+  return m_Items.size();
+}
+
+mitk::NodeBoundingVolumeHierarchy::NodeListType mitk::NodeBoundingVolumeHierarchy::IntersectSegment(
+  const Point3D &p0, const Point3D &p1, double tolerance)
+{
+  NodeListType result;
+
+  if (m_RebuildRequired)
+    this->Build();
+
+  if (m_Tree.empty())
+    return result;
+
+  std::vector<int> stack;
+  stack.push_back(0);
+
+  while (!stack.empty())
+  {
+    const TreeNode &treeNode = m_Tree[stack.back()];
+    stack.pop_back();
+
+    if (!IntersectsSegment(treeNode.Bounds, p0, p1, tolerance))
+      continue;
+
+    if (treeNode.Item >= 0)
+    {
+      result.push_back(m_Items[treeNode.Item].Node);
+    }
+    else
+    {
+      stack.push_back(treeNode.Left);
+      stack.push_back(treeNode.Right);
+    }
+  }
+
+  return result;
+}
+
+void mitk::NodeBoundingVolumeHierarchy::Build()
+{
+  m_Tree.clear();
+  m_RebuildRequired = false;
+
+  if (m_Items.empty())
+    return;
+
+  m_Tree.reserve(2 * m_Items.size() - 1);
+
+  std::vector<int> itemIds(m_Items.size());
+  for (std::size_t i = 0; i < m_Items.size(); ++i)
+    itemIds[i] = static_cast<int>(i);
+
+  this->BuildRange(itemIds, 0, itemIds.size(), -1);
+}
+
+int mitk::NodeBoundingVolumeHierarchy::BuildRange(std::vector<int> &itemIds, std::size_t begin, std::size_t end, int parent)
+{
+  const int treeNodeId = static_cast<int>(m_Tree.size());
+  m_Tree.push_back({ EmptyBounds(), parent, -1, -1, -1 });
+
+  if (end - begin == 1)
+  {
+    Item &item = m_Items[itemIds[begin]];
+    item.TreeNode = treeNodeId;
+    m_Tree[treeNodeId].Bounds = item.Bounds;
+    m_Tree[treeNodeId].Item = itemIds[begin];
+    return treeNodeId;
+  }
+
+  // Split at the median of the box centers along the axis of largest center extent
+  BoundsType centerBounds = EmptyBounds();
+  for (std::size_t i = begin; i < end; ++i)
+  {
+    const BoundsType &bounds = m_Items[itemIds[i]].Bounds;
+    BoundsType center;
+    for (int d = 0; d < 3; ++d)
+      center[2 * d] = center[2 * d + 1] = 0.5 * (bounds[2 * d] + bounds[2 * d + 1]);
+    Merge(centerBounds, center);
+  }
+
+  int axis = 0;
+  for (int d = 1; d < 3; ++d)
+  {
+    if (centerBounds[2 * d + 1] - centerBounds[2 * d] > centerBounds[2 * axis + 1] - centerBounds[2 * axis])
+      axis = d;
+  }
+
+  const std::size_t middle = begin + (end - begin) / 2;
+  std::nth_element(itemIds.begin() + begin, itemIds.begin() + middle, itemIds.begin() + end, [this, axis](int a, int b) {
+    const BoundsType &boundsA = m_Items[a].Bounds;
+    const BoundsType &boundsB = m_Items[b].Bounds;
+    return boundsA[2 * axis] + boundsA[2 * axis + 1] < boundsB[2 * axis] + boundsB[2 * axis + 1];
+  });
+
+  const int left = this->BuildRange(itemIds, begin, middle, treeNodeId);
+  const int right = this->BuildRange(itemIds, middle, end, treeNodeId);
+
+  TreeNode &treeNode = m_Tree[treeNodeId];
+  treeNode.Left = left;
+  treeNode.Right = right;
+  treeNode.Bounds = m_Tree[left].Bounds;
+  Merge(treeNode.Bounds, m_Tree[right].Bounds);
+
+  return treeNodeId;
+}
+
+void mitk::NodeBoundingVolumeHierarchy::Refit(int treeNode)
+{
+  while (treeNode >= 0)
+  {
+    TreeNode &node = m_Tree[treeNode];
+    node.Bounds = m_Tree[node.Left].Bounds;
+    Merge(node.Bounds, m_Tree[node.Right].Bounds);
+    treeNode = node.Parent;
+  }
+}
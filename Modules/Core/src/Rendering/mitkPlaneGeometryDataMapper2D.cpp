@@ -229,7 +229,7 @@ void mitk::PlaneGeometryDataMapper2D::CreateVtkCrosshair(mitk::BaseRenderer *ren
   ls->m_ArrowActor->SetVisibility(0);
   ls->m_CrosshairHelperLineActor->SetVisibility(0);
 
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, PropertyKeys::Visible());
 
   if (!visible)
   {
@@ -612,9 +612,9 @@ void mitk::PlaneGeometryDataMapper2D::ApplyColorAndOpacityProperties2D(BaseRende
   DataNode *node = GetDataNode();
 
   // check for color prop and use it for rendering if it exists
-  node->GetColor(rgba, renderer, "color");
+  node->GetColor(rgba, renderer, PropertyKeys::Color());
   // check for opacity prop and use it for rendering if it exists
-  node->GetOpacity(rgba[3], renderer, "opacity");
+  node->GetOpacity(rgba[3], renderer, PropertyKeys::Opacity());
 
   double drgba[4] = {rgba[0], rgba[1], rgba[2], rgba[3]};
   actor->GetProperty()->SetColor(drgba);
@@ -201,7 +201,7 @@ namespace mitk
     m_ImageAssembly->GetParts()->RemoveAllItems();
 
     bool visible = true;
-    GetDataNode()->GetVisibility(visible, renderer, "visible");
+    GetDataNode()->GetVisibility(visible, renderer, PropertyKeys::Visible());
 
     if (!visible)
     {
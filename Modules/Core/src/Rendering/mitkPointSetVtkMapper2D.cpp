@@ -294,175 +294,225 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
   const mitk::PlaneGeometry *geo2D = renderer->GetCurrentWorldPlaneGeometry();
   double resolution = GetScreenResolution(renderer);
 
-  vtkLinearTransform *dataNodeTransform = input->GetGeometry()->GetVtkTransform();
-
   int count = 0;
 
-  for (pointsIter = itkPointSet->GetPoints()->Begin(); pointsIter != itkPointSet->GetPoints()->End(); pointsIter++)
-  {
-    lastP = p;              // valid for number of points count > 0
-    preLastPt2d = lastPt2d; // valid only for count > 1
-    lastPt2d = pt2d;        // valid for number of points count > 0
-
-    lastVec = vec; // valid only for counter > 1
+  vtkLinearTransform *dataNodeTransform = input->GetGeometry(timestep)->GetVtkTransform();
 
-    // get current point in point set
-    point = pointsIter->Value();
-
-    // transform point
+  // adds the marker and the label of a point close to the current plane
+  auto addMarker = [&](const itk::Point<ScalarType> &point,
+                       const mitk::Point2D &pt2d,
+                       float dist,
+                       bool selected,
+                       mitk::PointSet::PointIdentifier id) {
+    // is point selected or not?
+    if (selected)
+    {
+      ls->m_SelectedPoints->InsertNextPoint(point[0], point[1], point[2]);
+      // point is scaled according to its distance to the plane
+      ls->m_SelectedScales->InsertNextTuple3(
+          std::max(0.0f, m_Point2DSize - (2 * dist)), 0, 0);
+    }
+    else
     {
-      float vtkp[3];
-      itk2vtk(point, vtkp);
-      dataNodeTransform->TransformPoint(vtkp, vtkp);
-      vtk2itk(vtkp, point);
+      ls->m_UnselectedPoints->InsertNextPoint(point[0], point[1], point[2]);
+      // point is scaled according to its distance to the plane
+      ls->m_UnselectedScales->InsertNextTuple3(
+          std::max(0.0f, m_Point2DSize - (2 * dist)), 0, 0);
     }
 
-    p[0] = point[0];
-    p[1] = point[1];
-    p[2] = point[2];
+    //---- LABEL -----//
+    // paint label for each point if available
+    if (dynamic_cast<mitk::StringProperty *>(this->GetDataNode()->GetProperty("label")) != nullptr)
+    {
+      const char *pointLabel =
+        dynamic_cast<mitk::StringProperty *>(this->GetDataNode()->GetProperty("label"))->GetValue();
+      std::string l = pointLabel;
+      if (input->GetSize() > 1)
+      {
+        std::stringstream ss;
+        ss << id;
+        l.append(ss.str());
+      }
 
-    renderer->WorldToDisplay(p, pt2d);
+      ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
 
-    vec = p - lastP; // valid only for counter > 0
+      ls->m_VtkTextActor->SetDisplayPosition(pt2d[0] + text2dDistance, pt2d[1] + text2dDistance);
+      ls->m_VtkTextActor->SetInput(l.c_str());
+      ls->m_VtkTextActor->GetTextProperty()->SetOpacity(100);
 
-    // compute distance to current plane
-    float dist = geo2D->Distance(point);
-    // measure distance in screen pixel units if requested
-    if (m_FixedSizeOnScreen)
-    {
-      dist /= resolution;
+      float unselectedColor[4] = {1.0, 1.0, 0.0, 1.0};
+
+      // check if there is a color property
+      GetDataNode()->GetColor(unselectedColor);
+
+      ls->m_VtkTextActor->GetTextProperty()->SetColor(unselectedColor[0], unselectedColor[1], unselectedColor[2]);
+
+      ls->m_VtkTextLabelActors.push_back(ls->m_VtkTextActor);
     }
+  };
+
+  auto transformPoint = [dataNodeTransform](itk::Point<ScalarType> &point) {
+    float vtkp[3];
+    itk2vtk(point, vtkp);
+    dataNodeTransform->TransformPoint(vtkp, vtkp);
+    vtk2itk(vtkp, point);
+  };
+
+  // Without contour only the markers of points close to the current plane are drawn.
+  // These points are looked up in the spatial index of the point set instead of
+  // visiting all points, which matters for large point clouds.
+  if (!m_ShowContour)
+  {
+    // the slab is slightly enlarged, the exact distance is checked below
+    ScalarType halfThickness = m_FixedSizeOnScreen ? m_DistanceToPlane * resolution : m_DistanceToPlane;
+    halfThickness = halfThickness * (1.0 + mitk::eps) + mitk::eps;
 
-    // draw markers on slices a certain distance away from the points
-    // location according to the tolerance threshold (m_DistanceToPlane)
-    if (dist < m_DistanceToPlane)
+    const mitk::PointSet::PointIdentifierListType ids =
+      input->SearchPointsInSlab(geo2D->GetOrigin(), geo2D->GetNormal(), halfThickness, timestep);
+
+    for (const auto id : ids)
     {
-      // is point selected or not?
-      if (pointDataIter->Value().selected)
+      itkPointSet->GetPoint(id, &point);
+      transformPoint(point);
+
+      float dist = geo2D->Distance(point);
+      if (m_FixedSizeOnScreen)
       {
-        ls->m_SelectedPoints->InsertNextPoint(point[0], point[1], point[2]);
-        // point is scaled according to its distance to the plane
-        ls->m_SelectedScales->InsertNextTuple3(
-            std::max(0.0f, m_Point2DSize - (2 * dist)), 0, 0);
+        dist /= resolution;
       }
-      else
+
+      if (dist < m_DistanceToPlane)
       {
-        ls->m_UnselectedPoints->InsertNextPoint(point[0], point[1], point[2]);
-        // point is scaled according to its distance to the plane
-        ls->m_UnselectedScales->InsertNextTuple3(
-            std::max(0.0f, m_Point2DSize - (2 * dist)), 0, 0);
+        p[0] = point[0];
+        p[1] = point[1];
+        p[2] = point[2];
+        renderer->WorldToDisplay(p, pt2d);
+
+        mitk::PointSet::PointDataType pointData = {0, false, mitk::PTUNDEFINED};
+        itkPointSet->GetPointData(id, &pointData);
+        addMarker(point, pt2d, dist, pointData.selected, id);
       }
+    }
+  }
+  else
+  {
+    for (pointsIter = itkPointSet->GetPoints()->Begin(); pointsIter != itkPointSet->GetPoints()->End(); pointsIter++)
+    {
+      lastP = p;              // valid for number of points count > 0
+      preLastPt2d = lastPt2d; // valid only for count > 1
+      lastPt2d = pt2d;        // valid for number of points count > 0
 
-      //---- LABEL -----//
-      // paint label for each point if available
-      if (dynamic_cast<mitk::StringProperty *>(this->GetDataNode()->GetProperty("label")) != nullptr)
-      {
-        const char *pointLabel =
-          dynamic_cast<mitk::StringProperty *>(this->GetDataNode()->GetProperty("label"))->GetValue();
-        std::string l = pointLabel;
-        if (input->GetSize() > 1)
-        {
-          std::stringstream ss;
-          ss << pointsIter->Index();
-          l.append(ss.str());
-        }
+      lastVec = vec; // valid only for counter > 1
 
-        ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
+      // get current point in point set
+      point = pointsIter->Value();
 
-        ls->m_VtkTextActor->SetDisplayPosition(pt2d[0] + text2dDistance, pt2d[1] + text2dDistance);
-        ls->m_VtkTextActor->SetInput(l.c_str());
-        ls->m_VtkTextActor->GetTextProperty()->SetOpacity(100);
+      // transform point
+      transformPoint(point);
 
-        float unselectedColor[4] = {1.0, 1.0, 0.0, 1.0};
+      p[0] = point[0];
+      p[1] = point[1];
+      p[2] = point[2];
 
-        // check if there is a color property
-        GetDataNode()->GetColor(unselectedColor);
+      renderer->WorldToDisplay(p, pt2d);
 
-        ls->m_VtkTextActor->GetTextProperty()->SetColor(unselectedColor[0], unselectedColor[1], unselectedColor[2]);
+      vec = p - lastP; // valid only for counter > 0
 
-        ls->m_VtkTextLabelActors.push_back(ls->m_VtkTextActor);
+      // compute distance to current plane
+      float dist = geo2D->Distance(point);
+      // measure distance in screen pixel units if requested
+      if (m_FixedSizeOnScreen)
+      {
+        dist /= resolution;
       }
-    }
-
-    // draw contour, distance text and angle text in render window
 
-    // lines between points, which intersect the current plane, are drawn
-    if (m_ShowContour && count > 0)
-    {
-      ScalarType distance = renderer->GetCurrentWorldPlaneGeometry()->SignedDistance(point);
-      ScalarType lastDistance = renderer->GetCurrentWorldPlaneGeometry()->SignedDistance(lastP);
+      // draw markers on slices a certain distance away from the points
+      // location according to the tolerance threshold (m_DistanceToPlane)
+      if (dist < m_DistanceToPlane)
+      {
+        addMarker(point, pt2d, dist, pointDataIter->Value().selected, pointsIter->Index());
+      }
 
-      pointsOnSameSideOfPlane = (distance * lastDistance) > 0.5;
+      // draw contour, distance text and angle text in render window
 
-      // Points must be on different side of plane in order to draw a contour.
-      // If "show distant lines" is enabled this condition is disregarded.
-      if (!pointsOnSameSideOfPlane || m_ShowDistantLines)
+      // lines between points, which intersect the current plane, are drawn
+      if (m_ShowContour && count > 0)
       {
-        vtkSmartPointer<vtkLine> line = vtkSmartPointer<vtkLine>::New();
+        ScalarType distance = renderer->GetCurrentWorldPlaneGeometry()->SignedDistance(point);
+        ScalarType lastDistance = renderer->GetCurrentWorldPlaneGeometry()->SignedDistance(lastP);
 
-        ls->m_ContourPoints->InsertNextPoint(lastP[0], lastP[1], lastP[2]);
-        line->GetPointIds()->SetId(0, NumberContourPoints);
-        NumberContourPoints++;
+        pointsOnSameSideOfPlane = (distance * lastDistance) > 0.5;
 
-        ls->m_ContourPoints->InsertNextPoint(point[0], point[1], point[2]);
-        line->GetPointIds()->SetId(1, NumberContourPoints);
-        NumberContourPoints++;
+        // Points must be on different side of plane in order to draw a contour.
+        // If "show distant lines" is enabled this condition is disregarded.
+        if (!pointsOnSameSideOfPlane || m_ShowDistantLines)
+        {
+          vtkSmartPointer<vtkLine> line = vtkSmartPointer<vtkLine>::New();
 
-        ls->m_ContourLines->InsertNextCell(line);
+          ls->m_ContourPoints->InsertNextPoint(lastP[0], lastP[1], lastP[2]);
+          line->GetPointIds()->SetId(0, NumberContourPoints);
+          NumberContourPoints++;
 
-        if (m_ShowDistances) // calculate and print distance between adjacent points
-        {
-          float distancePoints = point.EuclideanDistanceTo(lastP);
+          ls->m_ContourPoints->InsertNextPoint(point[0], point[1], point[2]);
+          line->GetPointIds()->SetId(1, NumberContourPoints);
+          NumberContourPoints++;
 
-          std::stringstream buffer;
-          buffer << std::fixed << std::setprecision(m_DistancesDecimalDigits) << distancePoints << " mm";
+          ls->m_ContourLines->InsertNextCell(line);
 
-          // compute desired display position of text
-          Vector2D vec2d = pt2d - lastPt2d;
-          makePerpendicularVector2D(vec2d,
-                                    vec2d); // text is rendered within text2dDistance perpendicular to current line
-          Vector2D pos2d = (lastPt2d.GetVectorFromOrigin() + pt2d.GetVectorFromOrigin()) * 0.5 + vec2d * text2dDistance;
+          if (m_ShowDistances) // calculate and print distance between adjacent points
+          {
+            float distancePoints = point.EuclideanDistanceTo(lastP);
 
-          ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
+            std::stringstream buffer;
+            buffer << std::fixed << std::setprecision(m_DistancesDecimalDigits) << distancePoints << " mm";
 
-          ls->m_VtkTextActor->SetDisplayPosition(pos2d[0], pos2d[1]);
-          ls->m_VtkTextActor->SetInput(buffer.str().c_str());
-          ls->m_VtkTextActor->GetTextProperty()->SetColor(0.0, 1.0, 0.0);
+            // compute desired display position of text
+            Vector2D vec2d = pt2d - lastPt2d;
+            makePerpendicularVector2D(vec2d,
+                                      vec2d); // text is rendered within text2dDistance perpendicular to current line
+            Vector2D pos2d = (lastPt2d.GetVectorFromOrigin() + pt2d.GetVectorFromOrigin()) * 0.5 + vec2d * text2dDistance;
 
-          ls->m_VtkTextDistanceActors.push_back(ls->m_VtkTextActor);
-        }
+            ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
 
-        if (m_ShowAngles && count > 1) // calculate and print angle between connected lines
-        {
-          std::stringstream buffer;
-          buffer << angle(vec.GetVnlVector(), -lastVec.GetVnlVector()) * 180 / vnl_math::pi << "°";
+            ls->m_VtkTextActor->SetDisplayPosition(pos2d[0], pos2d[1]);
+            ls->m_VtkTextActor->SetInput(buffer.str().c_str());
+            ls->m_VtkTextActor->GetTextProperty()->SetColor(0.0, 1.0, 0.0);
+
+            ls->m_VtkTextDistanceActors.push_back(ls->m_VtkTextActor);
+          }
 
-          // compute desired display position of text
-          Vector2D vec2d = pt2d - lastPt2d; // first arm enclosing the angle
-          vec2d.Normalize();
-          Vector2D lastVec2d = lastPt2d - preLastPt2d; // second arm enclosing the angle
-          lastVec2d.Normalize();
-          vec2d = vec2d - lastVec2d; // vector connecting both arms
-          vec2d.Normalize();
+          if (m_ShowAngles && count > 1) // calculate and print angle between connected lines
+          {
+            std::stringstream buffer;
+            buffer << angle(vec.GetVnlVector(), -lastVec.GetVnlVector()) * 180 / vnl_math::pi << "°";
 
-          // middle between two vectors that enclose the angle
-          Vector2D pos2d = lastPt2d.GetVectorFromOrigin() + vec2d * text2dDistance * text2dDistance;
+            // compute desired display position of text
+            Vector2D vec2d = pt2d - lastPt2d; // first arm enclosing the angle
+            vec2d.Normalize();
+            Vector2D lastVec2d = lastPt2d - preLastPt2d; // second arm enclosing the angle
+            lastVec2d.Normalize();
+            vec2d = vec2d - lastVec2d; // vector connecting both arms
+            vec2d.Normalize();
 
-          ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
+            // middle between two vectors that enclose the angle
+            Vector2D pos2d = lastPt2d.GetVectorFromOrigin() + vec2d * text2dDistance * text2dDistance;
 
-          ls->m_VtkTextActor->SetDisplayPosition(pos2d[0], pos2d[1]);
-          ls->m_VtkTextActor->SetInput(buffer.str().c_str());
-          ls->m_VtkTextActor->GetTextProperty()->SetColor(0.0, 1.0, 0.0);
+            ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
 
-          ls->m_VtkTextAngleActors.push_back(ls->m_VtkTextActor);
+            ls->m_VtkTextActor->SetDisplayPosition(pos2d[0], pos2d[1]);
+            ls->m_VtkTextActor->SetInput(buffer.str().c_str());
+            ls->m_VtkTextActor->GetTextProperty()->SetColor(0.0, 1.0, 0.0);
+
+            ls->m_VtkTextAngleActors.push_back(ls->m_VtkTextActor);
+          }
         }
       }
-    }
 
-    if (pointDataIter != itkPointSet->GetPointData()->End())
-    {
-      pointDataIter++;
-      count++;
+      if (pointDataIter != itkPointSet->GetPointData()->End())
+      {
+        pointDataIter++;
+        count++;
+      }
     }
   }
 
@@ -610,7 +660,7 @@ void mitk::PointSetVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rend
 
   // toggle visibility
   bool visible = true;
-  node->GetVisibility(visible, renderer, "visible");
+  node->GetVisibility(visible, renderer, PropertyKeys::Visible());
   if (!visible)
   {
     ls->m_UnselectedActor->VisibilityOff();
@@ -28,7 +28,6 @@ found in the LICENSE file.
 #include <vtkActor.h>
 #include <vtkArrowSource.h>
 #include <vtkAssembly.h>
-#include <vtkCutter.h>
 #include <vtkGlyph3D.h>
 #include <vtkLookupTable.h>
 #include <vtkPlane.h>
@@ -36,6 +35,7 @@ found in the LICENSE file.
 #include <vtkPolyData.h>
 #include <vtkReverseSense.h>
 #include <vtkTransformPolyDataFilter.h>
+#include <vtkMitkSlabPlaneCutter.h>
 
 // constructor LocalStorage
 mitk::SurfaceVtkMapper2D::LocalStorage::LocalStorage()
@@ -46,8 +46,10 @@ mitk::SurfaceVtkMapper2D::LocalStorage::LocalStorage()
   m_PropAssembly = vtkSmartPointer<vtkAssembly>::New();
   m_PropAssembly->AddPart(m_Actor);
   m_CuttingPlane = vtkSmartPointer<vtkPlane>::New();
-  m_Cutter = vtkSmartPointer<vtkCutter>::New();
-  m_Cutter->SetCutFunction(m_CuttingPlane);
+  m_Transform = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
+  m_Cutter = vtkSmartPointer<vtkMitkSlabPlaneCutter>::New();
+  m_Cutter->SetPlane(m_CuttingPlane);
+  m_Cutter->SetInputConnection(m_Transform->GetOutputPort());
   m_Mapper->SetInputConnection(m_Cutter->GetOutputPort());
 
   m_NormalGlyph = vtkSmartPointer<vtkGlyph3D>::New();
@@ -131,7 +133,7 @@ void mitk::SurfaceVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   }
 
   bool visible = true;
-  node->GetVisibility(visible, renderer, "visible");
+  node->GetVisibility(visible, renderer, PropertyKeys::Visible());
 
   if (!visible)
   {
@@ -227,11 +229,11 @@ void mitk::SurfaceVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rende
   localStorage->m_CuttingPlane->SetNormal(normal);
   // Transform the data according to its geometry.
   // See UpdateVtkTransform documentation for details.
+  // The filters are kept in the local storage, so the transformed data and the
+  // cell index of the cutter are only recomputed if the data or its geometry changed.
   vtkSmartPointer<vtkLinearTransform> vtktransform = GetDataNode()->GetVtkTransform(this->GetTimestep());
-  vtkSmartPointer<vtkTransformPolyDataFilter> filter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-  filter->SetTransform(vtktransform);
-  filter->SetInputData(inputPolyData);
-  localStorage->m_Cutter->SetInputConnection(filter->GetOutputPort());
+  localStorage->m_Transform->SetTransform(vtktransform);
+  localStorage->m_Transform->SetInputData(inputPolyData);
   localStorage->m_Cutter->Update();
 
   bool generateNormals = false;
@@ -57,7 +57,7 @@ void mitk::SurfaceVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *rende
   LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
 
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, PropertyKeys::Visible());
 
   if (!visible)
   {
@@ -457,6 +457,12 @@ vtkProp *mitk::SurfaceVtkMapper3D::GetVtkProp(mitk::BaseRenderer *renderer)
   return ls->m_Actor;
 }
 
+bool mitk::SurfaceVtkMapper3D::DependsOnOtherNodes() const
+{
+  const auto *node = this->GetDataNode();
+  return node != nullptr && node->GetProperty("Surface.Texture") != nullptr;
+}
+
 void mitk::SurfaceVtkMapper3D::CheckForClippingProperty(mitk::BaseRenderer *renderer, mitk::BaseProperty *property)
 {
   LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include "mitkMapper.h"
 #include "mitkPlaneGeometryDataVtkMapper3D.h"
 #include "mitkVtkMapper.h"
+#include "vtkMitkRenderProp.h"
 
 #include <mitkAbstractTransformGeometry.h>
 #include <mitkGeometry3D.h>
@@ -30,6 +31,10 @@ found in the LICENSE file.
 #include <mitkSurface.h>
 #include <mitkVtkInteractorStyle.h>
 
+// STL
+#include <algorithm>
+#include <map>
+
 // VTK
 #include <vtkAssemblyNode.h>
 #include <vtkAssemblyPath.h>
@@ -41,8 +46,10 @@ found in the LICENSE file.
 #include <vtkLightKit.h>
 #include <vtkLinearTransform.h>
 #include <vtkMapper.h>
+#include <vtkPicker.h>
 #include <vtkPointPicker.h>
 #include <vtkProp.h>
+#include <vtkPropCollection.h>
 #include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
 #include <vtkRenderer.h>
@@ -114,6 +121,8 @@ mitk::VtkPropRenderer::~VtkPropRenderer()
     m_CellPicker->Delete();
   if (m_TextRenderer != nullptr)
     m_TextRenderer->Delete();
+
+  this->RemoveDataStorageListeners();
 }
 
 void mitk::VtkPropRenderer::SetDataStorage(mitk::DataStorage *storage)
@@ -121,7 +130,10 @@ void mitk::VtkPropRenderer::SetDataStorage(mitk::DataStorage *storage)
   if (storage == nullptr || storage == m_DataStorage)
     return;
 
+  this->RemoveDataStorageListeners();
   BaseRenderer::SetDataStorage(storage);
+  this->AddDataStorageListeners();
+  this->RebuildRenderList();
 
   static_cast<mitk::PlaneGeometryDataVtkMapper3D *>(m_CurrentWorldPlaneGeometryMapper.GetPointer())
     ->SetDataStorageForTexture(m_DataStorage.GetPointer());
@@ -192,23 +204,61 @@ int mitk::VtkPropRenderer::Render(mitk::VtkPropRenderer::RenderType type)
 }
 
 /*!
-\brief PrepareMapperQueue iterates the datatree
+\brief PrepareMapperQueue iterates the render list
 
-PrepareMapperQueue iterates the datatree in order to find mappers which shall be rendered. Also, it sortes the mappers
-wrt to their layer.
+PrepareMapperQueue iterates the render list in order to find mappers which shall be rendered. Also, it sortes the mappers
+wrt to their layer. Cached visibility and layer values are only refreshed for modified nodes and the sorted
+mapper map is only rebuilt if a node was added or removed or its layer or mapper changed.
 */
 void mitk::VtkPropRenderer::PrepareMapperQueue()
 {
   // variable for counting LOD-enabled mappers
   m_NumberOfVisibleLODEnabledMappers = 0;
 
-  // Do we have to update the mappers ?
-  if (m_LastUpdateTime < GetMTime() || m_LastUpdateTime < this->GetCurrentWorldPlaneGeometry()->GetMTime())
+  if (m_RenderListMapperID != m_MapperID)
   {
-    Update();
+    for (auto &entry : m_RenderList)
+    {
+      entry.PropertiesValid = false;
+      entry.UpdateValid = false;
+    }
+    m_RenderListMapperID = m_MapperID;
   }
-  else if (m_MapperID >= 1 && m_MapperID < 6)
+
+  // Mappers may depend on the zoom level or the size of the viewport, so changes of the
+  // camera require an update of all mappers, like changes of the renderer or its geometry
+  const int *viewportSize = this->GetViewportSize();
+  const ScalarType scaleFactor = this->GetScaleFactorMMPerDisplayUnit();
+  const bool viewChanged = viewportSize[0] != m_LastUpdateViewportSize[0] ||
+                           viewportSize[1] != m_LastUpdateViewportSize[1] || scaleFactor != m_LastUpdateScaleFactor;
+  m_LastUpdateViewportSize[0] = viewportSize[0];
+  m_LastUpdateViewportSize[1] = viewportSize[1];
+  m_LastUpdateScaleFactor = scaleFactor;
+
+  // Do we have to update all mappers or only the ones of modified nodes?
+  if (m_LastUpdateTime < GetMTime() || m_LastUpdateTime < this->GetCurrentWorldPlaneGeometry()->GetMTime() ||
+      m_LastUpdateTime < this->GetCameraController()->GetMTime() || viewChanged)
+  {
     Update();
+  }
+  else
+  {
+    for (auto &entry : m_RenderList)
+    {
+      const Mapper *mapper = entry.Node->GetMapper(m_MapperID);
+      if (mapper == nullptr)
+        continue;
+
+      if (!entry.UpdateValid || mapper->DependsOnOtherNodes() || entry.UpdateTime < entry.Node->GetMTime(this) ||
+          entry.UpdateTime < mapper->GetMTime() || entry.UpdateTime < this->GetTimeStepUpdateTime())
+      {
+        this->Update(entry.Node);
+        entry.UpdateTime.Modified();
+        entry.UpdateValid = true;
+        this->InvalidatePickingBounds(entry);
+      }
+    }
+  }
 
   // remove all text properties before mappers will add new ones
   m_TextRenderer->RemoveAllViewProps();
@@ -219,44 +269,175 @@ void mitk::VtkPropRenderer::PrepareMapperQueue()
   }
   m_TextCollection.clear();
 
-  // clear priority_queue
-  m_MappersMap.clear();
-
-  int mapperNo = 0;
-
   // DataStorage
   if (m_DataStorage.IsNull())
+  {
+    m_MappersMap.clear();
     return;
+  }
 
-  DataStorage::SetOfObjects::ConstPointer allObjects = m_DataStorage->GetAll();
-
-  for (DataStorage::SetOfObjects::ConstIterator it = allObjects->Begin(); it != allObjects->End(); ++it)
+  for (auto &entry : m_RenderList)
   {
-    const DataNode::Pointer node = it->Value();
-    if (node.IsNull())
-      continue;
-    const mitk::Mapper::Pointer mapper = node->GetMapper(m_MapperID);
+    Mapper *mapper = entry.Node->GetMapper(m_MapperID);
 
-    if (mapper.IsNull())
+    if (mapper != entry.NodeMapper)
+    {
+      entry.NodeMapper = mapper;
+      entry.PropertiesValid = false;
+      m_MappersMapOutdated = true;
+    }
+
+    if (mapper == nullptr)
       continue;
 
-    bool visible = true;
-    node->GetVisibility(visible, this, "visible");
+    if (!entry.PropertiesValid || entry.PropertiesTime < entry.Node->GetMTime(this) ||
+        entry.PropertiesTime < mapper->GetMTime())
+    {
+      entry.Visible = true;
+      entry.Node->GetVisibility(entry.Visible, this, PropertyKeys::Visible());
+      entry.LODEnabled = mapper->IsLODEnabled(this);
+
+      // mapper without a layer property get layer number 1
+      int layer = 1;
+      entry.Node->GetIntProperty(PropertyKeys::Layer(), layer, this);
+      if (layer != entry.Layer)
+      {
+        entry.Layer = layer;
+        m_MappersMapOutdated = true;
+      }
+
+      entry.PropertiesTime.Modified();
+      entry.PropertiesValid = true;
+    }
 
     // The information about LOD-enabled mappers is required by RenderingManager
-    if (mapper->IsLODEnabled(this) && visible)
+    if (entry.LODEnabled && entry.Visible)
     {
       ++m_NumberOfVisibleLODEnabledMappers;
     }
-    // mapper without a layer property get layer number 1
-    int layer = 1;
-    node->GetIntProperty("layer", layer, this);
-    int nr = (layer << 16) + mapperNo;
-    m_MappersMap.insert(std::pair<int, Mapper *>(nr, mapper));
-    mapperNo++;
+  }
+
+  if (m_MappersMapOutdated)
+  {
+    m_MappersMap.clear();
+
+    // Mappers of the same layer are rendered in the order of DataStorage::GetAll(), so the
+    // render list is brought into this order (which only changes if nodes are added or removed)
+    DataStorage::SetOfObjects::ConstPointer allObjects = m_DataStorage->GetAll();
+    std::map<const DataNode *, unsigned int> nodeOrder;
+    for (DataStorage::SetOfObjects::ConstIterator it = allObjects->Begin(); it != allObjects->End(); ++it)
+    {
+      nodeOrder.emplace(it->Value().GetPointer(), static_cast<unsigned int>(nodeOrder.size()));
+    }
+    std::stable_sort(m_RenderList.begin(), m_RenderList.end(),
+      [&nodeOrder](const RenderListEntry &a, const RenderListEntry &b) {
+        auto orderA = nodeOrder.find(a.Node);
+        auto orderB = nodeOrder.find(b.Node);
+        return (orderA != nodeOrder.end() ? orderA->second : nodeOrder.size()) <
+               (orderB != nodeOrder.end() ? orderB->second : nodeOrder.size());
+      });
+
+    int mapperNo = 0;
+    for (const auto &entry : m_RenderList)
+    {
+      if (entry.NodeMapper == nullptr)
+        continue;
+
+      int nr = (entry.Layer << 16) + mapperNo;
+      m_MappersMap.insert(std::pair<int, Mapper *>(nr, entry.NodeMapper));
+      mapperNo++;
+    }
+
+    m_MappersMapOutdated = false;
   }
 }
 
+void mitk::VtkPropRenderer::RebuildRenderList()
+{
+  m_RenderList.clear();
+  m_PickingHierarchy.Clear();
+  m_PickingHierarchyOutdated = true;
+  m_MappersMapOutdated = true;
+
+  if (m_DataStorage.IsNull())
+    return;
+
+  DataStorage::SetOfObjects::ConstPointer allObjects = m_DataStorage->GetAll();
+
+  for (DataStorage::SetOfObjects::ConstIterator it = allObjects->Begin(); it != allObjects->End(); ++it)
+  {
+    this->OnNodeAdded(it->Value());
+  }
+}
+
+void mitk::VtkPropRenderer::OnNodeAdded(const DataNode *node)
+{
+  if (node == nullptr)
+    return;
+
+  RenderListEntry entry;
+  entry.Node = const_cast<DataNode *>(node);
+  m_RenderList.push_back(entry);
+  m_MappersMapOutdated = true;
+  m_PickingHierarchyOutdated = true;
+}
+
+void mitk::VtkPropRenderer::OnNodeRemoved(const DataNode *node)
+{
+  auto finding = std::find_if(m_RenderList.begin(), m_RenderList.end(), [node](const RenderListEntry &entry) {
+    return entry.Node == node;
+  });
+
+  if (finding != m_RenderList.end())
+  {
+    m_RenderList.erase(finding);
+    m_PickingHierarchy.Remove(node);
+    m_MappersMapOutdated = true;
+  }
+}
+
+void mitk::VtkPropRenderer::OnNodeChanged(const DataNode *node)
+{
+  auto finding = std::find_if(m_RenderList.begin(), m_RenderList.end(), [node](const RenderListEntry &entry) {
+    return entry.Node == node;
+  });
+
+  if (finding != m_RenderList.end())
+    this->InvalidatePickingBounds(*finding);
+}
+
+void mitk::VtkPropRenderer::InvalidatePickingBounds(RenderListEntry &entry)
+{
+  entry.PickingValid = false;
+  m_PickingHierarchyOutdated = true;
+}
+
+void mitk::VtkPropRenderer::AddDataStorageListeners()
+{
+  if (m_DataStorage.IsNull())
+    return;
+
+  m_DataStorage->AddNodeEvent.AddListener(
+    MessageDelegate1<VtkPropRenderer, const DataNode *>(this, &VtkPropRenderer::OnNodeAdded));
+  m_DataStorage->RemoveNodeEvent.AddListener(
+    MessageDelegate1<VtkPropRenderer, const DataNode *>(this, &VtkPropRenderer::OnNodeRemoved));
+  m_DataStorage->ChangedNodeEvent.AddListener(
+    MessageDelegate1<VtkPropRenderer, const DataNode *>(this, &VtkPropRenderer::OnNodeChanged));
+}
+
+void mitk::VtkPropRenderer::RemoveDataStorageListeners()
+{
+  if (m_DataStorage.IsNull())
+    return;
+
+  m_DataStorage->AddNodeEvent.RemoveListener(
+    MessageDelegate1<VtkPropRenderer, const DataNode *>(this, &VtkPropRenderer::OnNodeAdded));
+  m_DataStorage->RemoveNodeEvent.RemoveListener(
+    MessageDelegate1<VtkPropRenderer, const DataNode *>(this, &VtkPropRenderer::OnNodeRemoved));
+  m_DataStorage->ChangedNodeEvent.RemoveListener(
+    MessageDelegate1<VtkPropRenderer, const DataNode *>(this, &VtkPropRenderer::OnNodeChanged));
+}
+
 void mitk::VtkPropRenderer::SetPropertyKeys(vtkInformation *info)
 {
   if (info == m_VtkRenderInfo)
@@ -312,9 +493,13 @@ void mitk::VtkPropRenderer::Update()
   if (m_DataStorage.IsNull())
     return;
 
-  mitk::DataStorage::SetOfObjects::ConstPointer all = m_DataStorage->GetAll();
-  for (mitk::DataStorage::SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
-    Update(it->Value());
+  for (auto &entry : m_RenderList)
+  {
+    Update(entry.Node);
+    entry.UpdateTime.Modified();
+    entry.UpdateValid = true;
+    this->InvalidatePickingBounds(entry);
+  }
 
   Modified();
   m_LastUpdateTime = GetMTime();
@@ -439,13 +624,21 @@ void mitk::VtkPropRenderer::PickWorldPoint(const mitk::Point2D &displayPoint, mi
     }
     case (PointPicking):
     {
+      this->InitializePickList(m_PointPicker, displayPoint, false);
+      this->AddViewPropsToPickList(m_PointPicker);
+      m_PointPicker->PickFromListOn();
       m_PointPicker->Pick(displayPoint[0], displayPoint[1], 0, m_VtkRenderer);
+      m_PointPicker->PickFromListOff();
       vtk2itk(m_PointPicker->GetPickPosition(), worldPoint);
       break;
     }
     case (CellPicking):
     {
+      this->InitializePickList(m_CellPicker, displayPoint, false);
+      this->AddViewPropsToPickList(m_CellPicker);
+      m_CellPicker->PickFromListOn();
       m_CellPicker->Pick(displayPoint[0], displayPoint[1], 0, m_VtkRenderer);
+      m_CellPicker->PickFromListOff();
       vtk2itk(m_CellPicker->GetPickPosition(), worldPoint);
       break;
     }
@@ -456,32 +649,9 @@ void mitk::VtkPropRenderer::PickWorldPoint(const mitk::Point2D &displayPoint, mi
 
 mitk::DataNode *mitk::VtkPropRenderer::PickObject(const Point2D &displayPosition, Point3D &worldPosition) const
 {
-  m_CellPicker->InitializePickList();
-
-  // Iterate over all DataStorage objects to determine all vtkProps intended
-  // for picking
-  DataStorage::SetOfObjects::ConstPointer allObjects = m_DataStorage->GetAll();
-  for (DataStorage::SetOfObjects::ConstIterator it = allObjects->Begin(); it != allObjects->End(); ++it)
-  {
-    const DataNode *node = it->Value();
-    if (node == nullptr)
-      continue;
-
-    bool pickable = false;
-    node->GetBoolProperty("pickable", pickable);
-    if (!pickable)
-      continue;
-
-    auto *mapper = dynamic_cast<VtkMapper *>(node->GetMapper(m_MapperID));
-    if (mapper == nullptr)
-      continue;
-
-    vtkProp *prop = mapper->GetVtkProp((mitk::BaseRenderer *)this);
-    if (prop == nullptr)
-      continue;
-
-    m_CellPicker->AddPickList(prop);
-  }
+  // Only the vtkProps of pickable nodes whose bounds are hit by the pick ray are
+  // intended for picking
+  auto candidates = this->InitializePickList(m_CellPicker, displayPosition, true);
 
   // Do the picking and retrieve the picked vtkProp (if any)
   m_CellPicker->PickFromListOn();
@@ -496,13 +666,11 @@ mitk::DataNode *mitk::VtkPropRenderer::PickObject(const Point2D &displayPosition
     return nullptr;
   }
 
-  // Iterate over all DataStorage objects to determine if the retrieved
+  // Iterate over all candidates to determine if the retrieved
   // vtkProp is owned by any associated mapper.
-  for (DataStorage::SetOfObjects::ConstIterator it = allObjects->Begin(); it != allObjects->End(); ++it)
+  for (auto candidate : candidates)
   {
-    DataNode::Pointer node = it->Value();
-    if (node.IsNull())
-      continue;
+    auto *node = const_cast<DataNode *>(candidate);
 
     mitk::Mapper *mapper = node->GetMapper(m_MapperID);
     if (mapper == nullptr)
@@ -521,6 +689,114 @@ mitk::DataNode *mitk::VtkPropRenderer::PickObject(const Point2D &displayPosition
   }
   return nullptr;
 }
+
+void mitk::VtkPropRenderer::UpdatePickingHierarchy() const
+{
+  // Entries are marked as outdated by the DataStorage events and by the mapper updates of this
+  // renderer, so picking does not have to check the modification times of all nodes
+  if (!m_PickingHierarchyOutdated)
+    return;
+
+  for (const auto &entry : m_RenderList)
+  {
+    if (entry.PickingValid)
+      continue;
+
+    entry.PickingValid = true;
+
+    auto *mapper = dynamic_cast<VtkMapper *>(entry.Node->GetMapper(m_MapperID));
+    vtkProp *prop = mapper != nullptr ? mapper->GetVtkProp(const_cast<mitk::VtkPropRenderer *>(this)) : nullptr;
+
+    const double *bounds = prop != nullptr && prop->GetVisibility() ? prop->GetBounds() : nullptr;
+
+    if (bounds == nullptr)
+    {
+      m_PickingHierarchy.Remove(entry.Node);
+      continue;
+    }
+
+    NodeBoundingVolumeHierarchy::BoundsType nodeBounds;
+    std::copy(bounds, bounds + 6, nodeBounds.begin());
+    m_PickingHierarchy.SetBounds(entry.Node, nodeBounds);
+  }
+
+  m_PickingHierarchyOutdated = false;
+}
+
+std::vector<const mitk::DataNode *> mitk::VtkPropRenderer::InitializePickList(vtkPicker *picker,
+                                                                             const Point2D &displayPosition,
+                                                                             bool pickableOnly) const
+{
+  picker->InitializePickList();
+
+  std::vector<const DataNode *> candidates;
+  this->UpdatePickingHierarchy();
+
+  // Pick ray through the display position from the near to the far clipping plane
+  auto displayToWorld = [this](double x, double y, double z, Point3D &worldPoint) {
+    double homogeneousPoint[4];
+    m_VtkRenderer->SetDisplayPoint(x, y, z);
+    m_VtkRenderer->DisplayToWorld();
+    m_VtkRenderer->GetWorldPoint(homogeneousPoint);
+    if (homogeneousPoint[3] == 0.0)
+      return false;
+    for (int i = 0; i < 3; ++i)
+      worldPoint[i] = homogeneousPoint[i] / homogeneousPoint[3];
+    return true;
+  };
+
+  Point3D nearPoint, farPoint, farOrigin, farCorner;
+  const int *viewportSize = this->GetViewportSize();
+  if (!displayToWorld(displayPosition[0], displayPosition[1], 0.0, nearPoint) ||
+      !displayToWorld(displayPosition[0], displayPosition[1], 1.0, farPoint) ||
+      !displayToWorld(0.0, 0.0, 1.0, farOrigin) ||
+      !displayToWorld(viewportSize[0], viewportSize[1], 1.0, farCorner))
+  {
+    return candidates;
+  }
+
+  // The picker tolerance is a fraction of the window diagonal. Measured on the far
+  // clipping plane it is an upper bound for the tolerance in world coordinates.
+  const double tolerance = picker->GetTolerance() * farOrigin.EuclideanDistanceTo(farCorner);
+
+  for (auto node : m_PickingHierarchy.IntersectSegment(nearPoint, farPoint, tolerance))
+  {
+    if (pickableOnly)
+    {
+      bool pickable = false;
+      node->GetBoolProperty(PropertyKeys::Pickable(), pickable);
+      if (!pickable)
+        continue;
+    }
+
+    auto *mapper = dynamic_cast<VtkMapper *>(node->GetMapper(m_MapperID));
+    if (mapper == nullptr)
+      continue;
+
+    vtkProp *prop = mapper->GetVtkProp(const_cast<mitk::VtkPropRenderer *>(this));
+    if (prop == nullptr)
+      continue;
+
+    picker->AddPickList(prop);
+    candidates.push_back(node);
+  }
+
+  return candidates;
+}
+void mitk::VtkPropRenderer::AddViewPropsToPickList(vtkPicker *picker) const
+{
+  // All nodes are rendered through the vtkMitkRenderProp, the remaining vtkProps of the
+  // vtkRenderer (e.g. annotations) are not part of the picking hierarchy
+  vtkPropCollection *props = m_VtkRenderer->GetViewProps();
+  vtkCollectionSimpleIterator it;
+  props->InitTraversal(it);
+  while (vtkProp *prop = props->GetNextProp(it))
+  {
+    if (vtkMitkRenderProp::SafeDownCast(prop) == nullptr)
+      picker->AddPickList(prop);
+  }
+}
+
 // todo: is this 2D renderwindow picking?
 //    return Superclass::PickObject( displayPosition, worldPosition );
 
@@ -550,11 +826,10 @@ void mitk::VtkPropRenderer::UpdatePaths()
     // Create the list to hold all the paths
     m_Paths = vtkSmartPointer<vtkAssemblyPaths>::New();
 
-    DataStorage::SetOfObjects::ConstPointer objects = m_DataStorage->GetAll();
-    for (auto iter = objects->begin(); iter != objects->end(); ++iter)
+    for (const auto &entry : m_RenderList)
     {
       vtkSmartPointer<vtkAssemblyPath> onePath = vtkSmartPointer<vtkAssemblyPath>::New();
-      Mapper *mapper = (*iter)->GetMapper(BaseRenderer::Standard3D);
+      Mapper *mapper = entry.Node->GetMapper(BaseRenderer::Standard3D);
       if (mapper)
       {
         auto *vtkmapper = dynamic_cast<VtkMapper *>(mapper);
@@ -592,14 +867,9 @@ void mitk::VtkPropRenderer::ReleaseGraphicsResources(vtkWindow * /*renWin*/)
   if (m_DataStorage.IsNull())
     return;
 
-  DataStorage::SetOfObjects::ConstPointer allObjects = m_DataStorage->GetAll();
-  for (auto iter = allObjects->begin(); iter != allObjects->end(); ++iter)
+  for (const auto &entry : m_RenderList)
   {
-    DataNode::Pointer node = *iter;
-    if (node.IsNull())
-      continue;
-
-    Mapper *mapper = node->GetMapper(m_MapperID);
+    Mapper *mapper = entry.Node->GetMapper(m_MapperID);
 
     if (mapper)
     {
@@ -0,0 +1,324 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "vtkMitkSlabPlaneCutter.h"
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkCutter.h>
+#include <vtkIdList.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkMath.h>
+#include <vtkObjectFactory.h>
+#include <vtkPlane.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+vtkStandardNewMacro(vtkMitkSlabPlaneCutter);
+
+namespace
+{
+  enum CellCategory
+  {
+    VertexCells,
+    LineCells,
+    PolygonCells,
+    StripCells
+  };
+
+  CellCategory GetCellCategory(int cellType)
+  {
+    switch (cellType)
+    {
+      case VTK_EMPTY_CELL:
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+        return VertexCells;
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+        return LineCells;
+      case VTK_TRIANGLE_STRIP:
+        return StripCells;
+      default:
+        return PolygonCells;
+    }
+  }
+}
+
+vtkMitkSlabPlaneCutter::vtkMitkSlabPlaneCutter()
+  : m_Plane(vtkSmartPointer<vtkPlane>::New()),
+    m_Cutter(vtkSmartPointer<vtkCutter>::New()),
+    m_IndexInput(nullptr),
+    m_IndexMinimum(0.0),
+    m_SlabWidth(1.0),
+    m_NumberOfCutCells(0)
+{
+  m_IndexNormal[0] = 0.0;
+  m_IndexNormal[1] = 0.0;
+  m_IndexNormal[2] = 0.0;
+
+  m_Cutter->SetCutFunction(m_Plane);
+}
+
+vtkMitkSlabPlaneCutter::~vtkMitkSlabPlaneCutter()
+{
+}
+
+void vtkMitkSlabPlaneCutter::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Number of slabs: " << (m_SlabOffsets.empty() ? 0 : m_SlabOffsets.size() - 1) << "\n";
+  os << indent << "Number of cut cells: " << m_NumberOfCutCells << "\n";
+}
+
+void vtkMitkSlabPlaneCutter::SetPlane(vtkPlane *plane)
+{
+  if (plane == nullptr || plane == m_Plane)
+    return;
+
+  m_Plane = plane;
+  m_Cutter->SetCutFunction(m_Plane);
+  this->Modified();
+}
+
+vtkPlane *vtkMitkSlabPlaneCutter::GetPlane() const
+{
+  return m_Plane;
+}
+
+vtkIdType vtkMitkSlabPlaneCutter::GetNumberOfCutCells() const
+{
+  return m_NumberOfCutCells;
+}
+
+vtkMTimeType vtkMitkSlabPlaneCutter::GetMTime()
+{
+  return std::max(this->Superclass::GetMTime(), m_Plane->GetMTime());
+}
+
+int vtkMitkSlabPlaneCutter::RequestData(vtkInformation *,
+                                        vtkInformationVector **inputVector,
+                                        vtkInformationVector *outputVector)
+{
+  vtkPolyData *input = vtkPolyData::GetData(inputVector[0]);
+  vtkPolyData *output = vtkPolyData::GetData(outputVector);
+
+  if (input == nullptr || output == nullptr)
+    return 0;
+
+  output->Initialize();
+  m_NumberOfCutCells = 0;
+
+  double normal[3];
+  m_Plane->GetNormal(normal);
+  if (vtkMath::Normalize(normal) == 0.0 || input->GetNumberOfCells() == 0 || input->GetPoints() == nullptr)
+    return 1;
+
+  if (!this->IsIndexValid(input, normal))
+    this->BuildIndex(input, normal);
+
+  double origin[3];
+  m_Plane->GetOrigin(origin);
+
+  std::vector<vtkIdType> cells;
+  this->CollectCells(input, vtkMath::Dot(m_IndexNormal, origin), cells);
+  m_NumberOfCutCells = static_cast<vtkIdType>(cells.size());
+
+  if (cells.empty())
+    return 1;
+
+  auto subset = vtkSmartPointer<vtkPolyData>::New();
+  this->ExtractCells(input, cells, subset);
+
+  m_Cutter->SetInputData(subset);
+  m_Cutter->Update();
+  output->ShallowCopy(m_Cutter->GetOutput());
+  m_Cutter->SetInputData(nullptr);
+
+  return 1;
+}
+
+bool vtkMitkSlabPlaneCutter::IsIndexValid(vtkPolyData *input, const double normal[3]) const
+{
+  if (input != m_IndexInput || m_IndexTime.GetMTime() < input->GetMTime())
+    return false;
+
+  // The index stays valid as long as the plane is only moved along its normal
+  return vtkMath::Dot(normal, m_IndexNormal) > 1.0 - 1e-9;
+}
+
+void vtkMitkSlabPlaneCutter::BuildIndex(vtkPolyData *input, const double normal[3])
+{
+  if (input->NeedToBuildCells())
+    input->BuildCells();
+
+  const vtkIdType numberOfPoints = input->GetNumberOfPoints();
+  const vtkIdType numberOfCells = input->GetNumberOfCells();
+  vtkPoints *points = input->GetPoints();
+
+  std::vector<double> pointDistance(numberOfPoints);
+  for (vtkIdType pointId = 0; pointId < numberOfPoints; ++pointId)
+  {
+    double point[3];
+    points->GetPoint(pointId, point);
+    pointDistance[pointId] = vtkMath::Dot(normal, point);
+  }
+
+  // Extent of each cell along the normal; vertex cells get an empty extent
+  m_CellMinimum.assign(numberOfCells, std::numeric_limits<double>::max());
+  m_CellMaximum.assign(numberOfCells, std::numeric_limits<double>::lowest());
+
+  double minimum = std::numeric_limits<double>::max();
+  double maximum = std::numeric_limits<double>::lowest();
+  auto cellPointIds = vtkSmartPointer<vtkIdList>::New();
+
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    if (GetCellCategory(input->GetCellType(cellId)) == VertexCells)
+      continue;
+
+    input->GetCellPoints(cellId, cellPointIds);
+    for (vtkIdType i = 0; i < cellPointIds->GetNumberOfIds(); ++i)
+    {
+      const double distance = pointDistance[cellPointIds->GetId(i)];
+      m_CellMinimum[cellId] = std::min(m_CellMinimum[cellId], distance);
+      m_CellMaximum[cellId] = std::max(m_CellMaximum[cellId], distance);
+    }
+    minimum = std::min(minimum, m_CellMinimum[cellId]);
+    maximum = std::max(maximum, m_CellMaximum[cellId]);
+  }
+
+  // About 2 * sqrt(n) slabs: for meshes with evenly sized cells each cell then
+  // spans only a few slabs and each slab holds O(sqrt(n)) cells
+  vtkIdType numberOfSlabs = std::max<vtkIdType>(1, static_cast<vtkIdType>(2.0 * std::sqrt(static_cast<double>(numberOfCells))));
+  m_IndexMinimum = minimum <= maximum ? minimum : 0.0;
+  m_SlabWidth = minimum < maximum ? (maximum - minimum) / numberOfSlabs : 1.0;
+  if (minimum >= maximum)
+    numberOfSlabs = 1;
+
+  auto slabIndex = [this, numberOfSlabs](double distance) {
+    auto index = static_cast<vtkIdType>((distance - m_IndexMinimum) / m_SlabWidth);
+    return std::min(std::max<vtkIdType>(index, 0), numberOfSlabs - 1);
+  };
+
+  m_SlabOffsets.assign(numberOfSlabs + 1, 0);
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    if (m_CellMinimum[cellId] > m_CellMaximum[cellId])
+      continue;
+
+    for (vtkIdType slab = slabIndex(m_CellMinimum[cellId]); slab <= slabIndex(m_CellMaximum[cellId]); ++slab)
+      ++m_SlabOffsets[slab + 1];
+  }
+
+  for (vtkIdType slab = 0; slab < numberOfSlabs; ++slab)
+    m_SlabOffsets[slab + 1] += m_SlabOffsets[slab];
+
+  m_SlabCells.resize(m_SlabOffsets.back());
+  std::vector<vtkIdType> fill(m_SlabOffsets.begin(), m_SlabOffsets.end() - 1);
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    if (m_CellMinimum[cellId] > m_CellMaximum[cellId])
+      continue;
+
+    for (vtkIdType slab = slabIndex(m_CellMinimum[cellId]); slab <= slabIndex(m_CellMaximum[cellId]); ++slab)
+      m_SlabCells[fill[slab]++] = cellId;
+  }
+
+  m_PointMap.assign(numberOfPoints, -1);
+
+  std::copy(normal, normal + 3, m_IndexNormal);
+  m_IndexInput = input;
+  m_IndexTime.Modified();
+}
+
+void vtkMitkSlabPlaneCutter::CollectCells(vtkPolyData *, double distance, std::vector<vtkIdType> &cells) const
+{
+  const auto numberOfSlabs = static_cast<vtkIdType>(m_SlabOffsets.size()) - 1;
+  if (numberOfSlabs < 1)
+    return;
+
+  const double position = (distance - m_IndexMinimum) / m_SlabWidth;
+  if (position < 0.0 || position > static_cast<double>(numberOfSlabs))
+    return;
+
+  const auto slab = std::min(static_cast<vtkIdType>(position), numberOfSlabs - 1);
+  for (vtkIdType i = m_SlabOffsets[slab]; i < m_SlabOffsets[slab + 1]; ++i)
+  {
+    const vtkIdType cellId = m_SlabCells[i];
+    if (m_CellMinimum[cellId] <= distance && distance <= m_CellMaximum[cellId])
+      cells.push_back(cellId);
+  }
+}
+
+void vtkMitkSlabPlaneCutter::ExtractCells(vtkPolyData *input, const std::vector<vtkIdType> &cells, vtkPolyData *output)
+{
+  vtkPointData *inputPointData = input->GetPointData();
+  vtkCellData *inputCellData = input->GetCellData();
+  vtkPointData *outputPointData = output->GetPointData();
+  vtkCellData *outputCellData = output->GetCellData();
+
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataType(input->GetPoints()->GetDataType());
+  outputPointData->CopyAllocate(inputPointData, 3 * static_cast<vtkIdType>(cells.size()));
+  outputCellData->CopyAllocate(inputCellData, static_cast<vtkIdType>(cells.size()));
+
+  vtkSmartPointer<vtkCellArray> cellArrays[4] = { nullptr,
+                                                  vtkSmartPointer<vtkCellArray>::New(),
+                                                  vtkSmartPointer<vtkCellArray>::New(),
+                                                  vtkSmartPointer<vtkCellArray>::New() };
+
+  std::vector<vtkIdType> usedPoints;
+  auto cellPointIds = vtkSmartPointer<vtkIdList>::New();
+  vtkIdType outputCellId = 0;
+
+  // Polydata numbers its cells lines first, then polygons, then strips.
+  // Insert the cells in this order to keep the cell data consistent.
+  for (int category = LineCells; category <= StripCells; ++category)
+  {
+    for (vtkIdType cellId : cells)
+    {
+      if (GetCellCategory(input->GetCellType(cellId)) != category)
+        continue;
+
+      input->GetCellPoints(cellId, cellPointIds);
+      for (vtkIdType i = 0; i < cellPointIds->GetNumberOfIds(); ++i)
+      {
+        const vtkIdType pointId = cellPointIds->GetId(i);
+        if (m_PointMap[pointId] < 0)
+        {
+          m_PointMap[pointId] = points->InsertNextPoint(input->GetPoint(pointId));
+          outputPointData->CopyData(inputPointData, pointId, m_PointMap[pointId]);
+          usedPoints.push_back(pointId);
+        }
+        cellPointIds->SetId(i, m_PointMap[pointId]);
+      }
+
+      cellArrays[category]->InsertNextCell(cellPointIds);
+      outputCellData->CopyData(inputCellData, cellId, outputCellId++);
+    }
+  }
+
+  for (vtkIdType pointId : usedPoints)
+    m_PointMap[pointId] = -1;
+
+  output->SetPoints(points);
+  output->SetLines(cellArrays[LineCells]);
+  output->SetPolys(cellArrays[PolygonCells]);
+  output->SetStrips(cellArrays[StripCells]);
+}
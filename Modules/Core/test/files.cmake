@@ -27,6 +27,7 @@ set(MODULE_TESTS
   mitkActionTest.cpp
   mitkDispatcherTest.cpp
   mitkEnumerationPropertyTest.cpp
+  mitkEventStateMachineTest.cpp
   mitkFileReaderRegistryTest.cpp
   #mitkFileWriterRegistryTest.cpp
   mitkFloatToStringTest.cpp
@@ -38,6 +39,7 @@ set(MODULE_TESTS
   mitkImageCastTest.cpp
   mitkImageDataItemTest.cpp
   mitkImageGeneratorTest.cpp
+  mitkImageModifiedRegionTest.cpp
   mitkIOUtilTest.cpp
   mitkITKEventObserverGuardTest.cpp
   mitkBaseDataTest.cpp
@@ -55,6 +57,7 @@ set(MODULE_TESTS
   mitkPointSetLocaleTest.cpp
   mitkPointSetWriterTest.cpp
   mitkPointSetPointOperationsTest.cpp
+  mitkPointSetSpatialIndexTest.cpp
   mitkProgressBarTest.cpp
   mitkPropertyTest.cpp
   mitkPropertyListTest.cpp
@@ -78,6 +81,7 @@ set(MODULE_TESTS
   mitkRenderingManagerTest.cpp
   mitkCompositePixelValueToStringTest.cpp
   vtkMitkThickSlicesFilterTest.cpp
+  vtkMitkSlabPlaneCutterTest.cpp
   mitkNodePredicateDataPropertyTest.cpp
   mitkNodePredicateFunctionTest.cpp
   mitkVectorTest.cpp
@@ -85,9 +89,11 @@ set(MODULE_TESTS
   mitkExceptionTest.cpp
   mitkExtractSliceFilterTest.cpp
   mitkLogTest.cpp
+  mitkAsynchronousLogTest.cpp
   mitkImageDimensionConverterTest.cpp
   mitkLoggingAdapterTest.cpp
   mitkUIDGeneratorTest.cpp
+  mitkNodeBoundingVolumeHierarchyTest.cpp
   mitkPlanePositionManagerTest.cpp
   mitkAffineTransformBaseTest.cpp
   mitkPropertyAliasesTest.cpp
@@ -197,4 +203,6 @@ set(RESOURCE_FILES
   Interactions/globalConfig.xml
   Interactions/StatemachineTest.xml
   Interactions/StatemachineConfigTest.xml
+  Interactions/TransitionTableTest.xml
+  Interactions/DispatcherTest.xml
 )
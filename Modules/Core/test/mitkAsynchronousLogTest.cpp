@@ -0,0 +1,227 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+// MITK includes
+#include <mitkLog.h>
+#include <mitkLogBackendBase.h>
+// std includes
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  /**
+   * Backend that records the messages emitted by this file and the threads that processed them.
+   */
+  class RecordingBackend : public mitk::LogBackendBase
+  {
+  public:
+    void ProcessMessage(const mitk::LogMessage &message) override
+    {
+      if (message.FilePath != __FILE__)
+        return;
+
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Messages.push_back(message.Message);
+      m_Threads.push_back(std::this_thread::get_id());
+    }
+
+    OutputType GetOutputType() const override { return OutputType::Other; }
+
+    std::vector<std::string> GetMessages() const
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      return m_Messages;
+    }
+
+    std::vector<std::thread::id> GetThreads() const
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      return m_Threads;
+    }
+
+  private:
+    mutable std::mutex m_Mutex;
+    std::vector<std::string> m_Messages;
+    std::vector<std::thread::id> m_Threads;
+  };
+}
+
+class mitkAsynchronousLogTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkAsynchronousLogTestSuite);
+  MITK_TEST(SetAsynchronousLogging_Toggles);
+  MITK_TEST(SetAsynchronousLogging_DisablingWritesPendingMessages);
+  MITK_TEST(FlushLog_WritesPendingMessages);
+  MITK_TEST(FlushLog_SynchronousLoggingWritesImmediately);
+  MITK_TEST(MessageOrder_KeptPerThread);
+  MITK_TEST(DisableLogLevel_SuppressesMessages);
+  MITK_TEST(DisableLogLevel_SuppressesMessages_Asynchronous);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  RecordingBackend m_Backend;
+
+  void LogNumberedMessages(int count)
+  {
+    for (int i = 0; i < count; ++i)
+      MITK_INFO << i;
+  }
+
+  void CheckNumberedMessages(int count)
+  {
+    const auto messages = m_Backend.GetMessages();
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(count), messages.size());
+    for (int i = 0; i < count; ++i)
+      CPPUNIT_ASSERT_EQUAL(std::to_string(i), messages[i]);
+  }
+
+  void CheckLogLevels()
+  {
+    mitk::DisableLogLevel(mitk::LogLevel::Info);
+    CPPUNIT_ASSERT(!mitk::IsLogLevelEnabled(mitk::LogLevel::Info));
+    CPPUNIT_ASSERT(mitk::IsLogLevelEnabled(mitk::LogLevel::Warn));
+
+    MITK_INFO << "suppressed";
+    MITK_WARN << "warning";
+
+    mitk::EnableLogLevel(mitk::LogLevel::Info);
+    CPPUNIT_ASSERT(mitk::IsLogLevelEnabled(mitk::LogLevel::Info));
+    MITK_INFO << "info";
+
+    mitk::FlushLog();
+    const auto messages = m_Backend.GetMessages();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), messages.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("warning"), messages[0]);
+    CPPUNIT_ASSERT_EQUAL(std::string("info"), messages[1]);
+  }
+
+public:
+  void setUp() override
+  {
+    mitk::RegisterBackend(&m_Backend);
+  }
+
+  void tearDown() override
+  {
+    mitk::SetAsynchronousLogging(false);
+    mitk::EnableLogLevel(mitk::LogLevel::Info);
+    mitk::UnregisterBackend(&m_Backend);
+  }
+
+  void SetAsynchronousLogging_Toggles()
+  {
+    CPPUNIT_ASSERT(!mitk::IsAsynchronousLoggingEnabled());
+
+    mitk::SetAsynchronousLogging(true);
+    CPPUNIT_ASSERT(mitk::IsAsynchronousLoggingEnabled());
+    mitk::SetAsynchronousLogging(true);
+    CPPUNIT_ASSERT(mitk::IsAsynchronousLoggingEnabled());
+
+    mitk::SetAsynchronousLogging(false);
+    CPPUNIT_ASSERT(!mitk::IsAsynchronousLoggingEnabled());
+  }
+
+  void SetAsynchronousLogging_DisablingWritesPendingMessages()
+  {
+    mitk::SetAsynchronousLogging(true);
+    this->LogNumberedMessages(2000);
+    mitk::SetAsynchronousLogging(false);
+
+    this->CheckNumberedMessages(2000);
+  }
+
+  void FlushLog_WritesPendingMessages()
+  {
+    mitk::SetAsynchronousLogging(true);
+    this->LogNumberedMessages(2000);
+    mitk::FlushLog();
+
+    this->CheckNumberedMessages(2000);
+
+    // the messages were passed to the backend by the writer thread
+    for (const auto &thread : m_Backend.GetThreads())
+      CPPUNIT_ASSERT(thread != std::this_thread::get_id());
+
+    // flushing again without pending messages returns immediately
+    mitk::FlushLog();
+    this->CheckNumberedMessages(2000);
+  }
+
+  void FlushLog_SynchronousLoggingWritesImmediately()
+  {
+    this->LogNumberedMessages(10);
+    this->CheckNumberedMessages(10);
+
+    for (const auto &thread : m_Backend.GetThreads())
+      CPPUNIT_ASSERT(thread == std::this_thread::get_id());
+
+    mitk::FlushLog();
+    this->CheckNumberedMessages(10);
+  }
+
+  void MessageOrder_KeptPerThread()
+  {
+    mitk::SetAsynchronousLogging(true);
+
+    const int numberOfThreads = 4;
+    const int numberOfMessages = 1000;
+
+    std::vector<std::thread> threads;
+    for (int k = 0; k < numberOfThreads; ++k)
+    {
+      threads.emplace_back([k]() {
+        for (int i = 0; i < numberOfMessages; ++i)
+          MITK_INFO << k << " " << i;
+      });
+    }
+
+    for (auto &thread : threads)
+      thread.join();
+
+    mitk::FlushLog();
+
+    const auto messages = m_Backend.GetMessages();
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(numberOfThreads * numberOfMessages), messages.size());
+
+    // messages of different threads interleave, but the messages of each thread keep their order
+    std::vector<int> next(numberOfThreads, 0);
+    for (const auto &message : messages)
+    {
+      std::istringstream stream(message);
+      int k = -1;
+      int i = -1;
+      stream >> k >> i;
+      CPPUNIT_ASSERT(k >= 0 && k < numberOfThreads);
+      CPPUNIT_ASSERT_EQUAL(next[k], i);
+      ++next[k];
+    }
+  }
+
+  void DisableLogLevel_SuppressesMessages()
+  {
+    this->CheckLogLevels();
+  }
+
+  void DisableLogLevel_SuppressesMessages_Asynchronous()
+  {
+    mitk::SetAsynchronousLogging(true);
+    this->CheckLogLevels();
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkAsynchronousLog)
@@ -19,10 +19,49 @@ found in the LICENSE file.
 #include "mitkDataInteractor.h"
 #include "mitkDataNode.h"
 #include "mitkDispatcher.h"
+#include "mitkMouseMoveEvent.h"
+#include "mitkMousePressEvent.h"
+#include "mitkMouseReleaseEvent.h"
 #include "mitkStandaloneDataStorage.h"
 #include "mitkVtkPropRenderer.h"
 // ITK includes
 #include "itkLightObject.h"
+// Microservices
+#include "usGetModuleContext.h"
+#include "usModule.h"
+
+#include <functional>
+#include <vector>
+
+namespace
+{
+  /**
+   * Interactor that records all events it handles and optionally calls a function from within the handling.
+   */
+  class RecordingInteractor : public mitk::DataInteractor
+  {
+  public:
+    mitkClassMacro(RecordingInteractor, mitk::DataInteractor);
+    itkFactorylessNewMacro(Self);
+
+    std::vector<mitk::InteractionEvent *> HandledEvents;
+    std::function<void(mitk::InteractionEvent *)> OnEvent;
+
+  protected:
+    RecordingInteractor() {}
+    ~RecordingInteractor() override {}
+
+    void ConnectActionsAndFunctions() override { CONNECT_FUNCTION("record", Record); }
+
+  private:
+    void Record(mitk::StateMachineAction *, mitk::InteractionEvent *event)
+    {
+      HandledEvents.push_back(event);
+      if (OnEvent)
+        OnEvent(event);
+    }
+  };
+}
 
 class mitkDispatcherTestSuite : public mitk::TestFixture
 {
@@ -38,6 +77,9 @@ class mitkDispatcherTestSuite : public mitk::TestFixture
   MITK_TEST(RemoveDataNode_RemoveInteractor);
   MITK_TEST(GetReferenceCountDataNode_Success);
   MITK_TEST(GetReferenceCountInteractors_Success);
+  MITK_TEST(NestedMouseMoves_CoalescedPerSender);
+  MITK_TEST(NestedEvent_PendingMouseMovesDispatchedFirst);
+  MITK_TEST(QueuedMouseMoves_Coalesced);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -51,6 +93,37 @@ private:
   mitk::DataNode::Pointer m_Dn2;
   mitk::DataInteractor::Pointer m_Ei;
   mitk::DataInteractor::Pointer m_Ei2;
+
+  RecordingInteractor::Pointer m_RecordingInteractor;
+  mitk::InteractionEvent::Pointer m_Press;
+  mitk::InteractionEvent::Pointer m_Move1;
+  mitk::InteractionEvent::Pointer m_Move2;
+  mitk::InteractionEvent::Pointer m_Release;
+
+  /** Connects the recording interactor to m_Dn and creates the events sent by m_Renderer. */
+  void SetUpRecordingInteractor()
+  {
+    m_RecordingInteractor = RecordingInteractor::New();
+    m_RecordingInteractor->LoadStateMachine("DispatcherTest.xml", us::GetModuleContext()->GetModule());
+    m_RecordingInteractor->SetEventConfig("globalConfig.xml");
+
+    m_Dn->SetVisibility(true);
+    m_RecordingInteractor->SetDataNode(m_Dn);
+    m_Ds->Add(m_Dn);
+
+    mitk::Point2D point;
+    point.Fill(5);
+    m_Press = mitk::MousePressEvent::New(m_Renderer, point, mitk::InteractionEvent::NoButton,
+                                         mitk::InteractionEvent::NoKey, mitk::InteractionEvent::LeftMouseButton);
+    m_Move1 = mitk::MouseMoveEvent::New(m_Renderer, point, mitk::InteractionEvent::NoButton,
+                                        mitk::InteractionEvent::NoKey);
+    point.Fill(7);
+    m_Move2 = mitk::MouseMoveEvent::New(m_Renderer, point, mitk::InteractionEvent::NoButton,
+                                        mitk::InteractionEvent::NoKey);
+    m_Release = mitk::MouseReleaseEvent::New(m_Renderer, point, mitk::InteractionEvent::NoButton,
+                                             mitk::InteractionEvent::NoKey, mitk::InteractionEvent::LeftMouseButton);
+  }
+
 public:
 
   /*
@@ -81,6 +154,11 @@ public:
     m_Dn2 = nullptr;
     m_Ei = nullptr;
     m_Ei2 = nullptr;
+    m_RecordingInteractor = nullptr;
+    m_Press = nullptr;
+    m_Move1 = nullptr;
+    m_Move2 = nullptr;
+    m_Release = nullptr;
   }
 
   void DispatcherExists_Success()
@@ -199,5 +277,66 @@ public:
     CPPUNIT_ASSERT_MESSAGE("12 Expected number of references of Interactors is 1",
                                                      m_Ei->GetReferenceCount() == 1);
   }
+
+  void NestedMouseMoves_CoalescedPerSender()
+  {
+    SetUpRecordingInteractor();
+    auto dispatcher = m_Renderer->GetDispatcher();
+
+    m_RecordingInteractor->OnEvent = [this, dispatcher](mitk::InteractionEvent *event) {
+      if (event == m_Press.GetPointer())
+      {
+        // moves arriving while the press is processed are deferred, only the latest one is kept
+        CPPUNIT_ASSERT(dispatcher->ProcessEvent(m_Move1));
+        CPPUNIT_ASSERT(dispatcher->ProcessEvent(m_Move2));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_RecordingInteractor->HandledEvents.size());
+      }
+    };
+
+    CPPUNIT_ASSERT(dispatcher->ProcessEvent(m_Press));
+
+    const std::vector<mitk::InteractionEvent *> expected = {m_Press, m_Move2};
+    CPPUNIT_ASSERT_MESSAGE("Expected the press and the latest move", expected == m_RecordingInteractor->HandledEvents);
+  }
+
+  void NestedEvent_PendingMouseMovesDispatchedFirst()
+  {
+    SetUpRecordingInteractor();
+    auto dispatcher = m_Renderer->GetDispatcher();
+
+    m_RecordingInteractor->OnEvent = [this, dispatcher](mitk::InteractionEvent *event) {
+      if (event == m_Press.GetPointer())
+      {
+        dispatcher->ProcessEvent(m_Move1);
+        dispatcher->ProcessEvent(m_Release);
+      }
+    };
+
+    dispatcher->ProcessEvent(m_Press);
+
+    const std::vector<mitk::InteractionEvent *> expected = {m_Press, m_Move1, m_Release};
+    CPPUNIT_ASSERT_MESSAGE("Pending move must be dispatched before the release",
+                           expected == m_RecordingInteractor->HandledEvents);
+  }
+
+  void QueuedMouseMoves_Coalesced()
+  {
+    SetUpRecordingInteractor();
+    auto dispatcher = m_Renderer->GetDispatcher();
+
+    m_RecordingInteractor->OnEvent = [this, dispatcher](mitk::InteractionEvent *event) {
+      if (event == m_Press.GetPointer())
+      {
+        dispatcher->QueueEvent(m_Move1);
+        dispatcher->QueueEvent(m_Move2);
+      }
+    };
+
+    dispatcher->ProcessEvent(m_Press);
+
+    const std::vector<mitk::InteractionEvent *> expected = {m_Press, m_Move2};
+    CPPUNIT_ASSERT_MESSAGE("Queued move must replace the preceding queued move",
+                           expected == m_RecordingInteractor->HandledEvents);
+  }
 };
 MITK_TEST_SUITE_REGISTRATION(mitkDispatcher)
@@ -0,0 +1,259 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+// MITK includes
+#include "mitkDataInteractor.h"
+#include "mitkMouseMoveEvent.h"
+#include "mitkMousePressEvent.h"
+#include "mitkMouseReleaseEvent.h"
+#include "mitkStateMachineAction.h"
+#include "mitkStateMachineCondition.h"
+#include "mitkStateMachineState.h"
+#include "mitkStateMachineTransition.h"
+// Microservices
+#include "usGetModuleContext.h"
+#include "usModule.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+  /**
+   * Interactor that records the executed actions and evaluated conditions and exposes the transition lookup.
+   */
+  class TransitionTableTestInteractor : public mitk::DataInteractor
+  {
+  public:
+    mitkClassMacro(TransitionTableTestInteractor, mitk::DataInteractor);
+    itkFactorylessNewMacro(Self);
+
+    bool IsOverObject = true;
+    bool IsMovable = true;
+
+    std::vector<std::string> ExecutedActions;
+    std::map<std::string, int> ConditionEvaluations;
+
+    std::string GetCurrentStateName() const { return this->GetCurrentState()->GetName(); }
+
+    /** Returns the transition found in the compiled transition table. */
+    mitk::StateMachineTransition *GetCompiledTransition(mitk::InteractionEvent *event)
+    {
+      return this->GetExecutableTransition(event);
+    }
+
+    /** Returns the transition found by matching the transitions of the current state by name, as before. */
+    mitk::StateMachineTransition *GetTransitionByName(mitk::InteractionEvent *event)
+    {
+      for (const auto &transition :
+           this->GetCurrentState()->GetTransitionList(event->GetNameOfClass(), this->MapToEventVariant(event)))
+      {
+        bool allConditionsFulfilled = true;
+        for (const auto &condition : transition->GetConditions())
+        {
+          if (this->CheckCondition(condition, event) == condition.IsInverted())
+          {
+            allConditionsFulfilled = false;
+            break;
+          }
+        }
+
+        if (allConditionsFulfilled)
+          return transition;
+      }
+      return nullptr;
+    }
+
+  protected:
+    TransitionTableTestInteractor() {}
+    ~TransitionTableTestInteractor() override {}
+
+    void ConnectActionsAndFunctions() override
+    {
+      CONNECT_CONDITION("isOverObject", CheckOverObject);
+      CONNECT_CONDITION("isMovable", CheckMovable);
+      CONNECT_FUNCTION("select", Record);
+      CONNECT_FUNCTION("deselect", Record);
+      CONNECT_FUNCTION("hover", Record);
+      CONNECT_FUNCTION("move", Record);
+      CONNECT_FUNCTION("release", Record);
+    }
+
+    bool CheckCondition(const mitk::StateMachineCondition &condition, const mitk::InteractionEvent *event) override
+    {
+      ++ConditionEvaluations[condition.GetConditionName()];
+      return Superclass::CheckCondition(condition, event);
+    }
+
+    void ExecuteAction(mitk::StateMachineAction *action, mitk::InteractionEvent *event) override
+    {
+      // connected and unconnected actions are dispatched through this method
+      if (action->GetActionName() == "unconnected")
+      {
+        ExecutedActions.push_back("unconnected");
+      }
+      else
+      {
+        Superclass::ExecuteAction(action, event);
+      }
+    }
+
+    bool FilterEvents(mitk::InteractionEvent *, mitk::DataNode *) override { return true; }
+
+  private:
+    bool CheckOverObject(const mitk::InteractionEvent *) { return IsOverObject; }
+    bool CheckMovable(const mitk::InteractionEvent *) { return IsMovable; }
+    void Record(mitk::StateMachineAction *action, mitk::InteractionEvent *) { ExecutedActions.push_back(action->GetActionName()); }
+  };
+}
+
+class mitkEventStateMachineTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkEventStateMachineTestSuite);
+  MITK_TEST(CompiledTransitions_MatchTransitionsByName);
+  MITK_TEST(HandleEvent_ConditionsEvaluatedOncePerEvent);
+  MITK_TEST(HandleEvent_VirtualDispatch);
+  MITK_TEST(LoadStateMachine_ResetsTransitionTable);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  TransitionTableTestInteractor::Pointer m_Interactor;
+
+  mitk::InteractionEvent::Pointer m_Press;
+  mitk::InteractionEvent::Pointer m_Move;
+  mitk::InteractionEvent::Pointer m_Drag;
+  mitk::InteractionEvent::Pointer m_Release;
+
+  /** Checks that the compiled table finds the same transition as the lookup by name and handles the event with it. */
+  void CheckEvent(mitk::InteractionEvent *event, bool isOverObject, bool isMovable, const std::string &expectedAction)
+  {
+    m_Interactor->IsOverObject = isOverObject;
+    m_Interactor->IsMovable = isMovable;
+
+    auto *expectedTransition = m_Interactor->GetTransitionByName(event);
+    CPPUNIT_ASSERT_MESSAGE("Compiled transition table and lookup by name differ",
+                           expectedTransition == m_Interactor->GetCompiledTransition(event));
+
+    m_Interactor->ExecutedActions.clear();
+    CPPUNIT_ASSERT_EQUAL(expectedTransition != nullptr, m_Interactor->HandleEvent(event, nullptr));
+
+    if (expectedTransition != nullptr)
+    {
+      CPPUNIT_ASSERT_EQUAL(expectedTransition->GetNextState()->GetName(), m_Interactor->GetCurrentStateName());
+      CPPUNIT_ASSERT(!m_Interactor->ExecutedActions.empty());
+      CPPUNIT_ASSERT_EQUAL(expectedAction, m_Interactor->ExecutedActions.front());
+    }
+    else
+    {
+      CPPUNIT_ASSERT(m_Interactor->ExecutedActions.empty());
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_Interactor = TransitionTableTestInteractor::New();
+    m_Interactor->LoadStateMachine("TransitionTableTest.xml", us::GetModuleContext()->GetModule());
+    m_Interactor->SetEventConfig("globalConfig.xml");
+
+    mitk::Point2D point;
+    point.Fill(5);
+    m_Press = mitk::MousePressEvent::New(nullptr, point, mitk::InteractionEvent::NoButton,
+                                         mitk::InteractionEvent::NoKey, mitk::InteractionEvent::LeftMouseButton);
+    m_Move = mitk::MouseMoveEvent::New(nullptr, point, mitk::InteractionEvent::NoButton, mitk::InteractionEvent::NoKey);
+    m_Drag = mitk::MouseMoveEvent::New(nullptr, point, mitk::InteractionEvent::LeftMouseButton,
+                                       mitk::InteractionEvent::NoKey);
+    m_Release = mitk::MouseReleaseEvent::New(nullptr, point, mitk::InteractionEvent::NoButton,
+                                             mitk::InteractionEvent::NoKey, mitk::InteractionEvent::LeftMouseButton);
+  }
+
+  void tearDown() override
+  {
+    m_Interactor = nullptr;
+    m_Press = nullptr;
+    m_Move = nullptr;
+    m_Drag = nullptr;
+    m_Release = nullptr;
+  }
+
+  void CompiledTransitions_MatchTransitionsByName()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::string("start"), m_Interactor->GetCurrentStateName());
+
+    CheckEvent(m_Move, true, true, "hover");
+    CheckEvent(m_Drag, true, true, "");       // no transition for this variant in the start state
+    CheckEvent(m_Press, false, true, "deselect"); // inverted condition
+    CheckEvent(m_Press, true, true, "select");
+    CheckEvent(m_Drag, true, true, "move");
+    CheckEvent(m_Drag, true, false, "hover");  // falls back to the transition of the super class
+    CheckEvent(m_Drag, false, true, "hover");
+    CheckEvent(m_Move, true, true, "");
+    CheckEvent(m_Press, true, true, "");
+    CheckEvent(m_Release, true, true, "release");
+    CheckEvent(m_Press, true, true, "select");
+    CheckEvent(m_Drag, true, true, "move");
+    CheckEvent(m_Release, false, false, "release");
+
+    CPPUNIT_ASSERT_EQUAL(std::string("start"), m_Interactor->GetCurrentStateName());
+  }
+
+  void HandleEvent_ConditionsEvaluatedOncePerEvent()
+  {
+    // both press transitions of the start state depend on the same condition
+    m_Interactor->IsOverObject = false;
+    m_Interactor->ConditionEvaluations.clear();
+    CPPUNIT_ASSERT(m_Interactor->HandleEvent(m_Press, nullptr));
+    CPPUNIT_ASSERT_EQUAL(1, m_Interactor->ConditionEvaluations["isOverObject"]);
+
+    m_Interactor->IsOverObject = true;
+    m_Interactor->ConditionEvaluations.clear();
+    CPPUNIT_ASSERT(m_Interactor->HandleEvent(m_Press, nullptr));
+    CPPUNIT_ASSERT_MESSAGE("Conditions must be evaluated again for each event",
+                           m_Interactor->ConditionEvaluations["isOverObject"] == 1);
+  }
+
+  void HandleEvent_VirtualDispatch()
+  {
+    CPPUNIT_ASSERT(m_Interactor->HandleEvent(m_Press, nullptr));
+
+    m_Interactor->ExecutedActions.clear();
+    m_Interactor->ConditionEvaluations.clear();
+    CPPUNIT_ASSERT(m_Interactor->HandleEvent(m_Drag, nullptr));
+    CPPUNIT_ASSERT_MESSAGE("Connected conditions must be evaluated through CheckCondition()",
+                           m_Interactor->ConditionEvaluations["isMovable"] == 1);
+
+    m_Interactor->ExecutedActions.clear();
+    CPPUNIT_ASSERT(m_Interactor->HandleEvent(m_Release, nullptr));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Interactor->ExecutedActions.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("release"), m_Interactor->ExecutedActions[0]);
+    CPPUNIT_ASSERT_EQUAL(std::string("unconnected"), m_Interactor->ExecutedActions[1]);
+  }
+
+  void LoadStateMachine_ResetsTransitionTable()
+  {
+    CPPUNIT_ASSERT(m_Interactor->HandleEvent(m_Press, nullptr));
+    CPPUNIT_ASSERT_EQUAL(std::string("pressed"), m_Interactor->GetCurrentStateName());
+
+    CPPUNIT_ASSERT(m_Interactor->LoadStateMachine("TransitionTableTest.xml", us::GetModuleContext()->GetModule()));
+    CPPUNIT_ASSERT_EQUAL(std::string("start"), m_Interactor->GetCurrentStateName());
+
+    CheckEvent(m_Drag, true, true, "");
+    CheckEvent(m_Press, true, true, "select");
+    CheckEvent(m_Drag, true, true, "move");
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkEventStateMachine)
@@ -0,0 +1,210 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <array>
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImageToItk.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkPixelType.h>
+
+class mitkImageModifiedRegionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageModifiedRegionTestSuite);
+  MITK_TEST(TestTrackingDisabled);
+  MITK_TEST(TestReportedRegions);
+  MITK_TEST(TestUnknownModification);
+  MITK_TEST(TestWriteAccessor);
+  MITK_TEST(TestImageToItk);
+  MITK_TEST(TestRegionsKnownToObservers);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+  static mitk::Image::ModifiedRegionType MakeRegion(itk::IndexValueType x, itk::IndexValueType y, itk::IndexValueType z,
+    itk::SizeValueType sizeX, itk::SizeValueType sizeY, itk::SizeValueType sizeZ)
+  {
+    mitk::Image::ModifiedRegionType region;
+    region.SetIndex({{ x, y, z }});
+    region.SetSize({{ sizeX, sizeY, sizeZ }});
+    return region;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::Image::New();
+    std::array<unsigned int, 4> dimensions = {{ 8, 6, 4, 2 }};
+    m_Image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 4, dimensions.data());
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+  }
+
+  void TestTrackingDisabled()
+  {
+    CPPUNIT_ASSERT(!m_Image->GetModifiedRegionTracking());
+
+    const auto since = m_Image->GetMTime();
+    m_Image->AddModifiedRegion(0, MakeRegion(0, 0, 0, 1, 1, 1));
+    m_Image->Modified();
+
+    mitk::Image::ModifiedRegionVectorType regions;
+    CPPUNIT_ASSERT_MESSAGE("Changes are unknown without tracking", !m_Image->GetModifiedRegions(since, 0, regions));
+    CPPUNIT_ASSERT(regions.empty());
+  }
+
+  void TestReportedRegions()
+  {
+    m_Image->SetModifiedRegionTracking(true);
+    const auto since = m_Image->GetMTime();
+
+    mitk::Image::ModifiedRegionVectorType regions;
+    CPPUNIT_ASSERT_MESSAGE("Nothing changed yet", m_Image->GetModifiedRegions(since, 0, regions));
+    CPPUNIT_ASSERT(regions.empty());
+
+    const auto first = MakeRegion(1, 2, 3, 2, 2, 1);
+    m_Image->AddModifiedRegion(0, first);
+    m_Image->Modified();
+    const auto afterFirst = m_Image->GetMTime();
+
+    const auto second = MakeRegion(0, 0, 0, 8, 6, 1);
+    m_Image->AddModifiedRegion(1, second);
+    m_Image->Modified();
+
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegions(since, 0, regions));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), regions.size());
+    CPPUNIT_ASSERT_EQUAL(first, regions.front());
+
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegions(since, 1, regions));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), regions.size());
+    CPPUNIT_ASSERT_EQUAL(second, regions.front());
+
+    CPPUNIT_ASSERT_MESSAGE("Only changes after the passed time are returned", m_Image->GetModifiedRegions(afterFirst, 0, regions));
+    CPPUNIT_ASSERT(regions.empty());
+
+    m_Image->AddModifiedRegion(0, mitk::Image::ModifiedRegionType());
+    m_Image->Modified();
+    CPPUNIT_ASSERT_MESSAGE("Empty regions mark modifications without pixel changes", m_Image->GetModifiedRegions(afterFirst, 0, regions));
+    CPPUNIT_ASSERT(regions.empty());
+  }
+
+  void TestUnknownModification()
+  {
+    m_Image->SetModifiedRegionTracking(true);
+    const auto since = m_Image->GetMTime();
+
+    m_Image->AddModifiedRegion(0, MakeRegion(0, 0, 0, 1, 1, 1));
+    m_Image->Modified();
+    const auto afterKnown = m_Image->GetMTime();
+
+    m_Image->Modified();
+
+    mitk::Image::ModifiedRegionVectorType regions;
+    CPPUNIT_ASSERT_MESSAGE("Modified() without regions is unknown", !m_Image->GetModifiedRegions(since, 0, regions));
+    CPPUNIT_ASSERT(!m_Image->GetModifiedRegions(afterKnown, 0, regions));
+
+    const auto afterUnknown = m_Image->GetMTime();
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegions(afterUnknown, 0, regions));
+
+    m_Image->GetTimeGeometry()->Modified();
+    CPPUNIT_ASSERT_MESSAGE("Geometry changes are unknown", !m_Image->GetModifiedRegions(afterUnknown, 0, regions));
+  }
+
+  void TestWriteAccessor()
+  {
+    m_Image->SetModifiedRegionTracking(true);
+    auto since = m_Image->GetMTime();
+
+    mitk::Image::ModifiedRegionVectorType regions;
+
+    {
+      mitk::ImageWriteAccessor accessor(m_Image, m_Image->GetVolumeData(1));
+    }
+    m_Image->Modified();
+
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegions(since, 1, regions));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), regions.size());
+    CPPUNIT_ASSERT_EQUAL(MakeRegion(0, 0, 0, 8, 6, 4), regions.front());
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegions(since, 0, regions));
+    CPPUNIT_ASSERT(regions.empty());
+
+    since = m_Image->GetMTime();
+    const auto region = MakeRegion(2, 1, 0, 3, 3, 2);
+
+    {
+      mitk::ImageWriteAccessor accessor(m_Image, m_Image->GetVolumeData(0));
+      accessor.SetModifiedRegion(region);
+    }
+    m_Image->Modified();
+
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegions(since, 0, regions));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), regions.size());
+    CPPUNIT_ASSERT_EQUAL(region, regions.front());
+  }
+
+  void TestImageToItk()
+  {
+    m_Image->SetModifiedRegionTracking(true);
+    const auto since = m_Image->GetMTime();
+    const auto region = MakeRegion(0, 0, 2, 8, 6, 1);
+
+    {
+      auto imageToItk = mitk::ImageToItk<itk::Image<unsigned char, 3>>::New();
+      imageToItk->SetInput(m_Image);
+      imageToItk->SetModifiedRegion(region);
+      imageToItk->Update();
+    }
+    m_Image->Modified();
+
+    mitk::Image::ModifiedRegionVectorType regions;
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegions(since, 0, regions));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), regions.size());
+    CPPUNIT_ASSERT_EQUAL(region, regions.front());
+  }
+
+  void TestRegionsKnownToObservers()
+  {
+    m_Image->SetModifiedRegionTracking(true);
+    const auto since = m_Image->GetMTime();
+    const auto region = MakeRegion(1, 1, 1, 2, 3, 2);
+
+    bool called = false;
+    bool mTimeIncreased = false;
+    bool regionsKnown = false;
+    mitk::Image::ModifiedRegionVectorType regions;
+
+    const auto tag = m_Image->AddObserver(itk::ModifiedEvent(), [&](const itk::EventObject &) {
+      called = true;
+      mTimeIncreased = m_Image->GetMTime() > since;
+      regionsKnown = m_Image->GetModifiedRegions(since, 1, regions);
+    });
+
+    m_Image->AddModifiedRegion(1, region);
+    m_Image->Modified();
+    m_Image->RemoveObserver(tag);
+
+    CPPUNIT_ASSERT(called);
+    CPPUNIT_ASSERT_MESSAGE("MTime is increased before the observers are notified", mTimeIncreased);
+    CPPUNIT_ASSERT_MESSAGE("Observers see the regions of the modification that notified them", regionsKnown);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), regions.size());
+    CPPUNIT_ASSERT_EQUAL(region, regions.front());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageModifiedRegion)
@@ -275,6 +275,26 @@ public:
     mitk::UnregisterBackend(&myCoutBackend);
     MITK_TEST_CONDITION_REQUIRED(success, "Test disable / enable logging backends.")
   }
+
+  static void TestLogStreamsReleasedOutOfOrder()
+  {
+    std::ostream *first = mitk::AcquireLogStream();
+    std::ostream *second = mitk::AcquireLogStream();
+    *first << "first";
+    *second << "second";
+
+    // release the first stream while the second one is still in use
+    bool success = mitk::ReleaseLogStream(first) == "first";
+
+    std::ostream *third = mitk::AcquireLogStream();
+    success &= third != second;
+    *third << "third";
+
+    success &= mitk::ReleaseLogStream(second) == "second";
+    success &= mitk::ReleaseLogStream(third) == "third";
+
+    MITK_TEST_CONDITION_REQUIRED(success, "Test releasing log streams out of order.")
+  }
 };
 
 int mitkLogTest(int /* argc */, char * /*argv*/ [])
@@ -292,6 +312,7 @@ int mitkLogTest(int /* argc */, char * /*argv*/ [])
   mitkLogTestClass::TestThreadSaveLog(false); // false = to console
   mitkLogTestClass::TestThreadSaveLog(true);  // true = to file
   mitkLogTestClass::TestEnableDisableBackends();
+  mitkLogTestClass::TestLogStreamsReleasedOutOfOrder();
   // TODO actually test file somehow?
 
   // always end with this!
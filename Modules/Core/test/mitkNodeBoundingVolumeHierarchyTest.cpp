@@ -0,0 +1,171 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+// std includes
+#include <algorithm>
+// MITK includes
+#include <mitkDataNode.h>
+#include <mitkNodeBoundingVolumeHierarchy.h>
+
+class mitkNodeBoundingVolumeHierarchyTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkNodeBoundingVolumeHierarchyTestSuite);
+  MITK_TEST(IntersectSegment_ReturnsOnlyHitNodes);
+  MITK_TEST(SetBounds_UpdatesExistingNode);
+  MITK_TEST(Remove_RemovesNode);
+  MITK_TEST(SetBounds_InvalidBoundsRemoveNode);
+  MITK_TEST(IntersectSegment_ScalesWithBoxSize);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::NodeBoundingVolumeHierarchy m_Hierarchy;
+  std::vector<mitk::DataNode::Pointer> m_Nodes;
+
+  static mitk::NodeBoundingVolumeHierarchy::BoundsType UnitBoxAt(double x, double y, double z)
+  {
+    return { { x, x + 1.0, y, y + 1.0, z, z + 1.0 } };
+  }
+
+  static mitk::Point3D MakePoint(double x, double y, double z)
+  {
+    mitk::Point3D point;
+    point[0] = x;
+    point[1] = y;
+    point[2] = z;
+    return point;
+  }
+
+  bool Contains(const mitk::NodeBoundingVolumeHierarchy::NodeListType &nodes, const mitk::DataNode *node)
+  {
+    return std::find(nodes.begin(), nodes.end(), node) != nodes.end();
+  }
+
+public:
+  void setUp() override
+  {
+    m_Hierarchy.Clear();
+    m_Nodes.clear();
+
+    // 10 x 10 grid of unit boxes in the plane z = 0 with a spacing of 2
+    for (int y = 0; y < 10; ++y)
+    {
+      for (int x = 0; x < 10; ++x)
+      {
+        auto node = mitk::DataNode::New();
+        m_Hierarchy.SetBounds(node, UnitBoxAt(2.0 * x, 2.0 * y, 0.0));
+        m_Nodes.push_back(node);
+      }
+    }
+  }
+
+  void tearDown() override
+  {
+    m_Hierarchy.Clear();
+    m_Nodes.clear();
+  }
+
+  void IntersectSegment_ReturnsOnlyHitNodes()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::size_t(100), m_Hierarchy.GetNumberOfNodes());
+
+    // ray along z through the box at grid position (3, 4)
+    auto hits = m_Hierarchy.IntersectSegment(MakePoint(6.5, 8.5, -10.0), MakePoint(6.5, 8.5, 10.0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), hits.size());
+    CPPUNIT_ASSERT(hits.front() == m_Nodes[43].GetPointer());
+
+    // ray through the gap between the boxes
+    hits = m_Hierarchy.IntersectSegment(MakePoint(5.5, 8.5, -10.0), MakePoint(5.5, 8.5, 10.0));
+    CPPUNIT_ASSERT(hits.empty());
+
+    // the tolerance enlarges the boxes
+    hits = m_Hierarchy.IntersectSegment(MakePoint(5.5, 8.5, -10.0), MakePoint(5.5, 8.5, 10.0), 0.6);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), hits.size());
+    CPPUNIT_ASSERT(Contains(hits, m_Nodes[42]) && Contains(hits, m_Nodes[43]));
+
+    // segment ending in front of the boxes
+    hits = m_Hierarchy.IntersectSegment(MakePoint(6.5, 8.5, -10.0), MakePoint(6.5, 8.5, -1.0));
+    CPPUNIT_ASSERT(hits.empty());
+
+    // diagonal ray within the plane of the boxes hits the boxes on the diagonal
+    hits = m_Hierarchy.IntersectSegment(MakePoint(-1.0, -1.0, 0.5), MakePoint(20.0, 20.0, 0.5));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), hits.size());
+    for (int i = 0; i < 10; ++i)
+      CPPUNIT_ASSERT(Contains(hits, m_Nodes[11 * i]));
+  }
+
+  void SetBounds_UpdatesExistingNode()
+  {
+    // build the hierarchy, then move one box to an empty location
+    m_Hierarchy.IntersectSegment(MakePoint(0.5, 0.5, -10.0), MakePoint(0.5, 0.5, 10.0));
+    m_Hierarchy.SetBounds(m_Nodes[0], UnitBoxAt(100.0, 100.0, 0.0));
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(100), m_Hierarchy.GetNumberOfNodes());
+    CPPUNIT_ASSERT(m_Hierarchy.IntersectSegment(MakePoint(0.5, 0.5, -10.0), MakePoint(0.5, 0.5, 10.0)).empty());
+
+    auto hits = m_Hierarchy.IntersectSegment(MakePoint(100.5, 100.5, -10.0), MakePoint(100.5, 100.5, 10.0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), hits.size());
+    CPPUNIT_ASSERT(hits.front() == m_Nodes[0].GetPointer());
+  }
+
+  void Remove_RemovesNode()
+  {
+    m_Hierarchy.Remove(m_Nodes[43]);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(99), m_Hierarchy.GetNumberOfNodes());
+    CPPUNIT_ASSERT(!m_Hierarchy.Contains(m_Nodes[43]));
+    CPPUNIT_ASSERT(m_Hierarchy.IntersectSegment(MakePoint(6.5, 8.5, -10.0), MakePoint(6.5, 8.5, 10.0)).empty());
+
+    auto hits = m_Hierarchy.IntersectSegment(MakePoint(8.5, 8.5, -10.0), MakePoint(8.5, 8.5, 10.0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), hits.size());
+    CPPUNIT_ASSERT(hits.front() == m_Nodes[44].GetPointer());
+  }
+
+  void SetBounds_InvalidBoundsRemoveNode()
+  {
+    mitk::NodeBoundingVolumeHierarchy::BoundsType invalidBounds = { { 1.0, -1.0, 1.0, -1.0, 1.0, -1.0 } };
+    m_Hierarchy.SetBounds(m_Nodes[0], invalidBounds);
+
+    CPPUNIT_ASSERT(!m_Hierarchy.Contains(m_Nodes[0]));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(99), m_Hierarchy.GetNumberOfNodes());
+  }
+
+  void IntersectSegment_ScalesWithBoxSize()
+  {
+    m_Hierarchy.Clear();
+
+    // a box that is smaller than the machine epsilon and a segment that crosses it diagonally
+    auto tinyNode = mitk::DataNode::New();
+    const double size = 1e-18;
+    m_Hierarchy.SetBounds(tinyNode, { { 0.0, size, 0.0, size, 0.0, size } });
+
+    auto nodes = m_Hierarchy.IntersectSegment(MakePoint(-size, -size, 0.5 * size), MakePoint(2.0 * size, 2.0 * size, 0.5 * size));
+    CPPUNIT_ASSERT(Contains(nodes, tinyNode));
+
+    nodes = m_Hierarchy.IntersectSegment(MakePoint(-size, 2.0 * size, 0.5 * size), MakePoint(0.5 * size, 3.5 * size, 0.5 * size));
+    CPPUNIT_ASSERT(!Contains(nodes, tinyNode));
+
+    // a flat box (e.g. the bounds of a 2D slice) is hit by a segment that is perpendicular to it
+    auto flatNode = mitk::DataNode::New();
+    m_Hierarchy.SetBounds(flatNode, { { 0.0, 100.0, 0.0, 100.0, 5.0, 5.0 } });
+
+    nodes = m_Hierarchy.IntersectSegment(MakePoint(50.0, 50.0, -10.0), MakePoint(50.0, 50.0, 10.0));
+    CPPUNIT_ASSERT(Contains(nodes, flatNode));
+
+    nodes = m_Hierarchy.IntersectSegment(MakePoint(150.0, 50.0, -10.0), MakePoint(150.0, 50.0, 10.0));
+    CPPUNIT_ASSERT(!Contains(nodes, flatNode));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkNodeBoundingVolumeHierarchy)
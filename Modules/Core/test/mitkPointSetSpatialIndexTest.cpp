@@ -0,0 +1,263 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+// std includes
+#include <cmath>
+#include <random>
+#include <thread>
+// MITK includes
+#include <mitkPointSet.h>
+
+/**
+ * Compares the index based searches of mitk::PointSet with a linear search over all points.
+ */
+class mitkPointSetSpatialIndexTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPointSetSpatialIndexTestSuite);
+  MITK_TEST(SearchPoint_EqualsLinearSearch);
+  MITK_TEST(SearchPoint_PrefersSmallestIdOfEqualPoints);
+  MITK_TEST(SearchPoint_FollowsEdits);
+  MITK_TEST(Searches_FollowIncrementalEdits);
+  MITK_TEST(SearchPoint_ConcurrentSearches);
+  MITK_TEST(SearchPointsInSlab_EqualsLinearSearch);
+  MITK_TEST(InsertPoints_AppendsPoints);
+  MITK_TEST(RemovePoints_RemovesExistingPoints);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::PointSet::Pointer m_PointSet;
+  std::mt19937 m_Generator;
+
+  mitk::Point3D RandomPoint()
+  {
+    std::uniform_real_distribution<double> distribution(-50.0, 50.0);
+    mitk::Point3D point;
+    mitk::FillVector3D(point, distribution(m_Generator), distribution(m_Generator), distribution(m_Generator));
+    return point;
+  }
+
+  /** SearchPoint measures distances in index coordinates of the point set */
+  int LinearSearchPoint(const mitk::Point3D &point, double distance) const
+  {
+    mitk::Point3D indexPoint;
+    m_PointSet->GetGeometry()->WorldToIndex(point, indexPoint);
+
+    int best = -1;
+    double bestDistance = distance;
+    for (auto it = m_PointSet->Begin(); it != m_PointSet->End(); ++it)
+    {
+      const double pointDistance = indexPoint.EuclideanDistanceTo(it->Value());
+      if (pointDistance < bestDistance)
+      {
+        best = it->Index();
+        bestDistance = pointDistance;
+      }
+    }
+    return best;
+  }
+
+  mitk::PointSet::PointIdentifierListType LinearSearchPointsInSlab(const mitk::Point3D &origin,
+                                                                   const mitk::Vector3D &normal,
+                                                                   double halfThickness) const
+  {
+    mitk::Vector3D unitNormal = normal;
+    unitNormal.Normalize();
+
+    mitk::PointSet::PointIdentifierListType ids;
+    for (auto it = m_PointSet->Begin(); it != m_PointSet->End(); ++it)
+    {
+      const mitk::Vector3D difference = m_PointSet->GetPoint(it->Index()) - origin;
+      if (std::abs(difference * unitNormal) <= halfThickness)
+        ids.push_back(it->Index());
+    }
+    return ids;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Generator.seed(42);
+
+    m_PointSet = mitk::PointSet::New();
+    mitk::Vector3D spacing;
+    mitk::FillVector3D(spacing, 2.0, 1.0, 0.5);
+    m_PointSet->GetGeometry()->SetSpacing(spacing);
+
+    std::vector<mitk::Point3D> points;
+    for (int i = 0; i < 2000; ++i)
+      points.push_back(this->RandomPoint());
+
+    m_PointSet->InsertPoints(points);
+  }
+
+  void tearDown() override { m_PointSet = nullptr; }
+
+  void SearchPoint_EqualsLinearSearch()
+  {
+    for (int i = 0; i < 200; ++i)
+    {
+      const mitk::Point3D point = this->RandomPoint();
+      CPPUNIT_ASSERT_EQUAL(this->LinearSearchPoint(point, 5.0), m_PointSet->SearchPoint(point, 5.0));
+    }
+
+    // exact matches
+    for (mitk::PointSet::PointIdentifier id = 0; id < 2000; id += 97)
+    {
+      CPPUNIT_ASSERT_EQUAL(static_cast<int>(id), m_PointSet->SearchPoint(m_PointSet->GetPoint(id), 0.0));
+    }
+  }
+
+  void SearchPoint_PrefersSmallestIdOfEqualPoints()
+  {
+    const mitk::Point3D point = m_PointSet->GetPoint(1000);
+    m_PointSet->InsertPoint(point);
+    m_PointSet->InsertPoint(500, point);
+
+    CPPUNIT_ASSERT_EQUAL(500, m_PointSet->SearchPoint(point, 1.0));
+  }
+
+  void SearchPoint_FollowsEdits()
+  {
+    mitk::Point3D point;
+    mitk::FillVector3D(point, 100.0, 100.0, 100.0);
+
+    // build the index
+    CPPUNIT_ASSERT_EQUAL(-1, m_PointSet->SearchPoint(point, 1.0));
+
+    m_PointSet->SetPoint(7, point);
+    CPPUNIT_ASSERT_EQUAL(7, m_PointSet->SearchPoint(point, 1.0));
+
+    // RemovePointIfExists does not call Modified(), the index has to notice anyway
+    m_PointSet->RemovePointIfExists(7);
+    CPPUNIT_ASSERT_EQUAL(-1, m_PointSet->SearchPoint(point, 1.0));
+  }
+
+  void Searches_FollowIncrementalEdits()
+  {
+    mitk::Point3D origin;
+    mitk::FillVector3D(origin, 3.0, -2.0, 1.0);
+    mitk::Vector3D normal;
+    mitk::FillVector3D(normal, 0.3, -0.5, 0.8);
+
+    // build the index, then edit single points like an interaction does; the edits
+    // exceed the number of pending edits after which the index is rebuilt
+    m_PointSet->SearchPoint(this->RandomPoint(), 1.0);
+    for (int i = 0; i < 300; ++i)
+    {
+      switch (i % 3)
+      {
+        case 0:
+          m_PointSet->SetPoint(i, this->RandomPoint());
+          break;
+        case 1:
+          m_PointSet->InsertPoint(this->RandomPoint());
+          break;
+        default:
+          m_PointSet->RemovePointIfExists(i);
+          break;
+      }
+
+      const mitk::Point3D point = this->RandomPoint();
+      CPPUNIT_ASSERT_EQUAL(this->LinearSearchPoint(point, 5.0), m_PointSet->SearchPoint(point, 5.0));
+      CPPUNIT_ASSERT(this->LinearSearchPointsInSlab(origin, normal, 2.0) == m_PointSet->SearchPointsInSlab(origin, normal, 2.0));
+    }
+
+    // edits of the points container that bypass the point set are still picked up
+    m_PointSet->SetPoint(0, this->RandomPoint());
+    mitk::Point3D point;
+    mitk::FillVector3D(point, 100.0, 100.0, 100.0);
+    m_PointSet->GetPointSet()->GetPoints()->InsertElement(0, point);
+    CPPUNIT_ASSERT_EQUAL(0, m_PointSet->SearchPoint(m_PointSet->GetPoint(0), 1.0));
+  }
+
+  void SearchPoint_ConcurrentSearches()
+  {
+    // the index has to be updated by the first search
+    m_PointSet->SetPoint(0, this->RandomPoint());
+    m_PointSet->GetPointSet()->GetPoints()->Modified();
+
+    std::vector<mitk::Point3D> points;
+    std::vector<int> expectedIds;
+    for (int i = 0; i < 400; ++i)
+    {
+      points.push_back(this->RandomPoint());
+      expectedIds.push_back(this->LinearSearchPoint(points.back(), 5.0));
+    }
+
+    const unsigned int numberOfThreads = 4;
+    std::vector<int> ids(points.size(), -2);
+    std::vector<std::thread> threads;
+    for (unsigned int k = 0; k < numberOfThreads; ++k)
+    {
+      threads.emplace_back([&, k]() {
+        for (std::size_t i = k; i < points.size(); i += numberOfThreads)
+          ids[i] = m_PointSet->SearchPoint(points[i], 5.0);
+      });
+    }
+
+    for (auto &thread : threads)
+      thread.join();
+
+    CPPUNIT_ASSERT(expectedIds == ids);
+  }
+
+  void SearchPointsInSlab_EqualsLinearSearch()
+  {
+    mitk::Point3D origin;
+    mitk::FillVector3D(origin, 3.0, -2.0, 1.0);
+
+    const double normals[][3] = {{0.0, 0.0, 1.0}, {1.0, 0.0, 0.0}, {0.3, -0.5, 0.8}};
+    for (const auto &n : normals)
+    {
+      mitk::Vector3D normal;
+      mitk::FillVector3D(normal, n[0], n[1], n[2]);
+
+      const auto ids = m_PointSet->SearchPointsInSlab(origin, normal, 2.0);
+      const auto expectedIds = this->LinearSearchPointsInSlab(origin, normal, 2.0);
+
+      CPPUNIT_ASSERT(!expectedIds.empty());
+      CPPUNIT_ASSERT(expectedIds == ids);
+    }
+  }
+
+  void InsertPoints_AppendsPoints()
+  {
+    const auto mTime = m_PointSet->GetMTime();
+
+    std::vector<mitk::Point3D> points(3, this->RandomPoint());
+    m_PointSet->InsertPoints(points);
+
+    CPPUNIT_ASSERT(m_PointSet->GetMTime() > mTime);
+    CPPUNIT_ASSERT_EQUAL(2003, m_PointSet->GetSize());
+    CPPUNIT_ASSERT(m_PointSet->IndexExists(2002));
+    CPPUNIT_ASSERT(mitk::Equal(points.front(), m_PointSet->GetPoint(2001), mitk::eps, true));
+  }
+
+  void RemovePoints_RemovesExistingPoints()
+  {
+    const mitk::Point3D point = m_PointSet->GetPoint(10);
+    CPPUNIT_ASSERT_EQUAL(10, m_PointSet->SearchPoint(point, 0.0));
+
+    mitk::PointSet::PointIdentifierListType ids = {10, 11, 12, 5000};
+    CPPUNIT_ASSERT_EQUAL(3u, m_PointSet->RemovePoints(ids));
+    CPPUNIT_ASSERT_EQUAL(1997, m_PointSet->GetSize());
+    CPPUNIT_ASSERT(!m_PointSet->IndexExists(11));
+    CPPUNIT_ASSERT_EQUAL(-1, m_PointSet->SearchPoint(point, 0.0));
+
+    CPPUNIT_ASSERT_EQUAL(0u, m_PointSet->RemovePoints(ids));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPointSetSpatialIndex)
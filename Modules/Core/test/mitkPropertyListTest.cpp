@@ -254,6 +254,38 @@ int mitkPropertyListTest(int /*argc*/, char * /*argv*/ [])
     }
     std::cout << "[PASSED]" << std::endl;
   }
+  {
+    std::cout << "Testing GetProperty() with interned key: ";
+    const mitk::PropertyKey key("keyed");
+    mitk::BoolProperty::Pointer keyedProp = mitk::BoolProperty::New(true);
+    propList->SetProperty("keyed", keyedProp);
+    if (propList->GetProperty(key) != keyedProp.GetPointer() || key != mitk::PropertyKey(std::string("keyed")))
+    {
+      std::cout << "[FAILED]" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "[PASSED]" << std::endl;
+
+    std::cout << "Testing GetProperty() with interned key after ReplaceProperty(): ";
+    mitk::BoolProperty::Pointer replacedProp = mitk::BoolProperty::New(false);
+    propList->ReplaceProperty("keyed", replacedProp);
+    bool keyedValue = true;
+    if (propList->GetProperty(key) != replacedProp.GetPointer() || !propList->GetPropertyValue(key, keyedValue) || keyedValue)
+    {
+      std::cout << "[FAILED]" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "[PASSED]" << std::endl;
+
+    std::cout << "Testing GetProperty() with interned key after RemoveProperty(): ";
+    propList->RemoveProperty("keyed");
+    if (propList->GetProperty(key) != nullptr || propList->GetProperty(mitk::PropertyKey()) != nullptr)
+    {
+      std::cout << "[FAILED]" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "[PASSED]" << std::endl;
+  }
 
   std::cout << "Testing SetProperty() with no property (nullptr): ";
   tBefore = propList->GetMTime();
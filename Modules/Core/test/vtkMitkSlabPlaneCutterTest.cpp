@@ -0,0 +1,111 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+// VTK includes
+#include <vtkCutter.h>
+#include <vtkMitkSlabPlaneCutter.h>
+#include <vtkPlane.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+
+class vtkMitkSlabPlaneCutterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(vtkMitkSlabPlaneCutterTestSuite);
+  MITK_TEST(Cut_EqualsVtkCutter);
+  MITK_TEST(Cut_OnlyProcessesStraddlingCells);
+  MITK_TEST(Cut_OutsideOfInput_IsEmpty);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  vtkSmartPointer<vtkPolyData> m_Sphere;
+  vtkSmartPointer<vtkPlane> m_Plane;
+  vtkSmartPointer<vtkMitkSlabPlaneCutter> m_SlabCutter;
+  vtkSmartPointer<vtkCutter> m_Cutter;
+
+public:
+  void setUp() override
+  {
+    auto sphereSource = vtkSmartPointer<vtkSphereSource>::New();
+    sphereSource->SetRadius(10.0);
+    sphereSource->SetThetaResolution(100);
+    sphereSource->SetPhiResolution(100);
+    sphereSource->Update();
+    m_Sphere = sphereSource->GetOutput();
+
+    m_Plane = vtkSmartPointer<vtkPlane>::New();
+
+    m_SlabCutter = vtkSmartPointer<vtkMitkSlabPlaneCutter>::New();
+    m_SlabCutter->SetPlane(m_Plane);
+    m_SlabCutter->SetInputData(m_Sphere);
+
+    m_Cutter = vtkSmartPointer<vtkCutter>::New();
+    m_Cutter->SetCutFunction(m_Plane);
+    m_Cutter->SetInputData(m_Sphere);
+  }
+
+  void tearDown() override
+  {
+    m_Sphere = nullptr;
+    m_Plane = nullptr;
+    m_SlabCutter = nullptr;
+    m_Cutter = nullptr;
+  }
+
+  void Cut_EqualsVtkCutter()
+  {
+    const double normals[][3] = { { 0.0, 0.0, 1.0 }, { 1.0, 0.0, 0.0 }, { 0.3, -0.5, 0.8 } };
+
+    for (const auto &normal : normals)
+    {
+      m_Plane->SetNormal(normal[0], normal[1], normal[2]);
+
+      for (double offset = -9.5; offset < 10.0; offset += 1.3)
+      {
+        m_Plane->SetOrigin(offset * normal[0], offset * normal[1], offset * normal[2]);
+
+        m_SlabCutter->Update();
+        m_Cutter->Update();
+
+        CPPUNIT_ASSERT_EQUAL(m_Cutter->GetOutput()->GetNumberOfPoints(), m_SlabCutter->GetOutput()->GetNumberOfPoints());
+        CPPUNIT_ASSERT_EQUAL(m_Cutter->GetOutput()->GetNumberOfLines(), m_SlabCutter->GetOutput()->GetNumberOfLines());
+        CPPUNIT_ASSERT(m_SlabCutter->GetOutput()->GetNumberOfLines() > 0);
+      }
+    }
+  }
+
+  void Cut_OnlyProcessesStraddlingCells()
+  {
+    m_Plane->SetNormal(0.0, 0.0, 1.0);
+    m_Plane->SetOrigin(0.0, 0.0, 2.0);
+    m_SlabCutter->Update();
+
+    // A plane through a sphere with 100 x 100 facets hits a few hundred facets
+    CPPUNIT_ASSERT(m_SlabCutter->GetNumberOfCutCells() > 0);
+    CPPUNIT_ASSERT(m_SlabCutter->GetNumberOfCutCells() < m_Sphere->GetNumberOfCells() / 10);
+  }
+
+  void Cut_OutsideOfInput_IsEmpty()
+  {
+    m_Plane->SetNormal(0.0, 1.0, 0.0);
+    m_Plane->SetOrigin(0.0, 20.0, 0.0);
+    m_SlabCutter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), m_SlabCutter->GetNumberOfCutCells());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), m_SlabCutter->GetOutput()->GetNumberOfPoints());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(vtkMitkSlabPlaneCutter)
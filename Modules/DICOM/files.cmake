@@ -14,6 +14,8 @@ set(CPP_FILES
   mitkDICOMImageFrameInfo.cpp
   mitkDICOMIOHelper.cpp
   mitkDICOMGenericImageFrameInfo.cpp
+  mitkDICOMTagTable.cpp
+  mitkDICOMTagTableImageFrameInfo.cpp
   mitkDICOMDatasetAccessingImageFrameInfo.cpp
   mitkDICOMSortCriterion.cpp
   mitkDICOMSortByTag.cpp
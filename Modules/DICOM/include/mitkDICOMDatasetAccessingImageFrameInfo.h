@@ -35,6 +35,7 @@ namespace mitk
 
   protected:
       DICOMDatasetAccessingImageFrameInfo(const std::string& filename = "", unsigned int frameNo = 0);
+      DICOMDatasetAccessingImageFrameInfo(const std::shared_ptr<const std::string>& sharedFilename, unsigned int frameNo);
       ~DICOMDatasetAccessingImageFrameInfo() override;
 
     private:
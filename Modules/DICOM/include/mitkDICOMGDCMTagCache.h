@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkDICOMGDCMTagCache_h
 
 #include "mitkDICOMTagCache.h"
+#include "mitkDICOMTagTable.h"
 
 #include <set>
 #include <memory>
@@ -26,6 +27,9 @@ namespace mitk
   /**
     \ingroup DICOMModule
     \brief Tag cache implementation used by the DICOMGDCMTagScanner.
+
+    The scanned values are stored in a DICOMTagTable; tags with a numeric
+    value representation (according to the GDCM dictionary) get numeric columns.
   */
   class MITKDICOM_EXPORT DICOMGDCMTagCache : public DICOMTagCache
   {
@@ -45,6 +49,9 @@ namespace mitk
 
       const gdcm::Scanner& GetScanner() const;
 
+      /// \brief The table with the scanned values of all frames.
+      const DICOMTagTable* GetTagTable() const;
+
   protected:
 
       DICOMGDCMTagCache();
@@ -54,6 +61,8 @@ namespace mitk
 
       std::shared_ptr<gdcm::Scanner> m_Scanner;
 
+      DICOMTagTable::Pointer m_TagTable;
+
       DICOMDatasetAccessingImageFrameList m_ScanResult;
 
     private:
@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include "mitkDICOMTagCache.h"
 #include "mitkDICOMGenericImageFrameInfo.h"
 
+#include <unordered_map>
+
 namespace mitk
 {
 
@@ -46,6 +48,7 @@ namespace mitk
       ~DICOMGenericTagCache() override;
 
       DICOMDatasetAccessingImageFrameList m_ScanResult;
+      std::unordered_map<const DICOMImageFrameInfo*, DICOMDatasetAccessingImageFrameInfo*> m_FrameLookup;
 
     private:
       DICOMGenericTagCache(const DICOMGenericTagCache&);
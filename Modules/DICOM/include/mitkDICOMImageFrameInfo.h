@@ -18,6 +18,8 @@ found in the LICENSE file.
 
 #include "MitkDICOMExports.h"
 
+#include <memory>
+
 namespace mitk
 {
   /**
@@ -30,10 +32,13 @@ namespace mitk
   */
   class MITKDICOM_EXPORT DICOMImageFrameInfo : public itk::LightObject
   {
+      /// storage of Filename; frames of the same file may share one string (declared first, it is initialized before Filename)
+      const std::shared_ptr<const std::string> m_SharedFilename;
+
     public:
 
       /// absolute filename
-      const std::string Filename;
+      const std::string& Filename;
       /// frame number, starting with 0
       const unsigned int FrameNo;
 
@@ -45,9 +50,13 @@ namespace mitk
 
       bool operator==(const DICOMImageFrameInfo& other) const;
 
+      /// \brief The shared string of Filename (see DICOMTagTable).
+      std::shared_ptr<const std::string> GetSharedFilename() const;
+
     protected:
 
       DICOMImageFrameInfo(const std::string& filename = "", unsigned int frameNo = 0);
+      DICOMImageFrameInfo(const std::shared_ptr<const std::string>& sharedFilename, unsigned int frameNo);
   };
 
   typedef std::vector<DICOMImageFrameInfo::Pointer> DICOMImageFrameList;
@@ -43,6 +43,12 @@ class MITKDICOM_EXPORT DICOMSortByTag : public DICOMSortCriterion
 
     double NumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to) const override;
 
+    /// \brief The sort key is the numerical tag value (see NumericCompare()).
+    unsigned int GetSortKeySize() const override;
+    void ExtractSortKey(const mitk::DICOMDatasetAccess* dataset, double* key) const override;
+    int CompareSortKeys(const double* leftKey, const double* rightKey) const override;
+    double SortKeyDistance(const double* fromKey, const double* toKey) const override;
+
     void Print(std::ostream& os) const override;
 
     bool operator==(const DICOMSortCriterion& other) const override;
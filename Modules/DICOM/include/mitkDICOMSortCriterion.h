@@ -18,6 +18,8 @@ found in the LICENSE file.
 
 #include "mitkDICOMDatasetAccess.h"
 
+#include <vector>
+
 namespace mitk
 {
 
@@ -55,6 +57,26 @@ class MITKDICOM_EXPORT DICOMSortCriterion : public itk::LightObject
     /// \brief The fallback criterion.
     DICOMSortCriterion::ConstPointer GetSecondaryCriterion() const;
 
+    /// \brief Number of values of the pre-parsed sort key of this criterion (secondary criteria not included).
+    /// Sorters extract the keys of all datasets once (ExtractSortKey()) and then sort by comparing
+    /// the keys (CompareSortKeys()), so tag values are not parsed again for every comparison.
+    /// The default implementation returns 0, i.e. the criterion does not support sort keys
+    /// and IsLeftBeforeRight() is used instead.
+    virtual unsigned int GetSortKeySize() const;
+
+    /// \brief Parse the tag values of a dataset into a sort key of GetSortKeySize() values.
+    virtual void ExtractSortKey(const mitk::DICOMDatasetAccess* dataset, double* key) const;
+
+    /// \brief Compare two sort keys with the semantics of IsLeftBeforeRight(), but without referring to the secondary criterion.
+    /// \return negative if left is before right, positive if right is before left, 0 if the secondary criterion has to decide.
+    virtual int CompareSortKeys(const double* leftKey, const double* rightKey) const;
+
+    /// \brief NumericDistance() between the datasets of two sort keys.
+    virtual double SortKeyDistance(const double* fromKey, const double* toKey) const;
+
+    /// \brief Whether this criterion and all secondary criteria support sort keys.
+    bool AllCriteriaSupportSortKeys() const;
+
     /// brief describe this class in given stream.
     virtual void Print(std::ostream& os) const = 0;
 
@@ -67,6 +89,11 @@ class MITKDICOM_EXPORT DICOMSortCriterion : public itk::LightObject
 
     bool NextLevelIsLeftBeforeRight(const mitk::DICOMDatasetAccess* left, const mitk::DICOMDatasetAccess* right) const;
 
+    /// \brief Numbers of a tag value for ExtractSortKey().
+    /// Frames of a DICOMTagTable provide the numbers that were parsed once per distinct value by the table,
+    /// other datasets are parsed with DICOMTagTable::ParseNumbers().
+    static void GetTagValueAsNumbers(const mitk::DICOMDatasetAccess* dataset, const DICOMTag& tag, std::vector<double>& numbers);
+
     explicit DICOMSortCriterion(const DICOMSortCriterion& other);
     DICOMSortCriterion& operator=(const DICOMSortCriterion& other);
 
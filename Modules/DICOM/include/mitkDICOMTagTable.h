@@ -0,0 +1,141 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMTagTable_h
+#define mitkDICOMTagTable_h
+
+#include "itkObjectFactory.h"
+#include "mitkCommon.h"
+
+#include "mitkDICOMDatasetAccess.h"
+
+#include <map>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+namespace mitk
+{
+  /**
+    \ingroup DICOMModule
+    \brief Columnar storage of the scanned tag values of many frames.
+
+    The table has one row per frame and one column per (explicit) tag path.
+    A column stores one integer per row that refers to the distinct values
+    of the column, so frames with the same value (e.g. Series Instance UID or
+    Image Orientation (Patient)) share one string. Filenames are stored once
+    per file and shared with the frame infos of the file.
+
+    Columns of tags with a numeric value representation (see IsNumericVR())
+    additionally store the parsed numbers of each distinct value.
+
+    Tag caches use DICOMTagTableImageFrameInfo to offer the DICOMDatasetAccess
+    interface for the rows of the table.
+  */
+  class MITKDICOM_EXPORT DICOMTagTable : public itk::LightObject
+  {
+    public:
+
+      mitkClassMacroItkParent( DICOMTagTable, itk::LightObject );
+      itkFactorylessNewMacro( DICOMTagTable );
+
+      typedef std::size_t RowIndexType;
+      typedef std::size_t ColumnIndexType;
+
+      /// \brief Add a row for a frame. Returns the existing row if the frame was added before.
+      RowIndexType AddFrame(const std::string& filename, unsigned int frameNo = 0);
+
+      /// \brief Find the row of a frame. Returns false if the table has no row for it.
+      bool FindFrame(const std::string& filename, unsigned int frameNo, RowIndexType& row) const;
+
+      RowIndexType GetNumberOfRows() const;
+
+      const std::string& GetFilename(RowIndexType row) const;
+      std::shared_ptr<const std::string> GetSharedFilename(RowIndexType row) const;
+      unsigned int GetFrameNo(RowIndexType row) const;
+
+      /** \brief Add a column for a tag path. Returns the existing column if the path was added before.
+      \param path Tag path of the column. It must be explicit (no wildcards).
+      \param isNumeric If true, the parsed numbers of the values are stored as well (see GetTagValueAsNumbers()).
+      */
+      ColumnIndexType AddColumn(const DICOMTagPath& path, bool isNumeric = false);
+
+      ColumnIndexType GetNumberOfColumns() const;
+      const DICOMTagPath& GetColumnPath(ColumnIndexType column) const;
+      bool IsNumericColumn(ColumnIndexType column) const;
+
+      /// \brief Set the value of a frame (row) for a tag path (column). An existing value will be overwritten.
+      void SetValue(RowIndexType row, ColumnIndexType column, const std::string& value);
+
+      /// \brief Same semantics as DICOMDatasetAccess::GetTagValueAsString() for the frame of the passed row.
+      DICOMDatasetFinding GetTagValue(RowIndexType row, const DICOMTag& tag) const;
+
+      /// \brief Same semantics as DICOMDatasetAccess::GetTagValueAsString() for the frame of the passed row.
+      DICOMDatasetAccess::FindingsListType GetTagValue(RowIndexType row, const DICOMTagPath& path) const;
+
+      /** \brief Get the parsed numbers (one per value multiplicity) of the value of a numeric column.
+      \return false if the tag has no numeric column or the frame has no value for it.
+      */
+      bool GetTagValueAsNumbers(RowIndexType row, const DICOMTag& tag, std::vector<double>& numbers) const;
+
+      /// \brief Whether values of the passed value representation (e.g. "DS") are numbers.
+      static bool IsNumericVR(const std::string& vr);
+
+      /** \brief Parse a (multi-valued) tag value like the numeric columns do.
+      The value is split at backslashes and each part is converted with OFStandard::atof(), so empty or
+      invalid parts are 0 and the number of parsed values equals the value multiplicity.
+      */
+      static void ParseNumbers(const std::string& value, std::vector<double>& numbers);
+
+    protected:
+
+      DICOMTagTable();
+      ~DICOMTagTable() override;
+
+    private:
+
+      struct Column
+      {
+        DICOMTagPath path;
+        bool isNumeric = false;
+
+        /// ID of the value for each row; 0 indicates that the row has no value.
+        std::vector<unsigned int> valueIDs;
+        /// Distinct values; ID n refers to values[n-1] (keys of idForValue).
+        std::vector<const std::string*> values;
+        std::unordered_map<std::string, unsigned int> idForValue;
+        /// Numeric columns only: the numbers of value ID n are numbers[numberOffsets[n-1]] to numbers[numberOffsets[n]-1].
+        std::vector<std::size_t> numberOffsets;
+        std::vector<double> numbers;
+      };
+
+      unsigned int GetValueID(const Column& column, RowIndexType row) const;
+
+      DICOMTagTable(const DICOMTagTable&);
+      DICOMTagTable& operator=(const DICOMTagTable&);
+
+      std::vector<std::shared_ptr<const std::string>> m_Filenames;
+      std::unordered_map<std::string_view, unsigned int> m_FileIndexForFilename;
+
+      std::vector<unsigned int> m_FileIndexOfRow;
+      std::vector<unsigned int> m_FrameNoOfRow;
+      std::unordered_map<unsigned long long, RowIndexType> m_RowForFrame;
+
+      /// Columns are not moved when columns are added, values refers to the keys of idForValue.
+      std::vector<std::unique_ptr<Column>> m_Columns;
+      std::map<DICOMTagPath, ColumnIndexType> m_ColumnForPath;
+      /// Columns of paths that consist of one explicit tag (fast lookup for GetTagValue(row, tag)).
+      std::map<DICOMTag, ColumnIndexType> m_ColumnForTag;
+  };
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMTagTableImageFrameInfo_h
+#define mitkDICOMTagTableImageFrameInfo_h
+
+#include "mitkDICOMDatasetAccessingImageFrameInfo.h"
+#include "mitkDICOMTagTable.h"
+
+namespace mitk
+{
+  /**
+    \ingroup DICOMModule
+    \brief Image frame info with data access to one row of a DICOMTagTable.
+
+    The frame info only references the table, so the tag values and the
+    filename are stored once in the table and not per frame.
+  */
+  class MITKDICOM_EXPORT DICOMTagTableImageFrameInfo : public DICOMDatasetAccessingImageFrameInfo
+  {
+    public:
+
+      mitkClassMacro(DICOMTagTableImageFrameInfo, DICOMDatasetAccessingImageFrameInfo);
+      mitkNewMacro2Param( DICOMTagTableImageFrameInfo, const DICOMTagTable*, DICOMTagTable::RowIndexType );
+
+      ~DICOMTagTableImageFrameInfo() override;
+
+      DICOMDatasetFinding GetTagValueAsString(const DICOMTag&) const override;
+
+      FindingsListType GetTagValueAsString(const DICOMTagPath& path) const override;
+
+      std::string GetFilenameIfAvailable() const override;
+
+      /// \brief See DICOMTagTable::GetTagValueAsNumbers().
+      bool GetTagValueAsNumbers(const DICOMTag& tag, std::vector<double>& numbers) const;
+
+      const DICOMTagTable* GetTable() const;
+      DICOMTagTable::RowIndexType GetRow() const;
+
+    protected:
+
+      DICOMTagTableImageFrameInfo(const DICOMTagTable* table, DICOMTagTable::RowIndexType row);
+
+      DICOMTagTable::ConstPointer m_Table;
+      const DICOMTagTable::RowIndexType m_Row;
+
+    private:
+      Self& operator = (const Self&);
+      DICOMTagTableImageFrameInfo(const Self&);
+  };
+}
+
+#endif
@@ -42,6 +42,12 @@ class MITKDICOM_EXPORT SortByImagePositionPatient : public DICOMSortCriterion
 
     double NumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to) const override;
 
+    /// \brief The sort key contains the parsed image orientation (right and up vector) and the image position.
+    unsigned int GetSortKeySize() const override;
+    void ExtractSortKey(const mitk::DICOMDatasetAccess* dataset, double* key) const override;
+    int CompareSortKeys(const double* leftKey, const double* rightKey) const override;
+    double SortKeyDistance(const double* fromKey, const double* toKey) const override;
+
     void Print(std::ostream& os) const override;
 
     bool operator==(const DICOMSortCriterion& other) const override;
@@ -55,6 +61,7 @@ class MITKDICOM_EXPORT SortByImagePositionPatient : public DICOMSortCriterion
     SortByImagePositionPatient& operator=(const SortByImagePositionPatient& other);
 
     double InternalNumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to, bool& possible) const;
+    static double InternalSortKeyDistance(const double* fromKey, const double* toKey, bool& possible);
 
   private:
 };
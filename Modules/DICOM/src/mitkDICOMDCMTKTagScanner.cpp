@@ -11,12 +11,13 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkDICOMDCMTKTagScanner.h"
-#include "mitkDICOMGenericImageFrameInfo.h"
+#include "mitkDICOMTagTableImageFrameInfo.h"
 
 #include <mitkFileSystem.h>
 
 #include <dcmtk/dcmdata/dcfilefo.h>
 #include <dcmtk/dcmdata/dcpath.h>
+#include <dcmtk/dcmdata/dcvr.h>
 
 mitk::DICOMDCMTKTagScanner::DICOMDCMTKTagScanner()
 {
@@ -110,6 +111,7 @@ void mitk::DICOMDCMTKTagScanner::Scan()
     processor.setItemWildcardSupport(true);
 
     DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
+    DICOMTagTable::Pointer tagTable = DICOMTagTable::New();
 
     for (const auto& fileName : this->m_InputFilenames)
     {
@@ -124,7 +126,7 @@ void mitk::DICOMDCMTKTagScanner::Scan()
       }
       else
       {
-        DICOMGenericImageFrameInfo::Pointer info = DICOMGenericImageFrameInfo::New(fileName);
+        const auto row = tagTable->AddFrame(fileName);
 
         for (const auto& path : this->m_ScannedTags)
         {
@@ -152,13 +154,15 @@ void mitk::DICOMDCMTKTagScanner::Scan()
                 cond = element->getOFStringArray(value);
                 if (cond.good())
                 {
-                  info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
+                  const bool isNumeric = DICOMTagTable::IsNumericVR(DcmVR(element->getVR()).getVRName());
+                  const auto column = tagTable->AddColumn(DcmPathToTagPath(finding), isNumeric);
+                  tagTable->SetValue(row, column, std::string(value.c_str()));
                 }
               }
             }
           }
         }
-        newCache->AddFrameInfo(info);
+        newCache->AddFrameInfo(DICOMTagTableImageFrameInfo::New(tagTable, row));
       }
     }
 
@@ -18,6 +18,12 @@ mitk::DICOMDatasetAccessingImageFrameInfo
 {
 }
 
+mitk::DICOMDatasetAccessingImageFrameInfo
+::DICOMDatasetAccessingImageFrameInfo(const std::shared_ptr<const std::string>& sharedFilename, unsigned int frameNo)
+:DICOMImageFrameInfo(sharedFilename, frameNo)
+{
+}
+
 mitk::DICOMDatasetAccessingImageFrameInfo
 ::~DICOMDatasetAccessingImageFrameInfo()
 {
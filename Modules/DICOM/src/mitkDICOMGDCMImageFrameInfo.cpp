@@ -21,14 +21,14 @@ mitk::DICOMGDCMImageFrameInfo
 
 mitk::DICOMGDCMImageFrameInfo
 ::DICOMGDCMImageFrameInfo(const DICOMImageFrameInfo::Pointer& frameinfo)
-:DICOMDatasetAccessingImageFrameInfo(frameinfo->Filename, frameinfo->FrameNo)
+:DICOMDatasetAccessingImageFrameInfo(frameinfo->GetSharedFilename(), frameinfo->FrameNo)
 ,m_TagForValue()
 {
 }
 
 mitk::DICOMGDCMImageFrameInfo
 ::DICOMGDCMImageFrameInfo(const DICOMImageFrameInfo::Pointer& frameinfo, gdcm::Scanner::TagToValue const& tagToValueMapping)
-:DICOMDatasetAccessingImageFrameInfo(frameinfo->Filename, frameinfo->FrameNo)
+:DICOMDatasetAccessingImageFrameInfo(frameinfo->GetSharedFilename(), frameinfo->FrameNo)
 ,m_TagForValue(tagToValueMapping)
 {
 }
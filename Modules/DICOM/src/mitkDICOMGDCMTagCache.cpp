@@ -12,7 +12,19 @@ found in the LICENSE file.
 
 #include "mitkDICOMGDCMTagCache.h"
 #include "mitkDICOMEnums.h"
-#include "mitkDICOMGDCMImageFrameInfo.h"
+#include "mitkDICOMTagTableImageFrameInfo.h"
+
+#include <gdcmDicts.h>
+#include <gdcmGlobal.h>
+
+namespace
+{
+  bool IsNumericTag(const gdcm::Tag& tag)
+  {
+    const gdcm::DictEntry& entry = gdcm::Global::GetInstance().GetDicts().GetDictEntry(tag);
+    return mitk::DICOMTagTable::IsNumericVR(gdcm::VR::GetVRString(entry.GetVR()));
+  }
+}
 
 mitk::DICOMGDCMTagCache::DICOMGDCMTagCache()
 {
@@ -26,12 +38,10 @@ mitk::DICOMDatasetFinding mitk::DICOMGDCMTagCache::GetTagValue( DICOMImageFrameI
 {
   assert( frame );
 
-  for ( auto frameIter = m_ScanResult.cbegin(); frameIter != m_ScanResult.cend(); ++frameIter )
+  DICOMTagTable::RowIndexType row = 0;
+  if ( m_TagTable.IsNotNull() && m_TagTable->FindFrame( frame->Filename, frame->FrameNo, row ) )
   {
-    if ( **frameIter == *frame )
-    {
-      return (*frameIter)->GetTagValueAsString(tag);
-    }
+    return m_TagTable->GetTagValue( row, tag );
   }
 
   if ( m_ScannedTags.find( tag ) != m_ScannedTags.cend() )
@@ -87,13 +97,42 @@ mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const
   m_InputFilenames = inputFiles;
   m_Scanner = scanner;
 
+  m_TagTable = DICOMTagTable::New();
   m_ScanResult.clear();
   m_ScanResult.reserve(m_InputFilenames.size());
 
+  std::map<gdcm::Tag, DICOMTagTable::ColumnIndexType> columnForTag;
+  for (const auto& tag : m_ScannedTags)
+  {
+    const gdcm::Tag gdcmTag(tag.GetGroup(), tag.GetElement());
+    columnForTag[gdcmTag] = m_TagTable->AddColumn(DICOMTagPath(tag), IsNumericTag(gdcmTag));
+  }
+
   for (auto inputIter = m_InputFilenames.cbegin(); inputIter != m_InputFilenames.cend(); ++inputIter)
   {
-    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0),
-      m_Scanner->GetMapping(inputIter->c_str())).GetPointer());
+    const auto row = m_TagTable->AddFrame(*inputIter, 0);
+
+    const gdcm::Scanner::TagToValue& mapping = m_Scanner->GetMapping(inputIter->c_str());
+    for (const auto& [gdcmTag, rawValue] : mapping)
+    {
+      auto columnFinding = columnForTag.find(gdcmTag);
+      if (columnFinding == columnForTag.end())
+      {
+        const DICOMTag tag(gdcmTag.GetGroup(), gdcmTag.GetElement());
+        columnFinding = columnForTag.emplace(gdcmTag, m_TagTable->AddColumn(DICOMTagPath(tag), IsNumericTag(gdcmTag))).first;
+      }
+
+      // same value as DICOMGDCMImageFrameInfo provides: without trailing whitespace
+      std::string value;
+      if (rawValue != nullptr)
+      {
+        value = rawValue;
+        value.erase(value.find_last_not_of(" \n\r\t") + 1);
+      }
+      m_TagTable->SetValue(row, columnFinding->second, value);
+    }
+
+    m_ScanResult.push_back(DICOMTagTableImageFrameInfo::New(m_TagTable, row).GetPointer());
   }
 }
 
@@ -102,3 +141,9 @@ mitk::DICOMGDCMTagCache::GetScanner() const
 {
   return *(this->m_Scanner);
 }
+
+const mitk::DICOMTagTable*
+mitk::DICOMGDCMTagCache::GetTagTable() const
+{
+  return m_TagTable.GetPointer();
+}
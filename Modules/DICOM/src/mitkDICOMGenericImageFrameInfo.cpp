@@ -21,7 +21,7 @@ mitk::DICOMGenericImageFrameInfo
 
 mitk::DICOMGenericImageFrameInfo
 ::DICOMGenericImageFrameInfo(const DICOMImageFrameInfo::Pointer& frameinfo)
-:DICOMDatasetAccessingImageFrameInfo(frameinfo->Filename, frameinfo->FrameNo)
+:DICOMDatasetAccessingImageFrameInfo(frameinfo->GetSharedFilename(), frameinfo->FrameNo)
 {
 }
 
@@ -39,12 +39,10 @@ mitk::DICOMGenericTagCache::GetTagValue(DICOMImageFrameInfo* frame, const DICOMT
 {
   FindingsListType result;
 
-  for (auto info : m_ScanResult)
+  const auto finding = m_FrameLookup.find(frame);
+  if (finding != m_FrameLookup.cend())
   {
-    if (info == frame)
-    {
-      result = info->GetTagValueAsString(path);
-    }
+    result = finding->second->GetTagValueAsString(path);
   }
   return result;
 }
@@ -58,10 +56,12 @@ void
 mitk::DICOMGenericTagCache::AddFrameInfo(DICOMDatasetAccessingImageFrameInfo* info)
 {
   m_ScanResult.push_back(info);
+  m_FrameLookup[info] = info;
 };
 
 void
 mitk::DICOMGenericTagCache::Reset()
 {
   m_ScanResult.clear();
+  m_FrameLookup.clear();
 };
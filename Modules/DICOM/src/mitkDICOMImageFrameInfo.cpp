@@ -14,11 +14,27 @@ found in the LICENSE file.
 
 mitk::DICOMImageFrameInfo
 ::DICOMImageFrameInfo(const std::string& filename, unsigned int frameNo)
-:Filename(filename)
+:m_SharedFilename(std::make_shared<const std::string>(filename))
+,Filename(*m_SharedFilename)
 ,FrameNo(frameNo)
 {
 }
 
+mitk::DICOMImageFrameInfo
+::DICOMImageFrameInfo(const std::shared_ptr<const std::string>& sharedFilename, unsigned int frameNo)
+:m_SharedFilename(sharedFilename ? sharedFilename : std::make_shared<const std::string>())
+,Filename(*m_SharedFilename)
+,FrameNo(frameNo)
+{
+}
+
+std::shared_ptr<const std::string>
+mitk::DICOMImageFrameInfo
+::GetSharedFilename() const
+{
+  return m_SharedFilename;
+}
+
 bool
 mitk::DICOMImageFrameInfo
 ::operator==(const DICOMImageFrameInfo& other) const
@@ -175,3 +175,40 @@ mitk::DICOMSortByTag
   return toDouble - fromDouble;
   // TODO second-level compare?
 }
+
+unsigned int
+mitk::DICOMSortByTag
+::GetSortKeySize() const
+{
+  return 1;
+}
+
+void
+mitk::DICOMSortByTag
+::ExtractSortKey(const mitk::DICOMDatasetAccess* dataset, double* key) const
+{
+  assert(dataset);
+
+  // same conversion as in NumericCompare(), which only parses the first value; missing values are 0
+  std::vector<double> numbers;
+  GetTagValueAsNumbers(dataset, m_Tag, numbers);
+  key[0] = numbers.empty() ? 0.0 : numbers.front();
+}
+
+int
+mitk::DICOMSortByTag
+::CompareSortKeys(const double* leftKey, const double* rightKey) const
+{
+  if (leftKey[0] != rightKey[0])
+  {
+    return leftKey[0] < rightKey[0] ? -1 : 1;
+  }
+  return 0;
+}
+
+double
+mitk::DICOMSortByTag
+::SortKeyDistance(const double* fromKey, const double* toKey) const
+{
+  return toKey[0] - fromKey[0];
+}
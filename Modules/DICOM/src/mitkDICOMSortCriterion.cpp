@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkDICOMSortCriterion.h"
+#include "mitkDICOMTagTableImageFrameInfo.h"
 
 mitk::DICOMSortCriterion
 ::DICOMSortCriterion(DICOMSortCriterion::Pointer secondaryCriterion)
@@ -67,6 +68,62 @@ mitk::DICOMSortCriterion
   return allTags;
 }
 
+unsigned int
+mitk::DICOMSortCriterion
+::GetSortKeySize() const
+{
+  return 0;
+}
+
+void
+mitk::DICOMSortCriterion
+::ExtractSortKey(const mitk::DICOMDatasetAccess* /*dataset*/, double* /*key*/) const
+{
+}
+
+int
+mitk::DICOMSortCriterion
+::CompareSortKeys(const double* /*leftKey*/, const double* /*rightKey*/) const
+{
+  return 0;
+}
+
+double
+mitk::DICOMSortCriterion
+::SortKeyDistance(const double* /*fromKey*/, const double* /*toKey*/) const
+{
+  return 0.0;
+}
+
+bool
+mitk::DICOMSortCriterion
+::AllCriteriaSupportSortKeys() const
+{
+  const DICOMSortCriterion* criterionToCheck = this;
+  while (criterionToCheck)
+  {
+    if (criterionToCheck->GetSortKeySize() == 0)
+    {
+      return false;
+    }
+    criterionToCheck = criterionToCheck->m_SecondaryCriterion.GetPointer();
+  }
+
+  return true;
+}
+
+void
+mitk::DICOMSortCriterion
+::GetTagValueAsNumbers(const mitk::DICOMDatasetAccess* dataset, const DICOMTag& tag, std::vector<double>& numbers)
+{
+  const auto* frame = dynamic_cast<const DICOMTagTableImageFrameInfo*>(dataset);
+  if (frame == nullptr || !frame->GetTagValueAsNumbers(tag, numbers))
+  {
+    // invalid findings have an empty value, which is parsed like an empty value of the table
+    DICOMTagTable::ParseNumbers(dataset->GetTagValueAsString(tag).value, numbers);
+  }
+}
+
 bool
 mitk::DICOMSortCriterion
 ::NextLevelIsLeftBeforeRight(const mitk::DICOMDatasetAccess* left, const mitk::DICOMDatasetAccess* right) const
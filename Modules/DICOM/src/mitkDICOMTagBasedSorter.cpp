@@ -14,6 +14,114 @@ found in the LICENSE file.
 
 #include <algorithm>
 #include <iomanip>
+#include <numeric>
+#include <unordered_map>
+
+namespace
+{
+  /**
+    \brief Sort keys of all levels of a DICOMSortCriterion chain for a list of datasets.
+
+    The keys are extracted once per dataset and stored in one array (one row per dataset),
+    so sorting compares numbers instead of parsing tag values for every comparison.
+  */
+  class SortKeyTable
+  {
+  public:
+    SortKeyTable(const mitk::DICOMSortCriterion* criterion, const mitk::DICOMDatasetList& datasets)
+      : m_Datasets(datasets)
+    {
+      for (auto level = criterion; level != nullptr; level = level->GetSecondaryCriterion().GetPointer())
+      {
+        m_Levels.emplace_back(level, m_Stride);
+        m_Stride += level->GetSortKeySize();
+      }
+
+      m_Keys.resize(m_Stride * datasets.size());
+      for (std::size_t i = 0; i < datasets.size(); ++i)
+      {
+        for (const auto& level : m_Levels)
+        {
+          level.first->ExtractSortKey(datasets[i], this->GetKey(i, level.second));
+        }
+      }
+    }
+
+    /// Same decision as DICOMSortCriterion::IsLeftBeforeRight() of the whole chain (including the final pointer comparison).
+    bool IsLeftBeforeRight(std::size_t left, std::size_t right) const
+    {
+      for (const auto& level : m_Levels)
+      {
+        const int comparison = level.first->CompareSortKeys(this->GetKey(left, level.second), this->GetKey(right, level.second));
+        if (comparison != 0)
+        {
+          return comparison < 0;
+        }
+      }
+      return (void*)m_Datasets[left] < (void*)m_Datasets[right];
+    }
+
+    /// Same value as DICOMSortCriterion::NumericDistance() of the first criterion.
+    double NumericDistance(std::size_t from, std::size_t to) const
+    {
+      return m_Levels.front().first->SortKeyDistance(this->GetKey(from, 0), this->GetKey(to, 0));
+    }
+
+    /// Sorts the datasets and the keys; afterwards row i belongs to the i-th dataset of the sorted list.
+    void Sort()
+    {
+      std::vector<std::size_t> order(m_Datasets.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [this](std::size_t left, std::size_t right) { return this->IsLeftBeforeRight(left, right); });
+
+      mitk::DICOMDatasetList sortedDatasets;
+      sortedDatasets.reserve(order.size());
+      std::vector<double> sortedKeys;
+      sortedKeys.reserve(m_Keys.size());
+      for (const auto index : order)
+      {
+        sortedDatasets.push_back(m_Datasets[index]);
+        sortedKeys.insert(sortedKeys.end(), m_Keys.begin() + index * m_Stride, m_Keys.begin() + (index + 1) * m_Stride);
+      }
+      m_Datasets.swap(sortedDatasets);
+      m_Keys.swap(sortedKeys);
+    }
+
+    const mitk::DICOMDatasetList& GetDatasets() const
+    {
+      return m_Datasets;
+    }
+
+  private:
+    double* GetKey(std::size_t row, std::size_t offset)
+    {
+      return m_Keys.data() + row * m_Stride + offset;
+    }
+
+    const double* GetKey(std::size_t row, std::size_t offset) const
+    {
+      return m_Keys.data() + row * m_Stride + offset;
+    }
+
+    mitk::DICOMDatasetList m_Datasets;
+    std::vector<std::pair<const mitk::DICOMSortCriterion*, std::size_t>> m_Levels;
+    std::size_t m_Stride = 0;
+    std::vector<double> m_Keys;
+  };
+
+  struct GroupKeyHash
+  {
+    std::size_t operator()(const std::vector<std::size_t>& key) const
+    {
+      std::size_t hash = key.size();
+      for (const auto value : key)
+      {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      }
+      return hash;
+    }
+  };
+}
 
 mitk::DICOMTagBasedSorter::CutDecimalPlaces
 ::CutDecimalPlaces(unsigned int precision)
@@ -352,20 +460,75 @@ mitk::DICOMTagBasedSorter::GroupIDToListType
 mitk::DICOMTagBasedSorter
 ::SplitInputGroups(SplitReasonListType& splitReasons)
 {
-  DICOMDatasetList input = GetInput(); // copy
+  const DICOMDatasetList& input = GetInput();
+
+  // The (processed) values of each distinguishing tag are mapped to integer IDs once per distinct raw value.
+  // Datasets are grouped by the hashed ID tuple and the group ID string is only built once per group.
+  // All frames of a series usually share the same values, so the tag value processors run only a few times.
+  const std::size_t numberOfTags = m_DistinguishingTags.size();
+  std::vector<std::unordered_map<std::string, std::size_t>> rawValueIDs(numberOfTags);
+  std::vector<std::unordered_map<std::string, std::size_t>> processedValueIDs(numberOfTags);
+  std::vector<std::vector<std::string>> processedValues(numberOfTags);
+
+  std::unordered_map<std::vector<std::size_t>, std::size_t, GroupKeyHash> groupIndexForKey;
+  std::vector<std::vector<std::size_t>> groupKeys;
+  std::vector<DICOMDatasetList> groupDatasets;
+
+  std::vector<std::size_t> key(numberOfTags);
+  for (auto dataset : input)
+  {
+    assert(dataset);
 
-  GroupIDToListType listForGroupID;
+    for (std::size_t tagIndex = 0; tagIndex < numberOfTags; ++tagIndex)
+    {
+      const DICOMTag& tag = m_DistinguishingTags[tagIndex];
+      const DICOMDatasetFinding rawTagValue = dataset->GetTagValueAsString(tag);
+
+      // invalid findings are never processed, so they get their own key space
+      const std::string rawKey = (rawTagValue.isValid ? "v" : "i") + rawTagValue.value;
+      auto rawFinding = rawValueIDs[tagIndex].find(rawKey);
+      if (rawFinding == rawValueIDs[tagIndex].end())
+      {
+        const TagValueProcessor* processor = this->GetTagValueProcessorForDistinguishingTag(tag);
+        const std::string processedTagValue = (processor != nullptr && rawTagValue.isValid) ? (*processor)(rawTagValue.value) : rawTagValue.value;
+
+        auto processedFinding = processedValueIDs[tagIndex].find(processedTagValue);
+        if (processedFinding == processedValueIDs[tagIndex].end())
+        {
+          processedFinding = processedValueIDs[tagIndex].emplace(processedTagValue, processedValues[tagIndex].size()).first;
+          processedValues[tagIndex].push_back(processedTagValue);
+        }
+        rawFinding = rawValueIDs[tagIndex].emplace(rawKey, processedFinding->second).first;
+      }
+      key[tagIndex] = rawFinding->second;
+    }
+
+    auto groupFinding = groupIndexForKey.find(key);
+    if (groupFinding == groupIndexForKey.end())
+    {
+      groupFinding = groupIndexForKey.emplace(key, groupDatasets.size()).first;
+      groupKeys.push_back(key);
+      groupDatasets.emplace_back();
+    }
+    groupDatasets[groupFinding->second].push_back(dataset);
+  }
 
-  for (auto dsIter = input.cbegin();
-       dsIter != input.cend();
-       ++dsIter)
+  GroupIDToListType listForGroupID;
+  for (std::size_t groupIndex = 0; groupIndex < groupDatasets.size(); ++groupIndex)
   {
-    DICOMDatasetAccess* dataset = *dsIter;
-    assert(dataset);
+    // same ID as BuildGroupID() would generate for each dataset of the group
+    std::stringstream groupID;
+    groupID << "g";
+    for (std::size_t tagIndex = 0; tagIndex < numberOfTags; ++tagIndex)
+    {
+      const DICOMTag& tag = m_DistinguishingTags[tagIndex];
+      groupID << tag.GetGroup() << tag.GetElement(); // make group/element part of the id to cover empty tags
+      groupID << "#" << processedValues[tagIndex][groupKeys[groupIndex][tagIndex]];
+    }
 
-    const std::string groupID = this->BuildGroupID( dataset );
-    MITK_DEBUG << "Group ID for for " << dataset->GetFilenameIfAvailable() << ": " << groupID;
-    listForGroupID[groupID].push_back(dataset);
+    MITK_DEBUG << "Group ID for " << groupDatasets[groupIndex].size() << " datasets: " << groupID.str();
+    DICOMDatasetList& groupList = listForGroupID[groupID.str()];
+    groupList.insert(groupList.end(), groupDatasets[groupIndex].begin(), groupDatasets[groupIndex].end());
   }
 
   MITK_DEBUG << "After tag based splitting: " << listForGroupID.size() << " groups";
@@ -414,6 +577,9 @@ mitk::DICOMTagBasedSorter
     //    - sorting order (ascending, descending)
     //    - sort numerically
     //    - ... ?
+    // If all criteria provide sort keys, the keys are extracted once per dataset and reused by step 2.
+    const bool useSortKeys = m_SortCriterion->AllCriteriaSupportSortKeys();
+    std::map<std::string, SortKeyTable> sortKeysForGroup;
 #ifdef MBILOG_ENABLE_DEBUG
     unsigned int groupIndex(0);
 #endif
@@ -438,7 +604,17 @@ mitk::DICOMTagBasedSorter
 #endif // #ifdef MBILOG_ENABLE_DEBUG
 
 
-      std::sort( dsList.begin(), dsList.end(), ParameterizedDatasetSort( m_SortCriterion ) );
+      if (useSortKeys)
+      {
+        SortKeyTable sortKeys(m_SortCriterion.GetPointer(), dsList);
+        sortKeys.Sort();
+        dsList = sortKeys.GetDatasets();
+        sortKeysForGroup.emplace(gIter->first, std::move(sortKeys));
+      }
+      else
+      {
+        std::sort( dsList.begin(), dsList.end(), ParameterizedDatasetSort( m_SortCriterion ) );
+      }
 
 #ifdef MBILOG_ENABLE_DEBUG
       MITK_DEBUG << "   --------------------------------------------------------------------------------";
@@ -470,6 +646,7 @@ mitk::DICOMTagBasedSorter
         std::string groupKeyStr = groupKey.str();
 
         DICOMDatasetList& dsList = gIter->second;
+        const SortKeyTable* sortKeys = useSortKeys ? &sortKeysForGroup.at(gIter->first) : nullptr;
 
         DICOMDatasetAccess* previousDS(nullptr);
         unsigned int dsIndex(0);
@@ -485,7 +662,9 @@ mitk::DICOMTagBasedSorter
             // for the second and every following dataset:
             // let the sorting criterion calculate a "distance"
             // if the distance is not 1, split off a new group!
-            const double currentDistance = m_SortCriterion->NumericDistance(previousDS, *dataset);
+            const double currentDistance = sortKeys != nullptr
+              ? sortKeys->NumericDistance(dsIndex - 1, dsIndex)
+              : m_SortCriterion->NumericDistance(previousDS, *dataset);
             if (constantDistanceInitialized)
             {
               if (fabs(currentDistance - constantDistance) < fabs(constantDistance * 0.01)) // ok, deviation of up to 1% of distance is tolerated
@@ -576,7 +755,16 @@ mitk::DICOMTagBasedSorter
       firstSlices.push_back(gIter->second.front());
     }
 
-    std::sort( firstSlices.begin(), firstSlices.end(), ParameterizedDatasetSort( m_SortCriterion ) );
+    if (useSortKeys)
+    {
+      SortKeyTable sortKeys(m_SortCriterion.GetPointer(), firstSlices);
+      sortKeys.Sort();
+      firstSlices = sortKeys.GetDatasets();
+    }
+    else
+    {
+      std::sort( firstSlices.begin(), firstSlices.end(), ParameterizedDatasetSort( m_SortCriterion ) );
+    }
 
     GroupIDToListType sortedResultBlocks;
     SplitReasonListType sortedResultsReasons;
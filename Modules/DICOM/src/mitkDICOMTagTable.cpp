@@ -0,0 +1,313 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMTagTable.h"
+#include "mitkExceptionMacro.h"
+
+#include "dcmtk/ofstd/ofstd.h"
+
+namespace
+{
+  unsigned long long FrameKey(unsigned int fileIndex, unsigned int frameNo)
+  {
+    return (static_cast<unsigned long long>(fileIndex) << 32) | frameNo;
+  }
+}
+
+mitk::DICOMTagTable
+::DICOMTagTable()
+{
+}
+
+mitk::DICOMTagTable
+::~DICOMTagTable()
+{
+}
+
+mitk::DICOMTagTable::RowIndexType
+mitk::DICOMTagTable
+::AddFrame(const std::string& filename, unsigned int frameNo)
+{
+  unsigned int fileIndex = 0;
+  const auto fileFinding = m_FileIndexForFilename.find(filename);
+  if (fileFinding != m_FileIndexForFilename.cend())
+  {
+    fileIndex = fileFinding->second;
+  }
+  else
+  {
+    fileIndex = static_cast<unsigned int>(m_Filenames.size());
+    m_Filenames.push_back(std::make_shared<const std::string>(filename));
+    // the key refers to the shared string, which does not move
+    m_FileIndexForFilename.emplace(*m_Filenames.back(), fileIndex);
+  }
+
+  const auto frameFinding = m_RowForFrame.find(FrameKey(fileIndex, frameNo));
+  if (frameFinding != m_RowForFrame.cend())
+  {
+    return frameFinding->second;
+  }
+
+  const RowIndexType row = m_FileIndexOfRow.size();
+  m_FileIndexOfRow.push_back(fileIndex);
+  m_FrameNoOfRow.push_back(frameNo);
+  m_RowForFrame.emplace(FrameKey(fileIndex, frameNo), row);
+  return row;
+}
+
+bool
+mitk::DICOMTagTable
+::FindFrame(const std::string& filename, unsigned int frameNo, RowIndexType& row) const
+{
+  const auto fileFinding = m_FileIndexForFilename.find(filename);
+  if (fileFinding == m_FileIndexForFilename.cend())
+  {
+    return false;
+  }
+
+  const auto frameFinding = m_RowForFrame.find(FrameKey(fileFinding->second, frameNo));
+  if (frameFinding == m_RowForFrame.cend())
+  {
+    return false;
+  }
+
+  row = frameFinding->second;
+  return true;
+}
+
+mitk::DICOMTagTable::RowIndexType
+mitk::DICOMTagTable
+::GetNumberOfRows() const
+{
+  return m_FileIndexOfRow.size();
+}
+
+const std::string&
+mitk::DICOMTagTable
+::GetFilename(RowIndexType row) const
+{
+  return *(m_Filenames.at(m_FileIndexOfRow.at(row)));
+}
+
+std::shared_ptr<const std::string>
+mitk::DICOMTagTable
+::GetSharedFilename(RowIndexType row) const
+{
+  return m_Filenames.at(m_FileIndexOfRow.at(row));
+}
+
+unsigned int
+mitk::DICOMTagTable
+::GetFrameNo(RowIndexType row) const
+{
+  return m_FrameNoOfRow.at(row);
+}
+
+mitk::DICOMTagTable::ColumnIndexType
+mitk::DICOMTagTable
+::AddColumn(const DICOMTagPath& path, bool isNumeric)
+{
+  const auto finding = m_ColumnForPath.find(path);
+  if (finding != m_ColumnForPath.cend())
+  {
+    return finding->second;
+  }
+
+  if (path.IsEmpty() || !path.IsExplicit())
+  {
+    mitkThrow() << "Only non-empty explicit tag paths (no wildcards) are allowed as columns of DICOMTagTable. Passed tag path:" << path.ToStr();
+  }
+
+  auto column = std::make_unique<Column>();
+  column->path = path;
+  column->isNumeric = isNumeric;
+  column->numberOffsets.push_back(0);
+
+  const ColumnIndexType columnIndex = m_Columns.size();
+  m_Columns.push_back(std::move(column));
+  m_ColumnForPath.emplace(path, columnIndex);
+
+  if (path.Size() == 1 && path.GetFirstNode().type == DICOMTagPath::NodeInfo::NodeType::Element)
+  {
+    m_ColumnForTag.emplace(path.GetFirstNode().tag, columnIndex);
+  }
+
+  return columnIndex;
+}
+
+mitk::DICOMTagTable::ColumnIndexType
+mitk::DICOMTagTable
+::GetNumberOfColumns() const
+{
+  return m_Columns.size();
+}
+
+const mitk::DICOMTagPath&
+mitk::DICOMTagTable
+::GetColumnPath(ColumnIndexType column) const
+{
+  return m_Columns.at(column)->path;
+}
+
+bool
+mitk::DICOMTagTable
+::IsNumericColumn(ColumnIndexType column) const
+{
+  return m_Columns.at(column)->isNumeric;
+}
+
+void
+mitk::DICOMTagTable
+::SetValue(RowIndexType row, ColumnIndexType columnIndex, const std::string& value)
+{
+  if (row >= this->GetNumberOfRows())
+  {
+    mitkThrow() << "Invalid row index " << row << " of DICOMTagTable with " << this->GetNumberOfRows() << " rows.";
+  }
+
+  Column& column = *(m_Columns.at(columnIndex));
+
+  auto finding = column.idForValue.find(value);
+  if (finding == column.idForValue.end())
+  {
+    finding = column.idForValue.emplace(value, static_cast<unsigned int>(column.values.size() + 1)).first;
+    column.values.push_back(&(finding->first));
+
+    if (column.isNumeric)
+    {
+      // parse once per distinct value
+      std::vector<double> numbers;
+      ParseNumbers(value, numbers);
+      column.numbers.insert(column.numbers.end(), numbers.begin(), numbers.end());
+      column.numberOffsets.push_back(column.numbers.size());
+    }
+  }
+
+  if (column.valueIDs.size() <= row)
+  {
+    column.valueIDs.resize(this->GetNumberOfRows(), 0);
+  }
+  column.valueIDs[row] = finding->second;
+}
+
+unsigned int
+mitk::DICOMTagTable
+::GetValueID(const Column& column, RowIndexType row) const
+{
+  return row < column.valueIDs.size() ? column.valueIDs[row] : 0;
+}
+
+mitk::DICOMDatasetFinding
+mitk::DICOMTagTable
+::GetTagValue(RowIndexType row, const DICOMTag& tag) const
+{
+  DICOMDatasetFinding result;
+
+  const auto finding = m_ColumnForTag.find(tag);
+  if (finding != m_ColumnForTag.cend())
+  {
+    const Column& column = *(m_Columns[finding->second]);
+    const auto valueID = this->GetValueID(column, row);
+    if (valueID > 0)
+    {
+      result.isValid = true;
+      result.value = *(column.values[valueID - 1]);
+      result.path = column.path;
+    }
+  }
+  return result;
+}
+
+mitk::DICOMDatasetAccess::FindingsListType
+mitk::DICOMTagTable
+::GetTagValue(RowIndexType row, const DICOMTagPath& path) const
+{
+  DICOMDatasetAccess::FindingsListType result;
+
+  if (path.IsExplicit())
+  {
+    const auto finding = m_ColumnForPath.find(path);
+    if (finding != m_ColumnForPath.cend())
+    {
+      const Column& column = *(m_Columns[finding->second]);
+      const auto valueID = this->GetValueID(column, row);
+      if (valueID > 0)
+      {
+        result.emplace_back(true, *(column.values[valueID - 1]), column.path);
+      }
+    }
+    return result;
+  }
+
+  for (const auto& [columnPath, columnIndex] : m_ColumnForPath)
+  {
+    if (path.Equals(columnPath))
+    {
+      const Column& column = *(m_Columns[columnIndex]);
+      const auto valueID = this->GetValueID(column, row);
+      if (valueID > 0)
+      {
+        result.emplace_back(true, *(column.values[valueID - 1]), column.path);
+      }
+    }
+  }
+  return result;
+}
+
+bool
+mitk::DICOMTagTable
+::GetTagValueAsNumbers(RowIndexType row, const DICOMTag& tag, std::vector<double>& numbers) const
+{
+  const auto finding = m_ColumnForTag.find(tag);
+  if (finding == m_ColumnForTag.cend())
+  {
+    return false;
+  }
+
+  const Column& column = *(m_Columns[finding->second]);
+  const auto valueID = this->GetValueID(column, row);
+  if (!column.isNumeric || valueID == 0)
+  {
+    return false;
+  }
+
+  numbers.assign(column.numbers.begin() + column.numberOffsets[valueID - 1], column.numbers.begin() + column.numberOffsets[valueID]);
+  return true;
+}
+
+void
+mitk::DICOMTagTable
+::ParseNumbers(const std::string& value, std::vector<double>& numbers)
+{
+  numbers.clear();
+
+  // multiple values are separated by backslashes
+  std::string::size_type start = 0;
+  while (start <= value.size())
+  {
+    auto end = value.find('\\', start);
+    if (end == std::string::npos)
+    {
+      end = value.size();
+    }
+    numbers.push_back(OFStandard::atof(value.substr(start, end - start).c_str()));
+    start = end + 1;
+  }
+}
+
+bool
+mitk::DICOMTagTable
+::IsNumericVR(const std::string& vr)
+{
+  return vr == "DS" || vr == "IS" || vr == "FL" || vr == "FD"
+      || vr == "SS" || vr == "US" || vr == "SL" || vr == "UL";
+}
@@ -0,0 +1,67 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMTagTableImageFrameInfo.h"
+
+mitk::DICOMTagTableImageFrameInfo
+::DICOMTagTableImageFrameInfo(const DICOMTagTable* table, DICOMTagTable::RowIndexType row)
+:DICOMDatasetAccessingImageFrameInfo(table->GetSharedFilename(row), table->GetFrameNo(row))
+,m_Table(table)
+,m_Row(row)
+{
+}
+
+mitk::DICOMTagTableImageFrameInfo::
+~DICOMTagTableImageFrameInfo()
+{
+}
+
+mitk::DICOMDatasetFinding
+mitk::DICOMTagTableImageFrameInfo
+::GetTagValueAsString(const DICOMTag& tag) const
+{
+  return m_Table->GetTagValue(m_Row, tag);
+}
+
+mitk::DICOMDatasetAccess::FindingsListType
+mitk::DICOMTagTableImageFrameInfo::GetTagValueAsString(const DICOMTagPath& path) const
+{
+  return m_Table->GetTagValue(m_Row, path);
+}
+
+std::string
+mitk::DICOMTagTableImageFrameInfo
+::GetFilenameIfAvailable() const
+{
+  return this->Filename;
+}
+
+bool
+mitk::DICOMTagTableImageFrameInfo
+::GetTagValueAsNumbers(const DICOMTag& tag, std::vector<double>& numbers) const
+{
+  return m_Table->GetTagValueAsNumbers(m_Row, tag, numbers);
+}
+
+const mitk::DICOMTagTable*
+mitk::DICOMTagTableImageFrameInfo
+::GetTable() const
+{
+  return m_Table.GetPointer();
+}
+
+mitk::DICOMTagTable::RowIndexType
+mitk::DICOMTagTableImageFrameInfo
+::GetRow() const
+{
+  return m_Row;
+}
@@ -13,6 +13,8 @@ found in the LICENSE file.
 #include "mitkSortByImagePositionPatient.h"
 #include "mitkDICOMTag.h"
 
+#include <algorithm>
+
 mitk::SortByImagePositionPatient
 ::SortByImagePositionPatient(DICOMSortCriterion::Pointer secondaryCriterion)
 :DICOMSortCriterion(secondaryCriterion)
@@ -86,29 +88,80 @@ double
 mitk::SortByImagePositionPatient
 ::InternalNumericDistance(const mitk::DICOMDatasetAccess* left, const mitk::DICOMDatasetAccess* right, bool& possible) const
 {
-  // sort by distance to world origin, assuming (almost) equal orientation
+  double leftKey[9];
+  double rightKey[9];
+  this->ExtractSortKey(left, leftKey);
+  this->ExtractSortKey(right, rightKey);
+
+  return InternalSortKeyDistance(leftKey, rightKey, possible);
+}
+
+unsigned int
+mitk::SortByImagePositionPatient
+::GetSortKeySize() const
+{
+  return 9;
+}
+
+void
+mitk::SortByImagePositionPatient
+::ExtractSortKey(const mitk::DICOMDatasetAccess* dataset, double* key) const
+{
+  // key layout: right vector [0..2], up vector [3..5], image position [6..8]
   static const DICOMTag tagImagePositionPatient = DICOMTag(0x0020,0x0032); // Image Position (Patient)
   static const DICOMTag    tagImageOrientation = DICOMTag(0x0020, 0x0037); // Image Orientation
 
-  Vector3D leftRight; leftRight.Fill(0.0);
-  Vector3D leftUp; leftUp.Fill(0.0);
-  bool leftHasOrientation(false);
-  DICOMStringToOrientationVectors( left->GetTagValueAsString( tagImageOrientation ).value,
-                                   leftRight, leftUp, leftHasOrientation );
-
-  Vector3D rightRight; rightRight.Fill(0.0);
-  Vector3D rightUp; rightUp.Fill(0.0);
-  bool rightHasOrientation(false);
-  DICOMStringToOrientationVectors(right->GetTagValueAsString(tagImageOrientation).value,
-                                   rightRight, rightUp, rightHasOrientation );
-
-  Point3D leftOrigin; leftOrigin.Fill(0.0f);
-  bool leftHasOrigin(false);
-  leftOrigin = DICOMStringToPoint3D(left->GetTagValueAsString(tagImagePositionPatient).value, leftHasOrigin);
-
-  Point3D rightOrigin; rightOrigin.Fill(0.0f);
-  bool rightHasOrigin(false);
-  rightOrigin = DICOMStringToPoint3D(right->GetTagValueAsString(tagImagePositionPatient).value, rightHasOrigin);
+  // same conversion as DICOMStringToOrientationVectors() and DICOMStringToPoint3D(), but on the numbers
+  // that are parsed once per distinct value; values with a wrong multiplicity are 0
+  std::fill(key, key + 9, 0.0);
+
+  std::vector<double> numbers;
+  GetTagValueAsNumbers(dataset, tagImageOrientation, numbers);
+  if (numbers.size() == 6)
+  {
+    std::copy(numbers.begin(), numbers.end(), key);
+  }
+
+  GetTagValueAsNumbers(dataset, tagImagePositionPatient, numbers);
+  if (numbers.size() == 3)
+  {
+    std::copy(numbers.begin(), numbers.end(), key + 6);
+  }
+}
+
+int
+mitk::SortByImagePositionPatient
+::CompareSortKeys(const double* leftKey, const double* rightKey) const
+{
+  bool possible(false);
+  double distance = InternalSortKeyDistance(leftKey, rightKey, possible); // returns 0.0 if not possible
+  if (possible)
+  {
+    return distance > 0.0 ? -1 : 1;
+  }
+  return 0;
+}
+
+double
+mitk::SortByImagePositionPatient
+::SortKeyDistance(const double* fromKey, const double* toKey) const
+{
+  bool possible(false);
+  double retVal = InternalSortKeyDistance(fromKey, toKey, possible); // returns 0.0 if not possible
+  return possible ? retVal : 0.0;
+}
+
+double
+mitk::SortByImagePositionPatient
+::InternalSortKeyDistance(const double* leftKey, const double* rightKey, bool& possible)
+{
+  // sort by distance to world origin, assuming (almost) equal orientation
+  const double* leftRight = leftKey;
+  const double* leftUp = leftKey + 3;
+  const double* leftOrigin = leftKey + 6;
+  const double* rightRight = rightKey;
+  const double* rightUp = rightKey + 3;
+  const double* rightOrigin = rightKey + 6;
 
   //   we tolerate very small differences in image orientation, since we got to know about
   //   acquisitions where these values change across a single series (7th decimal digit)
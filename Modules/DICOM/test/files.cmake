@@ -3,6 +3,8 @@ set(MODULE_TESTS
   mitkDICOMDCMTKTagScannerTest.cpp
   mitkDICOMSimpleVolumeImportTest.cpp
   mitkDICOMTagPathTest.cpp
+  mitkDICOMTagTableTest.cpp
+  mitkDICOMSortCriterionTest.cpp
   mitkDICOMPropertyTest.cpp
 )
 
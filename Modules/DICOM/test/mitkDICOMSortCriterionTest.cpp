@@ -0,0 +1,149 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMDCMTKTagScanner.h"
+#include "mitkDICOMSortByTag.h"
+#include "mitkDICOMTagBasedSorter.h"
+#include "mitkSortByImagePositionPatient.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+namespace
+{
+  /**
+   * DICOMSortByTag without sort keys. A chain containing it is sorted by
+   * DICOMTagBasedSorter::ParameterizedDatasetSort, i.e. by IsLeftBeforeRight().
+   */
+  class ComparisonOnlySortByTag : public mitk::DICOMSortByTag
+  {
+  public:
+    mitkClassMacro(ComparisonOnlySortByTag, mitk::DICOMSortByTag);
+    mitkNewMacro2Param(ComparisonOnlySortByTag, const mitk::DICOMTag&, mitk::DICOMSortCriterion::Pointer);
+
+    unsigned int GetSortKeySize() const override { return 0; }
+
+  protected:
+    ComparisonOnlySortByTag(const mitk::DICOMTag& tag, mitk::DICOMSortCriterion::Pointer secondaryCriterion)
+      : DICOMSortByTag(tag, secondaryCriterion)
+    {
+    }
+  };
+}
+
+class mitkDICOMSortCriterionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMSortCriterionTestSuite);
+
+  MITK_TEST(SortKeys_ImagePositionPatient);
+  MITK_TEST(SortKeys_InstanceNumber);
+  MITK_TEST(SortKeys_InstanceNumber_StrictSorting);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  const mitk::DICOMTag m_SeriesInstanceUID = mitk::DICOMTag(0x0020, 0x000e);
+  const mitk::DICOMTag m_InstanceNumber = mitk::DICOMTag(0x0020, 0x0013);
+
+  mitk::StringList m_CTFiles;
+
+  mitk::DICOMTagBasedSorter::Pointer CreateSorter(mitk::DICOMSortCriterion::ConstPointer criterion, bool strictSorting) const
+  {
+    auto sorter = mitk::DICOMTagBasedSorter::New();
+    sorter->AddDistinguishingTag(m_SeriesInstanceUID);
+    sorter->SetSortCriterion(criterion);
+    sorter->SetStrictSorting(strictSorting);
+    return sorter;
+  }
+
+  /** Sorts the scanned fixtures with both criteria and checks that the outputs are identical.
+   * The criterion with sort keys is sorted via its keys, the reference criterion via ParameterizedDatasetSort.*/
+  void CheckSameOrder(mitk::DICOMSortCriterion::ConstPointer criterion, mitk::DICOMSortCriterion::ConstPointer reference, bool strictSorting) const
+  {
+    CPPUNIT_ASSERT(criterion->AllCriteriaSupportSortKeys());
+    CPPUNIT_ASSERT(!reference->AllCriteriaSupportSortKeys());
+
+    auto sorter = this->CreateSorter(criterion, strictSorting);
+    auto referenceSorter = this->CreateSorter(reference, strictSorting);
+
+    auto scanner = mitk::DICOMDCMTKTagScanner::New();
+    scanner->SetInputFiles(m_CTFiles);
+    scanner->AddTags(sorter->GetTagsOfInterest());
+    scanner->Scan();
+
+    // both sorters get the same input, so ties are broken the same way
+    const auto input = mitk::ConvertToDICOMDatasetList(scanner->GetFrameInfoList());
+    CPPUNIT_ASSERT_EQUAL(m_CTFiles.size(), input.size());
+
+    sorter->SetInput(input);
+    sorter->Sort();
+    referenceSorter->SetInput(input);
+    referenceSorter->Sort();
+
+    CPPUNIT_ASSERT_EQUAL(referenceSorter->GetNumberOfOutputs(), sorter->GetNumberOfOutputs());
+    for (unsigned int i = 0; i < sorter->GetNumberOfOutputs(); ++i)
+    {
+      const auto& output = sorter->GetOutput(i);
+      const auto& referenceOutput = referenceSorter->GetOutput(i);
+      CPPUNIT_ASSERT_EQUAL(referenceOutput.size(), output.size());
+      for (std::size_t j = 0; j < output.size(); ++j)
+      {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Sort keys and ParameterizedDatasetSort order output " + std::to_string(i) + " differently",
+          referenceOutput[j]->GetFilenameIfAvailable(), output[j]->GetFilenameIfAvailable());
+      }
+    }
+  }
+
+public:
+
+  void setUp() override
+  {
+    // unsorted, with a missing slice (103)
+    m_CTFiles.clear();
+    m_CTFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    m_CTFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    m_CTFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+    m_CTFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+  }
+
+  void tearDown() override
+  {
+  }
+
+  void SortKeys_ImagePositionPatient()
+  {
+    this->CheckSameOrder(
+      mitk::SortByImagePositionPatient::New(mitk::DICOMSortByTag::New(m_InstanceNumber).GetPointer()).GetPointer(),
+      mitk::SortByImagePositionPatient::New(ComparisonOnlySortByTag::New(m_InstanceNumber, nullptr).GetPointer()).GetPointer(),
+      false);
+  }
+
+  void SortKeys_InstanceNumber()
+  {
+    this->CheckSameOrder(
+      mitk::DICOMSortByTag::New(m_InstanceNumber).GetPointer(),
+      ComparisonOnlySortByTag::New(m_InstanceNumber, nullptr).GetPointer(),
+      false);
+  }
+
+  void SortKeys_InstanceNumber_StrictSorting()
+  {
+    // the distances of the first criterion decide about splitting at the missing slice
+    this->CheckSameOrder(
+      mitk::DICOMSortByTag::New(m_InstanceNumber, mitk::SortByImagePositionPatient::New(nullptr).GetPointer()).GetPointer(),
+      ComparisonOnlySortByTag::New(m_InstanceNumber, mitk::SortByImagePositionPatient::New(nullptr).GetPointer()).GetPointer(),
+      true);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMSortCriterion)
@@ -0,0 +1,161 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMTagTable.h"
+#include "mitkDICOMTagTableImageFrameInfo.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+class mitkDICOMTagTableTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMTagTableTestSuite);
+
+  MITK_TEST(AddFrame);
+  MITK_TEST(GetTagValue);
+  MITK_TEST(GetTagValueByPath);
+  MITK_TEST(GetTagValueAsNumbers);
+  MITK_TEST(ParseNumbers);
+  MITK_TEST(FrameInfo);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::DICOMTagTable::Pointer m_Table;
+
+  mitk::DICOMTag m_SeriesUID = mitk::DICOMTag(0x0020, 0x000e);
+  mitk::DICOMTag m_ImagePosition = mitk::DICOMTag(0x0020, 0x0032);
+  mitk::DICOMTag m_Modality = mitk::DICOMTag(0x0008, 0x0060);
+
+  mitk::DICOMTagPath m_NestedPath;
+
+public:
+
+  void setUp() override
+  {
+    m_Table = mitk::DICOMTagTable::New();
+
+    const auto row0 = m_Table->AddFrame("/data/file0.dcm");
+    const auto row1 = m_Table->AddFrame("/data/file1.dcm");
+    const auto row2 = m_Table->AddFrame("/data/file1.dcm", 1);
+
+    const auto uidColumn = m_Table->AddColumn(mitk::DICOMTagPath(m_SeriesUID));
+    const auto positionColumn = m_Table->AddColumn(mitk::DICOMTagPath(m_ImagePosition), true);
+
+    m_NestedPath.AddSelection(0x0054, 0x0016, 0).AddElement(0x0018, 0x1072);
+    const auto nestedColumn = m_Table->AddColumn(m_NestedPath);
+
+    m_Table->SetValue(row0, uidColumn, "1.2.3");
+    m_Table->SetValue(row1, uidColumn, "1.2.3");
+    m_Table->SetValue(row2, uidColumn, "1.2.4");
+
+    m_Table->SetValue(row0, positionColumn, "0\\0\\1.5");
+    m_Table->SetValue(row1, positionColumn, "0\\0\\3");
+
+    m_Table->SetValue(row1, nestedColumn, "120000");
+  }
+
+  void tearDown() override
+  {
+    m_Table = nullptr;
+  }
+
+  void AddFrame()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), m_Table->GetNumberOfRows());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Table->AddFrame("/data/file1.dcm"));
+
+    mitk::DICOMTagTable::RowIndexType row = 0;
+    CPPUNIT_ASSERT(m_Table->FindFrame("/data/file1.dcm", 1, row));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), row);
+    CPPUNIT_ASSERT(!m_Table->FindFrame("/data/file1.dcm", 2, row));
+    CPPUNIT_ASSERT(!m_Table->FindFrame("/data/file2.dcm", 0, row));
+
+    CPPUNIT_ASSERT_EQUAL(std::string("/data/file1.dcm"), m_Table->GetFilename(2));
+    CPPUNIT_ASSERT_EQUAL(1u, m_Table->GetFrameNo(2));
+    CPPUNIT_ASSERT_MESSAGE("Frames of one file share the filename.", m_Table->GetSharedFilename(1) == m_Table->GetSharedFilename(2));
+  }
+
+  void GetTagValue()
+  {
+    auto finding = m_Table->GetTagValue(1, m_SeriesUID);
+    CPPUNIT_ASSERT(finding.isValid);
+    CPPUNIT_ASSERT_EQUAL(std::string("1.2.3"), finding.value);
+    CPPUNIT_ASSERT(finding.path == mitk::DICOMTagPath(m_SeriesUID));
+
+    CPPUNIT_ASSERT_EQUAL(std::string("1.2.4"), m_Table->GetTagValue(2, m_SeriesUID).value);
+
+    CPPUNIT_ASSERT_MESSAGE("Missing value must be invalid.", !m_Table->GetTagValue(2, m_ImagePosition).isValid);
+    CPPUNIT_ASSERT_MESSAGE("Tag without column must be invalid.", !m_Table->GetTagValue(0, m_Modality).isValid);
+  }
+
+  void GetTagValueByPath()
+  {
+    auto findings = m_Table->GetTagValue(1, m_NestedPath);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), findings.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("120000"), findings.front().value);
+
+    mitk::DICOMTagPath wildcardPath;
+    wildcardPath.AddAnySelection(0x0054, 0x0016).AddElement(0x0018, 0x1072);
+    findings = m_Table->GetTagValue(1, wildcardPath);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), findings.size());
+    CPPUNIT_ASSERT(findings.front().path == m_NestedPath);
+
+    CPPUNIT_ASSERT(m_Table->GetTagValue(0, wildcardPath).empty());
+
+    CPPUNIT_ASSERT_THROW(m_Table->AddColumn(wildcardPath), mitk::Exception);
+  }
+
+  void GetTagValueAsNumbers()
+  {
+    std::vector<double> numbers;
+    CPPUNIT_ASSERT(m_Table->GetTagValueAsNumbers(0, m_ImagePosition, numbers));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), numbers.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, numbers[2], 1e-10);
+
+    CPPUNIT_ASSERT(m_Table->GetTagValueAsNumbers(1, m_ImagePosition, numbers));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3., numbers[2], 1e-10);
+
+    CPPUNIT_ASSERT(!m_Table->GetTagValueAsNumbers(2, m_ImagePosition, numbers));
+    CPPUNIT_ASSERT_MESSAGE("Column is not numeric.", !m_Table->GetTagValueAsNumbers(0, m_SeriesUID, numbers));
+  }
+
+  void ParseNumbers()
+  {
+    std::vector<double> numbers;
+    mitk::DICOMTagTable::ParseNumbers("1\\-2.5\\3e1", numbers);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), numbers.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-2.5, numbers[1], 1e-10);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(30., numbers[2], 1e-10);
+
+    // empty values are kept, so the number of values equals the value multiplicity
+    mitk::DICOMTagTable::ParseNumbers("1\\\\3", numbers);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), numbers.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., numbers[1], 1e-10);
+
+    mitk::DICOMTagTable::ParseNumbers("", numbers);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), numbers.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., numbers[0], 1e-10);
+  }
+
+  void FrameInfo()
+  {
+    auto frame = mitk::DICOMTagTableImageFrameInfo::New(m_Table, 2);
+    CPPUNIT_ASSERT_EQUAL(std::string("/data/file1.dcm"), frame->Filename);
+    CPPUNIT_ASSERT_EQUAL(1u, frame->FrameNo);
+    CPPUNIT_ASSERT_EQUAL(std::string("1.2.4"), frame->GetTagValueAsString(m_SeriesUID).value);
+    CPPUNIT_ASSERT(frame->GetTagValueAsString(m_NestedPath).empty());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMTagTable)
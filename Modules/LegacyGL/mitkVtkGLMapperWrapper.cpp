@@ -45,6 +45,11 @@ vtkProp *mitk::VtkGLMapperWrapper::GetVtkProp(mitk::BaseRenderer *renderer)
   return ls->m_GLMapperProp;
 }
 
+bool mitk::VtkGLMapperWrapper::DependsOnOtherNodes() const
+{
+  return m_MitkGLMapper->DependsOnOtherNodes();
+}
+
 void mitk::VtkGLMapperWrapper::GenerateDataForRenderer(mitk::BaseRenderer *renderer)
 {
   LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
@@ -39,6 +39,9 @@ namespace mitk
     /** \brief returns the a prop assembly */
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
 
+    /** Forwarded to the wrapped GL mapper */
+    bool DependsOnOtherNodes() const override;
+
     void GenerateDataForRenderer(mitk::BaseRenderer *renderer) override;
 
     /** \brief Internal class holding the mapper, actor, etc. for each of the 3 2D render windows */
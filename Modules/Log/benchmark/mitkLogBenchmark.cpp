@@ -0,0 +1,147 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkLog.h>
+#include <mitkLogBackendText.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  /** \brief Formats every message like a file backend would, but keeps the text in memory.
+   */
+  class BenchmarkBackend : public mitk::LogBackendText
+  {
+  public:
+    void ProcessMessage(const mitk::LogMessage& message) override
+    {
+      this->FormatFull(m_Stream, message);
+      ++m_NumberOfMessages;
+
+      if (m_NumberOfMessages % 1000 == 0)
+        m_Stream.str(std::string());
+    }
+
+    OutputType GetOutputType() const override
+    {
+      return OutputType::Other;
+    }
+
+    std::size_t GetNumberOfMessages() const
+    {
+      return m_NumberOfMessages;
+    }
+
+    void Reset()
+    {
+      m_NumberOfMessages = 0;
+      m_Stream.str(std::string());
+    }
+
+  private:
+    std::ostringstream m_Stream;
+    std::size_t m_NumberOfMessages = 0;
+  };
+
+  void EmitMessages(int numberOfMessages)
+  {
+    for (int i = 0; i < numberOfMessages; ++i)
+      MITK_INFO("Benchmark") << "Processed item " << i << " of " << numberOfMessages << ", value " << 0.5 * i;
+  }
+
+  /** \brief Emits the messages from the given number of threads and returns the time the threads took.
+   */
+  double Run(int numberOfThreads, int numberOfMessages)
+  {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; ++i)
+      threads.emplace_back(EmitMessages, numberOfMessages);
+
+    for (auto& thread : threads)
+      thread.join();
+
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+  }
+
+  bool Report(const std::string& name,
+              double microseconds,
+              std::size_t numberOfStatements,
+              BenchmarkBackend& backend,
+              std::size_t expectedNumberOfMessages)
+  {
+    std::cout << std::left << std::setw(36) << name << std::right << std::setw(12) << std::fixed
+              << std::setprecision(1) << microseconds / 1000.0 << " ms" << std::setw(12)
+              << 1000.0 * microseconds / static_cast<double>(numberOfStatements) << " ns/statement" << std::endl;
+
+    const bool complete = backend.GetNumberOfMessages() == expectedNumberOfMessages;
+    if (!complete)
+    {
+      std::cout << "  expected " << expectedNumberOfMessages << " messages, backend received "
+                << backend.GetNumberOfMessages() << std::endl;
+    }
+
+    backend.Reset();
+    return complete;
+  }
+}
+
+/** \brief Compares the time log statements take on the emitting threads in synchronous and asynchronous mode.
+ *
+ * Usage: MitkLogBenchmark [number of threads] [number of messages per thread]
+ */
+int main(int argc, char* argv[])
+{
+  const int numberOfThreads = argc > 1 ? std::atoi(argv[1]) : 4;
+  const int numberOfMessages = argc > 2 ? std::atoi(argv[2]) : 100000;
+  const auto numberOfStatements = static_cast<std::size_t>(numberOfThreads) * numberOfMessages;
+
+  BenchmarkBackend backend;
+  mitk::RegisterBackend(&backend);
+  mitk::DisableBackends(mitk::LogBackendBase::OutputType::Console);
+
+  std::cout << numberOfThreads << " threads x " << numberOfMessages << " messages" << std::endl;
+
+  bool success = true;
+
+  double time = Run(numberOfThreads, numberOfMessages);
+  success &= Report("synchronous", time, numberOfStatements, backend, numberOfStatements);
+
+  mitk::SetAsynchronousLogging(true);
+  time = Run(numberOfThreads, numberOfMessages);
+  mitk::FlushLog();
+  success &= Report("asynchronous (emitting threads)", time, numberOfStatements, backend, numberOfStatements);
+
+  const auto start = std::chrono::steady_clock::now();
+  Run(numberOfThreads, numberOfMessages);
+  mitk::SetAsynchronousLogging(false);
+  time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  success &= Report("asynchronous (including writing)", time, numberOfStatements, backend, numberOfStatements);
+
+  mitk::DisableLogLevel(mitk::LogLevel::Info);
+  time = Run(numberOfThreads, numberOfMessages);
+  success &= Report("disabled level", time, numberOfStatements, backend, 0);
+  mitk::EnableLogLevel(mitk::LogLevel::Info);
+
+  mitk::EnableBackends(mitk::LogBackendBase::OutputType::Console);
+  mitk::UnregisterBackend(&backend);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <mitkLogBackendBase.h>
 
+#include <memory>
 #include <sstream>
 
 #include <MitkLogExports.h>
@@ -48,6 +49,13 @@ namespace mitk
    */
   void MITKLOG_EXPORT DistributeToBackends(LogMessage& message);
 
+  /** \brief Distribute the given message to all registered backends.
+   *
+   * Takes ownership of the message, so that it can be queued without copying it if asynchronous logging is enabled.
+   * Should only be called by PseudoLogStream objects.
+   */
+  void MITKLOG_EXPORT DistributeToBackends(std::unique_ptr<LogMessage> message);
+
   /** \brief Enable the output of a backend.
    */
   void MITKLOG_EXPORT EnableBackends(LogBackendBase::OutputType type);
@@ -60,6 +68,54 @@ namespace mitk
    */
   bool MITKLOG_EXPORT IsBackendEnabled(LogBackendBase::OutputType type);
 
+  /** \brief Enable log messages of the given level (all levels are enabled by default).
+   */
+  void MITKLOG_EXPORT EnableLogLevel(LogLevel level);
+
+  /** \brief Disable log messages of the given level.
+   *
+   * Log statements of a disabled level neither format their arguments nor create a message.
+   */
+  void MITKLOG_EXPORT DisableLogLevel(LogLevel level);
+
+  /** \brief Check whether log messages of the given level are enabled.
+   */
+  bool MITKLOG_EXPORT IsLogLevelEnabled(LogLevel level);
+
+  /** \brief Enable or disable asynchronous logging.
+   *
+   * If enabled, log messages are put into a bounded lock-free queue and passed to the backends by a background
+   * thread, so that the logging thread does not wait for the backends. Messages keep their order. If the queue is
+   * full, the logging thread waits until there is space again. Fatal messages are flushed immediately.
+   *
+   * Disabling asynchronous logging writes all pending messages before it returns. Asynchronous logging is disabled by
+   * default.
+   */
+  void MITKLOG_EXPORT SetAsynchronousLogging(bool enabled);
+
+  /** \brief Check whether asynchronous logging is enabled.
+   */
+  bool MITKLOG_EXPORT IsAsynchronousLoggingEnabled();
+
+  /** \brief Wait until all log messages emitted so far have been passed to the backends.
+   *
+   * Does nothing if asynchronous logging is disabled.
+   */
+  void MITKLOG_EXPORT FlushLog();
+
+  /** \brief Get a formatting stream of the calling thread.
+   *
+   * The streams are reused by subsequent log statements of the thread once they are released. Streams can be released
+   * in any order. Should only be called by PseudoLogStream objects.
+   */
+  MITKLOG_EXPORT std::ostream* AcquireLogStream();
+
+  /** \brief Release a stream that was acquired by AcquireLogStream() and return its content.
+   *
+   * Should only be called by PseudoLogStream objects.
+   */
+  MITKLOG_EXPORT std::string ReleaseLogStream(std::ostream* stream);
+
   /** \brief Simulates a std::cout stream.
    *
    * Should only be used by the macros defined in the file mitkLog.h.
@@ -67,22 +123,35 @@ namespace mitk
   class MITKLOG_EXPORT PseudoLogStream
   {
   public:
-    PseudoLogStream(LogLevel level, const std::string& filePath, int lineNumber, const std::string& functionName)
-      : m_Disabled(false),
-        m_Message(level, filePath, lineNumber, functionName),
-        m_Stream(std::stringstream::out)
+    PseudoLogStream(LogLevel level, const char* filePath, int lineNumber, const char* functionName)
+      : m_Disabled(!IsLogLevelEnabled(level)),
+        m_Level(level),
+        m_FilePath(filePath),
+        m_LineNumber(lineNumber),
+        m_FunctionName(functionName),
+        m_Stream(nullptr)
     {
     }
 
+    PseudoLogStream(const PseudoLogStream&) = delete;
+    PseudoLogStream& operator=(const PseudoLogStream&) = delete;
+
     /** \brief The encapsulated message is written to the backend.
      */
     ~PseudoLogStream()
     {
+      std::string text;
+
+      if (m_Stream != nullptr)
+        text = ReleaseLogStream(m_Stream);
+
       if (!m_Disabled)
       {
-        m_Message.Message = m_Stream.str();
-        m_Message.ModuleName = MITKLOG_MODULENAME;
-        DistributeToBackends(m_Message);
+        std::unique_ptr<LogMessage> message(new LogMessage(m_Level, m_FilePath, m_LineNumber, m_FunctionName));
+        message->Message = std::move(text);
+        message->Category = std::move(m_Category);
+        message->ModuleName = MITKLOG_MODULENAME;
+        DistributeToBackends(std::move(message));
       }
     }
 
@@ -90,15 +159,7 @@ namespace mitk
     PseudoLogStream& operator<<(const T& data)
     {
       if (!m_Disabled)
-      {
-        std::locale C("C");
-        std::locale originalLocale = m_Stream.getloc();
-        m_Stream.imbue(C);
-
-        m_Stream << data;
-
-        m_Stream.imbue(originalLocale);
-      }
+        this->GetStream() << data;
 
       return *this;
     }
@@ -107,15 +168,7 @@ namespace mitk
     PseudoLogStream& operator<<(T& data)
     {
       if (!m_Disabled)
-      {
-        std::locale C("C");
-        std::locale originalLocale = m_Stream.getloc();
-        m_Stream.imbue(C);
-
-        m_Stream << data;
-
-        m_Stream.imbue(originalLocale);
-      }
+        this->GetStream() << data;
 
       return *this;
     }
@@ -123,15 +176,7 @@ namespace mitk
     PseudoLogStream& operator<<(std::ostream& (*func)(std::ostream&))
     {
       if (!m_Disabled)
-      {
-        std::locale C("C");
-        std::locale originalLocale = m_Stream.getloc();
-        m_Stream.imbue(C);
-
-        m_Stream << func;
-
-        m_Stream.imbue(originalLocale);
-      }
+        this->GetStream() << func;
 
       return *this;
     }
@@ -144,10 +189,10 @@ namespace mitk
     {
       if (!m_Disabled)
       {
-        if (m_Message.Category.length())
-          m_Message.Category += ".";
+        if (m_Category.length())
+          m_Category += ".";
 
-        m_Message.Category += category;
+        m_Category += category;
       }
 
       return *this;
@@ -164,9 +209,25 @@ namespace mitk
     }
 
   protected:
+    /** \brief The formatting stream is acquired on first use, so disabled statements never create one.
+     *
+     * The stream is imbued with the "C" locale.
+     */
+    std::ostream& GetStream()
+    {
+      if (m_Stream == nullptr)
+        m_Stream = AcquireLogStream();
+
+      return *m_Stream;
+    }
+
     bool m_Disabled;
-    LogMessage m_Message;
-    std::stringstream m_Stream;
+    const LogLevel m_Level;
+    const char* m_FilePath;
+    const int m_LineNumber;
+    const char* m_FunctionName;
+    std::string m_Category;
+    std::ostream* m_Stream;
   };
 
   /**
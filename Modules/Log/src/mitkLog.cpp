@@ -12,69 +12,404 @@ found in the LICENSE file.
 
 #include <mitkLog.h>
 #include <mitkLogBackendCout.h>
+#include "mitkLogMessageQueue.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <list>
+#include <locale>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <vector>
 
 static std::list<mitk::LogBackendBase*> backends;
 static std::set<mitk::LogBackendBase::OutputType> disabledBackendTypes;
 
+// Guards the backends. Recursive, since backends may emit log messages themselves.
+static std::recursive_mutex backendMutex;
+
+static std::atomic<unsigned int> enabledLogLevels(~0u);
+
+namespace
+{
+  unsigned int GetLogLevelBit(mitk::LogLevel level)
+  {
+    return 1u << static_cast<unsigned int>(level);
+  }
+
+  /** \brief Pass a message to all enabled backends on the calling thread.
+   */
+  void ProcessMessage(mitk::LogMessage& message)
+  {
+    // Crop Message
+    {
+      std::string::size_type i = message.Message.find_last_not_of(" \t\f\v\n\r");
+
+      if (i == std::string::npos)
+        message.Message.clear();
+      else
+        message.Message.erase(i + 1);
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(backendMutex);
+
+    // create dummy backend if there is no backend registered (so we have an output anyway)
+    static mitk::LogBackendCout* dummyBackend = nullptr;
+
+    if (backends.empty() && dummyBackend == nullptr)
+    {
+      dummyBackend = new mitk::LogBackendCout;
+      backends.push_back(dummyBackend);
+    }
+    else if (backends.size() > 1 && dummyBackend != nullptr)
+    {
+      // if there was added another backend remove the dummy backend and delete it
+      backends.remove(dummyBackend);
+      delete dummyBackend;
+      dummyBackend = nullptr;
+    }
+
+    // iterate through all registered images and call the ProcessMessage() methods of the backends
+    for (auto i = backends.begin(); i != backends.end(); ++i)
+    {
+      if (disabledBackendTypes.find((*i)->GetOutputType()) == disabledBackendTypes.end())
+        (*i)->ProcessMessage(message);
+    }
+  }
+
+  /** \brief Queue and background thread of the asynchronous logging mode.
+   *
+   * Producers count themselves in m_ActiveProducers while they push, so that disabling can wait for pushes that
+   * raced with it and write their messages before the writer thread stops. Flush() waits on m_Flushed, which the
+   * writer thread signals after each batch of messages while there are waiting threads.
+   */
+  class AsyncLogWriter
+  {
+  public:
+    AsyncLogWriter()
+      : m_Queue(8192),
+        m_ThreadId(std::thread::id()),
+        m_Enabled(false),
+        m_Stop(false),
+        m_Sleeping(false),
+        m_ActiveProducers(0),
+        m_Pushed(0),
+        m_Processed(0),
+        m_FlushWaiters(0)
+    {
+    }
+
+    ~AsyncLogWriter()
+    {
+      this->SetEnabled(false);
+    }
+
+    void SetEnabled(bool enabled)
+    {
+      std::lock_guard<std::mutex> lock(m_ControlMutex);
+
+      if (enabled == m_Enabled.load())
+        return;
+
+      if (enabled)
+      {
+        m_Stop = false;
+        m_Thread = std::thread(&AsyncLogWriter::Run, this);
+        m_Enabled = true;
+      }
+      else
+      {
+        m_Enabled = false;
+
+        while (m_ActiveProducers.load() != 0)
+          std::this_thread::yield();
+
+        {
+          std::lock_guard<std::mutex> wakeUpLock(m_WakeUpMutex);
+          m_Stop = true;
+        }
+        m_WakeUp.notify_one();
+        m_Thread.join();
+        m_ThreadId = std::thread::id();
+
+        this->NotifyFlushed();
+      }
+    }
+
+    bool IsEnabled() const
+    {
+      return m_Enabled.load();
+    }
+
+    /** \brief Queue the message, returns false and leaves the message to the caller if asynchronous logging is off.
+     */
+    bool Push(std::unique_ptr<mitk::LogMessage>& message)
+    {
+      ++m_ActiveProducers;
+
+      // The writer thread passes its own messages on directly, it would wait forever for space in a full queue
+      if (!m_Enabled.load() || std::this_thread::get_id() == m_ThreadId.load())
+      {
+        --m_ActiveProducers;
+        return false;
+      }
+
+      const bool isFatal = message->Level == mitk::LogLevel::Fatal;
+
+      mitk::LogMessage* rawMessage = message.release();
+      while (!m_Queue.Push(rawMessage))
+      {
+        this->WakeUp();
+        std::this_thread::yield();
+      }
+
+      ++m_Pushed;
+      --m_ActiveProducers;
+
+      if (m_Sleeping.load())
+        this->WakeUp();
+
+      if (isFatal)
+        this->Flush();
+
+      return true;
+    }
+
+    void Flush()
+    {
+      if (!m_Enabled.load() || std::this_thread::get_id() == m_ThreadId.load())
+        return;
+
+      const std::size_t pushed = m_Pushed.load();
+
+      // Register as waiter before checking the progress, so that the writer thread either sees the waiter or has
+      // already counted its messages when the condition is checked
+      ++m_FlushWaiters;
+      this->WakeUp();
+      {
+        std::unique_lock<std::mutex> lock(m_FlushMutex);
+        m_Flushed.wait(lock, [this, pushed]() { return m_Processed.load() >= pushed || !m_Enabled.load(); });
+      }
+      --m_FlushWaiters;
+    }
+
+  private:
+    void WakeUp()
+    {
+      std::lock_guard<std::mutex> lock(m_WakeUpMutex);
+      m_WakeUp.notify_one();
+    }
+
+    void NotifyFlushed()
+    {
+      if (m_FlushWaiters.load() == 0)
+        return;
+
+      std::lock_guard<std::mutex> lock(m_FlushMutex);
+      m_Flushed.notify_all();
+    }
+
+    void Run()
+    {
+      m_ThreadId = std::this_thread::get_id();
+
+      for (;;)
+      {
+        mitk::LogMessage* message = nullptr;
+        while (m_Queue.Pop(message))
+        {
+          ProcessMessage(*message);
+          delete message;
+          ++m_Processed;
+        }
+
+        this->NotifyFlushed();
+
+        std::unique_lock<std::mutex> lock(m_WakeUpMutex);
+
+        if (m_Stop && m_Queue.IsEmpty())
+          return;
+
+        m_Sleeping = true;
+        m_WakeUp.wait_for(lock, std::chrono::milliseconds(50), [this]() { return m_Stop || !m_Queue.IsEmpty(); });
+        m_Sleeping = false;
+      }
+    }
+
+    mitk::LogMessageQueue m_Queue;
+    std::thread m_Thread;
+    std::atomic<std::thread::id> m_ThreadId;
+    std::mutex m_ControlMutex;
+
+    std::mutex m_WakeUpMutex;
+    std::condition_variable m_WakeUp;
+
+    std::mutex m_FlushMutex;
+    std::condition_variable m_Flushed;
+
+    std::atomic<bool> m_Enabled;
+    bool m_Stop;
+    std::atomic<bool> m_Sleeping;
+    std::atomic<int> m_ActiveProducers;
+    std::atomic<std::size_t> m_Pushed;
+    std::atomic<std::size_t> m_Processed;
+    std::atomic<int> m_FlushWaiters;
+  };
+
+  AsyncLogWriter& GetAsyncLogWriter()
+  {
+    static AsyncLogWriter writer;
+    return writer;
+  }
+
+  /** \brief Formatting streams of a thread, reused by its log statements.
+   *
+   * Log statements can nest (an argument may emit a log message while it is streamed), so each thread keeps several
+   * streams instead of a single one. Log statements may end in any order (e.g. if PseudoLogStream objects are moved
+   * or kept alive by temporaries), so each stream is marked as in use until it is released.
+   */
+  struct LogStreamPool
+  {
+    struct Slot
+    {
+      std::unique_ptr<std::ostringstream> Stream;
+      bool InUse = false;
+    };
+
+    std::vector<Slot> Slots;
+  };
+
+  thread_local LogStreamPool logStreamPool;
+}
+
 void mitk::RegisterBackend(LogBackendBase* backend)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendMutex);
   backends.push_back(backend);
 }
 
 void mitk::UnregisterBackend(LogBackendBase* backend)
 {
+  // pending messages are still written to the backend
+  FlushLog();
+
+  std::lock_guard<std::recursive_mutex> lock(backendMutex);
   backends.remove(backend);
 }
 
 void mitk::DistributeToBackends(LogMessage& message)
 {
-  // Crop Message
+  if (GetAsyncLogWriter().IsEnabled())
   {
-    std::string::size_type i = message.Message.find_last_not_of(" \t\f\v\n\r");
-
-    message.Message = i != std::string::npos
-      ? message.Message.substr(0, i + 1)
-      : "";
+    std::unique_ptr<LogMessage> copy(new LogMessage(message));
+    if (GetAsyncLogWriter().Push(copy))
+      return;
   }
 
-  // create dummy backend if there is no backend registered (so we have an output anyway)
-  static LogBackendCout* dummyBackend = nullptr;
+  ProcessMessage(message);
+}
 
-  if (backends.empty() && dummyBackend == nullptr)
-  {
-    dummyBackend = new LogBackendCout;
-    RegisterBackend(dummyBackend);
-  }
-  else if (backends.size() > 1 && dummyBackend != nullptr)
-  {
-    // if there was added another backend remove the dummy backend and delete it
-    UnregisterBackend(dummyBackend);
-    delete dummyBackend;
-    dummyBackend = nullptr;
-  }
+void mitk::DistributeToBackends(std::unique_ptr<LogMessage> message)
+{
+  if (GetAsyncLogWriter().IsEnabled() && GetAsyncLogWriter().Push(message))
+    return;
 
-  // iterate through all registered images and call the ProcessMessage() methods of the backends
-  for (auto i = backends.begin(); i != backends.end(); ++i)
-  {
-    if (IsBackendEnabled((*i)->GetOutputType()))
-      (*i)->ProcessMessage(message);
-  }
+  ProcessMessage(*message);
 }
 
 void mitk::EnableBackends(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendMutex);
   disabledBackendTypes.erase(type);
 }
 
 void mitk::DisableBackends(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendMutex);
   disabledBackendTypes.insert(type);
 }
 
 bool mitk::IsBackendEnabled(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendMutex);
   return disabledBackendTypes.find(type) == disabledBackendTypes.end();
 }
+
+void mitk::EnableLogLevel(LogLevel level)
+{
+  enabledLogLevels |= GetLogLevelBit(level);
+}
+
+void mitk::DisableLogLevel(LogLevel level)
+{
+  enabledLogLevels &= ~GetLogLevelBit(level);
+}
+
+bool mitk::IsLogLevelEnabled(LogLevel level)
+{
+  return (enabledLogLevels.load(std::memory_order_relaxed) & GetLogLevelBit(level)) != 0;
+}
+
+void mitk::SetAsynchronousLogging(bool enabled)
+{
+  GetAsyncLogWriter().SetEnabled(enabled);
+}
+
+bool mitk::IsAsynchronousLoggingEnabled()
+{
+  return GetAsyncLogWriter().IsEnabled();
+}
+
+void mitk::FlushLog()
+{
+  GetAsyncLogWriter().Flush();
+}
+
+std::ostream* mitk::AcquireLogStream()
+{
+  LogStreamPool& pool = logStreamPool;
+
+  for (auto& slot : pool.Slots)
+  {
+    if (!slot.InUse)
+    {
+      slot.InUse = true;
+      return slot.Stream.get();
+    }
+  }
+
+  pool.Slots.emplace_back();
+  auto& slot = pool.Slots.back();
+  slot.Stream.reset(new std::ostringstream(std::ostringstream::out));
+  slot.Stream->imbue(std::locale::classic());
+  slot.InUse = true;
+  return slot.Stream.get();
+}
+
+std::string mitk::ReleaseLogStream(std::ostream* stream)
+{
+  auto* stringStream = static_cast<std::ostringstream*>(stream);
+
+  for (auto& slot : logStreamPool.Slots)
+  {
+    if (slot.Stream.get() == stringStream)
+    {
+      slot.InUse = false;
+      break;
+    }
+  }
+
+  std::string text = stringStream->str();
+
+  // reset the stream to the state of a new one for the next log statement
+  stringStream->str(std::string());
+  stringStream->clear();
+  stringStream->flags(std::ios_base::skipws | std::ios_base::dec);
+  stringStream->precision(6);
+  stringStream->width(0);
+  stringStream->fill(' ');
+
+  return text;
+}
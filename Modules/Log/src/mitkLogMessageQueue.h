@@ -0,0 +1,150 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLogMessageQueue_h
+#define mitkLogMessageQueue_h
+
+#include <mitkLogMessage.h>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Bounded lock-free multi-producer/multi-consumer queue of log messages.
+   *
+   * Each cell carries a sequence number that tells producers and consumers whether the cell is free or filled for
+   * their current position, so that neither has to take a lock. Push() fails if the queue is full, Pop() fails if it
+   * is empty. The queue takes ownership of the pushed messages and deletes messages that were never popped.
+   */
+  class LogMessageQueue
+  {
+  public:
+    /** \param capacity Maximum number of queued messages, rounded up to a power of two.
+     */
+    explicit LogMessageQueue(std::size_t capacity)
+      : m_Cells(RoundUpToPowerOfTwo(capacity)),
+        m_Mask(m_Cells.size() - 1)
+    {
+      for (std::size_t i = 0; i < m_Cells.size(); ++i)
+        m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+
+      m_EnqueuePosition.store(0, std::memory_order_relaxed);
+      m_DequeuePosition.store(0, std::memory_order_relaxed);
+    }
+
+    ~LogMessageQueue()
+    {
+      LogMessage* message = nullptr;
+      while (this->Pop(message))
+        delete message;
+    }
+
+    LogMessageQueue(const LogMessageQueue&) = delete;
+    LogMessageQueue& operator=(const LogMessageQueue&) = delete;
+
+    bool Push(LogMessage* message)
+    {
+      Cell* cell = nullptr;
+      std::size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+
+      for (;;)
+      {
+        cell = &m_Cells[position & m_Mask];
+        const std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+        if (difference == 0)
+        {
+          if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0)
+        {
+          return false; // full
+        }
+        else
+        {
+          position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        }
+      }
+
+      cell->Message = message;
+      cell->Sequence.store(position + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool Pop(LogMessage*& message)
+    {
+      Cell* cell = nullptr;
+      std::size_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+
+      for (;;)
+      {
+        cell = &m_Cells[position & m_Mask];
+        const std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+        if (difference == 0)
+        {
+          if (m_DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0)
+        {
+          return false; // empty
+        }
+        else
+        {
+          position = m_DequeuePosition.load(std::memory_order_relaxed);
+        }
+      }
+
+      message = cell->Message;
+      cell->Sequence.store(position + m_Mask + 1, std::memory_order_release);
+      return true;
+    }
+
+    /** \brief Approximation for wake-up decisions, may be outdated as soon as it returns.
+     */
+    bool IsEmpty() const
+    {
+      return m_DequeuePosition.load(std::memory_order_relaxed) == m_EnqueuePosition.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static std::size_t RoundUpToPowerOfTwo(std::size_t value)
+    {
+      std::size_t result = 2;
+      while (result < value)
+        result *= 2;
+
+      return result;
+    }
+
+    struct Cell
+    {
+      std::atomic<std::size_t> Sequence;
+      LogMessage* Message = nullptr;
+    };
+
+    std::vector<Cell> m_Cells;
+    std::size_t m_Mask;
+
+    // Producers and the consumer modify different positions, keep them on different cache lines
+    alignas(64) std::atomic<std::size_t> m_EnqueuePosition;
+    alignas(64) std::atomic<std::size_t> m_DequeuePosition;
+  };
+}
+
+#endif
@@ -49,6 +49,9 @@ namespace mitk
 
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
 
+    /** The grid is clipped by the "Clipping Bounding Object" node derived from the node */
+    bool DependsOnOtherNodes() const override { return true; }
+
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
 
     void ApplyProperties(vtkActor * /*actor*/, mitk::BaseRenderer *renderer) override;
@@ -31,11 +31,13 @@ found in the LICENSE file.
 #include <mitkNormalizedSumOfSquaredDifferencesFitCostFunction.h>
 #include <mitkExtractTimeGrid.h>
 #include <mitkModelFitCmdAppsHelper.h>
+#include <mitkModelFitBatchHelper.h>
 #include <mitkPreferenceListReaderOptionsFunctor.h>
 
 std::string inFilename;
 std::string outFileName;
 std::string maskFileName;
+std::string batchFileName;
 bool verbose(false);
 bool roibased(false);
 std::string functionName;
@@ -78,14 +80,16 @@ void setupParser(mitkCommandLineParser& parser)
     parser.endGroup();
     parser.beginGroup("Required I/O parameters");
     parser.addArgument(
-        "input", "i", mitkCommandLineParser::File, "Input file", "input 3D+t image file", us::Any(), false, false, false, mitkCommandLineParser::Input);
+        "input", "i", mitkCommandLineParser::File, "Input file", "input 3D+t image file (not needed in batch mode)", us::Any(), true, false, false, mitkCommandLineParser::Input);
     parser.addArgument("output",
         "o",
         mitkCommandLineParser::File,
         "Output file template",
-        "where to save the output parameter images. The specified path will be used as template to determine the format (via extension) and the name \"root\". For each parameter a suffix will be added to the name.",
+        "where to save the output parameter images. The specified path will be used as template to determine the format (via extension) and the name \"root\". For each parameter a suffix will be added to the name. Not needed in batch mode.",
         us::Any(),
-        false, false, false, mitkCommandLineParser::Output);
+        true, false, false, mitkCommandLineParser::Output);
+    parser.addArgument(
+        "batch", "b", mitkCommandLineParser::File, "Batch case list", "CSV or JSON file that lists the cases of a batch run (one case per row/object). Columns: \"input\", \"output\" and optionally \"mask\". A missing mask is taken from the command line; all other settings apply to all cases. The next case is loaded while the current one is fitted and results are stored in the background.", us::Any(), true, false, false, mitkCommandLineParser::Input);
     parser.endGroup();
 
     parser.beginGroup("Optional parameters");
@@ -115,9 +119,18 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
     {
         formular = us::any_cast<std::string>(parsedArgs["formular"]);
     }
-    inFilename = us::any_cast<std::string>(parsedArgs["input"]);
-    outFileName = us::any_cast<std::string>(parsedArgs["output"]);
-
+    if (parsedArgs.count("input"))
+    {
+        inFilename = us::any_cast<std::string>(parsedArgs["input"]);
+    }
+    if (parsedArgs.count("output"))
+    {
+        outFileName = us::any_cast<std::string>(parsedArgs["output"]);
+    }
+    if (parsedArgs.count("batch"))
+    {
+        batchFileName = us::any_cast<std::string>(parsedArgs["batch"]);
+    }
 
     verbose = false;
     if (parsedArgs.count("verbose"))
@@ -136,6 +149,12 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
         maskFileName = us::any_cast<std::string>(parsedArgs["mask"]);
     }
 
+    if (batchFileName.empty() && (inFilename.empty() || outFileName.empty()))
+    {
+        std::cerr << "Invalid program call. Please set 'input' and 'output' or a case list via 'batch'." << std::endl;
+        return false;
+    }
+
     return true;
 }
 
@@ -234,7 +253,8 @@ void generateModelFit_ROIBased(
     generator = fitGenerator.GetPointer();
 }
 
-void doFitting()
+/**Fits the current case. If a writer is passed, the results are stored by it in the background.*/
+void doFitting(mitk::BatchResultWriter* writer = nullptr)
 {
         mitk::ParameterFitImageGeneratorBase::Pointer generator = nullptr;
         mitk::modelFit::ModelFitInfo::Pointer fitSession = nullptr;
@@ -276,7 +296,15 @@ void doFitting()
             generator->Generate();
             std::cout << std::endl << "Finished fitting process" << std::endl;
 
-            mitk::storeModelFitGeneratorResults(outFileName, generator, fitSession);
+            if (writer)
+            {
+                const std::string outputPath = outFileName;
+                writer->Enqueue([outputPath, generator, fitSession]() { mitk::storeModelFitGeneratorResults(outputPath, generator, fitSession); });
+            }
+            else
+            {
+                mitk::storeModelFitGeneratorResults(outFileName, generator, fitSession);
+            }
         }
         else
         {
@@ -284,6 +312,53 @@ void doFitting()
         }
 }
 
+/**Fits the passed case. If a writer is passed, the results are stored by it in the background.*/
+void processCase(const mitk::ModelFitBatchCaseData& caseData, mitk::BatchResultWriter* writer)
+{
+    outFileName = caseData.outputFileName;
+    image = caseData.image;
+    mask = caseData.mask;
+
+    std::cout << "Input: " << caseData.inputFileName << std::endl;
+
+    if (mask.IsNotNull())
+    {
+        std::cout << "Mask:  " << caseData.maskFileName << std::endl;
+    }
+    else
+    {
+        std::cout << "Mask:  none" << std::endl;
+    }
+
+    if (roibased && mask.IsNull())
+    {
+        mitkThrow() << "Error. Cannot fit. Please specify mask if you select roi based fitting.";
+    }
+
+    std::cout << "Style: ";
+    if (roibased)
+    {
+        std::cout << "ROI based";
+    }
+    else
+    {
+        std::cout << "pixel based";
+    }
+    std::cout << std::endl;
+
+    doFitting(writer);
+}
+
+/**Processes all cases of the batch case list. Returns the number of failed cases.*/
+unsigned int doBatch(mitk::PreferenceListReaderOptionsFunctor* readerFilterFunctor)
+{
+    mitk::ModelFitBatchCaseData defaults;
+    defaults.maskFileName = maskFileName;
+
+    return mitk::processModelFitBatch(batchFileName, defaults, false, readerFilterFunctor,
+        [](const mitk::BatchCase&, const mitk::ModelFitBatchCaseData& caseData, mitk::BatchResultWriter& writer) { processCase(caseData, &writer); });
+}
+
 int main(int argc, char* argv[])
 {
     mitkCommandLineParser parser;
@@ -307,36 +382,17 @@ int main(int argc, char* argv[])
     //! [do processing]
     try
     {
-        image = mitk::IOUtil::Load<mitk::Image>(inFilename, &readerFilterFunctor);
-        std::cout << "Input: " << inFilename << std::endl;
-
-        if (!maskFileName.empty())
-        {
-            mask = mitk::IOUtil::Load<mitk::Image>(maskFileName, &readerFilterFunctor);
-            std::cout << "Mask:  " << maskFileName << std::endl;
-        }
-        else
-        {
-            std::cout << "Mask:  none" << std::endl;
-        }
-
-        if (roibased && mask.IsNull())
+        if (!batchFileName.empty())
         {
-            mitkThrow() << "Error. Cannot fit. Please specify mask if you select roi based fitting.";
+            return doBatch(&readerFilterFunctor) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
         }
 
-        std::cout << "Style: ";
-        if (roibased)
-        {
-            std::cout << "ROI based";
-        }
-        else
-        {
-            std::cout << "pixel based";
-        }
-        std::cout << std::endl;
+        mitk::ModelFitBatchCaseData caseData;
+        caseData.inputFileName = inFilename;
+        caseData.outputFileName = outFileName;
+        caseData.maskFileName = maskFileName;
 
-        doFitting();
+        processCase(mitk::loadModelFitBatchCase(caseData, nullptr, false, &readerFilterFunctor), nullptr);
 
         std::cout << "Processing finished." << std::endl;
 
@@ -7,6 +7,7 @@ set(CPP_FILES
   Common/mitkModelFitConstants.cpp
   Common/mitkModelFitParameter.cpp
   Common/mitkModelFitCmdAppsHelper.cpp
+  Common/mitkModelFitBatchHelper.cpp
   Common/mitkParameterFitImageGeneratorBase.cpp
   Common/mitkPixelBasedParameterFitImageGenerator.cpp
   Common/mitkROIBasedParameterFitImageGenerator.cpp
@@ -44,6 +45,7 @@ set(CPP_FILES
   Functors/mitkIndexedValueFunctorPolicy.cpp
   Functors/mitkModelDataGenerationFunctor.cpp
   Models/mitkModelBase.cpp
+  Models/mitkModelEvaluationWorkspace.cpp
   Models/mitkModelFactoryBase.cpp
   Models/mitkModelParameterizerBase.cpp
   Models/mitkLinearModel.cpp
@@ -75,6 +77,7 @@ set(CPP_FILES
 
 set(TPP_FILES
     include/itkMultiOutputNaryFunctorImageFilter.tpp
+    include/itkMultiOutputTimeSeriesFunctorImageFilter.tpp
     include/itkMaskedStatisticsImageFilter.hxx
     include/itkMaskedNaryStatisticsImageFilter.hxx
 	include/mitkModelFitProviderBase.tpp
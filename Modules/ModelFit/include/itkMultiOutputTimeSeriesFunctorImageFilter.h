@@ -0,0 +1,124 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkMultiOutputTimeSeriesFunctorImageFilter_h
+#define __itkMultiOutputTimeSeriesFunctorImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkVectorImage.h"
+
+namespace itk
+{
+/** \class MultiOutputTimeSeriesFunctorImageFilter
+ * \brief Perform a generic pixel-wise operation on the time curves of a vector image and produces m output images.
+ *
+ * This is the counterpart of itk::MultiOutputNaryFunctorImageFilter for time series in voxel-major layout
+ * (see mitk::GenerateVoxelMajorTimeSeries()). Instead of N input images (one per time frame), the filter
+ * gets one itk::VectorImage whose pixels are the time curves. The curve of a voxel is contiguous in memory,
+ * so it is copied in one go into the input array of the functor. The input array is reused for all voxels
+ * of a thread.\n
+ * The functor interface is the same as for itk::MultiOutputNaryFunctorImageFilter, so all functor policies
+ * can be used with both filters. Voxels outside of the mask are set to 0 in all outputs and are not read.
+ *
+ * \ingroup IntensityImageFilters MultiThreaded
+ */
+
+template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage = ::itk::Image<unsigned char, TInputImage::ImageDimension> >
+class ITK_EXPORT MultiOutputTimeSeriesFunctorImageFilter:
+  public ImageToImageFilter< TInputImage, TOutputImage >
+
+{
+public:
+  /** Standard class typedefs. */
+  typedef MultiOutputTimeSeriesFunctorImageFilter         Self;
+  typedef ImageToImageFilter< TInputImage, TOutputImage > Superclass;
+  typedef SmartPointer< Self >                            Pointer;
+  typedef SmartPointer< const Self >                      ConstPointer;
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MultiOutputTimeSeriesFunctorImageFilter, ImageToImageFilter);
+
+  /** Some typedefs. */
+  typedef TFunction                            FunctorType;
+  typedef TInputImage                          InputImageType;
+  typedef typename InputImageType::ConstPointer InputImageConstPointer;
+  typedef typename InputImageType::RegionType  InputImageRegionType;
+  typedef typename InputImageType::PixelType   InputImagePixelType;
+  typedef TOutputImage                         OutputImageType;
+  typedef typename OutputImageType::Pointer    OutputImagePointer;
+  typedef typename OutputImageType::RegionType OutputImageRegionType;
+  typedef typename OutputImageType::PixelType  OutputImagePixelType;
+  typedef typename FunctorType::InputPixelArrayType     NaryInputArrayType;
+  typedef typename FunctorType::OutputPixelArrayType    NaryOutputArrayType;
+  typedef TMaskImage MaskImageType;
+  typedef typename MaskImageType::Pointer     MaskImagePointer;
+  typedef typename MaskImageType::RegionType  MaskImageRegionType;
+
+  /** Get the functor object.  The functor is returned by reference.*/
+  FunctorType & GetFunctor() { return m_Functor; }
+
+  /** Set the functor object.  This replaces the current Functor with a
+   * copy of the specified Functor. This method requires an operator!=()
+   * be defined on the functor. */
+  void SetFunctor(FunctorType & functor)
+  {
+    if ( m_Functor != functor )
+      {
+      m_Functor = functor;
+      this->ActualizeOutputs();
+      this->Modified();
+      }
+  }
+
+  itkSetObjectMacro(Mask, MaskImageType);
+  itkGetConstObjectMacro(Mask, MaskImageType);
+
+  /** ImageDimension constants */
+  itkStaticConstMacro(
+    InputImageDimension, unsigned int, TInputImage::ImageDimension);
+  itkStaticConstMacro(
+    OutputImageDimension, unsigned int, TOutputImage::ImageDimension);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro( SameDimensionCheck,
+                   ( Concept::SameDimension< InputImageDimension, OutputImageDimension > ) );
+  itkConceptMacro( OutputHasZeroCheck,
+                   ( Concept::HasZero< OutputImagePixelType > ) );
+  /** End concept checking */
+#endif
+protected:
+  MultiOutputTimeSeriesFunctorImageFilter();
+  ~MultiOutputTimeSeriesFunctorImageFilter() override {}
+
+  void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                            ThreadIdType threadId) override;
+
+  /** Methods actualize the output settings of the filter according to the current functor*/
+  void ActualizeOutputs();
+
+private:
+  MultiOutputTimeSeriesFunctorImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);         //purposely not implemented
+
+  FunctorType m_Functor;
+  MaskImagePointer m_Mask;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkMultiOutputTimeSeriesFunctorImageFilter.tpp"
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkMultiOutputTimeSeriesFunctorImageFilter_hxx
+#define __itkMultiOutputTimeSeriesFunctorImageFilter_hxx
+
+#include "itkMultiOutputTimeSeriesFunctorImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
+
+#include <vector>
+
+namespace itk
+{
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  MultiOutputTimeSeriesFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::MultiOutputTimeSeriesFunctorImageFilter()
+  {
+    this->DynamicMultiThreadingOff();
+    this->SetNumberOfRequiredInputs(1);
+
+    this->ActualizeOutputs();
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputTimeSeriesFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::ActualizeOutputs()
+  {
+    this->SetNumberOfRequiredOutputs(m_Functor.GetNumberOfOutputs());
+
+    for (typename Superclass::DataObjectPointerArraySizeType i = this->GetNumberOfIndexedOutputs(); i< m_Functor.GetNumberOfOutputs(); ++i)
+    {
+      this->SetNthOutput( i, this->MakeOutput(i) );
+    }
+
+    while(this->GetNumberOfIndexedOutputs() > m_Functor.GetNumberOfOutputs())
+    {
+      this->RemoveOutput(this->GetNumberOfIndexedOutputs()-1);
+    }
+  };
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputTimeSeriesFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+    ThreadIdType threadId)
+  {
+    ProgressReporter progress( this, threadId,
+      outputRegionForThread.GetNumberOfPixels() );
+
+    const InputImageType* input = this->GetInput();
+    if (!input)
+    {
+      return;
+    }
+
+    const unsigned int numberOfTimeSteps = input->GetNumberOfComponentsPerPixel();
+    const unsigned int numberOfOutputImages =
+      static_cast< unsigned int >( this->GetNumberOfIndexedOutputs() );
+
+    typedef ImageRegionConstIterator< TInputImage > InputImageRegionIteratorType;
+    typedef ImageRegionIterator< TOutputImage > OutputImageRegionIteratorType;
+    typedef ImageRegionConstIterator< TMaskImage > MaskImageRegionIteratorType;
+
+    std::vector< OutputImageRegionIteratorType > outputIterators;
+    outputIterators.reserve(numberOfOutputImages);
+
+    for ( unsigned int i = 0; i < numberOfOutputImages; ++i )
+    {
+      OutputImagePointer outputPtr =
+        dynamic_cast< TOutputImage * >( ProcessObject::GetOutput(i) );
+
+      if ( outputPtr )
+      {
+        outputIterators.emplace_back(outputPtr, outputRegionForThread);
+      }
+    }
+
+    if (outputIterators.empty() || numberOfTimeSteps == 0)
+    {
+      return;
+    }
+
+    MaskImageRegionIteratorType maskIterator;
+    const bool hasMask = m_Mask.IsNotNull();
+
+    if (hasMask)
+    {
+      if (!m_Mask->GetLargestPossibleRegion().IsInside(outputRegionForThread))
+      {
+        itkExceptionMacro("Mask of filter is set but does not cover region of thread. Mask region: "<< m_Mask->GetLargestPossibleRegion() <<"Thread region: "<<outputRegionForThread)
+      }
+      maskIterator = MaskImageRegionIteratorType(m_Mask, outputRegionForThread);
+    }
+
+    // The arrays are reused for all voxels of the thread, assign() keeps their memory
+    NaryInputArrayType naryInputArray(numberOfTimeSteps);
+    NaryOutputArrayType naryOutputArray(outputIterators.size());
+
+    for (InputImageRegionIteratorType inputIterator(input, outputRegionForThread); !inputIterator.IsAtEnd(); ++inputIterator)
+    {
+      bool isValid = true;
+
+      if (hasMask)
+      {
+        isValid = maskIterator.Get() > 0;
+        ++maskIterator;
+      }
+
+      if (isValid)
+      {
+        const InputImagePixelType curve = inputIterator.Get();
+        naryInputArray.assign(curve.GetDataPointer(), curve.GetDataPointer() + numberOfTimeSteps);
+
+        naryOutputArray = m_Functor(naryInputArray, inputIterator.GetIndex());
+
+        if (outputIterators.size() != naryOutputArray.size())
+        {
+          itkExceptionMacro("Error. Number of valid output images do not equal number of outputs required by functor. Number of valid outputs: "<< outputIterators.size() << "; needed output number:" << this->m_Functor.GetNumberOfOutputs());
+        }
+      }
+      else
+      {
+        naryOutputArray.assign(outputIterators.size(), 0.0);
+      }
+
+      typename NaryOutputArrayType::const_iterator arrayOutIt = naryOutputArray.begin();
+      for (auto& outputIterator : outputIterators)
+      {
+        outputIterator.Set(*arrayOutIt++);
+        ++outputIterator;
+      }
+
+      progress.CompletedPixel();
+    }
+  }
+} // end namespace itk
+
+#endif
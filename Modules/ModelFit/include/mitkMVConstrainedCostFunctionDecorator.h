@@ -74,6 +74,9 @@ public:
 
     /**Returns the index of the first (in terms of index position) failed parameter in the last failed evaluation.*/
     ParametersType::size_type GetFailedParameter() const;
+
+    /**Reimplementation that skips the computation of the model signal, only the wrapped cost function needs it.*/
+    MeasureType GetValue(const ParametersType& parameter) const override;
 protected:
 
     MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const override;
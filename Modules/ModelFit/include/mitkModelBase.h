@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <itkObject.h>
 
 #include "MitkModelFitExports.h"
+#include "mitkModelEvaluationWorkspace.h"
 #include "mitkModelTraitsInterface.h"
 
 namespace mitk
@@ -168,10 +169,24 @@ namespace mitk
 
     ModelResultType GetSignal(const ParametersType& parameters) const;
 
+    /** Computes the signal like GetSignal(parameters), but writes it into the passed signal and uses the memory
+     * of the passed workspace for intermediate results. Signal is only resized if its size differs from the time grid.
+     * Models that implement EvaluateModelfunction() do not allocate memory once signal and workspace have been used
+     * for an evaluation of the same model, so this is the method of choice for the inner loop of fits.
+     * @param parameters The parameters of the model.
+     * @param [out] signal The computed signal.
+     * @param workspace Memory for intermediate results, e.g. ModelEvaluationWorkspace::GetThreadWorkspace().*/
+    void GetSignal(const ParametersType& parameters, ModelResultType& signal, ModelEvaluationWorkspace& workspace) const;
+
   protected:
 
     virtual ModelResultType ComputeModelfunction(const ParametersType& parameters) const = 0;
 
+    /** Called by GetSignal(parameters, signal, workspace). The default implementation assigns the result of
+     * ComputeModelfunction(). Reimplement to compute the signal in place with the memory of the workspace.*/
+    virtual void EvaluateModelfunction(const ParametersType& parameters, ModelResultType& signal,
+                                       ModelEvaluationWorkspace& workspace) const;
+
     /** Member is called by GetSignal() before ComputeModelfunction(). It indicates if model is in a valid state and
      * ready to compute the signal. The default implementation checks nothing and always returns true.
      * Reimplement to realize special behavior for derived classes.
@@ -0,0 +1,79 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkModelEvaluationWorkspace_h
+#define mitkModelEvaluationWorkspace_h
+
+#include <deque>
+#include <vector>
+
+#include <itkArray.h>
+#include <itkIntTypes.h>
+
+#include "MitkModelFitExports.h"
+
+namespace mitk
+{
+  class ModelBase;
+
+  /** @class ModelEvaluationWorkspace
+   * @brief Reusable memory for the evaluation of models via ModelBase::GetSignal(parameters, signal, workspace).
+   *
+   * Models use scratch arrays for intermediate results and cache arrays for values that only depend on the
+   * model state (e.g. an AIF interpolated to the model time grid). Arrays keep their memory between evaluations,
+   * so repeated evaluations with the same signal length do not allocate. Cache arrays are invalidated whenever the
+   * workspace is used for another model or the model was modified since the last evaluation.
+   *
+   * A workspace must only be used by one thread at a time. GetThreadWorkspace() offers an instance per thread
+   * that can be used for the evaluations of a fit.
+   * @remark Models must not use the workspace for nested evaluations of other models.*/
+  class MITKMODELFIT_EXPORT ModelEvaluationWorkspace
+  {
+  public:
+    typedef itk::Array<double> ArrayType;
+
+    ModelEvaluationWorkspace();
+
+    ModelEvaluationWorkspace(const ModelEvaluationWorkspace&) = delete;
+    ModelEvaluationWorkspace& operator=(const ModelEvaluationWorkspace&) = delete;
+
+    /** Invalidates the cache arrays if model is not the model of the last evaluation or was modified since.
+     * Called by ModelBase::GetSignal() before the model function is computed.*/
+    void PrepareEvaluation(const ModelBase* model);
+
+    /** Returns the scratch array with the given index with the requested size. The content is undefined.
+     * References to arrays of other indices stay valid, so a model can use several scratch arrays at once.*/
+    ArrayType& GetScratchArray(unsigned int index, ArrayType::SizeValueType size);
+
+    /** Returns the cache array with the given index. Its content is only meaningful if IsCacheValid(index).*/
+    ArrayType& GetCacheArray(unsigned int index);
+
+    bool IsCacheValid(unsigned int index) const;
+
+    /** Marks the cache array as valid for the model of the current evaluation.*/
+    void SetCacheValid(unsigned int index);
+
+    /** Returns the workspace of the calling thread.*/
+    static ModelEvaluationWorkspace& GetThreadWorkspace();
+
+  private:
+    // a deque does not move its elements when it grows, returned references remain valid
+    std::deque<ArrayType> m_ScratchArrays;
+    std::deque<ArrayType> m_CacheArrays;
+    std::vector<bool> m_CacheValid;
+
+    const ModelBase* m_Model;
+    itk::ModifiedTimeType m_ModelTime;
+  };
+}
+
+#endif
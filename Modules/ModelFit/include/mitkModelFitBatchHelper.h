@@ -0,0 +1,194 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkModelFitBatchHelper_h
+#define mitkModelFitBatchHelper_h
+
+// std includes
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// MITK includes
+#include <mitkImage.h>
+#include <mitkIOUtil.h>
+#include <mitkLog.h>
+
+#include "MitkModelFitExports.h"
+
+namespace mitk
+{
+  /** One case of a batch. Maps the column names of the case list (e.g. "input", "output", "mask") to the
+  values of the case.*/
+  typedef std::map<std::string, std::string> BatchCase;
+  typedef std::vector<BatchCase> BatchCaseList;
+
+  /** Helper function that reads the case list of a batch run of a command line app.
+  Supported are:
+  - JSON files (extension .json): an array of objects (or an object with the array "cases"); each object is one case.
+  - CSV files (all other extensions): the first line contains the column names; every further line is one case.
+  Values are separated by ',' or ';' and may be enclosed in double quotes. Empty lines and lines starting with '#' are skipped.
+  @exception mitk::Exception if the file cannot be read or is malformed.*/
+  MITKMODELFIT_EXPORT BatchCaseList readBatchCaseList(const std::string& caseListPath);
+
+  /** Helper function that returns the value of the passed key of a case, or defaultValue if the case has no (or an empty) value for it.*/
+  MITKMODELFIT_EXPORT std::string getBatchCaseValue(const BatchCase& batchCase, const std::string& key, const std::string& defaultValue = "");
+
+  /** Writes results in a background thread, so that a batch can already process the next case while the results
+  of the previous one are stored. The number of pending write tasks is bounded; Enqueue() blocks if the writer is
+  too far behind. The destructor waits for all pending tasks.
+  The readers and writers used by IOUtil (e.g. ITK image IOs, GDCM) are not guaranteed to be thread safe, therefore
+  the tasks are executed while holding the mutex returned by GetIOMutex(). Code that loads data concurrently to the
+  writer (like processBatchCases) must hold it as well, so that only computation overlaps with I/O.*/
+  class MITKMODELFIT_EXPORT BatchResultWriter
+  {
+  public:
+    typedef std::function<void()> WriteTaskType;
+
+    explicit BatchResultWriter(unsigned int maximumPendingTasks = 2);
+    ~BatchResultWriter();
+
+    BatchResultWriter(const BatchResultWriter&) = delete;
+    BatchResultWriter& operator=(const BatchResultWriter&) = delete;
+
+    /** Adds a task that writes results. The task must only reference data that stays valid until it is executed
+    (e.g. by capturing smart pointers and copies of paths). Exceptions of the task are reported and counted.*/
+    void Enqueue(WriteTaskType task);
+
+    /** Waits until all enqueued tasks are done and returns the number of tasks that failed so far.*/
+    unsigned int WaitForPendingTasks();
+
+    /** Mutex that serializes the I/O of the write tasks with other I/O of the batch.*/
+    std::mutex& GetIOMutex();
+
+  private:
+    void Run();
+
+    unsigned int m_MaximumPendingTasks;
+    std::deque<WriteTaskType> m_Tasks;
+    bool m_IsWriting = false;
+    bool m_Stop = false;
+    unsigned int m_FailedTasks = 0;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::mutex m_IOMutex;
+    std::thread m_Thread;
+  };
+
+  /** Helper function that processes all cases of a batch with pipelined I/O. The data of the next case is loaded
+  (by loadCase) while the current case is processed (by processCase), and processCase can hand its results over
+  to the passed BatchResultWriter. State that is initialized once (models, AIFs, ITK thread pools) is
+  therefore reused by all cases of the process. A failing case is reported and the batch continues with the next case.
+  @param loadCase Callable with the signature CaseData(const BatchCase&). It is called in a separate thread (for one
+  case at a time, in the order of the list) and must not change state that is used by processCase. It holds the
+  I/O mutex of the writer, so loading and writing never run concurrently.
+  @param processCase Callable with the signature void(const BatchCase&, CaseData&, BatchResultWriter&). Results
+  should be stored via the writer; direct I/O in processCase must lock BatchResultWriter::GetIOMutex().
+  @return Number of cases that failed (loading, processing or writing).*/
+  template <typename TLoadFunction, typename TProcessFunction>
+  unsigned int processBatchCases(const BatchCaseList& cases, TLoadFunction loadCase, TProcessFunction processCase)
+  {
+    typedef std::invoke_result_t<TLoadFunction, const BatchCase&> CaseDataType;
+
+    unsigned int failedCases = 0;
+    BatchResultWriter writer;
+
+    auto startLoading = [&cases, &loadCase, &writer](std::size_t caseIndex)
+    {
+      return std::async(std::launch::async, [&cases, &loadCase, &writer, caseIndex]()
+      {
+        std::lock_guard<std::mutex> ioLock(writer.GetIOMutex());
+        return loadCase(cases[caseIndex]);
+      });
+    };
+
+    std::future<CaseDataType> nextCase;
+    if (!cases.empty())
+    {
+      nextCase = startLoading(0);
+    }
+
+    for (std::size_t i = 0; i < cases.size(); ++i)
+    {
+      std::future<CaseDataType> currentCase = std::move(nextCase);
+      // Cases are loaded one after another, so loadCase may keep state between its calls
+      currentCase.wait();
+      if (i + 1 < cases.size())
+      {
+        nextCase = startLoading(i + 1);
+      }
+
+      MITK_INFO << "Case " << i + 1 << "/" << cases.size();
+      try
+      {
+        CaseDataType caseData = currentCase.get();
+        processCase(cases[i], caseData, writer);
+      }
+      catch (const std::exception& e)
+      {
+        MITK_ERROR << "Case " << i + 1 << " failed: " << e.what();
+        ++failedCases;
+      }
+      catch (...)
+      {
+        MITK_ERROR << "Case " << i + 1 << " failed: unexpected error encountered.";
+        ++failedCases;
+      }
+    }
+
+    failedCases += writer.WaitForPendingTasks();
+
+    MITK_INFO << "Batch finished. Processed cases: " << cases.size() << "; failed: " << failedCases;
+
+    return failedCases;
+  }
+
+  /** Files and images of one case of a model fit command line app.*/
+  struct ModelFitBatchCaseData
+  {
+    std::string inputFileName;
+    std::string outputFileName;
+    std::string maskFileName;
+    std::string aifMaskFileName;
+    std::string aifImageFileName;
+
+    Image::Pointer image;
+    Image::Pointer mask;
+    Image::Pointer aifMask;
+    Image::Pointer aifImage;
+  };
+
+  /** Helper function that loads the images of the passed case. AIF images that are already loaded by previousCase are reused.
+  In batch mode the function is called in a separate thread, so it does not change any global state.
+  @param loadAIF If true, the AIF mask (mandatory) and the AIF image (optional) are loaded as well.
+  @exception mitk::Exception if an image cannot be loaded or the AIF mask is missing.*/
+  MITKMODELFIT_EXPORT ModelFitBatchCaseData loadModelFitBatchCase(ModelFitBatchCaseData caseData,
+    const ModelFitBatchCaseData* previousCase, bool loadAIF, const IOUtil::ReaderOptionsFunctorBase* readerFilterFunctor);
+
+  typedef std::function<void(const BatchCase&, const ModelFitBatchCaseData&, BatchResultWriter&)> ModelFitBatchProcessFunctionType;
+
+  /** Helper function that processes all cases of the passed case list with processBatchCases(). The files of a case are
+  taken from the columns "input", "output", "mask", "aifmask" and "aifimage". Missing mask and AIF files are taken from
+  defaults. Cases without input or output fail.
+  @param processCase Called (in the main thread) for each loaded case. It can hand its results over to the passed writer.
+  @return Number of cases that failed.*/
+  MITKMODELFIT_EXPORT unsigned int processModelFitBatch(const std::string& caseListPath, const ModelFitBatchCaseData& defaults,
+    bool loadAIF, const IOUtil::ReaderOptionsFunctorBase* readerFilterFunctor, const ModelFitBatchProcessFunctionType& processCase);
+}
+#endif
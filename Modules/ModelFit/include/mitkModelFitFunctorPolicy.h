@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include "itkIndex.h"
 #include "mitkModelFitFunctorBase.h"
+#include "mitkSignalConverterBase.h"
 #include "MitkModelFitExports.h"
 
 namespace mitk
@@ -32,6 +33,8 @@ namespace mitk
     typedef ModelFitFunctorBase               FunctorType;
     typedef ModelFitFunctorBase::ConstPointer FunctorConstPointer;
 
+    typedef SignalConverterBase::ConstPointer SignalConverterConstPointer;
+
     typedef itk::Index<3> IndexType;
 
     ModelFitFunctorPolicy()
@@ -72,6 +75,13 @@ namespace mitk
       m_ModelParameterizer = parameterizer;
     }
 
+    /** Sets the converter that is applied to each signal before it is fitted. If no converter is set (default),
+     the signal is fitted as it is.*/
+    void SetSignalConverter(const SignalConverterBase* converter)
+    {
+      m_SignalConverter = converter;
+    }
+
     bool operator!=(const ModelFitFunctorPolicy& other) const
     {
       return !(*this == other);
@@ -80,7 +90,8 @@ namespace mitk
     bool operator==(const ModelFitFunctorPolicy& other) const
     {
       return (this->m_Functor == other.m_Functor) &&
-             (this->m_ModelParameterizer == other.m_ModelParameterizer);
+             (this->m_ModelParameterizer == other.m_ModelParameterizer) &&
+             (this->m_SignalConverter == other.m_SignalConverter);
     }
 
     inline OutputPixelArrayType operator()(const InputPixelArrayType& value,
@@ -100,6 +111,14 @@ namespace mitk
         m_ModelParameterizer->GenerateParameterizedModel(currentIndex);
       ParameterizerType::ParametersType initialParams = m_ModelParameterizer->GetInitialParameterization(
             currentIndex);
+
+      if (m_SignalConverter.IsNotNull())
+      {
+        InputPixelArrayType convertedValue;
+        m_SignalConverter->ConvertSignal(value, currentIndex, convertedValue);
+        return m_Functor->Compute(convertedValue, parameterizedModel, initialParams);
+      }
+
       OutputPixelArrayType result = m_Functor->Compute(value, parameterizedModel, initialParams);
 
       return result;
@@ -109,6 +128,7 @@ namespace mitk
 
     FunctorConstPointer m_Functor;
     ParameterizerConstPointer m_ModelParameterizer;
+    SignalConverterConstPointer m_SignalConverter;
   };
 
 }
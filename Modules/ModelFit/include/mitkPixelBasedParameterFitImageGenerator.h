@@ -19,6 +19,7 @@ found in the LICENSE file.
 
 #include "mitkModelParameterizerBase.h"
 #include "mitkModelFitFunctorBase.h"
+#include "mitkSignalConverterBase.h"
 #include "mitkParameterFitImageGeneratorBase.h"
 
 #include "MitkModelFitExports.h"
@@ -51,6 +52,8 @@ public:
 
     typedef ModelParameterizerBase ParameterizerType;
 
+    typedef SignalConverterBase SignalConverterType;
+
     typedef ParameterFitImageGeneratorBase::ModelBaseType ModelBaseType;
     typedef ParameterFitImageGeneratorBase::ParameterNameType ParameterNameType;
     typedef ParameterFitImageGeneratorBase::ParameterImageMapType ParameterImageMapType;
@@ -67,6 +70,12 @@ public:
     itkSetObjectMacro(ModelParameterizer, ParameterizerType);
     itkGetObjectMacro(ModelParameterizer, ParameterizerType);
 
+    /** Optional converter that is applied to the signal of each voxel before it is fitted. Setting a converter
+     allows to fit e.g. concentration curves directly on the signal image, without generating the converted
+     dynamic image first. If no converter is set (default), the signals of the dynamic image are fitted.*/
+    itkSetObjectMacro(SignalConverter, SignalConverterType);
+    itkGetObjectMacro(SignalConverter, SignalConverterType);
+
     itkSetMacro(TimeGridByParameterizer, bool);
     itkGetMacro(TimeGridByParameterizer, bool);
     itkBooleanMacro(TimeGridByParameterizer);
@@ -114,6 +123,8 @@ private:
 
     ParameterizerType::Pointer m_ModelParameterizer;
 
+    SignalConverterType::Pointer m_SignalConverter;
+
     ParameterImageMapType m_TempResultMap;
     ParameterImageMapType m_TempDerivedResultMap;
     ParameterImageMapType m_TempEvaluationResultMap;
@@ -62,6 +62,12 @@ protected:
 
     SignalType m_Sample;
 
+    /** Signal of the last evaluation, reused to avoid allocations in GetValue().*/
+    mutable SignalType m_Signal;
+
+    /** Shifted parameters of the numerical derivative, reused to avoid allocations in GetDerivative().*/
+    mutable ParametersType m_DerivativeParameters;
+
 private:
     ModelBase::ConstPointer m_Model;
 
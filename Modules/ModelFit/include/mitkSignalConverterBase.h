@@ -0,0 +1,66 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSignalConverterBase_h
+#define mitkSignalConverterBase_h
+
+#include <itkObject.h>
+#include <itkIndex.h>
+
+#include "mitkModelFitFunctorBase.h"
+
+#include "MitkModelFitExports.h"
+
+namespace mitk
+{
+  /** Base class for converters that transform the signal curve of a voxel before it is fitted
+   * (e.g. MR signal into contrast agent concentration).
+   * Pixel based fits can use a converter to convert and fit each voxel in one pass, instead of
+   * generating a converted dynamic image first (see PixelBasedParameterFitImageGenerator::SetSignalConverter()).*/
+  class MITKMODELFIT_EXPORT SignalConverterBase : public ::itk::Object
+  {
+  public:
+    typedef SignalConverterBase Self;
+    typedef itk::Object Superclass;
+    typedef itk::SmartPointer< Self >                            Pointer;
+    typedef itk::SmartPointer< const Self >                      ConstPointer;
+
+    itkTypeMacro(SignalConverterBase, itk::Object);
+
+    typedef ModelFitFunctorBase::InputPixelArrayType SignalType;
+    typedef itk::Index<3> IndexType;
+
+    /** Is called once before the first call of ConvertSignal(). Converters should check their settings
+     * and precompute everything that is shared by all voxels.
+     * @exception Exception will be thrown if the converter is not configured correctly.*/
+    virtual void PrepareSignalConversion() {};
+
+    /** Converts the signal curve of the voxel at the passed index.
+     * The method is called concurrently by the fitting threads, so implementations must be thread safe.
+     * @param signal Signal curve of the voxel.
+     * @param index Index of the voxel in the (spatial) geometry of the dynamic image.
+     * @param converted Converted curve. It is resized to the size of signal.*/
+    virtual void ConvertSignal(const SignalType& signal, const IndexType& index, SignalType& converted) const = 0;
+
+  protected:
+    SignalConverterBase() = default;
+    ~SignalConverterBase() override = default;
+
+  private:
+    //No copy constructor allowed
+    SignalConverterBase(const Self& source);
+    void operator=(const Self&);  //purposely not implemented
+  };
+
+}
+
+#endif
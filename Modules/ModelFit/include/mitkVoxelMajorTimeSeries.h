@@ -0,0 +1,102 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkVoxelMajorTimeSeries_h
+#define mitkVoxelMajorTimeSeries_h
+
+#include <algorithm>
+
+#include <itkImage.h>
+#include <itkVectorImage.h>
+
+namespace mitk
+{
+  /** Converts a dynamic image, whose last dimension is the time, into a vector image with one dimension less.
+   * Each pixel of the vector image is the time curve of the respective voxel, so the curve is contiguous in memory
+   * (voxel-major layout) instead of being spread over one buffer per time frame.
+   * The geometry of the vector image is the geometry of the spatial dimensions of the dynamic image.
+   * The conversion is done in one pass over blocks of voxels, such that the frames are read sequentially and the
+   * written curves of a block stay in the cache.
+   * @pre The buffered region of dynamicImage must be its largest possible region.*/
+  template <typename TPixel, unsigned int VDim>
+  typename itk::VectorImage<TPixel, VDim - 1>::Pointer GenerateVoxelMajorTimeSeries(
+    const itk::Image<TPixel, VDim>* dynamicImage)
+  {
+    using TimeSeriesImageType = itk::VectorImage<TPixel, VDim - 1>;
+
+    if (!dynamicImage)
+    {
+      itkGenericExceptionMacro(<< "Error. Cannot generate voxel-major time series. Dynamic image is Null.");
+    }
+
+    const auto dynamicRegion = dynamicImage->GetBufferedRegion();
+    if (dynamicRegion != dynamicImage->GetLargestPossibleRegion())
+    {
+      itkGenericExceptionMacro(<< "Error. Cannot generate voxel-major time series. Dynamic image is not completely buffered.");
+    }
+
+    typename TimeSeriesImageType::RegionType region;
+    typename TimeSeriesImageType::PointType origin;
+    typename TimeSeriesImageType::SpacingType spacing;
+    typename TimeSeriesImageType::DirectionType direction;
+
+    for (unsigned int i = 0; i < VDim - 1; ++i)
+    {
+      region.SetIndex(i, dynamicRegion.GetIndex(i));
+      region.SetSize(i, dynamicRegion.GetSize(i));
+      origin[i] = dynamicImage->GetOrigin()[i];
+      spacing[i] = dynamicImage->GetSpacing()[i];
+
+      for (unsigned int j = 0; j < VDim - 1; ++j)
+      {
+        direction[i][j] = dynamicImage->GetDirection()[i][j];
+      }
+    }
+
+    const unsigned int numberOfTimeSteps = dynamicRegion.GetSize(VDim - 1);
+
+    typename TimeSeriesImageType::Pointer timeSeriesImage = TimeSeriesImageType::New();
+    timeSeriesImage->SetRegions(region);
+    timeSeriesImage->SetOrigin(origin);
+    timeSeriesImage->SetSpacing(spacing);
+    timeSeriesImage->SetDirection(direction);
+    timeSeriesImage->SetVectorLength(numberOfTimeSteps);
+    timeSeriesImage->Allocate();
+
+    const std::size_t numberOfVoxels = region.GetNumberOfPixels();
+    const TPixel* source = dynamicImage->GetBufferPointer();
+    TPixel* destination = timeSeriesImage->GetBufferPointer();
+
+    // Blocks of voxels whose curves fit into the first level cache together with the read frame chunks
+    const std::size_t blockSize = std::max<std::size_t>(16, 4096 / std::max<std::size_t>(1, numberOfTimeSteps));
+
+    for (std::size_t blockBegin = 0; blockBegin < numberOfVoxels; blockBegin += blockSize)
+    {
+      const std::size_t blockEnd = std::min(numberOfVoxels, blockBegin + blockSize);
+
+      for (unsigned int t = 0; t < numberOfTimeSteps; ++t)
+      {
+        const TPixel* frame = source + t * numberOfVoxels;
+        TPixel* curves = destination + t;
+
+        for (std::size_t voxel = blockBegin; voxel < blockEnd; ++voxel)
+        {
+          curves[voxel * numberOfTimeSteps] = frame[voxel];
+        }
+      }
+    }
+
+    return timeSeriesImage;
+  }
+}
+
+#endif
@@ -0,0 +1,349 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkModelFitBatchHelper.h>
+
+#include <mitkExceptionMacro.h>
+
+#include "itksys/SystemTools.hxx"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+namespace
+{
+  std::string trim(const std::string& value)
+  {
+    const auto first = value.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos)
+    {
+      return std::string();
+    }
+    const auto last = value.find_last_not_of(" \t\r\n");
+    return value.substr(first, last - first + 1);
+  }
+
+  std::vector<std::string> splitCSVLine(const std::string& line, char separator)
+  {
+    std::vector<std::string> result;
+    std::string value;
+    bool isQuoted = false;
+
+    for (std::size_t i = 0; i < line.size(); ++i)
+    {
+      const char c = line[i];
+      if (c == '"')
+      {
+        if (isQuoted && i + 1 < line.size() && line[i + 1] == '"')
+        {
+          value += '"';
+          ++i;
+        }
+        else
+        {
+          isQuoted = !isQuoted;
+        }
+      }
+      else if (c == separator && !isQuoted)
+      {
+        result.push_back(trim(value));
+        value.clear();
+      }
+      else
+      {
+        value += c;
+      }
+    }
+    result.push_back(trim(value));
+
+    return result;
+  }
+
+  mitk::BatchCaseList readCSVCaseList(std::istream& stream, const std::string& caseListPath)
+  {
+    mitk::BatchCaseList cases;
+    std::vector<std::string> columns;
+    char separator = ',';
+    std::string line;
+    unsigned int lineNumber = 0;
+
+    while (std::getline(stream, line))
+    {
+      ++lineNumber;
+      line = trim(line);
+      if (line.empty() || line[0] == '#')
+      {
+        continue;
+      }
+
+      if (columns.empty())
+      {
+        if (line.find(',') == std::string::npos && line.find(';') != std::string::npos)
+        {
+          separator = ';';
+        }
+        columns = splitCSVLine(line, separator);
+        continue;
+      }
+
+      auto values = splitCSVLine(line, separator);
+      if (values.size() > columns.size())
+      {
+        mitkThrow() << "Cannot read case list " << caseListPath << ". Line " << lineNumber << " has more values than the header has columns.";
+      }
+
+      mitk::BatchCase batchCase;
+      for (std::size_t i = 0; i < values.size(); ++i)
+      {
+        batchCase[columns[i]] = values[i];
+      }
+      cases.push_back(batchCase);
+    }
+
+    return cases;
+  }
+
+  mitk::BatchCaseList readJSONCaseList(std::istream& stream, const std::string& caseListPath)
+  {
+    nlohmann::json json;
+    try
+    {
+      json = nlohmann::json::parse(stream);
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+      mitkThrow() << "Cannot read case list " << caseListPath << ". Invalid JSON: " << e.what();
+    }
+
+    if (json.is_object() && json.contains("cases"))
+    {
+      json = json["cases"];
+    }
+
+    if (!json.is_array())
+    {
+      mitkThrow() << "Cannot read case list " << caseListPath << ". Expected an array of cases.";
+    }
+
+    mitk::BatchCaseList cases;
+    for (const auto& jsonCase : json)
+    {
+      if (!jsonCase.is_object())
+      {
+        mitkThrow() << "Cannot read case list " << caseListPath << ". Each case must be an object.";
+      }
+
+      mitk::BatchCase batchCase;
+      for (const auto& item : jsonCase.items())
+      {
+        batchCase[item.key()] = item.value().is_string() ? item.value().get<std::string>() : item.value().dump();
+      }
+      cases.push_back(batchCase);
+    }
+
+    return cases;
+  }
+}
+
+MITKMODELFIT_EXPORT mitk::BatchCaseList mitk::readBatchCaseList(const std::string& caseListPath)
+{
+  std::ifstream stream(caseListPath);
+  if (!stream.is_open())
+  {
+    mitkThrow() << "Cannot open case list: " << caseListPath;
+  }
+
+  const std::string ext = itksys::SystemTools::LowerCase(itksys::SystemTools::GetFilenameLastExtension(caseListPath));
+
+  if (ext == ".json")
+  {
+    return readJSONCaseList(stream, caseListPath);
+  }
+
+  return readCSVCaseList(stream, caseListPath);
+}
+
+MITKMODELFIT_EXPORT std::string mitk::getBatchCaseValue(const BatchCase& batchCase, const std::string& key, const std::string& defaultValue)
+{
+  auto finding = batchCase.find(key);
+  if (finding == batchCase.end() || finding->second.empty())
+  {
+    return defaultValue;
+  }
+  return finding->second;
+}
+
+mitk::BatchResultWriter::BatchResultWriter(unsigned int maximumPendingTasks)
+  : m_MaximumPendingTasks(std::max(1u, maximumPendingTasks))
+{
+  m_Thread = std::thread(&BatchResultWriter::Run, this);
+}
+
+mitk::BatchResultWriter::~BatchResultWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_Condition.notify_all();
+  m_Thread.join();
+}
+
+void mitk::BatchResultWriter::Enqueue(WriteTaskType task)
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_Condition.wait(lock, [this]() { return m_Tasks.size() < m_MaximumPendingTasks; });
+  m_Tasks.push_back(std::move(task));
+  lock.unlock();
+  m_Condition.notify_all();
+}
+
+unsigned int mitk::BatchResultWriter::WaitForPendingTasks()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_Condition.wait(lock, [this]() { return m_Tasks.empty() && !m_IsWriting; });
+  return m_FailedTasks;
+}
+
+std::mutex& mitk::BatchResultWriter::GetIOMutex()
+{
+  return m_IOMutex;
+}
+
+void mitk::BatchResultWriter::Run()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
+  while (true)
+  {
+    m_Condition.wait(lock, [this]() { return m_Stop || !m_Tasks.empty(); });
+
+    if (m_Tasks.empty())
+    {
+      // stop was requested and all tasks are done
+      return;
+    }
+
+    WriteTaskType task = std::move(m_Tasks.front());
+    m_Tasks.pop_front();
+    m_IsWriting = true;
+    lock.unlock();
+    m_Condition.notify_all();
+
+    bool failed = false;
+    try
+    {
+      std::lock_guard<std::mutex> ioLock(m_IOMutex);
+      task();
+    }
+    catch (const std::exception& e)
+    {
+      MITK_ERROR << "Writing of results failed: " << e.what();
+      failed = true;
+    }
+    catch (...)
+    {
+      MITK_ERROR << "Writing of results failed: unexpected error encountered.";
+      failed = true;
+    }
+
+    lock.lock();
+    m_IsWriting = false;
+    if (failed)
+    {
+      ++m_FailedTasks;
+    }
+    m_Condition.notify_all();
+  }
+}
+
+MITKMODELFIT_EXPORT mitk::ModelFitBatchCaseData mitk::loadModelFitBatchCase(ModelFitBatchCaseData caseData,
+  const ModelFitBatchCaseData* previousCase, bool loadAIF, const IOUtil::ReaderOptionsFunctorBase* readerFilterFunctor)
+{
+  caseData.image = IOUtil::Load<Image>(caseData.inputFileName, readerFilterFunctor);
+
+  if (!caseData.maskFileName.empty())
+  {
+    caseData.mask = IOUtil::Load<Image>(caseData.maskFileName, readerFilterFunctor);
+  }
+
+  if (loadAIF)
+  {
+    if (caseData.aifMaskFileName.empty())
+    {
+      mitkThrow() << "Error. Cannot fit. Chosen model needs an AIF. Please specify AIF mask (--aifmask).";
+    }
+
+    if (previousCase && previousCase->aifMaskFileName == caseData.aifMaskFileName)
+    {
+      caseData.aifMask = previousCase->aifMask;
+    }
+    else
+    {
+      caseData.aifMask = IOUtil::Load<Image>(caseData.aifMaskFileName, readerFilterFunctor);
+    }
+
+    if (!caseData.aifImageFileName.empty())
+    {
+      if (previousCase && previousCase->aifImageFileName == caseData.aifImageFileName)
+      {
+        caseData.aifImage = previousCase->aifImage;
+      }
+      else
+      {
+        caseData.aifImage = IOUtil::Load<Image>(caseData.aifImageFileName, readerFilterFunctor);
+      }
+    }
+  }
+
+  return caseData;
+}
+
+MITKMODELFIT_EXPORT unsigned int mitk::processModelFitBatch(const std::string& caseListPath, const ModelFitBatchCaseData& defaults,
+  bool loadAIF, const IOUtil::ReaderOptionsFunctorBase* readerFilterFunctor, const ModelFitBatchProcessFunctionType& processCase)
+{
+  const BatchCaseList cases = readBatchCaseList(caseListPath);
+  MITK_INFO << "Batch: " << caseListPath << " (" << cases.size() << " cases)";
+
+  // cases are loaded one after another, so the previous case can be kept to reuse its AIF images
+  ModelFitBatchCaseData previousCase;
+  bool hasPreviousCase = false;
+
+  auto loadCase = [&previousCase, &hasPreviousCase, &defaults, loadAIF, readerFilterFunctor](const BatchCase& batchCase)
+  {
+    ModelFitBatchCaseData caseData;
+    caseData.inputFileName = getBatchCaseValue(batchCase, "input");
+    caseData.outputFileName = getBatchCaseValue(batchCase, "output");
+    caseData.maskFileName = getBatchCaseValue(batchCase, "mask", defaults.maskFileName);
+    caseData.aifMaskFileName = getBatchCaseValue(batchCase, "aifmask", defaults.aifMaskFileName);
+    caseData.aifImageFileName = getBatchCaseValue(batchCase, "aifimage", defaults.aifImageFileName);
+
+    if (caseData.inputFileName.empty())
+    {
+      mitkThrow() << "Invalid case. No input specified.";
+    }
+
+    if (caseData.outputFileName.empty())
+    {
+      mitkThrow() << "Invalid case. No output specified.";
+    }
+
+    caseData = loadModelFitBatchCase(caseData, hasPreviousCase ? &previousCase : nullptr, loadAIF, readerFilterFunctor);
+    previousCase = caseData;
+    hasPreviousCase = true;
+    return caseData;
+  };
+
+  return processBatchCases(cases, loadCase, processCase);
+}
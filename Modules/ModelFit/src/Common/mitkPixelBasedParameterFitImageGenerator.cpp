@@ -11,13 +11,13 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "itkCommand.h"
-#include "itkMultiOutputNaryFunctorImageFilter.h"
+#include "itkMultiOutputTimeSeriesFunctorImageFilter.h"
 
 #include "mitkPixelBasedParameterFitImageGenerator.h"
-#include "mitkImageTimeSelector.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
 #include "mitkModelFitFunctorPolicy.h"
+#include "mitkVoxelMajorTimeSeries.h"
 
 #include "mitkExtractTimeGrid.h"
 
@@ -79,12 +79,12 @@ mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType StoreResultIma
 
 template <typename TPixel, unsigned int VDim>
 void
-  mitk::PixelBasedParameterFitImageGenerator::DoParameterFit(itk::Image<TPixel, VDim>* /*image*/)
+  mitk::PixelBasedParameterFitImageGenerator::DoParameterFit(itk::Image<TPixel, VDim>* image)
 {
-  using InputFrameImageType = itk::Image<TPixel, VDim-1>;
+  using InputTimeSeriesImageType = itk::VectorImage<TPixel, VDim-1>;
   using ParameterImageType = itk::Image<ScalarType, VDim-1>;
 
-  using FitFilterType = itk::MultiOutputNaryFunctorImageFilter<InputFrameImageType, ParameterImageType, ModelFitFunctorPolicy, InternalMaskType>;
+  using FitFilterType = itk::MultiOutputTimeSeriesFunctorImageFilter<InputTimeSeriesImageType, ParameterImageType, ModelFitFunctorPolicy, InternalMaskType>;
 
   typename FitFilterType::Pointer fitFilter = FitFilterType::New();
 
@@ -92,21 +92,9 @@ void
   spProgressCommand->SetCallbackFunction(this, &Self::onFitProgressEvent);
   fitFilter->AddObserver(::itk::ProgressEvent(), spProgressCommand);
 
-  //add the time frames to the fit filter
-  mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
-  imageTimeSelector->SetInput(this->m_DynamicImage);
-  std::vector<Image::Pointer> frameCache;
-  for (unsigned int i = 0; i < this->m_DynamicImage->GetTimeSteps(); ++i)
-  {
-    typename InputFrameImageType::Pointer frameImage;
-    imageTimeSelector->SetTimeNr(i);
-    imageTimeSelector->UpdateLargestPossibleRegion();
-
-    Image::Pointer frameMITKImage = imageTimeSelector->GetOutput();
-    frameCache.push_back(frameMITKImage);
-    mitk::CastToItkImage(frameMITKImage, frameImage);
-    fitFilter->SetInput(i,frameImage);
-  }
+  //transpose the dynamic image once, so that the fit reads the time curve of each voxel from contiguous memory
+  typename InputTimeSeriesImageType::Pointer timeSeriesImage = GenerateVoxelMajorTimeSeries(image);
+  fitFilter->SetInput(timeSeriesImage);
 
   ModelBaseType::TimeGridType timeGrid = ExtractTimeGrid(m_DynamicImage);
   if (m_TimeGridByParameterizer)
@@ -126,6 +114,11 @@ void
 
   functor.SetModelFitFunctor(this->m_FitFunctor);
   functor.SetModelParameterizer(this->m_ModelParameterizer);
+  if (this->m_SignalConverter.IsNotNull())
+  {
+    this->m_SignalConverter->PrepareSignalConversion();
+    functor.SetSignalConverter(this->m_SignalConverter);
+  }
   fitFilter->SetFunctor(functor);
   if (this->m_InternalMask.IsNotNull())
   {
@@ -179,6 +172,14 @@ bool
     }
   }
 
+  if (m_SignalConverter.IsNotNull())
+  {
+    if (m_SignalConverter->GetMTime() > this->m_GenerationTimeStamp)
+    {
+      result = true;
+    }
+  }
+
   if (m_DynamicImage.IsNotNull())
   {
     if (m_DynamicImage->GetMTime() > this->m_GenerationTimeStamp)
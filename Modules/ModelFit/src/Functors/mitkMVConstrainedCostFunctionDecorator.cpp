@@ -61,6 +61,12 @@ mitk::MVConstrainedCostFunctionDecorator::MeasureType
   return measure;
 }
 
+mitk::MVConstrainedCostFunctionDecorator::MeasureType
+  mitk::MVConstrainedCostFunctionDecorator::GetValue(const ParametersType &parameter) const
+{
+  return CalcMeasure(parameter, m_Sample);
+}
+
 double
 mitk::MVConstrainedCostFunctionDecorator::
 GetPenaltyRatio() const
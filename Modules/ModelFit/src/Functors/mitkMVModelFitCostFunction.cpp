@@ -19,7 +19,9 @@ mitk::MVModelFitCostFunction::MeasureType mitk::MVModelFitCostFunction::GetValue
 {
   MeasureType measure;
 
-  SignalType signal = m_Model->GetSignal(parameter);
+  // the signal is computed in place with the workspace of the thread, the fit does not allocate memory for it
+  m_Model->GetSignal(parameter, m_Signal, ModelEvaluationWorkspace::GetThreadWorkspace());
+  const SignalType& signal = m_Signal;
 
   if(signal.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
   if(signal.GetSize() == 0)  itkExceptionMacro("Signal is empty!");
@@ -38,7 +40,8 @@ void mitk::MVModelFitCostFunction::GetDerivative (const ParametersType &paramete
 
   for ( ParametersType::SizeValueType i = 0; i < paramCount; i++ )
   {
-    ParametersType newParameters = parameters;
+    ParametersType& newParameters = m_DerivativeParameters;
+    newParameters = parameters;
     newParameters[i] -= m_DerivativeStepLength;
 
     MeasureType e0 = GetValue(newParameters);
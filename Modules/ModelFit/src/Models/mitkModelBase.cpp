@@ -146,6 +146,33 @@ mitk::ModelBase::ModelResultType mitk::ModelBase::GetSignal(const ParametersType
   return signal;
 }
 
+void mitk::ModelBase::GetSignal(const ParametersType& parameters, ModelResultType& signal,
+                                ModelEvaluationWorkspace& workspace) const
+{
+  if (parameters.size() != this->GetNumberOfParameters())
+  {
+    itkExceptionMacro("Passed parameter set has wrong size for model. Cannot evaluate model. Required size: "
+                      << this->GetNumberOfParameters() << "; passed parameters: " << parameters);
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot evaluate model and return signal. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  workspace.PrepareEvaluation(this);
+  EvaluateModelfunction(parameters, signal, workspace);
+}
+
+void mitk::ModelBase::EvaluateModelfunction(const ParametersType& parameters, ModelResultType& signal,
+                                            ModelEvaluationWorkspace& /*workspace*/) const
+{
+  signal = ComputeModelfunction(parameters);
+}
+
 bool mitk::ModelBase::ValidateModel(std::string& /*error*/) const
 {
   return true;
@@ -0,0 +1,73 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkModelEvaluationWorkspace.h"
+#include "mitkModelBase.h"
+
+#include <algorithm>
+
+mitk::ModelEvaluationWorkspace::ModelEvaluationWorkspace() : m_Model(nullptr), m_ModelTime(0)
+{
+}
+
+void mitk::ModelEvaluationWorkspace::PrepareEvaluation(const ModelBase* model)
+{
+  // The modification time stamps of ITK are unique, so a new model at the address of a deleted one
+  // can not be mistaken for it.
+  if (model != m_Model || model->GetMTime() != m_ModelTime)
+  {
+    std::fill(m_CacheValid.begin(), m_CacheValid.end(), false);
+    m_Model = model;
+    m_ModelTime = model->GetMTime();
+  }
+}
+
+mitk::ModelEvaluationWorkspace::ArrayType& mitk::ModelEvaluationWorkspace::GetScratchArray(unsigned int index,
+  ArrayType::SizeValueType size)
+{
+  if (index >= m_ScratchArrays.size())
+  {
+    m_ScratchArrays.resize(index + 1);
+  }
+
+  ArrayType& result = m_ScratchArrays[index];
+  result.SetSize(size);
+  return result;
+}
+
+mitk::ModelEvaluationWorkspace::ArrayType& mitk::ModelEvaluationWorkspace::GetCacheArray(unsigned int index)
+{
+  if (index >= m_CacheArrays.size())
+  {
+    m_CacheArrays.resize(index + 1);
+    m_CacheValid.resize(index + 1, false);
+  }
+
+  return m_CacheArrays[index];
+}
+
+bool mitk::ModelEvaluationWorkspace::IsCacheValid(unsigned int index) const
+{
+  return index < m_CacheValid.size() && m_CacheValid[index];
+}
+
+void mitk::ModelEvaluationWorkspace::SetCacheValid(unsigned int index)
+{
+  this->GetCacheArray(index);
+  m_CacheValid[index] = true;
+}
+
+mitk::ModelEvaluationWorkspace& mitk::ModelEvaluationWorkspace::GetThreadWorkspace()
+{
+  thread_local ModelEvaluationWorkspace workspace;
+  return workspace;
+}
@@ -1,5 +1,6 @@
 SET(MODULE_TESTS
   itkMultiOutputNaryFunctorImageFilterTest.cpp
+  itkMultiOutputTimeSeriesFunctorImageFilterTest.cpp
   itkMaskedStatisticsImageFilterTest.cpp
   itkMaskedNaryStatisticsImageFilterTest.cpp
   mitkLevenbergMarquardtModelFitFunctorTest.cpp
@@ -19,4 +20,5 @@ SET(MODULE_TESTS
   mitkTwoStepLinearModelTest.cpp
   mitkThreeStepLinearModelTest.cpp
   mitkExponentialSaturationModelTest.cpp
+  mitkModelFitBatchHelperTest.cpp
 )
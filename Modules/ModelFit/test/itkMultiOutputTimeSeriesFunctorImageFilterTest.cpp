@@ -0,0 +1,175 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+
+#include "itkMultiOutputNaryFunctorImageFilter.h"
+#include "itkMultiOutputTimeSeriesFunctorImageFilter.h"
+
+#include "mitkTestingMacros.h"
+#include "mitkVoxelMajorTimeSeries.h"
+
+#include "mitkTestDynamicImageGenerator.h"
+
+class TimeSeriesTestFunctor
+{
+public:
+  typedef std::vector<int> InputPixelArrayType;
+  typedef std::vector<int> OutputPixelArrayType;
+  typedef itk::Index<2> IndexType;
+
+  unsigned int GetNumberOfOutputs() const
+  {
+    return 4;
+  }
+
+  bool operator!=( const TimeSeriesTestFunctor & other) const
+  {
+    return !(*this == other);
+  }
+
+  bool operator==( const TimeSeriesTestFunctor & /*other*/ ) const
+  {
+    return true;
+  }
+
+  inline OutputPixelArrayType operator()( const InputPixelArrayType & value, const IndexType& currentIndex ) const
+  {
+    OutputPixelArrayType result;
+
+    int sum = 0;
+    for (InputPixelArrayType::const_iterator pos = value.begin(); pos != value.end(); ++pos)
+    {
+      sum += *pos;
+    }
+
+    result.push_back(sum);
+    result.push_back(value.back() - value.front());
+    result.push_back(currentIndex[0]);
+    result.push_back(currentIndex[1]);
+
+    return result;
+  }
+};
+
+typedef itk::Image<int, 3> TestDynamicImageType;
+
+/** Stacks the frames along the third dimension, like a dynamic image of 2D frames.*/
+static TestDynamicImageType::Pointer GenerateDynamicImage(const std::vector<mitk::TestImageType::Pointer>& frames)
+{
+  mitk::TestImageType::RegionType frameRegion = frames.front()->GetLargestPossibleRegion();
+
+  TestDynamicImageType::RegionType region;
+  TestDynamicImageType::SpacingType spacing;
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    region.SetIndex(i, frameRegion.GetIndex(i));
+    region.SetSize(i, frameRegion.GetSize(i));
+    spacing[i] = frames.front()->GetSpacing()[i];
+  }
+  region.SetIndex(2, 0);
+  region.SetSize(2, frames.size());
+  spacing[2] = 1.0;
+
+  TestDynamicImageType::Pointer image = TestDynamicImageType::New();
+  image->SetRegions(region);
+  image->SetSpacing(spacing);
+  image->Allocate();
+
+  for (itk::ImageRegionIterator<TestDynamicImageType> pos(image, region); !pos.IsAtEnd(); ++pos)
+  {
+    mitk::TestImageType::IndexType frameIndex;
+    frameIndex[0] = pos.GetIndex()[0];
+    frameIndex[1] = pos.GetIndex()[1];
+    pos.Set(frames[pos.GetIndex()[2]]->GetPixel(frameIndex));
+  }
+
+  return image;
+}
+
+int itkMultiOutputTimeSeriesFunctorImageFilterTest(int  /*argc*/, char*[] /*argv[]*/)
+{
+  // always start with this!
+  MITK_TEST_BEGIN("itkMultiOutputTimeSeriesFunctorImageFilter")
+
+  std::vector<mitk::TestImageType::Pointer> frames;
+  frames.push_back(mitk::GenerateTestImage());
+  frames.push_back(mitk::GenerateTestImage(10));
+  frames.push_back(mitk::GenerateTestImage(100));
+  frames.push_back(mitk::GenerateTestImage(3));
+
+  TestDynamicImageType::Pointer dynamicImage = GenerateDynamicImage(frames);
+
+  //Test voxel-major transposition
+  typedef itk::VectorImage<int, 2> TimeSeriesImageType;
+  TimeSeriesImageType::Pointer timeSeriesImage = mitk::GenerateVoxelMajorTimeSeries(dynamicImage.GetPointer());
+
+  CPPUNIT_ASSERT_MESSAGE("Check vector length of time series image", 4 == timeSeriesImage->GetNumberOfComponentsPerPixel());
+  CPPUNIT_ASSERT_MESSAGE("Check region of time series image", frames.front()->GetLargestPossibleRegion() == timeSeriesImage->GetLargestPossibleRegion());
+
+  bool curvesAreCorrect = true;
+  for (itk::ImageRegionConstIterator<mitk::TestImageType> pos(frames.front(), frames.front()->GetLargestPossibleRegion()); !pos.IsAtEnd(); ++pos)
+  {
+    const TimeSeriesImageType::PixelType curve = timeSeriesImage->GetPixel(pos.GetIndex());
+    for (unsigned int t = 0; t < frames.size(); ++t)
+    {
+      curvesAreCorrect = curvesAreCorrect && curve[t] == frames[t]->GetPixel(pos.GetIndex());
+    }
+  }
+  CPPUNIT_ASSERT_MESSAGE("Check time curves of time series image", curvesAreCorrect);
+
+  //Test that the filter generates the same outputs as the nary filter on the frames
+  typedef itk::MultiOutputNaryFunctorImageFilter<mitk::TestImageType, mitk::TestImageType, TimeSeriesTestFunctor> NaryFilterType;
+  typedef itk::MultiOutputTimeSeriesFunctorImageFilter<TimeSeriesImageType, mitk::TestImageType, TimeSeriesTestFunctor> TimeSeriesFilterType;
+
+  NaryFilterType::Pointer naryFilter = NaryFilterType::New();
+  for (unsigned int t = 0; t < frames.size(); ++t)
+  {
+    naryFilter->SetInput(t, frames[t]);
+  }
+
+  TimeSeriesFilterType::Pointer testFilter = TimeSeriesFilterType::New();
+  testFilter->SetInput(timeSeriesImage);
+  testFilter->SetNumberOfWorkUnits(2);
+
+  mitk::TestMaskType::Pointer mask = mitk::GenerateTestMask();
+
+  for (unsigned int run = 0; run < 2; ++run)
+  {
+    if (run == 1)
+    {
+      naryFilter->SetMask(mask);
+      testFilter->SetMask(mask);
+    }
+
+    naryFilter->Update();
+    testFilter->Update();
+
+    CPPUNIT_ASSERT_MESSAGE("Check number of outputs", naryFilter->GetNumberOfOutputs() == testFilter->GetNumberOfOutputs());
+
+    for (unsigned int i = 0; i < testFilter->GetNumberOfOutputs(); ++i)
+    {
+      bool outputsAreEqual = true;
+      itk::ImageRegionConstIterator<mitk::TestImageType> expected(naryFilter->GetOutput(i), naryFilter->GetOutput(i)->GetLargestPossibleRegion());
+      itk::ImageRegionConstIterator<mitk::TestImageType> actual(testFilter->GetOutput(i), testFilter->GetOutput(i)->GetLargestPossibleRegion());
+      for (; !expected.IsAtEnd() && !actual.IsAtEnd(); ++expected, ++actual)
+      {
+        outputsAreEqual = outputsAreEqual && expected.Get() == actual.Get();
+      }
+
+      MITK_TEST_CONDITION(outputsAreEqual && expected.IsAtEnd() && actual.IsAtEnd(), "Check output #" << i << (run == 1 ? " with mask" : " without mask"));
+    }
+  }
+
+  MITK_TEST_END()
+}
@@ -0,0 +1,272 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <mitkIOUtil.h>
+#include <mitkImageGenerator.h>
+#include <mitkModelFitBatchHelper.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+class mitkModelFitBatchHelperTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkModelFitBatchHelperTestSuite);
+
+  MITK_TEST(ReadCSVCaseList);
+  MITK_TEST(ReadCSVCaseListWithSemicolons);
+  MITK_TEST(ReadCSVCaseListWithMissingColumns);
+  MITK_TEST(ReadCSVCaseListWithTooManyValues);
+  MITK_TEST(ReadJSONCaseList);
+  MITK_TEST(ReadInvalidJSONCaseList);
+  MITK_TEST(ReadMissingCaseList);
+  MITK_TEST(LoadCaseWithBadPaths);
+  MITK_TEST(ProcessBatch);
+  MITK_TEST(ProcessBatchCasesSerializesIO);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_TempDir;
+  std::string m_ImagePath;
+
+  std::string WriteCaseList(const std::string& fileName, const std::string& content)
+  {
+    const std::string path = m_TempDir + "/" + fileName;
+    std::ofstream stream(path);
+    stream << content;
+    return path;
+  }
+
+public:
+  void setUp() override
+  {
+    m_TempDir = mitk::IOUtil::CreateTemporaryDirectory("ModelFitBatchHelperTest-XXXXXX");
+
+    auto image = mitk::ImageGenerator::GenerateRandomImage<short>(4, 4, 2, 1);
+    m_ImagePath = m_TempDir + "/image.nrrd";
+    mitk::IOUtil::Save(image, m_ImagePath);
+  }
+
+  void tearDown() override
+  {
+    itksys::SystemTools::RemoveADirectory(m_TempDir);
+  }
+
+  void ReadCSVCaseList()
+  {
+    const auto path = WriteCaseList("cases.csv",
+      "# batch of the test\n"
+      "\n"
+      "input, output ,mask\n"
+      "  \n"
+      "in1.nrrd,out1.nrrd,mask1.nrrd\n"
+      "# commented case,out.nrrd,\n"
+      "\"in 2, quoted.nrrd\",out2.nrrd,\n"
+      "\r\n"
+      "\"in\"\"3\"\".nrrd\" , out3.nrrd , mask3.nrrd\n");
+
+    const auto cases = mitk::readBatchCaseList(path);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), cases.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("in1.nrrd"), mitk::getBatchCaseValue(cases[0], "input"));
+    CPPUNIT_ASSERT_EQUAL(std::string("out1.nrrd"), mitk::getBatchCaseValue(cases[0], "output"));
+    CPPUNIT_ASSERT_EQUAL(std::string("mask1.nrrd"), mitk::getBatchCaseValue(cases[0], "mask"));
+    CPPUNIT_ASSERT_EQUAL(std::string("in 2, quoted.nrrd"), mitk::getBatchCaseValue(cases[1], "input"));
+    CPPUNIT_ASSERT_EQUAL(std::string("default.nrrd"), mitk::getBatchCaseValue(cases[1], "mask", "default.nrrd"));
+    CPPUNIT_ASSERT_EQUAL(std::string("in\"3\".nrrd"), mitk::getBatchCaseValue(cases[2], "input"));
+    CPPUNIT_ASSERT_EQUAL(std::string("out3.nrrd"), mitk::getBatchCaseValue(cases[2], "output"));
+  }
+
+  void ReadCSVCaseListWithSemicolons()
+  {
+    const auto path = WriteCaseList("cases.txt",
+      "input;output\n"
+      "in1.nrrd;out1.nrrd\n"
+      "in2.nrrd;out2.nrrd\n");
+
+    const auto cases = mitk::readBatchCaseList(path);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), cases.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("in2.nrrd"), mitk::getBatchCaseValue(cases[1], "input"));
+    CPPUNIT_ASSERT_EQUAL(std::string("out2.nrrd"), mitk::getBatchCaseValue(cases[1], "output"));
+  }
+
+  void ReadCSVCaseListWithMissingColumns()
+  {
+    const auto path = WriteCaseList("cases.csv",
+      "input,output,mask,aifmask\n"
+      "in1.nrrd,out1.nrrd\n"
+      "in2.nrrd\n");
+
+    const auto cases = mitk::readBatchCaseList(path);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), cases.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("out1.nrrd"), mitk::getBatchCaseValue(cases[0], "output"));
+    CPPUNIT_ASSERT_MESSAGE("Missing column should not be part of the case", cases[0].find("mask") == cases[0].end());
+    CPPUNIT_ASSERT_EQUAL(std::string("aif.nrrd"), mitk::getBatchCaseValue(cases[0], "aifmask", "aif.nrrd"));
+    CPPUNIT_ASSERT_EQUAL(std::string(), mitk::getBatchCaseValue(cases[1], "output"));
+  }
+
+  void ReadCSVCaseListWithTooManyValues()
+  {
+    const auto path = WriteCaseList("cases.csv",
+      "input,output\n"
+      "in1.nrrd,out1.nrrd,mask1.nrrd\n");
+
+    CPPUNIT_ASSERT_THROW(mitk::readBatchCaseList(path), mitk::Exception);
+  }
+
+  void ReadJSONCaseList()
+  {
+    const auto arrayPath = WriteCaseList("array.json",
+      "[ {\"input\": \"in1.nrrd\", \"output\": \"out1.nrrd\"}, {\"input\": \"in2.nrrd\", \"output\": \"out2.nrrd\", \"mask\": \"mask2.nrrd\"} ]");
+
+    auto cases = mitk::readBatchCaseList(arrayPath);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), cases.size());
+    CPPUNIT_ASSERT_EQUAL(std::string(), mitk::getBatchCaseValue(cases[0], "mask"));
+    CPPUNIT_ASSERT_EQUAL(std::string("mask2.nrrd"), mitk::getBatchCaseValue(cases[1], "mask"));
+
+    const auto objectPath = WriteCaseList("object.JSON",
+      "{ \"cases\": [ {\"input\": \"in1.nrrd\", \"output\": \"out1.nrrd\", \"index\": 3} ] }");
+
+    cases = mitk::readBatchCaseList(objectPath);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), cases.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("in1.nrrd"), mitk::getBatchCaseValue(cases[0], "input"));
+    CPPUNIT_ASSERT_EQUAL(std::string("3"), mitk::getBatchCaseValue(cases[0], "index"));
+  }
+
+  void ReadInvalidJSONCaseList()
+  {
+    const auto invalidPath = WriteCaseList("invalid.json", "[ {\"input\": \"in1.nrrd\", ");
+    CPPUNIT_ASSERT_THROW(mitk::readBatchCaseList(invalidPath), mitk::Exception);
+
+    const auto noArrayPath = WriteCaseList("noarray.json", "{ \"input\": \"in1.nrrd\" }");
+    CPPUNIT_ASSERT_THROW(mitk::readBatchCaseList(noArrayPath), mitk::Exception);
+
+    const auto noObjectPath = WriteCaseList("noobject.json", "[ \"in1.nrrd\" ]");
+    CPPUNIT_ASSERT_THROW(mitk::readBatchCaseList(noObjectPath), mitk::Exception);
+  }
+
+  void ReadMissingCaseList()
+  {
+    CPPUNIT_ASSERT_THROW(mitk::readBatchCaseList(m_TempDir + "/missing.csv"), mitk::Exception);
+  }
+
+  void LoadCaseWithBadPaths()
+  {
+    mitk::ModelFitBatchCaseData caseData;
+    caseData.inputFileName = m_TempDir + "/missing.nrrd";
+    CPPUNIT_ASSERT_THROW(mitk::loadModelFitBatchCase(caseData, nullptr, false, nullptr), mitk::Exception);
+
+    caseData.inputFileName = m_ImagePath;
+    caseData.maskFileName = m_TempDir + "/missing_mask.nrrd";
+    CPPUNIT_ASSERT_THROW(mitk::loadModelFitBatchCase(caseData, nullptr, false, nullptr), mitk::Exception);
+
+    caseData.maskFileName.clear();
+    CPPUNIT_ASSERT_THROW_MESSAGE("Missing AIF mask should be reported",
+      mitk::loadModelFitBatchCase(caseData, nullptr, true, nullptr), mitk::Exception);
+
+    caseData.aifMaskFileName = m_ImagePath;
+    auto loadedCase = mitk::loadModelFitBatchCase(caseData, nullptr, true, nullptr);
+    CPPUNIT_ASSERT(loadedCase.image.IsNotNull());
+    CPPUNIT_ASSERT(loadedCase.mask.IsNull());
+    CPPUNIT_ASSERT(loadedCase.aifMask.IsNotNull());
+    CPPUNIT_ASSERT(loadedCase.aifImage.IsNull());
+
+    auto nextCase = mitk::loadModelFitBatchCase(caseData, &loadedCase, true, nullptr);
+    CPPUNIT_ASSERT_MESSAGE("AIF mask of the previous case should be reused", nextCase.aifMask == loadedCase.aifMask);
+  }
+
+  void ProcessBatch()
+  {
+    const auto path = WriteCaseList("cases.csv",
+      "input,output,mask\n"
+      "# valid case that uses the default mask\n"
+      + m_ImagePath + ",out1.nrrd,\n"
+      + m_TempDir + "/missing.nrrd,out2.nrrd,\n"
+      + m_ImagePath + ",,\n"
+      ",out4.nrrd,\n"
+      + m_ImagePath + ",out5.nrrd," + m_TempDir + "/missing_mask.nrrd\n");
+
+    mitk::ModelFitBatchCaseData defaults;
+    defaults.maskFileName = m_ImagePath;
+
+    std::vector<std::string> processedOutputs;
+    auto processCase = [&processedOutputs, this](const mitk::BatchCase&, const mitk::ModelFitBatchCaseData& caseData, mitk::BatchResultWriter&)
+    {
+      CPPUNIT_ASSERT(caseData.image.IsNotNull());
+      CPPUNIT_ASSERT(caseData.mask.IsNotNull());
+      CPPUNIT_ASSERT_EQUAL(m_ImagePath, caseData.maskFileName);
+      processedOutputs.push_back(caseData.outputFileName);
+    };
+
+    const auto failedCases = mitk::processModelFitBatch(path, defaults, false, nullptr, processCase);
+
+    CPPUNIT_ASSERT_EQUAL(4u, failedCases);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), processedOutputs.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("out1.nrrd"), processedOutputs.front());
+
+    CPPUNIT_ASSERT_THROW(mitk::processModelFitBatch(m_TempDir + "/missing.csv", defaults, false, nullptr, processCase), mitk::Exception);
+  }
+
+  void ProcessBatchCasesSerializesIO()
+  {
+    const mitk::BatchCaseList cases(6);
+
+    std::atomic<int> activeIO(0);
+    std::atomic<bool> overlapped(false);
+    auto simulateIO = [&activeIO, &overlapped]()
+    {
+      if (++activeIO > 1)
+      {
+        overlapped = true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      --activeIO;
+    };
+
+    auto loadCase = [&simulateIO, this](const mitk::BatchCase&)
+    {
+      simulateIO();
+      return mitk::IOUtil::Load<mitk::Image>(m_ImagePath);
+    };
+
+    unsigned int processedCases = 0;
+    auto processCase = [&simulateIO, &processedCases, this](const mitk::BatchCase&, mitk::Image::Pointer& image, mitk::BatchResultWriter& writer)
+    {
+      CPPUNIT_ASSERT(image.IsNotNull());
+      const std::string outputPath = m_TempDir + "/out" + std::to_string(processedCases++) + ".nrrd";
+      writer.Enqueue([&simulateIO, image, outputPath]()
+      {
+        simulateIO();
+        mitk::IOUtil::Save(image, outputPath);
+      });
+    };
+
+    CPPUNIT_ASSERT_EQUAL(0u, mitk::processBatchCases(cases, loadCase, processCase));
+    CPPUNIT_ASSERT_EQUAL(6u, processedCases);
+    CPPUNIT_ASSERT_MESSAGE("Loading and writing of cases must not run concurrently", !overlapped);
+    for (unsigned int i = 0; i < processedCases; ++i)
+    {
+      CPPUNIT_ASSERT(itksys::SystemTools::FileExists(m_TempDir + "/out" + std::to_string(i) + ".nrrd"));
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkModelFitBatchHelper)
@@ -4,6 +4,7 @@ set(MODULE_TESTS
     mitkLegacyLabelSetImageIOTest.cpp
     mitkLabelSetImageSurfaceStampFilterTest.cpp
     mitkMultiLabelSegmentationIOTest.cpp
+    mitkDICOMSegmentationIOTest.cpp
     mitkTransferLabelTest.cpp
 )
 
@@ -0,0 +1,202 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkIOMimeTypes.h>
+#include <mitkIOUtil.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <map>
+
+class mitkDICOMSegmentationIOTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMSegmentationIOTestSuite);
+  MITK_TEST(TestRoundTrip_OneGroup);
+  MITK_TEST(TestRoundTrip_MultipleGroups_OverlappingLabels);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_TempDir;
+  mitk::Image::Pointer m_ReferenceImage;
+
+  mitk::Label::Pointer GenerateLabel(mitk::Label::PixelType value, const std::string& name, float r, float g, float b) const
+  {
+    auto label = mitk::Label::New(value, name);
+    mitk::Color color;
+    color.SetRed(r);
+    color.SetGreen(g);
+    color.SetBlue(b);
+    label->SetColor(color);
+
+    return label;
+  }
+
+  /** Creates a segmentation of the reference image with one group per passed label vector. The voxels of each group
+  * are filled with runs of its labels and the background value. The runs of the groups are shifted against each
+  * other, so the labels of different groups overlap.*/
+  mitk::LabelSetImage::Pointer GenerateSegmentation(const std::vector<mitk::LabelSetImage::ConstLabelVectorType>& groups) const
+  {
+    auto segmentation = mitk::LabelSetImage::New();
+    segmentation->Initialize(m_ReferenceImage);
+
+    for (std::size_t groupID = 0; groupID < groups.size(); ++groupID)
+    {
+      if (0 == groupID)
+      {
+        segmentation->ReplaceGroupLabels(0, groups[groupID]);
+      }
+      else
+      {
+        segmentation->AddLayer(groups[groupID]);
+      }
+
+      const auto labelValues = segmentation->GetLabelValuesByGroup(groupID);
+      mitk::ImageWriteAccessor accessor(segmentation->GetGroupImage(groupID));
+      auto* data = static_cast<mitk::LabelSetImage::PixelType*>(accessor.GetData());
+      const std::size_t numberOfVoxels = accessor.GetSize() / sizeof(mitk::LabelSetImage::PixelType);
+
+      for (std::size_t i = 0; i < numberOfVoxels; ++i)
+      {
+        const auto index = (i / 5 + groupID) % (labelValues.size() + 1);
+        data[i] = 0 == index ? mitk::LabelSetImage::UNLABELED_VALUE : labelValues[index - 1];
+      }
+    }
+
+    return segmentation;
+  }
+
+  mitk::LabelSetImage::Pointer LoadSegmentation(const std::string& path) const
+  {
+    CPPUNIT_ASSERT_MESSAGE("DICOM SEG file was not written: " + path, itksys::SystemTools::FileExists(path));
+
+    auto loadedData = mitk::IOUtil::Load(path);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Error reading the written DICOM SEG file", std::size_t(1), loadedData.size());
+
+    mitk::LabelSetImage::Pointer loaded = dynamic_cast<mitk::LabelSetImage*>(loadedData.front().GetPointer());
+    CPPUNIT_ASSERT_MESSAGE("DICOM SEG file is not read as multi-label segmentation", loaded.IsNotNull());
+    return loaded;
+  }
+
+  /** Checks that the loaded segmentation contains the labels and voxels of the passed group. DICOM SEG stores
+  * segment numbers instead of label values, so the labels are compared in the order of their values.*/
+  void CheckGroup(const mitk::LabelSetImage* segmentation, mitk::LabelSetImage::GroupIndexType groupID,
+    const mitk::LabelSetImage* loaded) const
+  {
+    CPPUNIT_ASSERT_EQUAL(segmentation->GetDimension(), loaded->GetDimension());
+    for (unsigned int i = 0; i < segmentation->GetDimension(); ++i)
+      CPPUNIT_ASSERT_EQUAL(segmentation->GetDimension(i), loaded->GetDimension(i));
+    CPPUNIT_ASSERT_MESSAGE("Origin of the segmentation was changed",
+      mitk::Equal(segmentation->GetGeometry()->GetOrigin(), loaded->GetGeometry()->GetOrigin(), 1e-3, true));
+    CPPUNIT_ASSERT_EQUAL(1u, loaded->GetNumberOfLayers());
+
+    const auto expectedLabels = segmentation->GetConstLabelsByValue(segmentation->GetLabelValuesByGroup(groupID));
+    const auto labels = loaded->GetConstLabelsByValue(loaded->GetLabelValuesByGroup(0));
+    CPPUNIT_ASSERT_EQUAL(expectedLabels.size(), labels.size());
+
+    // colors are stored as 8 bit CIELab values
+    const double colorTolerance = 2.0 / 255.0;
+
+    std::map<mitk::Label::PixelType, mitk::Label::PixelType> valueMapping;
+    valueMapping[mitk::LabelSetImage::UNLABELED_VALUE] = mitk::LabelSetImage::UNLABELED_VALUE;
+    for (std::size_t i = 0; i < labels.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(expectedLabels[i]->GetName(), labels[i]->GetName());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedLabels[i]->GetColor().GetRed(), labels[i]->GetColor().GetRed(), colorTolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedLabels[i]->GetColor().GetGreen(), labels[i]->GetColor().GetGreen(), colorTolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedLabels[i]->GetColor().GetBlue(), labels[i]->GetColor().GetBlue(), colorTolerance);
+      valueMapping[expectedLabels[i]->GetValue()] = labels[i]->GetValue();
+    }
+
+    mitk::ImageReadAccessor expectedAccessor(segmentation->GetGroupImage(groupID));
+    mitk::ImageReadAccessor accessor(loaded->GetGroupImage(0));
+    CPPUNIT_ASSERT_EQUAL(expectedAccessor.GetSize(), accessor.GetSize());
+
+    const auto* expectedData = static_cast<const mitk::LabelSetImage::PixelType*>(expectedAccessor.GetData());
+    const auto* data = static_cast<const mitk::LabelSetImage::PixelType*>(accessor.GetData());
+    const std::size_t numberOfVoxels = accessor.GetSize() / sizeof(mitk::LabelSetImage::PixelType);
+
+    for (std::size_t i = 0; i < numberOfVoxels; ++i)
+    {
+      if (valueMapping[expectedData[i]] != data[i])
+      {
+        CPPUNIT_FAIL("Voxels of group " + std::to_string(groupID) + " differ at index " + std::to_string(i));
+      }
+    }
+  }
+
+  void Save(const mitk::LabelSetImage* segmentation, const std::string& path) const
+  {
+    mitk::IOUtil::Save(segmentation, mitk::IOMimeTypes::DEFAULT_BASE_NAME() + ".image.dicom.seg", path);
+  }
+
+public:
+  void setUp() override
+  {
+    m_TempDir = mitk::IOUtil::CreateTemporaryDirectory("mitkDICOMSegmentationIOTest-XXXXXX");
+    m_ReferenceImage = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("TinyCTAbdomen/100"));
+    CPPUNIT_ASSERT_MESSAGE("Reference DICOM image could not be loaded", m_ReferenceImage.IsNotNull());
+  }
+
+  void tearDown() override
+  {
+    m_ReferenceImage = nullptr;
+    itksys::SystemTools::RemoveADirectory(m_TempDir);
+  }
+
+  void TestRoundTrip_OneGroup()
+  {
+    auto segmentation = GenerateSegmentation({
+      { GenerateLabel(1, "Liver", 0.8f, 0.2f, 0.2f), GenerateLabel(2, "Spleen", 0.2f, 0.6f, 0.4f) } });
+    CPPUNIT_ASSERT_MESSAGE("Segmentation does not reference the DICOM image", nullptr != segmentation->GetProperty("referenceFiles"));
+
+    const auto path = m_TempDir + "/segmentation.dcm";
+    Save(segmentation, path);
+
+    CheckGroup(segmentation, 0, LoadSegmentation(path));
+  }
+
+  void TestRoundTrip_MultipleGroups_OverlappingLabels()
+  {
+    auto segmentation = GenerateSegmentation({
+      { GenerateLabel(1, "Liver", 0.8f, 0.2f, 0.2f), GenerateLabel(2, "Spleen", 0.2f, 0.6f, 0.4f) },
+      { GenerateLabel(3, "Tumor", 0.9f, 0.9f, 0.1f), GenerateLabel(4, "Vessel", 0.1f, 0.3f, 0.9f),
+        GenerateLabel(5, "Cyst", 0.6f, 0.2f, 0.7f) } });
+
+    // the labels of the groups overlap, otherwise the test would not cover them
+    {
+      mitk::ImageReadAccessor accessor0(segmentation->GetGroupImage(0));
+      mitk::ImageReadAccessor accessor1(segmentation->GetGroupImage(1));
+      const auto* data0 = static_cast<const mitk::LabelSetImage::PixelType*>(accessor0.GetData());
+      const auto* data1 = static_cast<const mitk::LabelSetImage::PixelType*>(accessor1.GetData());
+      const std::size_t numberOfVoxels = accessor0.GetSize() / sizeof(mitk::LabelSetImage::PixelType);
+
+      bool overlapping = false;
+      for (std::size_t i = 0; i < numberOfVoxels && !overlapping; ++i)
+        overlapping = mitk::LabelSetImage::UNLABELED_VALUE != data0[i] && mitk::LabelSetImage::UNLABELED_VALUE != data1[i];
+      CPPUNIT_ASSERT(overlapping);
+    }
+
+    // each group is written to its own file, which is marked as containing non-overlapping segments
+    Save(segmentation, m_TempDir + "/segmentation.dcm");
+
+    CheckGroup(segmentation, 0, LoadSegmentation(m_TempDir + "/segmentation0.dcm"));
+    CheckGroup(segmentation, 1, LoadSegmentation(m_TempDir + "/segmentation1.dcm"));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMSegmentationIO)
@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <mitkTestingMacros.h>
 
 #include <mitkAutoCropImageFilter.h>
+#include <mitkImageWriteAccessor.h>
 
 namespace CppUnit
 {
@@ -77,6 +78,8 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestEraseLabels);
   MITK_TEST(TestMergeLabels);
   MITK_TEST(TestCreateLabelMask);
+  MITK_TEST(TestLabelStatistics);
+  MITK_TEST(TestLabelStatisticsAfterEraseAndMerge);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -659,6 +662,97 @@ public:
     // Count all pixels with value 6 = 507
     CPPUNIT_ASSERT_MESSAGE("Label mask not correctly created", maskImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 507);
   }
+
+  void FillBox(mitk::Image* image, const itk::Index<3>& minIndex, const itk::Index<3>& maxIndex, mitk::Label::PixelType value)
+  {
+    mitk::ImageWriteAccessor accessor(image, image->GetVolumeData(0));
+    auto* volume = static_cast<mitk::Label::PixelType*>(accessor.GetData());
+    const std::size_t dimX = image->GetDimension(0);
+    const std::size_t dimY = image->GetDimension(1);
+
+    for (auto z = minIndex[2]; z <= maxIndex[2]; ++z)
+      for (auto y = minIndex[1]; y <= maxIndex[1]; ++y)
+        for (auto x = minIndex[0]; x <= maxIndex[0]; ++x)
+          volume[(z * dimY + y) * dimX + x] = value;
+  }
+
+  void TestLabelStatistics()
+  {
+    m_LabelSetImage->AddLabel(mitk::Label::New(1, "Label1"), 0);
+    m_LabelSetImage->AddLabel(mitk::Label::New(2, "Label2"), 0);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Empty label has voxels", std::size_t(0), m_LabelSetImage->GetLabelStatistics(1).VoxelCount);
+
+    // box crossing brick borders
+    this->FillBox(m_LabelSetImage, { {28, 20, 30} }, { {37, 29, 35} }, 1);
+    m_LabelSetImage->Modified();
+
+    auto statistics = m_LabelSetImage->GetLabelStatistics(1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong voxel count", std::size_t(600), statistics.VoxelCount);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong min index", (itk::Index<3>{ {28, 20, 30} }), statistics.MinIndex);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong max index", (itk::Index<3>{ {37, 29, 35} }), statistics.MaxIndex);
+    mitk::Point3D expectedCentroid;
+    expectedCentroid[0] = 32.5;
+    expectedCentroid[1] = 24.5;
+    expectedCentroid[2] = 32.5;
+    CPPUNIT_ASSERT_MESSAGE("Wrong centroid", mitk::Equal(statistics.GetCentroid(), expectedCentroid));
+
+    // reported change: overwrite a part of label 1 with label 2
+    auto mTimeBeforeChange = m_LabelSetImage->GetMTime();
+    this->FillBox(m_LabelSetImage, { {28, 20, 30} }, { {37, 29, 31} }, 2);
+    m_LabelSetImage->Modified();
+    itk::ImageRegion<3> region({ {28, 20, 30} }, { {10, 10, 2} });
+    m_LabelSetImage->UpdateLabelStatistics(0, 0, region, mTimeBeforeChange);
+
+    statistics = m_LabelSetImage->GetLabelStatistics(1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong voxel count after reported change", std::size_t(400), statistics.VoxelCount);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong min index after reported change", (itk::Index<3>{ {28, 20, 32} }), statistics.MinIndex);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong voxel count of label 2 after reported change", std::size_t(200), m_LabelSetImage->GetLabelStatistics(2).VoxelCount);
+
+    // unreported change: statistics have to be recomputed
+    this->FillBox(m_LabelSetImage, { {0, 0, 0} }, { {1, 1, 1} }, 1);
+    m_LabelSetImage->Modified();
+
+    statistics = m_LabelSetImage->GetLabelStatistics(1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong voxel count after unreported change", std::size_t(408), statistics.VoxelCount);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong min index after unreported change", (itk::Index<3>{ {0, 0, 0} }), statistics.MinIndex);
+
+    // changing the active label does not invalidate the statistics
+    m_LabelSetImage->SetActiveLabel(2);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong voxel count after changing active label", std::size_t(408), m_LabelSetImage->GetLabelStatistics(1).VoxelCount);
+
+    CPPUNIT_ASSERT_THROW(m_LabelSetImage->GetLabelStatistics(3), mitk::Exception);
+  }
+
+  void TestLabelStatisticsAfterEraseAndMerge()
+  {
+    mitk::Image::Pointer image =
+      mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Multilabel/LabelSetTestInitializeImage.nrrd"));
+
+    m_LabelSetImage = nullptr;
+    m_LabelSetImage = mitk::LabelSetImage::New();
+    m_LabelSetImage->InitializeByLabeledImage(image);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong voxel count of label 6", std::size_t(507), m_LabelSetImage->GetLabelStatistics(6).VoxelCount);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong voxel count of label 7", std::size_t(823), m_LabelSetImage->GetLabelStatistics(7).VoxelCount);
+
+    m_LabelSetImage->MergeLabel(6, 7);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong voxel count of merged label", std::size_t(1330), m_LabelSetImage->GetLabelStatistics(6).VoxelCount);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Merged label still has voxels", std::size_t(0), m_LabelSetImage->GetLabelStatistics(7).VoxelCount);
+    CPPUNIT_ASSERT_MESSAGE("Pixels of merged label were not changed", m_LabelSetImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 1330);
+
+    m_LabelSetImage->EraseLabel(6);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Erased label still has voxels", std::size_t(0), m_LabelSetImage->GetLabelStatistics(6).VoxelCount);
+    CPPUNIT_ASSERT_MESSAGE("Label with value 6 was not erased from the image", m_LabelSetImage->GetStatistics()->GetScalarValueMax() == 5);
+
+    // statistics have to be identical to a complete recomputation
+    const auto incremental = m_LabelSetImage->GetLabelStatistics(3);
+    m_LabelSetImage->Modified();
+    const auto recomputed = m_LabelSetImage->GetLabelStatistics(3);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Incremental statistics differ", recomputed.VoxelCount, incremental.VoxelCount);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Incremental statistics differ", recomputed.MinIndex, incremental.MinIndex);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Incremental statistics differ", recomputed.MaxIndex, incremental.MaxIndex);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImage)
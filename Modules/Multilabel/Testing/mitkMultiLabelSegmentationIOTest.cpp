@@ -11,6 +11,8 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkLabelSetImage.h>
 
 #include <mitkTestFixture.h>
@@ -20,12 +22,20 @@ found in the LICENSE file.
 #include <mitkPropertyPersistenceInfo.h>
 #include <mitkIPropertyPersistence.h>
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
 class mitkMultiLabelSegmentationIOTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkMultiLabelSegmentationIOTestSuite);
   MITK_TEST(TestReadEmptyMultiLabelSegmentation);
   MITK_TEST(TestReadEmptyMultiLabelSegmentation_withNoMetaInformation);
   MITK_TEST(TestReadEmptyMultiLabelSegmentation_withNoMetaInformation_butContent);
+  MITK_TEST(TestRoundTrip_OneGroup);
+  MITK_TEST(TestRoundTrip_MultipleGroups);
+  MITK_TEST(TestRoundTrip_4D);
+  MITK_TEST(TestRoundTrip_MultipleChunks);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -69,6 +79,91 @@ public:
     m_labelSet2.clear();
     m_labelSet2_adapted.clear();
   }
+
+  /** Creates a segmentation with one group per passed label vector. The voxels of each group are
+  * filled with runs of its labels and the background value.*/
+  mitk::LabelSetImage::Pointer GenerateSegmentation(const std::vector<unsigned int>& dimensions,
+    const std::vector<mitk::LabelSetImage::ConstLabelVectorType>& groups) const
+  {
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<mitk::LabelSetImage::PixelType>(), static_cast<unsigned int>(dimensions.size()), dimensions.data());
+
+    auto segmentation = mitk::LabelSetImage::New();
+    segmentation->Initialize(image);
+
+    for (std::size_t groupID = 0; groupID < groups.size(); ++groupID)
+    {
+      if (0 == groupID)
+      {
+        segmentation->ReplaceGroupLabels(0, groups[groupID]);
+      }
+      else
+      {
+        segmentation->AddLayer(groups[groupID]);
+      }
+      segmentation->SetGroupName(groupID, "Group " + std::to_string(groupID));
+
+      const auto labelValues = segmentation->GetLabelValuesByGroup(groupID);
+      mitk::ImageWriteAccessor accessor(segmentation->GetGroupImage(groupID));
+      auto* data = static_cast<mitk::LabelSetImage::PixelType*>(accessor.GetData());
+      const std::size_t numberOfVoxels = accessor.GetSize() / sizeof(mitk::LabelSetImage::PixelType);
+
+      for (std::size_t i = 0; i < numberOfVoxels; ++i)
+      {
+        const auto index = (i / 7 + groupID) % (labelValues.size() + 1);
+        data[i] = 0 == index ? mitk::LabelSetImage::UNLABELED_VALUE : labelValues[index - 1];
+      }
+    }
+
+    return segmentation;
+  }
+
+  /** Saves and loads the segmentation and checks that groups, labels and voxels survived the round trip.*/
+  void CheckRoundTrip(const mitk::LabelSetImage* segmentation) const
+  {
+    std::ofstream tmpStream;
+    const auto path = mitk::IOUtil::CreateTemporaryFile(tmpStream, "mitkMultiLabelSegmentationIOTest_XXXXXX.nrrd");
+    tmpStream.close();
+
+    mitk::IOUtil::Save(segmentation, path);
+    auto loadedData = mitk::IOUtil::Load(path);
+    std::remove(path.c_str());
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Error reading the written segmentation", std::size_t(1), loadedData.size());
+    auto loaded = dynamic_cast<mitk::LabelSetImage*>(loadedData.front().GetPointer());
+    CPPUNIT_ASSERT_MESSAGE("Written segmentation is not read as multi-label segmentation", nullptr != loaded);
+
+    CPPUNIT_ASSERT_EQUAL(segmentation->GetDimension(), loaded->GetDimension());
+    for (unsigned int i = 0; i < segmentation->GetDimension(); ++i)
+      CPPUNIT_ASSERT_EQUAL(segmentation->GetDimension(i), loaded->GetDimension(i));
+    CPPUNIT_ASSERT_EQUAL(segmentation->GetNumberOfLayers(), loaded->GetNumberOfLayers());
+
+    for (mitk::LabelSetImage::GroupIndexType groupID = 0; groupID < segmentation->GetNumberOfLayers(); ++groupID)
+    {
+      CPPUNIT_ASSERT_EQUAL(segmentation->GetGroupName(groupID), loaded->GetGroupName(groupID));
+
+      const auto expectedLabels = segmentation->GetConstLabelsByValue(segmentation->GetLabelValuesByGroup(groupID));
+      const auto labels = loaded->GetConstLabelsByValue(loaded->GetLabelValuesByGroup(groupID));
+      CPPUNIT_ASSERT_EQUAL(expectedLabels.size(), labels.size());
+      for (std::size_t i = 0; i < labels.size(); ++i)
+      {
+        CPPUNIT_ASSERT_EQUAL(expectedLabels[i]->GetValue(), labels[i]->GetValue());
+        CPPUNIT_ASSERT_EQUAL(expectedLabels[i]->GetName(), labels[i]->GetName());
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedLabels[i]->GetColor().GetRed(), labels[i]->GetColor().GetRed(), mitk::eps);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedLabels[i]->GetColor().GetGreen(), labels[i]->GetColor().GetGreen(), mitk::eps);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedLabels[i]->GetColor().GetBlue(), labels[i]->GetColor().GetBlue(), mitk::eps);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedLabels[i]->GetOpacity(), labels[i]->GetOpacity(), mitk::eps);
+        CPPUNIT_ASSERT_EQUAL(expectedLabels[i]->GetLocked(), labels[i]->GetLocked());
+        CPPUNIT_ASSERT_EQUAL(expectedLabels[i]->GetVisible(), labels[i]->GetVisible());
+      }
+
+      mitk::ImageReadAccessor expectedAccessor(segmentation->GetGroupImage(groupID));
+      mitk::ImageReadAccessor accessor(loaded->GetGroupImage(groupID));
+      CPPUNIT_ASSERT_EQUAL(expectedAccessor.GetSize(), accessor.GetSize());
+      CPPUNIT_ASSERT_MESSAGE("Voxels of group " + std::to_string(groupID) + " are not equal",
+        0 == std::memcmp(expectedAccessor.GetData(), accessor.GetData(), accessor.GetSize()));
+    }
+  }
   
   void TestReadEmptyMultiLabelSegmentation()
   {
@@ -110,6 +205,37 @@ public:
       mitk::IOUtil::Load(GetTestDataFilePath("Multilabel/EmptyMultiLabelSegmentation_no_labels_meta_but_pixel_content.nrrd")),
       mitk::Exception);
   }
+
+  void TestRoundTrip_OneGroup()
+  {
+    auto segmentation = GenerateSegmentation({ 23, 17, 5 }, { m_labelSet1 });
+    CheckRoundTrip(segmentation);
+  }
+
+  void TestRoundTrip_MultipleGroups()
+  {
+    auto segmentation = GenerateSegmentation({ 23, 17, 5 }, { m_labelSet1, m_labelSet2, {} });
+    CPPUNIT_ASSERT_MESSAGE("Label values of the second group were not corrected as expected",
+      mitk::Equal(m_labelSet2_adapted, segmentation->GetConstLabelsByValue(segmentation->GetLabelValuesByGroup(1)), mitk::eps, true));
+
+    segmentation->GetLabel(4)->SetOpacity(0.25f);
+    segmentation->GetLabel(4)->SetLocked(false);
+    segmentation->GetLabel(5)->SetVisible(false);
+    CheckRoundTrip(segmentation);
+  }
+
+  void TestRoundTrip_4D()
+  {
+    auto segmentation = GenerateSegmentation({ 11, 9, 4, 3 }, { m_labelSet1, m_labelSet2 });
+    CheckRoundTrip(segmentation);
+  }
+
+  void TestRoundTrip_MultipleChunks()
+  {
+    // 2 groups * 2 bytes * 128*128*24 voxels = 1.5 MiB, i.e. more than one compressed chunk
+    auto segmentation = GenerateSegmentation({ 128, 128, 24 }, { m_labelSet1, m_labelSet2 });
+    CheckRoundTrip(segmentation);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkMultiLabelSegmentationIO)
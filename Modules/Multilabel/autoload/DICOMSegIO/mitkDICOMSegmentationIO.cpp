@@ -28,7 +28,7 @@ found in the LICENSE file.
 
 
 // itk
-#include <itkThresholdImageFilter.h>
+#include <itkCastImageFilter.h>
 
 // dcmqi
 #include <dcmqi/Itk2DicomConverter.h>
@@ -39,6 +39,48 @@ found in the LICENSE file.
 #include <usGetModuleContext.h>
 #include <usModuleContext.h>
 
+namespace
+{
+  std::string GetSegmentLabelName(dcmqi::SegmentAttributes* segmentAttribute)
+  {
+    OFString labelName = segmentAttribute->getSegmentLabel();
+
+    if (labelName.empty())
+    {
+      if (segmentAttribute->getSegmentedPropertyTypeCodeSequence() != nullptr)
+      {
+        segmentAttribute->getSegmentedPropertyTypeCodeSequence()->getCodeMeaning(labelName);
+        if (segmentAttribute->getSegmentedPropertyTypeModifierCodeSequence() != nullptr)
+        {
+          OFString modifier;
+          segmentAttribute->getSegmentedPropertyTypeModifierCodeSequence()->getCodeMeaning(modifier);
+          labelName.append(" (").append(modifier).append(")");
+        }
+      }
+      else
+      {
+        labelName = std::to_string(segmentAttribute->getLabelID()).c_str();
+        if (labelName.empty())
+          labelName = "Unnamed";
+      }
+    }
+
+    return labelName.c_str();
+  }
+
+  mitk::Color GetSegmentColor(dcmqi::SegmentAttributes* segmentAttribute)
+  {
+    float tmp[3] = { 0.0, 0.0, 0.0 };
+    if (segmentAttribute->getRecommendedDisplayRGBValue() != nullptr)
+    {
+      tmp[0] = segmentAttribute->getRecommendedDisplayRGBValue()[0] / 255.0;
+      tmp[1] = segmentAttribute->getRecommendedDisplayRGBValue()[1] / 255.0;
+      tmp[2] = segmentAttribute->getRecommendedDisplayRGBValue()[2] / 255.0;
+    }
+    return mitk::Color(tmp);
+  }
+}
+
 namespace mitk
 {
   DICOMSegmentationIO::DICOMSegmentationIO()
@@ -160,6 +202,8 @@ namespace mitk
     // Iterate over all layers. For each a dcm file will be generated
     for (unsigned int layer = 0; layer < input->GetNumberOfLayers(); ++layer)
     {
+      // All labels of the group are passed to dcmqi in one image (one segment per label value),
+      // so no full-size image per label is needed.
       vector<itkInternalImageType::Pointer> segmentations;
 
       try
@@ -178,23 +222,7 @@ namespace mitk
         itkInternalImageType::Pointer itkLabelImage = castFilter->GetOutput();
         itkLabelImage->DisconnectPipeline();
 
-        // Iterate over all labels. For each label a segmentation image will be created
-        auto labelSet = input->GetConstLabelsByValue(input->GetLabelValuesByGroup(layer));
-
-        for (const auto& label : labelSet)
-        {
-          // Threshold over the image with the given label value
-          itk::ThresholdImageFilter<itkInternalImageType>::Pointer thresholdFilter =
-            itk::ThresholdImageFilter<itkInternalImageType>::New();
-          thresholdFilter->SetInput(itkLabelImage);
-          thresholdFilter->ThresholdOutside(label->GetValue(), label->GetValue());
-          thresholdFilter->SetOutsideValue(0);
-          thresholdFilter->Update();
-          itkInternalImageType::Pointer segmentImage = thresholdFilter->GetOutput();
-          segmentImage->DisconnectPipeline();
-
-          segmentations.push_back(segmentImage);
-        }
+        segmentations.push_back(itkLabelImage);
       }
       catch (const itk::ExceptionObject &e)
       {
@@ -213,9 +241,10 @@ namespace mitk
         for (const auto& dcmDataSet : dcmDatasetsSourceImage)
           rawVecDataset.push_back(dcmDataSet.get());
 
-        // Convert itk segmentation images to dicom image
+        // Convert itk segmentation images to dicom image. Empty slices are skipped, so for each segment
+        // only the frames within its bounding box are encoded.
         auto converter = std::make_unique<dcmqi::Itk2DicomConverter>();
-        std::unique_ptr<DcmDataset> result(converter->itkimage2dcmSegmentation(rawVecDataset, segmentations, tmpMetaInfoFile, false));
+        std::unique_ptr<DcmDataset> result(converter->itkimage2dcmSegmentation(rawVecDataset, segmentations, tmpMetaInfoFile, true));
 
         //We store only one group, thus we can specify the SegmentsOverlap Tag (0062,0013)
         // as NO
@@ -307,10 +336,12 @@ namespace mitk
       }
 
       //=============================== dcmqi part ====================================
-      // Read the DICOM SEG images (segItkImages) and DICOM tags (metaInfo)
+      // Read the DICOM SEG images (segItkImages) and DICOM tags (metaInfo).
+      // Segments that do not overlap are merged by dcmqi into the same image (pixel value = label ID),
+      // so only a few images are created instead of one full-size image per segment.
       auto converter = std::make_unique<dcmqi::Dicom2ItkConverter>();
       std::string metaInfoString;
-      auto convert_condition = converter->dcmSegmentation2itkimage(dataSet, metaInfoString, false);
+      auto convert_condition = converter->dcmSegmentation2itkimage(dataSet, metaInfoString, true);
 
       std::vector<itkInternalImageType::Pointer> segItkImages;
 
@@ -330,118 +361,95 @@ namespace mitk
       MITK_INFO << "Input " << metaInfo.getJSONOutputAsString();
       //===============================================================================
 
-      // Get the label information from segment attributes for each itk image
-      vector<map<unsigned, dcmqi::SegmentAttributes *>>::const_iterator segmentIter =
-        metaInfo.segmentsAttributesMappingList.begin();
+      if (segItkImages.size() > metaInfo.segmentsAttributesMappingList.size())
+        mitkThrow() << "Segment information is missing for some images of the DICOM SEG file.";
 
-      // For each itk image add a layer to the LabelSetImage output
-      for (auto &segItkImage : segItkImages)
+      // For each itk image add its segments to the LabelSetImage output
+      for (std::size_t imageIndex = 0; imageIndex < segItkImages.size(); ++imageIndex)
       {
         // Get the labeled image and cast it to mitkImage
         typedef itk::CastImageFilter<itkInternalImageType, itkInputImageType> castItkImageFilterType;
         castItkImageFilterType::Pointer castFilter = castItkImageFilterType::New();
-        castFilter->SetInput(segItkImage);
+        castFilter->SetInput(segItkImages[imageIndex]);
         castFilter->Update();
 
         Image::Pointer segmentImage;
         CastToMitkImage(castFilter->GetOutput(), segmentImage);
 
-        // Get pixel value of the label
-        itkInternalImageType::ValueType segValue = 1;
-        typedef itk::ImageRegionIterator<const itkInternalImageType> IteratorType;
-        // Iterate over the image to find the pixel value of the label
-        IteratorType iter(segItkImage, segItkImage->GetLargestPossibleRegion());
-        iter.GoToBegin();
-        while (!iter.IsAtEnd())
+        // Get the label information from the segment attributes. The pixel value of a segment is its label ID,
+        // so the image does not have to be searched for it.
+        const auto &segmentMap = metaInfo.segmentsAttributesMappingList[imageIndex];
+
+        LabelSetImage::LabelVectorType segmentLabels;
+        for (const auto &segment : segmentMap)
         {
-          itkInputImageType::PixelType value = iter.Get();
-          if (value != LabelSetImage::UNLABELED_VALUE)
-          {
-            segValue = value;
-            break;
-          }
-          ++iter;
+          auto newLabel = Label::New();
+          newLabel->SetName(GetSegmentLabelName(segment.second));
+          newLabel->SetColor(GetSegmentColor(segment.second));
+          newLabel->SetValue(segment.second->getLabelID());
+          segmentLabels.push_back(newLabel);
         }
-        // Get Segment information map
-        map<unsigned, dcmqi::SegmentAttributes *> segmentMap = (*segmentIter);
-        map<unsigned, dcmqi::SegmentAttributes *>::const_iterator segmentMapIter = (*segmentIter).begin();
-        dcmqi::SegmentAttributes *segmentAttribute = (*segmentMapIter).second;
 
-        OFString labelName = segmentAttribute->getSegmentLabel();
+        // Maps the pixel values of the image to the values of the added labels
+        LabelValueMappingVector labelMapping;
 
-        if (labelName.empty())
+        // If labelSetImage do not exists (first image)
+        if (labelSetImage.IsNull())
         {
-          if (segmentAttribute->getSegmentedPropertyTypeCodeSequence() != nullptr)
+          // Initialize the labelSetImage with the read image. This generates default labels for all
+          // pixel values of the image, which are then updated with the segment information.
+          labelSetImage = LabelSetImage::New();
+          labelSetImage->InitializeByLabeledImage(segmentImage);
+
+          for (const auto &segmentLabel : segmentLabels)
           {
-            segmentAttribute->getSegmentedPropertyTypeCodeSequence()->getCodeMeaning(labelName);
-            if (segmentAttribute->getSegmentedPropertyTypeModifierCodeSequence() != nullptr)
+            if (labelSetImage->ExistLabel(segmentLabel->GetValue()))
             {
-              OFString modifier;
-              segmentAttribute->getSegmentedPropertyTypeModifierCodeSequence()->getCodeMeaning(modifier);
-              labelName.append(" (").append(modifier).append(")");
+              auto existingLabel = labelSetImage->GetLabel(segmentLabel->GetValue());
+              existingLabel->SetName(segmentLabel->GetName());
+              existingLabel->SetColor(segmentLabel->GetColor());
             }
-          }
-          else
-          {
-            labelName = std::to_string(segmentAttribute->getLabelID()).c_str();
-            if (labelName.empty())
-              labelName = "Unnamed";
+            else
+            {
+              // empty segment
+              labelSetImage->AddLabel(segmentLabel, 0, false, false);
+            }
+            labelMapping.emplace_back(segmentLabel->GetValue(), segmentLabel->GetValue());
           }
         }
-
-        float tmp[3] = { 0.0, 0.0, 0.0 };
-        if (segmentAttribute->getRecommendedDisplayRGBValue() != nullptr)
+        else if (assumeOverlappingSegments)
         {
-          tmp[0] = segmentAttribute->getRecommendedDisplayRGBValue()[0] / 255.0;
-          tmp[1] = segmentAttribute->getRecommendedDisplayRGBValue()[1] / 255.0;
-          tmp[2] = segmentAttribute->getRecommendedDisplayRGBValue()[2] / 255.0;
-        }
+          // The segments of one image do not overlap each other, but may overlap the segments of
+          // the other images. So add a new group per image; the label content is directly transferred here.
+          labelSetImage->AddLayer(segmentImage, LabelSetImage::ConvertLabelVectorConst(segmentLabels));
 
-        Label::Pointer newLabel = nullptr;
-        // If labelSetImage do not exists (first image)
-        if (labelSetImage.IsNull())
-        {
-          // Initialize the labelSetImage with the read image
-          labelSetImage = LabelSetImage::New();
-          labelSetImage->InitializeByLabeledImage(segmentImage);
-          // Check if the segment image contained labeled pixels. At this point it either contains no (when no labeled pixels where in the image)
-          // or one label (as DCMSeg segments only represent one labels). So either generate a new label or used the only existing one.
-          newLabel = labelSetImage->GetTotalNumberOfLabels() > 0 ? labelSetImage->GetLabels().front() : Label::New();
-          newLabel->SetName(labelName.c_str());
-          newLabel->SetColor(Color(tmp));
-          newLabel->SetValue(segValue);
+          for (const auto &segmentLabel : segmentLabels)
+          {
+            labelMapping.emplace_back(segmentLabel->GetValue(), segmentLabel->GetValue());
+          }
         }
         else
         {
-          LabelSetImage::GroupIndexType groupID = 0;
-          if (assumeOverlappingSegments)
+          // if we know the labels are non overlapping we can put everything in one image
+          // the label content has to be transferred, as no new group was added.
+          for (const auto &segmentLabel : segmentLabels)
           {
-            // Add a new group because we have to expect every label to be overlapping
-            // the label content is directly transferred here.
-            groupID = labelSetImage->AddLayer(segmentImage);
-          }
-
-          // Add the new label
-          newLabel = Label::New();
-          newLabel->SetName(labelName.c_str());
-          newLabel->SetColor(Color(tmp));
-          newLabel->SetValue(segValue);
-          labelSetImage->AddLabel(newLabel, groupID, true, true);
-
-          if (!assumeOverlappingSegments)
-          {
-            //if we know the labels are non overlapping we can put everything in one image
-            //the label content has to be transferred, as no new group was added.
-            mitk::TransferLabelContent(segmentImage, labelSetImage->GetGroupImage(groupID),
-              labelSetImage->GetConstLabelsByValue(labelSetImage->GetLabelValuesByGroup(groupID)),
-              mitk::LabelSetImage::UNLABELED_VALUE, mitk::LabelSetImage::UNLABELED_VALUE, false, {{segValue,newLabel->GetValue()}});
+            auto addedLabel = labelSetImage->AddLabel(segmentLabel, 0, false, true);
+            labelMapping.emplace_back(segmentLabel->GetValue(), addedLabel->GetValue());
           }
 
+          mitk::TransferLabelContent(segmentImage, labelSetImage->GetGroupImage(0),
+            labelSetImage->GetConstLabelsByValue(labelSetImage->GetLabelValuesByGroup(0)),
+            mitk::LabelSetImage::UNLABELED_VALUE, mitk::LabelSetImage::UNLABELED_VALUE, false, labelMapping);
         }
 
         // Add some more label properties
-        this->SetLabelProperties(newLabel, segmentAttribute);
-        ++segmentIter;
+        auto segmentIter = segmentMap.cbegin();
+        for (const auto &[segmentValue, labelValue] : labelMapping)
+        {
+          this->SetLabelProperties(labelSetImage->GetLabel(labelValue), segmentIter->second);
+          ++segmentIter;
+        }
       }
 
       labelSetImage->SetAllLabelsVisible(true);
@@ -623,6 +631,20 @@ namespace mitk
         }
       }
     }
+
+    // createOrGetSegment() lists each segment as content of a separate input image. All segments of the group
+    // are stored in the same image, so they have to be listed together.
+    std::map<unsigned, dcmqi::SegmentAttributes *> groupSegments;
+    for (const auto &segments : handler.segmentsAttributesMappingList)
+    {
+      groupSegments.insert(segments.begin(), segments.end());
+    }
+    handler.segmentsAttributesMappingList.clear();
+    if (!groupSegments.empty())
+    {
+      handler.segmentsAttributesMappingList.push_back(groupSegments);
+    }
+
     return handler.getJSONOutputAsString();
   }
 
@@ -1,4 +1,6 @@
 set(CPP_FILES
+  mitkLabelGroupNrrdWriter.cpp
+  mitkLabelGroupNrrdWriter.h
   mitkLegacyLabelSetImageIO.cpp
   mitkLegacyLabelSetImageIO.h
   mitkMultilabelActivator.cpp
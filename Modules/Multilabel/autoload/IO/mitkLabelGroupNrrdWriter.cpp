@@ -0,0 +1,341 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLabelGroupNrrdWriter.h"
+
+#include <mitkExceptionMacro.h>
+
+// itk
+#include <itkByteSwapper.h>
+#include <itkMetaDataObject.h>
+#include <itkMultiThreaderBase.h>
+#include <itk_zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+  /** Size of the uncompressed data of one chunk. Chunks are compressed independently,
+  so they should be large compared to the deflate window (32 KiB).*/
+  constexpr std::size_t ChunkSize = 1 << 20;
+
+  struct CompressedChunk
+  {
+    std::vector<unsigned char> data;
+    uLong crc = 0;
+    std::size_t size = 0;
+    bool valid = false;
+  };
+
+  /** Compresses the chunk as raw deflate data. All chunks but the last end with a sync flush
+  (byte aligned, no final block), so the compressed chunks can be concatenated to one deflate stream.*/
+  void CompressChunk(const unsigned char* data, std::size_t size, bool isLastChunk, CompressedChunk& chunk)
+  {
+    chunk.size = size;
+    chunk.crc = crc32(crc32(0L, Z_NULL, 0), data, static_cast<uInt>(size));
+
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    // Label images mostly consist of long runs, which the fastest level already finds.
+    if (Z_OK != deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY))
+    {
+      return;
+    }
+
+    // additional space for the sync flush marker
+    chunk.data.resize(deflateBound(&stream, static_cast<uLong>(size)) + 16);
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = chunk.data.data();
+    stream.avail_out = static_cast<uInt>(chunk.data.size());
+
+    const int result = deflate(&stream, isLastChunk ? Z_FINISH : Z_SYNC_FLUSH);
+    chunk.valid = isLastChunk ? Z_STREAM_END == result : (Z_OK == result && 0 == stream.avail_in && stream.avail_out > 0);
+    chunk.data.resize(stream.total_out);
+    deflateEnd(&stream);
+  }
+
+  /** Interleaves the voxels [firstVoxel, firstVoxel+numberOfVoxels) of all groups (group index runs fastest).*/
+  template <typename TComponent>
+  void InterleaveGroups(const std::vector<const void*>& groupBuffers, std::size_t firstVoxel, std::size_t numberOfVoxels, unsigned char* output)
+  {
+    const std::size_t numberOfGroups = groupBuffers.size();
+    auto* interleaved = reinterpret_cast<TComponent*>(output);
+
+    for (std::size_t group = 0; group < numberOfGroups; ++group)
+    {
+      const auto* groupData = static_cast<const TComponent*>(groupBuffers[group]) + firstVoxel;
+      for (std::size_t voxel = 0; voxel < numberOfVoxels; ++voxel)
+      {
+        interleaved[voxel * numberOfGroups + group] = groupData[voxel];
+      }
+    }
+  }
+
+  void InterleaveGroups(const std::vector<const void*>& groupBuffers, std::size_t componentSize, std::size_t firstVoxel, std::size_t numberOfVoxels, unsigned char* output)
+  {
+    switch (componentSize)
+    {
+      case 1: InterleaveGroups<std::uint8_t>(groupBuffers, firstVoxel, numberOfVoxels, output); break;
+      case 2: InterleaveGroups<std::uint16_t>(groupBuffers, firstVoxel, numberOfVoxels, output); break;
+      case 4: InterleaveGroups<std::uint32_t>(groupBuffers, firstVoxel, numberOfVoxels, output); break;
+      case 8: InterleaveGroups<std::uint64_t>(groupBuffers, firstVoxel, numberOfVoxels, output); break;
+      default: break; // checked before
+    }
+  }
+
+  std::string GetNrrdType(itk::IOComponentEnum componentType, std::size_t componentSize)
+  {
+    switch (componentType)
+    {
+      case itk::IOComponentEnum::UCHAR: return "unsigned char";
+      case itk::IOComponentEnum::CHAR: return "signed char";
+      case itk::IOComponentEnum::USHORT: return "unsigned short";
+      case itk::IOComponentEnum::SHORT: return "short";
+      case itk::IOComponentEnum::UINT: return "unsigned int";
+      case itk::IOComponentEnum::INT: return "int";
+      case itk::IOComponentEnum::ULONG: return 4 == componentSize ? "unsigned int" : "unsigned long long";
+      case itk::IOComponentEnum::LONG: return 4 == componentSize ? "int" : "long long";
+      case itk::IOComponentEnum::ULONGLONG: return "unsigned long long";
+      case itk::IOComponentEnum::LONGLONG: return "long long";
+      case itk::IOComponentEnum::FLOAT: return "float";
+      case itk::IOComponentEnum::DOUBLE: return "double";
+      default: mitkThrow() << "Cannot write label groups. Unsupported component type: " << itk::ImageIOBase::GetComponentTypeAsString(componentType);
+    }
+  }
+
+  /** Escapes a key or value of a NRRD key/value pair (same as teem does).*/
+  std::string EscapeNrrdKeyValue(const std::string& value)
+  {
+    std::string result;
+    result.reserve(value.size());
+    for (const char c : value)
+    {
+      if ('\n' == c)
+      {
+        result += "\\n";
+      }
+      else if ('\\' == c)
+      {
+        result += "\\\\";
+      }
+      else
+      {
+        result += c;
+      }
+    }
+    return result;
+  }
+
+  std::string GenerateNrrdHeader(const itk::ImageIOBase* imageIO, std::size_t numberOfGroups)
+  {
+    const unsigned int dimension = imageIO->GetNumberOfDimensions();
+    const bool isVector = numberOfGroups > 1;
+
+    std::ostringstream header;
+    header.imbue(std::locale::classic());
+    header << std::setprecision(17);
+
+    header << "NRRD0004\n";
+    header << "# Complete NRRD file format specification at:\n";
+    header << "# http://teem.sourceforge.net/nrrd/format.html\n";
+    header << "type: " << GetNrrdType(imageIO->GetComponentType(), imageIO->GetComponentSize()) << "\n";
+    header << "dimension: " << dimension + (isVector ? 1 : 0) << "\n";
+
+    if (3 == dimension)
+    {
+      header << "space: left-posterior-superior\n";
+    }
+    else
+    {
+      header << "space dimension: " << dimension << "\n";
+    }
+
+    header << "sizes:";
+    if (isVector)
+    {
+      header << " " << numberOfGroups;
+    }
+    for (unsigned int axis = 0; axis < dimension; ++axis)
+    {
+      header << " " << imageIO->GetDimensions(axis);
+    }
+    header << "\n";
+
+    header << "space directions:";
+    if (isVector)
+    {
+      header << " none";
+    }
+    for (unsigned int axis = 0; axis < dimension; ++axis)
+    {
+      const auto direction = imageIO->GetDirection(axis);
+      const double spacing = imageIO->GetSpacing(axis);
+      header << " (";
+      for (unsigned int i = 0; i < dimension; ++i)
+      {
+        header << (i > 0 ? "," : "") << spacing * direction[i];
+      }
+      header << ")";
+    }
+    header << "\n";
+
+    header << "kinds:";
+    if (isVector)
+    {
+      header << " vector";
+    }
+    for (unsigned int axis = 0; axis < dimension; ++axis)
+    {
+      header << " domain";
+    }
+    header << "\n";
+
+    if (imageIO->GetComponentSize() > 1)
+    {
+      header << "endian: " << (itk::ByteSwapper<int>::SystemIsBigEndian() ? "big" : "little") << "\n";
+    }
+    header << "encoding: gzip\n";
+
+    header << "space origin: (";
+    for (unsigned int axis = 0; axis < dimension; ++axis)
+    {
+      header << (axis > 0 ? "," : "") << imageIO->GetOrigin(axis);
+    }
+    header << ")\n";
+
+    // Like itk::NrrdImageIO, only string meta data is written. Keys with the prefix "NRRD_" encode
+    // NRRD fields, which are defined by the geometry above.
+    const auto& dictionary = imageIO->GetMetaDataDictionary();
+    for (const auto& key : dictionary.GetKeys())
+    {
+      std::string value;
+      if (0 == key.compare(0, 5, "NRRD_") || !itk::ExposeMetaData<std::string>(dictionary, key, value))
+      {
+        continue;
+      }
+      header << EscapeNrrdKeyValue(key) << ":=" << EscapeNrrdKeyValue(value) << "\n";
+    }
+
+    header << "\n";
+    return header.str();
+  }
+
+  void WriteLittleEndian32(std::ostream& stream, std::uint32_t value)
+  {
+    const unsigned char bytes[4] = { static_cast<unsigned char>(value & 0xff), static_cast<unsigned char>((value >> 8) & 0xff),
+                                     static_cast<unsigned char>((value >> 16) & 0xff), static_cast<unsigned char>((value >> 24) & 0xff) };
+    stream.write(reinterpret_cast<const char*>(bytes), 4);
+  }
+}
+
+void mitk::LabelGroupNrrdWriter::Write(const std::string& path, const itk::ImageIOBase* imageIO, const std::vector<const void*>& groupBuffers)
+{
+  if (nullptr == imageIO || groupBuffers.empty())
+  {
+    mitkThrow() << "Invalid usage of LabelGroupNrrdWriter. No image IO or no group buffers passed.";
+  }
+
+  const std::size_t numberOfGroups = groupBuffers.size();
+  const std::size_t componentSize = imageIO->GetComponentSize();
+  const std::size_t voxelSize = componentSize * numberOfGroups;
+
+  if (1 != componentSize && 2 != componentSize && 4 != componentSize && 8 != componentSize)
+  {
+    mitkThrow() << "Cannot write label groups. Unsupported component size: " << componentSize;
+  }
+
+  std::size_t numberOfVoxels = 1;
+  for (unsigned int axis = 0; axis < imageIO->GetNumberOfDimensions(); ++axis)
+  {
+    numberOfVoxels *= imageIO->GetDimensions(axis);
+  }
+
+  const std::size_t voxelsPerChunk = std::max<std::size_t>(1, ChunkSize / voxelSize);
+  // at least one (possibly empty) chunk, because the last chunk finishes the deflate stream
+  const std::size_t numberOfChunks = std::max<std::size_t>(1, (numberOfVoxels + voxelsPerChunk - 1) / voxelsPerChunk);
+
+  const std::string header = GenerateNrrdHeader(imageIO, numberOfGroups);
+
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    mitkThrow() << "Cannot open file for writing: " << path;
+  }
+
+  file.write(header.data(), header.size());
+
+  // gzip member header: deflate, no flags, no modification time, fastest compression, unknown OS
+  const unsigned char gzipHeader[10] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 4, 0xff };
+  file.write(reinterpret_cast<const char*>(gzipHeader), sizeof(gzipHeader));
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+  // chunks are compressed in batches, so only the compressed data of one batch is kept in memory
+  const std::size_t batchSize = std::max<std::size_t>(1, 4 * multiThreader->GetNumberOfWorkUnits());
+
+  uLong crc = crc32(0L, Z_NULL, 0);
+  std::vector<CompressedChunk> chunks(batchSize);
+
+  for (std::size_t firstChunk = 0; firstChunk < numberOfChunks; firstChunk += batchSize)
+  {
+    const std::size_t chunksInBatch = std::min(batchSize, numberOfChunks - firstChunk);
+
+    multiThreader->ParallelizeArray(0, chunksInBatch, [&](itk::SizeValueType batchIndex)
+    {
+      const std::size_t chunkIndex = firstChunk + batchIndex;
+      const std::size_t firstVoxel = std::min(numberOfVoxels, chunkIndex * voxelsPerChunk);
+      const std::size_t chunkVoxels = std::min(voxelsPerChunk, numberOfVoxels - firstVoxel);
+      const bool isLastChunk = chunkIndex + 1 == numberOfChunks;
+
+      chunks[batchIndex] = CompressedChunk();
+
+      if (1 == numberOfGroups)
+      {
+        // the group buffer already has the file layout, compress it directly
+        const auto* groupData = static_cast<const unsigned char*>(groupBuffers.front()) + firstVoxel * voxelSize;
+        CompressChunk(groupData, chunkVoxels * voxelSize, isLastChunk, chunks[batchIndex]);
+      }
+      else
+      {
+        std::vector<unsigned char> interleaved(chunkVoxels * voxelSize);
+        InterleaveGroups(groupBuffers, componentSize, firstVoxel, chunkVoxels, interleaved.data());
+        CompressChunk(interleaved.data(), interleaved.size(), isLastChunk, chunks[batchIndex]);
+      }
+    }, nullptr);
+
+    for (std::size_t batchIndex = 0; batchIndex < chunksInBatch; ++batchIndex)
+    {
+      const auto& chunk = chunks[batchIndex];
+      if (!chunk.valid)
+      {
+        mitkThrow() << "Cannot write file " << path << ". Compression of the label groups failed.";
+      }
+      file.write(reinterpret_cast<const char*>(chunk.data.data()), chunk.data.size());
+      crc = crc32_combine(crc, chunk.crc, static_cast<z_off_t>(chunk.size));
+    }
+  }
+
+  // gzip member trailer: CRC-32 and size (modulo 2^32) of the uncompressed data
+  WriteLittleEndian32(file, static_cast<std::uint32_t>(crc));
+  WriteLittleEndian32(file, static_cast<std::uint32_t>(numberOfVoxels * voxelSize));
+
+  file.close();
+  if (file.fail())
+  {
+    mitkThrow() << "Cannot write file: " << path;
+  }
+}
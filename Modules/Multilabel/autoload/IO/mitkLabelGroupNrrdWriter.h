@@ -0,0 +1,46 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelGroupNrrdWriter_h
+#define mitkLabelGroupNrrdWriter_h
+
+#include <itkImageIOBase.h>
+
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+  /**
+  * Writes the group images of a multi-label segmentation as one gzip encoded NRRD file
+  * (same layout as a vector image written by itk::NrrdImageIO, so it is read by the
+  * existing readers).
+  *
+  * In contrast to itk::NrrdImageIO, the groups are not composed into a vector image first.
+  * The data is interleaved and compressed chunk wise in parallel and the compressed chunks
+  * are stored as one gzip stream.
+  */
+  class LabelGroupNrrdWriter
+  {
+  public:
+    /**
+    * @param path File to write.
+    * @param imageIO Image IO that was prepared for one group image (see ItkImageIO::PreparImageIOToWriteImage).
+    * It defines the geometry and component type; all its string meta data is written as key/value pairs.
+    * @param groupBuffers Pixel buffers of all groups. Each buffer must have the size defined by imageIO.
+    * @exception mitk::Exception if the file cannot be written.
+    */
+    static void Write(const std::string& path, const itk::ImageIOBase* imageIO, const std::vector<const void*>& groupBuffers);
+  };
+}
+
+#endif
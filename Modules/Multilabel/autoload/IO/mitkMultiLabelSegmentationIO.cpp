@@ -15,11 +15,13 @@ found in the LICENSE file.
 #include "mitkIOMimeTypes.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkMultiLabelIOHelper.h"
+#include "mitkLabelGroupNrrdWriter.h"
 #include "mitkLabelSetImageConverter.h"
 #include <mitkLocaleSwitch.h>
 #include <mitkArbitraryTimeGeometry.h>
 #include <mitkIPropertyPersistence.h>
 #include <mitkCoreServices.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkItkImageIO.h>
 #include <mitkUIDManipulator.h>
 
@@ -70,17 +72,17 @@ namespace mitk
 
     mitk::LocaleSwitch localeSwitch("C");
 
-    mitk::Image::Pointer inputVector = mitk::ConvertLabelSetImageToImage(input);
-
     // image write
-    if (inputVector.IsNull())
+    if (nullptr == input || input->GetNumberOfLayers() == 0)
     {
       mitkThrow() << "Cannot write non-image data";
     }
 
+    // The image IO only collects the geometry and meta data. The group images are written
+    // by LabelGroupNrrdWriter without composing them into a vector image first.
     itk::NrrdImageIO::Pointer nrrdImageIo = itk::NrrdImageIO::New();
 
-    ItkImageIO::PreparImageIOToWriteImage(nrrdImageIo, inputVector);
+    ItkImageIO::PreparImageIOToWriteImage(nrrdImageIo, input);
 
     LocalFile localFile(this);
     const std::string path = localFile.GetFileName();
@@ -111,12 +113,15 @@ namespace mitk
       // Handle UID
       itk::EncapsulateMetaData<std::string>(nrrdImageIo->GetMetaDataDictionary(), PROPERTY_KEY_UID, input->GetUID());
 
-      // use compression if available
-      nrrdImageIo->UseCompressionOn();
-      nrrdImageIo->SetFileName(path);
+      std::vector<std::unique_ptr<ImageReadAccessor>> groupAccessors;
+      std::vector<const void*> groupBuffers;
+      for (LabelSetImage::GroupIndexType groupID = 0; groupID < input->GetNumberOfLayers(); ++groupID)
+      {
+        groupAccessors.emplace_back(new ImageReadAccessor(input->GetGroupImage(groupID)));
+        groupBuffers.push_back(groupAccessors.back()->GetData());
+      }
 
-      ImageReadAccessor imageAccess(inputVector);
-      nrrdImageIo->Write(imageAccess.GetData());
+      LabelGroupNrrdWriter::Write(path, nrrdImageIo, groupBuffers);
     }
     catch (const std::exception &e)
     {
@@ -15,12 +15,13 @@ found in the LICENSE file.
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
 #include <mitkImagePixelWriteAccessor.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkPadImageFilter.h>
 #include <mitkDICOMSegmentationPropertyHelper.h>
 #include <mitkDICOMQIPropertyHelper.h>
 #include <mitkNodePredicateGeometry.h>
 
-#include <itkLabelGeometryImageFilter.h>
 #include <itkCommand.h>
 #include <itkBinaryFunctorImageFilter.h>
 
@@ -57,6 +58,9 @@ mitk::LabelSetImage::LabelSetImage()
   m_LookupTable = mitk::LookupTable::New();
   m_LookupTable->SetType(mitk::LookupTable::MULTILABEL);
 
+  // allows to update the label statistics only for the modified regions
+  this->SetModifiedRegionTracking(true);
+
   // Add some DICOM Tags as properties to segmentation image
   DICOMSegmentationPropertyHelper::DeriveDICOMSegmentationProperties(this);
 }
@@ -69,10 +73,15 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
     m_ActiveLayer(other.GetActiveLayer()),
     m_activeLayerInvalid(false)
 {
+  this->SetModifiedRegionTracking(true);
+
   GroupIndexType i = 0;
   for (auto groupImage : other.m_LayerContainer)
   {
-    this->AddLayer(groupImage->Clone(), other.GetConstLabelsByValue(other.GetLabelValuesByGroup(i)));
+    // clones do not take over the tracking state, but the group images of a segmentation are always tracked
+    auto groupImageClone = groupImage->Clone();
+    groupImageClone->SetModifiedRegionTracking(true);
+    this->AddLayer(groupImageClone, other.GetConstLabelsByValue(other.GetLabelValuesByGroup(i)));
     i++;
   }
   m_Groups = other.m_Groups;
@@ -195,6 +204,12 @@ void mitk::LabelSetImage::RemoveGroup(GroupIndexType indexToDelete)
   //correct active layer index
   m_ActiveLayer = newActiveIndex;
 
+  {
+    // group indices have changed, so the statistics are recomputed on demand
+    std::lock_guard<std::mutex> guard(m_LabelStatisticsMutex);
+    m_LabelStatistics.clear();
+  }
+
   this->InvokeEvent(LabelsChangedEvent(relevantLabels));
   this->InvokeEvent(GroupRemovedEvent(indexToDelete));
   this->Modified();
@@ -264,6 +279,9 @@ mitk::LabelSetImage::GroupIndexType mitk::LabelSetImage::AddLayer(ConstLabelVect
 
   ClearImageBuffer(newImage);
 
+  // allows to update the label statistics only for the modified regions
+  newImage->SetModifiedRegionTracking(true);
+
   return this->AddLayer(newImage, labels);
 }
 
@@ -462,7 +480,12 @@ void mitk::LabelSetImage::SetActiveLabel(LabelValueType label)
     auto groupID = this->GetGroupIndexOfLabel(label);
     if (groupID!=this->GetActiveLayer()) this->SetActiveLayer(groupID);
   }
+
+  // changing the active label does not change pixels, so the statistics stay valid
+  const auto mTimeBeforeChange = this->GetMTime();
+  this->AddModifiedRegion(0, {});
   Modified();
+  this->UpdateLabelStatistics(m_ActiveLayer, mTimeBeforeChange);
 }
 
 void mitk::LabelSetImage::ClearBuffer()
@@ -480,9 +503,12 @@ void mitk::LabelSetImage::ClearBuffer()
 
 void mitk::LabelSetImage::MergeLabel(PixelType pixelValue, PixelType sourcePixelValue)
 {
+  const auto groupID = this->GetActiveLayer();
+  const auto mTimeBeforeChange = this->GetMTime();
+
   try
   {
-    AccessByItk_2(this, MergeLabelProcessing, pixelValue, sourcePixelValue);
+    this->ReplaceLabelValue(groupID, sourcePixelValue, pixelValue);
   }
   catch (itk::ExceptionObject &e)
   {
@@ -493,15 +519,19 @@ void mitk::LabelSetImage::MergeLabel(PixelType pixelValue, PixelType sourcePixel
   this->InvokeEvent(LabelModifiedEvent(pixelValue));
   this->InvokeEvent(LabelsChangedEvent({ sourcePixelValue, pixelValue }));
   Modified();
+  this->UpdateLabelStatistics(groupID, mTimeBeforeChange);
 }
 
 void mitk::LabelSetImage::MergeLabels(PixelType pixelValue, const std::vector<PixelType>& vectorOfSourcePixelValues)
 {
+  const auto groupID = this->GetActiveLayer();
+  const auto mTimeBeforeChange = this->GetMTime();
+
   try
   {
     for (unsigned int idx = 0; idx < vectorOfSourcePixelValues.size(); idx++)
     {
-      AccessByItk_2(this, MergeLabelProcessing, pixelValue, vectorOfSourcePixelValues[idx]);
+      this->ReplaceLabelValue(groupID, vectorOfSourcePixelValues[idx], pixelValue);
       this->InvokeEvent(LabelModifiedEvent(vectorOfSourcePixelValues[idx]));
     }
   }
@@ -516,6 +546,7 @@ void mitk::LabelSetImage::MergeLabels(PixelType pixelValue, const std::vector<Pi
   this->InvokeEvent(LabelsChangedEvent(modifiedValues));
 
   Modified();
+  this->UpdateLabelStatistics(groupID, mTimeBeforeChange);
 }
 
 void mitk::LabelSetImage::RemoveLabel(LabelValueType pixelValue)
@@ -569,20 +600,14 @@ void mitk::LabelSetImage::RemoveLabels(const LabelValueVectorType& vectorOfLabel
 
 void mitk::LabelSetImage::EraseLabel(LabelValueType pixelValue)
 {
-  try
-  {
-    auto groupID = this->GetGroupIndexOfLabel(pixelValue);
+  auto groupID = this->GetGroupIndexOfLabel(pixelValue);
 
-    mitk::Image* groupImage = this->GetGroupImage(groupID);
+  mitk::Image* groupImage = this->GetGroupImage(groupID);
+  const auto mTimeBeforeChange = groupImage->GetMTime();
 
-    if (4 == this->GetDimension())
-    {
-      AccessFixedDimensionByItk_1(groupImage, EraseLabelProcessing, 4, pixelValue);
-    }
-    else
-    {
-      AccessByItk_1(groupImage, EraseLabelProcessing, pixelValue);
-    }
+  try
+  {
+    this->ReplaceLabelValue(groupID, pixelValue, UNLABELED_VALUE);
     groupImage->Modified();
   }
   catch (const itk::ExceptionObject& e)
@@ -593,6 +618,7 @@ void mitk::LabelSetImage::EraseLabel(LabelValueType pixelValue)
   this->InvokeEvent(LabelModifiedEvent(pixelValue));
   this->InvokeEvent(LabelsChangedEvent({ pixelValue }));
   Modified();
+  this->UpdateLabelStatistics(groupID, mTimeBeforeChange);
 }
 
 void mitk::LabelSetImage::EraseLabels(const LabelValueVectorType& labelValues)
@@ -715,13 +741,163 @@ const mitk::Label* mitk::LabelSetImage::GetActiveLabel() const
 
 void mitk::LabelSetImage::UpdateCenterOfMass(PixelType pixelValue)
 {
-  if (4 == this->GetDimension())
+  if (3 != this->GetDimension())
   {
-    AccessFixedDimensionByItk_1(this->GetGroupImage(this->GetGroupIndexOfLabel(pixelValue)), CalculateCenterOfMassProcessing, 4, pixelValue);
+    return;
   }
-  else
+
+  auto pos = this->GetLabelStatistics(pixelValue).GetCentroid();
+
+  auto label = this->GetLabel(pixelValue);
+  if (label.IsNotNull())
+  {
+    label->SetCenterOfMassIndex(pos);
+    this->GetSlicedGeometry()->IndexToWorld(pos, pos);
+    label->SetCenterOfMassCoordinates(pos);
+  }
+}
+
+mitk::LabelSetImage::LabelStatistics mitk::LabelSetImage::GetLabelStatistics(LabelValueType labelValue, TimeStepType timeStep) const
+{
+  const auto groupID = this->GetGroupIndexOfLabel(labelValue);
+
+  std::lock_guard<std::mutex> guard(m_LabelStatisticsMutex);
+  return this->GetLabelStatisticsIndex(groupID, timeStep).GetStatistics(labelValue);
+}
+
+void mitk::LabelSetImage::UpdateLabelStatistics(GroupIndexType groupID, TimeStepType timeStep, const itk::ImageRegion<3>& region, itk::ModifiedTimeType mTimeBeforeChange)
+{
+  const mitk::Image* groupImage = this->GetGroupImage(groupID);
+
+  this->UpdateLabelStatistics(groupID, mTimeBeforeChange, [groupImage, timeStep, &region](LabelStatisticsIndex& index, TimeStepType indexTimeStep)
+  {
+    if (indexTimeStep != timeStep)
+      return;
+
+    ImageReadAccessor accessor(groupImage, groupImage->GetVolumeData(timeStep));
+    index.Rescan(static_cast<const LabelValueType*>(accessor.GetData()), region);
+  });
+}
+
+mitk::LabelStatisticsIndex& mitk::LabelSetImage::GetLabelStatisticsIndex(GroupIndexType groupID, TimeStepType timeStep) const
+{
+  const mitk::Image* groupImage = this->GetGroupImage(groupID);
+
+  if (!groupImage->GetTimeGeometry()->IsValidTimeStep(timeStep))
+    mitkThrow() << "Cannot compute label statistics. Time step is invalid. Invalid time step: " << timeStep;
+
+  if (groupImage->GetPixelType() != MakeScalarPixelType<LabelValueType>())
+    mitkThrow() << "Cannot compute label statistics. Group image has an unexpected pixel type: " << groupImage->GetPixelType().GetTypeAsString();
+
+  auto& groupStatistics = m_LabelStatistics[groupID];
+  const auto mTime = groupImage->GetMTime();
+
+  if (groupStatistics.GroupImage != groupImage)
+  {
+    groupStatistics.TimeSteps.clear();
+    groupStatistics.GroupImage = groupImage;
+    groupStatistics.MTime = mTime;
+  }
+  else if (groupStatistics.MTime < mTime)
+  { // only rescan the regions the group image knows to be modified; otherwise recompute
+    Image::ModifiedRegionVectorType regions;
+    for (auto iter = groupStatistics.TimeSteps.begin(); iter != groupStatistics.TimeSteps.end();)
+    {
+      if (groupImage->GetModifiedRegions(groupStatistics.MTime, iter->first, regions))
+      {
+        ImageReadAccessor accessor(groupImage, groupImage->GetVolumeData(iter->first));
+        for (const auto& region : regions)
+          iter->second->Rescan(static_cast<const LabelValueType*>(accessor.GetData()), region);
+        ++iter;
+      }
+      else
+      {
+        iter = groupStatistics.TimeSteps.erase(iter);
+      }
+    }
+    groupStatistics.MTime = mTime;
+  }
+
+  auto& index = groupStatistics.TimeSteps[timeStep];
+
+  if (nullptr == index)
+  {
+    index = std::make_unique<LabelStatisticsIndex>(std::array<unsigned int, 3>{{ groupImage->GetDimension(0), groupImage->GetDimension(1), groupImage->GetDimension(2) }});
+
+    ImageReadAccessor accessor(groupImage, groupImage->GetVolumeData(timeStep));
+    index->Scan(static_cast<const LabelValueType*>(accessor.GetData()));
+  }
+
+  return *index;
+}
+
+void mitk::LabelSetImage::UpdateLabelStatistics(GroupIndexType groupID, itk::ModifiedTimeType mTimeBeforeChange,
+  const std::function<void(LabelStatisticsIndex&, TimeStepType)>& update)
+{
+  std::lock_guard<std::mutex> guard(m_LabelStatisticsMutex);
+
+  auto finding = m_LabelStatistics.find(groupID);
+  if (m_LabelStatistics.end() == finding)
+    return;
+
+  if (!this->ExistGroup(groupID))
+  {
+    m_LabelStatistics.erase(finding);
+    return;
+  }
+
+  const mitk::Image* groupImage = this->GetGroupImage(groupID);
+  auto& groupStatistics = finding->second;
+
+  if (groupStatistics.GroupImage != groupImage || groupStatistics.MTime < mTimeBeforeChange)
+  { // the group image was changed before without reporting the changed region; recompute on demand
+    m_LabelStatistics.erase(finding);
+    return;
+  }
+
+  if (update)
+  {
+    for (auto& [timeStep, index] : groupStatistics.TimeSteps)
+      update(*index, timeStep);
+  }
+
+  groupStatistics.MTime = groupImage->GetMTime();
+}
+
+void mitk::LabelSetImage::ReplaceLabelValue(GroupIndexType groupID, LabelValueType sourceValue, LabelValueType targetValue)
+{
+  mitk::Image* groupImage = this->GetGroupImage(groupID);
+
+  const std::size_t dimX = groupImage->GetDimension(0);
+  const std::size_t sliceSize = dimX * groupImage->GetDimension(1);
+
+  std::lock_guard<std::mutex> guard(m_LabelStatisticsMutex);
+
+  for (TimeStepType timeStep = 0; timeStep < groupImage->GetTimeSteps(); ++timeStep)
   {
-    AccessByItk_1(this->GetGroupImage(this->GetGroupIndexOfLabel(pixelValue)), CalculateCenterOfMassProcessing, pixelValue);
+    auto& statisticsIndex = this->GetLabelStatisticsIndex(groupID, timeStep);
+    const auto region = statisticsIndex.GetStatistics(sourceValue).GetBoundingRegion();
+
+    if (0 == region.GetNumberOfPixels())
+      continue;
+
+    ImageWriteAccessor accessor(groupImage, groupImage->GetVolumeData(timeStep));
+    accessor.SetModifiedRegion(region);
+    auto* volume = static_cast<LabelValueType*>(accessor.GetData());
+
+    const auto& index = region.GetIndex();
+    const auto& size = region.GetSize();
+
+    for (std::size_t z = 0; z < size[2]; ++z)
+    {
+      for (std::size_t y = 0; y < size[1]; ++y)
+      {
+        auto* row = volume + (index[2] + z) * sliceSize + (index[1] + y) * dimX + index[0];
+        std::replace(row, row + size[0], sourceValue, targetValue);
+      }
+    }
+
+    statisticsIndex.MergeLabel(targetValue, sourceValue);
   }
 }
 
@@ -924,33 +1100,6 @@ void mitk::LabelSetImage::MaskStampProcessing(ImageType *itkImage, mitk::Image *
   this->Modified();
 }
 
-template <typename ImageType>
-void mitk::LabelSetImage::CalculateCenterOfMassProcessing(ImageType *itkImage, LabelValueType pixelValue)
-{
-  if (ImageType::GetImageDimension() != 3)
-  {
-    return;
-  }
-
-  auto labelGeometryFilter = itk::LabelGeometryImageFilter<ImageType>::New();
-  labelGeometryFilter->SetInput(itkImage);
-  labelGeometryFilter->Update();
-  auto centroid = labelGeometryFilter->GetCentroid(pixelValue);
-
-  mitk::Point3D pos;
-  pos[0] = centroid[0];
-  pos[1] = centroid[1];
-  pos[2] = centroid[2];
-
-  auto label = this->GetLabel(pixelValue);
-  if (label.IsNotNull())
-  {
-    label->SetCenterOfMassIndex(pos);
-    this->GetSlicedGeometry()->IndexToWorld(pos, pos);
-    label->SetCenterOfMassCoordinates(pos);
-  }
-}
-
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::LabelSetImage::LayerContainerToImageProcessing(itk::Image<TPixel, VImageDimension> *target,
                                                           unsigned int layer)
@@ -1004,44 +1153,6 @@ void mitk::LabelSetImage::ImageToLayerContainerProcessing(const itk::Image<TPixe
   m_LayerContainer[layer]->Modified();
 }
 
-template <typename ImageType>
-void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage, PixelType pixelValue)
-{
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
-
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  while (!iter.IsAtEnd())
-  {
-    PixelType value = iter.Get();
-
-    if (value == pixelValue)
-    {
-      iter.Set(0);
-    }
-    ++iter;
-  }
-}
-
-template <typename ImageType>
-void mitk::LabelSetImage::MergeLabelProcessing(ImageType *itkImage, PixelType pixelValue, PixelType index)
-{
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
-
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  while (!iter.IsAtEnd())
-  {
-    if (iter.Get() == index)
-    {
-      iter.Set(pixelValue);
-    }
-    ++iter;
-  }
-}
-
 void mitk::LabelSetImage::AddLabelToMap(LabelValueType labelValue, mitk::Label* label, GroupIndexType groupID)
 {
   if (m_LabelMap.find(labelValue)!=m_LabelMap.end())
@@ -1097,7 +1208,11 @@ void mitk::LabelSetImage::OnLabelModified(const Object* sender, const itk::Event
   if (nullptr == label)
     mitkThrow() << "LabelSet is in wrong state. LabelModified event is not send by a label instance.";
 
+  // label properties do not change pixels, so the statistics stay valid
+  const auto mTimeBeforeChange = this->GetMTime();
+  this->AddModifiedRegion(0, {});
   Superclass::Modified();
+  this->UpdateLabelStatistics(m_ActiveLayer, mTimeBeforeChange);
   this->InvokeEvent(LabelModifiedEvent(label->GetValue()));
 }
 
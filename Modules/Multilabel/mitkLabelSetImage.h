@@ -13,9 +13,11 @@ found in the LICENSE file.
 #ifndef mitkLabelSetImage_h
 #define mitkLabelSetImage_h
 
+#include <mutex>
 #include <shared_mutex>
 #include <mitkImage.h>
 #include <mitkLabel.h>
+#include <mitkLabelStatisticsIndex.h>
 #include <mitkLookupTable.h>
 #include <mitkMultiLabelEvents.h>
 #include <mitkMessage.h>
@@ -362,6 +364,26 @@ namespace mitk
     */
     void UpdateLookupTable(PixelType pixelValue);
 
+    using LabelStatistics = LabelStatisticsIndex::Statistics;
+
+    /** Returns voxel count, bounding box and centroid (in index coordinates) of a label at a time step.
+    * The statistics are kept per group and time step and are only recomputed for the regions reported
+    * via UpdateLabelStatistics(). If the group image was modified otherwise, the whole volume is rescanned
+    * once on the next request.
+    * @pre labelValue must exist.
+    * @pre timeStep must be a valid time step of the segmentation.*/
+    LabelStatistics GetLabelStatistics(LabelValueType labelValue, TimeStepType timeStep = 0) const;
+
+    /** Informs the segmentation that only the passed region of a group image at a time step was changed.
+    * Call it after the pixels were written and the group image was modified.
+    * @param groupID Index of the changed group.
+    * @param timeStep Changed time step.
+    * @param region Changed region (index coordinates of the group image).
+    * @param mTimeBeforeChange Modification time of the group image before the pixels were written. The statistics
+    * are only updated incrementally if they were valid at this point in time; otherwise they are discarded.
+    * @pre groupID must reference an existing group.*/
+    void UpdateLabelStatistics(GroupIndexType groupID, TimeStepType timeStep, const itk::ImageRegion<3>& region, itk::ModifiedTimeType mTimeBeforeChange);
+
     protected:
 
       void OnLabelModified(const Object* sender, const itk::EventObject&);
@@ -413,6 +435,34 @@ namespace mitk
       /** Mutex used to secure manipulations of the internal state of label and group maps.*/
       std::shared_mutex m_LabelNGroupMapsMutex;
 
+      /** Returns the statistics index of a group at a time step. It is (re)computed if it is missing or if the
+      * group image was modified since it was computed. m_LabelStatisticsMutex must be locked by the caller.*/
+      LabelStatisticsIndex& GetLabelStatisticsIndex(GroupIndexType groupID, TimeStepType timeStep) const;
+
+      /** Replaces the pixel value sourceValue by targetValue in all time steps of a group image. Only the bounding
+      * boxes of sourceValue are visited and the statistics are updated accordingly. The caller has to modify the
+      * group image and to call UpdateLabelStatistics() afterwards.*/
+      void ReplaceLabelValue(GroupIndexType groupID, LabelValueType sourceValue, LabelValueType targetValue);
+
+      /** Applies an update to all computed statistics indices of a group and marks them as valid for the current
+      * state of the group image, if they were valid before the group image was changed (see UpdateLabelStatistics()).
+      * Otherwise they are discarded. Without update, the change is assumed to have no effect on the statistics.*/
+      void UpdateLabelStatistics(GroupIndexType groupID, itk::ModifiedTimeType mTimeBeforeChange,
+        const std::function<void(LabelStatisticsIndex&, TimeStepType)>& update = nullptr);
+
+      struct GroupLabelStatistics
+      {
+        /** Group image the statistics were computed for.*/
+        const Image* GroupImage = nullptr;
+        /** Modification time of the group image the statistics are valid for.*/
+        itk::ModifiedTimeType MTime = 0;
+        std::map<TimeStepType, std::unique_ptr<LabelStatisticsIndex>> TimeSteps;
+      };
+
+      /** Lazily computed label statistics of the groups (group index is the key).*/
+      mutable std::map<GroupIndexType, GroupLabelStatistics> m_LabelStatistics;
+      mutable std::mutex m_LabelStatisticsMutex;
+
     public:
 
 
@@ -514,6 +564,8 @@ namespace mitk
     * \pre layerImage must be valid instance
     * \pre layerImage needs to have the same geometry then the segmentation
     * \pre layerImage must have the pixel value equal to LabelValueType.
+    * \remark The modified region tracking of layerImage is not changed. If it is enabled (see
+    * Image::SetModifiedRegionTracking()), the label statistics of the group are updated incrementally.
     */
     GroupIndexType AddLayer(mitk::Image* layerImage, ConstLabelVector labels = {});
 
@@ -530,15 +582,6 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void ImageToLayerContainerProcessing(const itk::Image<TPixel, VImageDimension> *source, unsigned int layer) const;
 
-    template <typename ImageType>
-    void CalculateCenterOfMassProcessing(ImageType *input, LabelValueType index);
-
-    template <typename ImageType>
-    void EraseLabelProcessing(ImageType *input, PixelType index);
-
-    template <typename ImageType>
-    void MergeLabelProcessing(ImageType *input, PixelType pixelValue, PixelType index);
-
     template <typename ImageType>
     void MaskStampProcessing(ImageType *input, mitk::Image *mask, bool forceOverwrite);
 
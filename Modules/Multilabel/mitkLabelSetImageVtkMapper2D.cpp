@@ -36,7 +36,10 @@ found in the LICENSE file.
 #include <vtkPlaneSource.h>
 #include <vtkPolyData.h>
 #include <vtkPolyDataMapper.h>
-#include <vtkImageMapToColors.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
 
 namespace
 {
@@ -133,6 +136,22 @@ void mitk::LabelSetImageVtkMapper2D::GenerateLookupTable(mitk::BaseRenderer* ren
       localStorage->m_LabelLookupTable->Modified();
     }
   }
+
+  // Map all possible label values once, so that compositing only needs a table look up per pixel.
+  auto lookUpTable = localStorage->m_LabelLookupTable->GetVtkLookupTable();
+  auto& colors = localStorage->m_PremultipliedLabelColors;
+  colors.resize(static_cast<std::size_t>(std::numeric_limits<mitk::Label::PixelType>::max()) + 1);
+
+  for (std::size_t value = 0; value < colors.size(); ++value)
+  {
+    const unsigned char* rgba = lookUpTable->MapValue(static_cast<double>(value));
+    const unsigned int alpha = rgba[3];
+
+    for (int i = 0; i < 3; ++i)
+      colors[value][i] = static_cast<unsigned char>((rgba[i] * alpha + 127) / 255);
+
+    colors[value][3] = rgba[3];
+  }
 }
 
 namespace
@@ -206,10 +225,10 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     for (unsigned int lidx = 0; lidx < localStorage->m_NumberOfLayers; ++lidx)
     {
       localStorage->m_ReslicedImageVector[lidx] = nullptr;
-      localStorage->m_LayerMapperVector[lidx]->SetInputData(localStorage->m_EmptyPolyData);
-      localStorage->m_OutlineActor->SetVisibility(false);
-      localStorage->m_OutlineShadowActor->SetVisibility(false);
     }
+    localStorage->m_LayerMapper->SetInputData(localStorage->m_EmptyPolyData);
+    localStorage->m_OutlineActor->SetVisibility(false);
+    localStorage->m_OutlineShadowActor->SetVisibility(false);
     localStorage->m_LastDataUpdateTime.Modified();
   }
 
@@ -247,36 +266,26 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
   node->GetOpacity(opacity, renderer, "opacity");
   opacity *= this->GetOpacityFactor();
 
-  if (isLookupModified)
-  {
-    //if lookup table is modified all groups need a new color mapping
-    outdatedGroups.resize(segmentation->GetNumberOfLayers());
-    std::iota(outdatedGroups.begin(), outdatedGroups.end(), 0);
-  }
-
-  for (const auto groupID: outdatedGroups)
+  if (!outdatedGroups.empty() || isLookupModified)
   {
-    localStorage->m_LayerImageMapToColors[groupID]->SetLookupTable(localStorage->m_LabelLookupTable->GetVtkLookupTable());
-    localStorage->m_LayerImageMapToColors[groupID]->SetInputData(localStorage->m_ReslicedImageVector[groupID]);
-    localStorage->m_LayerImageMapToColors[groupID]->Update();
+    // a changed group slice or lookup table only requires one compositing pass over the slice
+    this->GenerateCompositedSlice(renderer);
 
     // check for texture interpolation property
     bool textureInterpolation = false;
     node->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
 
     // set the interpolation modus according to the property
-    localStorage->m_LayerTextureVector[groupID]->SetInterpolate(textureInterpolation);
-
-    localStorage->m_LayerTextureVector[groupID]->SetInputConnection(
-      localStorage->m_LayerImageMapToColors[groupID]->GetOutputPort());
+    localStorage->m_LayerTexture->SetInterpolate(textureInterpolation);
+    localStorage->m_LayerTexture->SetInputData(localStorage->m_CompositedImage);
     this->TransformActor(renderer);
 
     // set the plane as input for the mapper
-    localStorage->m_LayerMapperVector[groupID]->SetInputConnection(localStorage->m_Plane->GetOutputPort());
+    localStorage->m_LayerMapper->SetInputConnection(localStorage->m_Plane->GetOutputPort());
 
     // set the texture for the actor
-    localStorage->m_LayerActorVector[groupID]->SetTexture(localStorage->m_LayerTextureVector[groupID]);
-    localStorage->m_LayerActorVector[groupID]->GetProperty()->SetOpacity(opacity);
+    localStorage->m_LayerActor->SetTexture(localStorage->m_LayerTexture);
+    localStorage->m_LayerActor->GetProperty()->SetOpacity(opacity);
   }
 
   auto activeLayer = segmentation->GetActiveLayer();
@@ -312,15 +321,7 @@ void mitk::LabelSetImageVtkMapper2D::GenerateImageSlice(mitk::BaseRenderer* rend
         localStorage->m_GroupImageIDs.push_back(nullptr);
         localStorage->m_ReslicedImageVector.push_back(vtkSmartPointer<vtkImageData>::New());
         localStorage->m_ReslicerVector.push_back(mitk::ExtractSliceFilter::New());
-        localStorage->m_LayerTextureVector.push_back(vtkSmartPointer<vtkNeverTranslucentTexture>::New());
-        localStorage->m_LayerMapperVector.push_back(vtkSmartPointer<vtkPolyDataMapper>::New());
-        localStorage->m_LayerActorVector.push_back(vtkSmartPointer<vtkActor>::New());
-        localStorage->m_LayerImageMapToColors.push_back(vtkSmartPointer<vtkImageMapToColors>::New());
-
-        // do not repeat the texture (the image)
-        localStorage->m_LayerTextureVector[lidx]->RepeatOff();
-        // set corresponding mappers for the actors
-        localStorage->m_LayerActorVector[lidx]->SetMapper(localStorage->m_LayerMapperVector[lidx]);
+        localStorage->m_GroupSliceHasLabels.push_back(false);
       }
     }
     else
@@ -328,23 +329,15 @@ void mitk::LabelSetImageVtkMapper2D::GenerateImageSlice(mitk::BaseRenderer* rend
       localStorage->m_GroupImageIDs.resize(numberOfLayers);
       localStorage->m_ReslicedImageVector.resize(numberOfLayers);
       localStorage->m_ReslicerVector.resize(numberOfLayers);
-      localStorage->m_LayerTextureVector.resize(numberOfLayers);
-      localStorage->m_LayerMapperVector.resize(numberOfLayers);
-      localStorage->m_LayerActorVector.resize(numberOfLayers);
-      localStorage->m_LayerImageMapToColors.resize(numberOfLayers);
+      localStorage->m_GroupSliceHasLabels.resize(numberOfLayers);
     }
     localStorage->m_NumberOfLayers = numberOfLayers;
-
-    localStorage->m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
-
-    for (unsigned int lidx = 0; lidx < numberOfLayers; ++lidx)
-    {
-      localStorage->m_Actors->AddPart(localStorage->m_LayerActorVector[lidx]);
-    }
-    localStorage->m_Actors->AddPart(localStorage->m_OutlineShadowActor);
-    localStorage->m_Actors->AddPart(localStorage->m_OutlineActor);
   }
 
+  // is the geometry of the slice based on the image image or the worldgeometry?
+  bool inPlaneResampleExtentByGeometry = false;
+  node->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
+
   for (const auto groupID : outdatedGroupIDs)
   {
     const auto groupImage = segmentation->GetGroupImage(groupID);
@@ -358,9 +351,6 @@ void mitk::LabelSetImageVtkMapper2D::GenerateImageSlice(mitk::BaseRenderer* rend
     localStorage->m_ReslicerVector[groupID]->SetResliceTransformByGeometry(
       groupImage->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
 
-    // is the geometry of the slice based on the image image or the worldgeometry?
-    bool inPlaneResampleExtentByGeometry = false;
-    node->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
     localStorage->m_ReslicerVector[groupID]->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
     localStorage->m_ReslicerVector[groupID]->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
     localStorage->m_ReslicerVector[groupID]->SetVtkOutputRequest(true);
@@ -382,7 +372,7 @@ void mitk::LabelSetImageVtkMapper2D::GenerateImageSlice(mitk::BaseRenderer* rend
 
     localStorage->m_ReslicerVector[groupID]->GetClippedPlaneBounds(sliceBounds);
 
-    // setup the textured plane
+    // setup the textured plane (the same for all groups)
     this->GeneratePlane(renderer, sliceBounds);
 
     // get the spacing of the slice
@@ -391,10 +381,98 @@ void mitk::LabelSetImageVtkMapper2D::GenerateImageSlice(mitk::BaseRenderer* rend
     // start the pipeline with updating the largest possible, needed if the geometry of the image has changed
     localStorage->m_ReslicerVector[groupID]->UpdateLargestPossibleRegion();
     localStorage->m_ReslicedImageVector[groupID] = localStorage->m_ReslicerVector[groupID]->GetVtkOutput();
+
+    auto* slice = localStorage->m_ReslicedImageVector[groupID].GetPointer();
+    const auto* firstPixel = static_cast<const mitk::Label::PixelType*>(slice->GetScalarPointer());
+    localStorage->m_GroupSliceHasLabels[groupID] = nullptr != firstPixel
+      && std::any_of(firstPixel, firstPixel + slice->GetNumberOfPoints(), [](mitk::Label::PixelType value) { return 0 != value; });
   }
   localStorage->m_LastDataUpdateTime.Modified();
 }
 
+void mitk::LabelSetImageVtkMapper2D::GenerateCompositedSlice(mitk::BaseRenderer* renderer)
+{
+  LocalStorage* localStorage = m_LSH.GetLocalStorage(renderer);
+
+  // All group slices are resliced with the same geometry. Slices without label values are skipped.
+  vtkImageData* referenceSlice = nullptr;
+  std::vector<const mitk::Label::PixelType*> groupSlices;
+
+  for (unsigned int groupID = 0; groupID < localStorage->m_NumberOfLayers; ++groupID)
+  {
+    auto* slice = localStorage->m_ReslicedImageVector[groupID].GetPointer();
+
+    if (nullptr == slice || nullptr == slice->GetScalarPointer())
+      continue;
+
+    if (nullptr == referenceSlice)
+    {
+      referenceSlice = slice;
+    }
+    else if (!std::equal(slice->GetExtent(), slice->GetExtent() + 6, referenceSlice->GetExtent()))
+    {
+      MITK_WARN << "Slice of group " << groupID << " does not match the slices of the other groups. It is not rendered.";
+      continue;
+    }
+
+    if (localStorage->m_GroupSliceHasLabels[groupID])
+      groupSlices.push_back(static_cast<const mitk::Label::PixelType*>(slice->GetScalarPointer()));
+  }
+
+  auto* composite = localStorage->m_CompositedImage.GetPointer();
+  int extent[6] = { 0, 0, 0, 0, 0, 0 };
+
+  if (nullptr != referenceSlice)
+  {
+    referenceSlice->GetExtent(extent);
+    composite->SetOrigin(referenceSlice->GetOrigin());
+    composite->SetSpacing(referenceSlice->GetSpacing());
+  }
+
+  if (!std::equal(extent, extent + 6, composite->GetExtent()) || nullptr == composite->GetScalarPointer())
+  {
+    composite->SetExtent(extent);
+    composite->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+  }
+
+  auto* outputPixel = static_cast<unsigned char*>(composite->GetScalarPointer());
+  const auto numberOfPixels = composite->GetNumberOfPoints();
+  const auto& colors = localStorage->m_PremultipliedLabelColors;
+
+  for (vtkIdType pixelID = 0; pixelID < numberOfPixels; ++pixelID, outputPixel += 4)
+  {
+    // "over" operator in group order with premultiplied alpha
+    unsigned int rgba[4] = { 0, 0, 0, 0 };
+
+    for (const auto* groupSlice : groupSlices)
+    {
+      const auto& color = colors[groupSlice[pixelID]];
+
+      if (0 == color[3])
+        continue;
+
+      const unsigned int transparency = 255 - color[3];
+
+      for (int i = 0; i < 4; ++i)
+        rgba[i] = color[i] + (rgba[i] * transparency + 127) / 255;
+    }
+
+    // The texture is rendered like the former per group textures, i.e. without premultiplied alpha.
+    if (0 == rgba[3])
+    {
+      std::fill(outputPixel, outputPixel + 4, 0);
+      continue;
+    }
+
+    for (int i = 0; i < 3; ++i)
+      outputPixel[i] = static_cast<unsigned char>(std::min(255u, (rgba[i] * 255 + rgba[3] / 2) / rgba[3]));
+
+    outputPixel[3] = static_cast<unsigned char>(rgba[3]);
+  }
+
+  composite->Modified();
+}
+
 void mitk::LabelSetImageVtkMapper2D::GenerateActiveLabelOutline(mitk::BaseRenderer* renderer)
 {
   LocalStorage* localStorage = m_LSH.GetLocalStorage(renderer);
@@ -724,14 +802,11 @@ void mitk::LabelSetImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer
   vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_ReslicerVector[0]->GetResliceAxes(); // same for all layers
   trans->SetMatrix(matrix);
 
-  for (unsigned int lidx = 0; lidx < localStorage->m_NumberOfLayers; ++lidx)
-  {
-    // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or sagittal)
-    localStorage->m_LayerActorVector[lidx]->SetUserTransform(trans);
-    // transform the origin to center based coordinates, because MITK is center based.
-    localStorage->m_LayerActorVector[lidx]->SetPosition(
-      -0.5 * localStorage->m_mmPerPixel[0], -0.5 * localStorage->m_mmPerPixel[1], 0.0);
-  }
+  // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or sagittal)
+  localStorage->m_LayerActor->SetUserTransform(trans);
+  // transform the origin to center based coordinates, because MITK is center based.
+  localStorage->m_LayerActor->SetPosition(
+    -0.5 * localStorage->m_mmPerPixel[0], -0.5 * localStorage->m_mmPerPixel[1], 0.0);
   // same for outline actor
   localStorage->m_OutlineActor->SetUserTransform(trans);
   localStorage->m_OutlineActor->SetPosition(
@@ -770,6 +845,10 @@ mitk::LabelSetImageVtkMapper2D::LocalStorage::LocalStorage()
   m_OutlineActor = vtkSmartPointer<vtkActor>::New();
   m_OutlineMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
   m_OutlineShadowActor = vtkSmartPointer<vtkActor>::New();
+  m_LayerActor = vtkSmartPointer<vtkActor>::New();
+  m_LayerMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+  m_LayerTexture = vtkSmartPointer<vtkNeverTranslucentTexture>::New();
+  m_CompositedImage = vtkSmartPointer<vtkImageData>::New();
 
   m_HasValidContent = false;
   m_NumberOfLayers = 0;
@@ -781,4 +860,12 @@ mitk::LabelSetImageVtkMapper2D::LocalStorage::LocalStorage()
 
   m_OutlineActor->SetVisibility(false);
   m_OutlineShadowActor->SetVisibility(false);
+
+  // do not repeat the texture (the image)
+  m_LayerTexture->RepeatOff();
+  m_LayerActor->SetMapper(m_LayerMapper);
+
+  m_Actors->AddPart(m_LayerActor);
+  m_Actors->AddPart(m_OutlineShadowActor);
+  m_Actors->AddPart(m_OutlineActor);
 }
@@ -26,6 +26,8 @@ found in the LICENSE file.
 // VTK
 #include <vtkSmartPointer.h>
 
+#include <array>
+
 class vtkActor;
 class vtkPolyDataMapper;
 class vtkPlaneSource;
@@ -36,13 +38,16 @@ class vtkPoints;
 class vtkMitkThickSlicesFilter;
 class vtkPolyData;
 class vtkNeverTranslucentTexture;
-class vtkImageMapToColors;
 
 namespace mitk
 {
   class IPreferences;
 
   /** \brief Mapper to resample and display 2D slices of a 3D labelset image.
+   *
+   * The slices of all groups are composited into a single RGBA texture (group 0 at the bottom),
+   * so there is only one textured plane per render window regardless of the number of groups.
+   * Only groups whose data changed are resliced; a changed lookup table only requires a new compositing pass.
    *
    * Properties that can be set for labelset images and influence this mapper are:
    *
@@ -74,6 +79,9 @@ namespace mitk
 
     //### methods of MITK-VTK rendering pipeline
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
+
+    /** The label texture only depends on the node, its segmentation and the world geometry of the renderer */
+    bool DependsOnOtherNodes() const override { return false; }
     //### end of methods of MITK-VTK rendering pipeline
 
     /** \brief Internal class holding the mapper, actor, etc. for each of the 3 2D render windows */
@@ -94,11 +102,17 @@ namespace mitk
        * in order to adapt the pipe line accordingly*/
       std::vector<const Image*> m_GroupImageIDs;
 
-      std::vector<vtkSmartPointer<vtkActor>> m_LayerActorVector;
-      std::vector<vtkSmartPointer<vtkPolyDataMapper>> m_LayerMapperVector;
+      /** \brief Actor, mapper and texture of the plane showing the composited slice of all groups. */
+      vtkSmartPointer<vtkActor> m_LayerActor;
+      vtkSmartPointer<vtkPolyDataMapper> m_LayerMapper;
+      vtkSmartPointer<vtkNeverTranslucentTexture> m_LayerTexture;
+      /** \brief RGBA slice with the colors of all groups. */
+      vtkSmartPointer<vtkImageData> m_CompositedImage;
+
       std::vector<vtkSmartPointer<vtkImageData>> m_ReslicedImageVector;
-      std::vector<vtkSmartPointer<vtkImageMapToColors>> m_LayerImageMapToColors;
-      std::vector<vtkSmartPointer<vtkNeverTranslucentTexture>> m_LayerTextureVector;
+      /** \brief Indicates for each group whether its current slice contains any label value (0 otherwise).
+       * Slices without label values are skipped while compositing.*/
+      std::vector<bool> m_GroupSliceHasLabels;
 
       vtkSmartPointer<vtkPolyData> m_EmptyPolyData;
       vtkSmartPointer<vtkPlaneSource> m_Plane;
@@ -126,6 +140,9 @@ namespace mitk
       /** look up table for label colors. */
       mitk::LookupTable::Pointer m_LabelLookupTable;
 
+      /** Colors of m_LabelLookupTable for all label values as RGBA with premultiplied alpha. */
+      std::vector<std::array<unsigned char, 4>> m_PremultipliedLabelColors;
+
       mitk::PlaneGeometry::Pointer m_WorldPlane;
       bool m_HasValidContent;
 
@@ -205,6 +222,11 @@ namespace mitk
 
     void GenerateImageSlice(mitk::BaseRenderer* renderer, const std::vector<mitk::LabelSetImage::GroupIndexType>& outdatedGroupIDs);
 
+    /** \brief Composites the resliced slices of all groups into the RGBA texture in a single pass over the slice.
+      * Per pixel, the colors of the groups are blended (with premultiplied alpha) in group order.
+      */
+    void GenerateCompositedSlice(mitk::BaseRenderer* renderer);
+
     void GenerateActiveLabelOutline(mitk::BaseRenderer* renderer);
 
     /** \brief Generates the look up table that should be used.
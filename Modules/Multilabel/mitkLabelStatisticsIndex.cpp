@@ -0,0 +1,287 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkLabelStatisticsIndex.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+
+namespace
+{
+  constexpr unsigned int BrickSize = 32;
+
+  unsigned int NumberOfBricks(unsigned int dimension)
+  {
+    return (dimension + BrickSize - 1) / BrickSize;
+  }
+}
+
+mitk::LabelStatisticsIndex::RegionType mitk::LabelStatisticsIndex::Statistics::GetBoundingRegion() const
+{
+  RegionType region;
+
+  if (0 == VoxelCount)
+    return region;
+
+  itk::Size<3> size;
+  for (unsigned int i = 0; i < 3; ++i)
+    size[i] = static_cast<itk::SizeValueType>(MaxIndex[i] - MinIndex[i] + 1);
+
+  region.SetIndex(MinIndex);
+  region.SetSize(size);
+  return region;
+}
+
+mitk::Point3D mitk::LabelStatisticsIndex::Statistics::GetCentroid() const
+{
+  Point3D centroid;
+  centroid.Fill(0.0);
+
+  if (0 == VoxelCount)
+    return centroid;
+
+  for (unsigned int i = 0; i < 3; ++i)
+    centroid[i] = IndexSum[i] / static_cast<double>(VoxelCount);
+
+  return centroid;
+}
+
+void mitk::LabelStatisticsIndex::Statistics::Merge(const Statistics& other)
+{
+  if (0 == other.VoxelCount)
+    return;
+
+  if (0 == VoxelCount)
+  {
+    *this = other;
+    return;
+  }
+
+  VoxelCount += other.VoxelCount;
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    MinIndex[i] = std::min(MinIndex[i], other.MinIndex[i]);
+    MaxIndex[i] = std::max(MaxIndex[i], other.MaxIndex[i]);
+    IndexSum[i] += other.IndexSum[i];
+  }
+}
+
+mitk::LabelStatisticsIndex::LabelStatisticsIndex(const std::array<unsigned int, 3>& dimensions)
+  : m_Dimensions(dimensions)
+{
+  for (unsigned int i = 0; i < 3; ++i)
+    m_NumberOfBricks[i] = NumberOfBricks(m_Dimensions[i]);
+
+  m_Bricks.resize(static_cast<std::size_t>(m_NumberOfBricks[0]) * m_NumberOfBricks[1] * m_NumberOfBricks[2]);
+}
+
+mitk::LabelStatisticsIndex::BrickType mitk::LabelStatisticsIndex::ScanBrick(const LabelValueType* volume, std::size_t brickIndex) const
+{
+  const std::size_t brickX = brickIndex % m_NumberOfBricks[0];
+  const std::size_t brickY = (brickIndex / m_NumberOfBricks[0]) % m_NumberOfBricks[1];
+  const std::size_t brickZ = brickIndex / (static_cast<std::size_t>(m_NumberOfBricks[0]) * m_NumberOfBricks[1]);
+
+  const std::size_t beginX = brickX * BrickSize;
+  const std::size_t endX = std::min<std::size_t>(beginX + BrickSize, m_Dimensions[0]);
+  const std::size_t beginY = brickY * BrickSize;
+  const std::size_t endY = std::min<std::size_t>(beginY + BrickSize, m_Dimensions[1]);
+  const std::size_t beginZ = brickZ * BrickSize;
+  const std::size_t endZ = std::min<std::size_t>(beginZ + BrickSize, m_Dimensions[2]);
+
+  const std::size_t sliceSize = static_cast<std::size_t>(m_Dimensions[0]) * m_Dimensions[1];
+
+  BrickType brick;
+  std::size_t lastEntry = 0;
+
+  for (std::size_t z = beginZ; z < endZ; ++z)
+  {
+    for (std::size_t y = beginY; y < endY; ++y)
+    {
+      const LabelValueType* row = volume + z * sliceSize + y * m_Dimensions[0];
+      std::size_t x = beginX;
+
+      while (x < endX)
+      {
+        const auto value = row[x];
+        const std::size_t runBegin = x;
+
+        while (x < endX && row[x] == value)
+          ++x;
+
+        if (0 == value)
+          continue;
+
+        // Runs of the same value are common, so the previously used entry is checked first.
+        if (lastEntry >= brick.size() || brick[lastEntry].Value != value)
+        {
+          auto iter = std::find_if(brick.begin(), brick.end(), [value](const Entry& entry) { return entry.Value == value; });
+
+          if (iter == brick.end())
+          {
+            brick.push_back({ value, Statistics() });
+            iter = brick.end() - 1;
+          }
+
+          lastEntry = static_cast<std::size_t>(iter - brick.begin());
+        }
+
+        const std::size_t runLength = x - runBegin;
+
+        Statistics runStats;
+        runStats.VoxelCount = runLength;
+        runStats.MinIndex = {{ static_cast<itk::IndexValueType>(runBegin), static_cast<itk::IndexValueType>(y), static_cast<itk::IndexValueType>(z) }};
+        runStats.MaxIndex = {{ static_cast<itk::IndexValueType>(x - 1), static_cast<itk::IndexValueType>(y), static_cast<itk::IndexValueType>(z) }};
+        runStats.IndexSum = {{ 0.5 * static_cast<double>(runLength) * static_cast<double>(runBegin + x - 1),
+                               static_cast<double>(runLength) * static_cast<double>(y),
+                               static_cast<double>(runLength) * static_cast<double>(z) }};
+
+        brick[lastEntry].Stats.Merge(runStats);
+      }
+    }
+  }
+
+  return brick;
+}
+
+void mitk::LabelStatisticsIndex::ScanBricks(const LabelValueType* volume, const std::vector<std::size_t>& brickIndices)
+{
+  if (brickIndices.empty())
+    return;
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(0, brickIndices.size(), [this, volume, &brickIndices](itk::SizeValueType i)
+  {
+    const auto brickIndex = brickIndices[i];
+    m_Bricks[brickIndex] = this->ScanBrick(volume, brickIndex);
+  }, nullptr);
+}
+
+void mitk::LabelStatisticsIndex::Scan(const LabelValueType* volume)
+{
+  std::vector<std::size_t> brickIndices(m_Bricks.size());
+
+  for (std::size_t i = 0; i < brickIndices.size(); ++i)
+    brickIndices[i] = i;
+
+  this->ScanBricks(volume, brickIndices);
+}
+
+void mitk::LabelStatisticsIndex::Rescan(const LabelValueType* volume, const RegionType& region)
+{
+  RegionType volumeRegion;
+  volumeRegion.SetSize({{ m_Dimensions[0], m_Dimensions[1], m_Dimensions[2] }});
+
+  auto cropped = region;
+
+  if (!cropped.Crop(volumeRegion))
+    return;
+
+  std::array<std::size_t, 3> beginBrick;
+  std::array<std::size_t, 3> endBrick;
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (0 == cropped.GetSize(i))
+      return;
+
+    beginBrick[i] = static_cast<std::size_t>(cropped.GetIndex(i)) / BrickSize;
+    endBrick[i] = static_cast<std::size_t>(cropped.GetUpperIndex()[i]) / BrickSize + 1;
+  }
+
+  std::vector<std::size_t> brickIndices;
+  brickIndices.reserve((endBrick[0] - beginBrick[0]) * (endBrick[1] - beginBrick[1]) * (endBrick[2] - beginBrick[2]));
+
+  for (std::size_t z = beginBrick[2]; z < endBrick[2]; ++z)
+  {
+    for (std::size_t y = beginBrick[1]; y < endBrick[1]; ++y)
+    {
+      for (std::size_t x = beginBrick[0]; x < endBrick[0]; ++x)
+        brickIndices.push_back((z * m_NumberOfBricks[1] + y) * m_NumberOfBricks[0] + x);
+    }
+  }
+
+  this->ScanBricks(volume, brickIndices);
+}
+
+mitk::LabelStatisticsIndex::Statistics mitk::LabelStatisticsIndex::GetStatistics(LabelValueType value) const
+{
+  Statistics result;
+
+  for (const auto& brick : m_Bricks)
+  {
+    for (const auto& entry : brick)
+    {
+      if (entry.Value == value)
+      {
+        result.Merge(entry.Stats);
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
+std::map<mitk::LabelStatisticsIndex::LabelValueType, mitk::LabelStatisticsIndex::Statistics> mitk::LabelStatisticsIndex::GetAllStatistics() const
+{
+  std::map<LabelValueType, Statistics> result;
+
+  for (const auto& brick : m_Bricks)
+  {
+    for (const auto& entry : brick)
+      result[entry.Value].Merge(entry.Stats);
+  }
+
+  return result;
+}
+
+void mitk::LabelStatisticsIndex::RemoveLabel(LabelValueType value)
+{
+  for (auto& brick : m_Bricks)
+  {
+    brick.erase(std::remove_if(brick.begin(), brick.end(), [value](const Entry& entry) { return entry.Value == value; }), brick.end());
+  }
+}
+
+void mitk::LabelStatisticsIndex::MergeLabel(LabelValueType targetValue, LabelValueType sourceValue)
+{
+  if (targetValue == sourceValue)
+    return;
+
+  if (0 == targetValue)
+  {
+    this->RemoveLabel(sourceValue);
+    return;
+  }
+
+  for (auto& brick : m_Bricks)
+  {
+    auto source = std::find_if(brick.begin(), brick.end(), [sourceValue](const Entry& entry) { return entry.Value == sourceValue; });
+
+    if (source == brick.end())
+      continue;
+
+    auto target = std::find_if(brick.begin(), brick.end(), [targetValue](const Entry& entry) { return entry.Value == targetValue; });
+
+    if (target == brick.end())
+    {
+      source->Value = targetValue;
+    }
+    else
+    {
+      target->Stats.Merge(source->Stats);
+      brick.erase(source);
+    }
+  }
+}
@@ -0,0 +1,99 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelStatisticsIndex_h
+#define mitkLabelStatisticsIndex_h
+
+#include <MitkMultilabelExports.h>
+#include <mitkLabel.h>
+#include <mitkPoint.h>
+
+#include <itkImageRegion.h>
+
+#include <array>
+#include <map>
+#include <vector>
+
+namespace mitk
+{
+  /**
+  * @brief Per label summary (voxel count, bounding box and centroid) of one volume of a group image.
+  *
+  * The volume is divided into bricks and the summary is kept per brick. Therefore a change of a region
+  * of the volume only requires to rescan the bricks intersecting this region (see Rescan()).
+  * Unlabeled voxels (value 0) are not recorded.
+  */
+  class MITKMULTILABEL_EXPORT LabelStatisticsIndex
+  {
+  public:
+    using LabelValueType = Label::PixelType;
+    using IndexType = itk::Index<3>;
+    using RegionType = itk::ImageRegion<3>;
+
+    struct MITKMULTILABEL_EXPORT Statistics
+    {
+      /** Number of voxels with the label value. All other members are only valid if VoxelCount > 0.*/
+      std::size_t VoxelCount = 0;
+      /** Bounding box of the voxels (inclusive).*/
+      IndexType MinIndex = {{0, 0, 0}};
+      IndexType MaxIndex = {{0, 0, 0}};
+      /** Sum of the indices of the voxels (used to compute the centroid).*/
+      std::array<double, 3> IndexSum = {{0.0, 0.0, 0.0}};
+
+      /** Returns the bounding box as region (empty if there are no voxels).*/
+      RegionType GetBoundingRegion() const;
+      /** Returns the centroid in index coordinates ((0,0,0) if there are no voxels).*/
+      Point3D GetCentroid() const;
+      /** Adds the voxels summarized by other.*/
+      void Merge(const Statistics& other);
+    };
+
+    /** @param dimensions Dimensions of the volume.*/
+    explicit LabelStatisticsIndex(const std::array<unsigned int, 3>& dimensions);
+
+    /** Computes the summary of the whole volume (bricks are processed in parallel).*/
+    void Scan(const LabelValueType* volume);
+
+    /** Recomputes the summary of all bricks intersecting the passed region of the volume.*/
+    void Rescan(const LabelValueType* volume, const RegionType& region);
+
+    /** Returns the statistics of a label value (VoxelCount is 0 if the value does not occur).*/
+    Statistics GetStatistics(LabelValueType value) const;
+
+    /** Returns the statistics of all label values that occur in the volume.*/
+    std::map<LabelValueType, Statistics> GetAllStatistics() const;
+
+    /** Updates the summary after all voxels of the value were set to 0.*/
+    void RemoveLabel(LabelValueType value);
+
+    /** Updates the summary after all voxels of sourceValue were set to targetValue.*/
+    void MergeLabel(LabelValueType targetValue, LabelValueType sourceValue);
+
+  private:
+    struct Entry
+    {
+      LabelValueType Value;
+      Statistics Stats;
+    };
+
+    using BrickType = std::vector<Entry>;
+
+    BrickType ScanBrick(const LabelValueType* volume, std::size_t brickIndex) const;
+    void ScanBricks(const LabelValueType* volume, const std::vector<std::size_t>& brickIndices);
+
+    std::array<unsigned int, 3> m_Dimensions;
+    std::array<unsigned int, 3> m_NumberOfBricks;
+    std::vector<BrickType> m_Bricks;
+  };
+}
+
+#endif
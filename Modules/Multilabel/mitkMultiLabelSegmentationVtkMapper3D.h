@@ -65,6 +65,9 @@ namespace mitk
 
     //### methods of MITK-VTK rendering pipeline
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
+
+    /** The volume rendering only depends on the node and its segmentation */
+    bool DependsOnOtherNodes() const override { return false; }
     //### end of methods of MITK-VTK rendering pipeline
 
     /** \brief Internal class holding the mapper, actor, etc. for each of the 3 2D render windows */
@@ -0,0 +1,222 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkStandardToftsModel.h>
+#include <mitkSquaredDifferencesFitCostFunction.h>
+#include <mitkTwoCompartmentExchangeModel.h>
+
+#include <itkLevenbergMarquardtOptimizer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  /** \brief Cost function evaluating the model like before the evaluation workspaces existed.
+   *
+   * Every evaluation allocates the signal and interpolates the AIF to the time grid of the model.
+   */
+  class AllocatingFitCostFunction : public mitk::SquaredDifferencesFitCostFunction
+  {
+  public:
+    typedef AllocatingFitCostFunction Self;
+    typedef itk::SmartPointer<Self> Pointer;
+
+    itkNewMacro(Self);
+
+    MeasureType GetValue(const ParametersType& parameter) const override
+    {
+      const SignalType signal = this->GetModel()->GetSignal(parameter);
+      return this->CalcMeasure(parameter, signal);
+    }
+  };
+
+  mitk::ModelBase::TimeGridType GenerateTimeGrid(unsigned int numberOfTimePoints)
+  {
+    mitk::ModelBase::TimeGridType grid(numberOfTimePoints);
+    for (unsigned int i = 0; i < numberOfTimePoints; ++i)
+      grid[i] = 3.0 * i;
+
+    return grid;
+  }
+
+  /** \brief Gamma variate bolus with a recirculation plateau, sampled on the given grid.
+   */
+  mitk::AIFBasedModelBase::AterialInputFunctionType GenerateAIF(const mitk::ModelBase::TimeGridType& grid)
+  {
+    mitk::AIFBasedModelBase::AterialInputFunctionType aif(grid.GetSize());
+    for (unsigned int i = 0; i < grid.GetSize(); ++i)
+    {
+      const double t = grid[i] / 60.0;
+      aif[i] = t < 0.2 ? 0.0 : 6.0 * (t - 0.2) * std::exp(-8.0 * (t - 0.2)) + 0.4 * (1.0 - std::exp(-2.0 * (t - 0.2)));
+    }
+
+    return aif;
+  }
+
+  struct Case
+  {
+    std::vector<mitk::ModelBase::ModelResultType> Signals;
+    mitk::ModelBase::ParametersType InitialParameters;
+  };
+
+  Case GenerateCase(const mitk::ModelBase* model,
+                    const mitk::ModelBase::ParametersType& parameters,
+                    unsigned int numberOfVoxels)
+  {
+    Case result;
+    result.InitialParameters = parameters;
+    for (unsigned int i = 0; i < parameters.GetSize(); ++i)
+      result.InitialParameters[i] *= 0.5;
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> variation(0.7, 1.3);
+    std::normal_distribution<double> noise(0.0, 0.002);
+
+    for (unsigned int voxel = 0; voxel < numberOfVoxels; ++voxel)
+    {
+      mitk::ModelBase::ParametersType voxelParameters = parameters;
+      for (unsigned int i = 0; i < voxelParameters.GetSize(); ++i)
+        voxelParameters[i] *= variation(generator);
+
+      mitk::ModelBase::ModelResultType signal = model->GetSignal(voxelParameters);
+      for (unsigned int i = 0; i < signal.GetSize(); ++i)
+        signal[i] += noise(generator);
+
+      result.Signals.push_back(signal);
+    }
+
+    return result;
+  }
+
+  /** \brief Fits all signals of the case like LevenbergMarquardtModelFitFunctor does and returns the
+   * fits per second. The fitted parameters are stored in results.
+   */
+  template <typename TCostFunction>
+  double Fit(const mitk::ModelBase* model,
+             const Case& fitCase,
+             std::vector<mitk::ModelBase::ParametersType>& results)
+  {
+    results.clear();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const auto& signal : fitCase.Signals)
+    {
+      auto costFunction = TCostFunction::New();
+      costFunction->SetModel(model);
+      costFunction->SetSample(signal);
+
+      ::itk::LevenbergMarquardtOptimizer::ScalesType scales(model->GetNumberOfParameters());
+      scales.Fill(1.0);
+
+      auto optimizer = ::itk::LevenbergMarquardtOptimizer::New();
+      optimizer->SetCostFunction(costFunction);
+      optimizer->SetEpsilonFunction(1e-5);
+      optimizer->SetGradientTolerance(1e-4);
+      optimizer->SetNumberOfIterations(1000);
+      optimizer->SetScales(scales);
+      optimizer->SetInitialPosition(fitCase.InitialParameters);
+      optimizer->StartOptimization();
+
+      results.push_back(optimizer->GetCurrentPosition());
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    return fitCase.Signals.size() / std::chrono::duration<double>(end - start).count();
+  }
+
+  bool Run(const std::string& name,
+           mitk::AIFBasedModelBase* model,
+           const mitk::ModelBase::ParametersType& parameters,
+           unsigned int numberOfVoxels,
+           unsigned int numberOfTimePoints)
+  {
+    const auto grid = GenerateTimeGrid(numberOfTimePoints);
+    model->SetTimeGrid(grid);
+    model->SetAterialInputFunctionTimeGrid(grid);
+    model->SetAterialInputFunctionValues(GenerateAIF(grid));
+
+    const Case fitCase = GenerateCase(model, parameters, numberOfVoxels);
+
+    std::vector<mitk::ModelBase::ParametersType> allocatingResults;
+    std::vector<mitk::ModelBase::ParametersType> workspaceResults;
+    const double allocatingFitsPerSecond = Fit<AllocatingFitCostFunction>(model, fitCase, allocatingResults);
+    const double workspaceFitsPerSecond = Fit<mitk::SquaredDifferencesFitCostFunction>(model, fitCase, workspaceResults);
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << allocatingFitsPerSecond << " fits/s" << std::setw(12) << workspaceFitsPerSecond
+              << " fits/s" << std::setw(8) << std::setprecision(2) << workspaceFitsPerSecond / allocatingFitsPerSecond
+              << "x" << std::endl;
+
+    // Both variants evaluate the same model function, so the fits have to end at the same parameters
+    for (std::size_t voxel = 0; voxel < allocatingResults.size(); ++voxel)
+    {
+      for (unsigned int i = 0; i < allocatingResults[voxel].GetSize(); ++i)
+      {
+        const double difference = std::abs(allocatingResults[voxel][i] - workspaceResults[voxel][i]);
+        if (difference > 1e-9 * std::max(1.0, std::abs(allocatingResults[voxel][i])))
+        {
+          std::cout << "  voxel " << voxel << ": parameter " << i << " differs (" << allocatingResults[voxel][i]
+                    << " vs. " << workspaceResults[voxel][i] << ")" << std::endl;
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+}
+
+/** \brief Compares the fits per second of AIF based models evaluated with allocating signals and with
+ * evaluation workspaces.
+ *
+ * Usage: MitkPharmacokineticsBenchmark [number of voxels] [number of time points]
+ */
+int main(int argc, char* argv[])
+{
+  const unsigned int numberOfVoxels = argc > 1 ? std::atoi(argv[1]) : 2000;
+  const unsigned int numberOfTimePoints = argc > 2 ? std::atoi(argv[2]) : 80;
+
+  std::cout << numberOfVoxels << " voxels x " << numberOfTimePoints << " time points" << std::endl;
+  std::cout << std::left << std::setw(28) << "model" << std::right << std::setw(19) << "allocating"
+            << std::setw(19) << "workspace" << std::setw(9) << "speedup" << std::endl;
+
+  bool success = true;
+
+  {
+    auto model = mitk::StandardToftsModel::New();
+    mitk::ModelBase::ParametersType parameters(model->GetNumberOfParameters());
+    parameters[mitk::StandardToftsModel::POSITION_PARAMETER_Ktrans] = 0.25;
+    parameters[mitk::StandardToftsModel::POSITION_PARAMETER_ve] = 0.3;
+    success &= Run("StandardToftsModel", model, parameters, numberOfVoxels, numberOfTimePoints);
+  }
+
+  {
+    auto model = mitk::TwoCompartmentExchangeModel::New();
+    mitk::ModelBase::ParametersType parameters(model->GetNumberOfParameters());
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_F] = 0.6;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_PS] = 0.15;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_ve] = 0.25;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_vp] = 0.05;
+    success &= Run("TwoCompartmentExchangeModel", model, parameters, numberOfVoxels, numberOfTimePoints);
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -24,6 +24,7 @@ found in the LICENSE file.
 #include <mitkPreferenceListReaderOptionsFunctor.h>
 
 #include <mitkModelFitCmdAppsHelper.h>
+#include <mitkModelFitBatchHelper.h>
 #include <mitkExtractTimeGrid.h>
 #include <mitkPixelBasedDescriptionParameterImageGenerator.h>
 
@@ -36,6 +37,7 @@ found in the LICENSE file.
 std::string inFilename;
 std::string outFileName;
 std::string maskFileName;
+std::string batchFileName;
 bool verbose(false);
 bool preview(false);
 mitk::Image::Pointer image;
@@ -70,14 +72,16 @@ void setupParser(mitkCommandLineParser& parser)
     // see mitkCommandLineParser::addArgument for more information
     parser.beginGroup("Required I/O parameters");
     parser.addArgument(
-        "input", "i", mitkCommandLineParser::File, "Input file", "input 3D+t image file", us::Any(), false, false, false, mitkCommandLineParser::Input);
+        "input", "i", mitkCommandLineParser::File, "Input file", "input 3D+t image file (not needed in batch mode)", us::Any(), true, false, false, mitkCommandLineParser::Input);
     parser.addArgument("output",
         "o",
         mitkCommandLineParser::File,
         "Output file template",
-        "where to save the output parameter images. The specified path will be used as template to determine the format (via extension) and the name \"root\". For each parameter a suffix will be added to the name.",
+        "where to save the output parameter images. The specified path will be used as template to determine the format (via extension) and the name \"root\". For each parameter a suffix will be added to the name. Not needed in batch mode.",
         us::Any(),
-        false, false, false, mitkCommandLineParser::Output);
+        true, false, false, mitkCommandLineParser::Output);
+    parser.addArgument(
+        "batch", "b", mitkCommandLineParser::File, "Batch case list", "CSV or JSON file that lists the cases of a batch run (one case per row/object). Columns: \"input\", \"output\" and optionally \"mask\". A missing mask is taken from the command line; all other settings apply to all cases. The next case is loaded while the current one is processed and results are stored in the background.", us::Any(), true, false, false, mitkCommandLineParser::Input);
     parser.endGroup();
 
     parser.beginGroup("Optional parameters");
@@ -114,8 +118,24 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
       preview = us::any_cast<bool>(parsedArgs["preview"]);
     }
 
-    inFilename = us::any_cast<std::string>(parsedArgs["input"]);
-    outFileName = us::any_cast<std::string>(parsedArgs["output"]);
+    if (parsedArgs.count("input"))
+    {
+        inFilename = us::any_cast<std::string>(parsedArgs["input"]);
+    }
+    if (parsedArgs.count("output"))
+    {
+        outFileName = us::any_cast<std::string>(parsedArgs["output"]);
+    }
+    if (parsedArgs.count("batch"))
+    {
+        batchFileName = us::any_cast<std::string>(parsedArgs["batch"]);
+    }
+
+    if (batchFileName.empty() && (inFilename.empty() || outFileName.empty()))
+    {
+        std::cerr << "Invalid program call. Please set 'input' and 'output' or a case list via 'batch'." << std::endl;
+        return false;
+    }
 
     return true;
 }
@@ -135,7 +155,8 @@ void ConfigureFunctor(mitk::CurveParameterFunctor* functor)
     functor->RegisterDescriptionParameter("TimeToPeak", parameterFunction);
 };
 
-void doDescription()
+/**Computes the descriptors of the current case. If a writer is passed, the results are stored by it in the background.*/
+void doDescription(mitk::BatchResultWriter* writer = nullptr)
 {
     mitk::PixelBasedDescriptionParameterImageGenerator::Pointer generator =
       mitk::PixelBasedDescriptionParameterImageGenerator::New();
@@ -155,9 +176,23 @@ void doDescription()
     generator->Generate();
     std::cout << std::endl << "Finished computation process" << std::endl;
 
-    for (auto imageIterator : generator->GetParameterImages())
+    const std::string outputPath = outFileName;
+    const auto parameterImages = generator->GetParameterImages();
+    auto storeResults = [outputPath, parameterImages]()
     {
-        mitk::storeParameterResultImage(outFileName, imageIterator.first, imageIterator.second);
+        for (auto imageIterator : parameterImages)
+        {
+            mitk::storeParameterResultImage(outputPath, imageIterator.first, imageIterator.second);
+        }
+    };
+
+    if (writer)
+    {
+        writer->Enqueue(storeResults);
+    }
+    else
+    {
+        storeResults();
     }
 }
 
@@ -175,6 +210,50 @@ void doPreview()
   }
 }
 
+/**Computes the descriptors of the passed case. If a writer is passed, the results are stored by it in the background.*/
+void processCase(const mitk::ModelFitBatchCaseData& caseData, mitk::BatchResultWriter* writer)
+{
+    outFileName = caseData.outputFileName;
+    image = caseData.image;
+    mask = caseData.mask;
+
+    std::cout << "Input: " << caseData.inputFileName << std::endl;
+
+    if (mask.IsNotNull())
+    {
+        std::cout << "Mask:  " << caseData.maskFileName << std::endl;
+    }
+    else
+    {
+        std::cout << "Mask:  none" << std::endl;
+    }
+
+    doDescription(writer);
+}
+
+/**Processes all cases of the batch case list. Returns the number of failed cases.*/
+unsigned int doBatch(mitk::PreferenceListReaderOptionsFunctor* readerFilterFunctor)
+{
+    if (preview)
+    {
+        const mitk::BatchCaseList cases = mitk::readBatchCaseList(batchFileName);
+        std::cout << "Batch: " << batchFileName << " (" << cases.size() << " cases)" << std::endl;
+
+        for (const auto& batchCase : cases)
+        {
+            outFileName = mitk::getBatchCaseValue(batchCase, "output");
+            doPreview();
+        }
+        return 0;
+    }
+
+    mitk::ModelFitBatchCaseData defaults;
+    defaults.maskFileName = maskFileName;
+
+    return mitk::processModelFitBatch(batchFileName, defaults, false, readerFilterFunctor,
+        [](const mitk::BatchCase&, const mitk::ModelFitBatchCaseData& caseData, mitk::BatchResultWriter& writer) { processCase(caseData, &writer); });
+}
+
 int main(int argc, char* argv[])
 {
     mitkCommandLineParser parser;
@@ -198,26 +277,23 @@ int main(int argc, char* argv[])
     //! [do processing]
     try
     {
+      if (!batchFileName.empty())
+      {
+        return doBatch(&readerFilterFunctor) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+      }
+
       if (preview)
       {
         doPreview();
       }
       else
       {
-        image = mitk::IOUtil::Load<mitk::Image>(inFilename, &readerFilterFunctor);
-        std::cout << "Input: " << inFilename << std::endl;
-
-        if (!maskFileName.empty())
-        {
-          mask = mitk::IOUtil::Load<mitk::Image>(maskFileName, &readerFilterFunctor);
-          std::cout << "Mask:  " << maskFileName << std::endl;
-        }
-        else
-        {
-          std::cout << "Mask:  none" << std::endl;
-        }
+        mitk::ModelFitBatchCaseData caseData;
+        caseData.inputFileName = inFilename;
+        caseData.outputFileName = outFileName;
+        caseData.maskFileName = maskFileName;
 
-        doDescription();
+        processCase(mitk::loadModelFitBatchCase(caseData, nullptr, false, &readerFilterFunctor), nullptr);
       }
 
       std::cout << "Processing finished." << std::endl;
@@ -30,12 +30,14 @@ found in the LICENSE file.
 #include <mitkROIBasedParameterFitImageGenerator.h>
 #include <mitkModelFitInfo.h>
 #include <mitkModelFitCmdAppsHelper.h>
+#include <mitkModelFitBatchHelper.h>
 
 #include <mitkMaskedDynamicImageStatisticsGenerator.h>
 #include <mitkLevenbergMarquardtModelFitFunctor.h>
 #include <mitkNormalizedSumOfSquaredDifferencesFitCostFunction.h>
 #include <mitkExtractTimeGrid.h>
 #include <mitkAterialInputFunctionGenerator.h>
+#include <mitkConcentrationCurveGenerator.h>
 #include <mitkModelFitResultHelper.h>
 #include <mitkDescriptivePharmacokineticBrixModelParameterizer.h>
 #include <mitkDescriptivePharmacokineticBrixModelValueBasedParameterizer.h>
@@ -55,6 +57,8 @@ std::string outFileName;
 std::string maskFileName;
 std::string aifMaskFileName;
 std::string aifImageFileName;
+std::string concentrationFileName;
+std::string batchFileName;
 
 mitk::Image::Pointer image;
 mitk::Image::Pointer mask;
@@ -66,6 +70,22 @@ bool verbose(false);
 bool roibased(false);
 bool preview(false);
 
+bool t1_absolute(false);
+bool t1_relative(false);
+bool t2(false);
+float conversionK(1.0);
+float conversionTE(0);
+/**Indicates if the signal is converted voxel by voxel while fitting (true) or if the concentration images are
+generated before the fitting (false).*/
+bool streamConversion(false);
+
+/**Key of the AIF of the current case (AIF image and AIF mask file). Empty if the AIF is taken from the signal image.
+In batch mode the AIF is only computed once for all consecutive cases that share the same key.*/
+std::string aifKey;
+std::string cachedAIFKey;
+mitk::AIFBasedModelBase::AterialInputFunctionType cachedAIF;
+mitk::AIFBasedModelBase::AterialInputFunctionType cachedAIFTimeGrid;
+
 std::string modelName;
 
 float aifHematocritLevel(0);
@@ -94,7 +114,7 @@ void setupParser(mitkCommandLineParser& parser)
     // set general information about your MiniApp
     parser.setCategory("Dynamic Data Analysis Tools");
     parser.setTitle("MR Perfusion");
-    parser.setDescription("MiniApp that allows to fit MRI perfusion models and generates the according parameter maps. IMPORTANT!!!: The app assumes that the input images (signal and AIF) are concentration images. If your images do not hold this assumption, convert the image date before using this app (e.g. by using the signal-to-concentration-converter mini app.");
+    parser.setDescription("MiniApp that allows to fit MRI perfusion models and generates the according parameter maps. IMPORTANT!!!: The app assumes that the input images (signal and AIF) are concentration images, unless a conversion mode (t1-absolute, t1-relative or t2) is selected. If a conversion mode is selected, the signal of each voxel is converted into concentration right before it is fitted, so the concentration image is not generated (except for ROI based fits, the descriptive Brix model or if the concentration image should be stored).");
     parser.setContributor("DKFZ MIC");
     //! [create parser]
 
@@ -111,14 +131,16 @@ void setupParser(mitkCommandLineParser& parser)
     parser.endGroup();
     parser.beginGroup("Required I/O parameters");
     parser.addArgument(
-        "input", "i", mitkCommandLineParser::File, "Input file", "input 3D+t image file", us::Any(), false, false, false, mitkCommandLineParser::Input);
+        "input", "i", mitkCommandLineParser::File, "Input file", "input 3D+t image file (not needed in batch mode)", us::Any(), true, false, false, mitkCommandLineParser::Input);
     parser.addArgument("output",
         "o",
         mitkCommandLineParser::File,
         "Output file template",
-        "where to save the output parameter images. The specified path will be used as template to determine the format (via extension) and the name \"root\". For each parameter a suffix will be added to the name.",
+        "where to save the output parameter images. The specified path will be used as template to determine the format (via extension) and the name \"root\". For each parameter a suffix will be added to the name. Not needed in batch mode.",
         us::Any(),
-        false, false, false, mitkCommandLineParser::Output);
+        true, false, false, mitkCommandLineParser::Output);
+    parser.addArgument(
+        "batch", "b", mitkCommandLineParser::File, "Batch case list", "CSV or JSON file that lists the cases of a batch run (one case per row/object). Columns: \"input\", \"output\" and optionally \"mask\", \"aifmask\", \"aifimage\" and \"concentration-output\". Missing mask and AIF files are taken from the command line. If \"concentration-output\" is missing but set on the command line, the concentration image of a case is stored next to its output (suffix \"_concentration\"). All other settings apply to all cases. The next case is loaded while the current one is fitted and results are stored in the background.", us::Any(), true, false, false, mitkCommandLineParser::Input);
     parser.endGroup();
 
     parser.beginGroup("AIF parameters");
@@ -130,6 +152,21 @@ void setupParser(mitkCommandLineParser& parser)
       "hematocrit", "h", mitkCommandLineParser::Float, "Hematocrit Level", "Value needed for correct AIF computation. Only needed if model needs an AIF. Default value is 0.45.", us::Any(0.45));
     parser.endGroup();
 
+    parser.beginGroup("Conversion parameters");
+    parser.addArgument(
+      "t1-absolute", "", mitkCommandLineParser::Bool, "T1 absolute signal enhancement", "Activate conversion for T1 absolute signal enhancement.");
+    parser.addArgument(
+      "t1-relative", "", mitkCommandLineParser::Bool, "T1 relative signal enhancement", "Activate conversion for T1 relative signal enhancement.");
+    parser.addArgument(
+      "t2", "", mitkCommandLineParser::Bool, "T2 signal conversion", "Activate conversion for T2 signal enhancement to concentration.");
+    parser.addArgument(
+      "k", "k", mitkCommandLineParser::Float, "Conversion factor k", "Needed for the following conversion modes: T1-absolute, T1-relative, T2. Default value is 1.", us::Any(1));
+    parser.addArgument(
+      "te", "", mitkCommandLineParser::Float, "Echo time TE", "Needed for the following conversion modes: T2.", us::Any(1));
+    parser.addArgument(
+      "concentration-output", "", mitkCommandLineParser::File, "Concentration output file", "If set, the concentration image is generated and stored at the given path. Otherwise the signal is converted voxel by voxel while fitting. Only used if a conversion mode is selected.", us::Any(), true, false, false, mitkCommandLineParser::Output);
+    parser.endGroup();
+
     parser.beginGroup("Optional parameters");
     parser.addArgument(
         "mask", "m", mitkCommandLineParser::File, "Mask file", "Mask that defines the spatial image region that should be fitted. Must have the same geometry as the input image!", us::Any(), true, false, false, mitkCommandLineParser::Input);
@@ -158,8 +195,20 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
       modelName = us::any_cast<std::string>(parsedArgs["model"]);
     }
 
-    inFilename = us::any_cast<std::string>(parsedArgs["input"]);
-    outFileName = us::any_cast<std::string>(parsedArgs["output"]);
+    if (parsedArgs.count("input"))
+    {
+      inFilename = us::any_cast<std::string>(parsedArgs["input"]);
+    }
+
+    if (parsedArgs.count("output"))
+    {
+      outFileName = us::any_cast<std::string>(parsedArgs["output"]);
+    }
+
+    if (parsedArgs.count("batch"))
+    {
+      batchFileName = us::any_cast<std::string>(parsedArgs["batch"]);
+    }
 
     if (parsedArgs.count("mask"))
     {
@@ -211,6 +260,66 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
     {
       brixInjectionTime = us::any_cast<float>(parsedArgs["injectiontime"]);
     }
+
+    t1_absolute = false;
+    if (parsedArgs.count("t1-absolute"))
+    {
+      t1_absolute = us::any_cast<bool>(parsedArgs["t1-absolute"]);
+    }
+
+    t1_relative = false;
+    if (parsedArgs.count("t1-relative"))
+    {
+      t1_relative = us::any_cast<bool>(parsedArgs["t1-relative"]);
+    }
+
+    t2 = false;
+    if (parsedArgs.count("t2"))
+    {
+      t2 = us::any_cast<bool>(parsedArgs["t2"]);
+    }
+
+    conversionK = 1.0;
+    if (parsedArgs.count("k"))
+    {
+      conversionK = us::any_cast<float>(parsedArgs["k"]);
+    }
+
+    conversionTE = 0.0;
+    if (parsedArgs.count("te"))
+    {
+      conversionTE = us::any_cast<float>(parsedArgs["te"]);
+    }
+
+    if (parsedArgs.count("concentration-output"))
+    {
+      concentrationFileName = us::any_cast<std::string>(parsedArgs["concentration-output"]);
+    }
+
+    //consistency checks
+    int modeCount = 0;
+    if (t1_absolute) ++modeCount;
+    if (t1_relative) ++modeCount;
+    if (t2) ++modeCount;
+
+    if (modeCount > 1)
+    {
+      std::cerr << "Invalid program call. Please select only one conversion mode." << std::endl;
+      return false;
+    }
+
+    if (t2 && !parsedArgs.count("te"))
+    {
+      std::cerr << "Invalid program call. Please set 'te', if you use t2 mode." << std::endl;
+      return false;
+    }
+
+    if (batchFileName.empty() && (inFilename.empty() || outFileName.empty()))
+    {
+      std::cerr << "Invalid program call. Please set 'input' and 'output' or a case list via 'batch'." << std::endl;
+      return false;
+    }
+
     return true;
 }
 
@@ -241,6 +350,46 @@ mitk::ModelFitFunctorBase::Pointer createDefaultFitFunctor(
     return fitFunctor.GetPointer();
 }
 
+bool isConversionSelected()
+{
+  return t1_absolute || t1_relative || t2;
+}
+
+/**Helper that creates a concentration curve generator for the passed signal image according to the
+selected conversion mode.*/
+mitk::ConcentrationCurveGenerator::Pointer createConcentrationGenerator(const mitk::Image* signalImage)
+{
+  mitk::ConcentrationCurveGenerator::Pointer concentrationGen =
+    mitk::ConcentrationCurveGenerator::New();
+  concentrationGen->SetDynamicImage(signalImage);
+
+  concentrationGen->SetAbsoluteSignalEnhancement(t1_absolute);
+  concentrationGen->SetRelativeSignalEnhancement(t1_relative);
+
+  concentrationGen->SetisT2weightedImage(t2);
+
+  if (t2)
+  {
+    concentrationGen->SetT2Factor(conversionK);
+    concentrationGen->SetT2EchoTime(conversionTE);
+  }
+  else
+  {
+    concentrationGen->SetFactor(conversionK);
+  }
+
+  return concentrationGen;
+}
+
+/**Helper that sets the signal converter of a pixel based fit generator, if the conversion is streamed.*/
+void setSignalConverter(mitk::PixelBasedParameterFitImageGenerator* fitGenerator)
+{
+  if (streamConversion)
+  {
+    fitGenerator->SetSignalConverter(createConcentrationGenerator(image));
+  }
+}
+
 /**Helper that ensures that the mask (if it exists) is always 3D image. If the mask is originally an 4D image, the first
 time step will be used.*/
 mitk::Image::Pointer getMask3D()
@@ -270,6 +419,14 @@ mitk::Image::Pointer getMask3D()
 void getAIF(mitk::AIFBasedModelBase::AterialInputFunctionType& aif,
   mitk::AIFBasedModelBase::AterialInputFunctionType& aifTimeGrid)
 {
+  if (!aifKey.empty() && aifKey == cachedAIFKey)
+  {
+    aif = cachedAIF;
+    aifTimeGrid = cachedAIFTimeGrid;
+    std::cout << "AIF: reused from previous case" << std::endl;
+    return;
+  }
+
   if (aifMask.IsNotNull())
   {
     aif.clear();
@@ -306,8 +463,17 @@ void getAIF(mitk::AIFBasedModelBase::AterialInputFunctionType& aif,
 
     aifGenerator->SetDynamicImage(selectedAIFImage);
 
+    if (streamConversion)
+    {
+      aifGenerator->SetSignalConverter(createConcentrationGenerator(selectedAIFImage));
+    }
+
     aif = aifGenerator->GetAterialInputFunction();
     aifTimeGrid = aifGenerator->GetAterialInputFunctionTimeGrid();
+
+    cachedAIFKey = aifKey;
+    cachedAIF = aif;
+    cachedAIFTimeGrid = aifTimeGrid;
   }
   else
   {
@@ -357,6 +523,7 @@ void generateDescriptiveBrixModel_PixelBased(mitk::modelFit::ModelFitInfo::Point
 
   fitGenerator->SetDynamicImage(image);
   fitGenerator->SetFitFunctor(fitFunctor);
+  setSignalConverter(fitGenerator);
 
   generator = fitGenerator.GetPointer();
 
@@ -451,6 +618,7 @@ void GenerateLinearModelFit_PixelBased(mitk::modelFit::ModelFitInfo::Pointer&
 
   fitGenerator->SetDynamicImage(image);
   fitGenerator->SetFitFunctor(fitFunctor);
+  setSignalConverter(fitGenerator);
 
   generator = fitGenerator.GetPointer();
 
@@ -549,6 +717,7 @@ void generateAIFbasedModelFit_PixelBased(mitk::modelFit::ModelFitInfo::Pointer&
 
   fitGenerator->SetDynamicImage(image);
   fitGenerator->SetFitFunctor(fitFunctor);
+  setSignalConverter(fitGenerator);
 
   generator = fitGenerator.GetPointer();
 
@@ -743,7 +912,8 @@ void createFitGenerator(mitk::modelFit::ModelFitInfo::Pointer& fitSession, mitk:
   }
 }
 
-void doFitting()
+/**Fits the current case. If a writer is passed, the results are stored by it in the background.*/
+void doFitting(mitk::BatchResultWriter* writer = nullptr)
 {
         mitk::ParameterFitImageGeneratorBase::Pointer generator = nullptr;
         mitk::modelFit::ModelFitInfo::Pointer fitSession = nullptr;
@@ -760,7 +930,15 @@ void doFitting()
             generator->Generate();
             std::cout << std::endl << "Finished fitting process" << std::endl;
 
-            mitk::storeModelFitGeneratorResults(outFileName, generator, fitSession);
+            if (writer)
+            {
+              const std::string outputPath = outFileName;
+              writer->Enqueue([outputPath, generator, fitSession]() { mitk::storeModelFitGeneratorResults(outputPath, generator, fitSession); });
+            }
+            else
+            {
+              mitk::storeModelFitGeneratorResults(outFileName, generator, fitSession);
+            }
         }
         else
         {
@@ -785,6 +963,139 @@ void doPreview()
   }
 }
 
+bool needsAIF()
+{
+  return modelName != MODEL_NAME_descriptive && modelName != MODEL_NAME_3SL && MODEL_NAME_2SL != modelName;
+}
+
+/**Converts (if selected) and fits the passed case. If a writer is passed, all results are stored by it in the background.*/
+void processCase(const mitk::ModelFitBatchCaseData& caseData, mitk::BatchResultWriter* writer)
+{
+  outFileName = caseData.outputFileName;
+  image = caseData.image;
+  mask = caseData.mask;
+  aifMask = caseData.aifMask;
+  aifImage = caseData.aifImage;
+  aifKey = caseData.aifImageFileName.empty() ? std::string() : caseData.aifImageFileName + "|" + caseData.aifMaskFileName;
+
+  std::cout << "Input: " << caseData.inputFileName << std::endl;
+
+  if (mask.IsNotNull())
+  {
+    std::cout << "Mask:  " << caseData.maskFileName << std::endl;
+  }
+  else
+  {
+    std::cout << "Mask:  none" << std::endl;
+  }
+
+  if (needsAIF())
+  {
+    std::cout << "AIF mask:  " << caseData.aifMaskFileName << std::endl;
+    if (aifImage.IsNotNull())
+    {
+      std::cout << "AIF image:  " << caseData.aifImageFileName << std::endl;
+    }
+    else
+    {
+      std::cout << "AIF image: none (using signal image)" << std::endl;
+    }
+  }
+
+  if (roibased && mask.IsNull())
+  {
+    mitkThrow() << "Error. Cannot fit. Please specify mask if you select roi based fitting.";
+  }
+
+  if (isConversionSelected())
+  {
+    // The descriptive Brix model and ROI based fits need the concentration image itself (base image or ROI signal)
+    streamConversion = concentrationFileName.empty() && !roibased && modelName != MODEL_NAME_descriptive;
+
+    if (streamConversion)
+    {
+      std::cout << "Conversion: signal is converted voxel by voxel while fitting" << std::endl;
+    }
+    else
+    {
+      image = createConcentrationGenerator(image)->GetConvertedImage();
+      if (aifImage.IsNotNull())
+      {
+        aifImage = createConcentrationGenerator(aifImage)->GetConvertedImage();
+      }
+
+      if (!concentrationFileName.empty() && !preview)
+      {
+        const mitk::Image::Pointer concentrationImage = image;
+        const std::string concentrationPath = concentrationFileName;
+        auto storeConcentration = [concentrationImage, concentrationPath]()
+        {
+          mitk::IOUtil::Save(concentrationImage, concentrationPath);
+          std::cout << "Store concentration image: " << concentrationPath << std::endl;
+        };
+
+        if (writer)
+        {
+          writer->Enqueue(storeConcentration);
+        }
+        else
+        {
+          storeConcentration();
+        }
+      }
+      else
+      {
+        std::cout << "Conversion: concentration image is generated before fitting" << std::endl;
+      }
+    }
+  }
+
+  std::cout << "Style: ";
+  if (roibased)
+  {
+    std::cout << "ROI based";
+  }
+  else
+  {
+    std::cout << "pixel based";
+  }
+  std::cout << std::endl;
+
+  if (preview)
+  {
+    doPreview();
+  }
+  else
+  {
+    doFitting(writer);
+  }
+}
+
+/**Processes all cases of the batch case list. Returns the number of failed cases.*/
+unsigned int doBatch(mitk::PreferenceListReaderOptionsFunctor* readerFilterFunctor)
+{
+  mitk::ModelFitBatchCaseData defaults;
+  defaults.maskFileName = maskFileName;
+  defaults.aifMaskFileName = aifMaskFileName;
+  defaults.aifImageFileName = aifImageFileName;
+
+  // The concentration output of the command line applies to all cases; each case stores its own image next to its output
+  const bool storeConcentration = !concentrationFileName.empty();
+
+  auto processBatchCase = [storeConcentration](const mitk::BatchCase& batchCase, const mitk::ModelFitBatchCaseData& caseData, mitk::BatchResultWriter& writer)
+  {
+    concentrationFileName = mitk::getBatchCaseValue(batchCase, "concentration-output");
+    if (concentrationFileName.empty() && storeConcentration)
+    {
+      concentrationFileName = mitk::generateModelFitResultImagePath(caseData.outputFileName, "concentration");
+    }
+
+    processCase(caseData, &writer);
+  };
+
+  return mitk::processModelFitBatch(batchFileName, defaults, needsAIF(), readerFilterFunctor, processBatchCase);
+}
+
 int main(int argc, char* argv[])
 {
     mitkCommandLineParser parser;
@@ -808,65 +1119,19 @@ int main(int argc, char* argv[])
     //! [do processing]
     try
     {
-		image = mitk::IOUtil::Load<mitk::Image>(inFilename, &readerFilterFunctor);
-        std::cout << "Input: " << inFilename << std::endl;
-
-        if (!maskFileName.empty())
+        if (!batchFileName.empty())
         {
-			mask = mitk::IOUtil::Load<mitk::Image>(maskFileName, &readerFilterFunctor);
-            std::cout << "Mask:  " << maskFileName << std::endl;
-        }
-        else
-        {
-            std::cout << "Mask:  none" << std::endl;
-        }
-
-        if (modelName != MODEL_NAME_descriptive && modelName != MODEL_NAME_3SL && MODEL_NAME_2SL != modelName)
-        {
-          if (!aifMaskFileName.empty())
-          {
-            aifMask = mitk::IOUtil::Load<mitk::Image>(aifMaskFileName, &readerFilterFunctor);
-            std::cout << "AIF mask:  " << aifMaskFileName << std::endl;
-          }
-          else
-          {
-            mitkThrow() << "Error. Cannot fit. Chosen model needs an AIF. Please specify AIF mask (--aifmask).";
-          }
-          if (!aifImageFileName.empty())
-          {
-   	        aifImage = mitk::IOUtil::Load<mitk::Image>(aifImageFileName, &readerFilterFunctor);
-            std::cout << "AIF image:  " << aifImageFileName << std::endl;
-          }
-          else
-          {
-            std::cout << "AIF image: none (using signal image)" << std::endl;
-          }
+          return doBatch(&readerFilterFunctor) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
         }
 
-        if (roibased && mask.IsNull())
-        {
-            mitkThrow() << "Error. Cannot fit. Please specify mask if you select roi based fitting.";
-        }
+        mitk::ModelFitBatchCaseData caseData;
+        caseData.inputFileName = inFilename;
+        caseData.outputFileName = outFileName;
+        caseData.maskFileName = maskFileName;
+        caseData.aifMaskFileName = aifMaskFileName;
+        caseData.aifImageFileName = aifImageFileName;
 
-        std::cout << "Style: ";
-        if (roibased)
-        {
-            std::cout << "ROI based";
-        }
-        else
-        {
-            std::cout << "pixel based";
-        }
-        std::cout << std::endl;
-
-        if (preview)
-        {
-          doPreview();
-        }
-        else
-        {
-          doFitting();
-        }
+        processCase(mitk::loadModelFitBatchCase(caseData, nullptr, needsAIF(), &readerFilterFunctor), nullptr);
 
         std::cout << "Processing finished." << std::endl;
 
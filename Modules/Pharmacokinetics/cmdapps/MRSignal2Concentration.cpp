@@ -26,9 +26,11 @@ found in the LICENSE file.
 #include <mitkPreferenceListReaderOptionsFunctor.h>
 
 #include <mitkConcentrationCurveGenerator.h>
+#include <mitkModelFitBatchHelper.h>
 
 std::string inFilename;
 std::string outFileName;
+std::string batchFileName;
 
 mitk::Image::Pointer image;
 
@@ -60,14 +62,16 @@ void setupParser(mitkCommandLineParser& parser)
     // see mitkCommandLineParser::addArgument for more information
     parser.beginGroup("Required I/O parameters");
     parser.addArgument(
-        "input", "i", mitkCommandLineParser::File, "Input file", "input 3D+t image file", us::Any(), false, false, false, mitkCommandLineParser::Input);
+        "input", "i", mitkCommandLineParser::File, "Input file", "input 3D+t image file (not needed in batch mode)", us::Any(), true, false, false, mitkCommandLineParser::Input);
     parser.addArgument("output",
         "o",
         mitkCommandLineParser::File,
         "Output file",
-        "where to save the output concentration image.",
+        "where to save the output concentration image. Not needed in batch mode.",
         us::Any(),
-        false, false, false, mitkCommandLineParser::Output);
+        true, false, false, mitkCommandLineParser::Output);
+    parser.addArgument(
+        "batch", "b", mitkCommandLineParser::File, "Batch case list", "CSV or JSON file that lists the cases of a batch run (one case per row/object). Columns: \"input\" and \"output\". All other settings apply to all cases. The next case is loaded while the current one is converted and results are stored in the background.", us::Any(), true, false, false, mitkCommandLineParser::Input);
     parser.endGroup();
 
     parser.beginGroup("Conversion parameters");
@@ -102,8 +106,18 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
     if (parsedArgs.size() == 0)
         return false;
 
-    inFilename = us::any_cast<std::string>(parsedArgs["input"]);
-    outFileName = us::any_cast<std::string>(parsedArgs["output"]);
+    if (parsedArgs.count("input"))
+    {
+        inFilename = us::any_cast<std::string>(parsedArgs["input"]);
+    }
+    if (parsedArgs.count("output"))
+    {
+        outFileName = us::any_cast<std::string>(parsedArgs["output"]);
+    }
+    if (parsedArgs.count("batch"))
+    {
+        batchFileName = us::any_cast<std::string>(parsedArgs["batch"]);
+    }
 
     verbose = false;
     if (parsedArgs.count("verbose"))
@@ -186,11 +200,17 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
       mitkThrow() << "Invalid program call. Please set 'te', if you use t2 mode.";
     }
 
+    if (batchFileName.empty() && (inFilename.empty() || outFileName.empty()))
+    {
+      mitkThrow() << "Invalid program call. Please set 'input' and 'output' or a case list via 'batch'.";
+    }
+
 
     return true;
 }
 
-void doConversion()
+/**Converts the current image. If a writer is passed, the result is stored by it in the background.*/
+void doConversion(mitk::BatchResultWriter* writer = nullptr)
 {
     mitk::ConcentrationCurveGenerator::Pointer concentrationGen =
       mitk::ConcentrationCurveGenerator::New();
@@ -214,9 +234,37 @@ void doConversion()
 
     mitk::Image::Pointer concentrationImage = concentrationGen->GetConvertedImage();
 
-    mitk::IOUtil::Save(concentrationImage, outFileName);
+    const std::string outputPath = outFileName;
+    auto storeResult = [concentrationImage, outputPath]()
+    {
+        mitk::IOUtil::Save(concentrationImage, outputPath);
+
+        std::cout << "Store result: " << outputPath << std::endl;
+    };
 
-    std::cout << "Store result: " << outFileName << std::endl;
+    if (writer)
+    {
+        writer->Enqueue(storeResult);
+    }
+    else
+    {
+        storeResult();
+    }
+}
+
+/**Converts all cases of the batch case list. Returns the number of failed cases.*/
+unsigned int doBatch(mitk::PreferenceListReaderOptionsFunctor* readerFilterFunctor)
+{
+    auto processBatchCase = [](const mitk::BatchCase&, const mitk::ModelFitBatchCaseData& caseData, mitk::BatchResultWriter& writer)
+    {
+        outFileName = caseData.outputFileName;
+        image = caseData.image;
+        std::cout << "Input: " << caseData.inputFileName << std::endl;
+
+        doConversion(&writer);
+    };
+
+    return mitk::processModelFitBatch(batchFileName, mitk::ModelFitBatchCaseData(), false, readerFilterFunctor, processBatchCase);
 }
 
 int main(int argc, char* argv[])
@@ -259,6 +307,11 @@ int main(int argc, char* argv[])
     //! [do processing]
     try
     {
+        if (!batchFileName.empty())
+        {
+            return doBatch(&readerFilterFunctor) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
         image = mitk::IOUtil::Load<mitk::Image>(inFilename, &readerFilterFunctor);
         std::cout << "Input: " << inFilename << std::endl;
 
@@ -84,6 +84,10 @@ namespace mitk
      * if currentTimeGrid.Size() = 0 , the Original AIF will be returned*/
     const AterialInputFunctionType GetAterialInputFunction(TimeGridType currentTimeGrid) const;
 
+    /** Returns the Aterial Input Function matching the model time grid, like GetAterialInputFunction(GetTimeGrid()).
+     * The interpolated values are cached in the workspace and only recomputed if the model was modified.*/
+    const AterialInputFunctionType& GetAterialInputFunction(ModelEvaluationWorkspace& workspace) const;
+
     ParameterNamesType GetStaticParameterNames() const override;
     ParametersSizeType GetNumberOfStaticParameters() const override;
     ParamterUnitMapType GetStaticParameterUnits() const override;
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <mitkImage.h>
 #include "mitkAIFBasedModelBase.h"
+#include "mitkSignalConverterBase.h"
 #include "MitkPharmacokineticsExports.h"
 
 
@@ -29,6 +30,8 @@ namespace mitk
   * and the resulting image is fed into the Generator.
   * The generator checks whether both image and mask  are set and passes them to the itkMaskedNaryStatisticsImageFilter and the mitkExtractTimeGrid, to
   * calculate the mean of every time slice within the ROI and extract the corresponding time grid from the date set.
+  * If a signal converter is set, the dynamic image is expected to contain signals. Then the curve of every voxel within the ROI is
+  * converted (e.g. by a ConcentrationCurveGenerator) and the mean of the converted curves is used.
   */
   class MITKPHARMACOKINETICS_EXPORT AterialInputFunctionGenerator : public itk::Object
   {
@@ -47,6 +50,11 @@ namespace mitk
     itkSetConstObjectMacro(Mask, Image);
     itkGetConstObjectMacro(Mask, Image);
 
+    /** @brief Setter and Getter for the optional converter that is applied to the curve of every voxel in the mask before
+    * the mean is computed. If not set (default), the dynamic image has to be converted already.*/
+    itkSetObjectMacro(SignalConverter, SignalConverterBase);
+    itkGetObjectMacro(SignalConverter, SignalConverterBase);
+
     /** @brief Setter and Getter for the hematocritlevel, important for conversion to plasma curve*/
     itkSetMacro(HCL, double);
     itkGetConstReferenceMacro(HCL, double);
@@ -79,6 +87,10 @@ namespace mitk
     //template <typename TPixel, unsigned int VDim>
     //void DoCalculateAIF(itk::Image<TPixel, VDim>* image);
 
+    /** @brief Computes the mean of the converted curves of all voxels within the mask and stores it in m_ConvertedMean*/
+    template <typename TPixel, unsigned int VDim>
+    void DoCalculateConvertedMean(const itk::Image<TPixel, VDim>* image);
+
     /** @brief Passes m_DynamicImage and m_Mask to the itkMaskedNaryStatisticsImageFilter and mitkExtractTimeGrid
      * and inserts the result into m_AIFValues and m_AIFTimeGrid and modiefies the Timestamp*/
     virtual void CalculateAIFAndGetResult();
@@ -94,7 +106,9 @@ namespace mitk
   private:
     Image::ConstPointer m_DynamicImage;
     Image::ConstPointer m_Mask;
+    SignalConverterBase::Pointer m_SignalConverter;
 
+    SignalConverterBase::SignalType m_ConvertedMean;
 
     AIFBasedModelBase::AterialInputFunctionType m_AIFValues;
     ModelBase::TimeGridType m_AIFTimeGrid;
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #define mitkConcentrationCurveGenerator_h
 
 #include <mitkImage.h>
+#include <mitkSignalConverterBase.h>
 #include <itkBinaryFunctorImageFilter.h>
 #include "mitkConvertToConcentrationAbsoluteFunctor.h"
 #include "mitkConvertToConcentrationRelativeFunctor.h"
@@ -27,12 +28,16 @@ namespace mitk {
 * From a given 4D image, the Generator takes the 3D image of the first time point as baseline image. It then loops over all time steps, casts
 * the current 3D image to itk and passes it to the ConvertToconcentrationFunctor. The returned 3D image has now values of concentration type and is stored at its timepoint
 * in the return image.
+*
+* The generator can also be used as signal converter of a pixel based fit (see PixelBasedParameterFitImageGenerator::SetSignalConverter()).
+* Then each voxel curve is converted by ConvertSignal() right before it is fitted, so the converted 4D image never has to be generated.
+* The baseline of a voxel is computed from its own curve in the same way as for GetConvertedImage().
 */
-class MITKPHARMACOKINETICS_EXPORT ConcentrationCurveGenerator : public itk::Object
+class MITKPHARMACOKINETICS_EXPORT ConcentrationCurveGenerator : public SignalConverterBase
 {
 public:
 
-    mitkClassMacroItkParent(ConcentrationCurveGenerator, itk::Object);
+    mitkClassMacroItkParent(ConcentrationCurveGenerator, SignalConverterBase);
     itkNewMacro(Self);
 
     //typedef itk::Image<double,3> ImageType;
@@ -102,6 +107,15 @@ public:
 
     Image::Pointer GetConvertedImage();
 
+    /** Checks the conversion parameters of the selected conversion and prepares the PDW image (if needed).
+     * Must be called after the parameters are set and before ConvertSignal() is used.*/
+    void PrepareSignalConversion() override;
+
+    /** Converts the signal curve of one voxel into a concentration curve. The result is the same as the curve of
+     * the voxel in the image returned by GetConvertedImage().
+     * @pre PrepareSignalConversion() was called.*/
+    void ConvertSignal(const SignalType& signal, const IndexType& index, SignalType& concentration) const override;
+
 protected:
 
     ConcentrationCurveGenerator();
@@ -127,6 +141,21 @@ protected:
 
 
 private:
+    typedef itk::Image<double, 3> PDWImageType;
+
+    enum class ConversionType
+    {
+      None,
+      T2,
+      TurboFlash,
+      T1Map,
+      Absolute,
+      Relative
+    };
+
+    /** Returns the conversion selected by the flags, in the order of precedence used by convertToConcentration().*/
+    ConversionType GetConversionType() const;
+
     Image::ConstPointer m_DynamicImage;
     Image::ConstPointer m_BaselineImage;
     Image::ConstPointer m_PDWImage;
@@ -161,6 +190,10 @@ private:
     unsigned int m_BaselineStartTimeStep;
     // m_BaselinStopTimeStep is the last time frame, that is included into the baseline averaging.
     unsigned int m_BaselineEndTimeStep;
+
+    /** Conversion and PDW image used by ConvertSignal(); set by PrepareSignalConversion().*/
+    ConversionType m_SignalConversionType;
+    PDWImageType::Pointer m_SignalConversionPDWImage;
 };
 
 }
@@ -105,47 +105,71 @@ inline    itk::Array<double> wrap1d(itk::Array<double> kernel)
 
     }
 
-  inline itk::Array<double> convoluteAIFWithExponential(mitk::ModelBase::TimeGridType timeGrid, mitk::AIFBasedModelBase::AterialInputFunctionType aif, double lambda)
+  /** @brief Iterative Formula to Convolve aif(t) with an exponential Residuefunction R(t) = exp(lambda*t)
+   * Writes the result into convolution, the arrays are non-owning views of numberOfTimePoints values, so
+   * the function can be used in the inner loop of fits without allocating memory.
+   * @pre convolution must not alias timeGrid or aif.*/
+  inline void convoluteAIFWithExponential(const double* timeGrid, const double* aif, unsigned int numberOfTimePoints,
+                                          double lambda, double* convolution)
   {
-      /** @brief Iterative Formula to Convolve aif(t) with an exponential Residuefunction R(t) = exp(lambda*t)
-       **/
-      typedef itk::Array<double> ConvolutionResultType;
-      ConvolutionResultType convolution(timeGrid.GetSize());
-      convolution.fill(0.0);
+      if (numberOfTimePoints == 0)
+      {
+          return;
+      }
 
-      convolution(0) = 0;
-      for(unsigned int i = 0; i< (timeGrid.GetSize()-1); ++i)
+      convolution[0] = 0;
+      for(unsigned int i = 0; i< (numberOfTimePoints-1); ++i)
       {
-          double dt = timeGrid(i+1) - timeGrid(i);
-          double m = (aif(i+1) - aif(i))/dt;
+          double dt = timeGrid[i+1] - timeGrid[i];
+          double m = (aif[i+1] - aif[i])/dt;
           double edt = exp(-lambda *dt);
 
-          convolution(i+1) =edt * convolution(i)
-                           + (aif(i) - m*timeGrid(i))/lambda * (1 - edt )
-                           + m/(lambda * lambda) * ((lambda * timeGrid(i+1) - 1) - edt*(lambda*timeGrid(i) -1));
+          convolution[i+1] =edt * convolution[i]
+                           + (aif[i] - m*timeGrid[i])/lambda * (1 - edt )
+                           + m/(lambda * lambda) * ((lambda * timeGrid[i+1] - 1) - edt*(lambda*timeGrid[i] -1));
 
       }
-      return convolution;
   }
 
+  /** @brief Iterative Formula to Convolve aif(t) with a constant value by linear interpolation of the Aif between sampling points
+   * Writes the result into convolution, see the view based convoluteAIFWithExponential().*/
+  inline void convoluteAIFWithConstant(const double* timeGrid, const double* aif, unsigned int numberOfTimePoints,
+                                       double constant, double* convolution)
+  {
+      if (numberOfTimePoints == 0)
+      {
+          return;
+      }
+
+      convolution[0] = 0;
+      for(unsigned int i = 0; i< (numberOfTimePoints-1); ++i)
+      {
+          double dt = timeGrid[i+1] - timeGrid[i];
+          double m = (aif[i+1] - aif[i])/dt;
+
+          convolution[i+1] = convolution[i] + constant * (aif[i]*dt + m*timeGrid[i]*dt + m/2*(timeGrid[i+1]*timeGrid[i+1] - timeGrid[i]*timeGrid[i]));
 
-  inline itk::Array<double> convoluteAIFWithConstant(mitk::ModelBase::TimeGridType timeGrid, mitk::AIFBasedModelBase::AterialInputFunctionType aif, double constant)
+      }
+  }
+
+  inline itk::Array<double> convoluteAIFWithExponential(const mitk::ModelBase::TimeGridType& timeGrid, const mitk::AIFBasedModelBase::AterialInputFunctionType& aif, double lambda)
   {
-      /** @brief Iterative Formula to Convolve aif(t) with a constant value by linear interpolation of the Aif between sampling points
-       **/
       typedef itk::Array<double> ConvolutionResultType;
       ConvolutionResultType convolution(timeGrid.GetSize());
       convolution.fill(0.0);
 
-      convolution(0) = 0;
-      for(unsigned int i = 0; i< (timeGrid.GetSize()-1); ++i)
-      {
-          double dt = timeGrid(i+1) - timeGrid(i);
-          double m = (aif(i+1) - aif(i))/dt;
+      convoluteAIFWithExponential(timeGrid.data_block(), aif.data_block(), timeGrid.GetSize(), lambda, convolution.data_block());
+      return convolution;
+  }
 
-          convolution(i+1) = convolution(i) + constant * (aif(i)*dt + m*timeGrid(i)*dt + m/2*(timeGrid(i+1)*timeGrid(i+1) - timeGrid(i)*timeGrid(i)));
 
-      }
+  inline itk::Array<double> convoluteAIFWithConstant(const mitk::ModelBase::TimeGridType& timeGrid, const mitk::AIFBasedModelBase::AterialInputFunctionType& aif, double constant)
+  {
+      typedef itk::Array<double> ConvolutionResultType;
+      ConvolutionResultType convolution(timeGrid.GetSize());
+      convolution.fill(0.0);
+
+      convoluteAIFWithConstant(timeGrid.data_block(), aif.data_block(), timeGrid.GetSize(), constant, convolution.data_block());
       return convolution;
   }
 
@@ -70,6 +70,9 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    void EvaluateModelfunction(const ParametersType& parameters, ModelResultType& signal,
+                               ModelEvaluationWorkspace& workspace) const override;
+
     void PrintSelf(std::ostream& os, ::itk::Indent indent) const override;
 
   private:
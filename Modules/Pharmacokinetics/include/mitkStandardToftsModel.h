@@ -91,6 +91,9 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    void EvaluateModelfunction(const ParametersType& parameters, ModelResultType& signal,
+                               ModelEvaluationWorkspace& workspace) const override;
+
     DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const override;
 
@@ -20,7 +20,9 @@ found in the LICENSE file.
 #include "mitkExtractTimeGrid.h"
 #include "mitkAIFBasedModelBase.h"
 #include "mitkImageCast.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
@@ -68,14 +70,25 @@ void mitk::AterialInputFunctionGenerator::CalculateAIFAndGetResult()
     m_AIFTimeGrid = timeGrid;
 
 
-    signalGenerator->SetDynamicImage(m_DynamicImage);
-    signalGenerator->SetMask(m_Mask);
-    signalGenerator->Generate();
+    mitk::MaskedDynamicImageStatisticsGenerator::ResultType temp;
+    if (this->m_SignalConverter.IsNotNull())
+    {
+      this->m_SignalConverter->PrepareSignalConversion();
+      AccessFixedDimensionByItk(m_DynamicImage, mitk::AterialInputFunctionGenerator::DoCalculateConvertedMean, 4);
+      temp.SetSize(this->m_ConvertedMean.size());
+      std::copy(this->m_ConvertedMean.begin(), this->m_ConvertedMean.end(), temp.begin());
+    }
+    else
+    {
+      signalGenerator->SetDynamicImage(m_DynamicImage);
+      signalGenerator->SetMask(m_Mask);
+      signalGenerator->Generate();
 
+      temp = signalGenerator->GetMean();
+    }
 
     //Convert from aterial curve Ca to Plasma curve Cp
   //  m_AIFValues = signalGenerator->GetMean()/(1-this->m_HCL);
-    mitk::MaskedDynamicImageStatisticsGenerator::ResultType temp = signalGenerator->GetMean();
 
 
     mitk::AIFBasedModelBase::AterialInputFunctionType::iterator aif = this->m_AIFValues.begin();
@@ -92,6 +105,60 @@ void mitk::AterialInputFunctionGenerator::CalculateAIFAndGetResult()
 
 
 
+template <typename TPixel, unsigned int VDim>
+void mitk::AterialInputFunctionGenerator::DoCalculateConvertedMean(const itk::Image<TPixel, VDim>* image)
+{
+  typedef itk::Image<TPixel, VDim> InputImageType;
+  typedef itk::Image<unsigned char, VDim - 1> InternalMaskType;
+
+  typename InternalMaskType::Pointer castedMask;
+  CastToItkImage<InternalMaskType>(m_Mask, castedMask);
+  if (castedMask.IsNull())
+  {
+    mitkThrow() << "Dynamic cast of mask went wrong. Internal Mask is NULL. Aterial Input Function cannot be generated.";
+  }
+
+  const unsigned int numberOfTimeSteps = image->GetLargestPossibleRegion().GetSize(VDim - 1);
+
+  this->m_ConvertedMean.assign(numberOfTimeSteps, 0.);
+  SignalConverterBase::SignalType signal(numberOfTimeSteps);
+  SignalConverterBase::SignalType converted;
+  unsigned int count = 0;
+
+  for (itk::ImageRegionConstIteratorWithIndex<InternalMaskType> pos(castedMask, castedMask->GetLargestPossibleRegion()); !pos.IsAtEnd(); ++pos)
+  {
+    if (pos.Get() > 0)
+    {
+      typename InputImageType::IndexType index;
+      for (unsigned int i = 0; i < VDim - 1; ++i)
+      {
+        index[i] = pos.GetIndex()[i];
+      }
+      for (unsigned int t = 0; t < numberOfTimeSteps; ++t)
+      {
+        index[VDim - 1] = t;
+        signal[t] = image->GetPixel(index);
+      }
+
+      this->m_SignalConverter->ConvertSignal(signal, pos.GetIndex(), converted);
+
+      for (unsigned int t = 0; t < numberOfTimeSteps; ++t)
+      {
+        this->m_ConvertedMean[t] += converted[t];
+      }
+      ++count;
+    }
+  }
+
+  if (count > 0)
+  {
+    for (auto& value : this->m_ConvertedMean)
+    {
+      value /= count;
+    }
+  }
+}
+
 void
   mitk::AterialInputFunctionGenerator::CheckValidInputs() const
 {
@@ -122,6 +189,11 @@ bool mitk::AterialInputFunctionGenerator::HasOutdatedResults()
     }
     }
 
+    if (m_SignalConverter.IsNotNull() && m_SignalConverter->GetMTime() > this->m_GenerationTimeStamp)
+    {
+        result = true;
+    }
+
     if (m_Mask.IsNull())
     {
         result = true;
@@ -28,12 +28,15 @@ found in the LICENSE file.
 #include <itkExtractImageFilter.h>
 #include "itkMeanProjectionImageFilter.h"
 
+#include <algorithm>
+
 mitk::ConcentrationCurveGenerator::ConcentrationCurveGenerator() : m_isT2weightedImage(false), m_isTurboFlashSequence(false),
     m_AbsoluteSignalEnhancement(false), m_RelativeSignalEnhancement(false), m_UsingT1Map(false), m_Factor(std::numeric_limits<double>::quiet_NaN()),
     m_RecoveryTime(std::numeric_limits<double>::quiet_NaN()), m_RepetitionTime(std::numeric_limits<double>::quiet_NaN()),
     m_RelaxationTime(std::numeric_limits<double>::quiet_NaN()), m_Relaxivity(std::numeric_limits<double>::quiet_NaN()),
     m_FlipAngle(std::numeric_limits<double>::quiet_NaN()), m_FlipAnglePDW(std::numeric_limits<double>::quiet_NaN()),
-    m_T2Factor(std::numeric_limits<double>::quiet_NaN()), m_T2EchoTime(std::numeric_limits<double>::quiet_NaN())
+    m_T2Factor(std::numeric_limits<double>::quiet_NaN()), m_T2EchoTime(std::numeric_limits<double>::quiet_NaN()),
+    m_BaselineStartTimeStep(0), m_BaselineEndTimeStep(0), m_SignalConversionType(ConversionType::None)
 {
 }
 
@@ -396,3 +399,177 @@ mitk::Image::Pointer mitk::ConcentrationCurveGenerator::convertToConcentration(c
 }
 
 
+
+mitk::ConcentrationCurveGenerator::ConversionType mitk::ConcentrationCurveGenerator::GetConversionType() const
+{
+  if (this->m_isT2weightedImage)
+  {
+    return ConversionType::T2;
+  }
+  if (this->m_isTurboFlashSequence)
+  {
+    return ConversionType::TurboFlash;
+  }
+  if (this->m_UsingT1Map)
+  {
+    return ConversionType::T1Map;
+  }
+  if (this->m_AbsoluteSignalEnhancement)
+  {
+    return ConversionType::Absolute;
+  }
+  if (this->m_RelativeSignalEnhancement)
+  {
+    return ConversionType::Relative;
+  }
+  return ConversionType::None;
+}
+
+void mitk::ConcentrationCurveGenerator::PrepareSignalConversion()
+{
+  if (m_BaselineStartTimeStep > m_BaselineEndTimeStep)
+  {
+    mitkThrow() << "Error in ConcentrationCurveGenerator::PrepareSignalConversion. End time point is before start time point.";
+  }
+  if (this->m_DynamicImage.IsNotNull() && m_BaselineEndTimeStep >= this->m_DynamicImage->GetTimeSteps())
+  {
+    mitkThrow() << "Error in ConcentrationCurveGenerator::PrepareSignalConversion. End time point is larger than total number of time points.";
+  }
+
+  m_SignalConversionType = this->GetConversionType();
+  m_SignalConversionPDWImage = nullptr;
+
+  switch (m_SignalConversionType)
+  {
+    case ConversionType::T2:
+      if (std::isnan(this->m_T2Factor))
+      {
+        mitkThrow() << "The conversion factor k for T2-weighted images must be set.";
+      }
+      else if (std::isnan(this->m_T2EchoTime))
+      {
+        mitkThrow() << "The echo time TE for T2-weighted images must be set.";
+      }
+      break;
+    case ConversionType::TurboFlash:
+      if (std::isnan(this->m_RelaxationTime))
+      {
+        mitkThrow() << "The relaxation time must be set.";
+      }
+      else if (std::isnan(this->m_Relaxivity))
+      {
+        mitkThrow() << "The relaxivity must be set.";
+      }
+      else if (std::isnan(this->m_RecoveryTime))
+      {
+        mitkThrow() << "The recovery time must be set.";
+      }
+      break;
+    case ConversionType::T1Map:
+      if (std::isnan(this->m_Relaxivity))
+      {
+        mitkThrow() << "The relaxivity must be set.";
+      }
+      else if (std::isnan(this->m_RepetitionTime))
+      {
+        mitkThrow() << "The repetition time must be set.";
+      }
+      else if (std::isnan(this->m_FlipAngle))
+      {
+        mitkThrow() << "The flip angle must be set.";
+      }
+      else if (std::isnan(this->m_FlipAnglePDW))
+      {
+        mitkThrow() << "The flip angle of the PDW image must be set.";
+      }
+      else if (this->m_PDWImage.IsNull())
+      {
+        mitkThrow() << "The PDW image must be set.";
+      }
+      mitk::CastToItkImage(this->m_PDWImage, m_SignalConversionPDWImage);
+      break;
+    case ConversionType::Absolute:
+    case ConversionType::Relative:
+      if (std::isnan(this->m_Factor))
+      {
+        mitkThrow() << "The conversion factor k must be set.";
+      }
+      break;
+    case ConversionType::None:
+      mitkThrow() << "No signal to concentration conversion is selected.";
+  }
+}
+
+void mitk::ConcentrationCurveGenerator::ConvertSignal(const SignalType& signal, const IndexType& index, SignalType& concentration) const
+{
+  concentration.resize(signal.size());
+
+  if (signal.empty())
+  {
+    return;
+  }
+
+  // Same baseline as PrepareBaselineImage(): the first frame, or the mean over the baseline time steps
+  double baseline = signal[0];
+  if (m_BaselineStartTimeStep != m_BaselineEndTimeStep)
+  {
+    if (m_BaselineEndTimeStep >= signal.size())
+    {
+      mitkThrow() << "Error in ConcentrationCurveGenerator::ConvertSignal. End time point is larger than total number of time points.";
+    }
+
+    baseline = 0.;
+    for (unsigned int i = m_BaselineStartTimeStep; i <= m_BaselineEndTimeStep; ++i)
+    {
+      baseline += signal[i];
+    }
+    baseline /= (m_BaselineEndTimeStep - m_BaselineStartTimeStep + 1);
+  }
+
+  // The conversion functors are not const, so every call uses its own instance
+  switch (m_SignalConversionType)
+  {
+    case ConversionType::T2:
+    {
+      mitk::ConvertT2ConcentrationFunctor<double, double, double> functor;
+      functor.initialize(this->m_T2Factor, this->m_T2EchoTime);
+      std::transform(signal.begin(), signal.end(), concentration.begin(), [&](double value) { return functor(value, baseline); });
+      break;
+    }
+    case ConversionType::TurboFlash:
+    {
+      mitk::ConvertToConcentrationTurboFlashFunctor<double, double, double> functor;
+      functor.initialize(this->m_RelaxationTime, this->m_Relaxivity, this->m_RecoveryTime);
+      std::transform(signal.begin(), signal.end(), concentration.begin(), [&](double value) { return functor(value, baseline); });
+      break;
+    }
+    case ConversionType::T1Map:
+    {
+      if (m_SignalConversionPDWImage.IsNull())
+      {
+        mitkThrow() << "Error in ConcentrationCurveGenerator::ConvertSignal. PDW image is not prepared. Call PrepareSignalConversion() first.";
+      }
+      mitk::ConvertToConcentrationViaT1CalcFunctor<double, double, double, double> functor;
+      functor.initialize(this->m_Relaxivity, this->m_RepetitionTime, this->m_FlipAngle, this->m_FlipAnglePDW);
+      const double pdw = m_SignalConversionPDWImage->GetPixel(index);
+      std::transform(signal.begin(), signal.end(), concentration.begin(), [&](double value) { return functor(value, baseline, pdw); });
+      break;
+    }
+    case ConversionType::Absolute:
+    {
+      mitk::ConvertToConcentrationAbsoluteFunctor<double, double, double> functor;
+      functor.initialize(this->m_Factor);
+      std::transform(signal.begin(), signal.end(), concentration.begin(), [&](double value) { return functor(value, baseline); });
+      break;
+    }
+    case ConversionType::Relative:
+    {
+      mitk::ConvertToConcentrationRelativeFunctor<double, double, double> functor;
+      functor.initialize(this->m_Factor);
+      std::transform(signal.begin(), signal.end(), concentration.begin(), [&](double value) { return functor(value, baseline); });
+      break;
+    }
+    case ConversionType::None:
+      mitkThrow() << "Error in ConcentrationCurveGenerator::ConvertSignal. No conversion is prepared. Call PrepareSignalConversion() first.";
+  }
+}
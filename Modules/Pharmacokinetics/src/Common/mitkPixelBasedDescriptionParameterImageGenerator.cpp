@@ -11,14 +11,14 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "itkCommand.h"
-#include "itkMultiOutputNaryFunctorImageFilter.h"
+#include "itkMultiOutputTimeSeriesFunctorImageFilter.h"
 
 #include "mitkPixelBasedDescriptionParameterImageGenerator.h"
-#include "mitkImageTimeSelector.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
 #include "mitkSimpleFunctorPolicy.h"
 #include "mitkModelBase.h"
+#include "mitkVoxelMajorTimeSeries.h"
 
 void
   mitk::PixelBasedDescriptionParameterImageGenerator::
@@ -76,12 +76,12 @@ mitk::PixelBasedDescriptionParameterImageGenerator::ParameterImageMapType StoreR
 
 template <typename TPixel, unsigned int VDim>
 void
-  mitk::PixelBasedDescriptionParameterImageGenerator::DoParameterCalculation(itk::Image<TPixel, VDim>* /*image*/)
+  mitk::PixelBasedDescriptionParameterImageGenerator::DoParameterCalculation(itk::Image<TPixel, VDim>* image)
 {
-  typedef itk::Image<TPixel, VDim-1> InputFrameImageType;
+  typedef itk::VectorImage<TPixel, VDim-1> InputTimeSeriesImageType;
   typedef itk::Image<ScalarType, VDim-1> ParameterImageType;
 
-  typedef itk::MultiOutputNaryFunctorImageFilter<InputFrameImageType, ParameterImageType, SimpleFunctorPolicy, InternalMaskType> DescriptorFilterType;
+  typedef itk::MultiOutputTimeSeriesFunctorImageFilter<InputTimeSeriesImageType, ParameterImageType, SimpleFunctorPolicy, InternalMaskType> DescriptorFilterType;
 
   typename DescriptorFilterType::Pointer descFilter = DescriptorFilterType::New();
 
@@ -89,22 +89,9 @@ void
   spProgressCommand->SetCallbackFunction(this, &Self::onFitProgressEvent);
   descFilter->AddObserver(::itk::ProgressEvent(), spProgressCommand);
 
-  //add the time frames to the descriptor filter
-  std::vector<Image::Pointer> frameCache;
-  for (unsigned int i = 0; i < this->m_DynamicImage->GetTimeSteps(); ++i)
-  {
-    typename InputFrameImageType::Pointer frameImage;
-    mitk::ImageTimeSelector::Pointer imageTimeSelector =	mitk::ImageTimeSelector::New();
-    imageTimeSelector->SetInput(this->m_DynamicImage);
-    imageTimeSelector->SetTimeNr(i);
-    imageTimeSelector->UpdateLargestPossibleRegion();
-
-    Image::Pointer frameMITKImage = imageTimeSelector->GetOutput();
-    frameCache.push_back(frameMITKImage);
-    mitk::CastToItkImage(frameMITKImage, frameImage);
-    descFilter->SetInput(i,frameImage);
-  }
-
+  //transpose the dynamic image once, so that the descriptors read the time curve of each voxel from contiguous memory
+  typename InputTimeSeriesImageType::Pointer timeSeriesImage = GenerateVoxelMajorTimeSeries(image);
+  descFilter->SetInput(timeSeriesImage);
 
   SimpleFunctorPolicy functor;
 
@@ -90,6 +90,23 @@ mitk::AIFBasedModelBase::GetAterialInputFunction(TimeGridType CurrentTimeGrid) c
   }
 }
 
+const mitk::AIFBasedModelBase::AterialInputFunctionType&
+mitk::AIFBasedModelBase::GetAterialInputFunction(ModelEvaluationWorkspace& workspace) const
+{
+  // Cache array of the workspace that is reserved for the interpolated AIF
+  const unsigned int aifCacheIndex = 0;
+
+  AterialInputFunctionType& aif = workspace.GetCacheArray(aifCacheIndex);
+
+  if (!workspace.IsCacheValid(aifCacheIndex))
+  {
+    aif = GetAterialInputFunction(this->m_TimeGrid);
+    workspace.SetCacheValid(aifCacheIndex);
+  }
+
+  return aif;
+}
+
 mitk::AIFBasedModelBase::ParameterNamesType mitk::AIFBasedModelBase::GetStaticParameterNames() const
 {
   ParameterNamesType result;
@@ -81,43 +81,38 @@ mitk::OneTissueCompartmentModel::GetParameterUnits() const
 
 mitk::OneTissueCompartmentModel::ModelResultType mitk::OneTissueCompartmentModel::ComputeModelfunction(
   const ParametersType& parameters) const
+{
+  ModelEvaluationWorkspace workspace;
+  ModelResultType signal;
+  this->EvaluateModelfunction(parameters, signal, workspace);
+  return signal;
+}
+
+void mitk::OneTissueCompartmentModel::EvaluateModelfunction(const ParametersType& parameters, ModelResultType& signal,
+    ModelEvaluationWorkspace& workspace) const
 {
   if (this->m_TimeGrid.GetSize() == 0)
   {
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const AterialInputFunctionType& aterialInputFunction = GetAterialInputFunction(workspace);
 
-
-
-  unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  signal.SetSize(timeSteps);
 
   //Model Parameters
   double     K1 = (double) parameters[POSITION_PARAMETER_K1] / 60.0;
   double     k2 = (double) parameters[POSITION_PARAMETER_k2] / 60.0;
 
+  ModelResultType& convolution = workspace.GetScratchArray(0, timeSteps);
+  mitk::convoluteAIFWithExponential(this->m_TimeGrid.data_block(), aterialInputFunction.data_block(), timeSteps,
+      k2, convolution.data_block());
 
-
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, k2);
-
-  //Signal that will be returned by ComputeModelFunction
-  mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
-
-  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-
-
-
-  for (mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin(); res != convolution.end(); ++res, ++signalPos)
+  for (unsigned int i = 0; i < timeSteps; ++i)
   {
-    *signalPos = K1 * (*res);
+    signal[i] = K1 * convolution[i];
   }
-
-  return signal;
-
 }
 
 
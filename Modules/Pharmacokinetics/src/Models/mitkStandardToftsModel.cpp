@@ -109,18 +109,25 @@ mitk::StandardToftsModel::ParamterUnitMapType mitk::StandardToftsModel::GetDeriv
 
 mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModelfunction(
   const ParametersType& parameters) const
+{
+  ModelEvaluationWorkspace workspace;
+  ModelResultType signal;
+  this->EvaluateModelfunction(parameters, signal, workspace);
+  return signal;
+}
+
+void mitk::StandardToftsModel::EvaluateModelfunction(const ParametersType& parameters, ModelResultType& signal,
+    ModelEvaluationWorkspace& workspace) const
 {
   if (this->m_TimeGrid.GetSize() == 0)
   {
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
-
-
+  const AterialInputFunctionType& aterialInputFunction = GetAterialInputFunction(workspace);
 
-  unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  signal.SetSize(timeSteps);
 
   //Model Parameters
   double ktrans = parameters[POSITION_PARAMETER_Ktrans] / 6000.0;
@@ -129,25 +136,14 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
 
   double lambda =  ktrans / ve;
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, lambda);
+  ModelResultType& convolution = workspace.GetScratchArray(0, timeSteps);
+  mitk::convoluteAIFWithExponential(this->m_TimeGrid.data_block(), aterialInputFunction.data_block(), timeSteps,
+      lambda, convolution.data_block());
 
-  //Signal that will be returned by ComputeModelFunction
-  mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
-
-  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-  mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin();
-
-
-  for (AterialInputFunctionType::iterator Cp = aterialInputFunction.begin();
-       Cp != aterialInputFunction.end(); ++res, ++signalPos, ++Cp)
+  for (unsigned int i = 0; i < timeSteps; ++i)
   {
-    *signalPos = ktrans * (*res);
+    signal[i] = ktrans * convolution[i];
   }
-
-  return signal;
-
 }
 
 
@@ -99,19 +99,24 @@ mitk::TwoCompartmentExchangeModel::GetParameterUnits() const
 mitk::TwoCompartmentExchangeModel::ModelResultType
 mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& parameters) const
 {
-    typedef mitk::ModelBase::ModelResultType ConvolutionResultType;
+    ModelEvaluationWorkspace workspace;
+    ModelResultType signal;
+    this->EvaluateModelfunction(parameters, signal, workspace);
+    return signal;
+}
 
+void mitk::TwoCompartmentExchangeModel::EvaluateModelfunction(const ParametersType& parameters, ModelResultType& signal,
+    ModelEvaluationWorkspace& workspace) const
+{
     if (this->m_TimeGrid.GetSize() == 0)
     {
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
     }
 
-    AterialInputFunctionType aterialInputFunction;
-    aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+    const AterialInputFunctionType& aterialInputFunction = GetAterialInputFunction(workspace);
 
-    unsigned int timeSteps = this->m_TimeGrid.GetSize();
-    mitk::ModelBase::ModelResultType signal(timeSteps);
-    signal.fill(0.0);
+    const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+    signal.SetSize(timeSteps);
 
     //Model Parameters
     double F = parameters[POSITION_PARAMETER_F] / 6000.0;
@@ -130,19 +135,16 @@ mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& pa
 
         double E = ( Kp - 1/Tb )/( Kp - Km );
 
+        ModelResultType& expp = workspace.GetScratchArray(0, timeSteps);
+        ModelResultType& expm = workspace.GetScratchArray(1, timeSteps);
+        mitk::convoluteAIFWithExponential(this->m_TimeGrid.data_block(), aterialInputFunction.data_block(), timeSteps,
+            Kp, expp.data_block());
+        mitk::convoluteAIFWithExponential(this->m_TimeGrid.data_block(), aterialInputFunction.data_block(), timeSteps,
+            Km, expm.data_block());
 
-
-        ConvolutionResultType expp = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Kp);
-        ConvolutionResultType expm = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Km);
-
-        //Signal that will be returned by ComputeModelFunction
-
-        mitk::ModelBase::ModelResultType::const_iterator exppPos = expp.begin();
-        mitk::ModelBase::ModelResultType::const_iterator expmPos = expm.begin();
-
-        for( mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin(); signalPos!=signal.end(); ++exppPos,++expmPos, ++signalPos)
+        for (unsigned int i = 0; i < timeSteps; ++i)
         {
-            *signalPos = F * ( *exppPos + E*(*expmPos - *exppPos) );
+            signal[i] = F * ( expp[i] + E*(expm[i] - expp[i]) );
         }
     }
 
@@ -150,17 +152,16 @@ mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& pa
     else
     {
         double Kp = F/vp;
-        ConvolutionResultType exp = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Kp);
-        mitk::ModelBase::ModelResultType::const_iterator expPos = exp.begin();
+        ModelResultType& exp = workspace.GetScratchArray(0, timeSteps);
+        mitk::convoluteAIFWithExponential(this->m_TimeGrid.data_block(), aterialInputFunction.data_block(), timeSteps,
+            Kp, exp.data_block());
 
-        for( mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin(); signalPos!=signal.end(); ++expPos, ++signalPos)
+        for (unsigned int i = 0; i < timeSteps; ++i)
         {
-            *signalPos = F * ( *expPos );
+            signal[i] = F * exp[i];
         }
 
     }
-
-    return signal;
 }
 
 
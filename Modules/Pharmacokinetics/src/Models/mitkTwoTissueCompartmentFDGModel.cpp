@@ -89,17 +89,25 @@ mitk::TwoTissueCompartmentFDGModel::GetParameterUnits() const
 
 mitk::TwoTissueCompartmentFDGModel::ModelResultType
 mitk::TwoTissueCompartmentFDGModel::ComputeModelfunction(const ParametersType& parameters) const
+{
+  ModelEvaluationWorkspace workspace;
+  ModelResultType signal;
+  this->EvaluateModelfunction(parameters, signal, workspace);
+  return signal;
+}
+
+void mitk::TwoTissueCompartmentFDGModel::EvaluateModelfunction(const ParametersType& parameters, ModelResultType& signal,
+    ModelEvaluationWorkspace& workspace) const
 {
   if (this->m_TimeGrid.GetSize() == 0)
   {
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
-
+  const AterialInputFunctionType& aterialInputFunction = GetAterialInputFunction(workspace);
 
-  unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  signal.SetSize(timeSteps);
 
   //Model Parameters
   double K1 = (double)parameters[POSITION_PARAMETER_K1] / 60.0;
@@ -112,27 +120,23 @@ mitk::TwoTissueCompartmentFDGModel::ComputeModelfunction(const ParametersType& p
 
   double lambda = k2+k3;
 
-  mitk::ModelBase::ModelResultType exp = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-                                          aterialInputFunction, lambda);
-  mitk::ModelBase::ModelResultType CA = mitk::convoluteAIFWithConstant(this->m_TimeGrid, aterialInputFunction, k3);
+  ModelResultType& exp = workspace.GetScratchArray(0, timeSteps);
+  ModelResultType& CA = workspace.GetScratchArray(1, timeSteps);
+  mitk::convoluteAIFWithExponential(this->m_TimeGrid.data_block(), aterialInputFunction.data_block(), timeSteps,
+      lambda, exp.data_block());
+  mitk::convoluteAIFWithConstant(this->m_TimeGrid.data_block(), aterialInputFunction.data_block(), timeSteps,
+      k3, CA.data_block());
 
-  //Signal that will be returned by ComputeModelFunction
-  mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
-
-  mitk::ModelBase::ModelResultType::const_iterator expPos = exp.begin();
-  mitk::ModelBase::ModelResultType::const_iterator CAPos = CA.begin();
+  ModelResultType::const_iterator expPos = exp.begin();
+  ModelResultType::const_iterator CAPos = CA.begin();
   AterialInputFunctionType::const_iterator aifPos = aterialInputFunction.begin();
 
-  for (mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
+  for (ModelResultType::iterator signalPos = signal.begin();
        signalPos != signal.end(); ++expPos, ++signalPos, ++aifPos)
   {
       double Ci = K1 * k2 /lambda *(*expPos) + K1*k3/lambda*(*CAPos);
       *signalPos = vb * (*aifPos) + (1 - vb) * Ci;
   }
-
-  return signal;
-
 }
 
 
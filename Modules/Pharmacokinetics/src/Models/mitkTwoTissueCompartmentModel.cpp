@@ -100,17 +100,25 @@ mitk::TwoTissueCompartmentModel::GetParameterUnits() const
 
 mitk::TwoTissueCompartmentModel::ModelResultType
 mitk::TwoTissueCompartmentModel::ComputeModelfunction(const ParametersType& parameters) const
+{
+  ModelEvaluationWorkspace workspace;
+  ModelResultType signal;
+  this->EvaluateModelfunction(parameters, signal, workspace);
+  return signal;
+}
+
+void mitk::TwoTissueCompartmentModel::EvaluateModelfunction(const ParametersType& parameters, ModelResultType& signal,
+    ModelEvaluationWorkspace& workspace) const
 {
   if (this->m_TimeGrid.GetSize() == 0)
   {
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
-
+  const AterialInputFunctionType& aterialInputFunction = GetAterialInputFunction(workspace);
 
-  unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  signal.SetSize(timeSteps);
 
   //Model Parameters
   double K1 = (double)parameters[POSITION_PARAMETER_K1] / 60.0;
@@ -124,30 +132,18 @@ mitk::TwoTissueCompartmentModel::ComputeModelfunction(const ParametersType& para
   double alpha1 = 0.5 * ((k2 + k3 + k4) - sqrt(square(k2 + k3 + k4) - 4 * k2 * k4));
   double alpha2 = 0.5 * ((k2 + k3 + k4) + sqrt(square(k2 + k3 + k4) - 4 * k2 * k4));
 
-  mitk::ModelBase::ModelResultType exp1 = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-                                          aterialInputFunction, alpha1);
-  mitk::ModelBase::ModelResultType exp2 = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-                                          aterialInputFunction, alpha2);
-
+  ModelResultType& exp1 = workspace.GetScratchArray(0, timeSteps);
+  ModelResultType& exp2 = workspace.GetScratchArray(1, timeSteps);
+  mitk::convoluteAIFWithExponential(this->m_TimeGrid.data_block(), aterialInputFunction.data_block(), timeSteps,
+      alpha1, exp1.data_block());
+  mitk::convoluteAIFWithExponential(this->m_TimeGrid.data_block(), aterialInputFunction.data_block(), timeSteps,
+      alpha2, exp2.data_block());
 
-  //Signal that will be returned by ComputeModelFunction
-  mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
-
-  mitk::ModelBase::ModelResultType::const_iterator exp1Pos = exp1.begin();
-  mitk::ModelBase::ModelResultType::const_iterator exp2Pos = exp2.begin();
-  AterialInputFunctionType::const_iterator aifPos = aterialInputFunction.begin();
-
-  for (mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-       signalPos != signal.end(); ++exp1Pos, ++exp2Pos, ++signalPos, ++aifPos)
+  for (unsigned int i = 0; i < timeSteps; ++i)
   {
-    double Ci = K1 / (alpha2 - alpha1) * ((k4 - alpha1 + k3) * (*exp1Pos) + (alpha2 - k4 - k3) *
-                                          (*exp2Pos));
-    *signalPos = vb * (*aifPos) + (1 - vb) * Ci;
+    double Ci = K1 / (alpha2 - alpha1) * ((k4 - alpha1 + k3) * exp1[i] + (alpha2 - k4 - k3) * exp2[i]);
+    signal[i] = vb * aterialInputFunction[i] + (1 - vb) * Ci;
   }
-
-  return signal;
-
 }
 
 
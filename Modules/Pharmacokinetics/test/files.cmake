@@ -9,4 +9,5 @@ SET(MODULE_TESTS
   mitkExtendedOneTissueCompartmentModelTest.cpp
   mitkTwoTissueCompartmentModelTest.cpp
   mitkTwoTissueCompartmentFDGModelTest.cpp
+  mitkModelEvaluationWorkspaceTest.cpp
 )
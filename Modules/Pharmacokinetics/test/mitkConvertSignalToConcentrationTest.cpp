@@ -20,6 +20,8 @@ found in the LICENSE file.
 #include "mitkImagePixelReadAccessor.h"
 #include "boost/math/constants/constants.hpp"
 
+#include <cmath>
+
 
 class mitkConvertSignalToConcentrationTestSuite : public mitk::TestFixture
 {
@@ -38,6 +40,43 @@ private:
   mitk::ConcentrationCurveGenerator::Pointer m_concentrationGen;
   std::vector <itk::Index<4>> m_testIndices;
 
+  /** Checks that the voxel wise conversion (used when fitting directly on the signal image) yields the
+   curves of the converted image at all test indices.*/
+  void CheckConvertSignal(const std::string& conversionName)
+  {
+    m_concentrationGen->PrepareSignalConversion();
+
+    mitk::ImagePixelReadAccessor<double, 4> readAccessDyn(m_dynamicImage, m_dynamicImage->GetSliceData(4));
+    mitk::ImagePixelReadAccessor<double, 4> readAccess(m_convertedImage, m_convertedImage->GetSliceData(4));
+    const unsigned int timeSteps = m_dynamicImage->GetTimeSteps();
+
+    for (long unsigned int i = 0; i < m_testIndices.size(); i++)
+    {
+      itk::Index<4> index = m_testIndices.at(i);
+      const itk::Index<3> spatialIndex = { { index[0], index[1], index[2] } };
+
+      mitk::ConcentrationCurveGenerator::SignalType signal;
+      for (unsigned int t = 0; t < timeSteps; ++t)
+      {
+        index[3] = t;
+        signal.push_back(readAccessDyn.GetPixelByIndex(index));
+      }
+
+      mitk::ConcentrationCurveGenerator::SignalType concentration;
+      m_concentrationGen->ConvertSignal(signal, spatialIndex, concentration);
+      CPPUNIT_ASSERT_EQUAL(signal.size(), concentration.size());
+
+      for (unsigned int t = 0; t < timeSteps; ++t)
+      {
+        index[3] = t;
+        std::stringstream ss;
+        ss << "Checking signal conversion (" << conversionName << ") at test index " << i << " and time step " << t << ".";
+        const double expected = readAccess.GetPixelByIndex(index);
+        CPPUNIT_ASSERT_MESSAGE(ss.str(), (std::isnan(expected) && std::isnan(concentration[t])) || mitk::Equal(expected, concentration[t], 1e-6, true));
+      }
+    }
+  }
+
 public:
   void setUp() override
   {
@@ -82,6 +121,8 @@ public:
       std::string message = ss.str();
       CPPUNIT_ASSERT_MESSAGE(message, mitk::Equal(refValues.at(i), readAccess.GetPixelByIndex(m_testIndices.at(i)), 1e-6, true) == true);
     }
+
+    CheckConvertSignal("absolute enhancement");
   }
 
   void GetConvertedImageAbsoluteEnhancementAveragedBaselineTest()
@@ -106,6 +147,8 @@ public:
       std::string message = ss.str();
       CPPUNIT_ASSERT_MESSAGE(message, mitk::Equal(refValues.at(i), readAccess.GetPixelByIndex(m_testIndices.at(i)), 1e-6, true) == true);
     }
+
+    CheckConvertSignal("absolute enhancement with averaged baseline");
  }
 
   void GetConvertedImageRelativeEnhancementTest()
@@ -130,6 +173,8 @@ public:
       std::string message = ss.str();
       CPPUNIT_ASSERT_MESSAGE(message, mitk::Equal(refValues.at(i), readAccess.GetPixelByIndex(m_testIndices.at(i)), 1e-6, true) == true);
     }
+
+    CheckConvertSignal("relative enhancement");
  }
 
   void GetConvertedImageturboFLASHTest()
@@ -156,6 +201,8 @@ public:
       std::string message = ss.str();
       CPPUNIT_ASSERT_MESSAGE(message, mitk::Equal(refValues.at(i), readAccess.GetPixelByIndex(m_testIndices.at(i)), 1e-6, true) == true);
     }
+
+    CheckConvertSignal("turboFLASH");
   }
 
   void GetConvertedImageVFATest()
@@ -189,6 +236,8 @@ public:
       std::string message = ss.str();
       CPPUNIT_ASSERT_MESSAGE(message, mitk::Equal(refValues.at(i), readAccess.GetPixelByIndex(m_testIndices.at(i)), 1e-6, true) == true);
     }
+
+    CheckConvertSignal("VFA");
  }
 
   void GetConvertedImageT2Test()
@@ -214,6 +263,8 @@ public:
       std::string message = ss.str();
       CPPUNIT_ASSERT_MESSAGE(message, mitk::Equal(refValues.at(i), readAccess.GetPixelByIndex(m_testIndices.at(i)), 1e-6, true) == true);
     }
+
+    CheckConvertSignal("T2");
  }
 
 };
@@ -0,0 +1,275 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include "mitkConvolutionHelper.h"
+#include "mitkModelEvaluationWorkspace.h"
+#include "mitkTwoCompartmentExchangeModel.h"
+#include "mitkTwoTissueCompartmentFDGModel.h"
+#include "mitkTwoTissueCompartmentModel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+class mitkModelEvaluationWorkspaceTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkModelEvaluationWorkspaceTestSuite);
+  MITK_TEST(ScratchArraysKeepReferences);
+  MITK_TEST(TwoTissueCompartmentModel);
+  MITK_TEST(TwoCompartmentExchangeModel);
+  MITK_TEST(TwoTissueCompartmentFDGModel);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static const unsigned int NumberOfTimePoints = 60;
+
+  mitk::ModelBase::TimeGridType m_TimeGrid;
+  mitk::AIFBasedModelBase::AterialInputFunctionType m_AIF;
+
+  typedef mitk::ModelBase::ModelResultType (*ReferenceFunctionType)(const mitk::AIFBasedModelBase*,
+                                                                      const mitk::ModelBase::ParametersType&);
+
+  void InitializeModel(mitk::AIFBasedModelBase* model) const
+  {
+    model->SetTimeGrid(m_TimeGrid);
+    model->SetAterialInputFunctionValues(m_AIF);
+    model->SetAterialInputFunctionTimeGrid(m_TimeGrid);
+  }
+
+  /** Compares the signals of the legacy evaluation and of the workspace evaluation with the reference. The workspace
+   * already holds scratch arrays of other sizes, like after the evaluation of another model.*/
+  void CheckModel(mitk::AIFBasedModelBase* model, const mitk::ModelBase::ParametersType& parameters,
+    ReferenceFunctionType referenceFunction) const
+  {
+    const auto reference = referenceFunction(model, parameters);
+
+    mitk::ModelEvaluationWorkspace workspace;
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+      workspace.GetScratchArray(i, 3 * i + 1).Fill(-1.);
+    }
+
+    const auto legacySignal = model->GetSignal(parameters);
+    mitk::ModelBase::ModelResultType workspaceSignal;
+    model->GetSignal(parameters, workspaceSignal, workspace);
+    mitk::ModelBase::ModelResultType repeatedSignal;
+    model->GetSignal(parameters, repeatedSignal, workspace);
+
+    CPPUNIT_ASSERT_EQUAL(reference.GetSize(), legacySignal.GetSize());
+    CPPUNIT_ASSERT_EQUAL(reference.GetSize(), workspaceSignal.GetSize());
+    CPPUNIT_ASSERT_EQUAL(reference.GetSize(), repeatedSignal.GetSize());
+
+    for (unsigned int i = 0; i < reference.GetSize(); ++i)
+    {
+      std::ostringstream message;
+      message << model->GetClassID() << ": wrong signal at time point " << i;
+      const double tolerance = 1e-10 * std::max(1., std::abs(reference[i]));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(message.str(), reference[i], legacySignal[i], tolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(message.str(), reference[i], workspaceSignal[i], tolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(message.str(), reference[i], repeatedSignal[i], tolerance);
+    }
+  }
+
+  // The reference functions are the model functions as they were computed before the workspace was introduced.
+
+  static mitk::ModelBase::ModelResultType ComputeTwoTissueCompartmentSignal(const mitk::AIFBasedModelBase* model,
+    const mitk::ModelBase::ParametersType& parameters)
+  {
+    const auto timeGrid = model->GetTimeGrid();
+    const auto aif = model->GetAterialInputFunction(timeGrid);
+
+    const double K1 = parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_K1] / 60.0;
+    const double k2 = parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k2] / 60.0;
+    const double k3 = parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k3] / 60.0;
+    const double k4 = parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k4] / 60.0;
+    const double vb = parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_vb];
+
+    const double alpha1 = 0.5 * ((k2 + k3 + k4) - std::sqrt((k2 + k3 + k4) * (k2 + k3 + k4) - 4 * k2 * k4));
+    const double alpha2 = 0.5 * ((k2 + k3 + k4) + std::sqrt((k2 + k3 + k4) * (k2 + k3 + k4) - 4 * k2 * k4));
+
+    const auto exp1 = mitk::convoluteAIFWithExponential(timeGrid, aif, alpha1);
+    const auto exp2 = mitk::convoluteAIFWithExponential(timeGrid, aif, alpha2);
+
+    mitk::ModelBase::ModelResultType signal(timeGrid.GetSize());
+    for (unsigned int i = 0; i < signal.GetSize(); ++i)
+    {
+      const double Ci = K1 / (alpha2 - alpha1) * ((k4 - alpha1 + k3) * exp1[i] + (alpha2 - k4 - k3) * exp2[i]);
+      signal[i] = vb * aif[i] + (1 - vb) * Ci;
+    }
+    return signal;
+  }
+
+  static mitk::ModelBase::ModelResultType ComputeTwoCompartmentExchangeSignal(const mitk::AIFBasedModelBase* model,
+    const mitk::ModelBase::ParametersType& parameters)
+  {
+    const auto timeGrid = model->GetTimeGrid();
+    const auto aif = model->GetAterialInputFunction(timeGrid);
+
+    const double F = parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_F] / 6000.0;
+    const double PS = parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_PS] / 6000.0;
+    const double ve = parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_ve];
+    const double vp = parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_vp];
+
+    mitk::ModelBase::ModelResultType signal(timeGrid.GetSize());
+    if (PS != 0)
+    {
+      const double Tp = vp / (PS + F);
+      const double Te = ve / PS;
+      const double Tb = vp / F;
+
+      const double Kp = 0.5 * (1 / Tp + 1 / Te + std::sqrt((1 / Tp + 1 / Te) * (1 / Tp + 1 / Te) - 4 * 1 / Te * 1 / Tb));
+      const double Km = 0.5 * (1 / Tp + 1 / Te - std::sqrt((1 / Tp + 1 / Te) * (1 / Tp + 1 / Te) - 4 * 1 / Te * 1 / Tb));
+      const double E = (Kp - 1 / Tb) / (Kp - Km);
+
+      const auto expp = mitk::convoluteAIFWithExponential(timeGrid, aif, Kp);
+      const auto expm = mitk::convoluteAIFWithExponential(timeGrid, aif, Km);
+
+      for (unsigned int i = 0; i < signal.GetSize(); ++i)
+      {
+        signal[i] = F * (expp[i] + E * (expm[i] - expp[i]));
+      }
+    }
+    else
+    {
+      const auto exp = mitk::convoluteAIFWithExponential(timeGrid, aif, F / vp);
+      for (unsigned int i = 0; i < signal.GetSize(); ++i)
+      {
+        signal[i] = F * exp[i];
+      }
+    }
+    return signal;
+  }
+
+  static mitk::ModelBase::ModelResultType ComputeTwoTissueCompartmentFDGSignal(const mitk::AIFBasedModelBase* model,
+    const mitk::ModelBase::ParametersType& parameters)
+  {
+    const auto timeGrid = model->GetTimeGrid();
+    const auto aif = model->GetAterialInputFunction(timeGrid);
+
+    const double K1 = parameters[mitk::TwoTissueCompartmentFDGModel::POSITION_PARAMETER_K1] / 60.0;
+    const double k2 = parameters[mitk::TwoTissueCompartmentFDGModel::POSITION_PARAMETER_k2] / 60.0;
+    const double k3 = parameters[mitk::TwoTissueCompartmentFDGModel::POSITION_PARAMETER_k3] / 60.0;
+    const double vb = parameters[mitk::TwoTissueCompartmentFDGModel::POSITION_PARAMETER_vb];
+
+    const double lambda = k2 + k3;
+    const auto exp = mitk::convoluteAIFWithExponential(timeGrid, aif, lambda);
+    const auto CA = mitk::convoluteAIFWithConstant(timeGrid, aif, k3);
+
+    mitk::ModelBase::ModelResultType signal(timeGrid.GetSize());
+    for (unsigned int i = 0; i < signal.GetSize(); ++i)
+    {
+      const double Ci = K1 * k2 / lambda * exp[i] + K1 * k3 / lambda * CA[i];
+      signal[i] = vb * aif[i] + (1 - vb) * Ci;
+    }
+    return signal;
+  }
+
+public:
+  void setUp() override
+  {
+    m_TimeGrid.SetSize(NumberOfTimePoints);
+    m_AIF.SetSize(NumberOfTimePoints);
+    for (unsigned int i = 0; i < NumberOfTimePoints; ++i)
+    {
+      const double t = 2.5 * i;
+      m_TimeGrid[i] = t;
+      // gamma variate bolus with a plateau
+      m_AIF[i] = 6. * std::pow(t / 20., 3.) * std::exp(-t / 8.) + 0.3 * (1. - std::exp(-t / 30.));
+    }
+  }
+
+  void tearDown() override
+  {
+  }
+
+  void ScratchArraysKeepReferences()
+  {
+    mitk::ModelEvaluationWorkspace workspace;
+
+    auto& first = workspace.GetScratchArray(0, 10);
+    first.Fill(1.);
+    const double* firstData = first.data_block();
+
+    for (unsigned int i = 1; i < 100; ++i)
+    {
+      workspace.GetScratchArray(i, 10).Fill(2.);
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Reference of the first scratch array must stay valid", &first == &workspace.GetScratchArray(0, 10));
+    CPPUNIT_ASSERT(firstData == first.data_block());
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(1., first[i]);
+    }
+
+    auto& cache = workspace.GetCacheArray(0);
+    for (unsigned int i = 1; i < 100; ++i)
+    {
+      workspace.GetCacheArray(i);
+    }
+    CPPUNIT_ASSERT_MESSAGE("Reference of the first cache array must stay valid", &cache == &workspace.GetCacheArray(0));
+  }
+
+  void TwoTissueCompartmentModel()
+  {
+    auto model = mitk::TwoTissueCompartmentModel::New();
+    InitializeModel(model);
+
+    mitk::ModelBase::ParametersType parameters(model->GetNumberOfParameters());
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_K1] = 0.6;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k2] = 0.4;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k3] = 0.1;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k4] = 0.05;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_vb] = 0.04;
+
+    CheckModel(model, parameters, &ComputeTwoTissueCompartmentSignal);
+  }
+
+  void TwoCompartmentExchangeModel()
+  {
+    auto model = mitk::TwoCompartmentExchangeModel::New();
+    InitializeModel(model);
+
+    mitk::ModelBase::ParametersType parameters(model->GetNumberOfParameters());
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_F] = 60.;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_PS] = 10.;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_ve] = 0.3;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_vp] = 0.05;
+
+    CheckModel(model, parameters, &ComputeTwoCompartmentExchangeSignal);
+
+    // without exchange only one convolution is needed
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_PS] = 0.;
+    CheckModel(model, parameters, &ComputeTwoCompartmentExchangeSignal);
+  }
+
+  void TwoTissueCompartmentFDGModel()
+  {
+    auto model = mitk::TwoTissueCompartmentFDGModel::New();
+    InitializeModel(model);
+
+    mitk::ModelBase::ParametersType parameters(model->GetNumberOfParameters());
+    parameters[mitk::TwoTissueCompartmentFDGModel::POSITION_PARAMETER_K1] = 0.1;
+    parameters[mitk::TwoTissueCompartmentFDGModel::POSITION_PARAMETER_k2] = 0.15;
+    parameters[mitk::TwoTissueCompartmentFDGModel::POSITION_PARAMETER_k3] = 0.08;
+    parameters[mitk::TwoTissueCompartmentFDGModel::POSITION_PARAMETER_vb] = 0.05;
+
+    CheckModel(model, parameters, &ComputeTwoTissueCompartmentFDGSignal);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkModelEvaluationWorkspace)
@@ -119,6 +119,9 @@ namespace mitk
     */
       void MitkRender(mitk::BaseRenderer *renderer, mitk::VtkPropRenderer::RenderType type) override;
 
+    /** The figure only depends on the node, its planar figure and the world geometry of the renderer */
+    bool DependsOnOtherNodes() const override { return false; }
+
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
 
     /** \brief Apply color and opacity properties read from the PropertyList.
@@ -225,15 +225,20 @@ namespace mitk
           contourItem.getNumberOfContourPoints(numberOfPoints);
           contourItem.getContourData(contourData_LPS);
 
+          std::vector<mitk::Point3D> points;
+          points.reserve(contourData_LPS.size() / 3);
+
           for (unsigned int i = 0; i < contourData_LPS.size() / 3; i++)
           {
             mitk::Point3D point;
             point[0] = contourData_LPS.at(3 * i);
             point[1] = contourData_LPS.at(3 * i + 1);
             point[2] = contourData_LPS.at(3 * i + 2);
-            contourSequence->AddVertex(point);
+            points.push_back(point);
           }
 
+          contourSequence->AddVertices(points);
+
           contourSequence->Close();
           contourSet->AddContourModel(contourSequence);
         } while (contourSeqObject.gotoNextItem().good());
@@ -0,0 +1,431 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkContourModelSetRasterizer.h"
+
+#include <mitkContourModelSet.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImageHelper.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+
+namespace
+{
+  /** Pixel centers within this distance (in index coordinates) to the left or right of a contour are inside of it.*/
+  constexpr double Tolerance = 1e-6;
+
+  using Point2D = std::array<double, 2>;
+  using Polygon = std::vector<Point2D>;
+  using RunVectorType = mitk::ContourModelSetRasterizer::RunVectorType;
+
+  struct VolumeLayout
+  {
+    std::array<std::size_t, 3> dimensions;
+    std::array<std::size_t, 3> strides;
+  };
+
+  /** All contours of one contour set that lie in the same slice.*/
+  struct SliceTask
+  {
+    std::size_t setIndex = 0;
+    unsigned int sliceAxis = 0;
+    std::size_t slice = 0;
+    std::vector<Polygon> polygons;
+    RunVectorType runs;
+  };
+
+  VolumeLayout GetVolumeLayout(const mitk::BaseGeometry* geometry)
+  {
+    VolumeLayout layout;
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      layout.dimensions[axis] = static_cast<std::size_t>(std::max(1L, std::lround(geometry->GetExtent(axis))));
+    }
+    layout.strides = { 1, layout.dimensions[0], layout.dimensions[0] * layout.dimensions[1] };
+    return layout;
+  }
+
+  /** Rounded value (see roundFunction), clamped to [minValue, maxValue].*/
+  template <typename TRoundFunction>
+  long RoundAndClamp(double value, TRoundFunction roundFunction, long minValue, long maxValue)
+  {
+    const double rounded = roundFunction(value);
+    if (rounded < static_cast<double>(minValue))
+      return minValue;
+    if (rounded > static_cast<double>(maxValue))
+      return maxValue;
+    return static_cast<long>(rounded);
+  }
+
+  double Ceil(double value) { return std::ceil(value); }
+  double Floor(double value) { return std::floor(value); }
+
+  /** Axes of the rows (u) and of the columns (v) of a slice.*/
+  void GetInPlaneAxes(unsigned int sliceAxis, unsigned int& uAxis, unsigned int& vAxis)
+  {
+    uAxis = 0 == sliceAxis ? 1 : 0;
+    vAxis = 2 == sliceAxis ? 1 : 2;
+  }
+
+  void CollectSliceTasks(const mitk::ContourModelSet* contourSet, std::size_t setIndex, const mitk::BaseGeometry* geometry,
+    const VolumeLayout& layout, std::vector<SliceTask>& tasks)
+  {
+    std::map<std::pair<unsigned int, std::size_t>, std::size_t> taskIndexOfSlice;
+
+    for (int contourIndex = 0; contourIndex < contourSet->GetSize(); ++contourIndex)
+    {
+      const auto* contour = contourSet->GetContourModelAt(contourIndex);
+
+      // contours with less than three vertices do not enclose any pixel
+      if (nullptr == contour || contour->GetNumberOfVertices() < 3)
+        continue;
+
+      std::vector<mitk::Point3D> indexPoints;
+      indexPoints.reserve(contour->GetNumberOfVertices());
+      std::array<double, 3> minIndex = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+      std::array<double, 3> maxIndex = { std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest() };
+
+      for (auto vertexIter = contour->Begin(); vertexIter != contour->End(); ++vertexIter)
+      {
+        mitk::Point3D indexPoint;
+        geometry->WorldToIndex((*vertexIter)->Coordinates, indexPoint);
+        indexPoints.push_back(indexPoint);
+
+        for (unsigned int axis = 0; axis < 3; ++axis)
+        {
+          minIndex[axis] = std::min(minIndex[axis], indexPoint[axis]);
+          maxIndex[axis] = std::max(maxIndex[axis], indexPoint[axis]);
+        }
+      }
+
+      // The contour lies in a slice orthogonal to the axis with the smallest extent
+      unsigned int sliceAxis = 0;
+      for (unsigned int axis = 1; axis < 3; ++axis)
+      {
+        if (maxIndex[axis] - minIndex[axis] < maxIndex[sliceAxis] - minIndex[sliceAxis])
+          sliceAxis = axis;
+      }
+
+      if (maxIndex[sliceAxis] - minIndex[sliceAxis] >= 0.5)
+      {
+        MITK_ERROR << "Cannot detect correct slice number of contour " << contourIndex
+                   << "! Only axial, sagittal and coronal oriented contours are supported! Contour is skipped.";
+        continue;
+      }
+
+      const double slice = std::round((minIndex[sliceAxis] + maxIndex[sliceAxis]) / 2.0);
+      if (slice < 0.0 || slice >= static_cast<double>(layout.dimensions[sliceAxis]))
+        continue; // contour is outside of the volume
+
+      unsigned int uAxis = 0;
+      unsigned int vAxis = 0;
+      GetInPlaneAxes(sliceAxis, uAxis, vAxis);
+
+      Polygon polygon;
+      polygon.reserve(indexPoints.size());
+      for (const auto& indexPoint : indexPoints)
+      {
+        polygon.push_back({ indexPoint[uAxis], indexPoint[vAxis] });
+      }
+
+      const auto key = std::make_pair(sliceAxis, static_cast<std::size_t>(slice));
+      auto finding = taskIndexOfSlice.find(key);
+      if (finding == taskIndexOfSlice.end())
+      {
+        finding = taskIndexOfSlice.emplace(key, tasks.size()).first;
+        tasks.emplace_back();
+        tasks.back().setIndex = setIndex;
+        tasks.back().sliceAxis = sliceAxis;
+        tasks.back().slice = key.second;
+      }
+      tasks[finding->second].polygons.push_back(std::move(polygon));
+    }
+  }
+
+  /** Adds the pixel intervals [first, last] of row y that are inside the polygons (even-odd rule).*/
+  void AddIntervals(const std::vector<const Polygon*>& polygons, double y, long maxU,
+    std::vector<double>& crossings, std::vector<std::pair<long, long>>& intervals)
+  {
+    crossings.clear();
+    for (const auto* polygon : polygons)
+    {
+      const std::size_t numberOfPoints = polygon->size();
+      for (std::size_t i = 0; i < numberOfPoints; ++i)
+      {
+        const auto& p = (*polygon)[i];
+        const auto& q = (*polygon)[(i + 1) % numberOfPoints];
+
+        // half open, so that a vertex on the row is counted once
+        if ((p[1] <= y && y < q[1]) || (q[1] <= y && y < p[1]))
+        {
+          crossings.push_back(p[0] + (y - p[1]) * (q[0] - p[0]) / (q[1] - p[1]));
+        }
+      }
+    }
+
+    std::sort(crossings.begin(), crossings.end());
+
+    for (std::size_t i = 0; i + 1 < crossings.size(); i += 2)
+    {
+      const long first = RoundAndClamp(crossings[i] - Tolerance, Ceil, 0, maxU + 1);
+      const long last = RoundAndClamp(crossings[i + 1] + Tolerance, Floor, -1, maxU);
+      if (first <= last)
+      {
+        intervals.emplace_back(first, last);
+      }
+    }
+  }
+
+  void ScanConvert(SliceTask& task, const VolumeLayout& layout, bool useEvenOddRule)
+  {
+    unsigned int uAxis = 0;
+    unsigned int vAxis = 0;
+    GetInPlaneAxes(task.sliceAxis, uAxis, vAxis);
+
+    const long maxU = static_cast<long>(layout.dimensions[uAxis]) - 1;
+    const long maxV = static_cast<long>(layout.dimensions[vAxis]) - 1;
+
+    // Polygons that are filled together
+    std::vector<std::vector<const Polygon*>> fillUnits;
+    if (useEvenOddRule)
+    {
+      fillUnits.emplace_back();
+      for (const auto& polygon : task.polygons)
+        fillUnits.back().push_back(&polygon);
+    }
+    else
+    {
+      for (const auto& polygon : task.polygons)
+        fillUnits.push_back({ &polygon });
+    }
+
+    std::vector<std::pair<long, long>> rowRanges;
+    long firstRow = maxV + 1;
+    long lastRow = -1;
+    for (const auto& fillUnit : fillUnits)
+    {
+      double minV = std::numeric_limits<double>::max();
+      double maxVOfUnit = std::numeric_limits<double>::lowest();
+      for (const auto* polygon : fillUnit)
+      {
+        for (const auto& point : *polygon)
+        {
+          minV = std::min(minV, point[1]);
+          maxVOfUnit = std::max(maxVOfUnit, point[1]);
+        }
+      }
+      rowRanges.emplace_back(RoundAndClamp(minV - Tolerance, Ceil, 0, maxV + 1),
+                             RoundAndClamp(maxVOfUnit + Tolerance, Floor, -1, maxV));
+      firstRow = std::min(firstRow, rowRanges.back().first);
+      lastRow = std::max(lastRow, rowRanges.back().second);
+    }
+
+    const std::size_t sliceOffset = task.slice * layout.strides[task.sliceAxis];
+    std::vector<double> crossings;
+    std::vector<std::pair<long, long>> intervals;
+
+    for (long row = firstRow; row <= lastRow; ++row)
+    {
+      intervals.clear();
+      for (std::size_t unit = 0; unit < fillUnits.size(); ++unit)
+      {
+        if (row < rowRanges[unit].first || row > rowRanges[unit].second)
+          continue;
+
+        // Edges are half open in row direction (like the raster of vtkPolyDataToImageStencil that was used
+        // before): pixels on the lower horizontal edges of a polygon are inside, pixels on its upper ones are not.
+        AddIntervals(fillUnits[unit], row, maxU, crossings, intervals);
+      }
+
+      if (intervals.empty())
+        continue;
+
+      std::sort(intervals.begin(), intervals.end());
+
+      const std::size_t rowOffset = sliceOffset + row * layout.strides[vAxis];
+      auto current = intervals.front();
+      for (std::size_t i = 1; i <= intervals.size(); ++i)
+      {
+        if (i < intervals.size() && intervals[i].first <= current.second + 1)
+        {
+          current.second = std::max(current.second, intervals[i].second);
+          continue;
+        }
+
+        task.runs.push_back({ rowOffset + current.first * layout.strides[uAxis],
+                              static_cast<std::size_t>(current.second - current.first + 1),
+                              layout.strides[uAxis] });
+
+        if (i < intervals.size())
+          current = intervals[i];
+      }
+    }
+  }
+
+  void ScanConvertInParallel(std::vector<SliceTask>& tasks, const VolumeLayout& layout, bool useEvenOddRule)
+  {
+    if (tasks.empty())
+      return;
+
+    auto multiThreader = itk::MultiThreaderBase::New();
+    multiThreader->ParallelizeArray(0, tasks.size(), [&](itk::SizeValueType taskIndex)
+    {
+      ScanConvert(tasks[taskIndex], layout, useEvenOddRule);
+    }, nullptr);
+  }
+
+  template <typename TPixel>
+  void FillRunsTyped(const RunVectorType& runs, double pixelValue, void* volumeBuffer)
+  {
+    const auto value = static_cast<TPixel>(pixelValue);
+    auto* pixels = static_cast<TPixel*>(volumeBuffer);
+    for (const auto& run : runs)
+    {
+      TPixel* pixel = pixels + run.offset;
+      if (1 == run.step)
+      {
+        std::fill_n(pixel, run.length, value);
+      }
+      else
+      {
+        for (std::size_t i = 0; i < run.length; ++i)
+          pixel[i * run.step] = value;
+      }
+    }
+  }
+
+  bool IsAnyVoxelLabeled(const RunVectorType& runs, const mitk::Image* groupImage, mitk::TimeStepType timeStep)
+  {
+    mitk::ImageReadAccessor accessor(groupImage, groupImage->GetVolumeData(timeStep));
+    const auto* pixels = static_cast<const mitk::LabelSetImage::PixelType*>(accessor.GetData());
+
+    for (const auto& run : runs)
+    {
+      for (std::size_t i = 0; i < run.length; ++i)
+      {
+        if (mitk::LabelSetImage::UNLABELED_VALUE != pixels[run.offset + i * run.step])
+          return true;
+      }
+    }
+    return false;
+  }
+}
+
+mitk::ContourModelSetRasterizer::RunVectorType mitk::ContourModelSetRasterizer::ComputeRuns(
+  const ContourModelSet* contourSet, const BaseGeometry* geometry, bool useEvenOddRule)
+{
+  if (nullptr == contourSet || nullptr == geometry)
+    mitkThrow() << "Cannot rasterize contours. Contour set or geometry is invalid.";
+
+  const auto layout = GetVolumeLayout(geometry);
+
+  std::vector<SliceTask> tasks;
+  CollectSliceTasks(contourSet, 0, geometry, layout, tasks);
+  ScanConvertInParallel(tasks, layout, useEvenOddRule);
+
+  RunVectorType runs;
+  for (const auto& task : tasks)
+    runs.insert(runs.end(), task.runs.begin(), task.runs.end());
+
+  return runs;
+}
+
+void mitk::ContourModelSetRasterizer::FillRuns(const RunVectorType& runs, double value, const PixelType& pixelType, void* volumeBuffer)
+{
+  if (1 != pixelType.GetNumberOfComponents())
+    mitkThrow() << "Cannot fill contours. Only images with scalar pixels are supported.";
+
+  switch (pixelType.GetComponentType())
+  {
+    case itk::IOComponentEnum::UCHAR: FillRunsTyped<unsigned char>(runs, value, volumeBuffer); break;
+    case itk::IOComponentEnum::CHAR: FillRunsTyped<char>(runs, value, volumeBuffer); break;
+    case itk::IOComponentEnum::USHORT: FillRunsTyped<unsigned short>(runs, value, volumeBuffer); break;
+    case itk::IOComponentEnum::SHORT: FillRunsTyped<short>(runs, value, volumeBuffer); break;
+    case itk::IOComponentEnum::UINT: FillRunsTyped<unsigned int>(runs, value, volumeBuffer); break;
+    case itk::IOComponentEnum::INT: FillRunsTyped<int>(runs, value, volumeBuffer); break;
+    case itk::IOComponentEnum::ULONG: FillRunsTyped<unsigned long>(runs, value, volumeBuffer); break;
+    case itk::IOComponentEnum::LONG: FillRunsTyped<long>(runs, value, volumeBuffer); break;
+    case itk::IOComponentEnum::FLOAT: FillRunsTyped<float>(runs, value, volumeBuffer); break;
+    case itk::IOComponentEnum::DOUBLE: FillRunsTyped<double>(runs, value, volumeBuffer); break;
+    default: mitkThrow() << "Cannot fill contours. Unsupported pixel type: " << pixelType.GetComponentTypeAsString();
+  }
+}
+
+mitk::LabelSetImage::Pointer mitk::ContourModelSetRasterizer::RasterizeToMultiLabelSegmentation(const Image* referenceImage,
+  const std::vector<const ContourModelSet*>& contourSets, bool useEvenOddRule, TimeStepType timeStep)
+{
+  if (nullptr == referenceImage)
+    mitkThrow() << "Cannot rasterize contour sets. No reference image passed.";
+
+  if (std::find(contourSets.begin(), contourSets.end(), nullptr) != contourSets.end())
+    mitkThrow() << "Cannot rasterize contour sets. Invalid contour set passed.";
+
+  if (contourSets.size() >= std::numeric_limits<LabelSetImage::LabelValueType>::max())
+    mitkThrow() << "Cannot rasterize contour sets. Too many contour sets: " << contourSets.size();
+
+  auto segmentation = LabelSetImage::New();
+  segmentation->Initialize(referenceImage);
+
+  if (timeStep >= segmentation->GetTimeSteps())
+    mitkThrow() << "Cannot rasterize contour sets. Invalid time step: " << timeStep;
+
+  const auto* geometry = segmentation->GetGeometry(timeStep);
+  const auto layout = GetVolumeLayout(geometry);
+
+  // Rasterize all contour sets at once, so that the slices of all sets are processed in parallel
+  std::vector<SliceTask> tasks;
+  for (std::size_t setIndex = 0; setIndex < contourSets.size(); ++setIndex)
+    CollectSliceTasks(contourSets[setIndex], setIndex, geometry, layout, tasks);
+
+  ScanConvertInParallel(tasks, layout, useEvenOddRule);
+
+  std::vector<RunVectorType> runsOfSets(contourSets.size());
+  for (const auto& task : tasks)
+  {
+    auto& runs = runsOfSets[task.setIndex];
+    runs.insert(runs.end(), task.runs.begin(), task.runs.end());
+  }
+
+  for (std::size_t setIndex = 0; setIndex < contourSets.size(); ++setIndex)
+  {
+    const auto labelValue = static_cast<LabelSetImage::LabelValueType>(setIndex + 1);
+    const auto& runs = runsOfSets[setIndex];
+
+    // Use the first group that has no labeled voxel within the contours
+    LabelSetImage::GroupIndexType groupID = 0;
+    while (groupID < segmentation->GetNumberOfLayers() && IsAnyVoxelLabeled(runs, segmentation->GetGroupImage(groupID), timeStep))
+      ++groupID;
+
+    if (groupID == segmentation->GetNumberOfLayers())
+      groupID = segmentation->AddLayer();
+
+    auto* groupImage = segmentation->GetGroupImage(groupID);
+    {
+      ImageWriteAccessor accessor(groupImage, groupImage->GetVolumeData(timeStep));
+      FillRuns(runs, labelValue, groupImage->GetPixelType(), accessor.GetData());
+    }
+    groupImage->Modified();
+
+    auto label = LabelSetImageHelper::CreateNewLabel(segmentation);
+    label->SetValue(labelValue);
+    segmentation->AddLabel(label, groupID, false, false);
+  }
+
+  return segmentation;
+}
@@ -0,0 +1,82 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkContourModelSetRasterizer_h
+#define mitkContourModelSetRasterizer_h
+
+#include <MitkSegmentationExports.h>
+#include <mitkLabelSetImage.h>
+
+#include <vector>
+
+namespace mitk
+{
+  class BaseGeometry;
+  class ContourModelSet;
+
+  /**
+    * @brief Scan converts the planar contours of contour model sets directly into image buffers.
+    *
+    * Every contour has to lie in a slice of the image geometry (orthogonal to one of its index axes).
+    * The contours are grouped by slice and the polygons of each slice are scan converted row by row;
+    * pixels whose centers lie inside a polygon are filled. Pixel centers on the left and right boundary of a row
+    * and on lower horizontal edges are inside, centers on upper horizontal edges are outside (same results as
+    * the vtkPolyDataToImageStencil based filling of ContourModelUtils). Slices are processed in parallel.
+    * The result is a list of voxel runs that can be filled into a volume without reslicing.
+    * @ingroup Process
+    */
+  class MITKSEGMENTATION_EXPORT ContourModelSetRasterizer
+  {
+  public:
+    /** Voxels of one image row: linear index of the first voxel, number of voxels and distance between two voxels of the run.*/
+    struct Run
+    {
+      std::size_t offset;
+      std::size_t length;
+      std::size_t step;
+    };
+
+    using RunVectorType = std::vector<Run>;
+
+    /**
+      * @brief Computes the voxels of a volume that are inside the contours (time step 0) of the set.
+      * @param contourSet Contours to rasterize.
+      * @param geometry Geometry of the volume.
+      * @param useEvenOddRule If true, all contours of a slice are combined with the even-odd rule, so that
+      * contours within other contours cut holes (as in DICOM RTSTRUCT). Otherwise each contour is filled on its own.
+      * Contours that do not lie in a slice of the geometry are skipped.
+      */
+    static RunVectorType ComputeRuns(const ContourModelSet* contourSet, const BaseGeometry* geometry, bool useEvenOddRule);
+
+    /**
+      * @brief Sets all voxels of the runs to the passed value.
+      * @param volumeBuffer Buffer of a volume with scalar pixels of the passed type.
+      */
+    static void FillRuns(const RunVectorType& runs, double value, const PixelType& pixelType, void* volumeBuffer);
+
+    /**
+      * @brief Rasterizes contour sets (e.g. the ROIs of a DICOM RTSTRUCT) into one new multi-label segmentation.
+      *
+      * All contour sets and their slices are rasterized in parallel. The contour set with index i becomes the label
+      * with value i+1 (with default name and color). Contour sets that do not overlap share a group; a new group is
+      * only added for a contour set that overlaps labels of every existing group.
+      * @param referenceImage Defines the geometry of the segmentation.
+      * @param contourSets Contour sets to rasterize. Must not contain null pointers.
+      * @param useEvenOddRule See ComputeRuns().
+      * @param timeStep Time step of the segmentation the contours are filled into.
+      */
+    static LabelSetImage::Pointer RasterizeToMultiLabelSegmentation(const Image* referenceImage,
+      const std::vector<const ContourModelSet*>& contourSets, bool useEvenOddRule = false, TimeStepType timeStep = 0);
+  };
+}
+
+#endif
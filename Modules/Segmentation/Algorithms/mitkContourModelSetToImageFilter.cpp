@@ -13,18 +13,17 @@ found in the LICENSE file.
 #include "mitkContourModelSetToImageFilter.h"
 
 #include <mitkContourModelSet.h>
-#include <mitkContourModelUtils.h>
-#include <mitkExtractSliceFilter.h>
+#include <mitkContourModelSetRasterizer.h>
 #include <mitkImageWriteAccessor.h>
 #include <mitkProgressBar.h>
 #include <mitkTimeHelper.h>
 #include <mitkLabel.h>
-#include <mitkVtkImageOverwrite.h>
 
 mitk::ContourModelSetToImageFilter::ContourModelSetToImageFilter()
   : m_MakeOutputBinary(true),
     m_MakeOutputLabelPixelType(false),
     m_PaintingPixelValue(1),
+    m_UseEvenOddRule(false),
     m_TimeStep(0),
     m_ReferenceImage(nullptr)
 {
@@ -143,10 +142,10 @@ const mitk::Image *mitk::ContourModelSetToImageFilter::GetImage(void)
 
 void mitk::ContourModelSetToImageFilter::GenerateData()
 {
-  auto *contourSet = const_cast<mitk::ContourModelSet *>(this->GetInput());
+  const auto *contourSet = this->GetInput();
 
   // Initializing progressbar
-  unsigned int num_contours = contourSet->GetContourModelList()->size();
+  unsigned int num_contours = nullptr != contourSet ? contourSet->GetSize() : 0;
   mitk::ProgressBar::GetInstance()->AddStepsToDo(num_contours);
 
   // Assure that the volume data of the output is set (fill volume with zeros)
@@ -159,113 +158,23 @@ void mitk::ContourModelSetToImageFilter::GenerateData()
     mitkThrow() << "Error creating output for specified image!";
   }
 
-  if (!contourSet || contourSet->GetContourModelList()->size() == 0)
+  if (0 == num_contours)
   {
     mitkThrow() << "No contours specified!";
   }
 
-  mitk::BaseGeometry *outputImageGeo = outputImage->GetGeometry(m_TimeStep);
+  // Scan convert all contours (slices in parallel) and fill them directly into the volume,
+  // instead of extracting, filling and writing back a slice per contour.
+  auto runs = ContourModelSetRasterizer::ComputeRuns(contourSet, outputImage->GetGeometry(m_TimeStep), m_UseEvenOddRule);
 
-  // Create mitkVtkImageOverwrite which is needed to write the slice back into the volume
-  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-  // Create ExtractSliceFilter for extracting the corresponding slices from the volume
-  mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-  extractor->SetInput(outputImage);
-  extractor->SetTimeStep(m_TimeStep);
-  extractor->SetResliceTransformByGeometry(outputImageGeo);
-
-  // Fill each contour of the contourmodelset into the image
-  auto it = contourSet->Begin();
-  auto end = contourSet->End();
-  while (it != end)
   {
-    mitk::ContourModel *contour = it->GetPointer();
-
-    // 1. Create slice geometry using the contour points
-    mitk::PlaneGeometry::Pointer plane = mitk::PlaneGeometry::New();
-    mitk::Point3D point3D, tempPoint;
-    mitk::Vector3D normal;
-
-    mitk::Image::Pointer slice;
-
-    int sliceIndex;
-    bool isFrontside = true;
-    bool isRotated = false;
-
-    // Determine plane orientation
-    point3D = contour->GetVertexAt(0)->Coordinates;
-    tempPoint = contour->GetVertexAt(contour->GetNumberOfVertices() * 0.25)->Coordinates;
-    mitk::Vector3D vec = point3D - tempPoint;
-    vec.Normalize();
-    outputImageGeo->WorldToIndex(point3D, point3D);
-
-    mitk::AnatomicalPlane orientation;
-    if (mitk::Equal(vec[0], 0))
-    {
-      orientation = mitk::AnatomicalPlane::Sagittal;
-      sliceIndex = point3D[0];
-    }
-    else if (mitk::Equal(vec[1], 0))
-    {
-      orientation = mitk::AnatomicalPlane::Coronal;
-      sliceIndex = point3D[1];
-    }
-    else if (mitk::Equal(vec[2], 0))
-    {
-      orientation = mitk::AnatomicalPlane::Axial;
-      sliceIndex = point3D[2];
-    }
-    else
-    {
-      // TODO Maybe rotate geometry to extract slice?
-      MITK_ERROR
-        << "Cannot detect correct slice number! Only axial, sagittal and coronal oriented contours are supported!";
-      return;
-    }
-
-    // Initialize plane using the detected orientation
-    plane->InitializeStandardPlane(outputImageGeo, orientation, sliceIndex, isFrontside, isRotated);
-    point3D = plane->GetOrigin();
-    normal = plane->GetNormal();
-    normal.Normalize();
-    point3D += normal * 0.5; // pixelspacing is 1, so half the spacing is 0.5
-    plane->SetOrigin(point3D);
-
-    // 2. Extract slice at the given position
-    extractor->SetWorldGeometry(plane);
-    extractor->SetVtkOutputRequest(false);
-    reslice->SetOverwriteMode(false);
-
-    extractor->Modified();
-    extractor->Update();
-
-    slice = extractor->GetOutput();
-    slice->DisconnectPipeline();
-
-    // 3. Fill contour into slice
-    mitk::ContourModel::Pointer projectedContour =
-      mitk::ContourModelUtils::ProjectContourTo2DSlice(slice, contour);
-    mitk::ContourModelUtils::FillContourInSlice(projectedContour, slice, outputImage, m_PaintingPixelValue);
-
-    // 4. Write slice back into image volume
-    reslice->SetInputSlice(slice->GetVtkImageData());
-
-    // set overwrite mode to true to write back to the image volume
-    reslice->SetOverwriteMode(true);
-    reslice->Modified();
-
-    extractor->Modified();
-    extractor->Update();
-
-    reslice->SetInputSlice(nullptr);
-
-    // Progress
-    mitk::ProgressBar::GetInstance()->Progress();
-
-    ++it;
+    mitk::ImageWriteAccessor writeAccess(outputImage, outputImage->GetVolumeData(m_TimeStep));
+    ContourModelSetRasterizer::FillRuns(runs, m_PaintingPixelValue, outputImage->GetPixelType(), writeAccess.GetData());
   }
 
+  // Progress
+  mitk::ProgressBar::GetInstance()->Progress(num_contours);
+
   outputImage->Modified();
   outputImage->GetVtkImageData()->Modified();
 }
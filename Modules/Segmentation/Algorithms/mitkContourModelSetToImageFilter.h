@@ -22,6 +22,10 @@ namespace mitk
 
   /**
     * @brief Fills a given mitk::ContourModelSet into a given mitk::Image
+    *
+    * The contours are scan converted directly into the output volume (see mitk::ContourModelSetRasterizer).
+    * If UseEvenOddRule is on, contours within other contours of the same slice cut holes (as in DICOM RTSTRUCT).
+    * Otherwise (default) every contour is filled on its own.
     * @ingroup Process
     */
   class MITKSEGMENTATION_EXPORT ContourModelSetToImageFilter : public ImageSource
@@ -35,13 +39,16 @@ namespace mitk
     virtual void SetMakeOutputLabelPixelType(bool makeOutputLabelPixelType);
     itkSetMacro(PaintingPixelValue, int);
     itkSetMacro(TimeStep, unsigned int);
+    itkSetMacro(UseEvenOddRule, bool);
 
     itkGetMacro(MakeOutputBinary, bool);
     itkGetMacro(MakeOutputLabelPixelType, bool);
     itkGetMacro(PaintingPixelValue, int);
+    itkGetMacro(UseEvenOddRule, bool);
 
     itkBooleanMacro(MakeOutputBinary);
     itkBooleanMacro(MakeOutputLabelPixelType);
+    itkBooleanMacro(UseEvenOddRule);
 
     /**
        * Allocates a new output object and returns it. Currently the
@@ -91,6 +98,7 @@ namespace mitk
     bool m_MakeOutputBinary;
     bool m_MakeOutputLabelPixelType;
     int m_PaintingPixelValue;
+    bool m_UseEvenOddRule;
 
     unsigned int m_TimeStep;
 
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
 #include "mitkImageTimeSelector.h"
+#include "mitkPixelTypeMultiplex.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegmentationInterpolationController.h"
 
@@ -103,7 +104,7 @@ void mitk::DiffImageApplier::ExecuteOperation(Operation *operation)
         image3D = timeSelector->GetOutput();
       }
 
-      AccessFixedDimensionByItk(image3D, ItkImageSwitch2DDiff, 3);
+      mitkPixelTypeMultiplex1(ApplySliceDiff, image3D->GetPixelType(), image3D);
 
       if (m_Factor == 1 || m_Factor == -1)
       {
@@ -122,6 +123,7 @@ void mitk::DiffImageApplier::ExecuteOperation(Operation *operation)
           interpolator->SetChangedSlice(m_SliceDifferenceImage, m_SliceDimension, m_SliceIndex, m_TimeStep);
         }
 
+        m_Image->AddModifiedRegion(m_TimeStep, this->GetChangedSliceRegion());
         m_Image->Modified();
 
         if (interpolator)
@@ -136,6 +138,7 @@ void mitk::DiffImageApplier::ExecuteOperation(Operation *operation)
       }
       else // no trivial case, too lazy to do something else
       {
+        m_Image->AddModifiedRegion(m_TimeStep, this->GetChangedSliceRegion());
         m_Image->Modified(); // check if interpolation is called. prefer to send diff directly
       }
 
@@ -221,6 +224,18 @@ void mitk::DiffImageApplier::ExecuteOperation(Operation *operation)
   m_SliceDifferenceImage = nullptr;
 }
 
+mitk::Image::ModifiedRegionType mitk::DiffImageApplier::GetChangedSliceRegion() const
+{
+  Image::ModifiedRegionType region;
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    region.SetSize(d, m_Image->GetDimension(d));
+  }
+  region.SetIndex(m_SliceDimension, m_SliceIndex);
+  region.SetSize(m_SliceDimension, 1);
+  return region;
+}
+
 mitk::DiffImageApplier *mitk::DiffImageApplier::GetInstanceForUndo()
 {
   static DiffImageApplier::Pointer s_Instance = DiffImageApplier::New();
@@ -269,6 +284,20 @@ mitk::DiffImageApplier *mitk::DiffImageApplier::GetInstanceForUndo()
   \
 }
 
+template <typename TPixel>
+void mitk::DiffImageApplier::ApplySliceDiff(const PixelType &, Image *image3D)
+{
+  typedef itk::Image<TPixel, 3> VolumeImageType;
+
+  auto imageToItk = ImageToItk<VolumeImageType>::New();
+  imageToItk->SetInput(image3D);
+  // only the slice is written, not the whole volume
+  imageToItk->SetModifiedRegion(this->GetChangedSliceRegion());
+  imageToItk->Update();
+
+  this->ItkImageSwitch2DDiff(imageToItk->GetOutput());
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::DiffImageApplier::ItkImageSwitch2DDiff(itk::Image<TPixel, VImageDimension> *itkImage)
 {
@@ -51,6 +51,10 @@ namespace mitk
     DiffImageApplier(); // purposely hidden
     ~DiffImageApplier() override;
 
+    /** Applies the slice difference to the volume image3D. Only the changed slice is reported as modified region.*/
+    template <typename TPixel>
+    void ApplySliceDiff(const PixelType &pixelType, Image *image3D);
+
     template <typename TPixel, unsigned int VImageDimension>
     void ItkImageSwitch2DDiff(itk::Image<TPixel, VImageDimension> *image);
 
@@ -68,6 +72,9 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void ItkInvertPixelValues(itk::Image<TPixel, VImageDimension> *itkImage);
 
+    /** Returns the region of the volume that is covered by the slice m_SliceIndex in direction m_SliceDimension.*/
+    Image::ModifiedRegionType GetChangedSliceRegion() const;
+
     Image::Pointer m_Image;
     Image::Pointer m_SliceDifferenceImage;
 
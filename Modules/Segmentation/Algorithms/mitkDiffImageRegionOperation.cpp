@@ -0,0 +1,176 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDiffImageRegionOperation.h"
+
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itkCommand.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+mitk::DiffImageRegionOperation::DiffImageRegionOperation(Image *imageVolume,
+                                                         TimeStepType timestep,
+                                                         const RegionType &region,
+                                                         const PlaneListType &planes)
+  : Operation(1), m_Image(imageVolume), m_TimeStep(timestep), m_Region(region), m_DeleteObserverTag(0)
+{
+  for (const auto &plane : planes)
+  {
+    m_Planes.push_back(plane->Clone().GetPointer());
+  }
+
+  if (m_Image)
+  {
+    m_CompressedImageContainer.CompressImage(ExtractRegion(m_Image, m_TimeStep, m_Region));
+
+    /*add an observer to listen to the delete event of the image, this is necessary because the operation is then
+     * invalid*/
+    itk::SimpleMemberCommand<DiffImageRegionOperation>::Pointer command =
+      itk::SimpleMemberCommand<DiffImageRegionOperation>::New();
+    command->SetCallbackFunction(this, &DiffImageRegionOperation::OnImageDeleted);
+    // get the id of the observer, used to remove it later on
+    m_DeleteObserverTag = imageVolume->AddObserver(itk::DeleteEvent(), command);
+
+    m_ImageIsValid = true;
+  }
+  else
+    m_ImageIsValid = false;
+}
+
+mitk::DiffImageRegionOperation::~DiffImageRegionOperation()
+{
+  if (m_ImageIsValid)
+  {
+    // if the image is still there, we have to remove the observer from it
+    m_Image->RemoveObserver(m_DeleteObserverTag);
+  }
+  m_Image = nullptr;
+}
+
+mitk::Image::Pointer mitk::DiffImageRegionOperation::GetRegionImage() const
+{
+  return m_CompressedImageContainer.DecompressImage();
+}
+
+bool mitk::DiffImageRegionOperation::IsValid() const
+{
+  return m_ImageIsValid;
+}
+
+void mitk::DiffImageRegionOperation::OnImageDeleted()
+{
+  // if our imageVolume is removed e.g. from the datastorage the operation is no longer valid
+  m_ImageIsValid = false;
+}
+
+mitk::Image::Pointer mitk::DiffImageRegionOperation::ExtractRegion(const Image *image,
+                                                                   TimeStepType timestep,
+                                                                   const RegionType &region)
+{
+  const auto pixelSize = image->GetPixelType().GetSize();
+  const std::size_t dimX = image->GetDimension(0);
+  const std::size_t dimY = image->GetDimension(1);
+
+  unsigned int dimensions[3] = { static_cast<unsigned int>(region.GetSize(0)),
+                                 static_cast<unsigned int>(region.GetSize(1)),
+                                 static_cast<unsigned int>(region.GetSize(2)) };
+  auto regionImage = Image::New();
+  regionImage->Initialize(image->GetPixelType(), 3, dimensions);
+
+  ImageReadAccessor readAccess(image, image->GetVolumeData(timestep));
+  ImageWriteAccessor writeAccess(regionImage, regionImage->GetVolumeData(0));
+  auto source = static_cast<const char *>(readAccess.GetData());
+  auto target = static_cast<char *>(writeAccess.GetData());
+
+  // the lines of the region are independent, so they are copied in parallel
+  const std::size_t lineSize = region.GetSize(0) * pixelSize;
+  const int numberOfLines = static_cast<int>(region.GetSize(1) * region.GetSize(2));
+#pragma omp parallel for
+  for (int line = 0; line < numberOfLines; ++line)
+  {
+    const std::size_t y = region.GetIndex(1) + line % region.GetSize(1);
+    const std::size_t z = region.GetIndex(2) + line / region.GetSize(1);
+    const std::size_t sourceOffset = ((z * dimY + y) * dimX + region.GetIndex(0)) * pixelSize;
+    std::memcpy(target + line * lineSize, source + sourceOffset, lineSize);
+  }
+
+  return regionImage;
+}
+
+void mitk::DiffImageRegionOperation::WriteRegion(Image *image,
+                                                 TimeStepType timestep,
+                                                 const RegionType &region,
+                                                 const Image *regionImage)
+{
+  const auto pixelSize = image->GetPixelType().GetSize();
+  const std::size_t dimX = image->GetDimension(0);
+  const std::size_t dimY = image->GetDimension(1);
+
+  ImageReadAccessor readAccess(regionImage, regionImage->GetVolumeData(0));
+  ImageWriteAccessor writeAccess(image, image->GetVolumeData(timestep));
+  writeAccess.SetModifiedRegion(region);
+  auto source = static_cast<const char *>(readAccess.GetData());
+  auto target = static_cast<char *>(writeAccess.GetData());
+
+  const std::size_t lineSize = region.GetSize(0) * pixelSize;
+  const int numberOfLines = static_cast<int>(region.GetSize(1) * region.GetSize(2));
+#pragma omp parallel for
+  for (int line = 0; line < numberOfLines; ++line)
+  {
+    const std::size_t y = region.GetIndex(1) + line % region.GetSize(1);
+    const std::size_t z = region.GetIndex(2) + line / region.GetSize(1);
+    const std::size_t targetOffset = ((z * dimY + y) * dimX + region.GetIndex(0)) * pixelSize;
+    std::memcpy(target + targetOffset, source + line * lineSize, lineSize);
+  }
+}
+
+mitk::DiffImageRegionOperation::RegionType mitk::DiffImageRegionOperation::ComputeAffectedRegion(const Image *image,
+                                                                                                TimeStepType timestep,
+                                                                                                const PlaneListType &planes)
+{
+  const auto geometry = image->GetGeometry(timestep);
+
+  itk::Index<3> minIndex;
+  itk::Index<3> maxIndex;
+  minIndex.Fill(itk::NumericTraits<itk::IndexValueType>::max());
+  maxIndex.Fill(itk::NumericTraits<itk::IndexValueType>::NonpositiveMin());
+
+  for (const auto &plane : planes)
+  {
+    for (int corner = 0; corner < 8; ++corner)
+    {
+      Point3D index;
+      geometry->WorldToIndex(plane->GetCornerPoint(corner), index);
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        // one voxel margin to also cover voxels touched by the reslicing of oblique planes
+        minIndex[d] = std::min<itk::IndexValueType>(minIndex[d], static_cast<itk::IndexValueType>(std::floor(index[d])) - 1);
+        maxIndex[d] = std::max<itk::IndexValueType>(maxIndex[d], static_cast<itk::IndexValueType>(std::ceil(index[d])) + 1);
+      }
+    }
+  }
+
+  RegionType region;
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    minIndex[d] = std::max<itk::IndexValueType>(minIndex[d], 0);
+    maxIndex[d] = std::min<itk::IndexValueType>(maxIndex[d], image->GetDimension(d) - 1);
+    region.SetIndex(d, minIndex[d]);
+    region.SetSize(d, maxIndex[d] < minIndex[d] ? 0 : maxIndex[d] - minIndex[d] + 1);
+  }
+  return region;
+}
@@ -0,0 +1,104 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDiffImageRegionOperation_h
+#define mitkDiffImageRegionOperation_h
+
+#include "mitkCompressedImageContainer.h"
+#include <MitkSegmentationExports.h>
+#include <mitkOperation.h>
+#include <mitkPlaneGeometry.h>
+
+#include <itkImageRegion.h>
+
+#include <vector>
+
+namespace mitk
+{
+  class Image;
+
+  /** \brief An Operation for restoring the content of a region of an image volume.
+    \sa DiffImageRegionOperationApplier
+
+    On construction the operation stores (compressed) the current content of the passed region
+    of the image volume. Executing the operation writes this content back into the volume.
+    It is used to undo/redo write operations that affect many slices at once (e.g. the batched
+    write back of SegTool2D) with a single undo step instead of one DiffSliceOperation per slice.
+
+    The information for the operation is specified by properties:
+
+     imageVolume   the volume the region belongs to.
+     timestep      the timestep in an 4D image.
+     region        the affected region (index space of the volume).
+     planes        the planes that have been written; used to update the surface interpolation.
+  */
+  class MITKSEGMENTATION_EXPORT DiffImageRegionOperation : public Operation
+  {
+  public:
+    mitkClassMacro(DiffImageRegionOperation, OperationActor);
+
+    using RegionType = itk::ImageRegion<3>;
+    using PlaneListType = std::vector<PlaneGeometry::ConstPointer>;
+
+    /** \brief Creates the operation and stores the current content of the region of the image volume.*/
+    DiffImageRegionOperation(mitk::Image *imageVolume,
+                             const TimeStepType timestep,
+                             const RegionType &region,
+                             const PlaneListType &planes);
+
+    /** \brief Check if it is a valid operation.*/
+    bool IsValid() const;
+
+    /** \brief Get the image volume.*/
+    mitk::Image *GetImage() { return this->m_Image; }
+    const mitk::Image *GetImage() const { return this->m_Image; }
+
+    /** \brief Get the stored content of the region as 3D image.*/
+    Image::Pointer GetRegionImage() const;
+
+    TimeStepType GetTimeStep() const { return this->m_TimeStep; }
+    const RegionType &GetRegion() const { return this->m_Region; }
+    const PlaneListType &GetPlanes() const { return this->m_Planes; }
+
+    /** \brief Copies the content of the region of the passed time step of image into a new 3D image.*/
+    static Image::Pointer ExtractRegion(const Image *image, TimeStepType timestep, const RegionType &region);
+
+    /** \brief Writes regionImage (as created by ExtractRegion) into the region of the passed time step of image.
+     * The image is not marked as modified.*/
+    static void WriteRegion(Image *image, TimeStepType timestep, const RegionType &region, const Image *regionImage);
+
+    /** \brief Computes the region (index space of the passed time step of image) that is covered by the planes.
+     * A margin of one voxel is added to also cover voxels touched by the reslicing of oblique planes.*/
+    static RegionType ComputeAffectedRegion(const Image *image, TimeStepType timestep, const PlaneListType &planes);
+
+  protected:
+    ~DiffImageRegionOperation() override;
+
+    /** \brief Callback for image observer.*/
+    void OnImageDeleted();
+
+    CompressedImageContainer m_CompressedImageContainer;
+
+    mitk::Image *m_Image;
+
+    TimeStepType m_TimeStep;
+
+    RegionType m_Region;
+
+    PlaneListType m_Planes;
+
+    bool m_ImageIsValid;
+
+    unsigned long m_DeleteObserverTag;
+  };
+}
+#endif
@@ -0,0 +1,71 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDiffImageRegionOperationApplier.h"
+
+#include "mitkDiffImageRegionOperation.h"
+#include "mitkRenderingManager.h"
+#include "mitkSegTool2D.h"
+
+// VTK
+#include <vtkImageData.h>
+
+mitk::DiffImageRegionOperationApplier::DiffImageRegionOperationApplier()
+{
+}
+
+mitk::DiffImageRegionOperationApplier::~DiffImageRegionOperationApplier()
+{
+}
+
+void mitk::DiffImageRegionOperationApplier::ExecuteOperation(Operation *operation)
+{
+  auto *imageOperation = dynamic_cast<DiffImageRegionOperation *>(operation);
+
+  // as we only support DiffImageRegionOperation return if operation is not type of DiffImageRegionOperation
+  if (!imageOperation)
+    return;
+
+  // check if the operation is valid
+  if (imageOperation->IsValid())
+  {
+    auto image = imageOperation->GetImage();
+    auto timeStep = imageOperation->GetTimeStep();
+    const auto mTimeBeforeChange = image->GetMTime();
+
+    DiffImageRegionOperation::WriteRegion(image, timeStep, imageOperation->GetRegion(), imageOperation->GetRegionImage());
+
+    // the whole region is restored at once, so the image is marked as modified only once
+    image->Modified();
+    image->GetVtkImageData(timeStep)->Modified();
+
+    // make sure the modification is rendered
+    RenderingManager::GetInstance()->RequestUpdateAll();
+
+    auto labelSetImage = dynamic_cast<LabelSetImage *>(image);
+    if (nullptr != labelSetImage)
+    {
+      labelSetImage->UpdateLabelStatistics(labelSetImage->GetActiveLayer(), timeStep, imageOperation->GetRegion(), mTimeBeforeChange);
+
+      for (const auto &plane : imageOperation->GetPlanes())
+      {
+        SegTool2D::UpdateAllSurfaceInterpolations(labelSetImage, timeStep, plane, true);
+      }
+    }
+  }
+}
+
+mitk::DiffImageRegionOperationApplier *mitk::DiffImageRegionOperationApplier::GetInstance()
+{
+  static auto *s_Instance = new DiffImageRegionOperationApplier();
+  return s_Instance;
+}
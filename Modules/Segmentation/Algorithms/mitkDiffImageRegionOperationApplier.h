@@ -0,0 +1,46 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDiffImageRegionOperationApplier_h
+#define mitkDiffImageRegionOperationApplier_h
+
+#include "mitkCommon.h"
+#include <MitkSegmentationExports.h>
+#include <mitkOperationActor.h>
+
+namespace mitk
+{
+  /** \brief Executes a DiffImageRegionOperation.
+    \sa DiffImageRegionOperation
+  */
+  class MITKSEGMENTATION_EXPORT DiffImageRegionOperationApplier : public OperationActor
+  {
+  public:
+    mitkClassMacroNoParent(DiffImageRegionOperationApplier)
+
+      /** \brief Returns an instance of the class */
+      static DiffImageRegionOperationApplier *GetInstance();
+
+    /** \brief Executes a DiffImageRegionOperation.
+      \sa DiffImageRegionOperation
+      Note:
+        Only DiffImageRegionOperation is supported.
+    */
+    void ExecuteOperation(Operation *op) override;
+
+  protected:
+    DiffImageRegionOperationApplier();
+
+    ~DiffImageRegionOperationApplier() override;
+  };
+}
+#endif
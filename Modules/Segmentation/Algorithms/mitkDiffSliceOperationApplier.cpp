@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkDiffSliceOperationApplier.h"
 
+#include "mitkDiffImageRegionOperation.h"
 #include "mitkDiffSliceOperation.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegTool2D.h"
@@ -47,6 +48,8 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     // Set the slice as 'input'
     reslice->SetInputSlice(slice->GetVtkImageData());
 
+    const auto mTimeBeforeChange = imageOperation->GetImage()->GetMTime();
+
     // set overwrite mode to true to write back to the image volume
     reslice->SetOverwriteMode(true);
     reslice->Modified();
@@ -62,12 +65,26 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     extractor->Modified();
     extractor->Update();
 
+    PlaneGeometry::ConstPointer plane = dynamic_cast<const PlaneGeometry *>(imageOperation->GetWorldGeometry());
+
+    DiffImageRegionOperation::RegionType region;
+    if (plane.IsNotNull())
+    {
+      region = DiffImageRegionOperation::ComputeAffectedRegion(imageOperation->GetImage(), imageOperation->GetTimeStep(), { plane });
+      imageOperation->GetImage()->AddModifiedRegion(imageOperation->GetTimeStep(), region);
+    }
+
     // make sure the modification is rendered
     RenderingManager::GetInstance()->RequestUpdateAll();
     imageOperation->GetImage()->Modified();
 
-    PlaneGeometry::ConstPointer plane = dynamic_cast<const PlaneGeometry *>(imageOperation->GetWorldGeometry());
-    SegTool2D::UpdateAllSurfaceInterpolations(dynamic_cast<LabelSetImage*>(imageOperation->GetImage()), imageOperation->GetTimeStep(), plane, true);
+    auto labelSetImage = dynamic_cast<LabelSetImage *>(imageOperation->GetImage());
+    if (nullptr != labelSetImage && plane.IsNotNull())
+    {
+      labelSetImage->UpdateLabelStatistics(labelSetImage->GetActiveLayer(), imageOperation->GetTimeStep(), region, mTimeBeforeChange);
+    }
+
+    SegTool2D::UpdateAllSurfaceInterpolations(labelSetImage, imageOperation->GetTimeStep(), plane, true);
   }
 }
 
@@ -42,6 +42,8 @@ found in the LICENSE file.
 #include "mitkOperationEvent.h"
 #include "mitkUndoController.h"
 #include <mitkDiffSliceOperationApplier.h>
+#include <mitkDiffImageRegionOperation.h>
+#include <mitkDiffImageRegionOperationApplier.h>
 
 #include "mitkAbstractTransformGeometry.h"
 #include "mitkLabelSetImage.h"
@@ -53,6 +55,78 @@ found in the LICENSE file.
 #include <vtkAbstractArray.h>
 #include <vtkFieldData.h>
 
+#include <algorithm>
+#include <map>
+
+namespace
+{
+  /** Written slices that share one undo/redo region. */
+  struct SliceGroup
+  {
+    mitk::DiffImageRegionOperation::RegionType region;
+    mitk::DiffImageRegionOperation::PlaneListType planes;
+  };
+
+  mitk::DiffImageRegionOperation::RegionType GetBoundingRegion(const mitk::DiffImageRegionOperation::RegionType& a,
+                                                               const mitk::DiffImageRegionOperation::RegionType& b)
+  {
+    mitk::DiffImageRegionOperation::RegionType region;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      const auto lower = std::min(a.GetIndex(d), b.GetIndex(d));
+      const auto upper = std::max(a.GetUpperIndex()[d], b.GetUpperIndex()[d]);
+      region.SetIndex(d, lower);
+      region.SetSize(d, upper - lower + 1);
+    }
+    return region;
+  }
+
+  /** Groups the slices of a time step by their affected regions. Slices whose regions overlap or touch are merged
+   * into one group, as long as the bounding region of the group is not larger than its parts together. Distant slices
+   * keep separate regions, so that their undo/redo operations do not store the voxels between them.*/
+  std::vector<SliceGroup> GroupSlicesByRegion(const mitk::Image* image,
+                                              mitk::TimeStepType timeStep,
+                                              const std::vector<const mitk::SegTool2D::SliceInformation*>& slices)
+  {
+    std::vector<SliceGroup> sliceRegions;
+    for (const auto sliceInfo : slices)
+    {
+      SliceGroup sliceRegion;
+      sliceRegion.planes.push_back(sliceInfo->plane);
+      sliceRegion.region = mitk::DiffImageRegionOperation::ComputeAffectedRegion(image, timeStep, sliceRegion.planes);
+      if (sliceRegion.region.GetNumberOfPixels() > 0)
+      {
+        sliceRegions.push_back(sliceRegion);
+      }
+    }
+
+    // neighboring slices of a stack follow each other after sorting by the region origin
+    std::sort(sliceRegions.begin(), sliceRegions.end(), [](const SliceGroup& a, const SliceGroup& b) {
+      const auto& indexA = a.region.GetIndex();
+      const auto& indexB = b.region.GetIndex();
+      return std::lexicographical_compare(indexA.rbegin(), indexA.rend(), indexB.rbegin(), indexB.rend());
+    });
+
+    std::vector<SliceGroup> groups;
+    for (const auto& sliceRegion : sliceRegions)
+    {
+      if (!groups.empty())
+      {
+        auto& group = groups.back();
+        const auto mergedRegion = GetBoundingRegion(group.region, sliceRegion.region);
+        if (mergedRegion.GetNumberOfPixels() <= group.region.GetNumberOfPixels() + sliceRegion.region.GetNumberOfPixels())
+        {
+          group.region = mergedRegion;
+          group.planes.insert(group.planes.end(), sliceRegion.planes.begin(), sliceRegion.planes.end());
+          continue;
+        }
+      }
+      groups.push_back(sliceRegion);
+    }
+    return groups;
+  }
+}
+
 #define ROUND(a) ((a) > 0 ? (int)((a) + 0.5) : -(int)(0.5 - (a)))
 
 bool mitk::SegTool2D::m_SurfaceInterpolationEnabled = true;
@@ -618,11 +692,15 @@ void mitk::SegTool2D::WriteBackSegmentationResults(const DataNode* workingNode,
     mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
   }
 
-  for (const auto& sliceInfo : sliceList)
+  if (writeSliceToVolume)
   {
-    if (writeSliceToVolume && nullptr != sliceInfo.plane && sliceInfo.slice.IsNotNull())
+    if (sliceList.size() > 1)
+    {
+      SegTool2D::WriteSlicesToVolume(image, sliceList, true);
+    }
+    else if (nullptr != sliceList.front().plane && sliceList.front().slice.IsNotNull())
     {
-      SegTool2D::WriteSliceToVolume(image, sliceInfo, true);
+      SegTool2D::WriteSliceToVolume(image, sliceList.front(), true);
     }
   }
 
@@ -677,6 +755,8 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   auto noneConstSlice = const_cast<Image*>(sliceInfo.slice.GetPointer());
   reslice->SetInputSlice(noneConstSlice->GetVtkImageData());
 
+  const auto mTimeBeforeChange = workingImage->GetMTime();
+
   // set overwrite mode to true to write back to the image volume
   reslice->SetOverwriteMode(true);
   reslice->Modified();
@@ -691,10 +771,20 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   extractor->Modified();
   extractor->Update();
 
+  // only the voxels around the plane have changed
+  const auto region = DiffImageRegionOperation::ComputeAffectedRegion(workingImage, sliceInfo.timestep, { sliceInfo.plane });
+
   // the image was modified within the pipeline, but not marked so
+  workingImage->AddModifiedRegion(sliceInfo.timestep, region);
   workingImage->Modified();
   workingImage->GetVtkImageData()->Modified();
 
+  auto labelSetImage = dynamic_cast<LabelSetImage*>(workingImage);
+  if (nullptr != labelSetImage)
+  {
+    labelSetImage->UpdateLabelStatistics(labelSetImage->GetActiveLayer(), sliceInfo.timestep, region, mTimeBeforeChange);
+  }
+
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
@@ -719,6 +809,120 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
 }
 
 
+void mitk::SegTool2D::WriteSlicesToVolume(Image* workingImage, const std::vector<SliceInformation>& sliceList, bool allowUndo)
+{
+  if (nullptr == workingImage)
+  {
+    mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
+  }
+
+  std::map<TimeStepType, std::vector<const SliceInformation*>> slicesPerTimeStep;
+  for (const auto& sliceInfo : sliceList)
+  {
+    if (nullptr != sliceInfo.plane && sliceInfo.slice.IsNotNull())
+    {
+      slicesPerTimeStep[sliceInfo.timestep].push_back(&sliceInfo);
+    }
+  }
+
+  if (slicesPerTimeStep.empty())
+  {
+    return;
+  }
+
+  if (allowUndo)
+  {
+    UndoStackItem::IncCurrGroupEventId();
+  }
+
+  const auto mTimeBeforeChange = workingImage->GetMTime();
+  std::map<TimeStepType, std::vector<SliceGroup>> changedRegions;
+
+  for (const auto& timeStepSlices : slicesPerTimeStep)
+  {
+    const auto timeStep = timeStepSlices.first;
+
+    // one undo/redo region per group of neighboring slices instead of the bounding region of all slices
+    const auto sliceGroups = GroupSlicesByRegion(workingImage, timeStep, timeStepSlices.second);
+    changedRegions[timeStep] = sliceGroups;
+
+    std::vector<DiffImageRegionOperation*> undoOperations;
+    if (allowUndo)
+    {
+      /*============= BEGIN undo/redo feature block ========================*/
+      // Create undo operations by caching the not yet modified regions of the slices
+      for (const auto& group : sliceGroups)
+      {
+        undoOperations.push_back(new DiffImageRegionOperation(workingImage, timeStep, group.region, group.planes));
+      }
+      /*============= END undo/redo feature block ========================*/
+    }
+
+    // One overwrite pipeline for all slices of the time step (see WriteSliceToVolume for details).
+    vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    reslice->SetOverwriteMode(true);
+
+    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
+    extractor->SetInput(workingImage);
+    extractor->SetTimeStep(timeStep);
+    extractor->SetVtkOutputRequest(false);
+    extractor->SetResliceTransformByGeometry(workingImage->GetGeometry(timeStep));
+
+    for (const auto sliceInfo : timeStepSlices.second)
+    {
+      auto noneConstSlice = const_cast<Image*>(sliceInfo->slice.GetPointer());
+      reslice->SetInputSlice(noneConstSlice->GetVtkImageData());
+      reslice->Modified();
+
+      extractor->SetWorldGeometry(sliceInfo->plane);
+      extractor->Modified();
+      extractor->Update();
+    }
+
+    // the image was modified within the pipeline, but not marked so
+    workingImage->GetVtkImageData(timeStep)->Modified();
+
+    for (std::size_t i = 0; i < undoOperations.size(); ++i)
+    {
+      /*============= BEGIN undo/redo feature block ========================*/
+      // specify the redo operation with the edited region
+      auto* doOperation =
+        new DiffImageRegionOperation(workingImage, timeStep, sliceGroups[i].region, sliceGroups[i].planes);
+
+      // create an operation event for the undo stack; all events share the group event id,
+      // so they are undone in one step
+      OperationEvent* undoStackItem = new OperationEvent(
+        DiffImageRegionOperationApplier::GetInstance(), doOperation, undoOperations[i], "Segmentation");
+
+      // add it to the undo controller
+      UndoStackItem::IncCurrObjectEventId();
+      UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
+      /*============= END undo/redo feature block ========================*/
+    }
+  }
+
+  for (const auto& [timeStep, sliceGroups] : changedRegions)
+  {
+    for (const auto& group : sliceGroups)
+    {
+      workingImage->AddModifiedRegion(timeStep, group.region);
+    }
+  }
+  workingImage->Modified();
+
+  auto labelSetImage = dynamic_cast<LabelSetImage*>(workingImage);
+  if (nullptr != labelSetImage)
+  {
+    for (const auto& [timeStep, sliceGroups] : changedRegions)
+    {
+      for (const auto& group : sliceGroups)
+      {
+        labelSetImage->UpdateLabelStatistics(labelSetImage->GetActiveLayer(), timeStep, group.region, mTimeBeforeChange);
+      }
+    }
+  }
+}
+
 void mitk::SegTool2D::SetShowMarkerNodes(bool status)
 {
   m_ShowMarkerNodes = status;
@@ -227,7 +227,8 @@ namespace mitk
     void WriteBackSegmentationResults(const std::vector<SliceInformation> &sliceList, bool writeSliceToVolume = true);
 
     /** \brief Writes all provided source slices into the data of the passed workingNode.
-     * The function does the following: 1) for every passed slice write it to workingNode (and generate and undo/redo step);
+     * The function does the following: 1) write the passed slices to workingNode (and generate an undo/redo step;
+     * multiple slices are written as one batch, see WriteSlicesToVolume);
      * 2) update the surface interpolation and 3) mark the node as modified.
      * @param workingNode Pointer to the node that contains the working image.
      * @param sliceList Vector of all slices that should be written into the workingNode. If the list is
@@ -248,6 +249,17 @@ namespace mitk
     * @pre workingImage must point to a valid instance.*/
     static void WriteSliceToVolume(Image* workingImage, const SliceInformation &sliceInfo, bool allowUndo);
 
+    /** Writes all provided slices into the passed working image in one batch. In contrast to calling
+    * WriteSliceToVolume for each slice, the write pipeline is only set up once per time step, a single
+    * undo/redo step is generated and the image is only marked as modified once. The undo/redo step stores
+    * one region per group of adjacent or overlapping slices, so distant slices do not cache the voxels between them.
+    * @param workingImage Pointer to the image that is the target of the write operation.
+    * @param sliceList SliceInfo instances that contain the slice images, the defining plane geometries and time steps.
+    * Instances without slice or plane are ignored.
+    * @param allowUndo Indicates if an undo/redo operation should be registered for the write operation.
+    * @pre workingImage must point to a valid instance.*/
+    static void WriteSlicesToVolume(Image* workingImage, const std::vector<SliceInformation>& sliceList, bool allowUndo);
+
     /**
       \brief Adds a new node called Contourmarker to the datastorage which holds a mitk::PlanarFigure.
       By selecting this node the slicestack will be reoriented according to the passed
@@ -0,0 +1,203 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkContourModelSet.h>
+#include <mitkContourModelSetRasterizer.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <sstream>
+#include <vector>
+
+class mitkContourModelSetRasterizerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkContourModelSetRasterizerTestSuite);
+  MITK_TEST(TestBoundaryPixels);
+  MITK_TEST(TestEvenOddHoles);
+  MITK_TEST(TestSkippedContours);
+  MITK_TEST(TestGroupPacking);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static const unsigned int SizeX = 10;
+  static const unsigned int SizeY = 10;
+  static const unsigned int SizeZ = 3;
+
+  mitk::Image::Pointer m_ReferenceImage;
+
+  static std::size_t Offset(unsigned int x, unsigned int y, unsigned int z)
+  {
+    return x + SizeX * (y + SizeY * z);
+  }
+
+  /** Adds an axial rectangle with the corners (x0, y0) and (x1, y1) in slice z (index coordinates = world coordinates).*/
+  static void AddRectangle(mitk::ContourModelSet* contourSet, double x0, double y0, double x1, double y1, double z)
+  {
+    auto contour = mitk::ContourModel::New();
+    const double corners[4][2] = { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 } };
+    for (const auto& corner : corners)
+    {
+      mitk::Point3D point;
+      point[0] = corner[0];
+      point[1] = corner[1];
+      point[2] = z;
+      contour->AddVertex(point);
+    }
+    contour->Close();
+    contourSet->AddContourModel(contour);
+  }
+
+  std::vector<unsigned char> Rasterize(const mitk::ContourModelSet* contourSet, bool useEvenOddRule) const
+  {
+    std::vector<unsigned char> volume(SizeX * SizeY * SizeZ, 0);
+    auto runs = mitk::ContourModelSetRasterizer::ComputeRuns(contourSet, m_ReferenceImage->GetGeometry(), useEvenOddRule);
+    mitk::ContourModelSetRasterizer::FillRuns(runs, 1, mitk::MakeScalarPixelType<unsigned char>(), volume.data());
+    return volume;
+  }
+
+  /** Checks that exactly the voxels of slice z within [x0, x1] x [y0, y1] (minus the optional hole) are filled.*/
+  static void CheckFilledRectangle(const std::vector<unsigned char>& volume, unsigned int z,
+    unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1,
+    unsigned int holeX0 = 1, unsigned int holeY0 = 1, unsigned int holeX1 = 0, unsigned int holeY1 = 0)
+  {
+    for (unsigned int k = 0; k < SizeZ; ++k)
+    {
+      for (unsigned int j = 0; j < SizeY; ++j)
+      {
+        for (unsigned int i = 0; i < SizeX; ++i)
+        {
+          const bool inRectangle = k == z && i >= x0 && i <= x1 && j >= y0 && j <= y1;
+          const bool inHole = i >= holeX0 && i <= holeX1 && j >= holeY0 && j <= holeY1;
+          const unsigned char expected = inRectangle && !inHole ? 1 : 0;
+
+          std::ostringstream message;
+          message << "Wrong value of voxel (" << i << ", " << j << ", " << k << ")";
+          CPPUNIT_ASSERT_EQUAL_MESSAGE(message.str(), expected, volume[Offset(i, j, k)]);
+        }
+      }
+    }
+  }
+
+  static mitk::LabelSetImage::PixelType GetGroupValue(const mitk::LabelSetImage* segmentation,
+    mitk::LabelSetImage::GroupIndexType groupID, unsigned int x, unsigned int y, unsigned int z)
+  {
+    const auto* groupImage = segmentation->GetGroupImage(groupID);
+    mitk::ImageReadAccessor accessor(groupImage, groupImage->GetVolumeData(0));
+    return static_cast<const mitk::LabelSetImage::PixelType*>(accessor.GetData())[Offset(x, y, z)];
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[3] = { SizeX, SizeY, SizeZ };
+    m_ReferenceImage = mitk::Image::New();
+    m_ReferenceImage->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+  }
+
+  void tearDown() override
+  {
+    m_ReferenceImage = nullptr;
+  }
+
+  void TestBoundaryPixels()
+  {
+    // Pixel centers on the left, right and lower edge are inside, the ones on the upper edge are not
+    auto onPixelCenters = mitk::ContourModelSet::New();
+    AddRectangle(onPixelCenters, 2, 2, 6, 6, 1);
+    CheckFilledRectangle(Rasterize(onPixelCenters, false), 1, 2, 2, 6, 5);
+
+    auto betweenPixelCenters = mitk::ContourModelSet::New();
+    AddRectangle(betweenPixelCenters, 1.5, 1.5, 6.5, 6.5, 1);
+    CheckFilledRectangle(Rasterize(betweenPixelCenters, false), 1, 2, 2, 6, 6);
+
+    // Contours are clipped at the volume boundaries
+    auto exceedingVolume = mitk::ContourModelSet::New();
+    AddRectangle(exceedingVolume, -3.5, -3.5, 2.5, 12.5, 2);
+    CheckFilledRectangle(Rasterize(exceedingVolume, false), 2, 0, 0, 2, SizeY - 1);
+  }
+
+  void TestEvenOddHoles()
+  {
+    auto contourSet = mitk::ContourModelSet::New();
+    AddRectangle(contourSet, 0.5, 0.5, 8.5, 8.5, 1);
+    AddRectangle(contourSet, 2.5, 2.5, 5.5, 5.5, 1);
+
+    CheckFilledRectangle(Rasterize(contourSet, false), 1, 1, 1, 8, 8);
+    CheckFilledRectangle(Rasterize(contourSet, true), 1, 1, 1, 8, 8, 3, 3, 5, 5);
+
+    // Contours of other slices do not cut holes
+    auto otherSlices = mitk::ContourModelSet::New();
+    AddRectangle(otherSlices, 0.5, 0.5, 8.5, 8.5, 1);
+    AddRectangle(otherSlices, 2.5, 2.5, 5.5, 5.5, 2);
+    auto volume = Rasterize(otherSlices, true);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(1), volume[Offset(4, 4, 1)]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(1), volume[Offset(4, 4, 2)]);
+  }
+
+  void TestSkippedContours()
+  {
+    auto contourSet = mitk::ContourModelSet::New();
+
+    // not in a slice of the geometry
+    auto obliqueContour = mitk::ContourModel::New();
+    mitk::Point3D point;
+    point[0] = 1; point[1] = 1; point[2] = 0;
+    obliqueContour->AddVertex(point);
+    point[0] = 8; point[1] = 1; point[2] = 2;
+    obliqueContour->AddVertex(point);
+    point[0] = 8; point[1] = 8; point[2] = 1;
+    obliqueContour->AddVertex(point);
+    obliqueContour->Close();
+    contourSet->AddContourModel(obliqueContour);
+
+    // outside of the volume
+    AddRectangle(contourSet, 1.5, 1.5, 6.5, 6.5, 5);
+
+    CPPUNIT_ASSERT(mitk::ContourModelSetRasterizer::ComputeRuns(contourSet, m_ReferenceImage->GetGeometry(), false).empty());
+  }
+
+  void TestGroupPacking()
+  {
+    auto setA = mitk::ContourModelSet::New();
+    AddRectangle(setA, 0.5, 0.5, 3.5, 3.5, 1);
+    auto setB = mitk::ContourModelSet::New();
+    AddRectangle(setB, 5.5, 5.5, 8.5, 8.5, 1);
+    auto setC = mitk::ContourModelSet::New(); // overlaps A and B
+    AddRectangle(setC, 2.5, 2.5, 6.5, 6.5, 1);
+    auto setD = mitk::ContourModelSet::New(); // overlaps C, but not A and B
+    AddRectangle(setD, 3.5, 3.5, 5.5, 5.5, 2);
+    AddRectangle(setD, 3.5, 3.5, 5.5, 5.5, 1);
+
+    auto segmentation = mitk::ContourModelSetRasterizer::RasterizeToMultiLabelSegmentation(m_ReferenceImage,
+      { setA, setB, setC, setD });
+
+    CPPUNIT_ASSERT_EQUAL(2u, segmentation->GetNumberOfLayers());
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::GroupIndexType(0), segmentation->GetGroupIndexOfLabel(1));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::GroupIndexType(0), segmentation->GetGroupIndexOfLabel(2));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::GroupIndexType(1), segmentation->GetGroupIndexOfLabel(3));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::GroupIndexType(0), segmentation->GetGroupIndexOfLabel(4));
+
+    // overlapping labels keep all of their voxels
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::PixelType(1), GetGroupValue(segmentation, 0, 3, 3, 1));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::PixelType(3), GetGroupValue(segmentation, 1, 3, 3, 1));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::PixelType(2), GetGroupValue(segmentation, 0, 6, 6, 1));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::PixelType(3), GetGroupValue(segmentation, 1, 6, 6, 1));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::PixelType(4), GetGroupValue(segmentation, 0, 4, 4, 1));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::PixelType(4), GetGroupValue(segmentation, 0, 4, 4, 2));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::PixelType(3), GetGroupValue(segmentation, 1, 4, 4, 1));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::PixelType(mitk::LabelSetImage::UNLABELED_VALUE), GetGroupValue(segmentation, 1, 4, 4, 2));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::PixelType(mitk::LabelSetImage::UNLABELED_VALUE), GetGroupValue(segmentation, 0, 0, 0, 1));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkContourModelSetRasterizer)
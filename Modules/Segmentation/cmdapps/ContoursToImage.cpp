@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include <mitkCommandLineParser.h>
 #include <mitkContourModelSet.h>
+#include <mitkContourModelSetRasterizer.h>
 #include <mitkContourModelSetToImageFilter.h>
 #include <mitkDataStorage.h>
 #include <mitkImageReadAccessor.h>
@@ -44,6 +45,7 @@ void InitializeCommandLineParser(mitkCommandLineParser& parser)
   parser.addArgument("reference", "r", mitkCommandLineParser::Image, "Reference image:", "Input reference image", us::Any(), false, false, false, mitkCommandLineParser::Input);
   parser.addArgument("output", "o", mitkCommandLineParser::Image, "Output file:", "Output image", us::Any(), false, false, false, mitkCommandLineParser::Output);
   parser.addArgument("format", "f", mitkCommandLineParser::String, "Output format:", "Output format (binary, label, or multilabel)", std::string("binary"));
+  parser.addArgument("holes", "", mitkCommandLineParser::Bool, "Contours cut holes:", "Combine all contours of a slice with the even-odd rule, so that contours within other contours are holes (as in RTSTRUCT). By default, each contour is filled on its own.", us::Any());
 }
 
 std::string GetSafeName(const mitk::IPropertyProvider* propertyProvider)
@@ -193,6 +195,7 @@ int main(int argc, char* argv[])
     auto referenceFilename = us::any_cast<std::string>(args["reference"]);
     auto outputFilename = us::any_cast<std::string>(args["output"]);
     auto format = ParseOutputFormat(args);
+    const bool useEvenOddRule = args.count("holes") != 0 && us::any_cast<bool>(args["holes"]);
 
     auto referenceImage = mitk::IOUtil::Load<mitk::Image>(referenceFilename);
     auto inputs = FilterValidInputs(mitk::IOUtil::Load(inputFilename));
@@ -202,16 +205,39 @@ int main(int argc, char* argv[])
     fs::path outputPath(outputFilename);
     CreateParentDirectories(outputPath);
 
-    mitk::LabelSetImage::Pointer labelSetImage; // Only used for "multilabel" output
+    if (format == OutputFormat::Multilabel)
+    {
+      // Rasterize all contour sets in a single call. Each contour set becomes a label (label value = index + 1)
+      // and contour sets only get separate groups if they overlap.
+      std::vector<const mitk::ContourModelSet*> contourSets;
+      for (const auto& input : inputs)
+        contourSets.push_back(input);
+
+      auto labelSetImage = mitk::ContourModelSetRasterizer::RasterizeToMultiLabelSegmentation(referenceImage, contourSets, useEvenOddRule);
+
+      for (std::size_t i = 0; i < inputs.size(); ++i)
+      {
+        auto label = labelSetImage->GetLabel(static_cast<mitk::LabelSetImage::LabelValueType>(i + 1));
+
+        SetLabelName(inputs[i], label);
+        SetLabelColor(inputs[i], label);
+
+        MITK_INFO << "Creating label: " << label->GetName() << " [" << label->GetValue() << ']';
+      }
+
+      mitk::IOUtil::Save(labelSetImage, outputPath.string());
+      return returnValue;
+    }
+
     unsigned int nonameCounter = 0; // Helper variable to generate placeholder names for nameless contour sets
 
     for (auto input : inputs)
     {
-      // If the input file contains multiple contour sets but the output format is not set to "multilabel",
-      // we create separate output files for each contour set. In this case the specified output filename
-      // is used only as a base filename and the names of the individual contour sets are appended accordingly.
+      // If the input file contains multiple contour sets, we create separate output files for each contour set.
+      // In this case the specified output filename is used only as a base filename and the names of the
+      // individual contour sets are appended accordingly.
 
-      if (inputs.size() > 1 && format != OutputFormat::Multilabel)
+      if (inputs.size() > 1)
       {
         outputPath = outputFilename;
         auto name = GetSafeName(input);
@@ -225,14 +251,13 @@ int main(int argc, char* argv[])
       // Do the actual conversion from a contour set to an image with a background pixel value of 0.
       // - For "binary" output, use pixel value 1 and unsigned char as pixel type.
       // - For "label" output, use pixel value 1 and our label pixel type.
-      // - For "multilabel" output, use the next available label value instead.
+      // Contours within other contours of the same slice are only holes if requested (see "holes").
 
-      const auto labelValue = labelSetImage.IsNotNull()
-        ? labelSetImage->GetUnusedLabelValue()
-        : 1;
+      const mitk::Label::PixelType labelValue = 1;
 
       auto filter = mitk::ContourModelSetToImageFilter::New();
       filter->SetMakeOutputLabelPixelType(format != OutputFormat::Binary);
+      filter->SetUseEvenOddRule(useEvenOddRule);
       filter->SetPaintingPixelValue(labelValue);
       filter->SetImage(referenceImage);
       filter->SetInput(input);
@@ -255,17 +280,10 @@ int main(int argc, char* argv[])
       }
       else
       {
-        if (labelSetImage.IsNull())
-        {
-          labelSetImage = mitk::LabelSetImage::New();
-          labelSetImage->Initialize(image);
+        auto labelSetImage = mitk::LabelSetImage::New();
+        labelSetImage->Initialize(image);
 
-          CopyImageToActiveLayerImage(image, labelSetImage);
-        }
-        else
-        {
-          labelSetImage->AddLayer(image);
-        }
+        CopyImageToActiveLayerImage(image, labelSetImage);
 
         auto label = mitk::LabelSetImageHelper::CreateNewLabel(labelSetImage);
         label->SetValue(labelValue);
@@ -273,25 +291,11 @@ int main(int argc, char* argv[])
         SetLabelName(input, label);
         SetLabelColor(input, label);
 
-        if (format == OutputFormat::Multilabel)
-          MITK_INFO << "Creating label: " << label->GetName() << " [" << labelValue << ']';
-
         labelSetImage->AddLabel(label, labelSetImage->GetActiveLayer(), false, false);
 
-        if (format == OutputFormat::Label)
-        {
-          mitk::IOUtil::Save(labelSetImage, outputPath.string());
-          labelSetImage = nullptr;
-        }
+        mitk::IOUtil::Save(labelSetImage, outputPath.string());
       }
     }
-
-    // In case of the "multilabel" output format, eventually save the single output file.
-    // For all other output formats, the output file(s) have been saved already while iterating
-    // over the inputs.
-
-    if (labelSetImage.IsNotNull())
-      mitk::IOUtil::Save(labelSetImage, outputPath.string());
   }
   catch (const mitk::Exception& e)
   {
@@ -4,11 +4,14 @@ set(H_FILES
 
 set(CPP_FILES
   Algorithms/mitkCalculateSegmentationVolume.cpp
+  Algorithms/mitkContourModelSetRasterizer.cpp
   Algorithms/mitkContourModelSetToImageFilter.cpp
   Algorithms/mitkContourSetToPointSetFilter.cpp
   Algorithms/mitkContourUtils.cpp
   Algorithms/mitkCorrectorAlgorithm.cpp
   Algorithms/mitkDiffImageApplier.cpp
+  Algorithms/mitkDiffImageRegionOperation.cpp
+  Algorithms/mitkDiffImageRegionOperationApplier.cpp
   Algorithms/mitkDiffSliceOperation.cpp
   Algorithms/mitkDiffSliceOperationApplier.cpp
   Algorithms/mitkGrowCutSegmentationFilter.cpp
@@ -220,7 +220,11 @@ void org_blueberry_core_runtime_Activator::startRegistry()
 
   RegistryStrategy* strategy = nullptr;
   //Location configuration = OSGIUtils.getDefault().getConfigurationLocation();
-  QString configuration = context->getDataFile("").absoluteFilePath();
+  // The registry cache is stored in the plugin cache directory if one is configured and
+  // in the data directory of this plugin otherwise.
+  QString configuration = context->getProperty(RegistryConstants::PROP_PLUGIN_CACHE_DIR).toString();
+  if (configuration.isEmpty())
+    configuration = context->getDataFile("").absoluteFilePath();
   if (configuration.isEmpty())
   {
     RegistryProperties::SetProperty(RegistryConstants::PROP_NO_REGISTRY_CACHE, "true");
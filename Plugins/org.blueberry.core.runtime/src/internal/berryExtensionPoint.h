@@ -31,6 +31,8 @@ private:
   friend class ExtensionPointHandle;
   friend class ExtensionRegistry;
   friend class ExtensionsParser;
+  friend class TableReader;
+  friend class TableWriter;
 
   //Place holder for the label and the schema. It contains either a String[] or a SoftReference to a String[].
   //The array layout is [label, schemaReference, fullyQualifiedName, namespace, contributorId]
@@ -36,9 +36,15 @@ found in the LICENSE file.
 #include "berryRegistryProperties.h"
 #include "berryRegistryStrategy.h"
 #include "berryStatus.h"
+#include "berryTableReader.h"
+#include "berryTableWriter.h"
 
-#include <QThread>
+#include <QDir>
 #include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThread>
 
 namespace berry {
 
@@ -447,19 +453,12 @@ bool ExtensionRegistry::RemoveObject(const SmartPointer<RegistryObject>& registr
   return true;
 }
 
-void ExtensionRegistry::SetFileManager(const QString& /*cacheBase*/, bool /*isCacheReadOnly*/)
+void ExtensionRegistry::SetFileManager(const QString& cacheBase, bool isCacheReadOnly)
 {
-//  if (cacheStorageManager != nullptr)
-//    cacheStorageManager->Close(); // close existing file manager first
+  theTableReader->Close(); // close the cache of the previous location first
 
-//  if (cacheBase != null) {
-//    cacheStorageManager = new StorageManager(cacheBase, isCacheReadOnly ? "none" : null, isCacheReadOnly); //$NON-NLS-1$
-//    try {
-//      cacheStorageManager.open(!isCacheReadOnly);
-//    } catch (IOException e) {
-//      // Ignore the exception. The registry will be rebuilt from source.
-//    }
-//  }
+  cacheStorageLocation = cacheBase;
+  cacheStorageReadOnly = isCacheReadOnly;
 }
 
 void ExtensionRegistry::EnterRead()
@@ -485,30 +484,19 @@ void ExtensionRegistry::SetElementFactory()
   }
 }
 
-//TableReader ExtensionRegistry::getTableReader() const
-//{
-//  return theTableReader;
-//}
-
 bool ExtensionRegistry::CheckCache()
 {
-//  for (int index = 0; index < strategy.getLocationsLength(); index++) {
-//    File possibleCacheLocation = strategy.getStorage(index);
-//    if (possibleCacheLocation == null)
-//      break; // bail out on the first null
-//    setFileManager(possibleCacheLocation, strategy.isCacheReadOnly(index));
-//    if (cacheStorageManager != null) {
-//      // check this new location:
-//      File cacheFile = null;
-//      try {
-//        cacheFile = cacheStorageManager.lookup(TableReader.getTestFileName(), false);
-//      } catch (IOException e) {
-//        //Ignore the exception. The registry will be rebuilt from the xml files.
-//      }
-//      if (cacheFile != null && cacheFile.isFile())
-//        return true; // found the appropriate location
-//    }
-//  }
+  for (int index = 0; index < strategy->GetLocationsLength(); index++)
+  {
+    QString possibleCacheLocation = strategy->GetStorage(index);
+    if (possibleCacheLocation.isEmpty())
+      break; // bail out on the first empty location
+    SetFileManager(possibleCacheLocation, strategy->IsCacheReadOnly(index));
+
+    // check this new location:
+    if (QFileInfo(QDir(cacheStorageLocation).filePath(TableReader::GetTestFileName())).isFile())
+      return true; // found the appropriate location
+  }
   return false;
 }
 
@@ -776,8 +764,12 @@ void ExtensionRegistry::RemoveListener(IRegistryEventListener* listener)
 }
 
 ExtensionRegistry::ExtensionRegistry(RegistryStrategy* registryStrategy, QObject* masterToken, QObject* userToken)
-  : registryObjects(nullptr), isMultiLanguage(false), mlErrorLogged(false), eventThread(nullptr)
+  : registryObjects(nullptr), isMultiLanguage(false), mlErrorLogged(false), eventThread(nullptr),
+    cacheStorageReadOnly(true), theTableReader(new TableReader(this)), cacheCorrupt(0)
 {
+  QElapsedTimer startupTimer;
+  startupTimer.start();
+
   isMultiLanguage = RegistryProperties::GetProperty(RegistryConstants::PROP_REGISTRY_MULTI_LANGUAGE) == "true";
 
   if (registryStrategy != nullptr)
@@ -798,41 +790,33 @@ ExtensionRegistry::ExtensionRegistry(RegistryStrategy* registryStrategy, QObject
     if (Debug())
       timer.start();
 
-    //The cache is made of several files, find the real names of these other files. If all files are found, try to initialize the objectManager
+    // Find the location holding a cache file and try to initialize the objectManager from it
     if (CheckCache())
     {
-      // TODO Registry Cache
-//      try {
-//        theTableReader.setTableFile(cacheStorageManager.lookup(TableReader.TABLE, false));
-//        theTableReader.setExtraDataFile(cacheStorageManager.lookup(TableReader.EXTRA, false));
-//        theTableReader.setMainDataFile(cacheStorageManager.lookup(TableReader.MAIN, false));
-//        theTableReader.setContributionsFile(cacheStorageManager.lookup(TableReader.CONTRIBUTIONS, false));
-//        theTableReader.setContributorsFile(cacheStorageManager.lookup(TableReader.CONTRIBUTORS, false));
-//        theTableReader.setNamespacesFile(cacheStorageManager.lookup(TableReader.NAMESPACES, false));
-//        theTableReader.setOrphansFile(cacheStorageManager.lookup(TableReader.ORPHANS, false));
-//        long timestamp = strategy.getContributionsTimestamp();
-//        isRegistryFilledFromCache = registryObjects.init(timestamp);
-//        if (isRegistryFilledFromCache)
-//          aggregatedTimestamp.set(timestamp);
-//      } catch (IOException e) {
-//        // The registry will be rebuilt from the xml files. Make sure to clear anything filled
-//        // from cache so that we won't have partially filled items.
-//        isRegistryFilledFromCache = false;
-//        clearRegistryCache();
-//        log(new Status(IStatus.ERROR, RegistryMessages.OWNER_NAME, 0, RegistryMessages.registry_bad_cache, e));
-//      }
+      theTableReader->SetCacheFile(QDir(cacheStorageLocation).filePath(TableReader::GetTestFileName()));
+      isRegistryFilledFromCache = registryObjects->Init(strategy->GetContributionsStamp());
+      if (!isRegistryFilledFromCache)
+      {
+        // The cache is outdated or corrupt and the registry will be rebuilt from the xml files.
+        // Make sure to clear anything filled from cache so that we won't have partially filled items.
+        theTableReader->Close();
+        registryObjects = new RegistryObjectManager(this);
+        ClearRegistryCache();
+      }
     }
 
-//    if (!isRegistryFilledFromCache)
-//    {
-//      // set cache storage manager to a first writable location
-//      for (int index = 0; index < strategy.getLocationsLength(); index++) {
-//        if (!strategy.isCacheReadOnly(index)) {
-//          setFileManager(strategy.getStorage(index), false);
-//          break;
-//        }
-//      }
-//    }
+    if (!isRegistryFilledFromCache)
+    {
+      // set the cache location to a first writable location
+      for (int index = 0; index < strategy->GetLocationsLength(); index++)
+      {
+        if (!strategy->IsCacheReadOnly(index))
+        {
+          SetFileManager(strategy->GetStorage(index), false);
+          break;
+        }
+      }
+    }
 
     if (Debug() && isRegistryFilledFromCache)
       BERRY_INFO << "Reading registry cache: " << timer.elapsed() << "ms";
@@ -895,17 +879,20 @@ ExtensionRegistry::ExtensionRegistry(RegistryStrategy* registryStrategy, QObject
 
   // Do extra start processing if specified in the registry strategy
   strategy->OnStart(this, isRegistryFilledFromCache);
+
+  BERRY_INFO << "Extension registry " << (isRegistryFilledFromCache ? "read from cache" : "built from plug-in manifests")
+             << " in " << startupTimer.elapsed() << "ms";
 }
 
 ExtensionRegistry::~ExtensionRegistry()
 {
 }
 
-void ExtensionRegistry::Stop(QObject* /*key*/)
+void ExtensionRegistry::Stop(QObject* key)
 {
   // If the registry creator specified a key token, check that the key matches it
   // (it is assumed that registry owner keeps the key to prevent unautorized access).
-  if (masterToken != nullptr && masterToken != nullptr)
+  if (masterToken != nullptr && masterToken != key)
   {
     throw ctkInvalidArgumentException("Unauthorized access to the ExtensionRegistry.stop() method. Check if proper access token is supplied."); //$NON-NLS-1$
   }
@@ -915,81 +902,56 @@ void ExtensionRegistry::Stop(QObject* /*key*/)
 
   StopChangeEventScheduler();
 
-//  if (cacheStorageManager == nullptr)
-//    return;
+  if (cacheStorageLocation.isEmpty())
+    return;
 
-//  if (!registryObjects.isDirty() || cacheStorageManager.isReadOnly()) {
-//    cacheStorageManager.close();
-//    theTableReader.close();
-//    return;
-//  }
+  if (cacheCorrupt.loadRelaxed() != 0)
+  {
+    // Do not write a cache from a partially read registry
+    ClearRegistryCache();
+    return;
+  }
 
-//  File tableFile = null;
-//  File mainFile = null;
-//  File extraFile = null;
-//  File contributionsFile = null;
-//  File contributorsFile = null;
-//  File namespacesFile = null;
-//  File orphansFile = null;
-
-//  TableWriter theTableWriter = new TableWriter(this);
-
-//  try {
-//    cacheStorageManager.lookup(TableReader.TABLE, true);
-//    cacheStorageManager.lookup(TableReader.MAIN, true);
-//    cacheStorageManager.lookup(TableReader.EXTRA, true);
-//    cacheStorageManager.lookup(TableReader.CONTRIBUTIONS, true);
-//    cacheStorageManager.lookup(TableReader.CONTRIBUTORS, true);
-//    cacheStorageManager.lookup(TableReader.NAMESPACES, true);
-//    cacheStorageManager.lookup(TableReader.ORPHANS, true);
-//    tableFile = File.createTempFile(TableReader.TABLE, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    mainFile = File.createTempFile(TableReader.MAIN, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    extraFile = File.createTempFile(TableReader.EXTRA, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    contributionsFile = File.createTempFile(TableReader.CONTRIBUTIONS, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    contributorsFile = File.createTempFile(TableReader.CONTRIBUTORS, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    namespacesFile = File.createTempFile(TableReader.NAMESPACES, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    orphansFile = File.createTempFile(TableReader.ORPHANS, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    theTableWriter.setTableFile(tableFile);
-//    theTableWriter.setExtraDataFile(extraFile);
-//    theTableWriter.setMainDataFile(mainFile);
-//    theTableWriter.setContributionsFile(contributionsFile);
-//    theTableWriter.setContributorsFile(contributorsFile);
-//    theTableWriter.setNamespacesFile(namespacesFile);
-//    theTableWriter.setOrphansFile(orphansFile);
-//  } catch (IOException e) {
-//    cacheStorageManager.close();
-//    return; //Ignore the exception since we can recompute the cache
-//  }
-//  try {
-//    long timestamp;
-//    // A bit of backward compatibility: if registry was modified, but timestamp was not,
-//    // it means that the new timestamp tracking mechanism was not used. In this case
-//    // explicitly obtain timestamps for all contributions. Note that this logic
-//    // maintains a problem described in the bug 104267 for contributions that
-//    // don't use the timestamp tracking mechanism.
-//    if (aggregatedTimestamp.isModifed())
-//      timestamp = aggregatedTimestamp.getContentsTimestamp(); // use timestamp tracking
-//    else
-//      timestamp = strategy.getContributionsTimestamp(); // use legacy approach
-
-//    if (theTableWriter.saveCache(registryObjects, timestamp))
-//      cacheStorageManager.update(new   QString[] {TableReader.TABLE, TableReader.MAIN, TableReader.EXTRA, TableReader.CONTRIBUTIONS, TableReader.CONTRIBUTORS, TableReader.NAMESPACES, TableReader.ORPHANS}, new   QString[] {tableFile.getName(), mainFile.getName(), extraFile.getName(), contributionsFile.getName(), contributorsFile.getName(), namespacesFile.getName(), orphansFile.getName()});
-//  } catch (IOException e) {
-//    //Ignore the exception since we can recompute the cache
-//  }
-//  theTableReader.close();
-//  cacheStorageManager.close();
+  if (!registryObjects->IsDirty() || cacheStorageReadOnly)
+  {
+    theTableReader->Close();
+    return;
+  }
+
+  QElapsedTimer timer;
+  if (Debug())
+    timer.start();
+
+  // Objects not loaded yet are read from the old cache while the new one is written
+  QByteArray cache;
+  bool saved = false;
+  {
+    QReadLocker l(&access);
+    TableWriter theTableWriter;
+    saved = theTableWriter.SaveCache(*registryObjects, strategy->GetContributionsStamp(), cache);
+  }
+  theTableReader->Close();
+
+  if (!saved || !QDir().mkpath(cacheStorageLocation))
+    return; // Ignore the failure since we can recompute the cache
+
+  QSaveFile cacheFile(QDir(cacheStorageLocation).filePath(TableReader::GetTestFileName()));
+  if (cacheFile.open(QIODevice::WriteOnly) && cacheFile.write(cache) == cache.size())
+  {
+    cacheFile.commit();
+  }
+
+  if (Debug())
+    BERRY_INFO << "Writing registry cache: " << timer.elapsed() << "ms";
 }
 
 void ExtensionRegistry::ClearRegistryCache()
 {
-//  QString[] keys = new   QString[] {TableReader.TABLE, TableReader.MAIN, TableReader.EXTRA, TableReader.CONTRIBUTIONS, TableReader.ORPHANS};
-//  for (int i = 0; i < keys.length; i++)
-//    try {
-//      cacheStorageManager.remove(keys[i]);
-//    } catch (IOException e) {
-//      log(new Status(IStatus.ERROR, RegistryMessages.OWNER_NAME, IStatus.ERROR, RegistryMessages.meta_registryCacheReadProblems, e));
-//    }
+  theTableReader->Close();
+  if (!cacheStorageLocation.isEmpty() && !cacheStorageReadOnly)
+  {
+    QFile::remove(QDir(cacheStorageLocation).filePath(TableReader::GetTestFileName()));
+  }
   aggregatedTimestamp.Reset();
 }
 
@@ -1027,6 +989,22 @@ bool ExtensionRegistry::UseLazyCacheLoading() const
   return strategy->CacheLazyLoading();
 }
 
+TableReader* ExtensionRegistry::GetTableReader() const
+{
+  return theTableReader.data();
+}
+
+void ExtensionRegistry::CacheObjectLoadFailed(int objectId) const
+{
+  if (!cacheCorrupt.testAndSetRelaxed(0, 1))
+    return; // already reported
+
+  QString message = QString("Registry object %1 could not be read from the registry cache. The cache "
+                            "will be rebuilt from the plug-in manifests on the next start.").arg(objectId);
+  IStatus::Pointer status(new Status(IStatus::WARNING_TYPE, RegistryMessages::OWNER_NAME, 0, message, BERRY_STATUS_LOC));
+  Log(status);
+}
+
 long ExtensionRegistry::ComputeState() const
 {
   return strategy->GetContainerTimestamp();
@@ -21,10 +21,13 @@ found in the LICENSE file.
 #include "berryCombinedEventDelta.h"
 #include "berryListenerList.h"
 
+#include <QAtomicInt>
 #include <QObject>
 #include <QReadWriteLock>
 #include <QWaitCondition>
 
+#include <org_blueberry_core_runtime_Export.h>
+
 class QTranslator;
 
 namespace berry {
@@ -39,11 +42,12 @@ class RegistryObject;
 class RegistryObjectFactory;
 class RegistryObjectManager;
 class RegistryStrategy;
+class TableReader;
 
 /**
  * An implementation for the extension registry API.
  */
-class ExtensionRegistry : public QObject, public IExtensionRegistry
+class org_blueberry_core_runtime_EXPORT ExtensionRegistry : public QObject, public IExtensionRegistry
 {
   Q_OBJECT
   Q_INTERFACES(berry::IExtensionRegistry)
@@ -182,17 +186,23 @@ private:
 
 protected:
 
-  //storage manager associated with the registry cache
-  //StorageManager cacheStorageManager;
+  // location of the registry cache
+  QString cacheStorageLocation;
+
+  // indicates if the registry cache must not be written
+  bool cacheStorageReadOnly;
 
   // Table reader associated with this extension registry
-  //TableReader theTableReader = new TableReader(this);
+  QScopedPointer<TableReader> theTableReader;
+
+  // set if an object could not be read from the cache; the cache is removed on Stop()
+  mutable QAtomicInt cacheCorrupt;
 
   QScopedPointer<RegistryStrategy> strategy; // overridable portions of the registry functionality
 
   /**
-   * Sets new cache file manager. If existing file manager was owned by the registry,
-   * closes it.
+   * Sets the location of the registry cache. The table reader is closed and has
+   * to be pointed to the cache file of the new location.
    *
    * @param cacheBase the base location for the registry cache
    * @param isCacheReadOnly whether the file cache is read only
@@ -214,8 +224,6 @@ protected:
   // Override to provide domain-specific elements to be stored in the extension registry
   void SetElementFactory();
 
-  //TableReader getTableReader() const;
-
   // Find the first location that contains a cache table file and set file manager to it.
   bool CheckCache();
 
@@ -352,6 +360,18 @@ public:
 
   bool UseLazyCacheLoading() const;
 
+  TableReader* GetTableReader() const;
+
+  /**
+   * Called if a registry object listed in the cache could not be read from it. Objects
+   * which are not loaded yet are still read from the cache, so the cache is only removed
+   * when the registry is stopped and the registry is rebuilt from the plug-in manifests
+   * on the next start.
+   *
+   * @param objectId the id of the object which could not be read
+   */
+  void CacheObjectLoadFailed(int objectId) const;
+
   long ComputeState() const;
 
   QObject* CreateExecutableExtension(const SmartPointer<RegistryContributor>& defaultContributor,
@@ -62,6 +62,8 @@ private:
   friend class RegistryObjectManager;
   friend class ExtensionRegistry;
   friend class ExtensionsParser;
+  friend class TableReader;
+  friend class TableWriter;
 
   //The registry that owns this object
   ExtensionRegistry* registry;
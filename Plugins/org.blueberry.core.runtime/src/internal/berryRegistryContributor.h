@@ -15,6 +15,8 @@ found in the LICENSE file.
 
 #include "berryIContributor.h"
 
+#include <org_blueberry_core_runtime_Export.h>
+
 namespace berry {
 
 /**
@@ -35,7 +37,7 @@ namespace berry {
  * </p>
  * @noextend This class is not intended to be subclassed by clients.
  */
-class RegistryContributor : public IContributor
+class org_blueberry_core_runtime_EXPORT RegistryContributor : public IContributor
 {
 
 private:
@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include "berryExtensionHandle.h"
 #include "berryExtensionPoint.h"
 #include "berryExtensionPointHandle.h"
+#include "berryExtensionRegistry.h"
 #include "berryInvalidRegistryObjectException.h"
 #include "berryRegistryObjectReferenceMap.h"
 #include "berryRegistryConstants.h"
@@ -29,6 +30,7 @@ found in the LICENSE file.
 #include "berryRegistryIndexElement.h"
 #include "berryRegistryObject.h"
 #include "berryRegistryProperties.h"
+#include "berryTableReader.h"
 #include "berryTemporaryObjectManager.h"
 #include "berryThirdLevelConfigurationElementHandle.h"
 
@@ -247,28 +249,33 @@ RegistryObjectManager::GetExtensionsFromNamespace(const QString& namespaceName)
   return result;
 }
 
-bool RegistryObjectManager::Init(long /*timeStamp*/)
+bool RegistryObjectManager::Init(const QByteArray& stamp)
 {
-  return false;
-//  QMutexLocker l(&mutex);
-//  TableReader reader = registry.getTableReader();
-//  Object[] results = reader.loadTables(timeStamp);
-//  if (results == null) {
-//    return false;
-//  }
-//  fileOffsets = (OffsetTable) results[0];
-//  extensionPoints = (HashtableOfStringAndInt) results[1];
-//  nextId = ((Integer) results[2]).intValue();
-//  fromCache = true;
-
-//  if (!registry.useLazyCacheLoading()) {
-//    //TODO Here we could grow all the tables to the right size (ReferenceMap)
-//    reader.setHoldObjects(true);
-//    markOrphansHasDirty(getOrphans());
-//    fromCache = reader.readAllCache(this);
-//    formerContributions = getFormerContributions();
-//  }
-//  return fromCache;
+  QMutexLocker l(&mutex);
+  TableReader* reader = registry->GetTableReader();
+  if (!reader->LoadTables(stamp, fileOffsets, extensionPoints, nextId))
+    return false;
+  fromCache = true;
+
+  if (!registry->UseLazyCacheLoading())
+  {
+    for (auto iter = fileOffsets.begin(); iter != fileOffsets.end(); ++iter)
+    {
+      RegistryObject::Pointer object = reader->LoadObject(iter.value(), 0);
+      if (object.IsNull())
+      {
+        fromCache = false;
+        return false;
+      }
+      cache->Put(iter.key(), object);
+      Hold(object);
+    }
+    GetFormerContributions();
+    GetContributors();
+    GetNamespacesIndex();
+    GetOrphans();
+  }
+  return fromCache;
 }
 
 void RegistryObjectManager::AddContribution(const SmartPointer<RegistryContribution>& contribution)
@@ -329,8 +336,7 @@ void RegistryObjectManager::Remove(int id, bool release)
 void RegistryObjectManager::Remove_unlocked(int id, bool release)
 {
   RegistryObject::Pointer toRemove = cache->Get(id);
-//  if (fileOffsets != null)
-//    fileOffsets.removeKey(id);
+  fileOffsets.remove(id);
   if (toRemove.IsNotNull())
     Remove(toRemove, release);
 }
@@ -489,7 +495,7 @@ RegistryObjectManager::ContributorsMapType& RegistryObjectManager::GetContributo
   {
     if (fromCache)
     {
-      //contributors = registry->GetTableReader()->LoadContributors();
+      contributors = registry->GetTableReader()->LoadContributors();
     }
     contributorsLoaded = true;
   }
@@ -544,7 +550,7 @@ KeyedHashSet& RegistryObjectManager::GetNamespacesIndex() const
   {
     if (fromCache)
     {
-      //namespacesIndex = registry->GetTableReader()->LoadNamespaces();
+      namespacesIndex = registry->GetTableReader()->LoadNamespaces();
     }
     namespacesIndexLoaded = true;
   }
@@ -764,7 +770,7 @@ KeyedHashSet& RegistryObjectManager::GetFormerContributions() const
   {
     if (fromCache)
     {
-      //formerContributions = registry->GetTableReader()->LoadContributions();
+      formerContributions = registry->GetTableReader()->LoadContributions();
     }
     formerContributionsLoaded = true;
   }
@@ -801,29 +807,15 @@ SmartPointer<RegistryObject> RegistryObjectManager::BasicGetObject(int id, short
   return result;
 }
 
-SmartPointer<RegistryObject> RegistryObjectManager::Load(int /*id*/, short /*type*/) const
+SmartPointer<RegistryObject> RegistryObjectManager::Load(int id, short type) const
 {
-//  TableReader reader = registry.getTableReader();
-//  if (fileOffsets == null)
-//    return null;
-//  int offset = fileOffsets.get(id);
-//  if (offset == Integer.MIN_VALUE)
-//    return null;
-//  switch (type) {
-//    case CONFIGURATION_ELEMENT :
-//      return reader.loadConfigurationElement(offset);
-
-//    case THIRDLEVEL_CONFIGURATION_ELEMENT :
-//      return reader.loadThirdLevelConfigurationElements(offset, this);
-
-//    case EXTENSION :
-//      return reader.loadExtension(offset);
-
-//    case EXTENSION_POINT :
-//    default : //avoid compile errors. type must always be known
-//      return reader.loadExtensionPointTree(offset, this);
-//  }
-  return RegistryObject::Pointer();
+  QHash<int, quint32>::const_iterator offsetIter = fileOffsets.find(id);
+  if (offsetIter == fileOffsets.end())
+    return RegistryObject::Pointer();
+  RegistryObject::Pointer result = registry->GetTableReader()->LoadObject(offsetIter.value(), type);
+  if (result.IsNull())
+    registry->CacheObjectLoadFailed(id);
+  return result;
 }
 
 RegistryObjectManager::OrphansMapType& RegistryObjectManager::GetOrphans() const
@@ -832,7 +824,7 @@ RegistryObjectManager::OrphansMapType& RegistryObjectManager::GetOrphans() const
   {
     if(fromCache)
     {
-      //orphanExtensions = registry->GetTableReader()->LoadOrphans();
+      orphanExtensions = registry->GetTableReader()->LoadOrphans();
     }
     orphanExtensionsLoaded = true;
   }
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "berryHashtableOfStringAndInt.h"
 #include "berryKeyedHashSet.h"
 
+#include <QByteArray>
 #include <QMutex>
 
 namespace berry {
@@ -101,6 +102,7 @@ protected:
   friend class ExtensionsParser;
   friend class RegistryContribution;
   friend class RegistryObject;
+  friend class TableWriter;
 
   mutable QMutex mutex;
 
@@ -112,9 +114,12 @@ protected:
   typedef QHash<QString, SmartPointer<RegistryContributor> > ContributorsMapType;
 
   /**
-   * Initialize the object manager. Return true if the initialization succeeded, false otherwise
+   * Initialize the object manager from the registry cache. Return true if the initialization
+   * succeeded, false otherwise
+   *
+   * @param stamp the current contributions stamp, see RegistryStrategy::GetContributionsStamp()
    */
-  bool Init(long timeStamp);
+  bool Init(const QByteArray& stamp);
 
   void AddContribution(const SmartPointer<RegistryContribution>& contribution);
 
@@ -206,8 +211,8 @@ private:
   HashtableOfStringAndInt extensionPoints; //This is loaded on startup. Then entries can be added when loading a new plugin from the xml.
   // key: object id, value: an object
   RegistryObjectReferenceMap* cache; //Entries are added by getter. The structure is not thread safe.
-  //key: int, value: int
-  //OffsetTable fileOffsets = null; //This is read once on startup when loading from the cache. Entries are never added here. They are only removed to prevent "removed" objects to be reloaded.
+  //key: object id, value: offset of the object in the registry cache
+  QHash<int, quint32> fileOffsets; //This is read once on startup when loading from the cache. Entries are never added here. They are only removed to prevent "removed" objects to be reloaded.
 
   int nextId; //This is only used to get the next number available.
 
@@ -46,6 +46,8 @@ void RegistryProperties::SetProperty(const QString& propertyName, const QString&
 
 QString RegistryProperties::GetContextProperty(const QString& propertyName)
 {
+  if (context == nullptr)
+    return QString();
   return context->getProperty(propertyName).toString();
 }
 
@@ -15,6 +15,8 @@ found in the LICENSE file.
 
 #include <QHash>
 
+#include <org_blueberry_core_runtime_Export.h>
+
 class ctkPluginContext;
 
 namespace berry {
@@ -23,7 +25,7 @@ namespace berry {
  * Simple Property mechanism to chain property lookup from local registry properties,
  * to ctkPluginContext properties or System properties otherwise.
  */
-class RegistryProperties
+class org_blueberry_core_runtime_EXPORT RegistryProperties
 {
 
 private:
@@ -19,6 +19,7 @@ found in the LICENSE file.
 #include "berryRegistryConstants.h"
 #include "berryRegistryContributor.h"
 #include "berryRegistryMessages.h"
+#include "berryRegistryProperties.h"
 #include "berryRegistrySupport.h"
 #include "berryStatus.h"
 #include "berryLog.h"
@@ -29,10 +30,14 @@ found in the LICENSE file.
 #include <ctkPluginContext.h>
 #include <ctkUtils.h>
 
+#include <QCryptographicHash>
 #include <QFileInfo>
 #include <QDateTime>
+#include <QUrl>
 #include <QXmlSimpleReader>
 
+#include <algorithm>
+
 namespace berry {
 
 RegistryStrategy::RegistryStrategy(const QList<QString>& storageDirs, const QList<bool>& cacheReadOnly,
@@ -198,12 +203,14 @@ bool RegistryStrategy::DebugRegistryEvents() const
 
 bool RegistryStrategy::CacheUse() const
 {
-  return true;
+  return RegistryProperties::GetProperty(RegistryConstants::PROP_NO_REGISTRY_CACHE)
+      .compare("true", Qt::CaseInsensitive) != 0;
 }
 
 bool RegistryStrategy::CacheLazyLoading() const
 {
-  return true;
+  return RegistryProperties::GetProperty(RegistryConstants::PROP_NO_LAZY_REGISTRY_CACHE_LOADING)
+      .compare("true", Qt::CaseInsensitive) != 0;
 }
 
 long RegistryStrategy::GetContainerTimestamp() const
@@ -216,6 +223,37 @@ long RegistryStrategy::GetContributionsTimestamp() const
   return 0;
 }
 
+QByteArray RegistryStrategy::GetContributionsStamp() const
+{
+  ctkPluginContext* context = org_blueberry_core_runtime_Activator::getPluginContext();
+  if (context == nullptr)
+    return QByteArray();
+
+  QList<QSharedPointer<ctkPlugin> > plugins = context->getPlugins();
+  std::sort(plugins.begin(), plugins.end(), [](const QSharedPointer<ctkPlugin>& p1, const QSharedPointer<ctkPlugin>& p2) {
+    return p1->getPluginId() < p2->getPluginId();
+  });
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  for (const auto& plugin : std::as_const(plugins))
+  {
+    // the system plugin does not contribute to the registry
+    if (plugin->getPluginId() == 0)
+      continue;
+
+    QFileInfo pluginInfo(QUrl(plugin->getLocation()).toLocalFile());
+    qint64 lastModified = pluginInfo.exists() ? pluginInfo.lastModified().toMSecsSinceEpoch() : -1;
+
+    hash.addData(QString("%1|%2|%3|%4|%5\n")
+                 .arg(plugin->getPluginId())
+                 .arg(plugin->getSymbolicName())
+                 .arg(plugin->getVersion().toString())
+                 .arg(plugin->getLocation())
+                 .arg(lastModified).toUtf8());
+  }
+  return hash.result();
+}
+
 bool RegistryStrategy::CheckContributionsTimestamp() const
 {
   return trackTimestamp;
@@ -15,9 +15,12 @@ found in the LICENSE file.
 
 #include <berrySmartPointer.h>
 
+#include <QByteArray>
 #include <QList>
 #include <QSharedPointer>
 
+#include <org_blueberry_core_runtime_Export.h>
+
 class ctkPlugin;
 
 class QTranslator;
@@ -51,7 +54,7 @@ class RegistryContributor;
  * </p><p>
  * This class can be overridden and/or instantiated by clients.
  */
-class RegistryStrategy
+class org_blueberry_core_runtime_EXPORT RegistryStrategy
 {
 
 private:
@@ -109,7 +112,7 @@ public:
   RegistryStrategy(const QList<QString>& storageDirs, const QList<bool>& cacheReadOnly,
                    QObject* key);
 
-  ~RegistryStrategy();
+  virtual ~RegistryStrategy();
 
   /**
    * Returns the number of possible cache locations for this registry.
@@ -176,7 +179,7 @@ public:
    * @param loadedFromCache true is registry contents was loaded from
    * cache when the registry was created
    */
-  void OnStart(IExtensionRegistry* registry, bool loadedFromCache);
+  virtual void OnStart(IExtensionRegistry* registry, bool loadedFromCache);
 
   /**
    * Override this method to provide additional processing to be performed
@@ -184,7 +187,7 @@ public:
    * <code>super.onStop()</code> at the end of the processing.
    * @param registry the extension registry being stopped
    */
-  void OnStop(IExtensionRegistry* registry);
+  virtual void OnStop(IExtensionRegistry* registry);
 
   /**
    * Creates an executable extension. Override this method to supply an alternative processing
@@ -266,7 +269,8 @@ public:
    * Specifies if the extension registry should use cache to store registry data between
    * invocations.
    * <p>
-   * The default implementation enables caching returning <code>true</code>.
+   * The default implementation enables caching unless the property
+   * <code>BlueBerry.noRegistryCache</code> is set to <code>true</code>.
    * </p>
    *
    * @return <code>true</code> if the cache should be used and <code>false</code> otherwise
@@ -277,7 +281,8 @@ public:
    * Specifies if lazy cache loading is used.
    * <p>
    * The default implementation specifies that lazy cache loading is going to be used
-   * and therefore returns <code>true</code>.
+   * unless the property <code>BlueBerry.noLazyRegistryCacheLoading</code> is set to
+   * <code>true</code>.
    * </p>
    *
    * @return <code>true</code> if lazy cache loading is used and <code>false</code> otherwise
@@ -331,6 +336,20 @@ public:
    */
   long GetContributionsTimestamp() const;
 
+  /**
+   * Identifies the installed plug-ins the registry contents are created from.
+   * <p>
+   * The stamp is computed from the identifier, symbolic name, version, location and
+   * modification time of all installed plug-ins. It is stored in the registry cache and
+   * the cache is only used if its stamp matches the current one, i.e. if no plug-in was
+   * installed, uninstalled or modified since the cache was written.
+   * </p>
+   *
+   * @return the stamp or an empty byte array if it cannot be computed (the registry
+   *         cache is not used in this case)
+   */
+  virtual QByteArray GetContributionsStamp() const;
+
   bool CheckContributionsTimestamp() const;
 
   long GetExtendedTimestamp(const QSharedPointer<ctkPlugin>& plugin, const QString& pluginManifest) const;
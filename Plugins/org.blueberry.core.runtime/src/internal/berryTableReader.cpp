@@ -0,0 +1,328 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "berryTableReader.h"
+
+#include "berryConfigurationElement.h"
+#include "berryExtension.h"
+#include "berryExtensionPoint.h"
+#include "berryRegistryContribution.h"
+#include "berryRegistryContributor.h"
+#include "berryRegistryIndexElement.h"
+#include "berryRegistryObjectManager.h"
+
+#include <QDataStream>
+
+namespace berry {
+
+const QString TableReader::CACHE_FILE = "registry.cache";
+const quint32 TableReader::CACHE_MAGIC = 0x42425243;
+const quint32 TableReader::CACHE_VERSION = 1;
+const int TableReader::STREAM_VERSION = QDataStream::Qt_5_15;
+
+TableReader::TableReader(ExtensionRegistry* registry)
+  : registry(registry)
+{
+  for (auto& section : sections)
+    section = { 0, 0 };
+}
+
+TableReader::~TableReader()
+{
+  Close();
+}
+
+QString TableReader::GetTestFileName()
+{
+  return CACHE_FILE;
+}
+
+void TableReader::SetCacheFile(const QString& fileName)
+{
+  Close();
+  cacheFile.setFileName(fileName);
+}
+
+bool TableReader::LoadTables(const QByteArray& stamp, OffsetTableType& offsets,
+                             HashtableOfStringAndInt& extensionPoints, int& nextId)
+{
+  Close();
+
+  if (stamp.isEmpty() || !cacheFile.open(QIODevice::ReadOnly))
+    return false;
+
+  // Map the file so that objects are only read from disk when they are loaded
+  const qint64 size = cacheFile.size();
+  if (uchar* data = cacheFile.map(0, size))
+  {
+    content = QByteArray::fromRawData(reinterpret_cast<const char*>(data), size);
+  }
+  else
+  {
+    content = cacheFile.readAll();
+  }
+
+  QDataStream in(content);
+  in.setVersion(STREAM_VERSION);
+
+  quint32 magic = 0;
+  quint32 version = 0;
+  in >> magic >> version;
+  if (in.status() != QDataStream::Ok || magic != CACHE_MAGIC || version != CACHE_VERSION)
+  {
+    Close();
+    return false;
+  }
+
+  QByteArray cacheStamp;
+  qint32 cacheNextId = 0;
+  in >> cacheStamp >> cacheNextId;
+  if (in.status() != QDataStream::Ok || cacheStamp != stamp)
+  {
+    Close();
+    return false;
+  }
+
+  for (auto& section : sections)
+  {
+    quint32 sectionSize = 0;
+    in >> sectionSize;
+    section = { in.device()->pos(), sectionSize };
+    if (in.status() != QDataStream::Ok || in.skipRawData(sectionSize) != static_cast<int>(sectionSize))
+    {
+      Close();
+      return false;
+    }
+  }
+
+  OffsetTableType cacheOffsets;
+  QDataStream offsetsIn(GetSection(OFFSETS));
+  offsetsIn.setVersion(STREAM_VERSION);
+  offsetsIn >> cacheOffsets;
+
+  QHash<QString, int> cacheExtensionPoints;
+  QDataStream extensionPointsIn(GetSection(EXTENSION_POINTS));
+  extensionPointsIn.setVersion(STREAM_VERSION);
+  extensionPointsIn >> cacheExtensionPoints;
+
+  if (offsetsIn.status() != QDataStream::Ok || extensionPointsIn.status() != QDataStream::Ok)
+  {
+    Close();
+    return false;
+  }
+
+  // Check that each offset refers to the object it is listed for. This rejects a corrupt
+  // cache on startup instead of failing when the object is loaded lazily.
+  const QByteArray objects = GetSection(OBJECTS);
+  QDataStream objectsIn(objects);
+  objectsIn.setVersion(STREAM_VERSION);
+  for (auto iter = cacheOffsets.cbegin(); iter != cacheOffsets.cend(); ++iter)
+  {
+    if (iter.value() >= static_cast<quint32>(objects.size()) || !objectsIn.device()->seek(iter.value()))
+    {
+      Close();
+      return false;
+    }
+
+    qint8 objectType = 0;
+    qint32 id = 0;
+    objectsIn >> objectType >> id;
+    if (objectsIn.status() != QDataStream::Ok || id != iter.key() ||
+        (objectType != RegistryObjectManager::CONFIGURATION_ELEMENT &&
+         objectType != RegistryObjectManager::EXTENSION &&
+         objectType != RegistryObjectManager::EXTENSION_POINT))
+    {
+      Close();
+      return false;
+    }
+  }
+
+  offsets = cacheOffsets;
+  static_cast<QHash<QString, int>&>(extensionPoints) = cacheExtensionPoints;
+  nextId = cacheNextId;
+  return true;
+}
+
+SmartPointer<RegistryObject> TableReader::LoadObject(quint32 offset, short type) const
+{
+  QByteArray objects = GetSection(OBJECTS);
+  if (offset >= static_cast<quint32>(objects.size()))
+    return RegistryObject::Pointer();
+
+  QDataStream in(objects);
+  in.setVersion(STREAM_VERSION);
+  in.device()->seek(offset);
+
+  qint8 objectType = 0;
+  qint32 id = 0;
+  QList<int> children;
+  in >> objectType >> id >> children;
+
+  RegistryObject::Pointer result;
+  switch (objectType)
+  {
+  case RegistryObjectManager::CONFIGURATION_ELEMENT:
+  {
+    if (type != 0 && type != RegistryObjectManager::CONFIGURATION_ELEMENT &&
+        type != RegistryObjectManager::THIRDLEVEL_CONFIGURATION_ELEMENT)
+      return RegistryObject::Pointer();
+
+    QString contributorId;
+    QString name;
+    QList<QString> propertiesAndValue;
+    qint32 parentId = 0;
+    qint16 parentType = 0;
+    in >> contributorId >> name >> propertiesAndValue >> parentId >> parentType;
+
+    result = new ConfigurationElement(id, contributorId, name, propertiesAndValue, children,
+                                      -1, parentId, parentType, registry, true);
+    break;
+  }
+  case RegistryObjectManager::EXTENSION:
+  {
+    if (type != 0 && type != RegistryObjectManager::EXTENSION)
+      return RegistryObject::Pointer();
+
+    QString simpleId;
+    QString namespaceName;
+    QList<QString> extraInformation;
+    in >> simpleId >> namespaceName >> extraInformation;
+    if (extraInformation.size() != Extension::EXTRA_SIZE)
+      return RegistryObject::Pointer();
+
+    Extension::Pointer extension(new Extension(id, simpleId, namespaceName, children, -1, registry, true));
+    extension->extraInformation = extraInformation;
+    result = extension;
+    break;
+  }
+  case RegistryObjectManager::EXTENSION_POINT:
+  {
+    if (type != 0 && type != RegistryObjectManager::EXTENSION_POINT)
+      return RegistryObject::Pointer();
+
+    QList<QString> extraInformation;
+    in >> extraInformation;
+    if (extraInformation.size() != ExtensionPoint::EXTRA_SIZE)
+      return RegistryObject::Pointer();
+
+    ExtensionPoint::Pointer extensionPoint(new ExtensionPoint(id, children, -1, registry, true));
+    extensionPoint->extraInformation = extraInformation;
+    result = extensionPoint;
+    break;
+  }
+  default:
+    return RegistryObject::Pointer();
+  }
+
+  if (in.status() != QDataStream::Ok)
+    return RegistryObject::Pointer();
+  return result;
+}
+
+KeyedHashSet TableReader::LoadContributions() const
+{
+  QDataStream in(GetSection(CONTRIBUTIONS));
+  in.setVersion(STREAM_VERSION);
+
+  qint32 size = 0;
+  in >> size;
+
+  KeyedHashSet result;
+  for (int i = 0; i < size && in.status() == QDataStream::Ok; ++i)
+  {
+    QString contributorId;
+    QList<int> children;
+    in >> contributorId >> children;
+
+    RegistryContribution::Pointer contribution(new RegistryContribution(contributorId, registry, true));
+    contribution->SetRawChildren(children);
+    result.Add(contribution);
+  }
+  return result;
+}
+
+TableReader::ContributorsMapType TableReader::LoadContributors() const
+{
+  QDataStream in(GetSection(CONTRIBUTORS));
+  in.setVersion(STREAM_VERSION);
+
+  qint32 size = 0;
+  in >> size;
+
+  ContributorsMapType result;
+  for (int i = 0; i < size && in.status() == QDataStream::Ok; ++i)
+  {
+    QString actualId;
+    QString actualName;
+    QString hostId;
+    QString hostName;
+    in >> actualId >> actualName >> hostId >> hostName;
+
+    result.insert(actualId, RegistryContributor::Pointer(new RegistryContributor(actualId, actualName, hostId, hostName)));
+  }
+  return result;
+}
+
+KeyedHashSet TableReader::LoadNamespaces() const
+{
+  QDataStream in(GetSection(NAMESPACES));
+  in.setVersion(STREAM_VERSION);
+
+  qint32 size = 0;
+  in >> size;
+
+  KeyedHashSet result;
+  for (int i = 0; i < size && in.status() == QDataStream::Ok; ++i)
+  {
+    QString key;
+    QList<int> extensionPoints;
+    QList<int> extensions;
+    in >> key >> extensionPoints >> extensions;
+
+    result.Add(RegistryIndexElement::Pointer(new RegistryIndexElement(key, extensionPoints, extensions)));
+  }
+  return result;
+}
+
+TableReader::OrphansMapType TableReader::LoadOrphans() const
+{
+  QDataStream in(GetSection(ORPHANS));
+  in.setVersion(STREAM_VERSION);
+
+  OrphansMapType result;
+  in >> result;
+  if (in.status() != QDataStream::Ok)
+    return OrphansMapType();
+  return result;
+}
+
+void TableReader::Close()
+{
+  // content may refer to the mapped file, release it first
+  content.clear();
+  for (auto& section : sections)
+    section = { 0, 0 };
+
+  if (cacheFile.isOpen())
+    cacheFile.close();
+}
+
+QByteArray TableReader::GetSection(Section section) const
+{
+  const SectionLocation& location = sections[section];
+  if (content.isEmpty() || location.offset + location.size > content.size())
+    return QByteArray();
+
+  return QByteArray::fromRawData(content.constData() + location.offset, location.size);
+}
+
+}
@@ -0,0 +1,139 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef BERRYTABLEREADER_H
+#define BERRYTABLEREADER_H
+
+#include <berrySmartPointer.h>
+
+#include "berryHashtableOfStringAndInt.h"
+#include "berryKeyedHashSet.h"
+
+#include <QFile>
+#include <QHash>
+
+namespace berry {
+
+class ExtensionRegistry;
+class RegistryContributor;
+class RegistryObject;
+
+/**
+ * Reads the registry cache written by the TableWriter.
+ *
+ * The cache is a single binary file. Its header identifies the cache format and the
+ * installed plug-ins the cache was written for (see RegistryStrategy::GetContributionsStamp()).
+ * The header is followed by sections holding the registry objects and the tables of the
+ * RegistryObjectManager. On startup only the header, the object offsets and the extension
+ * point table are read. Registry objects and the remaining tables are read on demand.
+ */
+class TableReader
+{
+public:
+
+  typedef QHash<int, quint32> OffsetTableType;
+  typedef QHash<QString, QList<int> > OrphansMapType;
+  typedef QHash<QString, SmartPointer<RegistryContributor> > ContributorsMapType;
+
+  // Sections of the cache file, in the order they are stored
+  enum Section {
+    OBJECTS = 0,
+    OFFSETS,
+    EXTENSION_POINTS,
+    CONTRIBUTIONS,
+    CONTRIBUTORS,
+    NAMESPACES,
+    ORPHANS,
+    SECTION_COUNT
+  };
+
+  // Name of the cache file
+  static const QString CACHE_FILE; // = "registry.cache";
+
+  // Identifies a file as registry cache
+  static const quint32 CACHE_MAGIC; // = 0x42425243 ("BBRC")
+
+  // Version of the cache format. Increment it whenever the format changes.
+  static const quint32 CACHE_VERSION; // = 1;
+
+  // Version of the QDataStream serialization
+  static const int STREAM_VERSION;
+
+  TableReader(ExtensionRegistry* registry);
+
+  ~TableReader();
+
+  /**
+   * The name of the file whose existence indicates a registry cache in a location.
+   */
+  static QString GetTestFileName();
+
+  void SetCacheFile(const QString& fileName);
+
+  /**
+   * Opens the cache file and reads the tables needed on startup. The type and id stored
+   * at each object offset are checked so that a corrupt cache is rejected here.
+   *
+   * @param stamp the current contributions stamp; the cache is rejected if it was written for another one
+   * @param offsets receives the offsets of the registry objects in the cache
+   * @param extensionPoints receives the extension point table
+   * @param nextId receives the next available registry object id
+   * @return true if the cache is valid and the tables were read, false otherwise
+   */
+  bool LoadTables(const QByteArray& stamp, OffsetTableType& offsets,
+                  HashtableOfStringAndInt& extensionPoints, int& nextId);
+
+  /**
+   * Reads the registry object stored at the passed offset.
+   *
+   * @param type one of the RegistryObjectManager object types the stored object has to match,
+   *        or 0 to accept any type
+   * @return the object or null if it could not be read
+   */
+  SmartPointer<RegistryObject> LoadObject(quint32 offset, short type) const;
+
+  KeyedHashSet LoadContributions() const;
+
+  ContributorsMapType LoadContributors() const;
+
+  KeyedHashSet LoadNamespaces() const;
+
+  OrphansMapType LoadOrphans() const;
+
+  /**
+   * Releases the cache file. Objects that are not loaded yet can no longer be read afterwards.
+   */
+  void Close();
+
+private:
+
+  struct SectionLocation
+  {
+    qint64 offset;
+    quint32 size;
+  };
+
+  ExtensionRegistry* registry;
+
+  QFile cacheFile;
+
+  // the content of the cache file; refers to the mapped file if mapping is supported
+  QByteArray content;
+
+  SectionLocation sections[SECTION_COUNT];
+
+  QByteArray GetSection(Section section) const;
+};
+
+}
+
+#endif // BERRYTABLEREADER_H
@@ -0,0 +1,293 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "berryTableWriter.h"
+
+#include "berryConfigurationElement.h"
+#include "berryExtension.h"
+#include "berryExtensionPoint.h"
+#include "berryInvalidRegistryObjectException.h"
+#include "berryRegistryContribution.h"
+#include "berryRegistryContributor.h"
+#include "berryRegistryIndexElement.h"
+#include "berryRegistryObjectManager.h"
+#include "berryTableReader.h"
+
+#include <QBuffer>
+#include <QDataStream>
+
+#include <utility>
+
+namespace berry {
+
+bool TableWriter::SaveCache(const RegistryObjectManager& objectManager, const QByteArray& stamp, QByteArray& cache)
+{
+  objects.clear();
+  objectIds.clear();
+  cache.clear();
+
+  if (stamp.isEmpty())
+    return false;
+
+  try
+  {
+    CollectObjects(objectManager);
+
+    QByteArray objectsSection;
+    TableReader::OffsetTableType offsets;
+    {
+      QBuffer buffer(&objectsSection);
+      buffer.open(QIODevice::WriteOnly);
+      QDataStream out(&buffer);
+      out.setVersion(TableReader::STREAM_VERSION);
+      for (const ObjectEntry& entry : std::as_const(objects))
+      {
+        offsets.insert(entry.first->GetObjectId(), static_cast<quint32>(buffer.pos()));
+        SaveObject(out, entry);
+      }
+    }
+
+    QByteArray offsetsSection;
+    {
+      QDataStream out(&offsetsSection, QIODevice::WriteOnly);
+      out.setVersion(TableReader::STREAM_VERSION);
+      out << offsets;
+    }
+
+    QByteArray extensionPointsSection;
+    {
+      QHash<QString, int> extensionPoints;
+      const HashtableOfStringAndInt allExtensionPoints = objectManager.GetExtensionPoints();
+      for (auto iter = allExtensionPoints.begin(); iter != allExtensionPoints.end(); ++iter)
+      {
+        if (objectIds.contains(iter.value()))
+          extensionPoints.insert(iter.key(), iter.value());
+      }
+
+      QDataStream out(&extensionPointsSection, QIODevice::WriteOnly);
+      out.setVersion(TableReader::STREAM_VERSION);
+      out << extensionPoints;
+    }
+
+    QByteArray sections[TableReader::SECTION_COUNT];
+    sections[TableReader::OBJECTS] = objectsSection;
+    sections[TableReader::OFFSETS] = offsetsSection;
+    sections[TableReader::EXTENSION_POINTS] = extensionPointsSection;
+    sections[TableReader::CONTRIBUTIONS] = SaveContributions(objectManager);
+    sections[TableReader::CONTRIBUTORS] = SaveContributors(objectManager);
+    sections[TableReader::NAMESPACES] = SaveNamespaces(objectManager);
+    sections[TableReader::ORPHANS] = SaveOrphans(objectManager);
+
+    QDataStream out(&cache, QIODevice::WriteOnly);
+    out.setVersion(TableReader::STREAM_VERSION);
+    out << TableReader::CACHE_MAGIC << TableReader::CACHE_VERSION << stamp
+        << static_cast<qint32>(objectManager.GetNextId());
+    for (const QByteArray& section : sections)
+    {
+      out << static_cast<quint32>(section.size());
+      out.writeRawData(section.constData(), section.size());
+    }
+
+    objects.clear();
+    objectIds.clear();
+    return out.status() == QDataStream::Ok;
+  }
+  catch (const ctkException&)
+  {
+    objects.clear();
+    objectIds.clear();
+    cache.clear();
+    return false;
+  }
+}
+
+void TableWriter::CollectObjects(const RegistryObjectManager& objectManager)
+{
+  for (const KeyedHashSet& contributions : objectManager.GetContributions())
+  {
+    for (const KeyedElement::Pointer& element : contributions.Elements())
+    {
+      RegistryContribution::Pointer contribution = element.Cast<RegistryContribution>();
+      if (contribution.IsNull() || !contribution->ShouldPersist())
+        continue;
+
+      for (int id : contribution->GetExtensionPoints())
+      {
+        RegistryObject::Pointer extensionPoint = GetObject(objectManager, id, RegistryObjectManager::EXTENSION_POINT);
+        if (extensionPoint.IsNull() || !extensionPoint->ShouldPersist() || objectIds.contains(id))
+          continue;
+        objects.push_back(qMakePair(extensionPoint, static_cast<short>(RegistryObjectManager::EXTENSION_POINT)));
+        objectIds.insert(id);
+      }
+
+      for (int id : contribution->GetExtensions())
+      {
+        RegistryObject::Pointer extension = GetObject(objectManager, id, RegistryObjectManager::EXTENSION);
+        if (extension.IsNull() || !extension->ShouldPersist() || objectIds.contains(id))
+          continue;
+        objects.push_back(qMakePair(extension, static_cast<short>(RegistryObjectManager::EXTENSION)));
+        objectIds.insert(id);
+        CollectConfigurationElements(objectManager, extension->GetRawChildren());
+      }
+    }
+  }
+}
+
+void TableWriter::CollectConfigurationElements(const RegistryObjectManager& objectManager, const QList<int>& ids)
+{
+  for (int id : ids)
+  {
+    RegistryObject::Pointer element = GetObject(objectManager, id, RegistryObjectManager::CONFIGURATION_ELEMENT);
+    if (element.IsNull() || !element->ShouldPersist() || objectIds.contains(id))
+      continue;
+    objects.push_back(qMakePair(element, static_cast<short>(RegistryObjectManager::CONFIGURATION_ELEMENT)));
+    objectIds.insert(id);
+    CollectConfigurationElements(objectManager, element->GetRawChildren());
+  }
+}
+
+SmartPointer<RegistryObject> TableWriter::GetObject(const RegistryObjectManager& objectManager, int id, short type) const
+{
+  try
+  {
+    return objectManager.GetObject(id, type);
+  }
+  catch (const InvalidRegistryObjectException&)
+  {
+    // the object has been removed, it is not written
+    return RegistryObject::Pointer();
+  }
+}
+
+QList<int> TableWriter::Filter(const QList<int>& ids) const
+{
+  QList<int> result;
+  for (int id : ids)
+  {
+    if (objectIds.contains(id))
+      result.push_back(id);
+  }
+  return result;
+}
+
+void TableWriter::SaveObject(QDataStream& out, const ObjectEntry& entry) const
+{
+  const RegistryObject::Pointer& object = entry.first;
+  out << static_cast<qint8>(entry.second) << static_cast<qint32>(object->GetObjectId())
+      << Filter(object->GetRawChildren());
+
+  switch (entry.second)
+  {
+  case RegistryObjectManager::CONFIGURATION_ELEMENT:
+  {
+    ConfigurationElement::Pointer element = object.Cast<ConfigurationElement>();
+    out << element->contributorId << element->name << element->propertiesAndValue
+        << static_cast<qint32>(element->parentId) << static_cast<qint16>(element->parentType);
+    break;
+  }
+  case RegistryObjectManager::EXTENSION:
+  {
+    Extension::Pointer extension = object.Cast<Extension>();
+    out << extension->simpleId << extension->namespaceIdentifier << extension->GetExtraData();
+    break;
+  }
+  case RegistryObjectManager::EXTENSION_POINT:
+  {
+    ExtensionPoint::Pointer extensionPoint = object.Cast<ExtensionPoint>();
+    out << extensionPoint->GetExtraData();
+    break;
+  }
+  }
+}
+
+QByteArray TableWriter::SaveContributions(const RegistryObjectManager& objectManager) const
+{
+  QList<RegistryContribution::Pointer> contributions;
+  for (const KeyedHashSet& contributionSet : objectManager.GetContributions())
+  {
+    for (const KeyedElement::Pointer& element : contributionSet.Elements())
+    {
+      RegistryContribution::Pointer contribution = element.Cast<RegistryContribution>();
+      if (contribution.IsNotNull() && contribution->ShouldPersist())
+        contributions.push_back(contribution);
+    }
+  }
+
+  QByteArray section;
+  QDataStream out(&section, QIODevice::WriteOnly);
+  out.setVersion(TableReader::STREAM_VERSION);
+  out << static_cast<qint32>(contributions.size());
+  for (const RegistryContribution::Pointer& contribution : std::as_const(contributions))
+  {
+    const QList<int> extensionPoints = Filter(contribution->GetExtensionPoints());
+    const QList<int> extensions = Filter(contribution->GetExtensions());
+
+    // same layout as RegistryContribution::children
+    QList<int> children;
+    children << extensionPoints.size() << extensions.size() << extensionPoints << extensions;
+    out << contribution->GetContributorId() << children;
+  }
+  return section;
+}
+
+QByteArray TableWriter::SaveContributors(const RegistryObjectManager& objectManager) const
+{
+  const RegistryObjectManager::ContributorsMapType& contributors = objectManager.GetContributors();
+
+  QByteArray section;
+  QDataStream out(&section, QIODevice::WriteOnly);
+  out.setVersion(TableReader::STREAM_VERSION);
+  out << static_cast<qint32>(contributors.size());
+  for (const RegistryContributor::Pointer& contributor : contributors)
+  {
+    out << contributor->GetActualId() << contributor->GetActualName()
+        << contributor->GetId() << contributor->GetName();
+  }
+  return section;
+}
+
+QByteArray TableWriter::SaveNamespaces(const RegistryObjectManager& objectManager) const
+{
+  const QList<KeyedElement::Pointer> namespaces = objectManager.GetNamespacesIndex().Elements();
+
+  QByteArray section;
+  QDataStream out(&section, QIODevice::WriteOnly);
+  out.setVersion(TableReader::STREAM_VERSION);
+  out << static_cast<qint32>(namespaces.size());
+  for (const KeyedElement::Pointer& element : namespaces)
+  {
+    RegistryIndexElement::Pointer indexElement = element.Cast<RegistryIndexElement>();
+    out << indexElement->GetKey() << Filter(indexElement->GetExtensionPoints())
+        << Filter(indexElement->GetExtensions());
+  }
+  return section;
+}
+
+QByteArray TableWriter::SaveOrphans(const RegistryObjectManager& objectManager) const
+{
+  TableReader::OrphansMapType orphans;
+  const RegistryObjectManager::OrphansMapType allOrphans = objectManager.GetOrphanExtensions();
+  for (auto iter = allOrphans.begin(); iter != allOrphans.end(); ++iter)
+  {
+    const QList<int> extensions = Filter(iter.value());
+    if (!extensions.empty())
+      orphans.insert(iter.key(), extensions);
+  }
+
+  QByteArray section;
+  QDataStream out(&section, QIODevice::WriteOnly);
+  out.setVersion(TableReader::STREAM_VERSION);
+  out << orphans;
+  return section;
+}
+
+}
@@ -0,0 +1,83 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef BERRYTABLEWRITER_H
+#define BERRYTABLEWRITER_H
+
+#include <berrySmartPointer.h>
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QSet>
+
+class QDataStream;
+
+namespace berry {
+
+class RegistryObject;
+class RegistryObjectManager;
+
+/**
+ * Writes the registry cache read by the TableReader.
+ *
+ * Only objects of persisted contributions are written. References to objects which
+ * are not written (e.g. extensions of non-persisted contributions) are dropped from
+ * the written children lists and tables.
+ */
+class TableWriter
+{
+public:
+
+  /**
+   * Serializes the objects and tables of the passed object manager.
+   *
+   * @param objectManager the object manager to save
+   * @param stamp the contributions stamp the cache is valid for
+   * @param cache receives the content of the cache file
+   * @return true if the cache was written, false otherwise
+   */
+  bool SaveCache(const RegistryObjectManager& objectManager, const QByteArray& stamp, QByteArray& cache);
+
+private:
+
+  typedef QPair<SmartPointer<RegistryObject>, short> ObjectEntry;
+
+  // objects to be written, in the order they are written
+  QList<ObjectEntry> objects;
+
+  // ids of the objects to be written
+  QSet<int> objectIds;
+
+  void CollectObjects(const RegistryObjectManager& objectManager);
+
+  void CollectConfigurationElements(const RegistryObjectManager& objectManager, const QList<int>& ids);
+
+  SmartPointer<RegistryObject> GetObject(const RegistryObjectManager& objectManager, int id, short type) const;
+
+  QList<int> Filter(const QList<int>& ids) const;
+
+  void SaveObject(QDataStream& out, const ObjectEntry& entry) const;
+
+  QByteArray SaveContributions(const RegistryObjectManager& objectManager) const;
+
+  QByteArray SaveContributors(const RegistryObjectManager& objectManager) const;
+
+  QByteArray SaveNamespaces(const RegistryObjectManager& objectManager) const;
+
+  QByteArray SaveOrphans(const RegistryObjectManager& objectManager) const;
+};
+
+}
+
+#endif // BERRYTABLEWRITER_H
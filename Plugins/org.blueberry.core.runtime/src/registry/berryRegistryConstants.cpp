@@ -20,6 +20,7 @@ const QString RegistryConstants::PROP_NO_REGISTRY_FLUSHING = "BlueBerry.noRegist
 const QString RegistryConstants::PROP_NO_LAZY_REGISTRY_CACHE_LOADING = "BlueBerry.noLazyRegistryCacheLoading";
 const QString RegistryConstants::PROP_CHECK_CONFIG = "osgi.checkConfiguration";
 const QString RegistryConstants::PROP_NO_REGISTRY_CACHE = "BlueBerry.noRegistryCache";
+const QString RegistryConstants::PROP_PLUGIN_CACHE_DIR = "BlueBerry.plugin_cache_dir";
 const QString RegistryConstants::PROP_DEFAULT_REGISTRY = "BlueBerry.createRegistry";
 const QString RegistryConstants::PROP_REGISTRY_nullptr_USER_TOKEN = "BlueBerry.registry.nulltoken";
 const QString RegistryConstants::PROP_REGISTRY_MULTI_LANGUAGE = "BlueBerry.registry.MultiLanguage";
@@ -33,6 +33,7 @@ struct org_blueberry_core_runtime_EXPORT RegistryConstants
   static const QString PROP_NO_LAZY_REGISTRY_CACHE_LOADING; // = "BlueBerry.noLazyRegistryCacheLoading";
   static const QString PROP_CHECK_CONFIG; // = "osgi.checkConfiguration";
   static const QString PROP_NO_REGISTRY_CACHE; // = "BlueBerry.noRegistryCache";
+  static const QString PROP_PLUGIN_CACHE_DIR; // = "BlueBerry.plugin_cache_dir";
   static const QString PROP_DEFAULT_REGISTRY; // = "BlueBerry.createRegistry";
   static const QString PROP_REGISTRY_nullptr_USER_TOKEN; // = "BlueBerry.registry.nulltoken";
   static const QString PROP_REGISTRY_MULTI_LANGUAGE; // = "BlueBerry.registry.MultiLanguage";
@@ -0,0 +1,282 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+// BlueBerry includes
+#include <berryExtensionRegistry.h>
+#include <berryIConfigurationElement.h>
+#include <berryIExtension.h>
+#include <berryIExtensionPoint.h>
+#include <berryInvalidRegistryObjectException.h>
+#include <berryRegistryConstants.h>
+#include <berryRegistryContributor.h>
+#include <berryRegistryProperties.h>
+#include <berryRegistryStrategy.h>
+#include <berryTableReader.h>
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace
+{
+  const QString POINT_ID = "org.blueberry.test.point";
+
+  const QByteArray MANIFEST =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<?BlueBerry version=\"0.1\"?>\n"
+    "<plugin>\n"
+    "  <extension-point id=\"org.blueberry.test.point\" name=\"Test Point\"/>\n"
+    "  <extension id=\"first\" point=\"org.blueberry.test.point\">\n"
+    "    <element name=\"a\" value=\"1\"/>\n"
+    "    <element name=\"b\" value=\"2\"/>\n"
+    "  </extension>\n"
+    "  <extension id=\"second\" point=\"org.blueberry.test.point\">\n"
+    "    <element name=\"c\" value=\"3\"/>\n"
+    "  </extension>\n"
+    "</plugin>\n";
+
+  /**
+   * Strategy which stores the cache in a test directory and contributes MANIFEST
+   * if the registry was not filled from the cache, like the CTK strategy does for the
+   * installed plug-ins.
+   */
+  class TestRegistryStrategy : public berry::RegistryStrategy
+  {
+  public:
+    TestRegistryStrategy(const QString& storageDir, const QByteArray& stamp, QObject* key, bool& loadedFromCache)
+      : RegistryStrategy(QList<QString>() << storageDir, QList<bool>() << false, key),
+        m_Stamp(stamp), m_Key(key), m_LoadedFromCache(loadedFromCache)
+    {
+    }
+
+    void OnStart(berry::IExtensionRegistry* reg, bool loadedFromCache) override
+    {
+      m_LoadedFromCache = loadedFromCache;
+      if (loadedFromCache)
+        return;
+
+      auto registry = dynamic_cast<berry::ExtensionRegistry*>(reg);
+      berry::IContributor::Pointer contributor(
+        new berry::RegistryContributor("1", "org.blueberry.test", QString(), QString()));
+      QByteArray manifest = MANIFEST;
+      QBuffer buffer(&manifest);
+      registry->AddContribution(&buffer, contributor, true, "plugin.xml", nullptr, m_Key);
+    }
+
+    void OnStop(berry::IExtensionRegistry*) override {}
+
+    QByteArray GetContributionsStamp() const override { return m_Stamp; }
+
+  private:
+    QByteArray m_Stamp;
+    QObject* m_Key;
+    bool& m_LoadedFromCache;
+  };
+}
+
+class berryRegistryCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(berryRegistryCacheTestSuite);
+  MITK_TEST(RoundTrip_Lazy);
+  MITK_TEST(RoundTrip_Eager);
+  MITK_TEST(StampMismatch_Rebuilds);
+  MITK_TEST(BadMagic_Rebuilds);
+  MITK_TEST(BadVersion_Rebuilds);
+  MITK_TEST(CorruptObjectId_Rebuilds);
+  MITK_TEST(CorruptObject_Eager_Rebuilds);
+  MITK_TEST(CorruptObject_Lazy_RemovesCache);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  QScopedPointer<QTemporaryDir> m_StorageDir;
+  QObject m_MasterToken;
+  QObject m_UserToken;
+  QByteArray m_Stamp;
+
+  QString GetCacheFile() const
+  {
+    return QDir(m_StorageDir->path()).filePath(berry::TableReader::GetTestFileName());
+  }
+
+  void SetLazyLoading(bool lazy)
+  {
+    berry::RegistryProperties::SetProperty(berry::RegistryConstants::PROP_NO_LAZY_REGISTRY_CACHE_LOADING,
+                                           lazy ? "false" : "true");
+  }
+
+  berry::ExtensionRegistry* CreateRegistry(const QByteArray& stamp, bool& loadedFromCache)
+  {
+    return new berry::ExtensionRegistry(
+      new TestRegistryStrategy(m_StorageDir->path(), stamp, &m_MasterToken, loadedFromCache),
+      &m_MasterToken, &m_UserToken);
+  }
+
+  /** Creates a registry from MANIFEST and stops it, which writes the cache. */
+  void WriteCache()
+  {
+    bool loadedFromCache = true;
+    QScopedPointer<berry::ExtensionRegistry> registry(CreateRegistry(m_Stamp, loadedFromCache));
+    CPPUNIT_ASSERT(!loadedFromCache);
+    registry->Stop(&m_MasterToken);
+    CPPUNIT_ASSERT(QFile::exists(GetCacheFile()));
+  }
+
+  /** Overwrites the cache content at the passed position. */
+  void CorruptCache(qint64 pos, const QByteArray& bytes)
+  {
+    QFile cacheFile(GetCacheFile());
+    CPPUNIT_ASSERT(cacheFile.open(QIODevice::ReadWrite));
+    CPPUNIT_ASSERT(cacheFile.seek(pos));
+    CPPUNIT_ASSERT_EQUAL(static_cast<qint64>(bytes.size()), cacheFile.write(bytes));
+  }
+
+  /** Position of the first object in the cache: magic, version, stamp, next id and the size of the objects section. */
+  qint64 GetObjectsStart() const { return 4 + 4 + 4 + m_Stamp.size() + 4 + 4; }
+
+  /** Checks that the registry holds the contents of MANIFEST. */
+  void CheckContents(berry::ExtensionRegistry* registry)
+  {
+    auto extensionPoint = registry->GetExtensionPoint(POINT_ID);
+    CPPUNIT_ASSERT(extensionPoint.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(extensionPoint->GetExtensions().size()));
+
+    QStringList values;
+    for (const auto& element : registry->GetConfigurationElementsFor(POINT_ID))
+      values << element->GetAttribute("name") + "=" + element->GetAttribute("value");
+    values.sort();
+    CPPUNIT_ASSERT(values == (QStringList() << "a=1" << "b=2" << "c=3"));
+
+    auto extension = registry->GetExtension(POINT_ID, "org.blueberry.test.second");
+    CPPUNIT_ASSERT(extension.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(extension->GetConfigurationElements().size()));
+  }
+
+  /** Starts a registry from the cache and checks whether the cache was used and the contents are complete. */
+  void CheckStart(const QByteArray& stamp, bool expectLoadedFromCache)
+  {
+    bool loadedFromCache = !expectLoadedFromCache;
+    QScopedPointer<berry::ExtensionRegistry> registry(CreateRegistry(stamp, loadedFromCache));
+    CPPUNIT_ASSERT_EQUAL(expectLoadedFromCache, loadedFromCache);
+    CheckContents(registry.data());
+    registry->Stop(&m_MasterToken);
+  }
+
+  void CheckRoundTrip()
+  {
+    WriteCache();
+    CheckStart(m_Stamp, true);
+    // the cache stays valid after a start without changes
+    CheckStart(m_Stamp, true);
+  }
+
+public:
+  void setUp() override
+  {
+    m_StorageDir.reset(new QTemporaryDir());
+    CPPUNIT_ASSERT(m_StorageDir->isValid());
+    m_Stamp = "stamp-1";
+
+    berry::RegistryProperties::SetProperty(berry::RegistryConstants::PROP_REGISTRY_MULTI_LANGUAGE, "false");
+    berry::RegistryProperties::SetProperty(berry::RegistryConstants::PROP_NO_REGISTRY_CACHE, "false");
+    berry::RegistryProperties::SetProperty(berry::RegistryConstants::PROP_NO_REGISTRY_FLUSHING, "false");
+    SetLazyLoading(true);
+  }
+
+  void tearDown() override
+  {
+    m_StorageDir.reset();
+  }
+
+  void RoundTrip_Lazy()
+  {
+    SetLazyLoading(true);
+    CheckRoundTrip();
+  }
+
+  void RoundTrip_Eager()
+  {
+    SetLazyLoading(false);
+    CheckRoundTrip();
+  }
+
+  void StampMismatch_Rebuilds()
+  {
+    WriteCache();
+    CheckStart("stamp-2", false);
+    // the rebuilt registry writes a cache for the new stamp
+    CheckStart("stamp-2", true);
+  }
+
+  void BadMagic_Rebuilds()
+  {
+    WriteCache();
+    CorruptCache(0, "XXXX");
+    CheckStart(m_Stamp, false);
+  }
+
+  void BadVersion_Rebuilds()
+  {
+    WriteCache();
+    CorruptCache(4, QByteArray("\xff\xff\xff\xff", 4));
+    CheckStart(m_Stamp, false);
+  }
+
+  void CorruptObjectId_Rebuilds()
+  {
+    SetLazyLoading(true);
+    WriteCache();
+    // the id of the first object no longer matches its offset table entry
+    CorruptCache(GetObjectsStart() + 1, QByteArray("\x7f\xff\xff\xff", 4));
+    CheckStart(m_Stamp, false);
+  }
+
+  void CorruptObject_Eager_Rebuilds()
+  {
+    SetLazyLoading(false);
+    WriteCache();
+    // the children list of the first object exceeds the objects section
+    CorruptCache(GetObjectsStart() + 5, QByteArray("\x00\x01\x00\x00", 4));
+    CheckStart(m_Stamp, false);
+  }
+
+  void CorruptObject_Lazy_RemovesCache()
+  {
+    SetLazyLoading(true);
+    WriteCache();
+    // the header of the first object is valid, so the corruption is only found when it is loaded
+    CorruptCache(GetObjectsStart() + 5, QByteArray("\x00\x01\x00\x00", 4));
+
+    {
+      bool loadedFromCache = false;
+      QScopedPointer<berry::ExtensionRegistry> registry(CreateRegistry(m_Stamp, loadedFromCache));
+      CPPUNIT_ASSERT(loadedFromCache);
+      try
+      {
+        registry->GetConfigurationElementsFor(POINT_ID);
+      }
+      catch (const berry::InvalidRegistryObjectException&)
+      {
+        // expected for the object which could not be read
+      }
+      registry->Stop(&m_MasterToken);
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("A cache with unreadable objects must be removed", !QFile::exists(GetCacheFile()));
+    CheckStart(m_Stamp, false);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(berryRegistryCache)
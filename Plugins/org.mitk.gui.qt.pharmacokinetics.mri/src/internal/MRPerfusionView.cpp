@@ -202,6 +202,7 @@ void MRPerfusionView::CreateQtPartControl(QWidget* parent)
   m_Controls.spinBox_baselineEndTimeStep->setMinimum(0);
   m_Controls.spinBox_baselineStartTimeStep->setMinimum(0);
   m_Controls.groupBox_baselineRangeSelection->hide();
+  m_Controls.checkBox_storeConcentration->setChecked(false);
 
 
 
@@ -291,6 +292,7 @@ void MRPerfusionView::UpdateGUIControls()
 
   m_Controls.spinBox_baselineStartTimeStep->setEnabled( m_Controls.radioButton_absoluteEnhancement->isChecked() || m_Controls.radioButton_relativeEnchancement->isChecked() || m_Controls.radioButtonUsingT1viaVFA->isChecked());
   m_Controls.spinBox_baselineEndTimeStep->setEnabled(m_Controls.radioButton_absoluteEnhancement->isChecked() || m_Controls.radioButton_relativeEnchancement->isChecked() || m_Controls.radioButtonUsingT1viaVFA->isChecked());
+  m_Controls.checkBox_storeConcentration->setEnabled(!m_Controls.radioButtonNoConversion->isChecked() && m_Controls.radioPixelBased->isChecked());
 
 
 }
@@ -868,6 +870,12 @@ void MRPerfusionView::GenerateAIFbasedModelFit_PixelBased(mitk::modelFit::ModelF
   fitGenerator->SetDynamicImage(this->m_inputImage);
   fitGenerator->SetFitFunctor(fitFunctor);
 
+  if (this->IsStreamedConversion())
+  {
+    //the signal of each voxel is converted into concentration right before it is fitted
+    fitGenerator->SetSignalConverter(this->CreateConcentrationGenerator(false));
+  }
+
   generator = fitGenerator.GetPointer();
 
   //Create model info
@@ -1113,9 +1121,8 @@ mitk::DataNode::Pointer MRPerfusionView::GenerateConcentrationNode(mitk::Image*
 };
 
 
-mitk::Image::Pointer MRPerfusionView::ConvertConcentrationImage(bool AIFMode)
+mitk::ConcentrationCurveGenerator::Pointer MRPerfusionView::CreateConcentrationGenerator(bool AIFMode)
 {
-  //Compute Concentration image
   mitk::ConcentrationCurveGenerator::Pointer concentrationGen =
     mitk::ConcentrationCurveGenerator::New();
 
@@ -1154,12 +1161,28 @@ mitk::Image::Pointer MRPerfusionView::ConvertConcentrationImage(bool AIFMode)
     concentrationGen->SetBaselineEndTimeStep(m_Controls.spinBox_baselineEndTimeStep->value());
   }
 
+  return concentrationGen;
+}
 
-  mitk::Image::Pointer concentrationImage = concentrationGen->GetConvertedImage();
+mitk::Image::Pointer MRPerfusionView::ConvertConcentrationImage(bool AIFMode)
+{
+  //Compute Concentration image
+  mitk::Image::Pointer concentrationImage = this->CreateConcentrationGenerator(AIFMode)->GetConvertedImage();
 
   return concentrationImage;
 }
 
+bool MRPerfusionView::IsStreamedConversion() const
+{
+  //only the pixel based generator of the AIF based models converts the signal on the fly,
+  //the descriptive Brix model is fitted without a signal converter
+  bool isDescBrixFactory = dynamic_cast<mitk::DescriptivePharmacokineticBrixModelFactory*>
+                           (m_selectedModelFactory.GetPointer()) != nullptr;
+
+  return !isDescBrixFactory && !this->m_Controls.radioButtonNoConversion->isChecked()
+    && this->m_Controls.radioPixelBased->isChecked() && !this->m_Controls.checkBox_storeConcentration->isChecked();
+}
+
 void MRPerfusionView::GetAIF(mitk::AIFBasedModelBase::AterialInputFunctionType& aif,
                              mitk::AIFBasedModelBase::AterialInputFunctionType& aifTimeGrid)
 {
@@ -1239,6 +1262,11 @@ void MRPerfusionView::GetAIF(mitk::AIFBasedModelBase::AterialInputFunctionType&
 
     aifGenerator->SetDynamicImage(this->m_inputAIFImage);
 
+    if (this->IsStreamedConversion())
+    {
+      aifGenerator->SetSignalConverter(this->CreateConcentrationGenerator(true));
+    }
+
     aif = aifGenerator->GetAterialInputFunction();
     aifTimeGrid = aifGenerator->GetAterialInputFunctionTimeGrid();
   }
@@ -1308,7 +1336,7 @@ void MRPerfusionView::PrepareConcentrationImage()
   mitk::DataNode::Pointer concentrationNode = this->m_selectedNode;
   m_HasGeneratedNewInput = false;
 
-  if (!this->m_Controls.radioButtonNoConversion->isChecked())
+  if (!this->m_Controls.radioButtonNoConversion->isChecked() && !this->IsStreamedConversion())
   {
     concentrationImage = this->ConvertConcentrationImage(false);
     concentrationNode = GenerateConcentrationNode(concentrationImage, "Concentration");
@@ -1331,7 +1359,7 @@ void MRPerfusionView::PrepareAIFConcentrationImage()
     concentrationNode = this->m_selectedAIFImageNode;
   }
 
-  if (!this->m_Controls.radioButtonNoConversion->isChecked())
+  if (!this->m_Controls.radioButtonNoConversion->isChecked() && !this->IsStreamedConversion())
   {
     if (!this->m_Controls.checkDedicatedAIFImage->isChecked())
     {
@@ -27,6 +27,7 @@ found in the LICENSE file.
 #include "mitkLevenbergMarquardtModelFitFunctor.h"
 #include "mitkSimpleBarrierConstraintChecker.h"
 #include "mitkAIFBasedModelBase.h"
+#include "mitkConcentrationCurveGenerator.h"
 
 /*!
 *	@brief Test Plugin for SUV calculations of PET images
@@ -148,10 +149,19 @@ private:
   typedef std::vector<mitk::ModelFactoryBase::Pointer> ModelFactoryStackType;
   ModelFactoryStackType m_FactoryStack;
 
+  /**Creates a concentration curve generator for the selected image based on the given gui settings.
+   AIFMode controls if the generator converts the fit input or the AIF image.*/
+  mitk::ConcentrationCurveGenerator::Pointer CreateConcentrationGenerator(bool AIFMode);
+
   /**Converts the selected image to a concentration image based on the given gui settings.
    AIFMode controls if the concentration image for the fit input or the AIF will be converted.*/
   mitk::Image::Pointer ConvertConcentrationImage(bool AIFMode);
 
+  /**Indicates if the signal should be converted voxel by voxel while fitting, instead of generating
+   the concentration image(s) first. This is the case for pixel based fits of AIF based models with
+   conversion, if the user does not want to store the concentration image.*/
+  bool IsStreamedConversion() const;
+
   /**Helper function that (depending on the gui settings) prepares m_inputNode and m_inputImage.
    Either by directly pass back the selected image/node or the newly generated concentration image/node.
    After calling this method  m_inputImage are always what should be used as input image